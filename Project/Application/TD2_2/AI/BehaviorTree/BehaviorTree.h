@@ -75,4 +75,14 @@ public:
       buildFunc(builder);
       return Build(builder, name);
    }
+
+   /// @brief ビルド関数からコンパイル済みのツリーを作る
+   /// @param buildFunc ビルド関数
+   /// @return 複数のエージェントで共有するツリー（BehaviorTreeAgentGroup で実行する）
+   template<typename BuildFunc>
+   static std::shared_ptr<const CompiledBehaviorTree> CreateCompiled(BuildFunc buildFunc) {
+      auto builder = CreateBuilder();
+      buildFunc(builder);
+      return builder.Compile();
+   }
 };
@@ -2,57 +2,77 @@
 
 BehaviorTreeBuilder& BehaviorTreeBuilder::Selector() {
     stack_.push_back(std::make_unique<SelectorNode>());
+    BeginDescription(FlatNodeType::Selector);
     return *this;
 }
 
 BehaviorTreeBuilder& BehaviorTreeBuilder::Sequence() {
    stack_.push_back(std::make_unique<SequenceNode>());
+   BeginDescription(FlatNodeType::Sequence);
    return *this;
 }
 
-BehaviorTreeBuilder& BehaviorTreeBuilder::WeightedSelector() {
-   stack_.push_back(std::make_unique<WeightedRandomSelectorNode>());
+BehaviorTreeBuilder& BehaviorTreeBuilder::WeightedSelector(const Blackboard* blackboard) {
+   auto node = std::make_unique<WeightedRandomSelectorNode>();
+   node->SetBlackboard(blackboard);
+   stack_.push_back(std::move(node));
+   BeginDescription(FlatNodeType::WeightedSelector);
    return *this;
 }
 
 BehaviorTreeBuilder& BehaviorTreeBuilder::Parallel(ParallelPolicy policy) {
    stack_.push_back(std::make_unique<ParallelNode>(policy));
+   BeginDescription(FlatNodeType::Parallel, 0.0f, policy);
    return *this;
 }
 
 BehaviorTreeBuilder& BehaviorTreeBuilder::Condition(std::function<bool()> func) {
+   description_.sharedConditions.push_back(func);
+   AddDescriptionLeaf(FlatNodeType::SharedCondition, static_cast<uint32_t>(description_.sharedConditions.size() - 1));
    AddToCurrent(std::make_unique<ConditionNode>(std::move(func)));
    return *this;
 }
 
 BehaviorTreeBuilder& BehaviorTreeBuilder::Inverter() {
    stack_.push_back(std::make_unique<InverterNode>(nullptr));
+   BeginDescription(FlatNodeType::Inverter);
    return *this;
 }
 
 BehaviorTreeBuilder& BehaviorTreeBuilder::Succeeder() {
    stack_.push_back(std::make_unique<SucceederNode>(nullptr));
+   BeginDescription(FlatNodeType::Succeeder);
    return *this;
 }
 
 BehaviorTreeBuilder& BehaviorTreeBuilder::Repeater(int repeatCount) {
    stack_.push_back(std::make_unique<RepeaterNode>(nullptr, repeatCount));
+   BeginDescription(FlatNodeType::Repeater, static_cast<float>(repeatCount));
    return *this;
 }
 
 BehaviorTreeBuilder& BehaviorTreeBuilder::Retry() {
    stack_.push_back(std::make_unique<RetryNode>(nullptr));
+   BeginDescription(FlatNodeType::Retry);
    return *this;
 }
 
 BehaviorTreeBuilder& BehaviorTreeBuilder::Wait(float duration) {
+   AddDescriptionLeaf(FlatNodeType::Wait, 0, duration);
    AddToCurrent(std::make_unique<WaitNode>(duration));
    return *this;
 }
 
+BehaviorTreeBuilder& BehaviorTreeBuilder::WaitForEvent() {
+   compileOnly_ = true;
+   AddDescriptionLeaf(FlatNodeType::WaitForEvent, 0);
+   return *this;
+}
+
 BehaviorTreeBuilder& BehaviorTreeBuilder::WeightedNode(std::unique_ptr<BaseNode> node, float weight) {
    auto* weighted = dynamic_cast<WeightedRandomSelectorNode*>(stack_.back().get());
    assert(weighted && "Current node is not WeightedRandomSelectorNode!");
+   compilable_ = false;
    weighted->AddChild(std::move(node), weight);
    return *this;
 }
@@ -60,11 +80,31 @@ BehaviorTreeBuilder& BehaviorTreeBuilder::WeightedNode(std::unique_ptr<BaseNode>
 BehaviorTreeBuilder& BehaviorTreeBuilder::WeightedNode(std::unique_ptr<BaseNode> node, std::unique_ptr<IEvaluator> evaluator) {
    auto* weighted = dynamic_cast<WeightedRandomSelectorNode*>(stack_.back().get());
    assert(weighted && "Current node is not WeightedRandomSelectorNode!");
+   compilable_ = false;
    weighted->AddChild(std::move(node), std::move(evaluator));
    return *this;
 }
 
+BehaviorTreeBuilder& BehaviorTreeBuilder::WeightedNode(std::unique_ptr<BaseNode> node, std::unique_ptr<IEvaluator> evaluator, uint64_t watchedKeys) {
+   auto* weighted = dynamic_cast<WeightedRandomSelectorNode*>(stack_.back().get());
+   assert(weighted && "Current node is not WeightedRandomSelectorNode!");
+   compilable_ = false;
+   weighted->AddChild(std::move(node), std::move(evaluator), watchedKeys);
+   return *this;
+}
+
+BehaviorTreeBuilder& BehaviorTreeBuilder::NextWeight(float weight) {
+   nextWeight_ = weight;
+   return *this;
+}
+
 BehaviorTreeBuilder& BehaviorTreeBuilder::End() {
+   if (descriptionStack_.size() > 1) {
+      const uint32_t node = descriptionStack_.back();
+      descriptionStack_.pop_back();
+      description_.nodes[descriptionStack_.back()].children.push_back(node);
+   }
+
    if (stack_.size() > 1) {
       auto node = std::move(stack_.back());
       stack_.pop_back();
@@ -93,10 +133,43 @@ BehaviorTreeBuilder& BehaviorTreeBuilder::End() {
 
 std::unique_ptr<BaseNode> BehaviorTreeBuilder::Build() {
    assert(stack_.size() == 1 && "Unbalanced Begin/End calls in builder!");
+   assert(!compileOnly_ && "AgentCondition/AgentAction/ObserveBlackboard/WaitForEvent can only be used with Compile()!");
    return std::move(stack_.front());
 }
 
 std::unique_ptr<BaseNode> BehaviorTreeBuilder::BuildSubTree() {
    assert(stack_.size() == 1 && "Unbalanced Begin/End calls in sub-tree builder!");
+   assert(!compileOnly_ && "AgentCondition/AgentAction/ObserveBlackboard/WaitForEvent can only be used with Compile()!");
    return std::move(stack_.front());
 }
+
+std::shared_ptr<const CompiledBehaviorTree> BehaviorTreeBuilder::Compile() const {
+   assert(descriptionStack_.size() == 1 && "Unbalanced Begin/End calls in builder!");
+   assert(compilable_ && "Action<T>/WeightedAction/WeightedNode cannot be compiled!");
+   if (descriptionStack_.size() != 1 || !compilable_) {
+      return nullptr;
+   }
+   return CompiledBehaviorTree::Compile(description_);
+}
+
+void BehaviorTreeBuilder::BeginDescription(FlatNodeType type, float param, ParallelPolicy policy) {
+   descriptionStack_.push_back(AddDescriptionNode(type, param, policy));
+}
+
+void BehaviorTreeBuilder::AddDescriptionLeaf(FlatNodeType type, uint32_t index, float param) {
+   assert(!descriptionStack_.empty() && "Leaf node needs a parent!");
+   const uint32_t node = AddDescriptionNode(type, param, ParallelPolicy::SuccessWhenAllSucceed);
+   description_.nodes[node].index = index;
+   description_.nodes[descriptionStack_.back()].children.push_back(node);
+}
+
+uint32_t BehaviorTreeBuilder::AddDescriptionNode(FlatNodeType type, float param, ParallelPolicy policy) {
+   BehaviorTreeDescription::Node node;
+   node.type = type;
+   node.policy = policy;
+   node.param = param;
+   node.weight = nextWeight_;
+   nextWeight_ = 1.0f;
+   description_.nodes.push_back(std::move(node));
+   return static_cast<uint32_t>(description_.nodes.size() - 1);
+}
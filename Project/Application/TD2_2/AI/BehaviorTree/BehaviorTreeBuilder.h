@@ -6,6 +6,7 @@
 #include "../Node/DecoratorNode.h"
 #include "../Node/LeafNode.h"
 #include "../Node/Evaluator.h"
+#include "CompiledBehaviorTree.h"
 
 class BehaviorTreeBuilder {
 public:
@@ -13,7 +14,8 @@ public:
 
    BehaviorTreeBuilder& Sequence();
 
-   BehaviorTreeBuilder& WeightedSelector();
+   /// @param blackboard 評価関数の依存を調べるブラックボード（WeightedNode の watchedKeys 用）
+   BehaviorTreeBuilder& WeightedSelector(const Blackboard* blackboard = nullptr);
 
    BehaviorTreeBuilder& Parallel(ParallelPolicy policy = ParallelPolicy::SuccessWhenAllSucceed);
 
@@ -42,12 +44,44 @@ public:
 
    BehaviorTreeBuilder& WeightedNode(std::unique_ptr<BaseNode> node, std::unique_ptr<IEvaluator> evaluator);
 
+   /// @brief ブラックボードの値だけに依存する評価関数で重みを付ける（watchedKeys のキーが変わったときだけ評価し直す）
+   BehaviorTreeBuilder& WeightedNode(std::unique_ptr<BaseNode> node, std::unique_ptr<IEvaluator> evaluator, uint64_t watchedKeys);
+
+   /// @brief エージェントを受け取る条件（Compile 専用）
+   /// @details 例: AgentCondition<Minion>([](Minion& m) { return m.IsTargetVisible(); })
+   template<typename Agent>
+   BehaviorTreeBuilder& AgentCondition(bool (*condition)(Agent&));
+
+   /// @brief エージェントと経過時間を受け取るアクション（Compile 専用）
+   template<typename Agent>
+   BehaviorTreeBuilder& AgentAction(NodeState (*action)(Agent&, float));
+
+   /// @brief ブラックボードの値を監視する条件デコレーター（Compile 専用）
+   /// @details 条件を満たすときだけ子を実行する。条件は key が変わったときだけ評価し直し、
+   /// abort に従って実行中の枝を中断する。例: ObserveBlackboard(targetKey, &HasTarget, ObserverAbort::LowerPriority)
+   template<typename T>
+   BehaviorTreeBuilder& ObserveBlackboard(BlackboardKey<T> key, bool (*predicate)(const T&), ObserverAbort abort = ObserverAbort::None);
+
+   /// @brief ブラックボードが変わるまで待つ葉（Compile 専用）
+   /// @details ここで待っているエージェントは BehaviorTreeAgentGroup で眠り、Tick されない。
+   BehaviorTreeBuilder& WaitForEvent();
+
+   /// @brief 次に追加する子の重み（Compile した重み付きセレクター用）
+   BehaviorTreeBuilder& NextWeight(float weight);
+
    BehaviorTreeBuilder& End();
 
    std::unique_ptr<BaseNode> Build();
 
    std::unique_ptr<BaseNode> BuildSubTree();
 
+   /// @brief 平坦な配列にコンパイルする
+   /// @details 複合ノード・デコレーター・Condition・Wait・AgentCondition・AgentAction で組んだツリーのみ対象。
+   /// Condition の関数は全エージェントで共有されるので、エージェントの状態を見る条件は AgentCondition を使う。
+   /// Action<T>・WeightedAction・WeightedNode はノードを直接持つためコンパイルできない。
+   /// @return コンパイル済みのツリー（複数のエージェントで共有する）
+   std::shared_ptr<const CompiledBehaviorTree> Compile() const;
+
    // ======================================================================
    // 汎用ヘルパーメソッド群
    // ======================================================================
@@ -103,6 +137,19 @@ public:
 private:
    std::vector<std::unique_ptr<BaseNode>> stack_;
 
+   // Compile 用にツリーの構造を記録する（stack_ と同じ順に積む）
+   BehaviorTreeDescription description_;
+   std::vector<uint32_t> descriptionStack_;
+   float nextWeight_ = 1.0f;
+   bool compilable_ = true;     // ノードを直接持つ葉がない
+   bool compileOnly_ = false;   // Build できないノードがある
+
+   void BeginDescription(FlatNodeType type, float param = 0.0f, ParallelPolicy policy = ParallelPolicy::SuccessWhenAllSucceed);
+
+   void AddDescriptionLeaf(FlatNodeType type, uint32_t index, float param = 0.0f);
+
+   uint32_t AddDescriptionNode(FlatNodeType type, float param, ParallelPolicy policy);
+
    void AddToCurrent(std::unique_ptr<BaseNode> node) {
       auto* composite = dynamic_cast<CompositeNode*>(stack_.back().get());
       assert(composite && "Current node cannot have children!");
@@ -123,6 +170,7 @@ private:
 
 template<typename T, typename ...Args>
 inline BehaviorTreeBuilder& BehaviorTreeBuilder::Action(Args && ...args) {
+   compilable_ = false;
    AddToCurrent(std::make_unique<T>(std::forward<Args>(args)...));
    return *this;
 }
@@ -132,6 +180,7 @@ template<typename T, typename ...Args>
 inline BehaviorTreeBuilder& BehaviorTreeBuilder::WeightedAction(float weight, Args && ...args) {
    auto* weighted = dynamic_cast<WeightedRandomSelectorNode*>(stack_.back().get());
    assert(weighted && "Current node is not WeightedRandomSelectorNode!");
+   compilable_ = false;
    weighted->AddChild(std::make_unique<T>(std::forward<Args>(args)...), weight);
    return *this;
 }
@@ -141,10 +190,39 @@ template<typename T, typename ...Args>
 inline BehaviorTreeBuilder& BehaviorTreeBuilder::WeightedAction(std::unique_ptr<IEvaluator> evaluator, Args && ...args) {
    auto* weighted = dynamic_cast<WeightedRandomSelectorNode*>(stack_.back().get());
    assert(weighted && "Current node is not WeightedRandomSelectorNode!");
+   compilable_ = false;
    weighted->AddChild(std::make_unique<T>(std::forward<Args>(args)...), std::move(evaluator));
    return *this;
 }
 
+template<typename Agent>
+inline BehaviorTreeBuilder& BehaviorTreeBuilder::AgentCondition(bool (*condition)(Agent&)) {
+   compileOnly_ = true;
+   description_.leaves.push_back(BehaviorTreeLeaf::MakeCondition(condition));
+   AddDescriptionLeaf(FlatNodeType::Condition, static_cast<uint32_t>(description_.leaves.size() - 1));
+   return *this;
+}
+
+template<typename Agent>
+inline BehaviorTreeBuilder& BehaviorTreeBuilder::AgentAction(NodeState (*action)(Agent&, float)) {
+   compileOnly_ = true;
+   description_.leaves.push_back(BehaviorTreeLeaf::MakeAction(action));
+   AddDescriptionLeaf(FlatNodeType::Action, static_cast<uint32_t>(description_.leaves.size() - 1));
+   return *this;
+}
+
+template<typename T>
+inline BehaviorTreeBuilder& BehaviorTreeBuilder::ObserveBlackboard(BlackboardKey<T> key, bool (*predicate)(const T&), ObserverAbort abort) {
+   assert(key.IsValid() && "Invalid blackboard key!");
+   compileOnly_ = true;
+   // End() の対応を保つための代わりのノード（Build はしない）
+   stack_.push_back(std::make_unique<SucceederNode>(nullptr));
+   description_.observers.push_back(BehaviorTreeObserver::Make(key, predicate, abort));
+   BeginDescription(FlatNodeType::BlackboardCondition);
+   description_.nodes[descriptionStack_.back()].index = static_cast<uint32_t>(description_.observers.size() - 1);
+   return *this;
+}
+
 // ======================================================================
 // 汎用ヘルパーメソッドの実装
 // ======================================================================
@@ -159,6 +237,7 @@ inline BehaviorTreeBuilder& BehaviorTreeBuilder::QuickSequence(Actions&&... acti
 
 template<typename T, typename... Rest>
 inline void BehaviorTreeBuilder::AddActionsToSequence(T&& first, Rest&&... rest) {
+   compilable_ = false;
    AddToCurrent(std::forward<T>(first));
    AddActionsToSequence(std::forward<Rest>(rest)...);
 }
@@ -173,6 +252,7 @@ inline BehaviorTreeBuilder& BehaviorTreeBuilder::QuickSelector(Actions&&... acti
 
 template<typename T, typename... Rest>
 inline void BehaviorTreeBuilder::AddActionsToSelector(T&& first, Rest&&... rest) {
+   compilable_ = false;
    AddToCurrent(std::forward<T>(first));
    AddActionsToSelector(std::forward<Rest>(rest)...);
 }
@@ -0,0 +1,441 @@
+#include "CompiledBehaviorTree.h"
+#include <bit>
+#include <cassert>
+
+namespace {
+   // パラレルの子の結果（0は未完了）
+   constexpr uint32_t kParallelRunning = 0;
+   constexpr uint32_t kParallelSuccess = 1;
+   constexpr uint32_t kParallelFailure = 2;
+
+   // ブラックボード条件の状態（ビット）
+   constexpr uint32_t kObserverCached = 1u << 0;  // 条件の結果を保持している
+   constexpr uint32_t kObserverPassed = 1u << 1;  // 条件を満たしている
+   constexpr uint32_t kObserverRunning = 1u << 2; // 子が実行中
+
+   /// @brief xorshift32（状態ブロックの先頭に置く）
+   uint32_t NextRandom(uint32_t& state) {
+      uint32_t x = state;
+      x ^= x << 13;
+      x ^= x >> 17;
+      x ^= x << 5;
+      state = x;
+      return x;
+   }
+}
+
+std::shared_ptr<const CompiledBehaviorTree> CompiledBehaviorTree::Compile(const BehaviorTreeDescription& description) {
+   if (description.nodes.empty()) {
+      return nullptr;
+   }
+
+   std::shared_ptr<CompiledBehaviorTree> tree(new CompiledBehaviorTree());
+   tree->nodes_.reserve(description.nodes.size());
+   tree->leaves_ = description.leaves;
+   tree->sharedConditions_ = description.sharedConditions;
+   tree->stateSize_ = 1; // 先頭は乱数
+
+   // 前順に並べ、状態ブロックの位置を割り当てる
+   auto flatten = [&](auto& self, uint32_t source, uint32_t parent, uint32_t depth) -> void {
+      const BehaviorTreeDescription::Node& spec = description.nodes[source];
+      assert(depth < kMaxDepth && "Behavior tree is too deep to compile!");
+
+      Node node{};
+      node.type = spec.type;
+      node.policy = static_cast<uint8_t>(spec.policy);
+      node.childCount = static_cast<uint16_t>(spec.children.size());
+      node.index = spec.index;
+      node.param = spec.param;
+      node.weight = spec.weight;
+      node.stateOffset = tree->stateSize_;
+
+      switch (spec.type) {
+         case FlatNodeType::Selector:
+         case FlatNodeType::Sequence:
+         case FlatNodeType::WeightedSelector:
+         case FlatNodeType::Repeater:
+         case FlatNodeType::Wait:
+            tree->stateSize_ += 1;
+            break;
+         case FlatNodeType::BlackboardCondition: {
+            assert(spec.children.size() <= 1 && "Decorator has more than one child!");
+            tree->stateSize_ += 1;
+            // 監視する条件として登録する（node.index は observers_ の番号）
+            const BehaviorTreeObserver& observer = description.observers[spec.index];
+            node.index = static_cast<uint32_t>(tree->observers_.size());
+            tree->observers_.push_back({ observer, static_cast<uint32_t>(tree->nodes_.size()), parent });
+            tree->watchedKeys_ |= uint64_t{ 1 } << observer.key;
+            break;
+         }
+         case FlatNodeType::Parallel:
+            tree->stateSize_ += node.childCount;
+            break;
+         case FlatNodeType::Inverter:
+         case FlatNodeType::Succeeder:
+         case FlatNodeType::Retry:
+            assert(spec.children.size() <= 1 && "Decorator has more than one child!");
+            break;
+         default:
+            break;
+      }
+
+      const uint32_t position = static_cast<uint32_t>(tree->nodes_.size());
+      tree->nodes_.push_back(node);
+      for (uint32_t child : spec.children) {
+         self(self, child, position, depth + 1);
+      }
+      tree->nodes_[position].subtreeEnd = static_cast<uint32_t>(tree->nodes_.size());
+   };
+   flatten(flatten, 0, 0, 0);
+
+   return tree;
+}
+
+void CompiledBehaviorTree::ResetState(uint32_t* state, uint32_t seed) const {
+   std::fill_n(state, stateSize_, 0u);
+   state[0] = seed != 0 ? seed : 0x9E3779B9u;
+}
+
+NodeState CompiledBehaviorTree::Tick(void* agent, uint32_t* state, float deltaTime, const Blackboard* blackboard, bool* outIdle) const {
+   TickContext context{ state, blackboard, deltaTime, false };
+   const Node* nodes = nodes_.data();
+   Frame stack[kMaxDepth];
+   uint32_t depth = 0;
+   uint32_t current = 0;
+   NodeState result = NodeState::Failure;
+
+   // 大半を占める葉・Selector・Sequence はここで処理し、それ以外は EnterNode・ResumeNode に任せる
+   for (;;) {
+      // ---- ノードに入る ----
+      const Node& node = nodes[current];
+      uint32_t enter = 0; // 次に入る子（0は子に入らず result を親へ返す）
+
+      if (node.type == FlatNodeType::Action || node.type == FlatNodeType::Condition) {
+         const BehaviorTreeLeaf& leaf = leaves_[node.index];
+         result = leaf.invoke(leaf.function, agent, deltaTime);
+         context.didWork = true;
+      } else if (node.type == FlatNodeType::Selector || node.type == FlatNodeType::Sequence) {
+         if (node.childCount == 0) {
+            result = node.type == FlatNodeType::Selector ? NodeState::Failure : NodeState::Success;
+         } else {
+            // 前回Runningだった子から再開
+            const uint32_t resume = state[node.stateOffset];
+            enter = resume != 0 ? resume : current + 1;
+            stack[depth++] = { current, enter, 0 };
+         }
+      } else {
+         const Step step = EnterNode(current, context, stack[depth], result);
+         enter = step.next;
+         result = step.result;
+         if (enter != 0) {
+            ++depth;
+         }
+      }
+
+      // ---- 結果を親へ返す ----
+      while (enter == 0 && depth > 0) {
+         Frame& frame = stack[depth - 1];
+         const Node& parent = nodes[frame.node];
+
+         if (parent.type == FlatNodeType::Selector || parent.type == FlatNodeType::Sequence) {
+            // Selectorは失敗、Sequenceは成功で次の子へ進む
+            const NodeState advance = parent.type == FlatNodeType::Selector ? NodeState::Failure : NodeState::Success;
+            const uint32_t next = nodes[frame.child].subtreeEnd;
+            if (result == NodeState::Running) {
+               state[parent.stateOffset] = frame.child;
+            } else if (result == advance && next < parent.subtreeEnd) {
+               frame.child = next;
+               enter = next;
+            } else {
+               state[parent.stateOffset] = 0;
+            }
+         } else {
+            const Step step = ResumeNode(frame, state, result);
+            enter = step.next;
+            result = step.result;
+         }
+
+         if (enter == 0) {
+            --depth;
+         }
+      }
+
+      if (enter == 0) {
+         if (outIdle) {
+            *outIdle = !context.didWork;
+         }
+         return result;
+      }
+      current = enter;
+   }
+}
+
+CompiledBehaviorTree::Step CompiledBehaviorTree::EnterNode(uint32_t index, TickContext& context, Frame& frame, NodeState result) const {
+   const Node& node = nodes_[index];
+   uint32_t* state = context.state;
+   uint32_t* slot = state + node.stateOffset;
+   uint32_t child = index + 1;
+   uint32_t ordinal = 0;
+
+   switch (node.type) {
+      case FlatNodeType::SharedCondition:
+         context.didWork = true;
+         result = sharedConditions_[node.index]() ? NodeState::Success : NodeState::Failure;
+         return { 0, result };
+
+      case FlatNodeType::WaitForEvent:
+         // 監視するキーが変わるまで何もしない（エージェントは眠ってよい）
+         return { 0, NodeState::Running };
+
+      case FlatNodeType::Wait: {
+         context.didWork = true;
+         const float elapsed = std::bit_cast<float>(*slot) + context.deltaTime;
+         if (elapsed >= node.param) {
+            *slot = 0;
+            result = NodeState::Success;
+         } else {
+            *slot = std::bit_cast<uint32_t>(elapsed);
+            result = NodeState::Running;
+         }
+         return { 0, result };
+      }
+
+      case FlatNodeType::Parallel:
+         if (node.childCount == 0) {
+            result = NodeState::Failure;
+            return { 0, result };
+         }
+         FindRunningChild(node, slot, child, ordinal);
+         if (child >= node.subtreeEnd) {
+            result = FinishParallel(node, slot);
+            return { 0, result };
+         }
+         break;
+
+      case FlatNodeType::WeightedSelector: {
+         if (*slot != 0) {
+            child = *slot;
+            break;
+         }
+         float totalWeight = 0.0f;
+         for (uint32_t i = index + 1; i < node.subtreeEnd; i = nodes_[i].subtreeEnd) {
+            totalWeight += (std::max)(0.0f, nodes_[i].weight);
+         }
+         if (totalWeight <= 0.0f) {
+            result = NodeState::Failure;
+            return { 0, result };
+         }
+         // [0, totalWeight) から選ぶ
+         context.didWork = true;
+         const float r = static_cast<float>(NextRandom(state[0]) >> 8) * (1.0f / 16777216.0f) * totalWeight;
+         float cumulative = 0.0f;
+         for (uint32_t i = index + 1; i < node.subtreeEnd; i = nodes_[i].subtreeEnd) {
+            cumulative += (std::max)(0.0f, nodes_[i].weight);
+            child = i;
+            if (r < cumulative) {
+               break;
+            }
+         }
+         *slot = child;
+         break;
+      }
+
+      case FlatNodeType::BlackboardCondition: {
+         // 条件は監視するキーが変わったときだけ評価し直す
+         if ((*slot & kObserverCached) == 0) {
+            assert(context.blackboard && "BlackboardCondition needs a blackboard!");
+            *slot = kObserverCached | (observers_[node.index].Evaluate(*context.blackboard) ? kObserverPassed : 0u);
+         }
+         // 実行中の子は Self で中断されない限り続ける
+         if ((*slot & (kObserverPassed | kObserverRunning)) == 0) {
+            return { 0, NodeState::Failure };
+         }
+         if (node.childCount == 0) {
+            return { 0, NodeState::Success };
+         }
+         break;
+      }
+
+      default:
+         // デコレーター
+         if (node.childCount == 0) {
+            result = node.type == FlatNodeType::Succeeder ? NodeState::Success : NodeState::Failure;
+            return { 0, result };
+         }
+         if (node.type == FlatNodeType::Repeater && node.param == 0.0f) {
+            result = NodeState::Success;
+            return { 0, result };
+         }
+         break;
+   }
+
+   frame = { index, child, ordinal };
+   return { child, result };
+}
+
+CompiledBehaviorTree::Step CompiledBehaviorTree::ResumeNode(Frame& frame, uint32_t* state, NodeState result) const {
+   const Node& parent = nodes_[frame.node];
+   uint32_t* slot = state + parent.stateOffset;
+
+   switch (parent.type) {
+      case FlatNodeType::Parallel: {
+         if (result != NodeState::Running) {
+            slot[frame.ordinal] = result == NodeState::Success ? kParallelSuccess : kParallelFailure;
+         }
+         uint32_t child = nodes_[frame.child].subtreeEnd;
+         uint32_t ordinal = frame.ordinal + 1;
+         FindRunningChild(parent, slot, child, ordinal);
+         if (child < parent.subtreeEnd) {
+            frame.child = child;
+            frame.ordinal = ordinal;
+            return { child, result };
+         }
+         result = FinishParallel(parent, slot);
+         return { 0, result };
+      }
+
+      case FlatNodeType::WeightedSelector:
+         if (result != NodeState::Running) {
+            *slot = 0;
+         }
+         return { 0, result };
+
+      case FlatNodeType::Inverter:
+         if (result == NodeState::Success) result = NodeState::Failure;
+         else if (result == NodeState::Failure) result = NodeState::Success;
+         return { 0, result };
+
+      case FlatNodeType::Succeeder:
+         result = NodeState::Success;
+         return { 0, result };
+
+      case FlatNodeType::Repeater:
+         if (parent.param < 0.0f) {
+            // 無限に繰り返す
+            result = NodeState::Running;
+         } else if (result != NodeState::Running) {
+            // 子が終わったら同じフレームのうちに次の回を始める
+            if (static_cast<float>(++*slot) < parent.param) {
+               return { frame.child, result };
+            }
+            *slot = 0;
+            result = NodeState::Success;
+         }
+         return { 0, result };
+
+      case FlatNodeType::Retry:
+         result = result == NodeState::Success ? NodeState::Success : NodeState::Running;
+         return { 0, result };
+
+      case FlatNodeType::BlackboardCondition:
+         // 子が実行中の間だけ Self の中断の対象になる
+         if (result == NodeState::Running) {
+            *slot |= kObserverRunning;
+         } else {
+            *slot &= ~kObserverRunning;
+         }
+         return { 0, result };
+
+      default:
+         return { 0, result };
+   }
+}
+
+void CompiledBehaviorTree::FindRunningChild(const Node& node, const uint32_t* slot, uint32_t& child, uint32_t& ordinal) const {
+   while (child < node.subtreeEnd && slot[ordinal] != kParallelRunning) {
+      child = nodes_[child].subtreeEnd;
+      ++ordinal;
+   }
+}
+
+NodeState CompiledBehaviorTree::FinishParallel(const Node& node, uint32_t* slot) {
+   uint32_t successCount = 0;
+   uint32_t failureCount = 0;
+   for (uint32_t i = 0; i < node.childCount; ++i) {
+      successCount += slot[i] == kParallelSuccess;
+      failureCount += slot[i] == kParallelFailure;
+   }
+
+   NodeState finished = NodeState::Running;
+   switch (static_cast<ParallelPolicy>(node.policy)) {
+      case ParallelPolicy::SuccessWhenAllSucceed:
+         if (successCount == node.childCount) finished = NodeState::Success;
+         else if (failureCount > 0) finished = NodeState::Failure;
+         break;
+      case ParallelPolicy::SuccessWhenAnySucceed:
+         if (successCount > 0) finished = NodeState::Success;
+         else if (failureCount == node.childCount) finished = NodeState::Failure;
+         break;
+      case ParallelPolicy::StopWhenOneFails:
+         if (failureCount > 0) finished = NodeState::Failure;
+         else if (successCount == node.childCount) finished = NodeState::Success;
+         break;
+   }
+   // 終了したら次回に備えて子の結果を消す
+   if (finished != NodeState::Running) {
+      std::fill_n(slot, node.childCount, kParallelRunning);
+   }
+   return finished;
+}
+
+bool CompiledBehaviorTree::ApplyBlackboardChanges(uint32_t* state, const Blackboard& blackboard, uint64_t changedKeys) const {
+   if ((changedKeys & watchedKeys_) == 0) {
+      return false;
+   }
+
+   for (const CompiledObserver& observer : observers_) {
+      if ((changedKeys & (uint64_t{ 1 } << observer.key)) == 0) {
+         continue;
+      }
+      const Node& node = nodes_[observer.node];
+      const uint32_t previous = state[node.stateOffset];
+      const bool passed = observer.Evaluate(blackboard);
+      uint32_t slot = kObserverCached | (passed ? kObserverPassed : 0u) | (previous & kObserverRunning);
+
+      // 実行中の自分の子を中断する（次の Tick で条件を満たさず Failure になる）
+      const bool abortSelf = observer.abort == ObserverAbort::Self || observer.abort == ObserverAbort::Both;
+      if (abortSelf && !passed && (previous & kObserverRunning) != 0) {
+         ResetStateRange(state, observer.node + 1, node.subtreeEnd);
+         slot &= ~kObserverRunning;
+      }
+
+      // 親のセレクターが自分より後ろの子を実行中なら、それを中断して自分から再開させる
+      const bool abortLower = observer.abort == ObserverAbort::LowerPriority || observer.abort == ObserverAbort::Both;
+      const Node& parent = nodes_[observer.parent];
+      if (abortLower && passed && observer.node != 0 && parent.type == FlatNodeType::Selector) {
+         const uint32_t resume = state[parent.stateOffset];
+         if (resume >= node.subtreeEnd) {
+            ResetStateRange(state, node.subtreeEnd, parent.subtreeEnd);
+            state[parent.stateOffset] = observer.node;
+         }
+      }
+
+      state[node.stateOffset] = slot;
+   }
+   return true;
+}
+
+void CompiledBehaviorTree::ResetStateRange(uint32_t* state, uint32_t first, uint32_t end) const {
+   // 状態は前順に割り当てているので、連続したノードの状態も連続している
+   const uint32_t begin = first < nodes_.size() ? nodes_[first].stateOffset : stateSize_;
+   const uint32_t last = end < nodes_.size() ? nodes_[end].stateOffset : stateSize_;
+   std::fill(state + begin, state + last, 0u);
+}
+
+void CompiledBehaviorTree::TickBatch(void* const* agents, uint32_t* states, const Blackboard* const* blackboards, uint8_t* sleeping,
+   size_t count, float deltaTime, NodeState* outResults) const {
+   for (size_t i = 0; i < count; ++i) {
+      // 眠っているエージェントは監視するキーが変わるまで飛ばす
+      if (sleeping && sleeping[i]) {
+         continue;
+      }
+      bool isIdle = false;
+      const NodeState result = Tick(agents[i], states + i * stateSize_, deltaTime, blackboards ? blackboards[i] : nullptr, &isIdle);
+      if (sleeping) {
+         sleeping[i] = isIdle;
+      }
+      if (outResults) {
+         outResults[i] = result;
+      }
+   }
+}
@@ -0,0 +1,335 @@
+#pragma once
+#include "Application/TD2_2/AI/Node/BaseNode.h"
+#include "Application/TD2_2/AI/Node/CompositeNode.h"
+#include "Application/TD2_2/AI/Blackboard/Blackboard.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/// @brief コンパイル済みビヘイビアツリーのノードの種類
+enum class FlatNodeType : uint8_t {
+   Selector,
+   Sequence,
+   Parallel,
+   WeightedSelector,
+   Inverter,
+   Succeeder,
+   Repeater,
+   Retry,
+   BlackboardCondition, // ブラックボードの値を監視する条件デコレーター
+   Condition,        // エージェントを受け取る条件
+   Action,           // エージェントを受け取るアクション
+   SharedCondition,  // 引数なしの条件（全エージェントで同じ関数を呼ぶ）
+   Wait,
+   WaitForEvent,     // ブラックボードが変わるまで Running を返し続ける
+};
+
+/// @brief ブラックボードの条件が変わったときに中断する範囲
+enum class ObserverAbort : uint8_t {
+   None,          // 中断しない（次に入るときの判定だけが変わる）
+   Self,          // 条件を満たさなくなったら、実行中の自分の子を中断する
+   LowerPriority, // 条件を満たすようになったら、親のセレクターで実行中の後ろの子を中断する
+   Both,
+};
+
+/// @brief エージェントを受け取る葉の関数（型を消して保持する）
+struct BehaviorTreeLeaf {
+   using ErasedFunc = void (*)();
+   using Invoker = NodeState (*)(ErasedFunc function, void* agent, float deltaTime);
+
+   ErasedFunc function = nullptr;
+   Invoker invoke = nullptr;
+
+   /// @brief 条件の葉を作る
+   template<typename Agent>
+   static BehaviorTreeLeaf MakeCondition(bool (*condition)(Agent&)) {
+      return { reinterpret_cast<ErasedFunc>(condition), [](ErasedFunc function, void* agent, float) {
+         return reinterpret_cast<bool (*)(Agent&)>(function)(*static_cast<Agent*>(agent)) ? NodeState::Success : NodeState::Failure;
+      } };
+   }
+
+   /// @brief アクションの葉を作る
+   template<typename Agent>
+   static BehaviorTreeLeaf MakeAction(NodeState (*action)(Agent&, float)) {
+      return { reinterpret_cast<ErasedFunc>(action), [](ErasedFunc function, void* agent, float deltaTime) {
+         return reinterpret_cast<NodeState (*)(Agent&, float)>(function)(*static_cast<Agent*>(agent), deltaTime);
+      } };
+   }
+};
+
+/// @brief ブラックボードのキーを監視する条件（型を消して保持する）
+struct BehaviorTreeObserver {
+   using ErasedFunc = BehaviorTreeLeaf::ErasedFunc;
+   using Invoker = bool (*)(ErasedFunc predicate, const Blackboard& blackboard, uint32_t key);
+
+   uint32_t key = 0;
+   ObserverAbort abort = ObserverAbort::None;
+   ErasedFunc predicate = nullptr;
+   Invoker invoke = nullptr;
+
+   bool Evaluate(const Blackboard& blackboard) const { return invoke(predicate, blackboard, key); }
+
+   /// @brief 監視する条件を作る
+   template<typename T>
+   static BehaviorTreeObserver Make(BlackboardKey<T> key, bool (*predicate)(const T&), ObserverAbort abort) {
+      return { key.index, abort, reinterpret_cast<ErasedFunc>(predicate), [](ErasedFunc function, const Blackboard& blackboard, uint32_t index) {
+         return reinterpret_cast<bool (*)(const T&)>(function)(blackboard.Get(BlackboardKey<T>{ index }));
+      } };
+   }
+};
+
+/// @brief コンパイル前のツリーの構造（BehaviorTreeBuilder が記録する）
+struct BehaviorTreeDescription {
+   struct Node {
+      FlatNodeType type = FlatNodeType::Sequence;
+      ParallelPolicy policy = ParallelPolicy::SuccessWhenAllSucceed;
+      float param = 0.0f;    // Waitの秒数・Repeaterの回数
+      float weight = 1.0f;   // 重み付きセレクターの子としての重み
+      uint32_t index = 0;    // 葉の関数・監視する条件の番号
+      std::vector<uint32_t> children;
+   };
+
+   std::vector<Node> nodes;
+   std::vector<BehaviorTreeLeaf> leaves;
+   std::vector<std::function<bool()>> sharedConditions;
+   std::vector<BehaviorTreeObserver> observers;
+};
+
+/// @brief 平坦な配列にコンパイルした、複数のエージェントで共有できるビヘイビアツリー
+/// @details ノードは前順で並べ、子は親の直後に続けて置く（次の兄弟は子の部分木の終わり）。
+/// 実行中の子の位置・Waitの経過時間などエージェントごとに変わる値はノードに持たせず、
+/// エージェントごとの小さな状態ブロック（uint32_t の配列）に置く。
+/// Tick は仮想関数も再帰も使わない1つのループで配列をたどるので、
+/// 多数のエージェントを TickBatch でまとめて実行すると、ノード配列はキャッシュに載ったまま使われる。
+///
+/// BlackboardCondition は条件の結果を状態ブロックに覚えておき、監視するキーが変わったときだけ
+/// ApplyBlackboardChanges で評価し直す（毎Tick評価しない）。中断もそのときだけ行う。
+class CompiledBehaviorTree {
+public:
+   /// @brief ノードの入れ子の上限
+   static constexpr uint32_t kMaxDepth = 32;
+
+   /// @brief コンパイル済みのノード
+   struct Node {
+      FlatNodeType type;
+      uint8_t policy;         // ParallelPolicy
+      uint16_t childCount;
+      uint32_t subtreeEnd;    // 部分木の次のノード（次の兄弟）
+      uint32_t stateOffset;   // 状態ブロック内の位置
+      uint32_t index;         // 葉の関数・監視する条件の番号
+      float param;            // Waitの秒数・Repeaterの回数
+      float weight;           // 重み付きセレクターの子としての重み
+   };
+
+   /// @brief 構造からコンパイルする
+   /// @param description 構造（根は nodes[0]）
+   /// @return コンパイル済みのツリー（変更しないので複数のエージェント・スレッドで共有できる）
+   static std::shared_ptr<const CompiledBehaviorTree> Compile(const BehaviorTreeDescription& description);
+
+   /// @brief エージェントごとの状態ブロックの大きさ（uint32_t の数）
+   uint32_t GetStateSize() const { return stateSize_; }
+
+   /// @brief ノード数
+   uint32_t GetNodeCount() const { return static_cast<uint32_t>(nodes_.size()); }
+
+   /// @brief 状態ブロックを初期状態にする
+   /// @param state 状態ブロック（GetStateSize() 個）
+   /// @param seed 重み付きセレクターの乱数の種
+   void ResetState(uint32_t* state, uint32_t seed) const;
+
+   /// @brief ブラックボードを監視するキー（ビット番号がキーの番号）
+   uint64_t GetWatchedKeys() const { return watchedKeys_; }
+
+   /// @brief 1エージェント分を実行
+   /// @param agent 葉の関数に渡すエージェント
+   /// @param state エージェントの状態ブロック
+   /// @param deltaTime 経過時間（秒）
+   /// @param blackboard エージェントのブラックボード（BlackboardCondition がなければ nullptr可）
+   /// @param outIdle 葉を1つも実行しなかったら true（WaitForEvent・覚えている条件だけで終わった）
+   NodeState Tick(void* agent, uint32_t* state, float deltaTime, const Blackboard* blackboard = nullptr, bool* outIdle = nullptr) const;
+
+   /// @brief ブラックボードの変更を状態ブロックに反映する（次の Tick の前に呼ぶ）
+   /// @details 変更されたキーを監視する条件を評価し直し、ObserverAbort に従って実行中の枝を中断する。
+   /// LowerPriority の中断は直接の親がセレクターのときだけ行う。
+   /// @param changedKeys 変更されたキー（Blackboard::GetChangedKeys）
+   /// @return 監視するキーが変更されていたか（眠っているエージェントを起こすべきか）
+   bool ApplyBlackboardChanges(uint32_t* state, const Blackboard& blackboard, uint64_t changedKeys) const;
+
+   /// @brief 複数のエージェントをまとめて実行
+   /// @param agents エージェントの配列
+   /// @param states 状態ブロックを count 個続けて並べたもの
+   /// @param blackboards エージェントごとのブラックボード（nullptr可）
+   /// @param sleeping エージェントごとの眠っているか（nullptr可）。眠っているエージェントは飛ばし、
+   /// 葉を1つも実行しなかったエージェントは眠らせる
+   /// @param count エージェント数
+   /// @param deltaTime 経過時間（秒）
+   /// @param outResults 結果（nullptr可）
+   void TickBatch(void* const* agents, uint32_t* states, const Blackboard* const* blackboards, uint8_t* sleeping,
+      size_t count, float deltaTime, NodeState* outResults) const;
+
+private:
+   /// @brief 実行中の複合ノード・デコレーター
+   struct Frame {
+      uint32_t node;      // ノードの位置
+      uint32_t child;     // 実行中の子の位置
+      uint32_t ordinal;   // 実行中の子が何番目か（パラレル用）
+   };
+
+   /// @brief 次に実行する子と結果
+   struct Step {
+      uint32_t next;      // 次に実行する子（0なら result を親へ返す）
+      NodeState result;
+   };
+
+   /// @brief 1回の Tick の間だけ使う値
+   struct TickContext {
+      uint32_t* state;
+      const Blackboard* blackboard;
+      float deltaTime;
+      bool didWork;       // 葉を実行したか
+   };
+
+   /// @brief 監視する条件とその位置
+   struct CompiledObserver : BehaviorTreeObserver {
+      uint32_t node;      // BlackboardCondition のノードの位置
+      uint32_t parent;    // 親のノードの位置
+   };
+
+   CompiledBehaviorTree() = default;
+
+   /// @brief 葉・Selector・Sequence 以外のノードに入る（子に入るときは frame を設定する）
+   Step EnterNode(uint32_t index, TickContext& context, Frame& frame, NodeState result) const;
+
+   /// @brief 子の結果を Selector・Sequence 以外の親に渡す
+   Step ResumeNode(Frame& frame, uint32_t* state, NodeState result) const;
+
+   /// @brief 未完了のパラレルの子を child から探す（見つからなければ subtreeEnd）
+   void FindRunningChild(const Node& node, const uint32_t* slot, uint32_t& child, uint32_t& ordinal) const;
+
+   /// @brief パラレルの子の結果をポリシーに従ってまとめる
+   static NodeState FinishParallel(const Node& node, uint32_t* slot);
+
+   /// @brief ノード [first, end) の状態を初期状態に戻す
+   void ResetStateRange(uint32_t* state, uint32_t first, uint32_t end) const;
+
+   std::vector<Node> nodes_;
+   std::vector<BehaviorTreeLeaf> leaves_;
+   std::vector<std::function<bool()>> sharedConditions_;
+   std::vector<CompiledObserver> observers_;
+   uint64_t watchedKeys_ = 0;
+   uint32_t stateSize_ = 1;
+};
+
+/// @brief 1つのコンパイル済みツリーを共有するエージェントの集まり
+/// @details 状態ブロックを1つの配列に続けて並べ、Tick で全員を順に実行する。
+/// 葉を1つも実行しなかったエージェント（WaitForEvent で待っているなど）は眠らせて Tick を飛ばし、
+/// ブラックボードの監視するキーが変わったときにだけ起こす。
+template<typename Agent>
+class BehaviorTreeAgentGroup : public IBlackboardListener {
+public:
+   explicit BehaviorTreeAgentGroup(std::shared_ptr<const CompiledBehaviorTree> tree)
+      : tree_(std::move(tree)) {}
+
+   ~BehaviorTreeAgentGroup() override {
+      for (Blackboard* blackboard : blackboards_) {
+         if (blackboard) {
+            blackboard->SetListener(nullptr, 0);
+         }
+      }
+   }
+
+   BehaviorTreeAgentGroup(const BehaviorTreeAgentGroup&) = delete;
+   BehaviorTreeAgentGroup& operator=(const BehaviorTreeAgentGroup&) = delete;
+
+   /// @brief エージェントを追加
+   /// @param agent エージェント（グループより長く生存すること）
+   /// @param blackboard エージェントのブラックボード（nullptr可。グループより長く生存すること）
+   /// @param seed 乱数の種
+   /// @return エージェントの番号
+   uint32_t Add(Agent* agent, Blackboard* blackboard = nullptr, uint32_t seed = 1) {
+      const uint32_t index = static_cast<uint32_t>(agents_.size());
+      agents_.push_back(agent);
+      blackboards_.push_back(blackboard);
+      sleeping_.push_back(0);
+      states_.resize(states_.size() + tree_->GetStateSize());
+      tree_->ResetState(&states_[static_cast<size_t>(index) * tree_->GetStateSize()], seed);
+      results_.push_back(NodeState::Failure);
+      if (blackboard) {
+         blackboard->SetListener(this, index);
+      }
+      return index;
+   }
+
+   /// @brief エージェントを取り除く（最後のエージェントがその番号に移る）
+   void Remove(uint32_t index) {
+      const size_t stateSize = tree_->GetStateSize();
+      const uint32_t last = static_cast<uint32_t>(agents_.size() - 1);
+      if (blackboards_[index]) {
+         blackboards_[index]->SetListener(nullptr, 0);
+      }
+      agents_[index] = agents_[last];
+      blackboards_[index] = blackboards_[last];
+      sleeping_[index] = sleeping_[last];
+      results_[index] = results_[last];
+      std::copy_n(states_.begin() + last * stateSize, stateSize, states_.begin() + index * stateSize);
+      agents_.pop_back();
+      blackboards_.pop_back();
+      sleeping_.pop_back();
+      results_.pop_back();
+      states_.resize(last * stateSize);
+      if (index != last && blackboards_[index]) {
+         blackboards_[index]->SetListener(this, index);
+      }
+
+      // 通知待ちの番号も移す
+      std::erase(pending_, index);
+      std::replace(pending_.begin(), pending_.end(), last, index);
+   }
+
+   /// @brief 全エージェントを実行
+   void Tick(float deltaTime) {
+      // 前の Tick 以降に変更されたブラックボードだけを反映する
+      std::swap(pending_, processing_);
+      for (uint32_t index : processing_) {
+         Blackboard* blackboard = blackboards_[index];
+         const uint64_t changedKeys = blackboard->GetChangedKeys();
+         blackboard->ClearChangedKeys();
+         if (tree_->ApplyBlackboardChanges(&states_[static_cast<size_t>(index) * tree_->GetStateSize()], *blackboard, changedKeys)) {
+            sleeping_[index] = 0;
+         }
+      }
+      processing_.clear();
+
+      tree_->TickBatch(agents_.data(), states_.data(), blackboards_.data(),
+         sleeping_.data(), agents_.size(), deltaTime, results_.data());
+   }
+
+   /// @brief エージェントの状態を初期状態に戻す
+   void Reset(uint32_t index, uint32_t seed = 1) {
+      tree_->ResetState(&states_[static_cast<size_t>(index) * tree_->GetStateSize()], seed);
+      sleeping_[index] = 0;
+   }
+
+   /// @brief 眠っているエージェントを起こす（ブラックボード以外の理由で Tick させたいとき）
+   void Wake(uint32_t index) { sleeping_[index] = 0; }
+
+   size_t GetCount() const { return agents_.size(); }
+   Agent* GetAgent(uint32_t index) const { return static_cast<Agent*>(agents_[index]); }
+   NodeState GetLastResult(uint32_t index) const { return results_[index]; }
+   bool IsSleeping(uint32_t index) const { return sleeping_[index] != 0; }
+   const CompiledBehaviorTree& GetTree() const { return *tree_; }
+
+   void OnBlackboardChanged(uint32_t id) override { pending_.push_back(id); }
+
+private:
+   std::shared_ptr<const CompiledBehaviorTree> tree_;
+   std::vector<void*> agents_;
+   std::vector<Blackboard*> blackboards_;
+   std::vector<uint8_t> sleeping_;
+   std::vector<uint32_t> states_;
+   std::vector<NodeState> results_;
+   std::vector<uint32_t> pending_;    // 前の Tick 以降に変更されたブラックボードを持つエージェント
+   std::vector<uint32_t> processing_;
+};
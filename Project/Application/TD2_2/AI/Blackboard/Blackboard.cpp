@@ -0,0 +1,25 @@
+#include "Blackboard.h"
+
+Blackboard::Blackboard(std::shared_ptr<const BlackboardLayout> layout)
+   : layout_(std::move(layout)), data_(layout_->defaults_), keyRevisions_(layout_->GetKeyCount(), 0) {}
+
+void Blackboard::SetListener(IBlackboardListener* listener, uint32_t id) {
+   listener_ = listener;
+   listenerId_ = id;
+}
+
+void Blackboard::Write(uint32_t index, const void* value, size_t size) {
+   char* destination = reinterpret_cast<char*>(data_.data()) + layout_->entries_[index].offset;
+   if (std::memcmp(destination, value, size) == 0) {
+      return;
+   }
+   std::memcpy(destination, value, size);
+   keyRevisions_[index] = ++revision_;
+
+   // 変更のなかった状態からの最初の変更だけ通知する
+   const bool isFirstChange = changedKeys_ == 0;
+   changedKeys_ |= uint64_t{ 1 } << index;
+   if (isFirstChange && listener_) {
+      listener_->OnBlackboardChanged(listenerId_);
+   }
+}
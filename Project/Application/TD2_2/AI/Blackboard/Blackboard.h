@@ -0,0 +1,151 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/// @brief ブラックボードのキー（型付きの番号）
+template<typename T>
+struct BlackboardKey {
+   uint32_t index = UINT32_MAX;
+
+   bool IsValid() const { return index != UINT32_MAX; }
+};
+
+namespace BlackboardDetail {
+   /// @brief 型ごとに異なるアドレスを持つ目印（型の取り違えの検出用）
+   template<typename T>
+   inline constexpr char kTypeTag = 0;
+}
+
+/// @brief ブラックボードのキーの並び（同じ種類のエージェントで共有する）
+/// @details 値はキーごとに決まった位置に置くので、Get・Set は名前を引かずに番号だけで済む。
+class BlackboardLayout {
+public:
+   /// @brief キーの上限（変更されたキーを64ビットのマスクで表す）
+   static constexpr uint32_t kMaxKeys = 64;
+
+   /// @brief キーを追加する
+   /// @param name 名前（デバッグ表示用）
+   /// @param initialValue 初期値
+   template<typename T>
+   BlackboardKey<T> Add(const std::string& name, const T& initialValue = T{});
+
+   /// @brief 名前からキーを探す（見つからなければ無効なキー）
+   template<typename T>
+   BlackboardKey<T> Find(const std::string& name) const;
+
+   uint32_t GetKeyCount() const { return static_cast<uint32_t>(entries_.size()); }
+   const std::string& GetName(uint32_t index) const { return entries_[index].name; }
+
+private:
+   friend class Blackboard;
+
+   struct Entry {
+      std::string name;
+      const void* typeTag;
+      uint32_t offset;
+      uint32_t size;
+   };
+
+   std::vector<Entry> entries_;
+   std::vector<uint64_t> defaults_; // 初期値（8バイト境界に揃える）
+   uint32_t dataSize_ = 0;
+};
+
+/// @brief ブラックボードの変更の通知先
+class IBlackboardListener {
+public:
+   virtual ~IBlackboardListener() = default;
+
+   /// @brief 変更のなかったブラックボードに最初の変更があった
+   /// @param id SetListener で渡した番号
+   virtual void OnBlackboardChanged(uint32_t id) = 0;
+};
+
+/// @brief エージェントごとの型付きの値の置き場
+/// @details Set で値が実際に変わったときだけキーを変更済みにし、通知先に知らせる。
+/// 通知は ClearChangedKeys までの最初の1回だけなので、同じフレームに何度書き換えても通知は増えない。
+class Blackboard {
+public:
+   explicit Blackboard(std::shared_ptr<const BlackboardLayout> layout);
+
+   /// @brief 値を取得
+   template<typename T>
+   T Get(BlackboardKey<T> key) const;
+
+   /// @brief 値を設定（同じ値なら何もしない）
+   template<typename T>
+   void Set(BlackboardKey<T> key, const T& value);
+
+   /// @brief 前回の ClearChangedKeys から変更されたキー（ビット番号がキーの番号）
+   uint64_t GetChangedKeys() const { return changedKeys_; }
+
+   /// @brief 変更済みの記録を消す
+   void ClearChangedKeys() { changedKeys_ = 0; }
+
+   /// @brief いずれかのキーが変更されるたびに増える通し番号
+   uint32_t GetRevision() const { return revision_; }
+
+   /// @brief キーが最後に変更されたときの通し番号（ClearChangedKeys では消えない。評価値のキャッシュの無効化用）
+   uint32_t GetKeyRevision(uint32_t index) const { return keyRevisions_[index]; }
+
+   /// @brief 変更の通知先を設定（nullptr で解除）
+   void SetListener(IBlackboardListener* listener, uint32_t id);
+
+   const BlackboardLayout& GetLayout() const { return *layout_; }
+
+private:
+   void Write(uint32_t index, const void* value, size_t size);
+
+   std::shared_ptr<const BlackboardLayout> layout_;
+   std::vector<uint64_t> data_;
+   uint64_t changedKeys_ = 0;
+   uint32_t revision_ = 0;
+   std::vector<uint32_t> keyRevisions_;
+   IBlackboardListener* listener_ = nullptr;
+   uint32_t listenerId_ = 0;
+};
+
+template<typename T>
+inline BlackboardKey<T> BlackboardLayout::Add(const std::string& name, const T& initialValue) {
+   static_assert(std::is_trivially_copyable_v<T>, "Blackboard values must be trivially copyable!");
+   static_assert(alignof(T) <= alignof(uint64_t), "Blackboard values must not be over-aligned!");
+   assert(entries_.size() < kMaxKeys && "Too many blackboard keys!");
+
+   const uint32_t offset = (dataSize_ + alignof(T) - 1) / alignof(T) * alignof(T);
+   dataSize_ = offset + static_cast<uint32_t>(sizeof(T));
+   defaults_.resize((dataSize_ + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+   std::memcpy(reinterpret_cast<char*>(defaults_.data()) + offset, &initialValue, sizeof(T));
+
+   entries_.push_back({ name, &BlackboardDetail::kTypeTag<T>, offset, static_cast<uint32_t>(sizeof(T)) });
+   return { static_cast<uint32_t>(entries_.size() - 1) };
+}
+
+template<typename T>
+inline BlackboardKey<T> BlackboardLayout::Find(const std::string& name) const {
+   for (uint32_t i = 0; i < entries_.size(); ++i) {
+      if (entries_[i].name == name && entries_[i].typeTag == &BlackboardDetail::kTypeTag<T>) {
+         return { i };
+      }
+   }
+   return {};
+}
+
+template<typename T>
+inline T Blackboard::Get(BlackboardKey<T> key) const {
+   const BlackboardLayout::Entry& entry = layout_->entries_[key.index];
+   assert(entry.typeTag == &BlackboardDetail::kTypeTag<T> && "Blackboard key type mismatch!");
+   T value;
+   std::memcpy(&value, reinterpret_cast<const char*>(data_.data()) + entry.offset, sizeof(T));
+   return value;
+}
+
+template<typename T>
+inline void Blackboard::Set(BlackboardKey<T> key, const T& value) {
+   assert(layout_->entries_[key.index].typeTag == &BlackboardDetail::kTypeTag<T> && "Blackboard key type mismatch!");
+   Write(key.index, &value, sizeof(T));
+}
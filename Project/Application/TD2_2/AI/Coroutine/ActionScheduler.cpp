@@ -0,0 +1,136 @@
+#include "ActionScheduler.h"
+#include <algorithm>
+#include <cassert>
+
+#ifdef _DEBUG
+#include <imgui.h>
+#endif
+
+ActionScheduler::~ActionScheduler() {
+   // 残っているタスクが破棄されるときに、このスケジューラーへ触らないようにする
+   for (Slot& slot : slots_) {
+      if (slot.handle) {
+         slot.handle.promise().waitSlot = UINT32_MAX;
+         slot.handle.promise().scheduler = nullptr;
+      }
+   }
+}
+
+void ActionScheduler::Start(ActionTask& task) {
+   ActionTask::Handle handle = task.GetHandle();
+   if (!handle || handle.done()) {
+      return;
+   }
+   assert(handle.promise().waitSlot == UINT32_MAX && "Task is already running!");
+   handle.promise().scheduler = this;
+   handle.resume();
+}
+
+void ActionScheduler::Update(float deltaTime) {
+   time_ += deltaTime;
+   stats_ = {};
+
+   // この更新の前から待っていたものだけを処理する（再開したタスクが新しく待てば次の更新で扱う）
+   scratchFrame_.swap(nextFrame_);
+   scratchPoll_.swap(polling_);
+
+   for (const SlotRef& ref : scratchFrame_) {
+      if (IsCurrent(ref)) {
+         Resume(ref.slot);
+      }
+   }
+   scratchFrame_.clear();
+
+   // 眠っているタスクは、先頭の時刻が来ていなければ触らない
+   while (!timers_.empty() && timers_.front().wakeTime <= time_) {
+      std::pop_heap(timers_.begin(), timers_.end(), IsLater);
+      const SlotRef ref = timers_.back().ref;
+      timers_.pop_back();
+      if (IsCurrent(ref)) {
+         Resume(ref.slot);
+      }
+   }
+
+   for (const SlotRef& ref : scratchPoll_) {
+      if (!IsCurrent(ref)) {
+         continue;
+      }
+      ++stats_.pollCount;
+      if ((*slots_[ref.slot].predicate)()) {
+         Resume(ref.slot);
+      } else {
+         polling_.push_back(ref);
+      }
+   }
+   scratchPoll_.clear();
+}
+
+void ActionScheduler::Sleep(ActionTask::Handle handle, float seconds) {
+   const SlotRef ref = AcquireSlot(handle);
+   timers_.push_back({ time_ + seconds, nextOrder_++, ref });
+   std::push_heap(timers_.begin(), timers_.end(), IsLater);
+}
+
+void ActionScheduler::WaitUntil(ActionTask::Handle handle, const std::function<bool()>* predicate) {
+   const SlotRef ref = AcquireSlot(handle);
+   slots_[ref.slot].predicate = predicate;
+   polling_.push_back(ref);
+}
+
+void ActionScheduler::WaitNextFrame(ActionTask::Handle handle) {
+   nextFrame_.push_back(AcquireSlot(handle));
+}
+
+void ActionScheduler::Cancel(uint32_t slot) {
+   Slot& entry = slots_[slot];
+   entry.handle = nullptr;
+   entry.predicate = nullptr;
+   ++entry.generation;
+   freeSlots_.push_back(slot);
+}
+
+ActionScheduler::SlotRef ActionScheduler::AcquireSlot(ActionTask::Handle handle) {
+   assert(handle.promise().waitSlot == UINT32_MAX && "Task is already waiting!");
+   uint32_t slot;
+   if (!freeSlots_.empty()) {
+      slot = freeSlots_.back();
+      freeSlots_.pop_back();
+   } else {
+      slot = static_cast<uint32_t>(slots_.size());
+      slots_.emplace_back();
+   }
+   slots_[slot].handle = handle;
+   handle.promise().waitSlot = slot;
+   return { slot, slots_[slot].generation };
+}
+
+void ActionScheduler::Resume(uint32_t slot) {
+   ActionTask::Handle handle = slots_[slot].handle;
+   Cancel(slot);
+   handle.promise().waitSlot = UINT32_MAX;
+   ++stats_.resumedCount;
+   handle.resume();
+}
+
+bool ActionScheduler::IsLater(const Timer& a, const Timer& b) {
+   if (a.wakeTime != b.wakeTime) {
+      return a.wakeTime > b.wakeTime;
+   }
+   return a.order > b.order;
+}
+
+void ActionScheduler::DrawImGui() {
+#ifdef _DEBUG
+   if (!ImGui::Begin("Action Scripts")) {
+      ImGui::End();
+      return;
+   }
+
+   ImGui::Text("時間: %.2f s", time_);
+   ImGui::Text("待っているタスク: %u（眠り %zu, 条件 %zu, 毎フレーム %zu）",
+      GetWaitingCount(), timers_.size(), polling_.size(), nextFrame_.size());
+   ImGui::Text("再開: %u, 評価した条件: %u", stats_.resumedCount, stats_.pollCount);
+
+   ImGui::End();
+#endif
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include "ActionTask.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/// @brief ActionTask の待ちを管理し、待ちが明けたタスクだけを再開する
+/// @details Wait で眠っているタスクは起きる時刻の最小ヒープに入れるので、
+/// 何体眠っていても毎フレームの処理は先頭の時刻を1回比べるだけ。
+/// Until のタスクは更新ごとに条件を評価し、NextFrame のタスクは毎回再開する。
+/// 同じ時刻に起きるタスクは待ちに入った順に再開する。
+class ActionScheduler {
+public:
+   /// @brief 直前の Update の記録
+   struct Stats {
+      uint32_t resumedCount = 0;  // 再開したタスクの数
+      uint32_t pollCount = 0;     // 評価した Until の条件の数
+   };
+
+   ActionScheduler() = default;
+   ActionScheduler(const ActionScheduler&) = delete;
+   ActionScheduler& operator=(const ActionScheduler&) = delete;
+   ~ActionScheduler();
+
+   /// @brief タスクを動かし始める（最初の待ちまではこの場で実行する）
+   /// @details タスク（ActionTask）の所有権は呼び出し側に残る。途中で破棄すれば止まる。
+   void Start(ActionTask& task);
+
+   /// @brief 時間を進め、待ちが明けたタスクを再開する
+   void Update(float deltaTime);
+
+   /// @brief スケジューラーの時間（Update で進めた秒数の合計）
+   double GetTime() const { return time_; }
+
+   /// @brief 待っているタスクの数
+   uint32_t GetWaitingCount() const { return static_cast<uint32_t>(slots_.size() - freeSlots_.size()); }
+
+   const Stats& GetStats() const { return stats_; }
+
+   /// @brief ImGuiでのデバッグ表示
+   void DrawImGui();
+
+private:
+   friend struct WaitAwaiter;
+   friend struct UntilAwaiter;
+   friend struct NextFrameAwaiter;
+   friend struct ActionTask::promise_type;
+
+   struct Slot {
+      ActionTask::Handle handle;
+      const std::function<bool()>* predicate = nullptr; // Until の条件（待ちの間はタスクのフレームにある）
+      uint32_t generation = 0;                          // 使い回すたびに増やし、古い参照を見分ける
+   };
+
+   /// @brief スロットへの参照（スロットを使い回した後は無効になる）
+   struct SlotRef {
+      uint32_t slot;
+      uint32_t generation;
+   };
+
+   struct Timer {
+      double wakeTime;
+      uint64_t order;     // 同じ時刻のときは待ちに入った順
+      SlotRef ref;
+   };
+
+   void Sleep(ActionTask::Handle handle, float seconds);
+   void WaitUntil(ActionTask::Handle handle, const std::function<bool()>* predicate);
+   void WaitNextFrame(ActionTask::Handle handle);
+
+   /// @brief 待ちを取り消す（タスクの破棄時）
+   void Cancel(uint32_t slot);
+
+   SlotRef AcquireSlot(ActionTask::Handle handle);
+   bool IsCurrent(const SlotRef& ref) const { return slots_[ref.slot].generation == ref.generation && slots_[ref.slot].handle; }
+
+   /// @brief スロットを空けてタスクを再開する
+   void Resume(uint32_t slot);
+
+   static bool IsLater(const Timer& a, const Timer& b);
+
+   std::vector<Slot> slots_;
+   std::vector<uint32_t> freeSlots_;
+   std::vector<Timer> timers_;        // 起きる時刻の最小ヒープ
+   std::vector<SlotRef> polling_;     // Until で待っている
+   std::vector<SlotRef> nextFrame_;   // NextFrame で待っている
+   std::vector<SlotRef> scratchFrame_; // 作業用
+   std::vector<SlotRef> scratchPoll_;
+
+   double time_ = 0.0;
+   uint64_t nextOrder_ = 0;
+   Stats stats_;
+};
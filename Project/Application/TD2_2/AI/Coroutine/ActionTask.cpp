@@ -0,0 +1,85 @@
+#include "ActionTask.h"
+#include "ActionScheduler.h"
+#include <cassert>
+
+ActionTask::promise_type::~promise_type() {
+   // 待ちの途中で破棄された（取り消された）
+   if (scheduler && waitSlot != UINT32_MAX) {
+      scheduler->Cancel(waitSlot);
+   }
+}
+
+std::coroutine_handle<> ActionTask::FinalAwaiter::await_suspend(Handle handle) noexcept {
+   promise_type& promise = handle.promise();
+   if (promise.join) {
+      return --promise.join->remaining == 0 ? promise.join->parent : std::noop_coroutine();
+   }
+   if (promise.continuation) {
+      return promise.continuation;
+   }
+   return std::noop_coroutine();
+}
+
+std::coroutine_handle<> ActionTask::Awaiter::await_suspend(Handle parent) noexcept {
+   // 子は親と同じスケジューラーで待ち、終わったら親へ戻る
+   child.promise().scheduler = parent.promise().scheduler;
+   child.promise().continuation = parent;
+   return child;
+}
+
+ActionTask& ActionTask::operator=(ActionTask&& other) noexcept {
+   if (this != &other) {
+      Destroy();
+      handle_ = std::exchange(other.handle_, nullptr);
+   }
+   return *this;
+}
+
+void ActionTask::Destroy() {
+   if (handle_) {
+      handle_.destroy();
+      handle_ = nullptr;
+   }
+}
+
+void WaitAwaiter::await_suspend(ActionTask::Handle handle) const {
+   assert(handle.promise().scheduler && "Task is not started by ActionScheduler!");
+   handle.promise().scheduler->Sleep(handle, seconds);
+}
+
+void UntilAwaiter::await_suspend(ActionTask::Handle handle) const {
+   assert(handle.promise().scheduler && "Task is not started by ActionScheduler!");
+   handle.promise().scheduler->WaitUntil(handle, &predicate);
+}
+
+void NextFrameAwaiter::await_suspend(ActionTask::Handle handle) const {
+   assert(handle.promise().scheduler && "Task is not started by ActionScheduler!");
+   handle.promise().scheduler->WaitNextFrame(handle);
+}
+
+bool AllAwaiter::await_suspend(ActionTask::Handle parent) {
+   // 自分の分を1つ足しておき、開始中に子が全部終わっても親をここで再開しないようにする
+   join_.parent = parent;
+   join_.remaining = static_cast<uint32_t>(tasks_.size()) + 1;
+   for (ActionTask& task : tasks_) {
+      ActionTask::Handle child = task.GetHandle();
+      if (!child || child.done()) {
+         --join_.remaining;
+         continue;
+      }
+      child.promise().scheduler = parent.promise().scheduler;
+      child.promise().join = &join_;
+      child.resume();
+   }
+   // 全部がこの場で終わったら待たずに続ける
+   return --join_.remaining != 0;
+}
+
+NodeState AllAwaiter::await_resume() const {
+   for (const ActionTask& task : tasks_) {
+      if (task.GetResult() != NodeState::Success) {
+         return NodeState::Failure;
+      }
+   }
+   return NodeState::Success;
+}
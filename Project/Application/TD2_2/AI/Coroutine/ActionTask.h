@@ -0,0 +1,146 @@
+#pragma once
+#include "Application/TD2_2/AI/Node/BaseNode.h"
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+class ActionScheduler;
+
+/// @brief All で待っている子タスクの数と、揃ったときに再開する親
+struct ActionJoin {
+   std::coroutine_handle<> parent;
+   uint32_t remaining = 0;
+};
+
+/// @brief アクションを手続きとして書くコルーチン
+/// @details ステートマシンとタイマーの代わりに、待ちを co_await で書く。
+/// @code
+/// ActionTask Attack(Boss* boss) {
+///    co_await Wait(0.3f);                                 // 指定秒数だけ眠る（毎フレームの処理はない）
+///    co_await Until([boss]() { return boss->IsReady(); }); // 条件が成り立つまで待つ
+///    co_await All(SubAction(boss), OtherAction(boss));    // 子タスクをまとめて走らせ、全部終わるまで待つ
+///    co_return NodeState::Success;
+/// }
+/// @endcode
+/// 作っただけでは動かず、ActionScheduler::Start（またはタスクの中での co_await）で動き出す。
+/// タスクを破棄すると途中でも止まる（待ちはスケジューラーから外れ、コルーチン内の変数は破棄される）。
+class ActionTask {
+public:
+   struct promise_type;
+   using Handle = std::coroutine_handle<promise_type>;
+
+   /// @brief 終わったときに、待っている親（co_await・All）へ処理を移す
+   struct FinalAwaiter {
+      bool await_ready() const noexcept { return false; }
+      std::coroutine_handle<> await_suspend(Handle handle) noexcept;
+      void await_resume() const noexcept {}
+   };
+
+   struct promise_type {
+      ActionScheduler* scheduler = nullptr; // 待ちを登録するスケジューラー（親から引き継ぐ）
+      std::coroutine_handle<> continuation;  // co_await している親
+      ActionJoin* join = nullptr;            // All で待っている親
+      uint32_t waitSlot = UINT32_MAX;        // スケジューラーで待っている枠
+      NodeState result = NodeState::Running;
+
+      ~promise_type();
+
+      ActionTask get_return_object() { return ActionTask(Handle::from_promise(*this)); }
+      std::suspend_always initial_suspend() const noexcept { return {}; }
+      FinalAwaiter final_suspend() const noexcept { return {}; }
+      void return_value(NodeState state) { result = state; }
+      void unhandled_exception() const noexcept { std::terminate(); }
+   };
+
+   /// @brief 子タスクを最後まで実行し、その結果を返す
+   struct Awaiter {
+      Handle child;
+
+      bool await_ready() const noexcept { return !child || child.done(); }
+      std::coroutine_handle<> await_suspend(Handle parent) noexcept;
+      NodeState await_resume() const noexcept { return child ? child.promise().result : NodeState::Failure; }
+   };
+
+   ActionTask() = default;
+   ActionTask(ActionTask&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+   ActionTask& operator=(ActionTask&& other) noexcept;
+   ActionTask(const ActionTask&) = delete;
+   ActionTask& operator=(const ActionTask&) = delete;
+   ~ActionTask() { Destroy(); }
+
+   bool IsValid() const { return static_cast<bool>(handle_); }
+   bool IsDone() const { return handle_ && handle_.done(); }
+
+   /// @brief 結果（終わっていなければ Running）
+   NodeState GetResult() const { return IsDone() ? handle_.promise().result : NodeState::Running; }
+
+   /// @brief 止めて破棄する
+   void Destroy();
+
+   Handle GetHandle() const { return handle_; }
+
+   Awaiter operator co_await() && noexcept { return { handle_ }; }
+
+private:
+   explicit ActionTask(Handle handle) : handle_(handle) {}
+
+   Handle handle_;
+};
+
+/// @brief 指定秒数（スケジューラーの時間）だけ眠る。0以下なら待たない
+struct WaitAwaiter {
+   float seconds;
+
+   bool await_ready() const noexcept { return seconds <= 0.0f; }
+   void await_suspend(ActionTask::Handle handle) const;
+   void await_resume() const noexcept {}
+};
+
+/// @brief 条件が成り立つまで待つ（条件はスケジューラーの更新ごとに評価する）
+struct UntilAwaiter {
+   std::function<bool()> predicate;
+
+   bool await_ready() const { return predicate(); }
+   void await_suspend(ActionTask::Handle handle) const;
+   void await_resume() const noexcept {}
+};
+
+/// @brief 次のスケジューラーの更新まで待つ（毎フレーム処理するループ用）
+struct NextFrameAwaiter {
+   bool await_ready() const noexcept { return false; }
+   void await_suspend(ActionTask::Handle handle) const;
+   void await_resume() const noexcept {}
+};
+
+/// @brief 子タスクをまとめて走らせ、全部終わるまで待つ
+/// @details 結果は全部が成功なら Success、1つでも失敗があれば Failure。
+class AllAwaiter {
+public:
+   explicit AllAwaiter(std::vector<ActionTask> tasks) : tasks_(std::move(tasks)) {}
+
+   bool await_ready() const noexcept { return tasks_.empty(); }
+   bool await_suspend(ActionTask::Handle parent);
+   NodeState await_resume() const;
+
+private:
+   std::vector<ActionTask> tasks_;
+   ActionJoin join_;
+};
+
+inline WaitAwaiter Wait(float seconds) { return { seconds }; }
+
+inline UntilAwaiter Until(std::function<bool()> predicate) { return { std::move(predicate) }; }
+
+inline NextFrameAwaiter NextFrame() { return {}; }
+
+inline AllAwaiter All(std::vector<ActionTask> tasks) { return AllAwaiter(std::move(tasks)); }
+
+template<typename... Tasks>
+inline AllAwaiter All(Tasks&&... tasks) {
+   std::vector<ActionTask> list;
+   list.reserve(sizeof...(Tasks));
+   (list.push_back(std::forward<Tasks>(tasks)), ...);
+   return AllAwaiter(std::move(list));
+}
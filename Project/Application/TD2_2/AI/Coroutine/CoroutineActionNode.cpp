@@ -0,0 +1,26 @@
+#include "CoroutineActionNode.h"
+#include <cassert>
+
+CoroutineActionNode::CoroutineActionNode(ActionScheduler* scheduler, TaskFactory factory)
+   : scheduler_(scheduler), factory_(std::move(factory)) {
+   assert(scheduler_ && "ActionScheduler is null!");
+}
+
+NodeState CoroutineActionNode::Tick() {
+   if (!task_.IsValid()) {
+      task_ = factory_();
+      scheduler_->Start(task_);
+   }
+
+   if (!task_.IsDone()) {
+      return NodeState::Running;
+   }
+
+   const NodeState result = task_.GetResult();
+   task_.Destroy();
+   return result;
+}
+
+void CoroutineActionNode::Reset() {
+   task_.Destroy();
+}
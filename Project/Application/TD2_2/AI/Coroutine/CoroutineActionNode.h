@@ -0,0 +1,30 @@
+#pragma once
+#include "ActionScheduler.h"
+#include "ActionTask.h"
+#include "Application/TD2_2/AI/Node/LeafNode.h"
+#include <functional>
+
+/// @brief ActionTask を実行するビヘイビアツリーの葉
+/// @details 最初の Tick でタスクを作ってスケジューラーで動かし始め、終わるまで Running を返す。
+/// 待っている間の再開はスケジューラーが行うので、Tick は終わったかを見るだけ。
+class CoroutineActionNode : public LeafNode {
+public:
+   using TaskFactory = std::function<ActionTask()>;
+
+   /// @brief コンストラクタ
+   /// @param scheduler タスクを動かすスケジューラー（ノードより長く生存すること）
+   /// @param factory 実行のたびに新しいタスクを作る関数
+   CoroutineActionNode(ActionScheduler* scheduler, TaskFactory factory);
+
+   NodeState Tick() override;
+
+   /// @brief 実行中のタスクを止める
+   void Reset();
+
+   bool IsRunning() const { return task_.IsValid(); }
+
+private:
+   ActionScheduler* scheduler_;
+   TaskFactory factory_;
+   ActionTask task_;
+};
@@ -0,0 +1,381 @@
+#include "FlowField.h"
+#include "Engine/Utility/Job/JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+   using Clock = std::chrono::steady_clock;
+
+   // ブロックの辺（値が変わった辺の隣のブロックだけを汚す）
+   constexpr uint8_t kEdgeLeft = 1 << 0;
+   constexpr uint8_t kEdgeRight = 1 << 1;
+   constexpr uint8_t kEdgeBottom = 1 << 2;
+   constexpr uint8_t kEdgeTop = 1 << 3;
+   constexpr uint8_t kEdgeInner = 1 << 4;
+
+   // 高速掃引法の4方向（x の向き, y の向き）
+   constexpr int kSweepSteps[4][2] = { { 1, 1 }, { -1, 1 }, { -1, -1 }, { 1, -1 } };
+
+   float ElapsedMicroseconds(Clock::time_point start) {
+      return std::chrono::duration<float, std::micro>(Clock::now() - start).count();
+   }
+}
+
+template<typename Func>
+void FlowField::ForEachBlock(const std::vector<uint32_t>& blocks, JobSystem* jobSystem, const Func& func) {
+   if (!jobSystem || blocks.size() == 1) {
+      for (uint32_t block : blocks) {
+         func(block);
+      }
+      return;
+   }
+   jobSystem->ParallelFor(blocks.size(), 1, [&](uint32_t, size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+         func(blocks[i]);
+      }
+   });
+}
+
+void FlowField::Initialize(const NavigationGrid* grid) {
+   grid_ = grid;
+   targetCell_ = UINT32_MAX;
+   distances_.assign(grid->GetCellCount(), kUnreachable);
+   directions_.assign(grid->GetCellCount(), Vector2{ 0.0f, 0.0f });
+
+   blockCountX_ = (grid->GetWidth() + kBlockSize - 1) / kBlockSize;
+   blockCountY_ = (grid->GetHeight() + kBlockSize - 1) / kBlockSize;
+   const size_t blockCount = static_cast<size_t>(blockCountX_) * blockCountY_;
+   blockDirty_.assign(blockCount, 0);
+   blockEdges_.assign(blockCount, 0);
+   blockTouched_.assign(blockCount, 0);
+   dirtyCount_ = 0;
+   stats_ = {};
+}
+
+void FlowField::Build(uint32_t targetCell, JobSystem* jobSystem) {
+   const Clock::time_point start = Clock::now();
+   stats_ = {};
+   targetCell_ = targetCell;
+
+   std::fill(distances_.begin(), distances_.end(), kUnreachable);
+   distances_[targetCell] = 0.0f;
+   std::fill(blockDirty_.begin(), blockDirty_.end(), static_cast<uint8_t>(0));
+   std::fill(blockTouched_.begin(), blockTouched_.end(), static_cast<uint8_t>(1));
+   dirtyCount_ = 0;
+
+   // 目標と、その隣のセルを持つブロックから掃引を始める
+   const uint32_t x = grid_->GetX(targetCell);
+   const uint32_t y = grid_->GetY(targetCell);
+   const uint32_t bx = x / kBlockSize;
+   const uint32_t by = y / kBlockSize;
+   MarkDirty(by * blockCountX_ + bx);
+   if (x % kBlockSize == 0 && bx > 0) MarkDirty(by * blockCountX_ + bx - 1);
+   if (x % kBlockSize == kBlockSize - 1 && bx + 1 < blockCountX_) MarkDirty(by * blockCountX_ + bx + 1);
+   if (y % kBlockSize == 0 && by > 0) MarkDirty((by - 1) * blockCountX_ + bx);
+   if (y % kBlockSize == kBlockSize - 1 && by + 1 < blockCountY_) MarkDirty((by + 1) * blockCountX_ + bx);
+
+   Solve(jobSystem);
+   UpdateDirections(jobSystem);
+   stats_.microseconds = ElapsedMicroseconds(start);
+}
+
+void FlowField::ApplyGridChanges(const std::vector<uint32_t>& changedCells, JobSystem* jobSystem) {
+   if (!IsBuilt() || changedCells.empty()) {
+      return;
+   }
+   const Clock::time_point start = Clock::now();
+   stats_ = {};
+
+   // 塞がれたセルを未到達にし、そのセルを通っていた下流のセルを辿って未到達に戻す
+   raiseQueue_.clear();
+   for (uint32_t index : changedCells) {
+      const uint32_t block = GetBlock(index);
+      blockTouched_[block] = 1;
+      if (index == targetCell_) {
+         continue;
+      }
+      if (grid_->IsBlocked(index)) {
+         if (distances_[index] != kUnreachable) {
+            raiseQueue_.push_back({ index, distances_[index] });
+            distances_[index] = kUnreachable;
+         }
+      } else {
+         // 通れるようになったセルは、そのブロックの掃引で距離が付く
+         MarkDirty(block);
+      }
+   }
+   RaiseDependents();
+
+   Solve(jobSystem);
+   UpdateDirections(jobSystem);
+   stats_.microseconds = ElapsedMicroseconds(start);
+}
+
+void FlowField::RaiseDependents() {
+   // 下流の隣（距離が消えたセル以上）の更新値が変わったら、そのセルも消して先へ辿る。
+   // 変わらなければ別の隣から同じ距離で届くので、そこで止まる
+   const uint32_t width = grid_->GetWidth();
+   const uint32_t height = grid_->GetHeight();
+   for (size_t head = 0; head < raiseQueue_.size(); ++head) {
+      const RaisedCell raised = raiseQueue_[head];
+      const uint32_t x = grid_->GetX(raised.index);
+      const uint32_t y = grid_->GetY(raised.index);
+      const uint32_t neighbors[4] = {
+         x > 0 ? raised.index - 1 : UINT32_MAX,
+         x + 1 < width ? raised.index + 1 : UINT32_MAX,
+         y > 0 ? raised.index - width : UINT32_MAX,
+         y + 1 < height ? raised.index + width : UINT32_MAX };
+      for (uint32_t neighbor : neighbors) {
+         if (neighbor == UINT32_MAX || neighbor == targetCell_) {
+            continue;
+         }
+         const float distance = distances_[neighbor];
+         if (distance == kUnreachable || distance < raised.distance) {
+            continue;
+         }
+         if (ComputeDistance(grid_->GetX(neighbor), grid_->GetY(neighbor)) != distance) {
+            raiseQueue_.push_back({ neighbor, distance });
+            distances_[neighbor] = kUnreachable;
+         }
+      }
+
+      const uint32_t block = GetBlock(raised.index);
+      MarkDirty(block);
+      blockTouched_[block] = 1;
+   }
+   stats_.resetCells = static_cast<uint32_t>(raiseQueue_.size());
+}
+
+uint32_t FlowField::GetBlock(uint32_t index) const {
+   return (grid_->GetY(index) / kBlockSize) * blockCountX_ + grid_->GetX(index) / kBlockSize;
+}
+
+float FlowField::ComputeDistance(uint32_t x, uint32_t y) const {
+   const uint32_t width = grid_->GetWidth();
+   const size_t index = static_cast<size_t>(y) * width + x;
+
+   float a = x > 0 ? distances_[index - 1] : kUnreachable;
+   if (x + 1 < width) a = (std::min)(a, distances_[index + 1]);
+   float b = y > 0 ? distances_[index - width] : kUnreachable;
+   if (y + 1 < grid_->GetHeight()) b = (std::min)(b, distances_[index + width]);
+   if (a > b) std::swap(a, b);
+
+   if (a == kUnreachable) {
+      return kUnreachable;
+   }
+   // 片側だけから届く場合（もう一方が遠いか未到達）
+   const float difference = b - a;
+   if (difference >= 1.0f) {
+      return a + 1.0f;
+   }
+   // 両側から届く場合は (u - a)^2 + (u - b)^2 = 1 の大きい方の解
+   return (a + b + std::sqrt(2.0f - difference * difference)) * 0.5f;
+}
+
+uint8_t FlowField::SweepBlock(uint32_t block, int stepX, int stepY) {
+   const uint32_t width = grid_->GetWidth();
+   const uint32_t height = grid_->GetHeight();
+   const uint32_t x0 = (block % blockCountX_) * kBlockSize;
+   const uint32_t y0 = (block / blockCountX_) * kBlockSize;
+   const uint32_t x1 = (std::min)(x0 + kBlockSize, width) - 1;
+   const uint32_t y1 = (std::min)(y0 + kBlockSize, height) - 1;
+
+   uint8_t edges = 0;
+   for (uint32_t i = 0; i <= y1 - y0; ++i) {
+      const uint32_t y = stepY > 0 ? y0 + i : y1 - i;
+      const uint32_t rowStart = y * width;
+      float* row = &distances_[rowStart];
+      const float* down = y > 0 ? row - width : nullptr;
+      const float* up = y + 1 < height ? row + width : nullptr;
+      for (uint32_t j = 0; j <= x1 - x0; ++j) {
+         const uint32_t x = stepX > 0 ? x0 + j : x1 - j;
+         if (grid_->IsBlocked(rowStart + x) || rowStart + x == targetCell_) {
+            continue;
+         }
+
+         // ComputeDistance と同じ計算（行のポインターで隣を読む）
+         float a = x > 0 ? row[x - 1] : kUnreachable;
+         if (x + 1 < width) a = (std::min)(a, row[x + 1]);
+         float b = down ? down[x] : kUnreachable;
+         if (up) b = (std::min)(b, up[x]);
+         if (a > b) std::swap(a, b);
+         if (a == kUnreachable) {
+            continue;
+         }
+         const float difference = b - a;
+         const float distance = difference >= 1.0f ? a + 1.0f : (a + b + std::sqrt(2.0f - difference * difference)) * 0.5f;
+
+         if (distance < row[x]) {
+            row[x] = distance;
+            edges |= kEdgeInner;
+            if (x == x0) edges |= kEdgeLeft;
+            if (x == x1) edges |= kEdgeRight;
+            if (y == y0) edges |= kEdgeBottom;
+            if (y == y1) edges |= kEdgeTop;
+         }
+      }
+   }
+   return edges;
+}
+
+void FlowField::Solve(JobSystem* jobSystem) {
+   // 掃引の向きの斜めの列ごとに処理する。同じ列のブロックは辺で接しないので並列に掃引でき、
+   // 上流の隣（前の列）は掃引済み、下流の隣（次の列）は未掃引という、行順の掃引と同じ状態を読む
+   const uint32_t diagonalCount = blockCountX_ + blockCountY_ - 1;
+   uint32_t direction = 0;
+   while (dirtyCount_ > 0) {
+      const int stepX = kSweepSteps[direction][0];
+      const int stepY = kSweepSteps[direction][1];
+
+      for (uint32_t diagonal = 0; diagonal < diagonalCount; ++diagonal) {
+         batch_.clear();
+         const uint32_t first = diagonal >= blockCountX_ ? diagonal - (blockCountX_ - 1) : 0;
+         const uint32_t last = (std::min)(diagonal, blockCountY_ - 1);
+         for (uint32_t i = first; i <= last; ++i) {
+            const uint32_t j = diagonal - i;
+            const uint32_t bx = stepX > 0 ? j : blockCountX_ - 1 - j;
+            const uint32_t by = stepY > 0 ? i : blockCountY_ - 1 - i;
+            const uint32_t block = by * blockCountX_ + bx;
+            if (blockDirty_[block]) {
+               batch_.push_back(block);
+            }
+         }
+         if (batch_.empty()) {
+            continue;
+         }
+
+         ForEachBlock(batch_, jobSystem, [&](uint32_t block) {
+            blockEdges_[block] = SweepBlock(block, stepX, stepY);
+         });
+         stats_.blockUpdates += static_cast<uint32_t>(batch_.size());
+
+         // 値が変わったブロックは別の向きでもう一度、変わった辺の隣はこの後の列か次の掃引で処理する
+         for (uint32_t block : batch_) {
+            blockDirty_[block] = 0;
+            --dirtyCount_;
+            const uint8_t edges = blockEdges_[block];
+            if (!edges) {
+               continue;
+            }
+            const uint32_t bx = block % blockCountX_;
+            const uint32_t by = block / blockCountX_;
+            blockTouched_[block] = 1;
+            MarkDirty(block);
+            if ((edges & kEdgeLeft) && bx > 0) MarkDirty(block - 1);
+            if ((edges & kEdgeRight) && bx + 1 < blockCountX_) MarkDirty(block + 1);
+            if ((edges & kEdgeBottom) && by > 0) MarkDirty(block - blockCountX_);
+            if ((edges & kEdgeTop) && by + 1 < blockCountY_) MarkDirty(block + blockCountX_);
+         }
+      }
+
+      ++stats_.sweepCount;
+      direction = (direction + 1) % 4;
+   }
+}
+
+void FlowField::UpdateDirections(JobSystem* jobSystem) {
+   // 境界のセルの向きは隣のブロックの値も見るので、変わったブロックの周り1つまで求め直す
+   batch_.clear();
+   for (uint32_t by = 0; by < blockCountY_; ++by) {
+      for (uint32_t bx = 0; bx < blockCountX_; ++bx) {
+         bool isTouched = false;
+         for (uint32_t ny = (by > 0 ? by - 1 : 0); ny <= (std::min)(by + 1, blockCountY_ - 1) && !isTouched; ++ny) {
+            for (uint32_t nx = (bx > 0 ? bx - 1 : 0); nx <= (std::min)(bx + 1, blockCountX_ - 1); ++nx) {
+               if (blockTouched_[ny * blockCountX_ + nx]) {
+                  isTouched = true;
+                  break;
+               }
+            }
+         }
+         if (isTouched) {
+            batch_.push_back(by * blockCountX_ + bx);
+         }
+      }
+   }
+
+   const uint32_t width = grid_->GetWidth();
+   const uint32_t height = grid_->GetHeight();
+   ForEachBlock(batch_, jobSystem, [&](uint32_t block) {
+      const uint32_t x0 = (block % blockCountX_) * kBlockSize;
+      const uint32_t y0 = (block / blockCountX_) * kBlockSize;
+      const uint32_t x1 = (std::min)(x0 + kBlockSize, width);
+      const uint32_t y1 = (std::min)(y0 + kBlockSize, height);
+      for (uint32_t y = y0; y < y1; ++y) {
+         for (uint32_t x = x0; x < x1; ++x) {
+            directions_[grid_->GetIndex(x, y)] = ComputeDirection(x, y);
+         }
+      }
+   });
+   std::fill(blockTouched_.begin(), blockTouched_.end(), static_cast<uint8_t>(0));
+}
+
+Vector2 FlowField::ComputeDirection(uint32_t x, uint32_t y) const {
+   const uint32_t width = grid_->GetWidth();
+   const uint32_t height = grid_->GetHeight();
+   const uint32_t index = grid_->GetIndex(x, y);
+   const float distance = distances_[index];
+   if (index == targetCell_) {
+      return { 0.0f, 0.0f };
+   }
+
+   if (grid_->IsBlocked(index) || distance == kUnreachable) {
+      // 障害物の中に押し込まれた場合は、最も近い通れる隣のセルへ出る
+      float best = kUnreachable;
+      Vector2 direction = { 0.0f, 0.0f };
+      for (int dy = -1; dy <= 1; ++dy) {
+         for (int dx = -1; dx <= 1; ++dx) {
+            const int nx = static_cast<int>(x) + dx;
+            const int ny = static_cast<int>(y) + dy;
+            if ((dx == 0 && dy == 0) || nx < 0 || ny < 0 || nx >= static_cast<int>(width) || ny >= static_cast<int>(height)) {
+               continue;
+            }
+            const uint32_t neighbor = grid_->GetIndex(static_cast<uint32_t>(nx), static_cast<uint32_t>(ny));
+            if (!grid_->IsBlocked(neighbor) && distances_[neighbor] < best) {
+               best = distances_[neighbor];
+               direction = { static_cast<float>(dx), static_cast<float>(dy) };
+            }
+         }
+      }
+      return direction.Normalize();
+   }
+
+   // 距離の更新と同じ風上差分で、距離が減る向きを求める
+   const float left = x > 0 ? distances_[index - 1] : kUnreachable;
+   const float right = x + 1 < width ? distances_[index + 1] : kUnreachable;
+   const float down = y > 0 ? distances_[index - width] : kUnreachable;
+   const float up = y + 1 < height ? distances_[index + width] : kUnreachable;
+
+   Vector2 gradient = { 0.0f, 0.0f };
+   if (left < right) {
+      if (left < distance) gradient.x = -(distance - left);
+   } else if (right < distance) {
+      gradient.x = distance - right;
+   }
+   if (down < up) {
+      if (down < distance) gradient.y = -(distance - down);
+   } else if (up < distance) {
+      gradient.y = distance - up;
+   }
+
+   // 斜めの先が塞がれているときは角を削らないよう、強い方の軸だけにする
+   if (gradient.x != 0.0f && gradient.y != 0.0f) {
+      const uint32_t cornerX = gradient.x > 0.0f ? x + 1 : x - 1;
+      const uint32_t cornerY = gradient.y > 0.0f ? y + 1 : y - 1;
+      if (grid_->IsBlocked(grid_->GetIndex(cornerX, cornerY))) {
+         if (std::abs(gradient.x) >= std::abs(gradient.y)) {
+            gradient.y = 0.0f;
+         } else {
+            gradient.x = 0.0f;
+         }
+      }
+   }
+   return gradient.Normalize();
+}
+
+void FlowField::MarkDirty(uint32_t block) {
+   if (!blockDirty_[block]) {
+      blockDirty_[block] = 1;
+      ++dirtyCount_;
+   }
+}
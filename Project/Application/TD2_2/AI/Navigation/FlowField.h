@@ -0,0 +1,109 @@
+#pragma once
+#include "NavigationGrid.h"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+class JobSystem;
+
+/// @brief 直前の Build・ApplyGridChanges の記録
+struct FlowFieldStats {
+   uint32_t sweepCount = 0;      // 掃引の回数（4方向で1周）
+   uint32_t blockUpdates = 0;    // 掃引したブロックの延べ数
+   uint32_t resetCells = 0;      // 障害物で経路が変わり、解き直したセルの数
+   float microseconds = 0.0f;
+};
+
+/// @brief 1つの目標への流れの場（フローフィールド）
+/// @details 各セルに目標までの距離（アイコナール方程式 |∇u| = 1 の1次の風上差分の解）と、
+/// 距離が最も早く減る向きを持つ。エージェントは自分のセルの向きを読むだけなので、何体いても1体 O(1)。
+///
+/// 距離は高速掃引法（4方向の Gauss-Seidel 掃引）で解く。グリッドを kBlockSize 四方のブロックに分け、
+/// 掃引の向きの斜めの列（上流のブロックがすべて済んだブロック）を JobSystem で並列に処理する。
+/// 各セルが読む隣の値は1スレッドで行順に掃引した場合と同じなので、結果はスレッド数によらず同じ。
+/// 値が変わらなかったブロックは、隣から変化が届くまで掃引しない。
+///
+/// 障害物が動いたときは ApplyGridChanges で差分だけ解き直す。塞がれたセルを通っていたセルを下流へ辿って
+/// 未到達に戻し、通れるようになったセルと合わせて、そのブロックから掃引し直す。
+/// 差分更新の結果は作り直した場合と丸め誤差（距離の相対 1e-6 程度）の範囲で一致する。
+class FlowField {
+public:
+   static constexpr uint32_t kBlockSize = 32;
+   static constexpr float kUnreachable = std::numeric_limits<float>::infinity();
+
+   /// @brief グリッドに合わせて初期化（グリッドより先に破棄しないこと）
+   void Initialize(const NavigationGrid* grid);
+
+   /// @brief 目標のセルへの場を最初から作る
+   /// @param targetCell 目標のセル（塞がれていても距離 0 の起点になる）
+   /// @param jobSystem 並列化に使う（nullptr なら呼び出しスレッドだけ）
+   void Build(uint32_t targetCell, JobSystem* jobSystem = nullptr);
+
+   /// @brief グリッドの変化（NavigationGrid::GetChangedCells）を反映する
+   void ApplyGridChanges(const std::vector<uint32_t>& changedCells, JobSystem* jobSystem = nullptr);
+
+   /// @brief ワールド座標での進む向き（正規化済み。到達できない場所や目標のセルでは 0）
+   Vector2 SampleDirection(const Vector2& position) const { return directions_[grid_->WorldToIndex(position)]; }
+
+   /// @brief ワールド座標から目標までの経路の長さ（到達できなければ kUnreachable）
+   float SampleDistance(const Vector2& position) const { return distances_[grid_->WorldToIndex(position)] * grid_->GetCellSize(); }
+
+   /// @brief セル単位の距離（セルの一辺が 1）
+   float GetCellDistance(uint32_t index) const { return distances_[index]; }
+   const Vector2& GetCellDirection(uint32_t index) const { return directions_[index]; }
+
+   uint32_t GetTargetCell() const { return targetCell_; }
+   bool IsBuilt() const { return targetCell_ != UINT32_MAX; }
+   const FlowFieldStats& GetStats() const { return stats_; }
+
+private:
+   /// @brief 1セルの風上差分の更新値
+   float ComputeDistance(uint32_t x, uint32_t y) const;
+
+   /// @brief ブロックを1方向に掃引する
+   /// @return 値の変わった辺（kEdge* の組み合わせ）。中だけ変わった場合は kEdgeInner
+   uint8_t SweepBlock(uint32_t block, int stepX, int stepY);
+
+   /// @brief raiseQueue_ のセルに依存していたセルを辿って未到達に戻す
+   void RaiseDependents();
+
+   /// @brief セルのブロック
+   uint32_t GetBlock(uint32_t index) const;
+
+   /// @brief 汚れたブロックがなくなるまで掃引する
+   void Solve(JobSystem* jobSystem);
+
+   /// @brief 値の変わったブロックとその周りの向きを求め直す
+   void UpdateDirections(JobSystem* jobSystem);
+
+   /// @brief 1セルの向き
+   Vector2 ComputeDirection(uint32_t x, uint32_t y) const;
+
+   void MarkDirty(uint32_t block);
+
+   /// @brief ブロックのリストを並列に処理する（1つだけなら呼び出しスレッドで）
+   template<typename Func>
+   void ForEachBlock(const std::vector<uint32_t>& blocks, JobSystem* jobSystem, const Func& func);
+
+   const NavigationGrid* grid_ = nullptr;
+   uint32_t targetCell_ = UINT32_MAX;
+
+   std::vector<float> distances_;
+   std::vector<Vector2> directions_;
+
+   uint32_t blockCountX_ = 0;
+   uint32_t blockCountY_ = 0;
+   std::vector<uint8_t> blockDirty_;   // 次の掃引で処理する
+   std::vector<uint8_t> blockEdges_;   // 直前の掃引で値が変わった辺
+   std::vector<uint8_t> blockTouched_; // 今回の更新で値が変わった（向きを求め直す）
+   uint32_t dirtyCount_ = 0;
+   std::vector<uint32_t> batch_;       // 作業用
+
+   struct RaisedCell {
+      uint32_t index;
+      float distance; // 未到達に戻す前の距離
+   };
+   std::vector<RaisedCell> raiseQueue_;
+
+   FlowFieldStats stats_;
+};
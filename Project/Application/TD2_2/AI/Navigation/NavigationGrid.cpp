@@ -0,0 +1,115 @@
+#include "NavigationGrid.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+void NavigationGrid::Initialize(const Vector2& areaMin, const Vector2& areaMax, float cellSize) {
+   assert(cellSize > 0.0f && "Cell size must be positive!");
+   origin_ = areaMin;
+   cellSize_ = cellSize;
+   inverseCellSize_ = 1.0f / cellSize;
+   width_ = (std::max)(1u, static_cast<uint32_t>(std::ceil((areaMax.x - areaMin.x) * inverseCellSize_)));
+   height_ = (std::max)(1u, static_cast<uint32_t>(std::ceil((areaMax.y - areaMin.y) * inverseCellSize_)));
+   blockedCount_ = 0;
+
+   blockerCounts_.assign(GetCellCount(), 0);
+   changedFlags_.assign(GetCellCount(), 0);
+   changedCells_.clear();
+}
+
+uint32_t NavigationGrid::WorldToIndex(const Vector2& position) const {
+   const float fx = (position.x - origin_.x) * inverseCellSize_;
+   const float fy = (position.y - origin_.y) * inverseCellSize_;
+   const uint32_t x = fx <= 0.0f ? 0 : (std::min)(static_cast<uint32_t>(fx), width_ - 1);
+   const uint32_t y = fy <= 0.0f ? 0 : (std::min)(static_cast<uint32_t>(fy), height_ - 1);
+   return GetIndex(x, y);
+}
+
+Vector2 NavigationGrid::GetCellCenter(uint32_t index) const {
+   return {
+      origin_.x + (static_cast<float>(GetX(index)) + 0.5f) * cellSize_,
+      origin_.y + (static_cast<float>(GetY(index)) + 0.5f) * cellSize_ };
+}
+
+void NavigationGrid::GetCellRange(const Vector2& rangeMin, const Vector2& rangeMax, uint32_t& outX0, uint32_t& outY0, uint32_t& outX1, uint32_t& outY1) const {
+   const uint32_t minIndex = WorldToIndex(rangeMin);
+   const uint32_t maxIndex = WorldToIndex(rangeMax);
+   outX0 = GetX(minIndex);
+   outY0 = GetY(minIndex);
+   outX1 = GetX(maxIndex);
+   outY1 = GetY(maxIndex);
+}
+
+void NavigationGrid::CollectBoxCells(const Vector2& boxMin, const Vector2& boxMax, std::vector<uint32_t>& outCells) const {
+   uint32_t x0, y0, x1, y1;
+   GetCellRange(boxMin, boxMax, x0, y0, x1, y1);
+
+   const size_t first = outCells.size();
+   for (uint32_t y = y0; y <= y1; ++y) {
+      for (uint32_t x = x0; x <= x1; ++x) {
+         const uint32_t index = GetIndex(x, y);
+         const Vector2 center = GetCellCenter(index);
+         if (center.x >= boxMin.x && center.x <= boxMax.x && center.y >= boxMin.y && center.y <= boxMax.y) {
+            outCells.push_back(index);
+         }
+      }
+   }
+   if (outCells.size() == first) {
+      outCells.push_back(WorldToIndex((boxMin + boxMax) * 0.5f));
+   }
+}
+
+void NavigationGrid::CollectCircleCells(const Vector2& center, float radius, std::vector<uint32_t>& outCells) const {
+   uint32_t x0, y0, x1, y1;
+   GetCellRange({ center.x - radius, center.y - radius }, { center.x + radius, center.y + radius }, x0, y0, x1, y1);
+
+   const size_t first = outCells.size();
+   const float radiusSq = radius * radius;
+   for (uint32_t y = y0; y <= y1; ++y) {
+      for (uint32_t x = x0; x <= x1; ++x) {
+         const uint32_t index = GetIndex(x, y);
+         const Vector2 offset = GetCellCenter(index) - center;
+         if (offset.x * offset.x + offset.y * offset.y <= radiusSq) {
+            outCells.push_back(index);
+         }
+      }
+   }
+   if (outCells.size() == first) {
+      outCells.push_back(WorldToIndex(center));
+   }
+}
+
+void NavigationGrid::AddBlocker(const std::vector<uint32_t>& cells) {
+   for (uint32_t index : cells) {
+      assert(blockerCounts_[index] < UINT16_MAX && "Too many blockers in one cell!");
+      if (blockerCounts_[index]++ == 0) {
+         ++blockedCount_;
+         MarkChanged(index);
+      }
+   }
+}
+
+void NavigationGrid::RemoveBlocker(const std::vector<uint32_t>& cells) {
+   for (uint32_t index : cells) {
+      assert(blockerCounts_[index] > 0 && "Removing a blocker that was never added!");
+      if (--blockerCounts_[index] == 0) {
+         --blockedCount_;
+         MarkChanged(index);
+      }
+   }
+}
+
+void NavigationGrid::ClearChangedCells() {
+   for (uint32_t index : changedCells_) {
+      changedFlags_[index] = 0;
+   }
+   changedCells_.clear();
+}
+
+void NavigationGrid::MarkChanged(uint32_t index) {
+   // 塞いで戻した場合も記録する（フローフィールドは今の状態を見て判断する）
+   if (!changedFlags_[index]) {
+      changedFlags_[index] = 1;
+      changedCells_.push_back(index);
+   }
+}
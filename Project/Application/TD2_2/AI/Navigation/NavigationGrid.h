@@ -0,0 +1,68 @@
+#pragma once
+#include "MathCore.h"
+#include <cstdint>
+#include <vector>
+
+/// @brief アリーナを覆う一様なナビゲーショングリッド（XY平面）
+/// @details セルごとに「そのセルを塞いでいる障害物の数」を持ち、0 なら通れる。
+/// 障害物の追加・削除で通れる／通れないが切り替わったセルを記録し、フローフィールドの差分更新に渡す。
+class NavigationGrid {
+public:
+   /// @brief 初期化（全セル通行可能）
+   /// @param areaMin 範囲の最小の角
+   /// @param areaMax 範囲の最大の角
+   /// @param cellSize セルの一辺の長さ
+   void Initialize(const Vector2& areaMin, const Vector2& areaMax, float cellSize);
+
+   uint32_t GetWidth() const { return width_; }
+   uint32_t GetHeight() const { return height_; }
+   uint32_t GetCellCount() const { return width_ * height_; }
+   float GetCellSize() const { return cellSize_; }
+   const Vector2& GetOrigin() const { return origin_; }
+
+   uint32_t GetIndex(uint32_t x, uint32_t y) const { return y * width_ + x; }
+   uint32_t GetX(uint32_t index) const { return index % width_; }
+   uint32_t GetY(uint32_t index) const { return index / width_; }
+
+   /// @brief ワールド座標のセル（範囲の外は一番近い端のセル）
+   uint32_t WorldToIndex(const Vector2& position) const;
+
+   /// @brief セルの中心のワールド座標
+   Vector2 GetCellCenter(uint32_t index) const;
+
+   bool IsBlocked(uint32_t index) const { return blockerCounts_[index] != 0; }
+   uint32_t GetBlockedCount() const { return blockedCount_; }
+
+   /// @brief 中心が箱の中にあるセルを集める（箱が小さくても、箱の中心のセルは必ず含む）
+   void CollectBoxCells(const Vector2& boxMin, const Vector2& boxMax, std::vector<uint32_t>& outCells) const;
+
+   /// @brief 中心が円の中にあるセルを集める（円が小さくても、円の中心のセルは必ず含む）
+   void CollectCircleCells(const Vector2& center, float radius, std::vector<uint32_t>& outCells) const;
+
+   /// @brief セルを塞ぐ（同じセルを複数の障害物が塞いでもよい）
+   void AddBlocker(const std::vector<uint32_t>& cells);
+
+   /// @brief AddBlocker で塞いだセルを戻す
+   void RemoveBlocker(const std::vector<uint32_t>& cells);
+
+   /// @brief 前回の ClearChangedCells から通れる／通れないが切り替わったセル（重複なし）
+   const std::vector<uint32_t>& GetChangedCells() const { return changedCells_; }
+   void ClearChangedCells();
+
+private:
+   /// @brief 範囲のセルの座標を求める（範囲の外は端に寄せる）
+   void GetCellRange(const Vector2& rangeMin, const Vector2& rangeMax, uint32_t& outX0, uint32_t& outY0, uint32_t& outX1, uint32_t& outY1) const;
+
+   void MarkChanged(uint32_t index);
+
+   Vector2 origin_ = { 0.0f, 0.0f };
+   float cellSize_ = 1.0f;
+   float inverseCellSize_ = 1.0f;
+   uint32_t width_ = 0;
+   uint32_t height_ = 0;
+   uint32_t blockedCount_ = 0;
+
+   std::vector<uint16_t> blockerCounts_; // セルを塞いでいる障害物の数
+   std::vector<uint8_t> changedFlags_;   // changedCells_ に入っているか
+   std::vector<uint32_t> changedCells_;
+};
@@ -0,0 +1,232 @@
+#include "NavigationService.h"
+#include "Application/TD2_2/Collider/AABBCollider.h"
+#include "Application/TD2_2/Collider/SphereCollider.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+#ifdef _DEBUG
+#include <imgui.h>
+#endif
+
+namespace {
+   using Clock = std::chrono::steady_clock;
+}
+
+void NavigationService::Initialize(const NavigationSettings& settings, uint32_t workerCount) {
+   settings_ = settings;
+   grid_.Initialize(settings.areaMin, settings.areaMax, settings.cellSize);
+   jobSystem_.Initialize(workerCount);
+   obstacles_.clear();
+   targets_.clear();
+}
+
+void NavigationService::Finalize() {
+   jobSystem_.Finalize();
+}
+
+NavObstacleHandle NavigationService::AddObstacle(const Collider* collider) {
+   if (!collider || (collider->GetType() != ColliderType::Sphere && collider->GetType() != ColliderType::AABB)) {
+      return {};
+   }
+
+   // 空いている番号を使い回す
+   uint32_t id = 0;
+   while (id < obstacles_.size() && obstacles_[id].isActive) {
+      ++id;
+   }
+   if (id == obstacles_.size()) {
+      obstacles_.emplace_back();
+   }
+
+   Obstacle& obstacle = obstacles_[id];
+   obstacle.collider = collider;
+   obstacle.cells.clear();
+   obstacle.isActive = true;
+   RasterizeObstacle(obstacle);
+   return { id };
+}
+
+void NavigationService::RemoveObstacle(NavObstacleHandle handle) {
+   if (!handle.IsValid() || handle.id >= obstacles_.size() || !obstacles_[handle.id].isActive) {
+      return;
+   }
+   Obstacle& obstacle = obstacles_[handle.id];
+   grid_.RemoveBlocker(obstacle.cells);
+   obstacle.cells.clear();
+   obstacle.collider = nullptr;
+   obstacle.isActive = false;
+}
+
+NavTargetHandle NavigationService::AddTarget(const Vector3& position) {
+   uint32_t id = 0;
+   while (id < targets_.size() && targets_[id].isActive) {
+      ++id;
+   }
+   if (id == targets_.size()) {
+      targets_.emplace_back();
+   }
+
+   Target& target = targets_[id];
+   target.field.Initialize(&grid_);
+   target.requestedCell = grid_.WorldToIndex({ position.x, position.y });
+   target.isActive = true;
+   return { id };
+}
+
+void NavigationService::RemoveTarget(NavTargetHandle handle) {
+   if (!handle.IsValid() || handle.id >= targets_.size()) {
+      return;
+   }
+   targets_[handle.id].isActive = false;
+}
+
+void NavigationService::SetTargetPosition(NavTargetHandle handle, const Vector3& position) {
+   if (!handle.IsValid() || handle.id >= targets_.size() || !targets_[handle.id].isActive) {
+      return;
+   }
+   targets_[handle.id].requestedCell = grid_.WorldToIndex({ position.x, position.y });
+}
+
+void NavigationService::Update() {
+   const Clock::time_point start = Clock::now();
+
+   // 動いた障害物だけを塗り直す（静的な障害物は何もしない）
+   for (Obstacle& obstacle : obstacles_) {
+      if (obstacle.isActive) {
+         RasterizeObstacle(obstacle);
+      }
+   }
+
+   // 目標が動いた場は作り直し、それ以外は変わったセルだけを反映する
+   const std::vector<uint32_t>& changedCells = grid_.GetChangedCells();
+   lastChangedCellCount_ = static_cast<uint32_t>(changedCells.size());
+   lastRebuildCount_ = 0;
+   for (Target& target : targets_) {
+      if (!target.isActive) {
+         continue;
+      }
+      if (NeedsRebuild(target)) {
+         target.field.Build(target.requestedCell, &jobSystem_);
+         ++lastRebuildCount_;
+      } else {
+         target.field.ApplyGridChanges(changedCells, &jobSystem_);
+      }
+   }
+   grid_.ClearChangedCells();
+
+   lastUpdateMicroseconds_ = std::chrono::duration<float, std::micro>(Clock::now() - start).count();
+   peakUpdateMicroseconds_ = (std::max)(peakUpdateMicroseconds_, lastUpdateMicroseconds_);
+}
+
+Vector2 NavigationService::GetDirection(NavTargetHandle handle, const Vector3& position) const {
+   const FlowField* field = GetFlowField(handle);
+   if (!field) {
+      return { 0.0f, 0.0f };
+   }
+   return field->SampleDirection({ position.x, position.y });
+}
+
+float NavigationService::GetDistance(NavTargetHandle handle, const Vector3& position) const {
+   const FlowField* field = GetFlowField(handle);
+   if (!field) {
+      return FlowField::kUnreachable;
+   }
+   return field->SampleDistance({ position.x, position.y });
+}
+
+const FlowField* NavigationService::GetFlowField(NavTargetHandle handle) const {
+   if (!handle.IsValid() || handle.id >= targets_.size()) {
+      return nullptr;
+   }
+   const Target& target = targets_[handle.id];
+   return target.isActive && target.field.IsBuilt() ? &target.field : nullptr;
+}
+
+void NavigationService::RasterizeObstacle(Obstacle& obstacle) {
+   const Collider* collider = obstacle.collider;
+   const Vector3 position = collider->GetPosition();
+   const float inflate = settings_.agentRadius;
+
+   Vector2 boundsMin;
+   Vector2 boundsMax;
+   float radius = 0.0f;
+   if (collider->GetType() == ColliderType::Sphere) {
+      radius = static_cast<const SphereCollider*>(collider)->GetRadius() + inflate;
+      boundsMin = { position.x - radius, position.y - radius };
+      boundsMax = { position.x + radius, position.y + radius };
+   } else {
+      const AABBCollider* aabb = static_cast<const AABBCollider*>(collider);
+      const Vector3 min = aabb->GetMin();
+      const Vector3 max = aabb->GetMax();
+      boundsMin = { min.x - inflate, min.y - inflate };
+      boundsMax = { max.x + inflate, max.y + inflate };
+   }
+
+   const bool isPlaced = !obstacle.cells.empty();
+   if (isPlaced && boundsMin.x == obstacle.boundsMin.x && boundsMin.y == obstacle.boundsMin.y &&
+      boundsMax.x == obstacle.boundsMax.x && boundsMax.y == obstacle.boundsMax.y) {
+      return;
+   }
+   obstacle.boundsMin = boundsMin;
+   obstacle.boundsMax = boundsMax;
+
+   scratchCells_.clear();
+   if (collider->GetType() == ColliderType::Sphere) {
+      grid_.CollectCircleCells({ position.x, position.y }, radius, scratchCells_);
+   } else {
+      grid_.CollectBoxCells(boundsMin, boundsMax, scratchCells_);
+   }
+   if (isPlaced && scratchCells_ == obstacle.cells) {
+      return;
+   }
+
+   // 新しいセルを先に塞いでから古いセルを戻すと、重なったセルは切り替わらない
+   grid_.AddBlocker(scratchCells_);
+   grid_.RemoveBlocker(obstacle.cells);
+   obstacle.cells.swap(scratchCells_);
+}
+
+bool NavigationService::NeedsRebuild(const Target& target) const {
+   if (!target.field.IsBuilt()) {
+      return true;
+   }
+   const uint32_t current = target.field.GetTargetCell();
+   const uint32_t dx = static_cast<uint32_t>(std::abs(static_cast<int>(grid_.GetX(target.requestedCell)) - static_cast<int>(grid_.GetX(current))));
+   const uint32_t dy = static_cast<uint32_t>(std::abs(static_cast<int>(grid_.GetY(target.requestedCell)) - static_cast<int>(grid_.GetY(current))));
+   return (std::max)(dx, dy) >= (std::max)(settings_.rebuildCellDistance, 1u);
+}
+
+void NavigationService::DrawImGui() {
+#ifdef _DEBUG
+   if (!ImGui::Begin("Navigation")) {
+      ImGui::End();
+      return;
+   }
+
+   int rebuildCellDistance = static_cast<int>(settings_.rebuildCellDistance);
+   if (ImGui::DragInt("作り直す目標の移動（セル）", &rebuildCellDistance, 0.1f, 1, 32)) {
+      settings_.rebuildCellDistance = static_cast<uint32_t>((std::max)(rebuildCellDistance, 1));
+   }
+
+   ImGui::Separator();
+   ImGui::Text("グリッド: %u x %u（セル %.2f）, 塞がれたセル: %u", grid_.GetWidth(), grid_.GetHeight(), settings_.cellSize, grid_.GetBlockedCount());
+   ImGui::Text("ワーカー: %u", jobSystem_.GetWorkerCount());
+   ImGui::Text("更新: %.1f us (最大 %.1f us), 変わったセル: %u, 作り直し: %u",
+      lastUpdateMicroseconds_, peakUpdateMicroseconds_, lastChangedCellCount_, lastRebuildCount_);
+   if (ImGui::Button("記録をリセット")) {
+      peakUpdateMicroseconds_ = 0.0f;
+   }
+
+   for (size_t i = 0; i < targets_.size(); ++i) {
+      if (!targets_[i].isActive) {
+         continue;
+      }
+      const FlowFieldStats& stats = targets_[i].field.GetStats();
+      ImGui::Text("目標 %zu: %.1f us, 掃引 %u 回, ブロック %u, 解き直し %u",
+         i, stats.microseconds, stats.sweepCount, stats.blockUpdates, stats.resetCells);
+   }
+
+   ImGui::End();
+#endif
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include "FlowField.h"
+#include "NavigationGrid.h"
+#include "Engine/Utility/Job/JobSystem.h"
+#include "MathCore.h"
+#include <cstdint>
+#include <vector>
+
+class Collider;
+
+/// @brief ナビゲーションに登録した障害物の番号
+struct NavObstacleHandle {
+   uint32_t id = UINT32_MAX;
+
+   bool IsValid() const { return id != UINT32_MAX; }
+};
+
+/// @brief ナビゲーションに登録した目標の番号
+struct NavTargetHandle {
+   uint32_t id = UINT32_MAX;
+
+   bool IsValid() const { return id != UINT32_MAX; }
+};
+
+/// @brief ナビゲーションの設定
+struct NavigationSettings {
+   Vector2 areaMin = { -55.0f, -55.0f }; // グリッドが覆う範囲
+   Vector2 areaMax = { 55.0f, 55.0f };
+   float cellSize = 1.0f;                // セルの一辺の長さ
+   float agentRadius = 0.6f;             // 障害物をこの分だけ太らせて塞ぐ（エージェントの半径）
+   uint32_t rebuildCellDistance = 1;     // 目標がこのセル数だけ動いたら場を作り直す
+};
+
+/// @brief アリーナのナビゲーション（障害物のグリッドと、目標ごとのフローフィールド）
+/// @details 障害物のコライダーをグリッドに塗り、毎フレーム動いたものだけを塗り直して、
+/// 変わったセルを全目標のフローフィールドに差分で反映する。目標が動いた場合はその場を作り直す。
+/// エージェントは GetDirection で自分の位置の向きを読むだけなので、A* と違い何体いても1体 O(1)。
+class NavigationService {
+public:
+   /// @brief 初期化
+   /// @param workerCount フローフィールドを解くワーカー数（0の場合は呼び出しスレッドだけ）
+   void Initialize(const NavigationSettings& settings, uint32_t workerCount);
+
+   /// @brief ワーカースレッドを停止
+   void Finalize();
+
+   /// @brief 障害物を登録（Sphere・AABB。コライダーは登録を解除するまで生存すること）
+   NavObstacleHandle AddObstacle(const Collider* collider);
+
+   /// @brief 障害物の登録を解除
+   void RemoveObstacle(NavObstacleHandle handle);
+
+   /// @brief 目標を登録
+   NavTargetHandle AddTarget(const Vector3& position);
+
+   /// @brief 目標の登録を解除
+   void RemoveTarget(NavTargetHandle handle);
+
+   /// @brief 目標の位置を設定（場は次の Update で作り直す）
+   void SetTargetPosition(NavTargetHandle handle, const Vector3& position);
+
+   /// @brief 動いた障害物を塗り直し、フローフィールドを更新する
+   void Update();
+
+   /// @brief 目標へ向かう向き（XY平面、正規化済み。到達できない場所や目標のすぐ近くでは 0）
+   Vector2 GetDirection(NavTargetHandle handle, const Vector3& position) const;
+
+   /// @brief 目標までの経路の長さ（到達できなければ FlowField::kUnreachable）
+   float GetDistance(NavTargetHandle handle, const Vector3& position) const;
+
+   const NavigationGrid& GetGrid() const { return grid_; }
+   const NavigationSettings& GetSettings() const { return settings_; }
+   const FlowField* GetFlowField(NavTargetHandle handle) const;
+
+   /// @brief ImGuiでのデバッグ表示
+   void DrawImGui();
+
+private:
+   struct Obstacle {
+      const Collider* collider = nullptr;
+      Vector2 boundsMin = { 0.0f, 0.0f }; // 太らせた後の外接矩形（変化の検出用）
+      Vector2 boundsMax = { 0.0f, 0.0f };
+      std::vector<uint32_t> cells;         // 塞いでいるセル
+      bool isActive = false;
+   };
+
+   struct Target {
+      FlowField field;
+      uint32_t requestedCell = 0;
+      bool isActive = false;
+   };
+
+   /// @brief 障害物が動いていれば塗り直す
+   void RasterizeObstacle(Obstacle& obstacle);
+
+   /// @brief 場を作り直すほど目標が動いたか
+   bool NeedsRebuild(const Target& target) const;
+
+   NavigationSettings settings_;
+   NavigationGrid grid_;
+   JobSystem jobSystem_;
+   std::vector<Obstacle> obstacles_;
+   std::vector<Target> targets_;
+   std::vector<uint32_t> scratchCells_; // 作業用
+
+   float lastUpdateMicroseconds_ = 0.0f;
+   float peakUpdateMicroseconds_ = 0.0f;
+   uint32_t lastRebuildCount_ = 0;
+   uint32_t lastChangedCellCount_ = 0;
+};
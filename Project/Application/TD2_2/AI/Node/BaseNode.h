@@ -3,7 +3,6 @@
 #include <memory>
 #include <vector>
 #include <random>
-#include "EngineSystem.h"
 
 // ノードの実行結果を表す列挙体
 enum class NodeState {
@@ -1,5 +1,6 @@
 #define NOMINMAX
 #include "CompositeNode.h"
+#include "Application/TD2_2/AI/Blackboard/Blackboard.h"
 #include <random>
 #include <algorithm>
 
@@ -157,12 +158,28 @@ NodeState RandomSelectorNode::Tick() {
 }
 
 void WeightedRandomSelectorNode::AddChild(std::unique_ptr<BaseNode> child, float staticWeight) {
-   auto eval = std::make_unique<LambdaEvaluator>([=]() { return staticWeight; });
-   entries_.push_back({ std::move(child), std::move(eval) });
+   // 固定の重みは評価関数を持たず、ここで一度だけ決める
+   entries_.push_back({ std::move(child), nullptr, 0 });
+   weights_.push_back(std::max(0.0f, staticWeight));
+   isTableDirty_ = true;
 }
 
 void WeightedRandomSelectorNode::AddChild(std::unique_ptr<BaseNode> child, std::unique_ptr<IEvaluator> evaluator){
-   entries_.push_back({ std::move(child), std::move(evaluator) });
+   AddChild(std::move(child), std::move(evaluator), 0);
+}
+
+void WeightedRandomSelectorNode::AddChild(std::unique_ptr<BaseNode> child, std::unique_ptr<IEvaluator> evaluator, uint64_t watchedKeys) {
+   const uint32_t index = static_cast<uint32_t>(entries_.size());
+   (watchedKeys != 0 ? watchedEntries_ : dynamicEntries_).push_back(index);
+   entries_.push_back({ std::move(child), std::move(evaluator), watchedKeys });
+   weights_.push_back(0.0f);
+   hasEvaluated_ = false;
+   isTableDirty_ = true;
+}
+
+void WeightedRandomSelectorNode::SetBlackboard(const Blackboard* blackboard) {
+   blackboard_ = blackboard;
+   hasEvaluated_ = false;
 }
 
 NodeState WeightedRandomSelectorNode::Tick() {
@@ -177,30 +194,61 @@ NodeState WeightedRandomSelectorNode::Tick() {
 	  return state;
    }
 
-   // 各ノードの評価値を計算
-   std::vector<float> weights;
-   weights.reserve(entries_.size());
-   for (auto& e : entries_) {
-	  float w = e.evaluator ? e.evaluator->Evaluate() : 0.0f;
-	  weights.push_back(std::max(0.0f, w));
+   // 各ノードの評価値を更新（合計が0なら選べない）
+   if (!UpdateWeights()) return NodeState::Failure;
+
+   // ランダム選択
+   const size_t index = table_.Sample(static_cast<uint32_t>(rng_()));
+   NodeState state = entries_[index].node->Tick();
+   if (state == NodeState::Running) {
+	  currentIndex_ = static_cast<int>(index);
    }
+   return state;
+}
 
-   // 合計
-   float totalWeight = std::accumulate(weights.begin(), weights.end(), 0.0f);
-   if (totalWeight <= 0.0f) return NodeState::Failure;
+bool WeightedRandomSelectorNode::UpdateWeights() {
+   bool isChanged = isTableDirty_;
+   for (uint32_t index : dynamicEntries_) {
+	  isChanged |= EvaluateEntry(index);
+   }
 
-   // ランダム選択
-   std::uniform_real_distribution<float> dist(0.0f, totalWeight);
-   float r = dist(rng_);
-
-   float cumulative = 0.0f;
-   for (size_t i = 0; i < entries_.size(); ++i) {
-	  cumulative += weights[i];
-	  if (r <= cumulative) {
-		 currentIndex_ = static_cast<int>(i);
-		 return entries_[i].node->Tick();
+   // 依存のある評価関数は、ブラックボードが変わったときに変わったキーの分だけ評価する
+   if (!blackboard_ || !hasEvaluated_) {
+	  for (uint32_t index : watchedEntries_) {
+		 isChanged |= EvaluateEntry(index);
+	  }
+   } else if (blackboard_->GetRevision() != evaluatedRevision_) {
+	  for (uint32_t index : watchedEntries_) {
+		 if (IsWatchedKeyChanged(entries_[index].watchedKeys)) {
+			isChanged |= EvaluateEntry(index);
+		 }
 	  }
    }
 
-   return NodeState::Failure;
+   if (blackboard_) evaluatedRevision_ = blackboard_->GetRevision();
+   hasEvaluated_ = true;
+
+   // 重みが変わったときだけ表を作り直す
+   if (isChanged) {
+	  isTableValid_ = table_.Build(weights_.data(), weights_.size());
+	  isTableDirty_ = false;
+   }
+   return isTableValid_;
+}
+
+bool WeightedRandomSelectorNode::EvaluateEntry(uint32_t index) {
+   const Entry& entry = entries_[index];
+   float w = entry.evaluator ? std::max(0.0f, entry.evaluator->Evaluate()) : 0.0f;
+   if (w == weights_[index]) return false;
+   weights_[index] = w;
+   return true;
+}
+
+bool WeightedRandomSelectorNode::IsWatchedKeyChanged(uint64_t watchedKeys) const {
+   for (uint32_t key = 0; watchedKeys != 0; ++key, watchedKeys >>= 1) {
+	  if ((watchedKeys & 1) != 0 && blackboard_->GetKeyRevision(key) > evaluatedRevision_) {
+		 return true;
+	  }
+   }
+   return false;
 }
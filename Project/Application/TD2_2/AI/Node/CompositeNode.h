@@ -4,6 +4,9 @@
 #include <memory>
 #include <numeric>
 #include "Evaluator.h"
+#include "Engine/Utility/Random/AliasTable.h"
+
+class Blackboard;
 
 /// @brief 子ノードを複数持つノードの基底クラス
 class CompositeNode : public BaseNode {
@@ -58,11 +61,14 @@ public:
 };
 
 /// @brief 重み付きランダムセレクターノード - 子ノードを重みに基づいてランダムに選択して実行する
+/// @details 重みは選び直すときだけ評価し、前回から変わったときだけエイリアス表を作り直す（選ぶのは O(1)）。
+/// 固定の重みは評価しない。ブラックボードのキーに依存する評価関数は、そのキーが変わったときだけ評価し直す。
 class WeightedRandomSelectorNode : public CompositeNode {
 public:
    struct Entry {
       std::unique_ptr<BaseNode> node;
-      std::unique_ptr<IEvaluator> evaluator;
+      std::unique_ptr<IEvaluator> evaluator;  // nullptr なら固定の重み
+      uint64_t watchedKeys = 0;               // 0 以外ならこのキーが変わったときだけ評価し直す
    };
 
    // 通常の固定重み
@@ -71,9 +77,35 @@ public:
    // 動的な評価関数
    void AddChild(std::unique_ptr<BaseNode> child, std::unique_ptr<IEvaluator> evaluator);
 
+   /// @brief ブラックボードの値だけに依存する評価関数（SetBlackboard が必要）
+   /// @param watchedKeys 依存するキーのビット（BlackboardKey::index 番目のビットを立てる）
+   void AddChild(std::unique_ptr<BaseNode> child, std::unique_ptr<IEvaluator> evaluator, uint64_t watchedKeys);
+
+   /// @brief 依存を調べるブラックボード（未設定なら watchedKeys のある評価関数も毎回評価する）
+   void SetBlackboard(const Blackboard* blackboard);
+
    NodeState Tick() override;
 
 private:
+   /// @brief 重みを評価し直し、変わっていればエイリアス表を作り直す
+   /// @return 選べる子があれば true
+   bool UpdateWeights();
+
+   /// @brief 前回の評価から watchedKeys のいずれかが変わったか
+   bool IsWatchedKeyChanged(uint64_t watchedKeys) const;
+
+   /// @brief entries_[index] を評価し、重みが変わったら true
+   bool EvaluateEntry(uint32_t index);
+
    std::vector<Entry> entries_;
+   std::vector<float> weights_;            // 最後に評価した重み（entries_ と同じ順）
+   std::vector<uint32_t> dynamicEntries_;  // 毎回評価する子の番号
+   std::vector<uint32_t> watchedEntries_;  // ブラックボードのキーが変わったときだけ評価する子の番号
+   AliasTable table_;
+   const Blackboard* blackboard_ = nullptr;
+   uint32_t evaluatedRevision_ = 0;        // 最後に評価したときのブラックボードの通し番号
+   bool hasEvaluated_ = false;             // 依存のある評価関数も含めて一度評価したか
+   bool isTableDirty_ = true;              // 子が増えたので表を作り直す
+   bool isTableValid_ = false;             // 重みの合計が正
    int currentIndex_ = -1;
-};
\ No newline at end of file
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include "MathCore.h"
+#include <cstdint>
+#include <vector>
+
+/// @brief AIが読むエージェントの状態（AIの並列フェーズの間は変更しない）
+struct AIAgentSnapshot {
+   Vector3 position = { 0.0f, 0.0f, 0.0f };
+   Vector3 velocity = { 0.0f, 0.0f, 0.0f };
+   float hp = 0.0f;
+   uint32_t state = 0;   // ステートマシンの状態
+   uint32_t team = 0;
+};
+
+/// @brief AIが読む世界の状態（フレームの初めに作り、AIの並列フェーズの間は読み取り専用）
+struct AIWorldSnapshot {
+   uint64_t frame = 0;
+   float deltaTime = 0.0f;
+   Vector3 playerPosition = { 0.0f, 0.0f, 0.0f };
+   std::vector<AIAgentSnapshot> agents; // AIParallelPhase のエージェントと同じ順
+};
+
+/// @brief AIの意図の種類
+enum class AIIntentType : uint8_t {
+   Move,        // vector の速度で移動する
+   Attack,      // target に value のダメージを与える
+   ChangeState, // 状態を target に変える
+};
+
+/// @brief AIが出す意図（並列フェーズの後にまとめて順に適用する）
+struct AIIntent {
+   AIIntentType type = AIIntentType::Move;
+   uint32_t agent = 0;   // 意図を出したエージェント
+   uint32_t target = 0;  // 攻撃対象のエージェント・変更後の状態
+   Vector3 vector = { 0.0f, 0.0f, 0.0f };
+   float value = 0.0f;
+};
+
+/// @brief 1体のエージェントの意図の書き込み先
+class AIIntentWriter {
+public:
+   AIIntentWriter(std::vector<AIIntent>& intents, uint32_t agent)
+      : intents_(intents), agent_(agent) {}
+
+   void Move(const Vector3& velocity) { intents_.push_back({ AIIntentType::Move, agent_, 0, velocity, 0.0f }); }
+   void Attack(uint32_t target, float damage) { intents_.push_back({ AIIntentType::Attack, agent_, target, {}, damage }); }
+   void ChangeState(uint32_t state) { intents_.push_back({ AIIntentType::ChangeState, agent_, state, {}, 0.0f }); }
+
+private:
+   std::vector<AIIntent>& intents_;
+   uint32_t agent_;
+};
+
+/// @brief 並列フェーズでエージェントの思考に渡す値（コンパイル済みツリーの葉のエージェント型）
+/// @details 世界は読み取り専用で、結果は意図としてだけ出す。乱数もエージェント・フレームから決めるので、
+/// どのスレッドで実行しても同じ結果になる。
+struct AIThinkContext {
+   const AIWorldSnapshot& world;
+   const AIAgentSnapshot& self;
+   uint32_t index;           // world.agents でのエージェントの位置
+   AIIntentWriter& intents;
+
+   /// @brief エージェント・フレーム・salt だけで決まる乱数
+   uint32_t Random(uint32_t salt) const {
+      uint64_t x = world.frame * 0x9E3779B97F4A7C15ull ^ (static_cast<uint64_t>(index) << 32 | salt);
+      x ^= x >> 30;
+      x *= 0xBF58476D1CE4E5B9ull;
+      x ^= x >> 27;
+      x *= 0x94D049BB133111EBull;
+      x ^= x >> 31;
+      return static_cast<uint32_t>(x);
+   }
+
+   /// @brief [0, 1) の乱数
+   float RandomFloat(uint32_t salt) const { return static_cast<float>(Random(salt) >> 8) * (1.0f / 16777216.0f); }
+};
@@ -0,0 +1,84 @@
+#include "AIParallelPhase.h"
+#include <cassert>
+
+namespace {
+   // 1チャンクあたりの最小エージェント数（ジョブの起動の費用より思考が重くなるように）
+   constexpr size_t kMinAgentsPerChunk = 32;
+}
+
+void AIParallelPhase::Initialize(uint32_t workerCount) {
+   jobSystem_.Initialize(workerCount);
+}
+
+void AIParallelPhase::Finalize() {
+   jobSystem_.Finalize();
+}
+
+uint32_t AIParallelPhase::AddAgent(std::shared_ptr<const CompiledBehaviorTree> tree, uint32_t seed) {
+   assert(tree && "Tree is null!");
+   Agent agent;
+   agent.stateOffset = states_.size();
+   agent.stateSize = tree->GetStateSize();
+   states_.resize(states_.size() + agent.stateSize);
+   tree->ResetState(&states_[agent.stateOffset], seed);
+   agent.tree = std::move(tree);
+   agents_.push_back(std::move(agent));
+   return static_cast<uint32_t>(agents_.size() - 1);
+}
+
+uint32_t AIParallelPhase::AddAgent(ThinkFunc think) {
+   assert(think && "Think function is null!");
+   Agent agent;
+   agent.think = think;
+   agent.stateOffset = states_.size();
+   agents_.push_back(std::move(agent));
+   return static_cast<uint32_t>(agents_.size() - 1);
+}
+
+void AIParallelPhase::RemoveAgent(uint32_t index) {
+   // 状態ブロックを詰める（ツリーごとに大きさが違うので後ろのエージェントの位置をずらす）
+   const Agent& removed = agents_[index];
+   states_.erase(states_.begin() + removed.stateOffset, states_.begin() + removed.stateOffset + removed.stateSize);
+   for (Agent& agent : agents_) {
+      if (agent.stateOffset > removed.stateOffset) {
+         agent.stateOffset -= removed.stateSize;
+      }
+   }
+
+   agents_[index] = std::move(agents_.back());
+   agents_.pop_back();
+}
+
+void AIParallelPhase::Think(const AIWorldSnapshot& world, std::vector<AIIntent>& outIntents) {
+   assert(world.agents.size() == agents_.size() && "Snapshot does not match the agents!");
+   outIntents.clear();
+
+   const uint32_t chunkCount = jobSystem_.GetChunkCount(agents_.size(), kMinAgentsPerChunk);
+   if (chunkIntents_.size() < chunkCount) {
+      chunkIntents_.resize(chunkCount);
+   }
+
+   jobSystem_.ParallelFor(agents_.size(), kMinAgentsPerChunk, [&](uint32_t chunkIndex, size_t begin, size_t end) {
+      std::vector<AIIntent>& intents = chunkIntents_[chunkIndex];
+      intents.clear();
+      for (size_t i = begin; i < end; ++i) {
+         ThinkAgent(static_cast<uint32_t>(i), world, intents);
+      }
+   });
+
+   // チャンクはエージェントの順に並んでいるので、つなげればエージェントの順になる
+   for (uint32_t i = 0; i < chunkCount; ++i) {
+      outIntents.insert(outIntents.end(), chunkIntents_[i].begin(), chunkIntents_[i].end());
+   }
+}
+
+void AIParallelPhase::ThinkAgent(uint32_t index, const AIWorldSnapshot& world, std::vector<AIIntent>& intents) {
+   const Agent& agent = agents_[index];
+   AIIntentWriter writer(intents, index);
+   AIThinkContext context{ world, world.agents[index], index, writer };
+   if (agent.tree) {
+      agent.tree->Tick(&context, &states_[agent.stateOffset], world.deltaTime);
+   } else {
+      agent.think(context);
+   }
+}
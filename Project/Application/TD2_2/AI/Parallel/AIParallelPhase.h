@@ -0,0 +1,60 @@
+#pragma once
+#include "AIIntent.h"
+#include "Application/TD2_2/AI/BehaviorTree/CompiledBehaviorTree.h"
+#include "Engine/Utility/Job/JobSystem.h"
+#include <memory>
+#include <vector>
+
+/// @brief エージェントの思考を並列に実行し、意図を集めるAIフェーズ
+/// @details 思考（コンパイル済みツリー・関数）は読み取り専用の AIWorldSnapshot だけを読み、
+/// 結果を意図として出す。意図はチャンクごとに集めてエージェントの順に並べるので、
+/// 呼び出し側がそれを順に適用すれば、スレッド数によらずビット単位で同じ結果になる。
+/// ツリーの葉・思考関数はスレッドセーフで、共有の状態を書き換えないこと。
+class AIParallelPhase {
+public:
+   /// @brief ツリーを使わない思考関数
+   using ThinkFunc = void (*)(AIThinkContext& context);
+
+   /// @brief ワーカースレッドを起動
+   /// @param workerCount ワーカー数（0の場合は呼び出しスレッドだけで実行する）
+   void Initialize(uint32_t workerCount);
+
+   /// @brief ワーカースレッドを停止
+   void Finalize();
+
+   /// @brief コンパイル済みツリーで考えるエージェントを追加（葉のエージェント型は AIThinkContext）
+   /// @param seed 重み付きセレクターの乱数の種
+   /// @return エージェントの番号（AIWorldSnapshot::agents の位置）
+   uint32_t AddAgent(std::shared_ptr<const CompiledBehaviorTree> tree, uint32_t seed = 1);
+
+   /// @brief 関数で考えるエージェントを追加
+   /// @return エージェントの番号（AIWorldSnapshot::agents の位置）
+   uint32_t AddAgent(ThinkFunc think);
+
+   /// @brief エージェントを取り除く（最後のエージェントがその番号に移る。スナップショットも同じように並べること）
+   void RemoveAgent(uint32_t index);
+
+   /// @brief 全エージェントを並列に考えさせる
+   /// @param world 世界の状態（agents はこのフェーズのエージェントと同じ数・順）
+   /// @param outIntents 意図（エージェントの順、1体の中では出した順）
+   void Think(const AIWorldSnapshot& world, std::vector<AIIntent>& outIntents);
+
+   size_t GetAgentCount() const { return agents_.size(); }
+   uint32_t GetWorkerCount() const { return jobSystem_.GetWorkerCount(); }
+
+private:
+   struct Agent {
+      std::shared_ptr<const CompiledBehaviorTree> tree;
+      ThinkFunc think = nullptr;
+      size_t stateOffset = 0;
+      uint32_t stateSize = 0;
+   };
+
+   /// @brief 1体を考えさせる
+   void ThinkAgent(uint32_t index, const AIWorldSnapshot& world, std::vector<AIIntent>& intents);
+
+   JobSystem jobSystem_;
+   std::vector<Agent> agents_;
+   std::vector<uint32_t> states_;                  // ツリーの状態ブロック（エージェントごとに続けて並べる）
+   std::vector<std::vector<AIIntent>> chunkIntents_; // チャンクごとの意図
+};
@@ -0,0 +1,251 @@
+#include "AIScheduler.h"
+#include "Engine/Math/Frustum.h"
+#include <algorithm>
+#include <chrono>
+
+#ifdef _DEBUG
+#include <imgui.h>
+#endif
+
+namespace {
+   using Clock = std::chrono::steady_clock;
+
+   float MicrosecondsSince(Clock::time_point start) {
+      return std::chrono::duration<float, std::micro>(Clock::now() - start).count();
+   }
+}
+
+AIAgentHandle AIScheduler::Register(std::unique_ptr<BehaviorTree> tree, std::function<Vector3()> getPosition, float radius, const std::string& name) {
+   if (!tree) {
+      return {};
+   }
+
+   uint32_t id = 0;
+   if (!freeIds_.empty()) {
+      id = freeIds_.back();
+      freeIds_.pop_back();
+   } else {
+      id = static_cast<uint32_t>(slots_.size());
+      slots_.push_back(0);
+   }
+   slots_[id] = static_cast<uint32_t>(agents_.size());
+
+   Agent agent;
+   agent.tree = std::move(tree);
+   agent.getPosition = std::move(getPosition);
+   agent.radius = radius;
+   agent.name = name.empty() ? agent.tree->GetName() : name;
+   agent.id = id;
+   // 登録直後のフレームに実行されるようにする
+   agent.stats.framesSinceTick = UINT32_MAX / 2;
+   agents_.push_back(std::move(agent));
+   return { id };
+}
+
+void AIScheduler::Unregister(AIAgentHandle handle) {
+   const size_t index = FindIndex(handle);
+   if (index == SIZE_MAX) {
+      return;
+   }
+
+   // 最後のエージェントを空いた位置に移す
+   const size_t last = agents_.size() - 1;
+   if (index != last) {
+      agents_[index] = std::move(agents_[last]);
+      slots_[agents_[index].id] = static_cast<uint32_t>(index);
+   }
+   agents_.pop_back();
+   slots_[handle.id] = UINT32_MAX;
+   freeIds_.push_back(handle.id);
+   if (cursor_ >= agents_.size()) {
+      cursor_ = 0;
+   }
+}
+
+void AIScheduler::Clear() {
+   agents_.clear();
+   slots_.clear();
+   freeIds_.clear();
+   cursor_ = 0;
+}
+
+void AIScheduler::Update(float deltaTime, const Vector3& focus, const Frustum* frustum) {
+   const Clock::time_point start = Clock::now();
+   const size_t count = agents_.size();
+
+   // 詳細度を決め、Tick の間隔が来たかを数える
+   for (Agent& agent : agents_) {
+      UpdateLod(agent, focus, frustum);
+      ++agent.stats.framesSinceTick;
+   }
+
+   // 前のフレームで止まった位置から順に、予算が尽きるまで実行する
+   uint32_t tickedCount = 0;
+   size_t visited = 0;
+   for (; visited < count; ++visited) {
+      Agent& agent = agents_[(cursor_ + visited) % count];
+      if (agent.stats.framesSinceTick < agent.stats.interval) {
+         continue;
+      }
+      // 前回と同じだけかかると予算を超えるなら次のフレームに回す
+      if (tickedCount > 0 && MicrosecondsSince(start) + agent.stats.lastTickMicroseconds > settings_.budgetMicroseconds) {
+         break;
+      }
+
+      const Clock::time_point tickStart = Clock::now();
+      agent.tree->Tick();
+      const float tickMicroseconds = MicrosecondsSince(tickStart);
+
+      agent.stats.lastTickMicroseconds = tickMicroseconds;
+      agent.stats.maxTickMicroseconds = (std::max)(agent.stats.maxTickMicroseconds, tickMicroseconds);
+      agent.stats.framesSinceTick = 0;
+      ++agent.stats.tickCount;
+      ++agent.windowTicks;
+      ++tickedCount;
+   }
+
+   // 実行できなかったエージェントは次のフレームで先に実行する
+   uint32_t deferredCount = 0;
+   for (size_t i = visited; i < count; ++i) {
+      Agent& agent = agents_[(cursor_ + i) % count];
+      if (agent.stats.framesSinceTick >= agent.stats.interval) {
+         ++agent.stats.deferredCount;
+         ++deferredCount;
+      }
+   }
+   if (count > 0) {
+      cursor_ = (cursor_ + visited) % count;
+   }
+
+   // 実際の Tick の頻度は1秒ごとに更新する
+   windowSeconds_ += deltaTime;
+   if (windowSeconds_ >= 1.0f) {
+      for (Agent& agent : agents_) {
+         agent.stats.ticksPerSecond = static_cast<float>(agent.windowTicks) / windowSeconds_;
+         agent.windowTicks = 0;
+      }
+      windowSeconds_ = 0.0f;
+   }
+
+   stats_.tickedCount = tickedCount;
+   stats_.deferredCount = deferredCount;
+   stats_.usedMicroseconds = MicrosecondsSince(start);
+   stats_.peakMicroseconds = (std::max)(stats_.peakMicroseconds, stats_.usedMicroseconds);
+   if (stats_.usedMicroseconds > settings_.budgetMicroseconds) {
+      ++stats_.overrunFrames;
+   }
+   ++stats_.frameCount;
+}
+
+BehaviorTree* AIScheduler::GetTree(AIAgentHandle handle) const {
+   const size_t index = FindIndex(handle);
+   return index != SIZE_MAX ? agents_[index].tree.get() : nullptr;
+}
+
+const AIAgentStats* AIScheduler::GetAgentStats(AIAgentHandle handle) const {
+   const size_t index = FindIndex(handle);
+   return index != SIZE_MAX ? &agents_[index].stats : nullptr;
+}
+
+void AIScheduler::DrawImGui() {
+#ifdef _DEBUG
+   if (!ImGui::Begin("AI Scheduler")) {
+      ImGui::End();
+      return;
+   }
+
+   ImGui::DragFloat("予算 (us)", &settings_.budgetMicroseconds, 10.0f, 10.0f, 16000.0f);
+   ImGui::DragFloat2("詳細度の距離", settings_.lodDistances.data(), 1.0f, 0.0f, 1000.0f);
+   int intervals[3] = {
+      static_cast<int>(settings_.lodIntervals[0]), static_cast<int>(settings_.lodIntervals[1]), static_cast<int>(settings_.lodIntervals[2]) };
+   if (ImGui::DragInt3("Tickの間隔（近・中・遠）", intervals, 0.1f, 1, 60)) {
+      for (size_t i = 0; i < settings_.lodIntervals.size(); ++i) {
+         settings_.lodIntervals[i] = static_cast<uint32_t>((std::max)(intervals[i], 1));
+      }
+   }
+   int offscreenInterval = static_cast<int>(settings_.offscreenInterval);
+   if (ImGui::DragInt("画面外のTickの間隔", &offscreenInterval, 0.1f, 1, 120)) {
+      settings_.offscreenInterval = static_cast<uint32_t>((std::max)(offscreenInterval, 1));
+   }
+
+   ImGui::Separator();
+   ImGui::Text("エージェント: %zu, 実行: %u, 次フレームへ: %u", agents_.size(), stats_.tickedCount, stats_.deferredCount);
+   ImGui::Text("使用時間: %.1f us (最大 %.1f us)", stats_.usedMicroseconds, stats_.peakMicroseconds);
+   ImGui::Text("予算超過: %llu / %llu フレーム",
+      static_cast<unsigned long long>(stats_.overrunFrames), static_cast<unsigned long long>(stats_.frameCount));
+   if (ImGui::Button("記録をリセット")) {
+      stats_.peakMicroseconds = 0.0f;
+      stats_.overrunFrames = 0;
+      stats_.frameCount = 0;
+      for (Agent& agent : agents_) {
+         agent.stats.maxTickMicroseconds = 0.0f;
+         agent.stats.deferredCount = 0;
+      }
+   }
+
+   static const char* kLodNames[] = { "近", "中", "遠" };
+   if (ImGui::BeginTable("AIAgents", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY, ImVec2(0.0f, 200.0f))) {
+      ImGui::TableSetupColumn("名前");
+      ImGui::TableSetupColumn("詳細度");
+      ImGui::TableSetupColumn("間隔");
+      ImGui::TableSetupColumn("Tick/秒");
+      ImGui::TableSetupColumn("時間 (us)");
+      ImGui::TableSetupColumn("後回し");
+      ImGui::TableHeadersRow();
+      for (const Agent& agent : agents_) {
+         ImGui::TableNextRow();
+         ImGui::TableNextColumn();
+         ImGui::TextUnformatted(agent.name.c_str());
+         ImGui::TableNextColumn();
+         ImGui::Text("%s%s", kLodNames[static_cast<size_t>(agent.stats.lod)], agent.stats.isVisible ? "" : "（画面外）");
+         ImGui::TableNextColumn();
+         ImGui::Text("%u", agent.stats.interval);
+         ImGui::TableNextColumn();
+         ImGui::Text("%.1f", agent.stats.ticksPerSecond);
+         ImGui::TableNextColumn();
+         ImGui::Text("%.1f / %.1f", agent.stats.lastTickMicroseconds, agent.stats.maxTickMicroseconds);
+         ImGui::TableNextColumn();
+         ImGui::Text("%u", agent.stats.deferredCount);
+      }
+      ImGui::EndTable();
+   }
+
+   ImGui::End();
+#endif
+}
+
+size_t AIScheduler::FindIndex(AIAgentHandle handle) const {
+   if (handle.id >= slots_.size() || slots_[handle.id] == UINT32_MAX || slots_[handle.id] >= agents_.size()) {
+      return SIZE_MAX;
+   }
+   return slots_[handle.id];
+}
+
+void AIScheduler::UpdateLod(Agent& agent, const Vector3& focus, const Frustum* frustum) const {
+   if (!agent.getPosition) {
+      agent.stats.lod = AILod::Near;
+      agent.stats.isVisible = true;
+      agent.stats.interval = settings_.lodIntervals[0];
+      return;
+   }
+
+   const Vector3 position = agent.getPosition();
+   const float dx = position.x - focus.x;
+   const float dy = position.y - focus.y;
+   const float dz = position.z - focus.z;
+   const float distanceSquared = dx * dx + dy * dy + dz * dz;
+
+   AILod lod = AILod::Far;
+   if (distanceSquared < settings_.lodDistances[0] * settings_.lodDistances[0]) {
+      lod = AILod::Near;
+   } else if (distanceSquared < settings_.lodDistances[1] * settings_.lodDistances[1]) {
+      lod = AILod::Middle;
+   }
+
+   agent.stats.lod = lod;
+   agent.stats.isVisible = !frustum || frustum->IntersectsSphere(position, agent.radius);
+   agent.stats.interval = (std::max)(settings_.lodIntervals[static_cast<size_t>(lod)], 1u);
+   if (!agent.stats.isVisible) {
+      agent.stats.interval = (std::max)(agent.stats.interval, settings_.offscreenInterval);
+   }
+}
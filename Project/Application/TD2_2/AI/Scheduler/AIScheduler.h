@@ -0,0 +1,123 @@
+#pragma once
+#include "Application/TD2_2/AI/BehaviorTree/BehaviorTree.h"
+#include "MathCore.h"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct Frustum;
+
+/// @brief AIスケジューラーに登録したエージェントの番号
+struct AIAgentHandle {
+   uint32_t id = UINT32_MAX;
+
+   bool IsValid() const { return id != UINT32_MAX; }
+};
+
+/// @brief エージェントの詳細度（注目点からの距離で決まる）
+enum class AILod : uint8_t {
+   Near,
+   Middle,
+   Far,
+   Count,
+};
+
+/// @brief AIスケジューラーの設定（ImGui から調整できる）
+struct AISchedulerSettings {
+   float budgetMicroseconds = 1000.0f;                  // 1フレームで Tick に使う時間の上限
+   std::array<float, 2> lodDistances = { 30.0f, 80.0f }; // Near・Middle の上限の距離
+   std::array<uint32_t, static_cast<size_t>(AILod::Count)> lodIntervals = { 1, 2, 4 }; // 詳細度ごとの Tick の間隔（フレーム）
+   uint32_t offscreenInterval = 8;                      // 画面外のエージェントの Tick の間隔（フレーム）
+};
+
+/// @brief エージェントごとの実行の記録
+struct AIAgentStats {
+   AILod lod = AILod::Near;
+   bool isVisible = true;
+   uint32_t interval = 1;          // 今の Tick の間隔（フレーム）
+   uint32_t framesSinceTick = 0;   // 最後の Tick からのフレーム数
+   uint32_t tickCount = 0;
+   uint32_t deferredCount = 0;     // 予算切れで次のフレームに回された回数
+   float ticksPerSecond = 0.0f;    // 直近1秒間の実際の Tick の頻度
+   float lastTickMicroseconds = 0.0f;
+   float maxTickMicroseconds = 0.0f;
+};
+
+/// @brief フレームごとの実行の記録
+struct AISchedulerStats {
+   uint32_t tickedCount = 0;       // このフレームに Tick したエージェント数
+   uint32_t deferredCount = 0;     // このフレームに予算切れで Tick できなかったエージェント数
+   float usedMicroseconds = 0.0f;  // このフレームに Tick に使った時間
+   float peakMicroseconds = 0.0f;  // これまでの最大
+   uint64_t overrunFrames = 0;     // 予算を超えたフレーム数
+   uint64_t frameCount = 0;
+};
+
+/// @brief 登録したビヘイビアツリーを予算内で順番に実行するスケジューラー
+/// @details 毎フレーム、前回止まったエージェントから順に、Tick の間隔が来たエージェントを実行し、
+/// 使った時間が予算を超えた時点で残りを次のフレームに回す（1フレームに少なくとも1体は実行する）。
+/// 注目点（プレイヤー）から遠いエージェントや画面外のエージェントは間隔を空けて実行する。
+class AIScheduler {
+public:
+   /// @brief エージェントを登録
+   /// @param tree 実行するツリー（スケジューラーが所有する）
+   /// @param getPosition エージェントの位置を返す関数（詳細度の判定用。登録解除まで呼べること）
+   /// @param radius 画面内の判定に使う半径
+   /// @param name 名前（デバッグ表示用）
+   /// @return エージェントの番号
+   AIAgentHandle Register(std::unique_ptr<BehaviorTree> tree, std::function<Vector3()> getPosition, float radius = 1.0f, const std::string& name = "");
+
+   /// @brief 登録を解除（ツリーも破棄する）
+   void Unregister(AIAgentHandle handle);
+
+   /// @brief 登録済みのエージェントをすべて解除
+   void Clear();
+
+   /// @brief 予算内でエージェントを実行
+   /// @param deltaTime 経過時間（秒）
+   /// @param focus 詳細度の基準になる位置（プレイヤーなど）
+   /// @param frustum 画面内の判定に使う視錐台（nullptr なら全員画面内とみなす）
+   void Update(float deltaTime, const Vector3& focus, const Frustum* frustum);
+
+   /// @brief ツリーを取得（無効な番号なら nullptr）
+   BehaviorTree* GetTree(AIAgentHandle handle) const;
+
+   /// @brief エージェントの実行の記録を取得
+   const AIAgentStats* GetAgentStats(AIAgentHandle handle) const;
+
+   const AISchedulerStats& GetStats() const { return stats_; }
+   AISchedulerSettings& GetSettings() { return settings_; }
+   size_t GetAgentCount() const { return agents_.size(); }
+
+   /// @brief 予算・詳細度の調整と実行の記録の表示
+   void DrawImGui();
+
+private:
+   struct Agent {
+      std::unique_ptr<BehaviorTree> tree;
+      std::function<Vector3()> getPosition;
+      float radius = 1.0f;
+      std::string name;
+      uint32_t id = 0;
+      AIAgentStats stats;
+      uint32_t windowTicks = 0;   // 頻度の計測区間内の Tick 数
+   };
+
+   /// @brief 番号から agents_ の位置を探す（見つからなければ SIZE_MAX）
+   size_t FindIndex(AIAgentHandle handle) const;
+
+   /// @brief 詳細度と画面内かどうかから Tick の間隔を決める
+   void UpdateLod(Agent& agent, const Vector3& focus, const Frustum* frustum) const;
+
+   std::vector<Agent> agents_;
+   std::vector<uint32_t> slots_;   // 番号 → agents_ の位置
+   std::vector<uint32_t> freeIds_;
+   size_t cursor_ = 0;             // 次のフレームに最初に調べる位置
+   float windowSeconds_ = 0.0f;    // 頻度の計測区間の経過時間
+
+   AISchedulerSettings settings_;
+   AISchedulerStats stats_;
+};
@@ -0,0 +1,285 @@
+#include "UtilityScoring.h"
+#include <algorithm>
+#include <cassert>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define UTILITY_SCORING_USE_SSE
+#endif
+
+namespace {
+   constexpr size_t kLaneCount = 4;
+
+   size_t PadToLanes(size_t count) {
+      return (count + kLaneCount - 1) / kLaneCount * kLaneCount;
+   }
+
+   /// @brief 0〜1 の t に形を掛ける（CurveEvaluator::ApplyCurve と同じ計算順）
+   float ApplyEasing(ScoreEasing easing, float t) {
+      switch (easing) {
+         case ScoreEasing::EaseIn:
+            return t * t;
+         case ScoreEasing::EaseOut:
+            return 1.0f - (1.0f - t) * (1.0f - t);
+         case ScoreEasing::EaseInOut: {
+            if (t < 0.5f) {
+               return 2.0f * t * t;
+            }
+            const float u = -2.0f * t + 2.0f;
+            return 1.0f - u * u / 2.0f;
+         }
+         default:
+            return t;
+      }
+   }
+
+   float Combine(ScoreCombine combine, float a, float b) {
+      switch (combine) {
+         case ScoreCombine::Sum: return a + b;
+         case ScoreCombine::Max: return (std::max)(a, b);
+         case ScoreCombine::Min: return (std::min)(a, b);
+         default: return a * b;
+      }
+   }
+
+#ifdef UTILITY_SCORING_USE_SSE
+   /// @brief mask のレーンは a、それ以外は b
+   __m128 Select(__m128 mask, __m128 a, __m128 b) {
+      return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+   }
+
+   __m128 ApplyEasing(ScoreEasing easing, __m128 t) {
+      const __m128 one = _mm_set1_ps(1.0f);
+      const __m128 two = _mm_set1_ps(2.0f);
+      switch (easing) {
+         case ScoreEasing::EaseIn:
+            return _mm_mul_ps(t, t);
+         case ScoreEasing::EaseOut: {
+            const __m128 u = _mm_sub_ps(one, t);
+            return _mm_sub_ps(one, _mm_mul_ps(u, u));
+         }
+         case ScoreEasing::EaseInOut: {
+            const __m128 low = _mm_mul_ps(_mm_mul_ps(two, t), t);
+            const __m128 u = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-2.0f), t), two);
+            const __m128 high = _mm_sub_ps(one, _mm_div_ps(_mm_mul_ps(u, u), two));
+            return Select(_mm_cmplt_ps(t, _mm_set1_ps(0.5f)), low, high);
+         }
+         default:
+            return t;
+      }
+   }
+#endif
+}
+
+// --------------------------------------------------------
+// 既存の Evaluator と同じ曲線
+// --------------------------------------------------------
+ScoreCurve ScoreCurve::MakeDistance(uint32_t input, float closeValue, float farValue, float minDistance, float maxDistance) {
+   // 範囲が潰れている場合は最小距離で切り替わる
+   ScoreEasing easing = maxDistance > minDistance ? ScoreEasing::Linear : ScoreEasing::Step;
+   return { input, minDistance, maxDistance, closeValue, farValue, easing };
+}
+
+ScoreCurve ScoreCurve::MakeHpRatio(uint32_t input, float lowValue, float highValue, float minRatio, float maxRatio) {
+   ScoreEasing easing = maxRatio > minRatio ? ScoreEasing::Linear : ScoreEasing::Step;
+   return { input, minRatio, maxRatio, lowValue, highValue, easing };
+}
+
+ScoreCurve ScoreCurve::MakeTimeBased(uint32_t input, float startValue, float endValue, float duration) {
+   // 長さがなければ常に開始時の値
+   if (duration <= 0.0f) {
+      return { input, 0.0f, 0.0f, startValue, startValue, ScoreEasing::Step };
+   }
+   return { input, 0.0f, duration, startValue, endValue, ScoreEasing::Linear };
+}
+
+ScoreCurve ScoreCurve::MakeAngle(uint32_t input, float inRangeValue, float outRangeValue, float minAngle, float maxAngle) {
+   return { input, minAngle, maxAngle, outRangeValue, inRangeValue, ScoreEasing::Window };
+}
+
+ScoreCurve ScoreCurve::MakeCounter(uint32_t input, float minValue, float maxValue, int minCount, int maxCount) {
+   ScoreEasing easing = maxCount > minCount ? ScoreEasing::Linear : ScoreEasing::Step;
+   return { input, static_cast<float>(minCount), static_cast<float>(maxCount), minValue, maxValue, easing };
+}
+
+ScoreCurve ScoreCurve::MakeProgress(uint32_t input, float startValue, float endValue, CurveEvaluator::CurveType curveType) {
+   ScoreEasing easing = ScoreEasing::Linear;
+   switch (curveType) {
+      case CurveEvaluator::CurveType::EaseIn: easing = ScoreEasing::EaseIn; break;
+      case CurveEvaluator::CurveType::EaseOut: easing = ScoreEasing::EaseOut; break;
+      case CurveEvaluator::CurveType::EaseInOut: easing = ScoreEasing::EaseInOut; break;
+      default: break;
+   }
+   return { input, 0.0f, 1.0f, startValue, endValue, easing };
+}
+
+float ScoreCurve::Evaluate(float value) const {
+   if (easing == ScoreEasing::Step) {
+      return value <= inputMin ? outputMin : outputMax;
+   }
+   if (easing == ScoreEasing::Window) {
+      return (value >= inputMin && value <= inputMax) ? outputMax : outputMin;
+   }
+
+   if (value <= inputMin) return outputMin;
+   if (value >= inputMax) return outputMax;
+
+   float t = (value - inputMin) / (inputMax - inputMin);
+   return outputMin + ApplyEasing(easing, t) * (outputMax - outputMin);
+}
+
+// --------------------------------------------------------
+// 入力の表
+// --------------------------------------------------------
+uint32_t ScoreInputTable::AddColumn(const std::string& name) {
+   names_.push_back(name);
+   data_.resize(names_.size() * paddedCount_, 0.0f);
+   return static_cast<uint32_t>(names_.size() - 1);
+}
+
+void ScoreInputTable::Resize(size_t agentCount) {
+   agentCount_ = agentCount;
+   paddedCount_ = PadToLanes(agentCount);
+   data_.assign(names_.size() * paddedCount_, 0.0f);
+}
+
+// --------------------------------------------------------
+// まとめて採点
+// --------------------------------------------------------
+uint32_t UtilityScorer::AddOption(const ScoreOption& option) {
+   options_.push_back(option);
+   return static_cast<uint32_t>(options_.size() - 1);
+}
+
+void UtilityScorer::Score(const ScoreInputTable& inputs) {
+   agentCount_ = inputs.GetAgentCount();
+   paddedCount_ = inputs.GetPaddedCount();
+   scores_.resize(options_.size() * paddedCount_);
+   curveValues_.resize(paddedCount_);
+
+   for (size_t optionIndex = 0; optionIndex < options_.size(); ++optionIndex) {
+      const ScoreOption& option = options_[optionIndex];
+      float* scores = &scores_[optionIndex * paddedCount_];
+      if (option.curves.empty()) {
+         std::fill(scores, scores + paddedCount_, 0.0f);
+         continue;
+      }
+
+      // 最初の曲線はそのまま書き、以降は合わせていく
+      for (size_t c = 0; c < option.curves.size(); ++c) {
+         const ScoreCurve& curve = option.curves[c];
+         assert(curve.input < inputs.GetColumnCount() && "Unknown score input!");
+         float* values = c == 0 ? scores : curveValues_.data();
+         EvaluateCurve(curve, inputs.GetColumn(curve.input), values, paddedCount_);
+         if (c == 0) {
+            continue;
+         }
+
+         size_t i = 0;
+#ifdef UTILITY_SCORING_USE_SSE
+         for (; i + kLaneCount <= paddedCount_; i += kLaneCount) {
+            const __m128 a = _mm_loadu_ps(scores + i);
+            const __m128 b = _mm_loadu_ps(values + i);
+            __m128 combined;
+            switch (option.combine) {
+               case ScoreCombine::Sum: combined = _mm_add_ps(a, b); break;
+               case ScoreCombine::Max: combined = _mm_max_ps(a, b); break;
+               case ScoreCombine::Min: combined = _mm_min_ps(a, b); break;
+               default: combined = _mm_mul_ps(a, b); break;
+            }
+            _mm_storeu_ps(scores + i, combined);
+         }
+#endif
+         for (; i < paddedCount_; ++i) {
+            scores[i] = Combine(option.combine, scores[i], values[i]);
+         }
+      }
+
+      if (option.weight != 1.0f) {
+         for (size_t i = 0; i < paddedCount_; ++i) {
+            scores[i] *= option.weight;
+         }
+      }
+   }
+}
+
+void UtilityScorer::SelectBest(std::vector<uint32_t>& outOptions) const {
+   outOptions.assign(agentCount_, 0);
+   if (options_.empty()) return;
+
+   // 選択肢の列を順に見て、エージェントごとの最大を更新する（列を連続して読む）
+   std::vector<float> bestScores(GetScores(0), GetScores(0) + agentCount_);
+   for (uint32_t option = 1; option < options_.size(); ++option) {
+      const float* scores = GetScores(option);
+      for (size_t agent = 0; agent < agentCount_; ++agent) {
+         if (scores[agent] > bestScores[agent]) {
+            bestScores[agent] = scores[agent];
+            outOptions[agent] = option;
+         }
+      }
+   }
+}
+
+void UtilityScorer::EvaluateCurve(const ScoreCurve& curve, const float* input, float* output, size_t count) {
+   size_t i = 0;
+#ifdef UTILITY_SCORING_USE_SSE
+   // 4体ずつ評価する。形の計算は全レーンで行い、範囲の外は端の値で置き換える
+   const __m128 inputMin = _mm_set1_ps(curve.inputMin);
+   const __m128 inputMax = _mm_set1_ps(curve.inputMax);
+   const __m128 outputMin = _mm_set1_ps(curve.outputMin);
+   const __m128 outputMax = _mm_set1_ps(curve.outputMax);
+   const __m128 inputRange = _mm_set1_ps(curve.inputMax - curve.inputMin);
+   const __m128 outputRange = _mm_set1_ps(curve.outputMax - curve.outputMin);
+
+   switch (curve.easing) {
+      case ScoreEasing::Step:
+         for (; i + kLaneCount <= count; i += kLaneCount) {
+            const __m128 x = _mm_loadu_ps(input + i);
+            _mm_storeu_ps(output + i, Select(_mm_cmple_ps(x, inputMin), outputMin, outputMax));
+         }
+         break;
+
+      case ScoreEasing::Window:
+         for (; i + kLaneCount <= count; i += kLaneCount) {
+            const __m128 x = _mm_loadu_ps(input + i);
+            const __m128 inside = _mm_and_ps(_mm_cmpge_ps(x, inputMin), _mm_cmple_ps(x, inputMax));
+            _mm_storeu_ps(output + i, Select(inside, outputMax, outputMin));
+         }
+         break;
+
+      default:
+         for (; i + kLaneCount <= count; i += kLaneCount) {
+            const __m128 x = _mm_loadu_ps(input + i);
+            const __m128 t = _mm_div_ps(_mm_sub_ps(x, inputMin), inputRange);
+            __m128 value = _mm_add_ps(outputMin, _mm_mul_ps(ApplyEasing(curve.easing, t), outputRange));
+            // スカラー版と同じく、下端の判定を優先する
+            value = Select(_mm_cmpge_ps(x, inputMax), outputMax, value);
+            value = Select(_mm_cmple_ps(x, inputMin), outputMin, value);
+            _mm_storeu_ps(output + i, value);
+         }
+         break;
+   }
+#endif
+   for (; i < count; ++i) {
+      output[i] = curve.Evaluate(input[i]);
+   }
+}
+
+// --------------------------------------------------------
+// IEvaluator へのアダプター
+// --------------------------------------------------------
+ScoreCurveEvaluator::ScoreCurveEvaluator(const ScoreCurve& curve, const ScoreInputTable* inputs, size_t agent)
+   : curve_(curve), inputs_(inputs), agent_(agent) {}
+
+float ScoreCurveEvaluator::Evaluate() const {
+   if (!inputs_) return curve_.outputMin;
+   return curve_.Evaluate(inputs_->Get(curve_.input, agent_));
+}
+
+ScoredOptionEvaluator::ScoredOptionEvaluator(const UtilityScorer* scorer, uint32_t option, size_t agent)
+   : scorer_(scorer), option_(option), agent_(agent) {}
+
+float ScoredOptionEvaluator::Evaluate() const {
+   if (!scorer_) return 0.0f;
+   return scorer_->GetScore(option_, agent_);
+}
@@ -0,0 +1,157 @@
+#pragma once
+#include "Application/TD2_2/AI/Node/Evaluator.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// @brief 評価曲線の形
+enum class ScoreEasing : uint8_t {
+   Linear,     // 入力の範囲で線形補間
+   EaseIn,     // t^2
+   EaseOut,    // 1 - (1 - t)^2
+   EaseInOut,  // 前半 2t^2、後半 1 - (2 - 2t)^2 / 2
+   Step,       // inputMin 以下なら outputMin、それ以外は outputMax
+   Window,     // [inputMin, inputMax] の中なら outputMax、外なら outputMin
+};
+
+/// @brief 評価曲線の記述（入力の列・入力の範囲・出力の範囲・形）
+/// @details 入力を [inputMin, inputMax] で 0〜1 に正規化して形を掛け、outputMin〜outputMax に写す。
+/// 範囲の端では outputMin・outputMax をそのまま返す。既存の Evaluator と同じ曲線は Make* で作る。
+struct ScoreCurve {
+   uint32_t input = 0;        // ScoreInputTable の列
+   float inputMin = 0.0f;
+   float inputMax = 1.0f;
+   float outputMin = 0.0f;    // 入力が inputMin 以下のときの値
+   float outputMax = 1.0f;    // 入力が inputMax 以上のときの値
+   ScoreEasing easing = ScoreEasing::Linear;
+
+   /// @brief DistanceEvaluator と同じ曲線
+   static ScoreCurve MakeDistance(uint32_t input, float closeValue, float farValue, float minDistance = 0.0f, float maxDistance = 10.0f);
+
+   /// @brief HpRatioEvaluator と同じ曲線
+   static ScoreCurve MakeHpRatio(uint32_t input, float lowValue, float highValue, float minRatio = 0.0f, float maxRatio = 1.0f);
+
+   /// @brief TimeBasedEvaluator と同じ曲線
+   static ScoreCurve MakeTimeBased(uint32_t input, float startValue, float endValue, float duration);
+
+   /// @brief AngleEvaluator と同じ曲線
+   static ScoreCurve MakeAngle(uint32_t input, float inRangeValue, float outRangeValue, float minAngle = -45.0f, float maxAngle = 45.0f);
+
+   /// @brief CounterEvaluator と同じ曲線（カウントは float の列に入れる）
+   static ScoreCurve MakeCounter(uint32_t input, float minValue, float maxValue, int minCount = 0, int maxCount = 10);
+
+   /// @brief CurveEvaluator と同じ曲線（進行度は 0〜1）
+   static ScoreCurve MakeProgress(uint32_t input, float startValue, float endValue, CurveEvaluator::CurveType curveType = CurveEvaluator::CurveType::Linear);
+
+   /// @brief 1つの入力を評価する
+   float Evaluate(float value) const;
+};
+
+/// @brief 評価の入力（列ごとに全エージェントの値を並べる SoA）
+/// @details 列の長さは4の倍数に切り上げ、詰め物は 0 にする。エージェントの値はフレームの初めにまとめて書く。
+class ScoreInputTable {
+public:
+   /// @brief 列を追加
+   /// @param name 名前（デバッグ表示用）
+   /// @return 列の番号（ScoreCurve::input に使う）
+   uint32_t AddColumn(const std::string& name);
+
+   /// @brief エージェント数を変える（値は 0 になる）
+   void Resize(size_t agentCount);
+
+   void Set(uint32_t column, size_t agent, float value) { data_[column * paddedCount_ + agent] = value; }
+   float Get(uint32_t column, size_t agent) const { return data_[column * paddedCount_ + agent]; }
+
+   float* GetColumn(uint32_t column) { return &data_[column * paddedCount_]; }
+   const float* GetColumn(uint32_t column) const { return &data_[column * paddedCount_]; }
+
+   uint32_t GetColumnCount() const { return static_cast<uint32_t>(names_.size()); }
+   const std::string& GetColumnName(uint32_t column) const { return names_[column]; }
+   size_t GetAgentCount() const { return agentCount_; }
+   size_t GetPaddedCount() const { return paddedCount_; }
+
+private:
+   std::vector<std::string> names_;
+   std::vector<float> data_;
+   size_t agentCount_ = 0;
+   size_t paddedCount_ = 0;
+};
+
+/// @brief 選択肢の曲線の合わせ方
+enum class ScoreCombine : uint8_t {
+   Product,
+   Sum,
+   Max,
+   Min,
+};
+
+/// @brief 選択肢（曲線を合わせ、weight を掛けたものがスコア）
+struct ScoreOption {
+   std::vector<ScoreCurve> curves;
+   ScoreCombine combine = ScoreCombine::Product;
+   float weight = 1.0f;
+};
+
+/// @brief 全エージェント×全選択肢のスコアをまとめて計算する
+/// @details 曲線ごとに入力の列を4つずつ SIMD で評価し、選択肢ごとの列に合わせていく。
+/// 仮想呼び出しも std::function もなく、1回の Score で数千の（エージェント, 選択肢）を採点する。
+/// 結果は GetScore で読むか、ScoredOptionEvaluator で IEvaluator として使う。
+class UtilityScorer {
+public:
+   /// @brief 選択肢を追加
+   /// @return 選択肢の番号
+   uint32_t AddOption(const ScoreOption& option);
+
+   /// @brief 全選択肢を全エージェントについて採点する
+   void Score(const ScoreInputTable& inputs);
+
+   /// @brief 最後の Score の結果
+   float GetScore(uint32_t option, size_t agent) const { return scores_[option * paddedCount_ + agent]; }
+
+   /// @brief 最後の Score の結果（選択肢の列。長さは ScoreInputTable::GetPaddedCount）
+   const float* GetScores(uint32_t option) const { return &scores_[option * paddedCount_]; }
+
+   /// @brief エージェントごとにスコアの最も高い選択肢を選ぶ（同点なら番号の小さい方）
+   void SelectBest(std::vector<uint32_t>& outOptions) const;
+
+   uint32_t GetOptionCount() const { return static_cast<uint32_t>(options_.size()); }
+   const ScoreOption& GetOption(uint32_t option) const { return options_[option]; }
+
+   /// @brief 1つの曲線を入力の列に対して評価する
+   /// @param count 要素数（4の倍数でなくてもよい）
+   static void EvaluateCurve(const ScoreCurve& curve, const float* input, float* output, size_t count);
+
+private:
+   std::vector<ScoreOption> options_;
+   std::vector<float> scores_;     // [選択肢][エージェント]
+   std::vector<float> curveValues_; // 曲線1本分の作業用
+   size_t agentCount_ = 0;
+   size_t paddedCount_ = 0;
+};
+
+/// @brief ScoreCurve を IEvaluator として使うアダプター（入力の表から1体分の値を読んで評価する）
+class ScoreCurveEvaluator : public IEvaluator {
+public:
+   ScoreCurveEvaluator(const ScoreCurve& curve, const ScoreInputTable* inputs, size_t agent);
+
+   float Evaluate() const override;
+
+private:
+   ScoreCurve curve_;
+   const ScoreInputTable* inputs_;
+   size_t agent_;
+};
+
+/// @brief UtilityScorer でまとめて計算したスコアを IEvaluator として使うアダプター
+/// @details Evaluate は最後の Score の結果を読むだけなので、先に UtilityScorer::Score を呼んでおくこと。
+class ScoredOptionEvaluator : public IEvaluator {
+public:
+   ScoredOptionEvaluator(const UtilityScorer* scorer, uint32_t option, size_t agent);
+
+   float Evaluate() const override;
+
+private:
+   const UtilityScorer* scorer_;
+   uint32_t option_;
+   size_t agent_;
+};
@@ -127,21 +127,14 @@ bool CameraController::IsShaking() const
 
 void CameraController::UpdateShake(float deltaTime)
 {
+	// 終わったシェイク（タイマーは TimerService が進める）はオフセットを戻す
 	if (!shakeTimer_.IsActive()) {
 		shakeOffset_ = { 0.0f, 0.0f, 0.0f };
 		return;
 	}
 
-	// タイマーの更新
-	shakeTimer_.Update(deltaTime);
 	shakeTime_ += deltaTime;
 
-	// シェイクが終了したらオフセットをリセット
-	if (shakeTimer_.IsFinished()) {
-		shakeOffset_ = { 0.0f, 0.0f, 0.0f };
-		return;
-	}
-
 	// シェイクオフセットを計算
 	shakeOffset_ = CalculateShakeOffset();
 }
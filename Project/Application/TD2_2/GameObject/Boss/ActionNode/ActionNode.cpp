@@ -1,6 +1,7 @@
 #include "ActionNode.h"
 #include "Application/TD2_2/GameObject/Boss/Boss.h"
 #include "Application/TD2_2/Utility/StateMachine.h"
+#include <cassert>
 
 BossActionNode::BossActionNode(Boss* boss, const std::string& actionName)
    : ActionNode(nullptr), boss_(boss), currentState_(ActionState::Idle), actionName_(actionName) {
@@ -49,6 +50,7 @@ void BossActionNode::Reset() {
 void BossActionNode::SetupStateMachine() {
    if (!stateMachine_) return;
 
+   // 状態IDは登録順に振られるので、ActionState と同じ順に登録する（GetStateId が ActionState をそのままIDにする）
    // Idle状態
    stateMachine_->AddState("Idle",
       [this]() {
@@ -56,7 +58,7 @@ void BossActionNode::SetupStateMachine() {
       },
       [this]() {
          // Enterへ遷移
-         stateMachine_->RequestState("Enter", 1);
+         stateMachine_->RequestState(GetStateId(ActionState::Enter), 1);
       }
    );
 
@@ -67,7 +69,7 @@ void BossActionNode::SetupStateMachine() {
       },
       [this]() {
          // Executeへ遷移
-         stateMachine_->RequestState("Execute", 1);
+         stateMachine_->RequestState(GetStateId(ActionState::Execute), 1);
       }
    );
 
@@ -80,7 +82,7 @@ void BossActionNode::SetupStateMachine() {
          // OnExecuteの結果に応じて遷移
          NodeState result = OnExecute();
          if (result == NodeState::Success || result == NodeState::Failure) {
-            stateMachine_->RequestState("Exit", 1);
+            stateMachine_->RequestState(GetStateId(ActionState::Exit), 1);
          }
          // Runningの場合は継続
       }
@@ -93,7 +95,7 @@ void BossActionNode::SetupStateMachine() {
       },
       [this]() {
          // Completedへ遷移
-         stateMachine_->RequestState("Completed", 1);
+         stateMachine_->RequestState(GetStateId(ActionState::Completed), 1);
       }
    );
 
@@ -107,8 +109,10 @@ void BossActionNode::SetupStateMachine() {
       }
    );
 
+   assert(stateMachine_->FindState("Completed") == GetStateId(ActionState::Completed) && "State ids must follow ActionState!");
+
    // 初期状態を設定
-   stateMachine_->RequestState("Idle", 0);
+   stateMachine_->RequestState(GetStateId(ActionState::Idle), 0);
 }
 
 void BossActionNode::UpdateState() {
@@ -116,18 +120,9 @@ void BossActionNode::UpdateState() {
    
    stateMachine_->Update();
    
-   // ステートマシンの状態をActionStateに同期
-   const std::string& currentStateName = stateMachine_->GetCurrentState();
-   
-   if (currentStateName == "Idle") {
-      currentState_ = ActionState::Idle;
-   } else if (currentStateName == "Enter") {
-      currentState_ = ActionState::Enter;
-   } else if (currentStateName == "Execute") {
-      currentState_ = ActionState::Execute;
-   } else if (currentStateName == "Exit") {
-      currentState_ = ActionState::Exit;
-   } else if (currentStateName == "Completed") {
-      currentState_ = ActionState::Completed;
+   // ステートマシンの状態をActionStateに同期（IDの順が ActionState と同じなのでそのまま変換する）
+   StateMachine::StateId state = stateMachine_->GetCurrentState();
+   if (state <= GetStateId(ActionState::Completed)) {
+      currentState_ = static_cast<ActionState>(state);
    }
 }
@@ -66,6 +66,9 @@ protected:
    /// @brief ステートマシンのセットアップ（派生クラスでオーバーライド可能）
    virtual void SetupStateMachine();
 
+   /// @brief アクション状態に対応するステートマシンの状態ID（基底の状態は ActionState の順に登録する）
+   static StateMachine::StateId GetStateId(ActionState state) { return static_cast<StateMachine::StateId>(state); }
+
 private:
    /// @brief 内部状態を更新
    void UpdateState();
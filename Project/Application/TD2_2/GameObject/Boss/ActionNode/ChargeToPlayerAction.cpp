@@ -87,7 +87,9 @@ Vector3 ChargeToPlayerAction::CalculateDirectionToPlayer() const {
       return {0.0f, 0.0f, 0.0f};
    }
    
-   return boss_->GetDirectionToPlayer();
+   // 障害物を避ける向き（ゲームはXY平面）
+   Vector2 direction = boss_->GetPathDirectionToPlayer();
+   return {direction.x, direction.y, 0.0f};
 }
 
 void ChargeToPlayerAction::PrepareCharge() {
@@ -109,7 +111,7 @@ void ChargeToPlayerAction::ExecuteCharge() {
    // 突進の加速度を計算
    Vector2 acceleration2D = {
       chargeDirection_.x * chargeSpeed_,
-      chargeDirection_.z * chargeSpeed_
+      chargeDirection_.y * chargeSpeed_
    };
    
    // Bossの公開メソッドを使用して加速度を追加
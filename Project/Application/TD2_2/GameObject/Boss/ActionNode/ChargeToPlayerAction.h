@@ -1,6 +1,7 @@
 #pragma once
 #include "ActionNode.h"
 #include "Engine/Utility/Timer/GameTimer.h"
+#include "MathCore.h"
 
 class Player;
 
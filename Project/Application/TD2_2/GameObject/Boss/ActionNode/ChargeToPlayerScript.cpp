@@ -0,0 +1,61 @@
+#include "ChargeToPlayerScript.h"
+#include "Application/TD2_2/AI/Coroutine/ActionScheduler.h"
+#include "Application/TD2_2/GameObject/Boss/Boss.h"
+
+namespace {
+   /// @brief 突進用の移動パラメータを設定し、終わったとき（取り消されたときも）元に戻す
+   class ChargeMovementScope {
+   public:
+      ChargeMovementScope(Boss* boss, float maxSpeed, float damping) : boss_(boss) {
+         boss_->SetMaxSpeed(maxSpeed);
+         boss_->SetDamping(damping);
+      }
+      ~ChargeMovementScope() { boss_->ResetMovementParameters(); }
+
+      ChargeMovementScope(const ChargeMovementScope&) = delete;
+      ChargeMovementScope& operator=(const ChargeMovementScope&) = delete;
+
+   private:
+      Boss* boss_;
+   };
+
+   constexpr float kChargeMaxSpeed = 45.0f; // 突進最大速度
+   constexpr float kChargeDamping = 0.02f;  // 突進減衰率
+}
+
+ActionTask ChargeToPlayerScript(Boss* boss, const ActionScheduler* scheduler,
+                                float chargeSpeed, float chargeDuration, float preparationTime) {
+   if (!boss || !scheduler) {
+      co_return NodeState::Failure;
+   }
+
+   // 準備フェーズ（向きは準備が終わった時点のものを使うので、その間は何もしない）
+   co_await Wait(preparationTime);
+   const Vector2 direction = boss->GetPathDirectionToPlayer();
+
+   // 突進フェーズ
+   ChargeMovementScope movement(boss, kChargeMaxSpeed, kChargeDamping);
+   const double endTime = scheduler->GetTime() + chargeDuration;
+   while (scheduler->GetTime() < endTime) {
+      boss->AddAcceleration({ direction.x * chargeSpeed, direction.y * chargeSpeed });
+      co_await NextFrame();
+   }
+
+   co_return NodeState::Success;
+}
+
+ActionTask ChargeComboScript(Boss* boss, const ActionScheduler* scheduler, int chargeCount, float minDistance) {
+   if (!boss || !scheduler) {
+      co_return NodeState::Failure;
+   }
+
+   for (int i = 0; i < chargeCount; ++i) {
+      if (co_await ChargeToPlayerScript(boss, scheduler) != NodeState::Success) {
+         co_return NodeState::Failure;
+      }
+      co_await Until([boss, minDistance]() { return boss->GetDistanceToPlayer() >= minDistance; });
+   }
+
+   co_await Wait(1.0f);
+   co_return NodeState::Success;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include "Application/TD2_2/AI/Coroutine/ActionTask.h"
+
+class ActionScheduler;
+class Boss;
+
+/// @brief プレイヤーへの突進（ChargeToPlayerAction のコルーチン版）
+/// @details 準備の間は眠り、突進中だけ毎フレーム加速する。途中で止められても移動パラメータは元に戻る。
+/// ビヘイビアツリーでは CoroutineActionNode で使う。
+/// @code
+/// builder.Action<CoroutineActionNode>(scheduler, [boss, scheduler]() { return ChargeToPlayerScript(boss, scheduler); });
+/// @endcode
+/// @param scheduler タスクを動かすスケジューラー（突進時間の計測に使う）
+/// @param chargeSpeed 突進速度
+/// @param chargeDuration 突進持続時間（秒）
+/// @param preparationTime 準備時間（秒）
+ActionTask ChargeToPlayerScript(Boss* boss, const ActionScheduler* scheduler,
+                                float chargeSpeed = 50000.0f,
+                                float chargeDuration = 0.5f,
+                                float preparationTime = 0.3f);
+
+/// @brief 突進を続けて行う攻撃パターン
+/// @details 突進のたびにプレイヤーとの距離が離れるまで待ち、最後に間を置く。
+/// @param chargeCount 突進の回数
+/// @param minDistance 次の突進を始めるプレイヤーとの距離
+ActionTask ChargeComboScript(Boss* boss, const ActionScheduler* scheduler,
+                             int chargeCount = 3,
+                             float minDistance = 8.0f);
@@ -274,4 +274,35 @@ std::unique_ptr<BehaviorTree> CreateAdaptiveBossAI(
     );
 }
 
+// ===================================================================
+// コルーチンで書いた攻撃パターンの例（ChargeToPlayerScript.h）
+// ===================================================================
+
+#include "Application/TD2_2/AI/Coroutine/CoroutineActionNode.h"
+#include "Application/TD2_2/GameObject/Boss/ActionNode/ChargeToPlayerScript.h"
+
+// スケジューラーはシーンが所有し、AIScheduler::Update の後に毎フレーム Update する
+// （GameScene にはまだ置いていないので、このツリーを使うときに一緒に追加する）
+std::unique_ptr<BehaviorTree> CreateScriptedBossAI(Boss* boss, ActionScheduler* scheduler) {
+    return BehaviorTreeFactory::Create(
+        [boss, scheduler](BehaviorTreeBuilder& builder) {
+            builder.Selector()
+                // 近距離: 突進を3回続ける（準備中や待ちの間はスケジューラーの中で眠る）
+                .Sequence()
+                    .Condition([boss]() { return boss->GetDistanceToPlayer() <= 10.0f; })
+                    .Action<CoroutineActionNode>(scheduler, [boss, scheduler]() {
+                        return ChargeComboScript(boss, scheduler, 3, 8.0f);
+                    })
+                .End()
+
+                // それ以外: 1回だけ突進
+                .Action<CoroutineActionNode>(scheduler, [boss, scheduler]() {
+                    return ChargeToPlayerScript(boss, scheduler);
+                })
+            .End();
+        },
+        "ScriptedBossAI"
+    );
+}
+
 */
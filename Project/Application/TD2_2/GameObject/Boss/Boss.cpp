@@ -1,5 +1,6 @@
 #include "Boss.h"
 #include "Application/TD2_2/GameObject/Player/Player.h"
+#include <algorithm>
 #include <cmath>
 
 #ifdef _DEBUG
@@ -17,7 +18,7 @@ void Boss::Initialize(std::unique_ptr<Model> model, TextureManager::LoadedTextur
 }
 
 void Boss::Update() {
-   // ビヘイビアツリーの実行
+   // ビヘイビアツリーの実行（スケジューラーに登録したツリーはスケジューラーが実行する）
    if (behaviorTree_) {
       behaviorTree_->Tick();
    }
@@ -54,10 +55,13 @@ bool Boss::DrawImGui() {
       ImGui::Text("最大速度: %.2f", maxSpeed_);
       
       // ビヘイビアツリー情報
-      if (behaviorTree_) {
+      if (BehaviorTree* tree = GetBehaviorTree()) {
          ImGui::Separator();
-         ImGui::Text("ビヘイビアツリー: %s", behaviorTree_->GetName().c_str());
-         ImGui::Text("実行回数: %u", behaviorTree_->GetTickCount());
+         ImGui::Text("ビヘイビアツリー: %s", tree->GetName().c_str());
+         ImGui::Text("実行回数: %u", tree->GetTickCount());
+         if (const AIAgentStats* stats = aiScheduler_ ? aiScheduler_->GetAgentStats(aiHandle_) : nullptr) {
+            ImGui::Text("実行頻度: %.1f 回/秒（間隔 %u フレーム）", stats->ticksPerSecond, stats->interval);
+         }
       }
       
       // プレイヤー関連情報
@@ -112,7 +116,16 @@ void Boss::OnCollisionExit(GameObject* other) {
 }
 
 void Boss::SetBehaviorTree(std::unique_ptr<BehaviorTree> tree) {
-   behaviorTree_ = std::move(tree);
+   if (!aiScheduler_) {
+      behaviorTree_ = std::move(tree);
+      return;
+   }
+
+   aiScheduler_->Unregister(aiHandle_);
+   aiHandle_ = {};
+   if (tree) {
+      aiHandle_ = aiScheduler_->Register(std::move(tree), [this] { return GetWorldPosition(); }, 0.6f, GetObjectName());
+   }
 }
 
 void Boss::AddAcceleration(const Vector2& accel) {
@@ -169,6 +182,24 @@ float Boss::GetAngleToPlayer() const {
    return angle * 180.0f / 3.14159265f;
 }
 
+Vector2 Boss::GetPathDirectionToPlayer() const {
+   Vector3 direction = GetDirectionToPlayer();
+   Vector2 directDirection = Vector2{ direction.x, direction.y }.Normalize();
+   if (!navigation_ || !player_) return directDirection;
+
+   // 目標のセルの周りは場が粗いので、まっすぐ向かう
+   Vector3 position = GetWorldPosition();
+   if (navigation_->GetDistance(navigationTarget_, position) <= navigation_->GetSettings().cellSize * 2.0f) {
+      return directDirection;
+   }
+
+   Vector2 pathDirection = navigation_->GetDirection(navigationTarget_, position);
+   if (pathDirection.x == 0.0f && pathDirection.y == 0.0f) {
+      return directDirection;
+   }
+   return pathDirection;
+}
+
 void Boss::InitializeCollider() {
    AttachCollider(std::make_unique<SphereCollider>(this, 0.6f));
    collider_->SetLayer(CollisionLayer::Boss);
@@ -1,6 +1,8 @@
 #pragma once
 #include "../GameObject.h"
 #include "Application/TD2_2/AI/BehaviorTree/BehaviorTree.h"
+#include "Application/TD2_2/AI/Navigation/NavigationService.h"
+#include "Application/TD2_2/AI/Scheduler/AIScheduler.h"
 #include <memory>
 
 // 前方宣言
@@ -25,11 +27,15 @@ public:
    // ビヘイビアツリー関連
    // ======================================================================
    
+   /// @brief AIスケジューラーを設定（以降に設定したツリーはスケジューラーが実行する）
+   /// @param scheduler スケジューラー（ボスより長く生存すること）
+   void SetAIScheduler(AIScheduler* scheduler) { aiScheduler_ = scheduler; }
+
    /// @brief ビヘイビアツリーを設定
    void SetBehaviorTree(std::unique_ptr<BehaviorTree> tree);
    
    /// @brief ビヘイビアツリーを取得
-   BehaviorTree* GetBehaviorTree() const { return behaviorTree_.get(); }
+   BehaviorTree* GetBehaviorTree() const { return aiScheduler_ ? aiScheduler_->GetTree(aiHandle_) : behaviorTree_.get(); }
    
    /// @brief プレイヤーへの参照を設定
    void SetPlayer(Player* player) { player_ = player; }
@@ -68,6 +74,14 @@ public:
    /// @brief プレイヤーへの角度を取得（度数法）
    float GetAngleToPlayer() const;
 
+   /// @brief ナビゲーションを設定（シーンが所有）
+   /// @param target プレイヤーを追う目標
+   void SetNavigation(const NavigationService* navigation, NavTargetHandle target) { navigation_ = navigation; navigationTarget_ = target; }
+
+   /// @brief 障害物を避けてプレイヤーへ向かう向き（XY平面、正規化済み）
+   /// @details ナビゲーションがない場合・プレイヤーのすぐ近く・経路がない場合はまっすぐ向かう
+   Vector2 GetPathDirectionToPlayer() const;
+
 private:
 
    Vector2 acceleration_ = { 0.0f, 0.0f }; // 加速度ベクトル
@@ -88,8 +102,12 @@ private:
    GameTimer chargeTimer_;
    
    // ビヘイビアツリー
-   std::unique_ptr<BehaviorTree> behaviorTree_;
+   std::unique_ptr<BehaviorTree> behaviorTree_; // スケジューラーがないときだけ自分で実行する
+   AIScheduler* aiScheduler_ = nullptr;          // スケジューラー（所有権なし）
+   AIAgentHandle aiHandle_;
    Player* player_ = nullptr;  // プレイヤーへの参照（ポインタのみ、所有権なし）
+   const NavigationService* navigation_ = nullptr; // ナビゲーション（所有権なし）
+   NavTargetHandle navigationTarget_;
 
 private:
    /// @brief コライダーの初期化
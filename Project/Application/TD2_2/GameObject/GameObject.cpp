@@ -116,12 +116,6 @@ void GameObject::UpdateRotation() {
 	  return;
    }
 
-   // デルタタイムを取得
-   float deltaTime = GameUtils::GetDeltaTime();
-
-   // タイマーを更新
-   rotationTimer_->Update(deltaTime);
-
    // イージング進行率を取得（EaseInOut）
    float easedProgress = rotationTimer_->GetEasedProgress(EasingUtil::Type::EaseInOutQuad);
 
@@ -152,11 +146,17 @@ void GameObject::StartShake(float intensity, float duration) {
 }
 
 bool GameObject::UpdateShake() {
+   // タイマーはシーンの更新前に進むので、終わったフレームはここで元の位置に戻す
+   if (shakeTimer_.IsFinished()) {
+	  if (shakeIntensity_ != 0.0f) {
+		 shakeIntensity_ = 0.0f;
+		 transform_.translate = basePosition_;
+	  }
+	  return false;
+   }
    if (!shakeTimer_.IsActive()) {
 	  return false;
    }
-   float deltaTime = GameUtils::GetDeltaTime();
-   shakeTimer_.Update(deltaTime);
    Vector3 shakeOffset = {
 	  GameUtils::RandomFloat(-shakeIntensity_ * 0.5f, shakeIntensity_ * 0.5f),
 	  GameUtils::RandomFloat(-shakeIntensity_ * 0.5f, shakeIntensity_ * 0.5f),
@@ -165,12 +165,6 @@ bool GameObject::UpdateShake() {
    // オフセットを位置に適用
    transform_.translate = basePosition_ + shakeOffset;
 
-   if (shakeTimer_.IsFinished()) {
-	  shakeIntensity_ = 0.0f;
-	  transform_.translate = basePosition_;
-	  return false;
-   }
-
    return true;
 }
 
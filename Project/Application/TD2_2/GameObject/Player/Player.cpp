@@ -1,4 +1,5 @@
 #include "Player.h"
+#include <algorithm>
 
 #ifdef _DEBUG
 #include <imgui.h>
@@ -15,7 +16,7 @@ void Player::Initialize(std::unique_ptr<Model> model, TextureManager::LoadedText
    InitializeStateMachine();
 
    // 初期状態をMoveに設定
-   stateMachine_->RequestState("Move", 0);
+   stateMachine_->RequestState(moveState_, 0);
 
    // コライダーの初期化
    InitializeCollider();
@@ -24,12 +25,12 @@ void Player::Initialize(std::unique_ptr<Model> model, TextureManager::LoadedText
 void Player::Update() {
    if (keyConfig_->Get<bool>("Charge")) {
 	  if (GetMoveDirection().Length() > 0.0f) {
-		 stateMachine_->RequestState("Charge", 0);
+		 stateMachine_->RequestState(chargeState_, 0);
 	  }
    }
 
    if (keyConfig_->Get<bool>("Damage")) {
-	  stateMachine_->RequestState("Damage", 1);
+	  stateMachine_->RequestState(damageState_, 1);
    }
 
    stateMachine_->Update();
@@ -59,7 +60,7 @@ void Player::OnCollisionEnter(GameObject* other) {
 
    velocity_ *= 0.5f; // 衝突時の速度を半減
 
-   stateMachine_->RequestState("Stun", 0);
+   stateMachine_->RequestState(stunState_, 0);
 }
 
 void Player::OnCollisionStay(GameObject* other) {
@@ -69,7 +70,7 @@ void Player::OnCollisionStay(GameObject* other) {
    // 反対方向に加速度を与える
    acceleration_ -= Vector2{ toOther.x, toOther.y }.Normalize() * stunPower_;
 
-   stateMachine_->RequestState("Stun", 0);
+   stateMachine_->RequestState(stunState_, 0);
 }
 
 void Player::OnCollisionExit(GameObject* other) {
@@ -101,15 +102,15 @@ void Player::InitializeStateMachine() {
    // ステートマシンの取り付け
    GameObject::AttachStateMachine();
 
-   stateMachine_->AddState("Charge", std::bind(&Player::InitializeCharge, this), std::bind(&Player::Charge, this));
-   stateMachine_->AddState("Move", std::bind(&Player::InitializeMove, this), std::bind(&Player::Move, this));
-   stateMachine_->AddState("Stun", std::bind(&Player::InitializeStun, this), std::bind(&Player::Stun, this));
-   stateMachine_->AddState("Damage", std::bind(&Player::InitializeDamage, this), std::bind(&Player::Damage, this));
+   chargeState_ = stateMachine_->AddState("Charge", std::bind(&Player::InitializeCharge, this), std::bind(&Player::Charge, this));
+   moveState_ = stateMachine_->AddState("Move", std::bind(&Player::InitializeMove, this), std::bind(&Player::Move, this));
+   stunState_ = stateMachine_->AddState("Stun", std::bind(&Player::InitializeStun, this), std::bind(&Player::Stun, this));
+   damageState_ = stateMachine_->AddState("Damage", std::bind(&Player::InitializeDamage, this), std::bind(&Player::Damage, this));
 
-   stateMachine_->AddTransitionRule("Charge", { "Move" ,"Stun" ,"Damage" });
-   stateMachine_->AddTransitionRule("Move", { "Charge" ,"Stun" ,"Damage" });
-   stateMachine_->AddTransitionRule("Stun", { "Move" ,"Damage" });
-   stateMachine_->AddTransitionRule("Damage", { "Move" });
+   stateMachine_->AddTransitionRule(chargeState_, { moveState_, stunState_, damageState_ });
+   stateMachine_->AddTransitionRule(moveState_, { chargeState_, stunState_, damageState_ });
+   stateMachine_->AddTransitionRule(stunState_, { moveState_, damageState_ });
+   stateMachine_->AddTransitionRule(damageState_, { moveState_ });
 }
 
 void Player::InitializeCollider() {
@@ -168,18 +169,14 @@ void Player::Move() {
 }
 
 void Player::Charge() {
-
-   chargeTimer_.Update(GameUtils::GetDeltaTime());
    if (chargeTimer_.IsFinished()) {
-	  stateMachine_->RequestState("Move", 0);
+	  stateMachine_->RequestState(moveState_, 0);
    }
 }
 
 void Player::Stun() {
-
-   stunTimer_.Update(GameUtils::GetDeltaTime());
    if (stunTimer_.IsFinished()) {
-	  stateMachine_->RequestState("Move", 0);
+	  stateMachine_->RequestState(moveState_, 0);
    }
 }
 
@@ -191,7 +188,7 @@ void Player::Damage() {
    if (GameObject::UpdateShake()) return;
 
    GameObject::ChangeModelResource("Resources/Models/Player/Player.obj");
-   stateMachine_->RequestState("Move", 0);
+   stateMachine_->RequestState(moveState_, 0);
 }
 
 void Player::InitializeCharge() {
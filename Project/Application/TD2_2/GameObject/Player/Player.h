@@ -56,6 +56,12 @@ private:
    std::function<void()> startDamageFunction_;
 
    std::function<void()> damageFunction_;
+
+   // ステートID（InitializeStateMachine で登録）
+   StateMachine::StateId chargeState_ = StateMachine::kInvalidState;
+   StateMachine::StateId moveState_ = StateMachine::kInvalidState;
+   StateMachine::StateId stunState_ = StateMachine::kInvalidState;
+   StateMachine::StateId damageState_ = StateMachine::kInvalidState;
 private:
    /// @brief キーコンフィグの初期化
    void InitializeKeyConfig();
@@ -9,8 +9,12 @@
 #include "Engine/Graphics/Render/RenderManager.h"
 #include "Engine/Graphics/Light/LightManager.h"
 #include "Engine/Graphics/Light/LightData.h"
+#include "Engine/Math/Frustum.h"
 #include "MathCore.h"
 #include "Application/TD2_2/Utility/GameUtils.h"
+#include "Engine/Utility/Timer/TimerService.h"
+#include <algorithm>
+#include <thread>
 
 void GameScene::Initialize(EngineSystem* engine) {
    // 基底クラスの初期化
@@ -37,17 +41,21 @@ void GameScene::Initialize(EngineSystem* engine) {
 		 }
 		 });
 	  player_ = player.get();
-	  gameObjects_.push_back(std::move(player));
+	  AddGameObject(std::move(player));
    }
 
+   // AIスケジューラーの初期化（ボスより先に作る）
+   aiScheduler_ = std::make_unique<AIScheduler>();
+
    // ボスの生成と初期化
    {
 	  auto bossModel = modelManager->CreateStaticModel("Resources/Models/Boss/Boss.obj");
 	  auto bossTexture = textureManager.Load("Resources/Textures/Boss.png");
 	  auto boss = std::make_unique<Boss>();
 	  boss->Initialize(std::move(bossModel), bossTexture);
+	  boss->SetAIScheduler(aiScheduler_.get());
 	  boss_ = boss.get();
-	  gameObjects_.push_back(std::move(boss));
+	  AddGameObject(std::move(boss));
    }
 
    // 衝突設定の初期化
@@ -59,6 +67,9 @@ void GameScene::Initialize(EngineSystem* engine) {
 	  collisionManager_ = std::make_unique<CollisionManager>(collisionConfig_.get());
    }
 
+   // ナビゲーションの初期化（ボス・衝突判定の後）
+   InitializeNavigation();
+
    // カメラコントローラーの初期化（プレイヤーとボスを追跡）
    {
 	  cameraController_ = std::make_unique<CameraController>();
@@ -77,6 +88,22 @@ void GameScene::Initialize(EngineSystem* engine) {
 }
 
 void GameScene::Update() {
+   // ナビゲーションの更新（AIが読む前に障害物と目標を反映する）
+   if (navigation_) {
+	  navigation_->SetTargetPosition(playerTarget_, player_->GetWorldPosition());
+	  navigation_->Update();
+   }
+
+   // AIの実行（オブジェクトの更新より先に行い、その結果をこのフレームの移動に反映する）
+   if (aiScheduler_) {
+	  ICamera* camera = cameraManager_ ? cameraManager_->GetActiveCamera(CameraType::Camera3D) : nullptr;
+	  Frustum frustum;
+	  if (camera) {
+		 frustum = Frustum::FromMatrix(MathCore::Matrix::Multiply(camera->GetViewMatrix(), camera->GetProjectionMatrix()));
+	  }
+	  aiScheduler_->Update(GameUtils::GetDeltaTime(), player_->GetWorldPosition(), camera ? &frustum : nullptr);
+   }
+
    BaseScene::Update();
 
    // カメラコントローラーの更新
@@ -89,6 +116,16 @@ void GameScene::Update() {
    if (cameraController_) {
 	  cameraController_->DrawImGui();
    }
+   // AIスケジューラーのデバッグUI
+   if (aiScheduler_) {
+	  aiScheduler_->DrawImGui();
+   }
+   // タイマーのデバッグUI（グループの一時停止・タイムスケール）
+   TimerService::GetInstance().DrawImGui();
+   // ナビゲーションのデバッグUI
+   if (navigation_) {
+	  navigation_->DrawImGui();
+   }
 #endif
 
    // コライダー登録
@@ -102,7 +139,31 @@ void GameScene::Draw() {
    BaseScene::Draw();
 }
 
-void GameScene::Finalize() {}
+void GameScene::Finalize() {
+   if (navigation_) {
+	  navigation_->Finalize();
+   }
+}
+
+void GameScene::InitializeNavigation() {
+   // メインスレッドも掃引に加わるので論理コア数-1。既定の範囲では斜めの列のブロックは4つまでなので3で足りる
+   uint32_t hardwareThreads = std::thread::hardware_concurrency();
+   uint32_t workerCount = hardwareThreads > 1 ? (std::min)(hardwareThreads - 1, 3u) : 0;
+
+   navigation_ = std::make_unique<NavigationService>();
+   navigation_->Initialize(NavigationSettings{}, workerCount);
+
+   // Default レイヤーのコライダー（プレイヤー・ボス・弾以外の地形）を障害物にする
+   for (const auto& object : GetGameObjects()) {
+	  GameObject* gameObject = dynamic_cast<GameObject*>(object.get());
+	  if (gameObject && gameObject->GetCollider() && gameObject->GetCollider()->GetLayer() == CollisionLayer::Default) {
+		 navigation_->AddObstacle(gameObject->GetCollider());
+	  }
+   }
+
+   playerTarget_ = navigation_->AddTarget(player_->GetWorldPosition());
+   boss_->SetNavigation(navigation_.get(), playerTarget_);
+}
 
 void GameScene::RegisterAllColliders(){
    collisionManager_->Clear();
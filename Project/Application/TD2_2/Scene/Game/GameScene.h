@@ -10,6 +10,8 @@
 #include "../../Collider/CollisionManager.h"
 #include "../../Collider/CollisionConfig.h"
 #include "../../Camera/CameraController.h"
+#include "../../AI/Scheduler/AIScheduler.h"
+#include "../../AI/Navigation/NavigationService.h"
 
 class EngineSystem;
 class CameraManager;
@@ -40,7 +42,16 @@ private:
    // カメラコントローラー
    std::unique_ptr<CameraController> cameraController_;
 
+   // AIスケジューラー（敵のビヘイビアツリーを予算内で実行する）
+   std::unique_ptr<AIScheduler> aiScheduler_;
+
+   // ナビゲーション（障害物を避けてプレイヤーへ向かう流れの場）
+   std::unique_ptr<NavigationService> navigation_;
+   NavTargetHandle playerTarget_;
+
 private:
+   void InitializeNavigation();
+
    void RegisterAllColliders();
 
    void CheckCollisions();
@@ -19,7 +19,7 @@ void TitleScene::Initialize(EngineSystem* engine) {
 	  // 球体オブジェクトの生成と初期化
 	  auto sphere = std::make_unique<Sphere>();
 	  sphere->Initialize();
-	  gameObjects_.push_back(std::move(sphere));
+	  AddGameObject(std::move(sphere));
 
    }
 }
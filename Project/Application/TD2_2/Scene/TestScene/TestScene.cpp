@@ -422,7 +422,7 @@ void TestScene::Update()
    // ライトマネージャーの更新
    auto lightManager = engine_->GetComponent<LightManager>();
    if (lightManager) {
-	  lightManager->UpdateAll();
+	  lightManager->UpdateAll(activeCamera);
    }
 
    // パーティクルシステムの更新
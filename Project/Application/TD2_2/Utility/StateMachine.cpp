@@ -1,59 +1,115 @@
 #include "StateMachine.h"
+#include <cassert>
+
+namespace {
+   const std::string kNoStateName = "None";
+}
 
 StateMachine::StateMachine() {}
 
 // --------------------------------------------------------
 // 状態登録
 // --------------------------------------------------------
-void StateMachine::AddState(const std::string& name,
+StateMachine::StateId StateMachine::AddState(const std::string& name,
    std::function<void()> onEnter,
    std::function<void()> onUpdate)
 {
-   states_[name] = { onEnter, onUpdate };
+   // 同じ名前は上書き（IDは変わらない）
+   StateId existing = FindState(name);
+   if (existing != kInvalidState) {
+      states_[existing] = { onEnter, onUpdate };
+      return existing;
+   }
+
+   assert(states_.size() < kMaxStates && "Too many states!");
+   states_.push_back({ onEnter, onUpdate });
+   names_.push_back(name);
+   return static_cast<StateId>(states_.size() - 1);
+}
+
+// --------------------------------------------------------
+// 名前から状態を検索
+// --------------------------------------------------------
+StateMachine::StateId StateMachine::FindState(const std::string& name) const
+{
+   for (size_t i = 0; i < names_.size(); ++i) {
+      if (names_[i] == name) return static_cast<StateId>(i);
+   }
+   return kInvalidState;
+}
+
+const std::string& StateMachine::GetStateName(StateId state) const
+{
+   if (state >= names_.size()) return kNoStateName;
+   return names_[state];
 }
 
 // --------------------------------------------------------
 // 状態リクエスト追加
 // --------------------------------------------------------
-void StateMachine::RequestState(const std::string& stateName, int priority)
+void StateMachine::RequestState(StateId state, int priority)
 {
-   if (!CanTransition(stateName)) return;
+   assert(state < states_.size() && "Unknown state!");
+   if (!CanTransition(state)) return;
 
-   auto it = requests_.find(stateName);
-   if (it != requests_.end()) {
-      if (priority > it->second) it->second = priority;
-   } else {
-      requests_.insert({ stateName, priority });
+   // このフレームで最初にリクエストされた順番を状態ごとに覚えておく（一度捨てられても順番は変わらない）
+   if ((requestedMask_ & (1u << state)) == 0) {
+      requestedMask_ |= 1u << state;
+      requestOrders_[state] = nextRequestOrder_++;
    }
+   const Request request = { state, priority, requestOrders_[state] };
+
+   for (uint32_t i = 0; i < requestCount_; ++i) {
+      if (requests_[i].state == state) {
+         if (priority > requests_[i].priority) requests_[i].priority = priority;
+         return;
+      }
+   }
+
+   if (requestCount_ < kMaxRequests) {
+      requests_[requestCount_++] = request;
+      return;
+   }
+
+   // 満杯なら最も選ばれにくいリクエストと入れ替える（選ばれないものを捨てるだけなので結果は変わらない）
+   uint32_t worst = 0;
+   for (uint32_t i = 1; i < requestCount_; ++i) {
+      if (IsPreferred(requests_[worst], requests_[i])) worst = i;
+   }
+   if (IsPreferred(request, requests_[worst])) {
+      requests_[worst] = request;
+   }
+}
+
+bool StateMachine::IsPreferred(const Request& a, const Request& b)
+{
+   // 同じ優先度なら先にリクエストされたものを選ぶ
+   if (a.priority != b.priority) return a.priority > b.priority;
+   return a.order < b.order;
 }
 
 // --------------------------------------------------------
 // 最優先状態を決定
 // --------------------------------------------------------
-const std::string& StateMachine::Resolve()
+StateMachine::StateId StateMachine::Resolve()
 {
-   if (requests_.empty()) return currentState_;
+   if (requestCount_ == 0) return currentState_;
 
-   int bestPriority = -999999;
-   std::string bestState = currentState_;
-
-   for (const auto& req : requests_) {
-      if (req.second > bestPriority) {
-         bestPriority = req.second;
-         bestState = req.first;
-      }
+   const Request* best = &requests_[0];
+   for (uint32_t i = 1; i < requestCount_; ++i) {
+      if (IsPreferred(requests_[i], *best)) best = &requests_[i];
    }
+   StateId bestState = best->state;
+   Clear();
 
    // 状態が切り替わった場合に onEnter を呼ぶ
    if (bestState != currentState_) {
       currentState_ = bestState;
-      auto it = states_.find(bestState);
-      if (it != states_.end() && it->second.onEnter) {
-         it->second.onEnter();
+      if (states_[bestState].onEnter) {
+         states_[bestState].onEnter();
       }
    }
 
-   requests_.clear();
    return currentState_;
 }
 
@@ -62,32 +118,35 @@ const std::string& StateMachine::Resolve()
 // --------------------------------------------------------
 void StateMachine::Update()
 {
-   const std::string& state = Resolve();
-   auto it = states_.find(state);
-   if (it != states_.end() && it->second.onUpdate) {
-      it->second.onUpdate();
+   StateId state = Resolve();
+   if (state != kInvalidState && states_[state].onUpdate) {
+      states_[state].onUpdate();
    }
 }
 
 // --------------------------------------------------------
 // 遷移ルール追加
 // --------------------------------------------------------
-void StateMachine::AddTransitionRule(const std::string& from,
-   const std::vector<std::string>& toList)
+void StateMachine::AddTransitionRule(StateId from, std::initializer_list<StateId> toList)
 {
-   transitionRules_[from] = toList;
+   assert(from < kMaxStates && "Unknown state!");
+
+   uint32_t mask = 0;
+   for (StateId to : toList) {
+      assert(to < kMaxStates && "Unknown state!");
+      mask |= 1u << to;
+   }
+   transitionMasks_[from] = mask;
+   ruleMask_ |= 1u << from;
 }
 
 // --------------------------------------------------------
 // 遷移判定
 // --------------------------------------------------------
-bool StateMachine::CanTransition(const std::string& newState) const
+bool StateMachine::CanTransition(StateId newState) const
 {
-   auto it = transitionRules_.find(currentState_);
-   if (it == transitionRules_.end()) return true;
-
-   const auto& allowedList = it->second;
-   return std::find(allowedList.begin(), allowedList.end(), newState) != allowedList.end();
+   if (currentState_ == kInvalidState || (ruleMask_ & (1u << currentState_)) == 0) return true;
+   return (transitionMasks_[currentState_] & (1u << newState)) != 0;
 }
 
 // --------------------------------------------------------
@@ -95,5 +154,7 @@ bool StateMachine::CanTransition(const std::string& newState) const
 // --------------------------------------------------------
 void StateMachine::Clear()
 {
-   requests_.clear();
+   requestCount_ = 0;
+   requestedMask_ = 0;
+   nextRequestOrder_ = 0;
 }
@@ -1,12 +1,24 @@
 #pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
 #include <string>
-#include <unordered_map>
 #include <vector>
-#include <functional>
-#include <algorithm>
 
+/// @brief 整数IDで状態を扱うステートマシン
+/// @details 状態は登録時に 0 から連番のIDを振り、以降のリクエスト・遷移判定はIDだけで行う。
+/// 遷移ルールは状態ごとのビットマスク、リクエストは固定長の配列に持つので、毎フレームの文字列比較・確保はない。
+/// 名前はデバッグ表示・セットアップ時の検索にだけ使う。
 class StateMachine {
 public:
+   /// @brief 状態ID（AddState の戻り値）
+   using StateId = uint32_t;
+
+   static constexpr uint32_t kMaxStates = 32;   // 遷移マスクのビット数
+   static constexpr uint32_t kMaxRequests = 8;  // 1フレームに保持するリクエストの数
+   static constexpr StateId kInvalidState = UINT32_MAX;
+
    StateMachine();
 
    struct State {
@@ -15,18 +27,28 @@ public:
    };
 
    /// @brief 状態を登録
-   void AddState(const std::string& name,
+   /// @return 状態ID（登録順に 0, 1, 2, ...）
+   StateId AddState(const std::string& name,
       std::function<void()> onEnter = nullptr,
       std::function<void()> onUpdate = nullptr);
 
+   /// @brief 名前から状態IDを探す（セットアップ用。見つからなければ kInvalidState）
+   StateId FindState(const std::string& name) const;
+
    /// @brief 状態リクエストを追加
-   void RequestState(const std::string& stateName, int priority);
+   void RequestState(StateId state, int priority);
 
-   /// @brief 現在の状態名を取得
-   const std::string& GetCurrentState() const { return currentState_; }
+   /// @brief 現在の状態IDを取得（まだ状態に入っていなければ kInvalidState）
+   StateId GetCurrentState() const { return currentState_; }
 
-   /// @brief 遷移ルールを追加
-   void AddTransitionRule(const std::string& from, const std::vector<std::string>& toList);
+   /// @brief 状態名を取得（デバッグ表示用）
+   const std::string& GetStateName(StateId state) const;
+
+   /// @brief 現在の状態名を取得（デバッグ表示用）
+   const std::string& GetCurrentStateName() const { return GetStateName(currentState_); }
+
+   /// @brief 遷移ルールを追加（from から遷移できる状態を設定する。ルールのない状態からはどこへでも遷移できる）
+   void AddTransitionRule(StateId from, std::initializer_list<StateId> toList);
 
    /// @brief Update を呼ぶだけで Resolve + onUpdate を実行
    void Update();
@@ -35,12 +57,27 @@ public:
    void Clear();
 
 private:
-   const std::string& Resolve();
-   bool CanTransition(const std::string& newState) const;
+   struct Request {
+      StateId state;
+      int priority;
+      uint32_t order;   // このフレームで最初にリクエストされた順番
+   };
+
+   StateId Resolve();
+   bool CanTransition(StateId newState) const;
+
+   /// @brief a を b より優先するか（優先度が高い方、同じなら先にリクエストされた方）
+   static bool IsPreferred(const Request& a, const Request& b);
 
 private:
-   std::unordered_map<std::string, int> requests_;
-   std::unordered_map<std::string, State> states_;
-   std::string currentState_ = "Idle";
-   std::unordered_map<std::string, std::vector<std::string>> transitionRules_;
+   std::vector<State> states_;
+   std::vector<std::string> names_;                      // デバッグ表示用
+   std::array<uint32_t, kMaxStates> transitionMasks_{};  // [from] の遷移先のビット
+   uint32_t ruleMask_ = 0;                               // 遷移ルールを持つ状態のビット
+   std::array<Request, kMaxRequests> requests_{};
+   uint32_t requestCount_ = 0;
+   std::array<uint32_t, kMaxStates> requestOrders_{};    // [state] このフレームで最初にリクエストされた順番
+   uint32_t requestedMask_ = 0;                          // このフレームにリクエストされた状態のビット
+   uint32_t nextRequestOrder_ = 0;
+   StateId currentState_ = kInvalidState;
 };
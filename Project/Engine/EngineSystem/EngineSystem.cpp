@@ -5,6 +5,8 @@
 #include "Engine/Utility/Random/RandomGenerator.h"
 #include "Engine/Utility/Logger/Logger.h"
 #include "Engine/Graphics/TextureManager.h"
+#include "Engine/Graphics/Shader/ShaderCache.h"
+#include "Engine/Graphics/Pipeline/PipelineStateCache.h"
 
 // レンダリング関連
 #include "Engine/Graphics/Render/Render.h"
@@ -25,6 +27,8 @@
 #include "Engine/Utility/FrameRate/FrameRateController.h"
 
 #include "IDrawable.h"
+#include <algorithm>
+#include <thread>
 
 
 void EngineSystem::Initialize(WinApp* winApp)
@@ -36,6 +40,13 @@ void EngineSystem::Initialize(WinApp* winApp)
 	// ログシステムの初期化（最初に実行）
 	Logger::GetInstance().Initialize();
 
+	// シェーダーキャッシュの初期化（前回使用したシェーダーを並列に用意しておき、各レンダラーはキャッシュから取得する）
+	ShaderCache::GetInstance().Initialize("Cache/Shader");
+	ShaderCache::GetInstance().Precompile((std::max)(std::thread::hardware_concurrency(), 1u));
+
+	// PSOキャッシュの初期化（同じ記述のPSOはレンダラー間で共有し、前回作成したものはパイプラインライブラリから読み込む）
+	PipelineStateCache::GetInstance().Initialize("Cache/Pipeline");
+
 	// WinAppのインスタンスを保持
 	winApp_ = winApp;
 
@@ -98,6 +109,12 @@ void EngineSystem::Finalize()
 
 	componentOwners_.clear();
 
+	// パイプラインライブラリの保存とPSOの解放（レンダラーの破棄後）
+	PipelineStateCache::GetInstance().Finalize();
+
+	// シェーダー一覧の保存と古いキャッシュの削除
+	ShaderCache::GetInstance().Finalize();
+
 	// COMの解放
 	CoUninitialize();
 }
@@ -112,6 +129,18 @@ void EngineSystem::BeginFrame()
 	// RenderManagerの描画キューをクリア（前フレームのコマンドを削除）
 	if (auto* renderManager = GetComponent<RenderManager>()) {
 		renderManager->ClearQueue();
+
+		// スプライトの頂点バッファを今フレームのものに切り替え
+		if (auto* spriteRenderer = static_cast<SpriteRenderer*>(renderManager->GetRenderer(RenderPassType::Sprite))) {
+			spriteRenderer->BeginFrame();
+		}
+	}
+
+	// デバッグ線の頂点バッファを今フレームのものに切り替え
+	if (auto* lineRenderer = GetComponent<LineRenderer>()) {
+		if (auto* dxCommon = GetComponent<DirectXCommon>()) {
+			lineRenderer->BeginFrame(dxCommon->GetSwapChain()->GetCurrentBackBufferIndex());
+		}
 	}
 
 	// 入力の更新
@@ -231,7 +260,8 @@ void EngineSystem::CreateGraphicsComponents()
  RegisterComponent(std::move(directXCommon));
 
 	// TextureManagerの初期化（シングルトン）
-	TextureManager::GetInstance().Initialize(dxPtr);
+	// PNGなどは初回読み込み時にミップマップ生成・ブロック圧縮したDDSに変換し、Cache/Texture に保存する
+	TextureManager::GetInstance().Initialize(dxPtr, "Cache/Texture");
 
 	// ResourceFactoryの作成（コンストラクタで初期化済み）
 	auto resourceFactory = std::make_unique<ResourceFactory>();
@@ -280,6 +310,13 @@ void EngineSystem::CreateGraphicsComponents()
 	modelParticleRenderer->Initialize(dxPtr->GetDevice());
 	renderManager->RegisterRenderer(RenderPassType::ModelParticle, std::move(modelParticleRenderer));
 	
+	// 並列コマンド記録の準備（メインスレッドも1チャンクを記録するので論理コア数まで）
+	uint32_t hardwareThreads = std::thread::hardware_concurrency();
+	uint32_t recordingWorkerCount = hardwareThreads > 0 ? hardwareThreads : 1;
+	renderManager->InitializeParallelRecording(dxPtr->GetCommandManager(),
+		[renderPtr](ID3D12GraphicsCommandList* cmdList) { renderPtr->ApplyRenderTargetState(cmdList); },
+		recordingWorkerCount);
+
 	// RenderManagerを登録
 	RegisterComponent(std::move(renderManager));
 
@@ -295,7 +332,8 @@ void EngineSystem::CreateGraphicsComponents()
 
 	// ModelManagerの作成と初期化
 	auto modelManager = std::make_unique<ModelManager>();
-	modelManager->Initialize(dxPtr, resourcePtr);
+	// 頂点の結合・三角形の並べ替えを行ったモデルを Cache/Model に保存し、次回以降は最適化を省く
+	modelManager->Initialize(dxPtr, resourcePtr, "Cache/Model");
 	RegisterComponent(std::move(modelManager));
 }
 
@@ -1,4 +1,5 @@
 #include "CommandManager.h"
+#include "UploadManager.h"
 #include "Engine/Utility/Logger/Logger.h"
 
 #include <cassert>
@@ -56,6 +57,99 @@ void CommandManager::SignalFrame(UINT frameIndex)
     commandQueue_->Signal(fence_.Get(), fenceVal_);
 }
 
+void CommandManager::BeginFrame(UINT frameIndex)
+{
+    currentFrameIndex_ = frameIndex;
+    currentAllocator_ = commandAllocators_[frameIndex].Get();
+
+    // このフレームのワーカー用アロケータをリセット（WaitForFrame済みなのでGPUは使用していない）
+    for (auto& allocator : workerAllocators_[frameIndex]) {
+        HRESULT hr = allocator->Reset();
+        assert(SUCCEEDED(hr));
+        (void)hr;
+    }
+}
+
+void CommandManager::InitializeWorkerCommandLists(uint32_t workerCount)
+{
+    HRESULT result = S_FALSE;
+
+    for (UINT frame = 0; frame < kFrameCount; ++frame) {
+        workerAllocators_[frame].resize(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i) {
+            result = device_->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(workerAllocators_[frame][i].GetAddressOf()));
+            assert(SUCCEEDED(result));
+        }
+    }
+
+    workerCommandLists_.resize(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        result = device_->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, workerAllocators_[currentFrameIndex_][i].Get(), nullptr, IID_PPV_ARGS(workerCommandLists_[i].GetAddressOf()));
+        assert(SUCCEEDED(result));
+        // 記録開始時にResetするため、作成直後は閉じておく
+        workerCommandLists_[i]->Close();
+    }
+}
+
+void CommandManager::FlushCommandList()
+{
+    HRESULT hr = commandList_->Close();
+    assert(SUCCEEDED(hr));
+
+    // 記録済みのコピーを先に提出（このリストはコピーの完了を待ってから実行される）
+    if (uploadManager_) {
+        uploadManager_->Flush();
+    }
+
+    ID3D12CommandList* commandLists[] = { commandList_.Get() };
+    commandQueue_->ExecuteCommandLists(1, commandLists);
+
+    // アロケータはリセットせず、続きを同じアロケータに記録する
+    hr = commandList_->Reset(currentAllocator_, nullptr);
+    assert(SUCCEEDED(hr));
+    (void)hr;
+}
+
+void CommandManager::BeginRecording(uint32_t listIndex)
+{
+    assert(listIndex < workerCommandLists_.size());
+
+    ID3D12GraphicsCommandList* list = workerCommandLists_[listIndex].Get();
+    HRESULT hr = list->Reset(workerAllocators_[currentFrameIndex_][listIndex].Get(), nullptr);
+    assert(SUCCEEDED(hr));
+    (void)hr;
+
+    // このスレッドからのGetCommandListをワーカーのリストに向ける
+    tlsRecordingList_ = list;
+}
+
+void CommandManager::EndRecording(uint32_t listIndex)
+{
+    assert(listIndex < workerCommandLists_.size());
+
+    HRESULT hr = workerCommandLists_[listIndex]->Close();
+    assert(SUCCEEDED(hr));
+    (void)hr;
+
+    tlsRecordingList_ = nullptr;
+}
+
+void CommandManager::ExecuteRecorded(uint32_t listCount)
+{
+    assert(listCount <= workerCommandLists_.size());
+
+    std::vector<ID3D12CommandList*> commandLists(listCount);
+    for (uint32_t i = 0; i < listCount; ++i) {
+        commandLists[i] = workerCommandLists_[i].Get();
+    }
+    if (uploadManager_) {
+        uploadManager_->Flush();
+    }
+
+    // 1回の呼び出しに渡した順でGPU上でも実行される
+    commandQueue_->ExecuteCommandLists(listCount, commandLists.data());
+}
+
 void CommandManager::InitializeCommand()
 {
     HRESULT result = S_FALSE;
@@ -80,6 +174,7 @@ void CommandManager::InitializeCommand()
     result = device_->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, commandAllocator_.Get(), nullptr, IID_PPV_ARGS(commandList_.GetAddressOf()));
     // コマンドリストの生成が上手く行かなかったので起動できない
     assert(SUCCEEDED(result));
+    currentAllocator_ = commandAllocator_.Get();
 }
 
 void CommandManager::CreateFenceToEvent()
@@ -1,13 +1,17 @@
 #pragma once
 
+#include "Engine/Graphics/Render/Parallel/ICommandRecordingTarget.h"
 #include <d3d12.h>
 #include <wrl.h>
 #include <cstdint>
+#include <vector>
+
+class UploadManager;
 
 using namespace Microsoft::WRL;
 
 /// @brief DirectX12コマンド関連の管理クラス
-class CommandManager {
+class CommandManager : public ICommandRecordingTarget {
 public:
     /// @brief 初期化
     /// @param device D3D12デバイス
@@ -27,10 +31,36 @@ public:
     /// @param frameIndex フレームインデックス
     void SignalFrame(UINT frameIndex);
 
+    /// @brief フレームの開始処理（GPU完了待ち・メインアロケータのリセット後に呼ぶ）
+    /// @param frameIndex 開始するフレームインデックス
+    void BeginFrame(UINT frameIndex);
+
+    /// @brief 並列記録用のワーカーコマンドリストを作成
+    /// @param workerCount ワーカー数（フレームごとにこの数のアロケータとリストを持つ）
+    void InitializeWorkerCommandLists(uint32_t workerCount);
+
+    /// @brief 提出前にコピーを提出させるアップロード管理を設定
+    void SetUploadManager(UploadManager* uploadManager) { uploadManager_ = uploadManager; }
+
+    /// @brief ワーカーコマンドリスト数を取得
+    uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workerCommandLists_.size()); }
+
+    /// @brief ここまで記録したメインのコマンドリストを実行し、同じアロケータで記録を再開
+    /// @details 再開後のコマンドリストは描画先などの状態を持たないため、呼び出し側で再設定すること
+    void FlushCommandList();
+
+    // ICommandRecordingTargetの実装
+    void BeginRecording(uint32_t listIndex) override;
+    void EndRecording(uint32_t listIndex) override;
+    void ExecuteRecorded(uint32_t listCount) override;
+
     // アクセッサ
     ID3D12CommandQueue* GetCommandQueue() const { return commandQueue_.Get(); }
     ID3D12CommandAllocator* GetCommandAllocator() const { return commandAllocator_.Get(); }
-    ID3D12GraphicsCommandList* GetCommandList() const { return commandList_.Get(); }
+
+    /// @brief コマンドリストを取得
+    /// @return ワーカースレッドで記録中ならそのスレッドのリスト、それ以外はメインのリスト
+    ID3D12GraphicsCommandList* GetCommandList() const { return tlsRecordingList_ ? tlsRecordingList_ : commandList_.Get(); }
     
     /// @brief 特定のフレームのコマンドアロケータを取得
     ID3D12CommandAllocator* GetCommandAllocator(UINT frameIndex) const { return commandAllocators_[frameIndex].Get(); }
@@ -50,6 +80,15 @@ private:
     ComPtr<ID3D12CommandAllocator> commandAllocator_; // レガシー用（後方互換性）
     ComPtr<ID3D12CommandAllocator> commandAllocators_[kFrameCount]; // フレームごとのアロケータ
     ComPtr<ID3D12GraphicsCommandList> commandList_;
+    ID3D12CommandAllocator* currentAllocator_ = nullptr; // メインのリストが現在使用中のアロケータ
+    UINT currentFrameIndex_ = 0;
+
+    // 並列記録用（[フレーム][ワーカー]）
+    std::vector<ComPtr<ID3D12CommandAllocator>> workerAllocators_[kFrameCount];
+    std::vector<ComPtr<ID3D12GraphicsCommandList>> workerCommandLists_;
+
+    // ワーカースレッドで記録中のリスト（GetCommandListの差し替え用）
+    static inline thread_local ID3D12GraphicsCommandList* tlsRecordingList_ = nullptr;
 
     // フェンス & イベント
     ComPtr<ID3D12Fence> fence_;
@@ -58,4 +97,5 @@ private:
     HANDLE fenceEvent_ = nullptr;
 
     ID3D12Device* device_ = nullptr;
+    UploadManager* uploadManager_ = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include "DescriptorAllocator.h"
+#include <algorithm>
+#include <cassert>
+
+// ===== DescriptorAllocator =====
+
+void DescriptorAllocator::Initialize(uint32_t firstIndex, uint32_t capacity, uint32_t pageSize, uint32_t frameCount)
+{
+    assert(pageSize > 0 && frameCount > 0);
+    firstIndex_ = firstIndex;
+    capacity_ = capacity;
+    pageSize_ = pageSize;
+    committed_ = 0;
+
+    freeRanges_.clear();
+    generations_.clear();
+    allocationCounts_.clear();
+    retired_.assign(frameCount, {});
+
+    statistics_ = {};
+    statistics_.capacity = capacity;
+}
+
+DescriptorAllocation DescriptorAllocator::Allocate(uint32_t count)
+{
+    assert(count > 0);
+
+    // 先頭から最初に入る空き範囲を探す
+    auto it = std::find_if(freeRanges_.begin(), freeRanges_.end(),
+        [count](const auto& range) { return range.second >= count; });
+    if (it == freeRanges_.end()) {
+        if (!Commit(count)) {
+            return {};
+        }
+        it = std::find_if(freeRanges_.begin(), freeRanges_.end(),
+            [count](const auto& range) { return range.second >= count; });
+        assert(it != freeRanges_.end());
+    }
+
+    uint32_t begin = it->first;
+    uint32_t rangeCount = it->second;
+    freeRanges_.erase(it);
+    if (rangeCount > count) {
+        freeRanges_.emplace(begin + count, rangeCount - count);
+    }
+
+    allocationCounts_[begin] = count;
+    statistics_.allocatedCount += count;
+    statistics_.peakAllocatedCount = (std::max)(statistics_.peakAllocatedCount, statistics_.allocatedCount);
+    ++statistics_.allocationCount;
+
+    DescriptorAllocation allocation;
+    allocation.index = firstIndex_ + begin;
+    allocation.count = count;
+    allocation.generation = generations_[begin];
+    return allocation;
+}
+
+bool DescriptorAllocator::Free(const DescriptorAllocation& allocation)
+{
+    if (!Invalidate(allocation)) {
+        return false;
+    }
+    InsertFreeRange(allocation.index - firstIndex_, allocation.count);
+    statistics_.allocatedCount -= allocation.count;
+    return true;
+}
+
+bool DescriptorAllocator::Retire(const DescriptorAllocation& allocation, uint32_t frameIndex)
+{
+    assert(frameIndex < retired_.size());
+    if (!Invalidate(allocation)) {
+        return false;
+    }
+    retired_[frameIndex].push_back({ allocation.index - firstIndex_, allocation.count });
+    statistics_.retiredCount += allocation.count;
+    return true;
+}
+
+void DescriptorAllocator::ReleaseRetired(uint32_t frameIndex)
+{
+    assert(frameIndex < retired_.size());
+    for (const RetiredRange& range : retired_[frameIndex]) {
+        InsertFreeRange(range.begin, range.count);
+        statistics_.allocatedCount -= range.count;
+        statistics_.retiredCount -= range.count;
+    }
+    retired_[frameIndex].clear();
+}
+
+bool DescriptorAllocator::IsAlive(const DescriptorAllocation& allocation) const
+{
+    if (!allocation.IsValid() || allocation.index < firstIndex_) {
+        return false;
+    }
+    uint32_t begin = allocation.index - firstIndex_;
+    return begin < committed_
+        && allocationCounts_[begin] == allocation.count
+        && generations_[begin] == allocation.generation;
+}
+
+uint32_t DescriptorAllocator::GetLargestFreeRange() const
+{
+    uint32_t largest = capacity_ - committed_;
+    for (const auto& [begin, count] : freeRanges_) {
+        // 末尾の空きは未使用のページと続いている
+        uint32_t size = (begin + count == committed_) ? count + capacity_ - committed_ : count;
+        largest = (std::max)(largest, size);
+    }
+    return largest;
+}
+
+DescriptorAllocator::Statistics DescriptorAllocator::GetStatistics() const
+{
+    Statistics statistics = statistics_;
+    statistics.committedCount = committed_;
+    statistics.freeRangeCount = static_cast<uint32_t>(freeRanges_.size());
+    return statistics;
+}
+
+bool DescriptorAllocator::Commit(uint32_t required)
+{
+    // 末尾の空き範囲は新しいページと結合されるので、その分は広げなくてよい
+    uint32_t tailFree = 0;
+    if (!freeRanges_.empty()) {
+        auto last = std::prev(freeRanges_.end());
+        if (last->first + last->second == committed_) {
+            tailFree = last->second;
+        }
+    }
+    uint32_t needed = required - tailFree;
+    uint32_t pages = (needed + pageSize_ - 1) / pageSize_;
+    uint32_t newCommitted = static_cast<uint32_t>((std::min)(static_cast<uint64_t>(committed_) + static_cast<uint64_t>(pages) * pageSize_, static_cast<uint64_t>(capacity_)));
+    if (newCommitted - committed_ < needed) {
+        return false;
+    }
+
+    uint32_t begin = committed_;
+    committed_ = newCommitted;
+    generations_.resize(committed_, 0);
+    allocationCounts_.resize(committed_, 0);
+    InsertFreeRange(begin, committed_ - begin);
+    return true;
+}
+
+void DescriptorAllocator::InsertFreeRange(uint32_t begin, uint32_t count)
+{
+    uint32_t end = begin + count;
+
+    // 後ろの範囲と結合
+    auto next = freeRanges_.lower_bound(begin);
+    if (next != freeRanges_.end() && next->first == end) {
+        end += next->second;
+        next = freeRanges_.erase(next);
+    }
+
+    // 前の範囲と結合
+    if (next != freeRanges_.begin()) {
+        auto previous = std::prev(next);
+        assert(previous->first + previous->second <= begin && "空き範囲が重複している");
+        if (previous->first + previous->second == begin) {
+            previous->second = end - previous->first;
+            return;
+        }
+    }
+    freeRanges_.emplace_hint(next, begin, end - begin);
+}
+
+bool DescriptorAllocator::Invalidate(const DescriptorAllocation& allocation)
+{
+    if (!IsAlive(allocation)) {
+        ++statistics_.staleFreeCount;
+        return false;
+    }
+    uint32_t begin = allocation.index - firstIndex_;
+    for (uint32_t i = 0; i < allocation.count; ++i) {
+        ++generations_[begin + i];
+    }
+    allocationCounts_[begin] = 0;
+    --statistics_.allocationCount;
+    return true;
+}
+
+// ===== TransientDescriptorAllocator =====
+
+void TransientDescriptorAllocator::Initialize(uint32_t firstIndex, uint32_t countPerFrame, uint32_t frameCount)
+{
+    assert(frameCount > 0);
+    firstIndex_ = firstIndex;
+    countPerFrame_ = countPerFrame;
+    frameCount_ = frameCount;
+    frameIndex_ = 0;
+    used_ = 0;
+    peakUsed_ = 0;
+}
+
+void TransientDescriptorAllocator::BeginFrame(uint32_t frameIndex)
+{
+    assert(frameIndex < frameCount_);
+    frameIndex_ = frameIndex;
+    used_ = 0;
+}
+
+uint32_t TransientDescriptorAllocator::Allocate(uint32_t count)
+{
+    if (count == 0 || used_ + count > countPerFrame_) {
+        return DescriptorAllocation::kInvalidIndex;
+    }
+    uint32_t index = firstIndex_ + frameIndex_ * countPerFrame_ + used_;
+    used_ += count;
+    peakUsed_ = (std::max)(peakUsed_, used_);
+    return index;
+}
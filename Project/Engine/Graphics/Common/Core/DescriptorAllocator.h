@@ -0,0 +1,130 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <vector>
+
+/// @brief ディスクリプタの割り当て結果
+/// @details 割り当て時の世代を持つので、解放済みのものを使おうとすると IsAlive で検出できる。
+struct DescriptorAllocation {
+    static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+    uint32_t index = kInvalidIndex; ///< ヒープ内の先頭インデックス
+    uint32_t count = 0;             ///< 連続したディスクリプタ数
+    uint32_t generation = 0;        ///< 割り当て時の世代
+
+    bool IsValid() const { return index != kInvalidIndex; }
+};
+
+/// @brief 永続ディスクリプタの割り当て（D3D12に依存しない）
+/// @details ヒープ内の [firstIndex, firstIndex + capacity) を管理する。
+/// 空き領域は開始位置順の連続範囲として持ち、解放時に前後と結合する（先頭から最初に入る範囲を使う）。
+/// 空きが足りなければページ単位で使用範囲を広げるので、ヒープを大きく取っても使う範囲は先頭に詰まる。
+/// GPUが参照中の可能性があるものは Retire で世代だけ進め、そのフレームの完了後に ReleaseRetired で空きに戻す。
+class DescriptorAllocator {
+public:
+    /// @brief 統計
+    struct Statistics {
+        uint32_t capacity = 0;           ///< 管理している総数
+        uint32_t committedCount = 0;     ///< ページ単位で使用を始めた数
+        uint32_t allocatedCount = 0;     ///< 割り当て中の数（解放待ちを含む）
+        uint32_t retiredCount = 0;       ///< GPUの完了を待っている数
+        uint32_t peakAllocatedCount = 0; ///< 割り当て中の数の最大
+        uint32_t allocationCount = 0;    ///< 割り当て中の塊の数
+        uint32_t freeRangeCount = 0;     ///< 空き範囲の数（断片化の目安）
+        uint32_t staleFreeCount = 0;     ///< 解放済み・不正な割り当てを解放しようとした回数
+    };
+
+    /// @brief 初期化
+    /// @param firstIndex 管理する範囲の先頭（ヒープ内のインデックス）
+    /// @param capacity 管理する数
+    /// @param pageSize 使用範囲を広げる単位
+    /// @param frameCount 解放待ちを分けるフレーム数
+    void Initialize(uint32_t firstIndex, uint32_t capacity, uint32_t pageSize, uint32_t frameCount);
+
+    /// @brief 連続したディスクリプタを割り当てる
+    /// @param count 個数
+    /// @return 割り当て結果（空きがなければ IsValid() が false）
+    DescriptorAllocation Allocate(uint32_t count = 1);
+
+    /// @brief すぐに解放する（GPUが参照していないことが分かっている場合）
+    /// @return 解放済み・不正な割り当てならfalse（何もしない）
+    bool Free(const DescriptorAllocation& allocation);
+
+    /// @brief 解放待ちにする（以降 IsAlive は false、領域は ReleaseRetired まで再利用しない）
+    /// @param allocation 割り当て
+    /// @param frameIndex 現在記録中のフレーム
+    /// @return 解放済み・不正な割り当てならfalse（何もしない）
+    bool Retire(const DescriptorAllocation& allocation, uint32_t frameIndex);
+
+    /// @brief 指定フレームで解放待ちにしたものを空きに戻す（そのフレームのGPU処理の完了後に呼ぶ）
+    void ReleaseRetired(uint32_t frameIndex);
+
+    /// @brief 割り当てが有効か（解放後や、同じ場所の再割り当て後はfalse）
+    bool IsAlive(const DescriptorAllocation& allocation) const;
+
+    /// @brief 最も大きい空き範囲（まだ使用していないページを含む）
+    uint32_t GetLargestFreeRange() const;
+
+    /// @brief 統計を取得
+    Statistics GetStatistics() const;
+
+private:
+    /// @brief ページ単位で使用範囲を広げる
+    /// @param required 末尾の空きと合わせて必要な数
+    /// @return 広げられればtrue
+    bool Commit(uint32_t required);
+
+    /// @brief 空き範囲を追加（前後と結合する）
+    void InsertFreeRange(uint32_t begin, uint32_t count);
+
+    /// @brief 割り当てを無効にする（世代を進める）
+    bool Invalidate(const DescriptorAllocation& allocation);
+
+    uint32_t firstIndex_ = 0;
+    uint32_t capacity_ = 0;
+    uint32_t pageSize_ = 1;
+    uint32_t committed_ = 0;
+
+    std::map<uint32_t, uint32_t> freeRanges_;     ///< 空き範囲（管理範囲内の開始位置 -> 個数）
+    std::vector<uint32_t> generations_;          ///< 位置ごとの世代
+    std::vector<uint32_t> allocationCounts_;     ///< 割り当ての先頭なら個数、それ以外は0
+
+    struct RetiredRange {
+        uint32_t begin;
+        uint32_t count;
+    };
+    std::vector<std::vector<RetiredRange>> retired_; ///< [フレーム] 解放待ち
+
+    Statistics statistics_;
+};
+
+/// @brief フレームごとの一時ディスクリプタ（D3D12に依存しない）
+/// @details 領域をフレーム数で等分し、各フレームの領域は先頭から順に割り当てるだけにする。
+/// そのフレームのGPU処理の完了後に BeginFrame で先頭に戻すので、個別の解放は不要。
+class TransientDescriptorAllocator {
+public:
+    /// @brief 初期化
+    /// @param firstIndex 領域の先頭（ヒープ内のインデックス）
+    /// @param countPerFrame 1フレームで使える数
+    /// @param frameCount フレーム数
+    void Initialize(uint32_t firstIndex, uint32_t countPerFrame, uint32_t frameCount);
+
+    /// @brief フレームの開始（そのフレームの領域を先頭に戻す）
+    void BeginFrame(uint32_t frameIndex);
+
+    /// @brief 連続したディスクリプタを割り当てる
+    /// @return ヒープ内の先頭インデックス（足りなければ DescriptorAllocation::kInvalidIndex）
+    uint32_t Allocate(uint32_t count = 1);
+
+    uint32_t GetUsedCount() const { return used_; }
+    uint32_t GetPeakUsedCount() const { return peakUsed_; }
+    uint32_t GetCountPerFrame() const { return countPerFrame_; }
+
+private:
+    uint32_t firstIndex_ = 0;
+    uint32_t countPerFrame_ = 0;
+    uint32_t frameCount_ = 1;
+    uint32_t frameIndex_ = 0;
+    uint32_t used_ = 0;
+    uint32_t peakUsed_ = 0;
+};
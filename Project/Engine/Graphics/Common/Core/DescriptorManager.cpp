@@ -14,6 +14,12 @@ void DescriptorManager::Initialize(ID3D12Device* device)
 	device_ = device;             
 	CreateDescriptorHeaps();
 
+	// SRV/CBV/UAVヒープの内訳（予約の後ろから一時領域の手前までを永続領域にする）
+	srvDescriptorSize_ = device_->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	srvAllocator_.Initialize(kUserSRVStart, kTransientSRVStart - kUserSRVStart, kSRVPageSize, kFrameCount);
+	transientSRVAllocator_.Initialize(kTransientSRVStart, kTransientSRVDescriptorsPerFrame, kFrameCount);
+	currentFrameIndex_ = 0;
+
 	logger.Log(
 		std::format("DescriptorManager初期化完了: SRV最大数={}, RTV最大数={}, DSV最大数={}\n",
 			kMaxSRVDescriptors, kMaxRTVDescriptors, kMaxDSVDescriptors),
@@ -31,71 +37,68 @@ void DescriptorManager::Initialize(ID3D12Device* device)
 #endif
 }
 
-void DescriptorManager::CreateSRV(ID3D12Resource* resource, const D3D12_SHADER_RESOURCE_VIEW_DESC& desc,
+DescriptorAllocation DescriptorManager::CreateSRV(ID3D12Resource* resource, const D3D12_SHADER_RESOURCE_VIEW_DESC& desc,
 	D3D12_CPU_DESCRIPTOR_HANDLE& outCpuDesc,
 	D3D12_GPU_DESCRIPTOR_HANDLE& outGpuDesc,
 	const std::string& debugName)
 {
 	assert(resource != nullptr && "Resource must not be null");
 
-	// 境界チェック
-	CheckDescriptorBounds(nextSRVDescriptorIndex_, kMaxSRVDescriptors, "SRV");
+	// 割り当て（満杯なら例外）
+	DescriptorAllocation allocation = AllocateSRVDescriptor("SRV");
 
 	// ハンドル計算
-	CalculateSRVHandles(nextSRVDescriptorIndex_, outCpuDesc, outGpuDesc);
+	CalculateSRVHandles(allocation.index, outCpuDesc, outGpuDesc);
 
 	// SRV作成
 	device_->CreateShaderResourceView(resource, &desc, outCpuDesc);
 
 	// ログ出力
-	LogViewCreation(nextSRVDescriptorIndex_, "SRV", debugName);
+	LogViewCreation(allocation.index, "SRV", debugName);
 
-	// インデックス更新
-	++nextSRVDescriptorIndex_;
+	return allocation;
 }
 
-void DescriptorManager::CreateUAV(ID3D12Resource* resource, const D3D12_UNORDERED_ACCESS_VIEW_DESC& desc,
+DescriptorAllocation DescriptorManager::CreateUAV(ID3D12Resource* resource, const D3D12_UNORDERED_ACCESS_VIEW_DESC& desc,
 	D3D12_CPU_DESCRIPTOR_HANDLE& outCpuDesc,
 	D3D12_GPU_DESCRIPTOR_HANDLE& outGpuDesc,
 	const std::string& debugName)
 {
 	assert(resource != nullptr && "Resource must not be null");
 
-	// 境界チェック
-	CheckDescriptorBounds(nextSRVDescriptorIndex_, kMaxSRVDescriptors, "SRV/UAV");
+	// 割り当て（満杯なら例外）
+	DescriptorAllocation allocation = AllocateSRVDescriptor("SRV/UAV");
 
 	// ハンドル計算
-	CalculateSRVHandles(nextSRVDescriptorIndex_, outCpuDesc, outGpuDesc);
+	CalculateSRVHandles(allocation.index, outCpuDesc, outGpuDesc);
 
 	// UAV作成
 	device_->CreateUnorderedAccessView(resource, nullptr, &desc, outCpuDesc);
 
 	// ログ出力
-	LogViewCreation(nextSRVDescriptorIndex_, "UAV", debugName);
+	LogViewCreation(allocation.index, "UAV", debugName);
 
-	// インデックス更新
-	++nextSRVDescriptorIndex_;
+	return allocation;
 }
 
-void DescriptorManager::CreateCBV(const D3D12_CONSTANT_BUFFER_VIEW_DESC& desc,
+DescriptorAllocation DescriptorManager::CreateCBV(const D3D12_CONSTANT_BUFFER_VIEW_DESC& desc,
 	D3D12_CPU_DESCRIPTOR_HANDLE& outCpuDesc,
 	D3D12_GPU_DESCRIPTOR_HANDLE& outGpuDesc,
 	const std::string& debugName)
 {
-	// 境界チェック
-	CheckDescriptorBounds(nextSRVDescriptorIndex_, kMaxSRVDescriptors, "CBV");
+	// 割り当て（満杯なら例外）
+	DescriptorAllocation allocation = AllocateSRVDescriptor("CBV");
 
 	// ハンドル計算
-	CalculateSRVHandles(nextSRVDescriptorIndex_, outCpuDesc, outGpuDesc);
+	CalculateSRVHandles(allocation.index, outCpuDesc, outGpuDesc);
 
 	// CBV作成
 	device_->CreateConstantBufferView(&desc, outCpuDesc);
 
 	// ログ出力
-	LogViewCreation(nextSRVDescriptorIndex_, "CBV", debugName);
+	LogViewCreation(allocation.index, "CBV", debugName);
 
-	// インデックス更新
-	++nextSRVDescriptorIndex_;
+	return allocation;
 }
 
 void DescriptorManager::CreateRTV(ID3D12Resource* resource, const D3D12_RENDER_TARGET_VIEW_DESC& rtvDesc,
@@ -140,6 +143,108 @@ void DescriptorManager::CreateDSV(ID3D12Resource* resource, const D3D12_DEPTH_ST
 	++nextDSVDescriptorIndex_;
 }
 
+void DescriptorManager::Free(const DescriptorAllocation& allocation)
+{
+	if (!allocation.IsValid()) {
+		return;
+	}
+
+	bool retired;
+	{
+		std::lock_guard<std::mutex> lock(srvMutex_);
+		// このフレームのコマンドがまだ参照しているかもしれないので、完了するまで再利用しない
+		retired = srvAllocator_.Retire(allocation, currentFrameIndex_);
+	}
+
+	if (!retired) {
+		logger.Log(
+			std::format("エラー: 解放済み、または不正なSRVを解放しようとしました! インデックス={}, 個数={}, 世代={}\n",
+				allocation.index, allocation.count, allocation.generation),
+			LogLevel::Error, LogCategory::Graphics);
+		assert(false && "Descriptor double free");
+	}
+}
+
+bool DescriptorManager::IsAlive(const DescriptorAllocation& allocation) const
+{
+	std::lock_guard<std::mutex> lock(srvMutex_);
+	return srvAllocator_.IsAlive(allocation);
+}
+
+void DescriptorManager::AllocateTransient(UINT count, D3D12_CPU_DESCRIPTOR_HANDLE& outCpuDesc, D3D12_GPU_DESCRIPTOR_HANDLE& outGpuDesc)
+{
+	uint32_t index;
+	{
+		std::lock_guard<std::mutex> lock(srvMutex_);
+		index = transientSRVAllocator_.Allocate(count);
+	}
+
+	if (index == DescriptorAllocation::kInvalidIndex) {
+		logger.Log(
+			std::format("エラー: SRV一時領域が不足しています! 1フレームの最大数={}, 要求数={}\n",
+				kTransientSRVDescriptorsPerFrame, count),
+			LogLevel::Error, LogCategory::Graphics);
+		throw std::runtime_error("Transient SRV descriptor region is full!");
+	}
+
+	CalculateSRVHandles(index, outCpuDesc, outGpuDesc);
+}
+
+void DescriptorManager::BeginFrame(UINT frameIndex)
+{
+	std::lock_guard<std::mutex> lock(srvMutex_);
+	currentFrameIndex_ = frameIndex % kFrameCount;
+	// 前回このフレームで解放したものはGPUの処理が終わっているので再利用できる
+	srvAllocator_.ReleaseRetired(currentFrameIndex_);
+	transientSRVAllocator_.BeginFrame(currentFrameIndex_);
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE DescriptorManager::GetCPUHandle(const DescriptorAllocation& allocation) const
+{
+	assert(allocation.IsValid());
+	D3D12_CPU_DESCRIPTOR_HANDLE handle = srvHeap_->GetCPUDescriptorHandleForHeapStart();
+	handle.ptr += static_cast<SIZE_T>(allocation.index) * srvDescriptorSize_;
+	return handle;
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE DescriptorManager::GetGPUHandle(const DescriptorAllocation& allocation) const
+{
+	assert(allocation.IsValid());
+	D3D12_GPU_DESCRIPTOR_HANDLE handle = srvHeap_->GetGPUDescriptorHandleForHeapStart();
+	handle.ptr += static_cast<UINT64>(allocation.index) * srvDescriptorSize_;
+	return handle;
+}
+
+UINT DescriptorManager::GetUsedSRVCount() const
+{
+	std::lock_guard<std::mutex> lock(srvMutex_);
+	// 予約分を含めたヒープ全体での使用数（一時領域は除く）
+	return kUserSRVStart + srvAllocator_.GetStatistics().allocatedCount;
+}
+
+float DescriptorManager::GetSRVUsageRate() const
+{
+	return static_cast<float>(GetUsedSRVCount()) / kTransientSRVStart;
+}
+
+DescriptorAllocator::Statistics DescriptorManager::GetSRVStatistics() const
+{
+	std::lock_guard<std::mutex> lock(srvMutex_);
+	return srvAllocator_.GetStatistics();
+}
+
+UINT DescriptorManager::GetUsedTransientSRVCount() const
+{
+	std::lock_guard<std::mutex> lock(srvMutex_);
+	return transientSRVAllocator_.GetUsedCount();
+}
+
+UINT DescriptorManager::GetPeakTransientSRVCount() const
+{
+	std::lock_guard<std::mutex> lock(srvMutex_);
+	return transientSRVAllocator_.GetPeakUsedCount();
+}
+
 void DescriptorManager::CreateDescriptorHeaps()
 {
 	// RTV用のディスクリプタヒープの生成
@@ -174,6 +279,26 @@ ComPtr<ID3D12DescriptorHeap> DescriptorManager::CreateDescriptorHeap(D3D12_DESCR
 	return descriptorHeap;
 }
 
+DescriptorAllocation DescriptorManager::AllocateSRVDescriptor(const std::string& viewType)
+{
+	DescriptorAllocation allocation;
+	DescriptorAllocator::Statistics statistics;
+	{
+		std::lock_guard<std::mutex> lock(srvMutex_);
+		allocation = srvAllocator_.Allocate();
+		statistics = srvAllocator_.GetStatistics();
+	}
+
+	if (!allocation.IsValid()) {
+		logger.Log(
+			std::format("エラー: {}ヒープが満杯です! 永続領域の最大数={}, 使用中={}, 解放待ち={}\n",
+				viewType, statistics.capacity, statistics.allocatedCount, statistics.retiredCount),
+			LogLevel::Error, LogCategory::Graphics);
+		throw std::runtime_error(viewType + " descriptor heap is full!");
+	}
+	return allocation;
+}
+
 void DescriptorManager::CheckDescriptorBounds(UINT currentIndex, UINT maxCount, const std::string& heapName)
 {
 	// 境界チェック
@@ -190,15 +315,13 @@ void DescriptorManager::CalculateSRVHandles(UINT index,
 	D3D12_CPU_DESCRIPTOR_HANDLE& outCpuHandle,
 	D3D12_GPU_DESCRIPTOR_HANDLE& outGpuHandle)
 {
-	UINT descriptorSize = device_->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-
 	// CPUハンドル計算
 	outCpuHandle = srvHeap_->GetCPUDescriptorHandleForHeapStart();
-	outCpuHandle.ptr += index * descriptorSize;
+	outCpuHandle.ptr += static_cast<SIZE_T>(index) * srvDescriptorSize_;
 
 	// GPUハンドル計算
 	outGpuHandle = srvHeap_->GetGPUDescriptorHandleForHeapStart();
-	outGpuHandle.ptr += index * descriptorSize;
+	outGpuHandle.ptr += static_cast<UINT64>(index) * srvDescriptorSize_;
 }
 
 D3D12_CPU_DESCRIPTOR_HANDLE DescriptorManager::CalculateRTVHandle(UINT index)
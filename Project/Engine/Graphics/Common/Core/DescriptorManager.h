@@ -4,18 +4,29 @@
 #include <wrl.h>
 #include <string>
 #include <cstdint>
+#include <mutex>
 #include <stdexcept>
 
+#include "DescriptorAllocator.h"
+
 using namespace Microsoft::WRL;
 
 /// @brief ディスクリプタヒープ管理クラス
+/// @details SRV/CBV/UAVヒープは [予約 | 永続 | フレームごとの一時] に分けて使う。
+/// 永続領域は DescriptorAllocator で割り当て・解放し、解放したものはそのフレームのGPU処理が終わるまで再利用しない。
+/// 一時領域はフレームごとに先頭から割り当て、BeginFrame でまとめて戻す。
 class DescriptorManager {
 public:
 	// ディスクリプタヒープの最大サイズ
 	static constexpr UINT kMaxRTVDescriptors = 10;   // スワップチェーン2 + オフスクリーン2
-	static constexpr UINT kMaxSRVDescriptors = 128; // テクスチャやバッファ用（SRV/CBV/UAV共有）
+	static constexpr UINT kMaxSRVDescriptors = 32768; // テクスチャやバッファ用（SRV/CBV/UAV共有）
 	static constexpr UINT kMaxDSVDescriptors = 10;   // デプスステンシル用
 
+	// SRV/CBV/UAVヒープの内訳
+	static constexpr UINT kFrameCount = 2;                       // 解放待ち・一時領域を分けるフレーム数
+	static constexpr UINT kTransientSRVDescriptorsPerFrame = 2048; // 1フレームで使える一時ディスクリプタ数
+	static constexpr UINT kSRVPageSize = 256;                    // 永続領域の使用範囲を広げる単位
+
 	// 予約済みインデックス（スワップチェーン用）
 	static constexpr UINT kReservedSRVStart = 0;
 	static constexpr UINT kReservedRTVStart = 0;
@@ -23,6 +34,7 @@ public:
 	static constexpr UINT kUserSRVStart = 1; // ユーザーリソースは1から
 	static constexpr UINT kUserRTVStart = 2;        // スワップチェーン用に0,1を予約
 	static constexpr UINT kUserDSVStart = 0;        // DSVは0から使用可能
+	static constexpr UINT kTransientSRVStart = kMaxSRVDescriptors - kTransientSRVDescriptorsPerFrame * kFrameCount; // 一時領域の先頭
 
 	/// @brief 初期化
 	/// @param device D3D12デバイス
@@ -34,7 +46,8 @@ public:
 	/// @param outCpuDesc CPUディスクリプタハンドル出力
 	/// @param outGpuDesc GPUディスクリプタハンドル出力
 	/// @param debugName デバッグ用名前
-	void CreateSRV(ID3D12Resource* resource, const D3D12_SHADER_RESOURCE_VIEW_DESC& desc,
+	/// @return 割り当て（解放する場合は Free に渡す。捨てればアプリケーション終了まで保持される）
+	DescriptorAllocation CreateSRV(ID3D12Resource* resource, const D3D12_SHADER_RESOURCE_VIEW_DESC& desc,
 		D3D12_CPU_DESCRIPTOR_HANDLE& outCpuDesc,
 		D3D12_GPU_DESCRIPTOR_HANDLE& outGpuDesc,
 		const std::string& debugName = "Unknown");
@@ -45,7 +58,8 @@ public:
 	/// @param outCpuDesc CPUディスクリプタハンドル出力
 	/// @param outGpuDesc GPUディスクリプタハンドル出力
 	/// @param debugName デバッグ用名前
-	void CreateUAV(ID3D12Resource* resource, const D3D12_UNORDERED_ACCESS_VIEW_DESC& desc,
+	/// @return 割り当て（解放する場合は Free に渡す。捨てればアプリケーション終了まで保持される）
+	DescriptorAllocation CreateUAV(ID3D12Resource* resource, const D3D12_UNORDERED_ACCESS_VIEW_DESC& desc,
 		D3D12_CPU_DESCRIPTOR_HANDLE& outCpuDesc,
 		D3D12_GPU_DESCRIPTOR_HANDLE& outGpuDesc,
 		const std::string& debugName = "Unknown");
@@ -55,7 +69,8 @@ public:
 	/// @param outCpuDesc CPUディスクリプタハンドル出力
 	/// @param outGpuDesc GPUディスクリプタハンドル出力
 	/// @param debugName デバッグ用名前
-	void CreateCBV(const D3D12_CONSTANT_BUFFER_VIEW_DESC& desc,
+	/// @return 割り当て（解放する場合は Free に渡す。捨てればアプリケーション終了まで保持される）
+	DescriptorAllocation CreateCBV(const D3D12_CONSTANT_BUFFER_VIEW_DESC& desc,
 		D3D12_CPU_DESCRIPTOR_HANDLE& outCpuDesc,
 		D3D12_GPU_DESCRIPTOR_HANDLE& outGpuDesc,
 		const std::string& debugName = "Unknown");
@@ -76,18 +91,47 @@ public:
 	void CreateDSV(ID3D12Resource* resource, const D3D12_DEPTH_STENCIL_VIEW_DESC& dsvDesc,
 		D3D12_CPU_DESCRIPTOR_HANDLE& outDsvHandle, const std::string& debugName = "Unknown");
 
+	/// @brief SRV/CBV/UAVを解放（そのフレームのGPU処理が終わってから再利用される）
+	/// @param allocation Create* が返した割り当て（解放済みのものを渡すとエラーログを出して無視する）
+	void Free(const DescriptorAllocation& allocation);
+
+	/// @brief 割り当てが有効か（解放後はfalse）
+	bool IsAlive(const DescriptorAllocation& allocation) const;
+
+	/// @brief このフレームだけ使う連続したディスクリプタを割り当てる
+	/// @param count 個数
+	/// @param outCpuDesc 先頭のCPUディスクリプタハンドル出力
+	/// @param outGpuDesc 先頭のGPUディスクリプタハンドル出力
+	void AllocateTransient(UINT count, D3D12_CPU_DESCRIPTOR_HANDLE& outCpuDesc, D3D12_GPU_DESCRIPTOR_HANDLE& outGpuDesc);
+
+	/// @brief フレームの開始（そのフレームのGPU処理の完了後に呼ぶ）
+	/// @details 前回このフレームで解放したディスクリプタを再利用可能にし、一時領域を先頭に戻す。
+	/// @param frameIndex 開始するフレームインデックス
+	void BeginFrame(UINT frameIndex);
+
+	/// @brief 割り当てのハンドルを取得
+	D3D12_CPU_DESCRIPTOR_HANDLE GetCPUHandle(const DescriptorAllocation& allocation) const;
+	D3D12_GPU_DESCRIPTOR_HANDLE GetGPUHandle(const DescriptorAllocation& allocation) const;
+
 	// アクセッサ
 	ID3D12DescriptorHeap* GetRTVHeap() const { return rtvHeap_.Get(); }
 	ID3D12DescriptorHeap* GetSRVHeap() const { return srvHeap_.Get(); }
 	ID3D12DescriptorHeap* GetDSVHeap() const { return dsvHeap_.Get(); }
 
 	// 使用状況の取得
-	UINT GetUsedSRVCount() const { return nextSRVDescriptorIndex_; }
+	UINT GetUsedSRVCount() const;
 	UINT GetUsedRTVCount() const { return nextRTVDescriptorIndex_; }
 	UINT GetUsedDSVCount() const { return nextDSVDescriptorIndex_; }
-	float GetSRVUsageRate() const { return static_cast<float>(nextSRVDescriptorIndex_) / kMaxSRVDescriptors; }
+	float GetSRVUsageRate() const;
 	float GetDSVUsageRate() const { return static_cast<float>(nextDSVDescriptorIndex_) / kMaxDSVDescriptors; }
 
+	/// @brief 永続領域の統計
+	DescriptorAllocator::Statistics GetSRVStatistics() const;
+
+	/// @brief 一時領域の使用数（現在のフレーム・最大）
+	UINT GetUsedTransientSRVCount() const;
+	UINT GetPeakTransientSRVCount() const;
+
 private:
 	/// @brief ディスクリプタヒープの生成
 	void CreateDescriptorHeaps();
@@ -100,6 +144,10 @@ private:
 	ComPtr<ID3D12DescriptorHeap> CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE heapType,
 		UINT numDescriptors, bool shaderVisible);
 
+	/// @brief 永続領域から1つ割り当てる（満杯なら例外）
+	/// @param viewType ビュータイプ（エラーメッセージ用）
+	DescriptorAllocation AllocateSRVDescriptor(const std::string& viewType);
+
 	/// @brief ディスクリプタの境界チェック
 	/// @param currentIndex 現在のインデックス
 	/// @param maxCount 最大数
@@ -144,8 +192,14 @@ private:
 	ComPtr<ID3D12DescriptorHeap> srvHeap_;
 	ComPtr<ID3D12DescriptorHeap> dsvHeap_;
 
-	// 次に割り当てるディスクリプタのインデックス
-	uint32_t nextSRVDescriptorIndex_ = kUserSRVStart;
+	// SRV/CBV/UAVの割り当て（永続・一時）
+	DescriptorAllocator srvAllocator_;
+	TransientDescriptorAllocator transientSRVAllocator_;
+	UINT currentFrameIndex_ = 0;
+	UINT srvDescriptorSize_ = 0;
+	mutable std::mutex srvMutex_; // テクスチャの読み込みなど、複数スレッドから割り当てられる
+
+	// 次に割り当てるディスクリプタのインデックス（RTV・DSVは作り直さないので順に使う）
 	uint32_t nextRTVDescriptorIndex_ = kUserRTVStart;
 	uint32_t nextDSVDescriptorIndex_ = kUserDSVStart;
 
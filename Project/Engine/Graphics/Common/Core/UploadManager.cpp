@@ -0,0 +1,255 @@
+#include "UploadManager.h"
+#include "Engine/Graphics/Resource/ResourceFactory.h"
+
+#include <cassert>
+#include <cstring>
+
+void UploadManager::Initialize(ID3D12Device* device, ID3D12CommandQueue* graphicsQueue, uint64_t ringSize)
+{
+    device_ = device;
+    graphicsQueue_ = graphicsQueue;
+
+    HRESULT result = S_FALSE;
+
+    // コピーキューの生成（グラフィックスキューの描画と並行して転送する）
+    D3D12_COMMAND_QUEUE_DESC queueDesc{};
+    queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+    result = device_->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(copyQueue_.GetAddressOf()));
+    assert(SUCCEEDED(result));
+
+    // コマンドリストは記録開始時にResetするため、作成直後は閉じておく
+    result = device_->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(currentAllocator_.GetAddressOf()));
+    assert(SUCCEEDED(result));
+    result = device_->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, currentAllocator_.Get(), nullptr, IID_PPV_ARGS(commandList_.GetAddressOf()));
+    assert(SUCCEEDED(result));
+    commandList_->Close();
+    submittedAllocators_.emplace_back(0, std::move(currentAllocator_));
+
+    // フェンス & イベント
+    result = device_->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(fence_.GetAddressOf()));
+    assert(SUCCEEDED(result));
+    fenceEvent_ = CreateEvent(NULL, FALSE, FALSE, NULL);
+    assert(fenceEvent_ != nullptr);
+
+    // ステージング用リングバッファ（終了までマップしたままにする）
+    ringBuffer_ = ResourceFactory::CreateBufferResource(device_, static_cast<size_t>(ringSize));
+    D3D12_RANGE readRange{ 0, 0 }; // CPUからは読まない
+    result = ringBuffer_->Map(0, &readRange, reinterpret_cast<void**>(&ringData_));
+    assert(SUCCEEDED(result));
+    (void)result;
+    ring_.Initialize(ringSize);
+}
+
+UploadManager::~UploadManager()
+{
+    if (fence_) {
+        WaitIdle();
+    }
+    if (ringBuffer_ && ringData_) {
+        ringBuffer_->Unmap(0, nullptr);
+        ringData_ = nullptr;
+    }
+    if (fenceEvent_) {
+        CloseHandle(fenceEvent_);
+        fenceEvent_ = nullptr;
+    }
+}
+
+ComPtr<ID3D12Resource> UploadManager::CreateStaticBuffer(const void* data, size_t sizeInBytes)
+{
+    assert(data != nullptr && sizeInBytes > 0);
+    ComPtr<ID3D12Resource> buffer = ResourceFactory::CreateDefaultBufferResource(device_, sizeInBytes);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Staging staging = AllocateStaging(sizeInBytes, 16);
+    std::memcpy(staging.data, data, sizeInBytes);
+
+    BeginRecording();
+    commandList_->CopyBufferRegion(buffer.Get(), 0, staging.resource, staging.offset, sizeInBytes);
+    recordingResources_.push_back(buffer);
+
+    ++statistics_.bufferCount;
+    statistics_.uploadedBytes += sizeInBytes;
+    return buffer;
+}
+
+void UploadManager::UploadTexture(ID3D12Resource* texture, const D3D12_SUBRESOURCE_DATA* subresources,
+    UINT firstSubresource, UINT subresourceCount)
+{
+    assert(texture != nullptr && subresources != nullptr && subresourceCount > 0);
+
+    // ステージング上の配置（行ピッチのアライメントを含む）
+    D3D12_RESOURCE_DESC desc = texture->GetDesc();
+    std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> layouts(subresourceCount);
+    std::vector<UINT> rowCounts(subresourceCount);
+    std::vector<UINT64> rowSizes(subresourceCount);
+    UINT64 totalBytes = 0;
+    device_->GetCopyableFootprints(&desc, firstSubresource, subresourceCount, 0,
+        layouts.data(), rowCounts.data(), rowSizes.data(), &totalBytes);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Staging staging = AllocateStaging(totalBytes, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+
+    BeginRecording();
+    for (UINT i = 0; i < subresourceCount; ++i) {
+        const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& layout = layouts[i];
+        const D3D12_SUBRESOURCE_DATA& source = subresources[i];
+        const UINT64 slicePitch = static_cast<UINT64>(layout.Footprint.RowPitch) * rowCounts[i];
+
+        // 行ごとにコピー（ソースとステージングで行ピッチが異なる）
+        for (UINT z = 0; z < layout.Footprint.Depth; ++z) {
+            uint8_t* dstSlice = staging.data + layout.Offset + slicePitch * z;
+            const uint8_t* srcSlice = static_cast<const uint8_t*>(source.pData) + source.SlicePitch * z;
+            for (UINT y = 0; y < rowCounts[i]; ++y) {
+                std::memcpy(dstSlice + static_cast<UINT64>(layout.Footprint.RowPitch) * y,
+                    srcSlice + source.RowPitch * y, static_cast<size_t>(rowSizes[i]));
+            }
+        }
+
+        D3D12_TEXTURE_COPY_LOCATION dst{};
+        dst.pResource = texture;
+        dst.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+        dst.SubresourceIndex = firstSubresource + i;
+
+        D3D12_TEXTURE_COPY_LOCATION src{};
+        src.pResource = staging.resource;
+        src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+        src.PlacedFootprint = layout;
+        src.PlacedFootprint.Offset += staging.offset;
+
+        commandList_->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
+    }
+    recordingResources_.emplace_back(texture);
+
+    ++statistics_.textureCount;
+    statistics_.uploadedBytes += totalBytes;
+}
+
+void UploadManager::Flush()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Submit();
+}
+
+void UploadManager::WaitIdle()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Submit();
+    WaitForFence(fenceValue_);
+    ReleaseCompleted();
+}
+
+UploadManager::Statistics UploadManager::GetStatistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Statistics statistics = statistics_;
+    statistics.ring = ring_.GetStatistics();
+    return statistics;
+}
+
+UploadManager::Staging UploadManager::AllocateStaging(uint64_t size, uint64_t alignment)
+{
+    ReleaseCompleted();
+
+    // リングより大きいものは一時バッファに書き、コピーの完了後に解放する
+    if (size > ring_.GetCapacity()) {
+        ComPtr<ID3D12Resource> buffer = ResourceFactory::CreateBufferResource(device_, static_cast<size_t>(size));
+        Staging staging;
+        staging.resource = buffer.Get();
+        HRESULT hr = buffer->Map(0, nullptr, reinterpret_cast<void**>(&staging.data));
+        assert(SUCCEEDED(hr));
+        (void)hr;
+        recordingResources_.push_back(std::move(buffer));
+        ++statistics_.dedicatedCount;
+        return staging;
+    }
+
+    uint64_t offset = ring_.Allocate(size, alignment);
+    while (offset == UploadRingAllocator::kInvalidOffset) {
+        // 記録中の分を提出し、最も古い提出の完了を待って空ける
+        Submit();
+        assert(ring_.GetOldestPendingFence() != 0);
+        ++statistics_.stallCount;
+        WaitForFence(ring_.GetOldestPendingFence());
+        ReleaseCompleted();
+        offset = ring_.Allocate(size, alignment);
+    }
+
+    Staging staging;
+    staging.resource = ringBuffer_.Get();
+    staging.offset = offset;
+    staging.data = ringData_ + offset;
+    return staging;
+}
+
+void UploadManager::BeginRecording()
+{
+    if (recording_) {
+        return;
+    }
+
+    // 完了したアロケータを再利用（なければ作成）
+    if (!submittedAllocators_.empty() && submittedAllocators_.front().first <= fence_->GetCompletedValue()) {
+        currentAllocator_ = std::move(submittedAllocators_.front().second);
+        submittedAllocators_.pop_front();
+        HRESULT hr = currentAllocator_->Reset();
+        assert(SUCCEEDED(hr));
+        (void)hr;
+    } else {
+        HRESULT hr = device_->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(currentAllocator_.GetAddressOf()));
+        assert(SUCCEEDED(hr));
+        (void)hr;
+    }
+
+    HRESULT hr = commandList_->Reset(currentAllocator_.Get(), nullptr);
+    assert(SUCCEEDED(hr));
+    (void)hr;
+    recording_ = true;
+}
+
+void UploadManager::Submit()
+{
+    if (!recording_) {
+        return;
+    }
+
+    HRESULT hr = commandList_->Close();
+    assert(SUCCEEDED(hr));
+    (void)hr;
+
+    ID3D12CommandList* commandLists[] = { commandList_.Get() };
+    copyQueue_->ExecuteCommandLists(1, commandLists);
+    ++fenceValue_;
+    copyQueue_->Signal(fence_.Get(), fenceValue_);
+
+    // 以降にグラフィックスキューへ提出する描画はコピーの完了後に実行される
+    graphicsQueue_->Wait(fence_.Get(), fenceValue_);
+
+    ring_.Submit(fenceValue_);
+    submittedAllocators_.emplace_back(fenceValue_, std::move(currentAllocator_));
+    for (auto& resource : recordingResources_) {
+        submittedResources_.emplace_back(fenceValue_, std::move(resource));
+    }
+    recordingResources_.clear();
+    recording_ = false;
+    ++statistics_.submitCount;
+}
+
+void UploadManager::ReleaseCompleted()
+{
+    const uint64_t completed = fence_->GetCompletedValue();
+    ring_.Release(completed);
+    while (!submittedResources_.empty() && submittedResources_.front().first <= completed) {
+        submittedResources_.pop_front();
+    }
+}
+
+void UploadManager::WaitForFence(uint64_t fenceValue)
+{
+    if (fence_->GetCompletedValue() < fenceValue) {
+        HRESULT hr = fence_->SetEventOnCompletion(fenceValue, fenceEvent_);
+        assert(SUCCEEDED(hr));
+        (void)hr;
+        WaitForSingleObject(fenceEvent_, INFINITE);
+    }
+}
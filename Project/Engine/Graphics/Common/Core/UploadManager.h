@@ -0,0 +1,119 @@
+#pragma once
+
+#include "UploadRingAllocator.h"
+#include <d3d12.h>
+#include <wrl.h>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+using namespace Microsoft::WRL;
+
+/// @brief GPUへのアップロード（ステージング）の管理クラス
+/// @details 永続的にマップしたアップロードヒープのリングバッファにデータを書き込み、コピーキュー用の
+/// コマンドリストにまとめて記録する。記録したコピーは Flush で1回の ExecuteCommandLists として提出し、
+/// グラフィックスキューにはコピーの完了を待たせる（CPUは待たない）。
+/// ステージング領域・一時バッファ・コマンドアロケータはコピーキューのフェンスが進んでから再利用する。
+/// コピー先はCOMMON状態で作成すること（コピーキューの完了後にCOMMONへ戻り、描画時に暗黙的に昇格する）。
+class UploadManager {
+public:
+    /// @brief リングバッファの既定サイズ
+    static constexpr uint64_t kDefaultRingSize = 64ull * 1024 * 1024;
+
+    /// @brief 統計情報
+    struct Statistics {
+        UploadRingAllocator::Statistics ring; ///< リングバッファ
+        uint32_t submitCount = 0;    ///< コピーキューへの提出回数
+        uint32_t bufferCount = 0;    ///< アップロードしたバッファ数
+        uint32_t textureCount = 0;   ///< アップロードしたテクスチャ数
+        uint32_t dedicatedCount = 0; ///< リングに入らず一時バッファを使った回数
+        uint32_t stallCount = 0;     ///< リングの空きを待ってCPUが止まった回数
+        uint64_t uploadedBytes = 0;  ///< アップロードしたバイト数
+    };
+
+    /// @brief 初期化
+    /// @param device D3D12デバイス
+    /// @param graphicsQueue コピーの完了を待たせるグラフィックスキュー
+    /// @param ringSize リングバッファのバイト数
+    void Initialize(ID3D12Device* device, ID3D12CommandQueue* graphicsQueue, uint64_t ringSize = kDefaultRingSize);
+
+    /// @brief デストラクタ（提出済みのコピーの完了を待つ）
+    ~UploadManager();
+
+    /// @brief 中身が変わらないバッファをデフォルトヒープに作成し、データのコピーを記録する
+    /// @param data 初期データ
+    /// @param sizeInBytes バイト数
+    /// @return バッファ（COMMON状態。Flush 前でも頂点・インデックスバッファのビューを作ってよい）
+    ComPtr<ID3D12Resource> CreateStaticBuffer(const void* data, size_t sizeInBytes);
+
+    /// @brief テクスチャへのデータのコピーを記録する
+    /// @param texture コピー先（デフォルトヒープ・COMMON状態）
+    /// @param subresources サブリソースのデータ
+    /// @param firstSubresource 最初のサブリソース
+    /// @param subresourceCount サブリソース数
+    void UploadTexture(ID3D12Resource* texture, const D3D12_SUBRESOURCE_DATA* subresources,
+        UINT firstSubresource, UINT subresourceCount);
+
+    /// @brief 記録したコピーをコピーキューに提出し、グラフィックスキューに完了を待たせる
+    /// @details グラフィックスキューの ExecuteCommandLists の直前に呼ぶ（記録がなければ何もしない）
+    void Flush();
+
+    /// @brief 記録したコピーを提出し、全ての完了をCPUで待つ
+    void WaitIdle();
+
+    /// @brief 統計を取得
+    Statistics GetStatistics() const;
+
+private:
+    /// @brief ステージング領域
+    struct Staging {
+        ID3D12Resource* resource = nullptr; // リングバッファか一時バッファ
+        uint64_t offset = 0;                // resource 内の先頭位置
+        uint8_t* data = nullptr;            // 書き込み先
+    };
+
+    /// @brief ステージング領域を確保（リングが埋まっていれば提出して空きを待つ。入らない大きさは一時バッファ）
+    Staging AllocateStaging(uint64_t size, uint64_t alignment);
+
+    /// @brief コマンドリストの記録を開始（記録中なら何もしない）
+    void BeginRecording();
+
+    /// @brief 記録中のコマンドリストを提出（ロック済みで呼ぶ）
+    void Submit();
+
+    /// @brief コピーキューが完了した分のステージング領域・リソースを解放
+    void ReleaseCompleted();
+
+    /// @brief フェンスが指定値に達するまで待つ
+    void WaitForFence(uint64_t fenceValue);
+
+private:
+    ID3D12Device* device_ = nullptr;
+    ID3D12CommandQueue* graphicsQueue_ = nullptr;
+
+    // コピーキュー
+    ComPtr<ID3D12CommandQueue> copyQueue_;
+    ComPtr<ID3D12GraphicsCommandList> commandList_;
+    ComPtr<ID3D12CommandAllocator> currentAllocator_;
+    std::deque<std::pair<uint64_t, ComPtr<ID3D12CommandAllocator>>> submittedAllocators_; // 提出時のフェンス値と組
+    bool recording_ = false;
+
+    // フェンス & イベント
+    ComPtr<ID3D12Fence> fence_;
+    uint64_t fenceValue_ = 0; // 最後に提出したフェンス値
+    HANDLE fenceEvent_ = nullptr;
+
+    // ステージング用リングバッファ（永続マップ）
+    ComPtr<ID3D12Resource> ringBuffer_;
+    uint8_t* ringData_ = nullptr;
+    UploadRingAllocator ring_;
+
+    // コピーが終わるまで保持するリソース（一時バッファ・コピー先）
+    std::vector<ComPtr<ID3D12Resource>> recordingResources_;
+    std::deque<std::pair<uint64_t, ComPtr<ID3D12Resource>>> submittedResources_;
+
+    mutable std::mutex mutex_;
+    Statistics statistics_;
+};
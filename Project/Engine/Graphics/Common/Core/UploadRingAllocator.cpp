@@ -0,0 +1,100 @@
+#include "UploadRingAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace {
+    uint64_t AlignUp(uint64_t value, uint64_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+void UploadRingAllocator::Initialize(uint64_t capacity)
+{
+    capacity_ = capacity;
+    head_ = 0;
+    tail_ = 0;
+    usedSize_ = 0;
+    unsubmittedSize_ = 0;
+    batches_.clear();
+    statistics_ = {};
+}
+
+uint64_t UploadRingAllocator::Allocate(uint64_t size, uint64_t alignment)
+{
+    assert(size > 0);
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    // 空なら先頭から使い直す（折り返しを減らす）
+    if (usedSize_ == 0) {
+        head_ = 0;
+        tail_ = 0;
+    }
+
+    uint64_t offset = kInvalidOffset;
+    uint64_t consumed = 0;
+    const uint64_t aligned = AlignUp(head_, alignment);
+    const bool wrapped = head_ < tail_ || (head_ == tail_ && usedSize_ > 0);
+    if (wrapped) {
+        // 使用中が [tail, capacity) と [0, head) に分かれている：空きは [head, tail)
+        if (aligned + size <= tail_) {
+            offset = aligned;
+            consumed = aligned + size - head_;
+        }
+    } else {
+        // 使用中は [tail, head)：空きは [head, capacity) と [0, tail)
+        if (aligned + size <= capacity_) {
+            offset = aligned;
+            consumed = aligned + size - head_;
+        } else if (size <= tail_) {
+            offset = 0;
+            consumed = (capacity_ - head_) + size;
+            ++statistics_.wrapCount;
+        }
+    }
+
+    if (offset == kInvalidOffset) {
+        ++statistics_.failedCount;
+        return kInvalidOffset;
+    }
+
+    head_ = offset + size;
+    if (head_ == capacity_) {
+        head_ = 0;
+    }
+    usedSize_ += consumed;
+    unsubmittedSize_ += consumed;
+    ++statistics_.allocationCount;
+    statistics_.peakUsedSize = (std::max)(statistics_.peakUsedSize, usedSize_);
+    return offset;
+}
+
+void UploadRingAllocator::Submit(uint64_t fenceValue)
+{
+    if (unsubmittedSize_ == 0) {
+        return;
+    }
+    assert(batches_.empty() || batches_.back().fenceValue <= fenceValue);
+    batches_.push_back({ fenceValue, head_, unsubmittedSize_ });
+    unsubmittedSize_ = 0;
+}
+
+void UploadRingAllocator::Release(uint64_t completedFenceValue)
+{
+    while (!batches_.empty() && batches_.front().fenceValue <= completedFenceValue) {
+        const Batch& batch = batches_.front();
+        tail_ = batch.end;
+        usedSize_ -= batch.size;
+        batches_.pop_front();
+    }
+}
+
+UploadRingAllocator::Statistics UploadRingAllocator::GetStatistics() const
+{
+    Statistics statistics = statistics_;
+    statistics.capacity = capacity_;
+    statistics.usedSize = usedSize_;
+    statistics.pendingBatchCount = static_cast<uint32_t>(batches_.size());
+    return statistics;
+}
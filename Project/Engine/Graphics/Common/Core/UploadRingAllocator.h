@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+
+/// @brief アップロード用リングバッファの割り当て（D3D12に依存しない）
+/// @details [0, capacity) を先頭から順に切り出し、末尾に入らなければ先頭へ折り返す（飛ばした末尾は使用量に含める）。
+/// Submit でそれまでの割り当てをフェンス値に結び付け、Release で完了したフェンス値までの領域をまとめて空きに戻す。
+/// 空きは常に連続した1区間（head から tail まで）なので、割り当ても解放も定数時間で済む。
+class UploadRingAllocator {
+public:
+    static constexpr uint64_t kInvalidOffset = UINT64_MAX;
+
+    /// @brief 統計
+    struct Statistics {
+        uint64_t capacity = 0;        ///< 総バイト数
+        uint64_t usedSize = 0;        ///< 使用中のバイト数（折り返しで飛ばした分を含む）
+        uint64_t peakUsedSize = 0;    ///< 使用中のバイト数の最大
+        uint32_t allocationCount = 0; ///< 割り当てた回数
+        uint32_t wrapCount = 0;       ///< 先頭へ折り返した回数
+        uint32_t failedCount = 0;     ///< 空きが足りず失敗した回数
+        uint32_t pendingBatchCount = 0; ///< 完了を待っている提出の数
+    };
+
+    /// @brief 初期化
+    /// @param capacity 総バイト数
+    void Initialize(uint64_t capacity);
+
+    /// @brief 割り当て
+    /// @param size バイト数（0より大きいこと）
+    /// @param alignment 先頭のアライメント（2の累乗）
+    /// @return 先頭位置（空きが足りなければ kInvalidOffset）
+    uint64_t Allocate(uint64_t size, uint64_t alignment);
+
+    /// @brief 前回の Submit 以降の割り当てをフェンス値に結び付ける
+    /// @param fenceValue この値に達したら領域を再利用してよい（前回以上の値を渡すこと）
+    void Submit(uint64_t fenceValue);
+
+    /// @brief 完了したフェンス値までの領域を空きに戻す
+    /// @param completedFenceValue GPUが完了したフェンス値
+    void Release(uint64_t completedFenceValue);
+
+    /// @brief まだ Submit していない割り当てがあるか
+    bool HasUnsubmitted() const { return unsubmittedSize_ > 0; }
+
+    /// @brief 完了を待っている中で最も古いフェンス値（なければ0）
+    uint64_t GetOldestPendingFence() const { return batches_.empty() ? 0 : batches_.front().fenceValue; }
+
+    /// @brief 総バイト数
+    uint64_t GetCapacity() const { return capacity_; }
+
+    /// @brief 統計を取得
+    Statistics GetStatistics() const;
+
+private:
+    /// @brief フェンス値に結び付けた割り当ての塊
+    struct Batch {
+        uint64_t fenceValue = 0;
+        uint64_t end = 0;  // 塊の終端（解放後の tail）
+        uint64_t size = 0; // 塊が使っているバイト数
+    };
+
+    uint64_t capacity_ = 0;
+    uint64_t head_ = 0; // 次に割り当てる位置
+    uint64_t tail_ = 0; // 使用中の先頭
+    uint64_t usedSize_ = 0;
+    uint64_t unsubmittedSize_ = 0;
+    std::deque<Batch> batches_;
+    Statistics statistics_;
+};
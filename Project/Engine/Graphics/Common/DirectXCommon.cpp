@@ -17,6 +17,10 @@ void DirectXCommon::Initialize(WinApp* winApp)
 	commandManager_->Initialize(deviceManager_->GetDevice());
 	descriptorManager_->Initialize(deviceManager_->GetDevice());
 
+	// アップロード管理（コピーはグラフィックスキューへの提出前にまとめて提出する）
+	uploadManager_->Initialize(deviceManager_->GetDevice(), commandManager_->GetCommandQueue());
+	commandManager_->SetUploadManager(uploadManager_.get());
+
 	// スワップチェーンの初期化（バックバッファ取得とRTV作成まで含む）
 	swapChainManager_->Initialize(
 		deviceManager_->GetDevice(),
@@ -16,6 +16,7 @@
 #include "Graphics/Common/Core/SwapChainManager.h"
 #include "Graphics/Common/Core/OffScreenRenderTargetManager.h"
 #include "Graphics/Common/Core/DepthStencilManager.h"
+#include "Graphics/Common/Core/UploadManager.h"
 
 using namespace Microsoft::WRL;
 
@@ -59,6 +60,7 @@ public:
     // マネージャーへの直接アクセス（必要に応じて）
     DescriptorManager* GetDescriptorManager() { return descriptorManager_.get(); }
     DepthStencilManager* GetDepthStencilManager() { return depthStencilManager_.get(); }
+    UploadManager* GetUploadManager() { return uploadManager_.get(); }
 
     // オフスクリーン用のアクセッサ（1枚目）
     ID3D12Resource* GetOffScreenResource() { return offScreenManager_->GetOffScreenResource(); }
@@ -86,4 +88,6 @@ private:
 	std::unique_ptr<SwapChainManager> swapChainManager_ = std::make_unique<SwapChainManager>();
 	std::unique_ptr<OffScreenRenderTargetManager> offScreenManager_ = std::make_unique<OffScreenRenderTargetManager>();
 	std::unique_ptr<DepthStencilManager> depthStencilManager_ = std::make_unique<DepthStencilManager>();
+	// コマンドキューより先に破棄する（提出済みのコピーの完了を待つ）
+	std::unique_ptr<UploadManager> uploadManager_ = std::make_unique<UploadManager>();
 };
@@ -0,0 +1,321 @@
+#include "DebugLineBatch.h"
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numbers>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define DEBUG_LINE_BATCH_USE_SSE
+#endif
+
+namespace {
+    using Point = DebugLineTemplate::Point;
+
+    /// @brief 円を線分として追加（axisU・axisV が張る平面上の単位円）
+    /// @param out 追加先
+    /// @param segments 分割数
+    /// @param axisU 円の1つ目の軸（0=X, 1=Y, 2=Z）
+    /// @param axisV 円の2つ目の軸
+    /// @param offset 円の中心（残りの軸方向）
+    /// @param radius 半径
+    /// @param arc 角度の範囲（2πで一周）
+    void AppendArc(std::vector<Point>& out, uint32_t segments, int axisU, int axisV,
+        const float (&offset)[3], float radius, float arc)
+    {
+        for (uint32_t i = 0; i < segments; ++i) {
+            float angles[2] = {
+                arc * static_cast<float>(i) / static_cast<float>(segments),
+                arc * static_cast<float>(i + 1) / static_cast<float>(segments),
+            };
+            for (float angle : angles) {
+                float p[3] = { offset[0], offset[1], offset[2] };
+                p[axisU] += radius * std::cos(angle);
+                p[axisV] += radius * std::sin(angle);
+                out.push_back({ p[0], p[1], p[2], 1.0f });
+            }
+        }
+    }
+
+    /// @brief 線分を追加
+    void AppendLine(std::vector<Point>& out, float x0, float y0, float z0, float x1, float y1, float z1)
+    {
+        out.push_back({ x0, y0, z0, 1.0f });
+        out.push_back({ x1, y1, z1, 1.0f });
+    }
+
+    /// @brief 緯線・経線の単位球を作成
+    DebugLineTemplate BuildSphereGrid(uint32_t segments)
+    {
+        constexpr float kPi = std::numbers::pi_v<float>;
+        DebugLineTemplate shape;
+        shape.points.reserve(static_cast<size_t>(segments) * (segments * 2 + 1) * 2);
+
+        // 緯線（複数の水平円）
+        for (uint32_t lat = 0; lat <= segments; ++lat) {
+            float theta = (static_cast<float>(lat) / segments) * kPi;
+            const float offset[3] = { 0.0f, std::cos(theta), 0.0f };
+            AppendArc(shape.points, segments, 0, 2, offset, std::sin(theta), 2.0f * kPi);
+        }
+
+        // 経線（縦の線）
+        for (uint32_t lon = 0; lon < segments; ++lon) {
+            float phi = (static_cast<float>(lon) / segments) * 2.0f * kPi;
+            float sinPhi = std::sin(phi);
+            float cosPhi = std::cos(phi);
+            for (uint32_t lat = 0; lat < segments; ++lat) {
+                float theta1 = (static_cast<float>(lat) / segments) * kPi;
+                float theta2 = (static_cast<float>(lat + 1) / segments) * kPi;
+                AppendLine(shape.points,
+                    std::sin(theta1) * cosPhi, std::cos(theta1), std::sin(theta1) * sinPhi,
+                    std::sin(theta2) * cosPhi, std::cos(theta2), std::sin(theta2) * sinPhi);
+            }
+        }
+        return shape;
+    }
+}
+
+void DebugLineBatch::Begin(DebugLineVertex* destination, uint32_t capacity)
+{
+    destination_ = destination;
+    capacity_ = destination ? capacity : 0;
+    count_ = 0;
+    dropped_ = 0;
+}
+
+bool DebugLineBatch::Reserve(uint32_t lineCount)
+{
+    if (capacity_ - count_ < lineCount * 2) {
+        dropped_ += lineCount;
+        return false;
+    }
+    return true;
+}
+
+void DebugLineBatch::AddLine(const Vector3& start, const Vector3& end, const Vector3& color, float alpha)
+{
+    if (!Reserve(1)) {
+        return;
+    }
+    destination_[count_++] = { start, color, alpha };
+    destination_[count_++] = { end, color, alpha };
+}
+
+void DebugLineBatch::AddLines(const std::vector<DebugLine>& lines)
+{
+    if (!Reserve(static_cast<uint32_t>(lines.size()))) {
+        return;
+    }
+    for (const DebugLine& line : lines) {
+        destination_[count_++] = { line.start, line.color, line.alpha };
+        destination_[count_++] = { line.end, line.color, line.alpha };
+    }
+}
+
+void DebugLineBatch::AddTemplate(const DebugLineTemplate& shape, const Matrix4x4& world, const Vector3& color, float alpha)
+{
+    const uint32_t pointCount = static_cast<uint32_t>(shape.points.size());
+    if (!Reserve(shape.GetLineCount())) {
+        return;
+    }
+
+    DebugLineVertex* out = destination_ + count_;
+    DebugLineVertex vertex{ {}, color, alpha };
+#ifdef DEBUG_LINE_BATCH_USE_SSE
+    // 行ベクトル × 行列（w=1）を4要素まとめて計算
+    const __m128 row0 = _mm_loadu_ps(world.m[0]);
+    const __m128 row1 = _mm_loadu_ps(world.m[1]);
+    const __m128 row2 = _mm_loadu_ps(world.m[2]);
+    const __m128 row3 = _mm_loadu_ps(world.m[3]);
+    alignas(16) float result[4];
+    for (uint32_t i = 0; i < pointCount; ++i) {
+        const __m128 p = _mm_load_ps(&shape.points[i].x);
+        __m128 v = _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(0, 0, 0, 0)), row0);
+        v = _mm_add_ps(v, _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1)), row1));
+        v = _mm_add_ps(v, _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2)), row2));
+        v = _mm_add_ps(v, row3);
+        _mm_store_ps(result, v);
+        vertex.position = { result[0], result[1], result[2] };
+        out[i] = vertex;
+    }
+#else
+    for (uint32_t i = 0; i < pointCount; ++i) {
+        const Point& p = shape.points[i];
+        vertex.position = {
+            p.x * world.m[0][0] + p.y * world.m[1][0] + p.z * world.m[2][0] + world.m[3][0],
+            p.x * world.m[0][1] + p.y * world.m[1][1] + p.z * world.m[2][1] + world.m[3][1],
+            p.x * world.m[0][2] + p.y * world.m[1][2] + p.z * world.m[2][2] + world.m[3][2],
+        };
+        out[i] = vertex;
+    }
+#endif
+    count_ += pointCount;
+}
+
+void DebugLineBatch::AddSphere(const Vector3& center, float radius, const Vector3& color, float alpha)
+{
+    Matrix4x4 world = {};
+    world.m[0][0] = radius;
+    world.m[1][1] = radius;
+    world.m[2][2] = radius;
+    world.m[3][0] = center.x;
+    world.m[3][1] = center.y;
+    world.m[3][2] = center.z;
+    world.m[3][3] = 1.0f;
+    AddTemplate(GetUnitSphere(), world, color, alpha);
+}
+
+void DebugLineBatch::AddAABB(const Vector3& min, const Vector3& max, const Vector3& color, float alpha)
+{
+    Matrix4x4 world = {};
+    world.m[0][0] = (max.x - min.x) * 0.5f;
+    world.m[1][1] = (max.y - min.y) * 0.5f;
+    world.m[2][2] = (max.z - min.z) * 0.5f;
+    world.m[3][0] = (max.x + min.x) * 0.5f;
+    world.m[3][1] = (max.y + min.y) * 0.5f;
+    world.m[3][2] = (max.z + min.z) * 0.5f;
+    world.m[3][3] = 1.0f;
+    AddTemplate(GetUnitBox(), world, color, alpha);
+}
+
+void DebugLineBatch::AddBox(const Matrix4x4& world, const Vector3& color, float alpha)
+{
+    AddTemplate(GetUnitBox(), world, color, alpha);
+}
+
+void DebugLineBatch::AddCapsule(const Vector3& start, const Vector3& end, float radius, const Vector3& color, float alpha)
+{
+    const uint32_t lineCount = GetUnitCylinder().GetLineCount() + GetUnitHemisphere().GetLineCount() * 2;
+    if (!Reserve(lineCount)) {
+        return;
+    }
+
+    Vector3 axis = { end.x - start.x, end.y - start.y, end.z - start.z };
+    float length = std::sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+    Vector3 reversed = { -axis.x, -axis.y, -axis.z };
+
+    // 半球は等倍で変換するので、円柱の長さが変わっても形が崩れない
+    AddTemplate(GetUnitCylinder(), MakeAxisTransform(axis, { radius, length, radius }, start), color, alpha);
+    AddTemplate(GetUnitHemisphere(), MakeAxisTransform(axis, { radius, radius, radius }, end), color, alpha);
+    AddTemplate(GetUnitHemisphere(), MakeAxisTransform(reversed, { radius, radius, radius }, start), color, alpha);
+}
+
+void DebugLineBatch::AddCone(const Vector3& apex, const Vector3& direction, float length, float radius, const Vector3& color, float alpha)
+{
+    AddTemplate(GetUnitCone(), MakeAxisTransform(direction, { radius, length, radius }, apex), color, alpha);
+}
+
+Matrix4x4 DebugLineBatch::MakeAxisTransform(const Vector3& axis, const Vector3& scale, const Vector3& translate)
+{
+    // +Y を axis に向ける正規直交基底（X, Y, Z の各行）
+    float length = std::sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+    Vector3 y = (length > 1e-6f) ? Vector3{ axis.x / length, axis.y / length, axis.z / length } : Vector3{ 0.0f, 1.0f, 0.0f };
+
+    // y とほぼ平行にならない補助軸を選ぶ
+    Vector3 helper = (std::abs(y.x) < 0.9f) ? Vector3{ 1.0f, 0.0f, 0.0f } : Vector3{ 0.0f, 0.0f, 1.0f };
+    Vector3 z = { helper.y * y.z - helper.z * y.y, helper.z * y.x - helper.x * y.z, helper.x * y.y - helper.y * y.x };
+    float zLength = std::sqrt(z.x * z.x + z.y * z.y + z.z * z.z);
+    z = { z.x / zLength, z.y / zLength, z.z / zLength };
+    Vector3 x = { y.y * z.z - y.z * z.y, y.z * z.x - y.x * z.z, y.x * z.y - y.y * z.x };
+
+    Matrix4x4 result = {};
+    result.m[0][0] = x.x * scale.x; result.m[0][1] = x.y * scale.x; result.m[0][2] = x.z * scale.x;
+    result.m[1][0] = y.x * scale.y; result.m[1][1] = y.y * scale.y; result.m[1][2] = y.z * scale.y;
+    result.m[2][0] = z.x * scale.z; result.m[2][1] = z.y * scale.z; result.m[2][2] = z.z * scale.z;
+    result.m[3][0] = translate.x;
+    result.m[3][1] = translate.y;
+    result.m[3][2] = translate.z;
+    result.m[3][3] = 1.0f;
+    return result;
+}
+
+const DebugLineTemplate& DebugLineBatch::GetUnitSphere()
+{
+    static const DebugLineTemplate shape = [] {
+        constexpr float kTwoPi = 2.0f * std::numbers::pi_v<float>;
+        const float origin[3] = { 0.0f, 0.0f, 0.0f };
+        DebugLineTemplate result;
+        AppendArc(result.points, kCircleSegments, 0, 1, origin, 1.0f, kTwoPi); // XY
+        AppendArc(result.points, kCircleSegments, 1, 2, origin, 1.0f, kTwoPi); // YZ
+        AppendArc(result.points, kCircleSegments, 2, 0, origin, 1.0f, kTwoPi); // ZX
+        return result;
+    }();
+    return shape;
+}
+
+const DebugLineTemplate& DebugLineBatch::GetUnitSphereGrid(uint32_t segments)
+{
+    static std::mutex mutex;
+    static std::map<uint32_t, std::unique_ptr<DebugLineTemplate>> cache;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& entry = cache[segments];
+    if (!entry) {
+        entry = std::make_unique<DebugLineTemplate>(BuildSphereGrid(segments));
+    }
+    return *entry;
+}
+
+const DebugLineTemplate& DebugLineBatch::GetUnitBox()
+{
+    static const DebugLineTemplate shape = [] {
+        DebugLineTemplate result;
+        for (float a : { -1.0f, 1.0f }) {
+            for (float b : { -1.0f, 1.0f }) {
+                AppendLine(result.points, -1.0f, a, b, 1.0f, a, b); // X方向の辺
+                AppendLine(result.points, a, -1.0f, b, a, 1.0f, b); // Y方向の辺
+                AppendLine(result.points, a, b, -1.0f, a, b, 1.0f); // Z方向の辺
+            }
+        }
+        return result;
+    }();
+    return shape;
+}
+
+const DebugLineTemplate& DebugLineBatch::GetUnitCylinder()
+{
+    static const DebugLineTemplate shape = [] {
+        constexpr float kTwoPi = 2.0f * std::numbers::pi_v<float>;
+        const float bottom[3] = { 0.0f, 0.0f, 0.0f };
+        const float top[3] = { 0.0f, 1.0f, 0.0f };
+        DebugLineTemplate result;
+        AppendArc(result.points, kCircleSegments, 0, 2, bottom, 1.0f, kTwoPi);
+        AppendArc(result.points, kCircleSegments, 0, 2, top, 1.0f, kTwoPi);
+        AppendLine(result.points, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f);
+        AppendLine(result.points, -1.0f, 0.0f, 0.0f, -1.0f, 1.0f, 0.0f);
+        AppendLine(result.points, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f);
+        AppendLine(result.points, 0.0f, 0.0f, -1.0f, 0.0f, 1.0f, -1.0f);
+        return result;
+    }();
+    return shape;
+}
+
+const DebugLineTemplate& DebugLineBatch::GetUnitHemisphere()
+{
+    static const DebugLineTemplate shape = [] {
+        constexpr float kPi = std::numbers::pi_v<float>;
+        const float origin[3] = { 0.0f, 0.0f, 0.0f };
+        DebugLineTemplate result;
+        AppendArc(result.points, kCircleSegments / 2, 0, 1, origin, 1.0f, kPi); // XY平面の上半分
+        AppendArc(result.points, kCircleSegments / 2, 2, 1, origin, 1.0f, kPi); // ZY平面の上半分
+        return result;
+    }();
+    return shape;
+}
+
+const DebugLineTemplate& DebugLineBatch::GetUnitCone()
+{
+    static const DebugLineTemplate shape = [] {
+        constexpr float kTwoPi = 2.0f * std::numbers::pi_v<float>;
+        const float base[3] = { 0.0f, 1.0f, 0.0f };
+        DebugLineTemplate result;
+        AppendArc(result.points, kCircleSegments, 0, 2, base, 1.0f, kTwoPi);
+        AppendLine(result.points, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f);
+        AppendLine(result.points, 0.0f, 0.0f, 0.0f, -1.0f, 1.0f, 0.0f);
+        AppendLine(result.points, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f);
+        AppendLine(result.points, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, -1.0f);
+        return result;
+    }();
+    return shape;
+}
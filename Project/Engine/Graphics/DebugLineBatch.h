@@ -0,0 +1,124 @@
+#pragma once
+#include "Matrix/Matrix4x4.h"
+#include "Vector/Vector3.h"
+#include <cstdint>
+#include <vector>
+
+/// @brief デバッグ線の頂点（シェーダーと完全一致）
+struct DebugLineVertex {
+    Vector3 position;
+    Vector3 color;
+    float alpha;
+};
+
+/// @brief デバッグ線
+struct DebugLine {
+    Vector3 start;
+    Vector3 end;
+    Vector3 color;
+    float alpha;
+};
+
+/// @brief 単位形状の線分（ローカル座標、2点で1本）
+/// @details SIMDで変換できるよう、各点は w=1 の float4 として16バイト境界に並べる。
+struct DebugLineTemplate {
+    struct alignas(16) Point {
+        float x, y, z, w;
+    };
+    std::vector<Point> points;
+
+    /// @brief 線分の数
+    uint32_t GetLineCount() const { return static_cast<uint32_t>(points.size() / 2); }
+};
+
+/// @brief デバッグ線の書き込み（D3D12に依存しない）
+/// @details Begin で渡した書き込み先（マップ済みの頂点バッファなど）に直接頂点を書き込む。
+/// 球・箱・カプセル・円錐は事前に作った単位形状を行列で変換して書き込むので、三角関数の再計算はしない。
+/// 容量を超えた線は書き込まずに数だけ数える。
+class DebugLineBatch {
+public:
+    /// @brief 単位球の円の分割数
+    static constexpr uint32_t kCircleSegments = 32;
+
+    /// @brief 書き込みを開始
+    /// @param destination 書き込み先
+    /// @param capacity 書き込める頂点数
+    void Begin(DebugLineVertex* destination, uint32_t capacity);
+
+    /// @brief 線を追加
+    void AddLine(const Vector3& start, const Vector3& end, const Vector3& color, float alpha = 1.0f);
+
+    /// @brief 線をまとめて追加
+    void AddLines(const std::vector<DebugLine>& lines);
+
+    /// @brief 単位形状を変換して追加
+    /// @param shape 単位形状
+    /// @param world ローカルからワールドへの変換行列
+    /// @param color 色
+    /// @param alpha 透明度
+    void AddTemplate(const DebugLineTemplate& shape, const Matrix4x4& world, const Vector3& color, float alpha = 1.0f);
+
+    /// @brief 球（3方向の円）を追加
+    void AddSphere(const Vector3& center, float radius, const Vector3& color, float alpha = 1.0f);
+
+    /// @brief 軸に沿った箱を追加
+    void AddAABB(const Vector3& min, const Vector3& max, const Vector3& color, float alpha = 1.0f);
+
+    /// @brief 任意の向きの箱を追加
+    /// @param world 単位立方体（-1～1）を変換する行列（スケールが半分の大きさになる）
+    void AddBox(const Matrix4x4& world, const Vector3& color, float alpha = 1.0f);
+
+    /// @brief カプセルを追加
+    /// @param start 一方の端の中心
+    /// @param end もう一方の端の中心
+    /// @param radius 半径
+    void AddCapsule(const Vector3& start, const Vector3& end, float radius, const Vector3& color, float alpha = 1.0f);
+
+    /// @brief 円錐を追加
+    /// @param apex 頂点
+    /// @param direction 頂点から底面への向き（正規化不要）
+    /// @param length 高さ
+    /// @param radius 底面の半径
+    void AddCone(const Vector3& apex, const Vector3& direction, float length, float radius, const Vector3& color, float alpha = 1.0f);
+
+    /// @brief 書き込んだ頂点数
+    uint32_t GetVertexCount() const { return count_; }
+
+    /// @brief 容量不足で書き込めなかった線の数
+    uint32_t GetDroppedLineCount() const { return dropped_; }
+
+    // ===== 単位形状 =====
+
+    /// @brief 単位球（XY・YZ・ZXの3つの円）
+    static const DebugLineTemplate& GetUnitSphere();
+
+    /// @brief 緯線・経線の単位球（分割数ごとにキャッシュ）
+    static const DebugLineTemplate& GetUnitSphereGrid(uint32_t segments);
+
+    /// @brief 単位立方体（-1～1の12辺）
+    static const DebugLineTemplate& GetUnitBox();
+
+    /// @brief 半径1・高さ1の円柱の側面（Y軸方向、0～1）
+    static const DebugLineTemplate& GetUnitCylinder();
+
+    /// @brief 半径1の+Y側の半球
+    static const DebugLineTemplate& GetUnitHemisphere();
+
+    /// @brief 頂点が原点で+Y方向に開く、高さ1・底面半径1の円錐
+    static const DebugLineTemplate& GetUnitCone();
+
+    /// @brief +Y軸を指定方向に向ける回転と拡大・平行移動の行列を作る
+    /// @param axis 向ける方向（正規化不要、長さ0なら+Y）
+    /// @param scale 各軸の拡大率（Yが軸方向）
+    /// @param translate 平行移動
+    static Matrix4x4 MakeAxisTransform(const Vector3& axis, const Vector3& scale, const Vector3& translate);
+
+private:
+    /// @brief 残り容量を確認し、足りなければ線を数えてfalse
+    bool Reserve(uint32_t lineCount);
+
+    DebugLineVertex* destination_ = nullptr;
+    uint32_t capacity_ = 0;
+    uint32_t count_ = 0;
+    uint32_t dropped_ = 0;
+};
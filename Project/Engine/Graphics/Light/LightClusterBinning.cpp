@@ -0,0 +1,367 @@
+#include "LightClusterBinning.h"
+#include <algorithm>
+#include <cmath>
+
+// LIGHT_CLUSTER_BINNING_NO_SIMD を定義するとスカラー版になる（検証用）
+#if !defined(LIGHT_CLUSTER_BINNING_NO_SIMD) && (defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__))
+#include <emmintrin.h>
+#define LIGHT_CLUSTER_BINNING_USE_SSE
+#endif
+
+namespace {
+    /// @brief 詰め物の列の境界（どの球とも交差しない値、2乗してもfloatに収まる）
+    constexpr float kOutsideBound = 1.0e18f;
+
+    /// @brief 1クラスターに入れられる各ライトの最大数（範囲の16bitに収める）
+    constexpr uint32_t kMaxLightsPerType = 0xFFFF;
+
+    /// @brief 区間 [minValue, maxValue] と値の距離
+    float DistanceToRange(float value, float minValue, float maxValue)
+    {
+        return (std::max)({ minValue - value, value - maxValue, 0.0f });
+    }
+}
+
+bool LightClusterView::FromMatrices(const Matrix4x4& view, const Matrix4x4& projection, float maxDepth, LightClusterView& out)
+{
+    // 正射影（w=1）ではクラスターの奥行き分割ができない
+    if (projection.m[2][3] == 0.0f || projection.m[2][2] == 0.0f) {
+        return false;
+    }
+
+    // PerspectiveFov: m22 = f / (f - n), m32 = -n * f / (f - n)
+    float nearZ = -projection.m[3][2] / projection.m[2][2];
+    float farZ = (projection.m[2][2] != 1.0f) ? projection.m[3][2] / (1.0f - projection.m[2][2]) : INFINITY;
+    if (maxDepth > 0.0f) {
+        farZ = (std::min)(farZ, maxDepth);
+    }
+    if (!(nearZ > 0.0f) || !std::isfinite(farZ) || farZ <= nearZ) {
+        return false;
+    }
+
+    out.view = view;
+    out.projScaleX = projection.m[0][0];
+    out.projScaleY = projection.m[1][1];
+    out.nearZ = nearZ;
+    out.farZ = farZ;
+    return true;
+}
+
+void LightClusterBinning::Initialize(uint32_t tileCountX, uint32_t tileCountY, uint32_t sliceCount, uint32_t maxIndexCount)
+{
+    tileCountX_ = (std::max)(tileCountX, 1u);
+    tileCountY_ = (std::max)(tileCountY, 1u);
+    sliceCount_ = (std::max)(sliceCount, 1u);
+    paddedTileCountX_ = (tileCountX_ + 3u) & ~3u;
+    maxIndexCount_ = maxIndexCount;
+
+    sliceNear_.assign(sliceCount_ + 1, 0.0f);
+    boundsMinX_.assign(static_cast<size_t>(sliceCount_) * paddedTileCountX_, kOutsideBound);
+    boundsMaxX_.assign(static_cast<size_t>(sliceCount_) * paddedTileCountX_, kOutsideBound);
+    boundsMinY_.assign(static_cast<size_t>(sliceCount_) * tileCountY_, 0.0f);
+    boundsMaxY_.assign(static_cast<size_t>(sliceCount_) * tileCountY_, 0.0f);
+
+    pointCounts_.assign(GetClusterCount(), 0);
+    spotCounts_.assign(GetClusterCount(), 0);
+    ranges_.assign(GetClusterCount(), LightClusterRange{ 0, 0 });
+    indices_.clear();
+    indices_.reserve(maxIndexCount_);
+    statistics_ = {};
+}
+
+void LightClusterBinning::GetSliceParameters(const LightClusterView& view, float& outScale, float& outBias) const
+{
+    float logRange = std::log(view.farZ / view.nearZ);
+    outScale = static_cast<float>(sliceCount_) / logRange;
+    outBias = -static_cast<float>(sliceCount_) * std::log(view.nearZ) / logRange;
+}
+
+void LightClusterBinning::BuildBounds(const LightClusterView& view)
+{
+    GetSliceParameters(view, sliceScale_, sliceBias_);
+
+    float ratio = view.farZ / view.nearZ;
+    for (uint32_t k = 0; k <= sliceCount_; ++k) {
+        sliceNear_[k] = view.nearZ * std::pow(ratio, static_cast<float>(k) / static_cast<float>(sliceCount_));
+    }
+    sliceNear_[sliceCount_] = view.farZ;
+
+    // NDCの端 e を奥行き z で見ると、ビュー空間では e * z / projScale
+    // 分割の手前と奥のうち、範囲が広がる方を取ればそのクラスターを囲むAABBになる
+    auto edgeMin = [](float ndc, float zNear, float zFar, float scale) {
+        return ndc * (ndc < 0.0f ? zFar : zNear) / scale;
+    };
+    auto edgeMax = [](float ndc, float zNear, float zFar, float scale) {
+        return ndc * (ndc > 0.0f ? zFar : zNear) / scale;
+    };
+
+    for (uint32_t k = 0; k < sliceCount_; ++k) {
+        float zNear = sliceNear_[k];
+        float zFar = sliceNear_[k + 1];
+        for (uint32_t x = 0; x < tileCountX_; ++x) {
+            float ndcMin = -1.0f + 2.0f * static_cast<float>(x) / static_cast<float>(tileCountX_);
+            float ndcMax = -1.0f + 2.0f * static_cast<float>(x + 1) / static_cast<float>(tileCountX_);
+            boundsMinX_[k * paddedTileCountX_ + x] = edgeMin(ndcMin, zNear, zFar, view.projScaleX);
+            boundsMaxX_[k * paddedTileCountX_ + x] = edgeMax(ndcMax, zNear, zFar, view.projScaleX);
+        }
+        for (uint32_t y = 0; y < tileCountY_; ++y) {
+            float ndcMin = -1.0f + 2.0f * static_cast<float>(y) / static_cast<float>(tileCountY_);
+            float ndcMax = -1.0f + 2.0f * static_cast<float>(y + 1) / static_cast<float>(tileCountY_);
+            boundsMinY_[k * tileCountY_ + y] = edgeMin(ndcMin, zNear, zFar, view.projScaleY);
+            boundsMaxY_[k * tileCountY_ + y] = edgeMax(ndcMax, zNear, zFar, view.projScaleY);
+        }
+    }
+}
+
+void LightClusterBinning::CollectClusters(const Sphere& sphere, const Cone* cone, uint32_t lightIndex, std::vector<Pair>& outPairs)
+{
+    const float zMin = sphere.z - sphere.radius;
+    const float zMax = sphere.z + sphere.radius;
+    if (zMax < sliceNear_[0] || zMin > sliceNear_[sliceCount_]) {
+        return;
+    }
+
+    // 奥行きの範囲を分割番号に変換（丸め誤差に備えて前後1つずつ広げ、各分割で正確に判定する）
+    auto toSlice = [&](float z) {
+        float slice = std::log((std::max)(z, sliceNear_[0])) * sliceScale_ + sliceBias_;
+        return static_cast<int32_t>(std::floor(slice));
+    };
+    int32_t lastSlice = static_cast<int32_t>(sliceCount_) - 1;
+    uint32_t firstSlice = static_cast<uint32_t>((std::clamp)(toSlice(zMin) - 1, 0, lastSlice));
+    uint32_t endSlice = static_cast<uint32_t>((std::clamp)(toSlice(zMax) + 1, 0, lastSlice)) + 1;
+
+    const float radiusSq = sphere.radius * sphere.radius;
+
+    // 円錐で絞り込む（クラスターを囲む球と円錐の交差判定）
+    auto passesCone = [&](uint32_t x, uint32_t y, uint32_t k) {
+        if (!cone) {
+            return true;
+        }
+        float minX = boundsMinX_[k * paddedTileCountX_ + x];
+        float maxX = boundsMaxX_[k * paddedTileCountX_ + x];
+        float minY = boundsMinY_[k * tileCountY_ + y];
+        float maxY = boundsMaxY_[k * tileCountY_ + y];
+        float minZ = sliceNear_[k];
+        float maxZ = sliceNear_[k + 1];
+        float halfX = (maxX - minX) * 0.5f;
+        float halfY = (maxY - minY) * 0.5f;
+        float halfZ = (maxZ - minZ) * 0.5f;
+        float clusterRadius = std::sqrt(halfX * halfX + halfY * halfY + halfZ * halfZ);
+
+        float vx = minX + halfX - cone->apexX;
+        float vy = minY + halfY - cone->apexY;
+        float vz = minZ + halfZ - cone->apexZ;
+        float lengthSq = vx * vx + vy * vy + vz * vz;
+        float alongAxis = vx * cone->dirX + vy * cone->dirY + vz * cone->dirZ;
+        float fromAxis = std::sqrt((std::max)(lengthSq - alongAxis * alongAxis, 0.0f));
+        float closest = cone->cosAngle * fromAxis - alongAxis * cone->sinAngle;
+
+        bool outsideAngle = closest > clusterRadius;
+        bool beyondRange = alongAxis > clusterRadius + cone->range;
+        bool behindApex = alongAxis < -clusterRadius;
+        return !(outsideAngle || beyondRange || behindApex);
+    };
+
+    for (uint32_t k = firstSlice; k < endSlice; ++k) {
+        float dz = DistanceToRange(sphere.z, sliceNear_[k], sliceNear_[k + 1]);
+        float restZ = radiusSq - dz * dz;
+        if (restZ < 0.0f) {
+            continue;
+        }
+        const float* minXs = &boundsMinX_[k * paddedTileCountX_];
+        const float* maxXs = &boundsMaxX_[k * paddedTileCountX_];
+
+        for (uint32_t y = 0; y < tileCountY_; ++y) {
+            float dy = DistanceToRange(sphere.y, boundsMinY_[k * tileCountY_ + y], boundsMaxY_[k * tileCountY_ + y]);
+            float restY = restZ - dy * dy;
+            if (restY < 0.0f) {
+                continue;
+            }
+            uint32_t rowBase = GetClusterIndex(0, y, k);
+
+#ifdef LIGHT_CLUSTER_BINNING_USE_SSE
+            // 4列ずつ X 方向の距離を求め、残りの半径と比べる
+            const __m128 centerX = _mm_set1_ps(sphere.x);
+            const __m128 rest = _mm_set1_ps(restY);
+            const __m128 zero = _mm_setzero_ps();
+            for (uint32_t x = 0; x < paddedTileCountX_; x += 4) {
+                __m128 below = _mm_sub_ps(_mm_loadu_ps(minXs + x), centerX);
+                __m128 above = _mm_sub_ps(centerX, _mm_loadu_ps(maxXs + x));
+                __m128 dx = _mm_max_ps(_mm_max_ps(below, above), zero);
+                int mask = _mm_movemask_ps(_mm_cmple_ps(_mm_mul_ps(dx, dx), rest));
+                while (mask != 0) {
+                    uint32_t lane = 0;
+                    while ((mask & (1 << lane)) == 0) {
+                        ++lane;
+                    }
+                    mask &= ~(1 << lane);
+                    // 詰め物の列は境界が遠いので選ばれない
+                    if (passesCone(x + lane, y, k)) {
+                        outPairs.push_back({ rowBase + x + lane, lightIndex });
+                    }
+                }
+            }
+#else
+            for (uint32_t x = 0; x < tileCountX_; ++x) {
+                float dx = DistanceToRange(sphere.x, minXs[x], maxXs[x]);
+                if (dx * dx <= restY && passesCone(x, y, k)) {
+                    outPairs.push_back({ rowBase + x, lightIndex });
+                }
+            }
+#endif
+        }
+    }
+}
+
+void LightClusterBinning::Bin(const LightClusterView& view,
+    const PointLightData* pointLights, uint32_t pointLightCount,
+    const SpotLightData* spotLights, uint32_t spotLightCount)
+{
+    const uint32_t clusterCount = GetClusterCount();
+    BuildBounds(view);
+    pointPairs_.clear();
+    spotPairs_.clear();
+    statistics_ = {};
+
+    // ===== ポイントライト：影響範囲の球 =====
+    for (uint32_t i = 0; i < pointLightCount; ++i) {
+        const PointLightData& light = pointLights[i];
+        if (!light.enabled || light.radius <= 0.0f) {
+            continue;
+        }
+        Vector3 center = ToView(view.view, light.position);
+        CollectClusters({ center.x, center.y, center.z, light.radius }, nullptr, i, pointPairs_);
+        ++statistics_.pointLightCount;
+    }
+
+    // ===== スポットライト：円錐（距離で切った扇形の立体）を囲む球と円錐 =====
+    for (uint32_t i = 0; i < spotLightCount; ++i) {
+        const SpotLightData& light = spotLights[i];
+        if (!light.enabled || light.distance <= 0.0f) {
+            continue;
+        }
+        Vector3 apex = ToView(view.view, light.position);
+        Vector3 direction = ToViewDirection(view.view, light.direction);
+        float length = std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+        float cosAngle = (std::clamp)(light.cosAngle, -1.0f, 1.0f);
+
+        Sphere sphere{ apex.x, apex.y, apex.z, light.distance };
+        Cone cone{};
+        bool useCone = length > 0.0f && cosAngle > 0.0f;
+        if (useCone) {
+            direction = { direction.x / length, direction.y / length, direction.z / length };
+            float sinAngle = std::sqrt(1.0f - cosAngle * cosAngle);
+            // 45度以下なら頂点と縁を通る球、それより広ければ底面の円を囲む球が小さい
+            float offset = 0.0f;
+            if (cosAngle >= 0.70710678f) {
+                sphere.radius = light.distance / (2.0f * cosAngle);
+                offset = sphere.radius;
+            } else {
+                sphere.radius = light.distance * sinAngle;
+                offset = light.distance * cosAngle;
+            }
+            sphere.x += direction.x * offset;
+            sphere.y += direction.y * offset;
+            sphere.z += direction.z * offset;
+            cone = { apex.x, apex.y, apex.z, direction.x, direction.y, direction.z, light.distance, cosAngle, sinAngle };
+        }
+        CollectClusters(sphere, useCone ? &cone : nullptr, i, spotPairs_);
+        ++statistics_.spotLightCount;
+    }
+
+    // ===== クラスターごとに数え、先頭位置を決める =====
+    std::fill(pointCounts_.begin(), pointCounts_.end(), 0u);
+    std::fill(spotCounts_.begin(), spotCounts_.end(), 0u);
+    for (const Pair& pair : pointPairs_) {
+        ++pointCounts_[pair.cluster];
+    }
+    for (const Pair& pair : spotPairs_) {
+        ++spotCounts_[pair.cluster];
+    }
+
+    uint32_t offset = 0;
+    uint32_t requested = 0;
+    for (uint32_t c = 0; c < clusterCount; ++c) {
+        requested += pointCounts_[c] + spotCounts_[c];
+
+        // 容量を超える分は切り捨てる（ポイントライトを優先）
+        uint32_t available = maxIndexCount_ - offset;
+        uint32_t pointCount = (std::min)({ pointCounts_[c], kMaxLightsPerType, available });
+        uint32_t spotCount = (std::min)({ spotCounts_[c], kMaxLightsPerType, available - pointCount });
+
+        ranges_[c] = { offset, pointCount | (spotCount << 16) };
+        offset += pointCount + spotCount;
+
+        if (pointCount + spotCount > 0) {
+            ++statistics_.occupiedClusterCount;
+            statistics_.maxLightsPerCluster = (std::max)(statistics_.maxLightsPerCluster, pointCount + spotCount);
+        }
+        // 書き込み位置として使い回す
+        pointCounts_[c] = 0;
+        spotCounts_[c] = 0;
+    }
+
+    // ===== ライト番号順に書き込む（組はライト番号順に並んでいる） =====
+    indices_.resize(offset);
+    for (const Pair& pair : pointPairs_) {
+        const LightClusterRange& range = ranges_[pair.cluster];
+        uint32_t& cursor = pointCounts_[pair.cluster];
+        if (cursor < (range.lightCount & 0xFFFF)) {
+            indices_[range.offset + cursor++] = pair.light;
+        }
+    }
+    for (const Pair& pair : spotPairs_) {
+        const LightClusterRange& range = ranges_[pair.cluster];
+        uint32_t& cursor = spotCounts_[pair.cluster];
+        if (cursor < (range.lightCount >> 16)) {
+            indices_[range.offset + (range.lightCount & 0xFFFF) + cursor++] = pair.light;
+        }
+    }
+
+    statistics_.indexCount = offset;
+    statistics_.droppedIndexCount = requested - offset;
+}
+
+uint32_t LightClusterBinning::FindCluster(const LightClusterView& view, const Vector3& viewPosition) const
+{
+    if (viewPosition.z < view.nearZ || viewPosition.z > view.farZ) {
+        return UINT32_MAX;
+    }
+    float ndcX = viewPosition.x * view.projScaleX / viewPosition.z;
+    float ndcY = viewPosition.y * view.projScaleY / viewPosition.z;
+    if (std::abs(ndcX) > 1.0f || std::abs(ndcY) > 1.0f) {
+        return UINT32_MAX;
+    }
+
+    float scale = 0.0f;
+    float bias = 0.0f;
+    GetSliceParameters(view, scale, bias);
+
+    auto toTile = [](float value, uint32_t count) {
+        int32_t tile = static_cast<int32_t>(std::floor(value * static_cast<float>(count)));
+        return static_cast<uint32_t>((std::clamp)(tile, 0, static_cast<int32_t>(count) - 1));
+    };
+    uint32_t x = toTile(ndcX * 0.5f + 0.5f, tileCountX_);
+    uint32_t y = toTile(ndcY * 0.5f + 0.5f, tileCountY_);
+    int32_t slice = static_cast<int32_t>(std::floor(std::log(viewPosition.z) * scale + bias));
+    uint32_t z = static_cast<uint32_t>((std::clamp)(slice, 0, static_cast<int32_t>(sliceCount_) - 1));
+    return GetClusterIndex(x, y, z);
+}
+
+Vector3 LightClusterBinning::ToView(const Matrix4x4& view, const Vector3& position)
+{
+    return {
+        position.x * view.m[0][0] + position.y * view.m[1][0] + position.z * view.m[2][0] + view.m[3][0],
+        position.x * view.m[0][1] + position.y * view.m[1][1] + position.z * view.m[2][1] + view.m[3][1],
+        position.x * view.m[0][2] + position.y * view.m[1][2] + position.z * view.m[2][2] + view.m[3][2],
+    };
+}
+
+Vector3 LightClusterBinning::ToViewDirection(const Matrix4x4& view, const Vector3& direction)
+{
+    return {
+        direction.x * view.m[0][0] + direction.y * view.m[1][0] + direction.z * view.m[2][0],
+        direction.x * view.m[0][1] + direction.y * view.m[1][1] + direction.z * view.m[2][1],
+        direction.x * view.m[0][2] + direction.y * view.m[1][2] + direction.z * view.m[2][2],
+    };
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "LightData.h"
+#include <cstdint>
+#include <vector>
+
+/// @brief クラスターごとのライト範囲（シェーダーと完全一致）
+/// @details offset から pointCount 個がポイントライト、その後ろ spotCount 個がスポットライトのインデックス。
+struct LightClusterRange {
+    uint32_t offset;     ///< ライトインデックスリスト内の先頭
+    uint32_t lightCount; ///< 下位16bitがポイントライト数、上位16bitがスポットライト数
+};
+
+/// @brief クラスター分割に使うカメラの情報
+struct LightClusterView {
+    Matrix4x4 view;          ///< ビュー行列
+    float projScaleX = 1.0f; ///< 透視投影行列の m[0][0]
+    float projScaleY = 1.0f; ///< 透視投影行列の m[1][1]
+    float nearZ = 0.1f;      ///< ニアクリップ
+    float farZ = 100.0f;     ///< ファークリップ
+
+    /// @brief ビュー行列と透視投影行列から作成
+    /// @param view ビュー行列
+    /// @param projection 透視投影行列（MathCore::Matrix::PerspectiveFov の形式）
+    /// @param maxDepth クラスターで扱う最大の奥行き（0以下ならファークリップまで）
+    /// @param out 結果
+    /// @return 透視投影でなければfalse
+    static bool FromMatrices(const Matrix4x4& view, const Matrix4x4& projection, float maxDepth, LightClusterView& out);
+};
+
+/// @brief ライトのクラスター分割（D3D12に依存しない）
+/// @details 視錐台を画面のタイル × 指数分割した奥行きのクラスターに分け、
+/// ポイントライトは影響範囲の球、スポットライトは円錐を囲む球と円錐そのものでクラスターとの交差を判定する。
+/// 同じ列のクラスターはX方向の範囲だけが異なるので、4列ずつSIMDでまとめて判定する。
+/// 結果はクラスターごとの範囲と、それが指すライトインデックスの一覧になる（各クラスター内はライト番号順）。
+class LightClusterBinning {
+public:
+    /// @brief 統計
+    struct Statistics {
+        uint32_t pointLightCount = 0;      ///< 判定したポイントライト数
+        uint32_t spotLightCount = 0;       ///< 判定したスポットライト数
+        uint32_t indexCount = 0;           ///< 書き出したライトインデックス数
+        uint32_t droppedIndexCount = 0;    ///< 容量不足で書き出せなかったインデックス数
+        uint32_t occupiedClusterCount = 0; ///< ライトが1つ以上あるクラスター数
+        uint32_t maxLightsPerCluster = 0;  ///< 1クラスターあたりの最大ライト数
+    };
+
+    /// @brief グリッドの分割数と、ライトインデックスの最大数を設定
+    /// @param tileCountX 横方向のタイル数
+    /// @param tileCountY 縦方向のタイル数
+    /// @param sliceCount 奥行き方向の分割数
+    /// @param maxIndexCount 書き出せるライトインデックスの最大数
+    void Initialize(uint32_t tileCountX, uint32_t tileCountY, uint32_t sliceCount, uint32_t maxIndexCount);
+
+    /// @brief ライトをクラスターに振り分ける
+    /// @param view カメラ
+    /// @param pointLights ポイントライト（無効なものは振り分けない）
+    /// @param pointLightCount ポイントライト数
+    /// @param spotLights スポットライト（無効なものは振り分けない）
+    /// @param spotLightCount スポットライト数
+    void Bin(const LightClusterView& view,
+        const PointLightData* pointLights, uint32_t pointLightCount,
+        const SpotLightData* spotLights, uint32_t spotLightCount);
+
+    /// @brief クラスターの番号（x + y * タイル数X + z * タイル数X * タイル数Y）
+    uint32_t GetClusterIndex(uint32_t x, uint32_t y, uint32_t z) const { return x + (y + z * tileCountY_) * tileCountX_; }
+
+    /// @brief ビュー空間の位置が属するクラスターの番号（視錐台の外なら UINT32_MAX）
+    /// @details シェーダーと同じ計算。検証用。
+    uint32_t FindCluster(const LightClusterView& view, const Vector3& viewPosition) const;
+
+    /// @brief 奥行きの分割に使う係数（slice = log(z) * scale + bias）
+    void GetSliceParameters(const LightClusterView& view, float& outScale, float& outBias) const;
+
+    uint32_t GetTileCountX() const { return tileCountX_; }
+    uint32_t GetTileCountY() const { return tileCountY_; }
+    uint32_t GetSliceCount() const { return sliceCount_; }
+    uint32_t GetClusterCount() const { return tileCountX_ * tileCountY_ * sliceCount_; }
+    uint32_t GetMaxIndexCount() const { return maxIndexCount_; }
+
+    /// @brief クラスターごとのライト範囲（GetClusterCount() 個）
+    const std::vector<LightClusterRange>& GetRanges() const { return ranges_; }
+
+    /// @brief ライトインデックスの一覧（GetStatistics().indexCount 個）
+    const std::vector<uint32_t>& GetIndices() const { return indices_; }
+
+    /// @brief 直前の Bin の統計
+    const Statistics& GetStatistics() const { return statistics_; }
+
+private:
+    /// @brief ライトとクラスターの組
+    struct Pair {
+        uint32_t cluster;
+        uint32_t light;
+    };
+
+    /// @brief 判定対象の球（ビュー空間）
+    struct Sphere {
+        float x, y, z, radius;
+    };
+
+    /// @brief 円錐（ビュー空間、スポットライトの絞り込み用）
+    struct Cone {
+        float apexX, apexY, apexZ;
+        float dirX, dirY, dirZ;
+        float range;
+        float cosAngle;
+        float sinAngle;
+    };
+
+    /// @brief カメラに合わせてクラスターの境界を計算
+    void BuildBounds(const LightClusterView& view);
+
+    /// @brief 球と交差するクラスターを列挙
+    /// @param cone nullptr でなければ円錐とも交差するクラスターだけに絞る
+    void CollectClusters(const Sphere& sphere, const Cone* cone, uint32_t lightIndex, std::vector<Pair>& outPairs);
+
+    /// @brief ワールド座標をビュー空間に変換
+    static Vector3 ToView(const Matrix4x4& view, const Vector3& position);
+
+    /// @brief ワールドの向きをビュー空間に変換
+    static Vector3 ToViewDirection(const Matrix4x4& view, const Vector3& direction);
+
+    uint32_t tileCountX_ = 16;
+    uint32_t tileCountY_ = 9;
+    uint32_t sliceCount_ = 24;
+    uint32_t paddedTileCountX_ = 16; ///< 4の倍数に切り上げたタイル数X
+    uint32_t maxIndexCount_ = 0;
+
+    // クラスターの境界（ビュー空間のAABB）
+    // X・Yの範囲は奥行きの分割ごとに変わるので [slice][tile] で持つ
+    std::vector<float> sliceNear_;     ///< [slice + 1] 各分割の手前のZ（最後は奥）
+    std::vector<float> boundsMinX_;    ///< [slice * paddedTileCountX_ + x]
+    std::vector<float> boundsMaxX_;
+    std::vector<float> boundsMinY_;    ///< [slice * tileCountY_ + y]
+    std::vector<float> boundsMaxY_;
+    float sliceScale_ = 0.0f;
+    float sliceBias_ = 0.0f;
+
+    // 作業用
+    std::vector<Pair> pointPairs_;
+    std::vector<Pair> spotPairs_;
+    std::vector<uint32_t> pointCounts_;
+    std::vector<uint32_t> spotCounts_;
+
+    // 結果
+    std::vector<LightClusterRange> ranges_;
+    std::vector<uint32_t> indices_;
+    Statistics statistics_;
+};
@@ -40,9 +40,20 @@ struct SpotLightData {
 };
 
 /// @brief ライトカウント用の定数バッファ構造体
+/// @details クラスター分割が有効なとき、ピクセルシェーダーはワールド座標から属するクラスターを求め、
+/// そのクラスターのライトだけを計算する。
 struct LightCounts {
     uint32_t directionalLightCount;
     uint32_t pointLightCount;
     uint32_t spotLightCount;
-    uint32_t padding;  // 16バイトアライメント
+    uint32_t clusterEnabled;    // クラスター分割の有効フラグ（0なら全ライトを計算）
+    uint32_t clusterCountX;     // 横方向のタイル数
+    uint32_t clusterCountY;     // 縦方向のタイル数
+    uint32_t clusterCountZ;     // 奥行き方向の分割数
+    uint32_t padding;           // 16バイトアライメント
+    float projScaleX;           // 透視投影行列の m[0][0]
+    float projScaleY;           // 透視投影行列の m[1][1]
+    float sliceScale;           // 奥行き分割 slice = log(z) * sliceScale + sliceBias
+    float sliceBias;
+    Matrix4x4 view;             // クラスター分割に使ったビュー行列
 };
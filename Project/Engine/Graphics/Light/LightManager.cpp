@@ -4,7 +4,10 @@
 #include "MathCore.h"
 #include "Engine/Graphics/Resource/ResourceFactory.h"
 #include "Engine/Graphics/Common/Core/DescriptorManager.h"
+#include "Engine/Camera/ICamera.h"
+#include <algorithm>
 #include <cstring>
+#include <string>
 
 #ifdef _DEBUG
 #include <imgui.h>
@@ -16,6 +19,11 @@ void LightManager::Initialize(ID3D12Device* device, ResourceFactory* resourceFac
     device_ = device;
     resourceFactory_ = resourceFactory;
 
+    // Add*Light が返すポインタが追加で無効にならないよう、最大数まで確保しておく
+    directionalLights_.reserve(MAX_DIRECTIONAL_LIGHTS);
+    pointLights_.reserve(MAX_POINT_LIGHTS);
+    spotLights_.reserve(MAX_SPOT_LIGHTS);
+
     // 新システムのStructuredBufferリソースを作成
     CreateStructuredBufferResources(device);
 
@@ -23,12 +31,110 @@ void LightManager::Initialize(ID3D12Device* device, ResourceFactory* resourceFac
     if (descriptorManager) {
         CreateStructuredBufferSRVs(descriptorManager);
     }
+
+    // クラスター分割の準備
+    clusterBinning_.Initialize(kClusterCountX, kClusterCountY, kClusterCountZ,
+        kClusterCountX * kClusterCountY * kClusterCountZ * kAverageLightsPerCluster);
+    CreateClusterBuffers(device);
+    clusterWorker_ = std::thread(&LightManager::ClusterWorkerMain, this);
+}
+
+LightManager::~LightManager()
+{
+    if (clusterWorker_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(clusterMutex_);
+            clusterExit_ = true;
+        }
+        clusterStartCondition_.notify_one();
+        clusterWorker_.join();
+    }
 }
 
-void LightManager::UpdateAll()
+void LightManager::UpdateAll(const ICamera* camera)
 {
+    // 前フレームの振り分けを終えてから、次のフレームのバッファに切り替える
+    WaitForClusters();
+    clusterStatistics_ = clusterBinning_.GetStatistics();
+    uploadStatistics_.clusterBytes = clusterUploadBytes_;
+    lastUploadStatistics_ = uploadStatistics_;
+    totalUploadedBytes_ += uploadStatistics_.GetLightBytes() + uploadStatistics_.clusterBytes;
+    uploadStatistics_ = {};
+    clusterUploadBytes_ = 0;
+    frameIndex_ = (frameIndex_ + 1) % kFrameCount;
+
+    // クラスター分割の設定（ライトカウントと一緒に転送する）
+    LightClusterView view;
+    bool clustered = camera && clusterWorker_.joinable() &&
+        LightClusterView::FromMatrices(camera->GetViewMatrix(), camera->GetProjectionMatrix(), 0.0f, view);
+    lightCounts_.clusterEnabled = clustered ? 1 : 0;
+    lightCounts_.clusterCountX = kClusterCountX;
+    lightCounts_.clusterCountY = kClusterCountY;
+    lightCounts_.clusterCountZ = kClusterCountZ;
+    if (clustered) {
+        lightCounts_.projScaleX = view.projScaleX;
+        lightCounts_.projScaleY = view.projScaleY;
+        clusterBinning_.GetSliceParameters(view, lightCounts_.sliceScale, lightCounts_.sliceBias);
+        lightCounts_.view = view.view;
+    }
+
     // 新システムの更新
     UpdateLightBuffers();
+
+    if (clustered) {
+        StartClusterBinning(view);
+    }
+}
+
+void LightManager::WaitForClusters()
+{
+    std::unique_lock<std::mutex> lock(clusterMutex_);
+    clusterDoneCondition_.wait(lock, [this] { return !clusterPending_; });
+}
+
+void LightManager::StartClusterBinning(const LightClusterView& view)
+{
+    // ワーカーはコピーを読むので、振り分け中にライトを編集・追加してもよい
+    clusterView_ = view;
+    pointLightSnapshot_.assign(pointLights_.begin(), pointLights_.end());
+    spotLightSnapshot_.assign(spotLights_.begin(), spotLights_.end());
+
+    {
+        std::lock_guard<std::mutex> lock(clusterMutex_);
+        clusterRequested_ = true;
+        clusterPending_ = true;
+    }
+    clusterStartCondition_.notify_one();
+}
+
+void LightManager::ClusterWorkerMain()
+{
+    std::unique_lock<std::mutex> lock(clusterMutex_);
+    while (true) {
+        clusterStartCondition_.wait(lock, [this] { return clusterRequested_ || clusterExit_; });
+        if (clusterExit_) {
+            return;
+        }
+        clusterRequested_ = false;
+        lock.unlock();
+
+        clusterBinning_.Bin(clusterView_,
+            pointLightSnapshot_.data(), static_cast<uint32_t>(pointLightSnapshot_.size()),
+            spotLightSnapshot_.data(), static_cast<uint32_t>(spotLightSnapshot_.size()));
+
+        // 今フレームのバッファへ書き込む
+        const auto& ranges = clusterBinning_.GetRanges();
+        const auto& indices = clusterBinning_.GetIndices();
+        std::memcpy(mappedClusterRanges_[frameIndex_], ranges.data(), sizeof(LightClusterRange) * ranges.size());
+        if (!indices.empty()) {
+            std::memcpy(mappedLightIndices_[frameIndex_], indices.data(), sizeof(uint32_t) * indices.size());
+        }
+        clusterUploadBytes_ = static_cast<uint32_t>(sizeof(LightClusterRange) * ranges.size() + sizeof(uint32_t) * indices.size());
+
+        lock.lock();
+        clusterPending_ = false;
+        clusterDoneCondition_.notify_all();
+    }
 }
 
 void LightManager::DrawAllImGui()
@@ -44,6 +150,22 @@ void LightManager::DrawAllImGui()
             static_cast<uint32_t>(pointLights_.size()), MAX_POINT_LIGHTS);
         ImGui::Text("  スポットライト: %u / %u", 
             static_cast<uint32_t>(spotLights_.size()), MAX_SPOT_LIGHTS);
+
+        // クラスター分割
+        if (ImGui::TreeNode("クラスター分割")) {
+            const LightClusterBinning::Statistics& stats = clusterStatistics_;
+            bool enabled = lightCountsData_[frameIndex_] && lightCountsData_[frameIndex_]->clusterEnabled != 0;
+            ImGui::Text("状態: %s", enabled ? "有効" : "無効（全ライトを計算）");
+            ImGui::Text("クラスター: %u x %u x %u", kClusterCountX, kClusterCountY, kClusterCountZ);
+            ImGui::Text("振り分けたライト: ポイント %u / スポット %u", stats.pointLightCount, stats.spotLightCount);
+            ImGui::Text("ライトのあるクラスター: %u / %u", stats.occupiedClusterCount, clusterBinning_.GetClusterCount());
+            ImGui::Text("1クラスターの最大ライト数: %u", stats.maxLightsPerCluster);
+            ImGui::Text("インデックス: %u / %u", stats.indexCount, clusterBinning_.GetMaxIndexCount());
+            if (stats.droppedIndexCount > 0) {
+                ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "容量不足で省いたインデックス: %u", stats.droppedIndexCount);
+            }
+            ImGui::TreePop();
+        }
         
         ImGui::Separator();
         
@@ -219,96 +341,123 @@ SpotLightData* LightManager::AddSpotLight()
 
 void LightManager::CreateStructuredBufferResources(ID3D12Device* device)
 {
-    // ===== ディレクショナルライトのStructuredBuffer作成 =====
-    directionalLightsBuffer_ = ResourceFactory::CreateBufferResource(
-        device,
-        sizeof(DirectionalLightData) * MAX_DIRECTIONAL_LIGHTS
-    );
-
-    // ===== ポイントライトのStructuredBuffer作成 =====
-    pointLightsBuffer_ = ResourceFactory::CreateBufferResource(
-        device,
-        sizeof(PointLightData) * MAX_POINT_LIGHTS
-    );
-
-    // ===== スポットライトのStructuredBuffer作成 =====
-    spotLightsBuffer_ = ResourceFactory::CreateBufferResource(
-        device,
-        sizeof(SpotLightData) * MAX_SPOT_LIGHTS
-    );
-
-    // ===== ライトカウント用のConstantBuffer作成 =====
-    lightCountsBuffer_ = ResourceFactory::CreateBufferResource(
-        device,
-        sizeof(LightCounts)
-    );
-
-    // ライトカウントバッファをマップ
-    lightCountsBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&lightCountsData_));
+    // GPUが前のフレームのバッファを読んでいる間に書き込めるよう、フレームごとに作って永続マップする
+    for (uint32_t i = 0; i < kFrameCount; ++i) {
+        // ===== ディレクショナルライトのStructuredBuffer作成 =====
+        directionalLightsBuffers_[i] = ResourceFactory::CreateBufferResource(
+            device,
+            sizeof(DirectionalLightData) * MAX_DIRECTIONAL_LIGHTS
+        );
+        directionalLightsBuffers_[i]->Map(0, nullptr, reinterpret_cast<void**>(&mappedDirectionalLights_[i]));
+
+        // ===== ポイントライトのStructuredBuffer作成 =====
+        pointLightsBuffers_[i] = ResourceFactory::CreateBufferResource(
+            device,
+            sizeof(PointLightData) * MAX_POINT_LIGHTS
+        );
+        pointLightsBuffers_[i]->Map(0, nullptr, reinterpret_cast<void**>(&mappedPointLights_[i]));
+
+        // ===== スポットライトのStructuredBuffer作成 =====
+        spotLightsBuffers_[i] = ResourceFactory::CreateBufferResource(
+            device,
+            sizeof(SpotLightData) * MAX_SPOT_LIGHTS
+        );
+        spotLightsBuffers_[i]->Map(0, nullptr, reinterpret_cast<void**>(&mappedSpotLights_[i]));
+
+        // ===== ライトカウント用のConstantBuffer作成（256バイト境界） =====
+        lightCountsBuffers_[i] = ResourceFactory::CreateBufferResource(
+            device,
+            (sizeof(LightCounts) + 255) & ~static_cast<size_t>(255)
+        );
+
+        // ライトカウントバッファをマップ
+        lightCountsBuffers_[i]->Map(0, nullptr, reinterpret_cast<void**>(&lightCountsData_[i]));
+        *lightCountsData_[i] = {};
+        writtenLightCounts_[i] = {};
+    }
 }
 
 void LightManager::CreateStructuredBufferSRVs(DescriptorManager* descriptorManager)
 {
-    // ===== ディレクショナルライトのSRV作成 =====
     D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
     srvDesc.Format = DXGI_FORMAT_UNKNOWN;
     srvDesc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
     srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
     srvDesc.Buffer.FirstElement = 0;
-    srvDesc.Buffer.NumElements = MAX_DIRECTIONAL_LIGHTS;
-    srvDesc.Buffer.StructureByteStride = sizeof(DirectionalLightData);
     srvDesc.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
 
     D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle;
     D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle;
-    
-    descriptorManager->CreateSRV(directionalLightsBuffer_.Get(), srvDesc, cpuHandle, gpuHandle, "DirectionalLights");
-    directionalLightsSRVHandle_ = gpuHandle;
-
-    // ===== ポイントライトのSRV作成 =====
-    srvDesc.Buffer.NumElements = MAX_POINT_LIGHTS;
-    srvDesc.Buffer.StructureByteStride = sizeof(PointLightData);
-    descriptorManager->CreateSRV(pointLightsBuffer_.Get(), srvDesc, cpuHandle, gpuHandle, "PointLights");
-    pointLightsSRVHandle_ = gpuHandle;
-
-    // ===== スポットライトのSRV作成 =====
-    srvDesc.Buffer.NumElements = MAX_SPOT_LIGHTS;
-    srvDesc.Buffer.StructureByteStride = sizeof(SpotLightData);
-    descriptorManager->CreateSRV(spotLightsBuffer_.Get(), srvDesc, cpuHandle, gpuHandle, "SpotLights");
-    spotLightsSRVHandle_ = gpuHandle;
-}
 
-void LightManager::UpdateLightBuffers()
-{
-    // ===== ディレクショナルライトバッファの更新 =====
-    if (!directionalLights_.empty()) {
-        DirectionalLightData* mappedData = nullptr;
-        directionalLightsBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&mappedData));
-        std::memcpy(mappedData, directionalLights_.data(), sizeof(DirectionalLightData) * directionalLights_.size());
-        directionalLightsBuffer_->Unmap(0, nullptr);
-    }
-
-    // ===== ポイントライトバッファの更新 =====
-    if (!pointLights_.empty()) {
-        PointLightData* mappedData = nullptr;
-        pointLightsBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&mappedData));
-        std::memcpy(mappedData, pointLights_.data(), sizeof(PointLightData) * pointLights_.size());
-        pointLightsBuffer_->Unmap(0, nullptr);
+    for (uint32_t i = 0; i < kFrameCount; ++i) {
+        std::string suffix = std::to_string(i);
+
+        // ===== ディレクショナルライトのSRV作成 =====
+        srvDesc.Buffer.NumElements = MAX_DIRECTIONAL_LIGHTS;
+        srvDesc.Buffer.StructureByteStride = sizeof(DirectionalLightData);
+        descriptorManager->CreateSRV(directionalLightsBuffers_[i].Get(), srvDesc, cpuHandle, gpuHandle, "DirectionalLights" + suffix);
+        directionalLightsSRVHandles_[i] = gpuHandle;
+
+        // ===== ポイントライトのSRV作成 =====
+        srvDesc.Buffer.NumElements = MAX_POINT_LIGHTS;
+        srvDesc.Buffer.StructureByteStride = sizeof(PointLightData);
+        descriptorManager->CreateSRV(pointLightsBuffers_[i].Get(), srvDesc, cpuHandle, gpuHandle, "PointLights" + suffix);
+        pointLightsSRVHandles_[i] = gpuHandle;
+
+        // ===== スポットライトのSRV作成 =====
+        srvDesc.Buffer.NumElements = MAX_SPOT_LIGHTS;
+        srvDesc.Buffer.StructureByteStride = sizeof(SpotLightData);
+        descriptorManager->CreateSRV(spotLightsBuffers_[i].Get(), srvDesc, cpuHandle, gpuHandle, "SpotLights" + suffix);
+        spotLightsSRVHandles_[i] = gpuHandle;
     }
+}
 
-    // ===== スポットライトバッファの更新 =====
-    if (!spotLights_.empty()) {
-        SpotLightData* mappedData = nullptr;
-        spotLightsBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&mappedData));
-        std::memcpy(mappedData, spotLights_.data(), sizeof(SpotLightData) * spotLights_.size());
-        spotLightsBuffer_->Unmap(0, nullptr);
+void LightManager::CreateClusterBuffers(ID3D12Device* device)
+{
+    // ルートSRVとして渡すのでディスクリプタは作らない
+    for (uint32_t i = 0; i < kFrameCount; ++i) {
+        clusterRangesBuffers_[i] = ResourceFactory::CreateBufferResource(
+            device,
+            sizeof(LightClusterRange) * clusterBinning_.GetClusterCount()
+        );
+        clusterRangesBuffers_[i]->Map(0, nullptr, reinterpret_cast<void**>(&mappedClusterRanges_[i]));
+        std::memset(mappedClusterRanges_[i], 0, sizeof(LightClusterRange) * clusterBinning_.GetClusterCount());
+
+        lightIndicesBuffers_[i] = ResourceFactory::CreateBufferResource(
+            device,
+            sizeof(uint32_t) * (std::max)(clusterBinning_.GetMaxIndexCount(), 1u)
+        );
+        lightIndicesBuffers_[i]->Map(0, nullptr, reinterpret_cast<void**>(&mappedLightIndices_[i]));
     }
+}
 
-    // ===== ライトカウントの更新 =====
-    if (lightCountsData_) {
-        lightCountsData_->directionalLightCount = static_cast<uint32_t>(directionalLights_.size());
-        lightCountsData_->pointLightCount = static_cast<uint32_t>(pointLights_.size());
-        lightCountsData_->spotLightCount = static_cast<uint32_t>(spotLights_.size());
+void LightManager::UpdateLightBuffers()
+{
+    // ===== 変更されたライトを検出し、今フレームのバッファに未反映の範囲だけを書き込む =====
+    auto record = [this](const auto& result, uint32_t& bytes) {
+        bytes += result.bytes;
+        uploadStatistics_.changedLightCount += result.lightCount;
+        uploadStatistics_.rangeCount += result.rangeCount;
+    };
+
+    directionalUploads_.Detect(directionalLights_);
+    record(directionalUploads_.Upload(frameIndex_, mappedDirectionalLights_[frameIndex_]), uploadStatistics_.directionalBytes);
+
+    pointUploads_.Detect(pointLights_);
+    record(pointUploads_.Upload(frameIndex_, mappedPointLights_[frameIndex_]), uploadStatistics_.pointBytes);
+
+    spotUploads_.Detect(spotLights_);
+    record(spotUploads_.Upload(frameIndex_, mappedSpotLights_[frameIndex_]), uploadStatistics_.spotBytes);
+
+    // ===== ライトカウントの更新（このフレームのバッファと内容が変わったときだけ） =====
+    lightCounts_.directionalLightCount = static_cast<uint32_t>(directionalLights_.size());
+    lightCounts_.pointLightCount = static_cast<uint32_t>(pointLights_.size());
+    lightCounts_.spotLightCount = static_cast<uint32_t>(spotLights_.size());
+    LightCounts* counts = lightCountsData_[frameIndex_];
+    if (counts && std::memcmp(&writtenLightCounts_[frameIndex_], &lightCounts_, sizeof(LightCounts)) != 0) {
+        *counts = lightCounts_;
+        writtenLightCounts_[frameIndex_] = lightCounts_;
+        uploadStatistics_.countsBytes += sizeof(LightCounts);
     }
 }
 
@@ -317,35 +466,51 @@ void LightManager::SetLightsToCommandList(
     UINT lightCountsRootParameterIndex,
     UINT directionalLightsRootParameterIndex,
     UINT pointLightsRootParameterIndex,
-    UINT spotLightsRootParameterIndex
+    UINT spotLightsRootParameterIndex,
+    UINT clusterRangesRootParameterIndex,
+    UINT lightIndicesRootParameterIndex
 )
 {
+    // クラスターの振り分けが終わっていなければ待つ
+    WaitForClusters();
+
     // ライトカウントをConstantBufferとしてセット
     commandList->SetGraphicsRootConstantBufferView(
         lightCountsRootParameterIndex,
-        lightCountsBuffer_->GetGPUVirtualAddress()
+        lightCountsBuffers_[frameIndex_]->GetGPUVirtualAddress()
     );
 
     // 各ライトのStructuredBufferをDescriptorTableとしてセット
     commandList->SetGraphicsRootDescriptorTable(
         directionalLightsRootParameterIndex,
-        directionalLightsSRVHandle_
+        directionalLightsSRVHandles_[frameIndex_]
     );
 
     commandList->SetGraphicsRootDescriptorTable(
         pointLightsRootParameterIndex,
-        pointLightsSRVHandle_
+        pointLightsSRVHandles_[frameIndex_]
     );
 
     commandList->SetGraphicsRootDescriptorTable(
         spotLightsRootParameterIndex,
-        spotLightsSRVHandle_
+        spotLightsSRVHandles_[frameIndex_]
+    );
+
+    // クラスターごとのライト範囲とライトインデックスリスト
+    commandList->SetGraphicsRootShaderResourceView(
+        clusterRangesRootParameterIndex,
+        clusterRangesBuffers_[frameIndex_]->GetGPUVirtualAddress()
+    );
+
+    commandList->SetGraphicsRootShaderResourceView(
+        lightIndicesRootParameterIndex,
+        lightIndicesBuffers_[frameIndex_]->GetGPUVirtualAddress()
     );
 }
 
 D3D12_GPU_VIRTUAL_ADDRESS LightManager::GetLightCountsGPUAddress() const
 {
-    return lightCountsBuffer_ ? lightCountsBuffer_->GetGPUVirtualAddress() : 0;
+    return lightCountsBuffers_[frameIndex_] ? lightCountsBuffers_[frameIndex_]->GetGPUVirtualAddress() : 0;
 }
 
 void LightManager::SetDirectionalLightEnabled(size_t index, bool enabled)
@@ -374,4 +539,9 @@ void LightManager::ClearAllLights()
     directionalLights_.clear();
     pointLights_.clear();
     spotLights_.clear();
+
+    // 次に追加されたライトは全フレームへ書き込み直す
+    directionalUploads_.Reset();
+    pointUploads_.Reset();
+    spotUploads_.Reset();
 }
@@ -1,26 +1,62 @@
 #pragma once
 
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <d3d12.h>
 #include <wrl.h>
 
 #include "LightData.h"
+#include "LightClusterBinning.h"
+#include "LightUploadTracker.h"
 #include "MathCore.h"
 
 // 前方宣言
 class ResourceFactory;
 class DescriptorManager;
+class ICamera;
 
 /// @brief ライトマネージャー
+/// @details UpdateAll にカメラを渡すと、ポイントライトとスポットライトを視錐台のクラスターに振り分ける。
+/// 振り分けはワーカースレッドで行い、SetLightsToCommandList（または WaitForClusters）で完了を待つ。
+/// ライトのバッファはフレームごとに永続マップしており、前回から変わったライトの範囲だけを書き込む。
 class LightManager {
 public:
+    /// @brief 1フレームの転送量
+    struct UploadStatistics {
+        uint32_t directionalBytes = 0; ///< ディレクショナルライト
+        uint32_t pointBytes = 0;       ///< ポイントライト
+        uint32_t spotBytes = 0;        ///< スポットライト
+        uint32_t countsBytes = 0;      ///< ライトカウント（定数バッファ）
+        uint32_t clusterBytes = 0;     ///< クラスター分割の結果
+        uint32_t changedLightCount = 0; ///< 書き込んだライト数
+        uint32_t rangeCount = 0;       ///< 書き込んだ連続範囲の数
+
+        /// @brief ライトデータの合計（クラスター分割の結果を除く）
+        uint32_t GetLightBytes() const { return directionalBytes + pointBytes + spotBytes + countsBytes; }
+    };
+
     /// @brief 各ライトタイプの最大数
     static constexpr uint32_t MAX_DIRECTIONAL_LIGHTS = 4;
-    static constexpr uint32_t MAX_POINT_LIGHTS = 16;
-    static constexpr uint32_t MAX_SPOT_LIGHTS = 16;
+    static constexpr uint32_t MAX_POINT_LIGHTS = 512;
+    static constexpr uint32_t MAX_SPOT_LIGHTS = 256;
+
+    /// @brief クラスターの分割数（横 × 縦 × 奥行き）
+    static constexpr uint32_t kClusterCountX = 16;
+    static constexpr uint32_t kClusterCountY = 9;
+    static constexpr uint32_t kClusterCountZ = 24;
+
+    /// @brief 1クラスターあたりの平均ライト数（ライトインデックスリストの容量）
+    static constexpr uint32_t kAverageLightsPerCluster = 32;
+
+    /// @brief フレーム数（ダブルバッファリング）
+    static constexpr uint32_t kFrameCount = 2;
 
 public:
+    ~LightManager();
+
     /// @brief 初期化
     /// @param device D3D12デバイス
     /// @param resourceFactory リソースファクトリ
@@ -28,7 +64,20 @@ public:
     void Initialize(ID3D12Device* device, ResourceFactory* resourceFactory, DescriptorManager* descriptorManager);
 
     /// @brief 全てのライトを更新
-    void UpdateAll();
+    /// @param camera クラスター分割に使うカメラ（nullptrや正射影の場合は全ライトを計算する）
+    void UpdateAll(const ICamera* camera = nullptr);
+
+    /// @brief クラスターの振り分けの完了を待つ（複数スレッドから呼んでよい）
+    void WaitForClusters();
+
+    /// @brief 直前に完了したクラスター分割の統計
+    const LightClusterBinning::Statistics& GetClusterStatistics() const { return clusterStatistics_; }
+
+    /// @brief 直前のフレームの転送量
+    const UploadStatistics& GetUploadStatistics() const { return lastUploadStatistics_; }
+
+    /// @brief 起動してからの転送量の合計
+    uint64_t GetTotalUploadedBytes() const { return totalUploadedBytes_; }
 
     /// @brief ライトのImGuiを描画
     void DrawAllImGui();
@@ -45,7 +94,7 @@ public:
     /// @return 追加されたライトデータへのポインタ（最大数を超えた場合はnullptr）
     SpotLightData* AddSpotLight();
 
-    /// @brief GPU用のライトバッファを更新
+    /// @brief GPU用のライトバッファを更新（変更されたライトの範囲だけを今フレームのバッファへ書き込む）
     void UpdateLightBuffers();
 
     /// @brief コマンドリストにライトをセット
@@ -54,25 +103,29 @@ public:
     /// @param directionalLightsRootParameterIndex ディレクショナルライト用のルートパラメータインデックス
     /// @param pointLightsRootParameterIndex ポイントライト用のルートパラメータインデックス
     /// @param spotLightsRootParameterIndex スポットライト用のルートパラメータインデックス
+    /// @param clusterRangesRootParameterIndex クラスターごとのライト範囲用のルートパラメータインデックス（ルートSRV）
+    /// @param lightIndicesRootParameterIndex ライトインデックスリスト用のルートパラメータインデックス（ルートSRV）
     void SetLightsToCommandList(
         ID3D12GraphicsCommandList* commandList,
         UINT lightCountsRootParameterIndex,
         UINT directionalLightsRootParameterIndex,
         UINT pointLightsRootParameterIndex,
-        UINT spotLightsRootParameterIndex
+        UINT spotLightsRootParameterIndex,
+        UINT clusterRangesRootParameterIndex,
+        UINT lightIndicesRootParameterIndex
     );
 
     /// @brief ライトカウントバッファのGPU仮想アドレスを取得
     D3D12_GPU_VIRTUAL_ADDRESS GetLightCountsGPUAddress() const;
 
-    /// @brief ディレクショナルライトSRVのGPUハンドルを取得
-    D3D12_GPU_DESCRIPTOR_HANDLE GetDirectionalLightsSRVHandle() const { return directionalLightsSRVHandle_; }
+    /// @brief ディレクショナルライトSRVのGPUハンドルを取得（今フレームのバッファ）
+    D3D12_GPU_DESCRIPTOR_HANDLE GetDirectionalLightsSRVHandle() const { return directionalLightsSRVHandles_[frameIndex_]; }
 
-    /// @brief ポイントライトSRVのGPUハンドルを取得
-    D3D12_GPU_DESCRIPTOR_HANDLE GetPointLightsSRVHandle() const { return pointLightsSRVHandle_; }
+    /// @brief ポイントライトSRVのGPUハンドルを取得（今フレームのバッファ）
+    D3D12_GPU_DESCRIPTOR_HANDLE GetPointLightsSRVHandle() const { return pointLightsSRVHandles_[frameIndex_]; }
 
-    /// @brief スポットライトSRVのGPUハンドルを取得
-    D3D12_GPU_DESCRIPTOR_HANDLE GetSpotLightsSRVHandle() const { return spotLightsSRVHandle_; }
+    /// @brief スポットライトSRVのGPUハンドルを取得（今フレームのバッファ）
+    D3D12_GPU_DESCRIPTOR_HANDLE GetSpotLightsSRVHandle() const { return spotLightsSRVHandles_[frameIndex_]; }
 
     /// @brief ディレクショナルライトの有効/無効を設定
     /// @param index ライトのインデックス
@@ -99,25 +152,69 @@ private:
     /// @brief StructuredBuffer用のSRVを作成
     void CreateStructuredBufferSRVs(DescriptorManager* descriptorManager);
 
+    /// @brief クラスター分割の結果を書き込むバッファを作成
+    void CreateClusterBuffers(ID3D12Device* device);
+
+    /// @brief 今フレームのライトをコピーしてワーカースレッドで振り分けを開始
+    void StartClusterBinning(const LightClusterView& view);
+
+    /// @brief ワーカースレッドのメインループ
+    void ClusterWorkerMain();
+
 private:
     // CPU側のライトデータ配列
     std::vector<DirectionalLightData> directionalLights_;
     std::vector<PointLightData> pointLights_;
     std::vector<SpotLightData> spotLights_;
 
-    // GPU側のStructuredBufferリソース
-    Microsoft::WRL::ComPtr<ID3D12Resource> directionalLightsBuffer_;
-    Microsoft::WRL::ComPtr<ID3D12Resource> pointLightsBuffer_;
-    Microsoft::WRL::ComPtr<ID3D12Resource> spotLightsBuffer_;
-    Microsoft::WRL::ComPtr<ID3D12Resource> lightCountsBuffer_;
-
-    // StructuredBufferのSRV用GPUハンドル
-    D3D12_GPU_DESCRIPTOR_HANDLE directionalLightsSRVHandle_{};
-    D3D12_GPU_DESCRIPTOR_HANDLE pointLightsSRVHandle_{};
-    D3D12_GPU_DESCRIPTOR_HANDLE spotLightsSRVHandle_{};
-
-    // マップされたライトカウントデータ
-    LightCounts* lightCountsData_ = nullptr;
+    // GPU側のStructuredBufferリソース（フレームごと、永続マップ）
+    Microsoft::WRL::ComPtr<ID3D12Resource> directionalLightsBuffers_[kFrameCount];
+    Microsoft::WRL::ComPtr<ID3D12Resource> pointLightsBuffers_[kFrameCount];
+    Microsoft::WRL::ComPtr<ID3D12Resource> spotLightsBuffers_[kFrameCount];
+    Microsoft::WRL::ComPtr<ID3D12Resource> lightCountsBuffers_[kFrameCount];
+    DirectionalLightData* mappedDirectionalLights_[kFrameCount] = {};
+    PointLightData* mappedPointLights_[kFrameCount] = {};
+    SpotLightData* mappedSpotLights_[kFrameCount] = {};
+
+    // StructuredBufferのSRV用GPUハンドル（フレームごと）
+    D3D12_GPU_DESCRIPTOR_HANDLE directionalLightsSRVHandles_[kFrameCount]{};
+    D3D12_GPU_DESCRIPTOR_HANDLE pointLightsSRVHandles_[kFrameCount]{};
+    D3D12_GPU_DESCRIPTOR_HANDLE spotLightsSRVHandles_[kFrameCount]{};
+
+    // マップされたライトカウントデータ（フレームごと）と、最後に書き込んだ内容
+    LightCounts* lightCountsData_[kFrameCount] = {};
+    LightCounts writtenLightCounts_[kFrameCount] = {};
+    LightCounts lightCounts_ = {};              ///< 今フレームに書き込むライトカウント
+
+    // 変更されたライトの検出と差分転送
+    LightUploadTracker<DirectionalLightData, kFrameCount> directionalUploads_;
+    LightUploadTracker<PointLightData, kFrameCount> pointUploads_;
+    LightUploadTracker<SpotLightData, kFrameCount> spotUploads_;
+    UploadStatistics uploadStatistics_;      ///< 今フレームの転送量
+    UploadStatistics lastUploadStatistics_;  ///< 前フレームの転送量
+    uint64_t totalUploadedBytes_ = 0;
+    uint32_t clusterUploadBytes_ = 0;        ///< ワーカーが書き込んだクラスター分割の結果のバイト数
+
+    // クラスター分割の結果（フレームごと、永続マップ）
+    Microsoft::WRL::ComPtr<ID3D12Resource> clusterRangesBuffers_[kFrameCount];
+    Microsoft::WRL::ComPtr<ID3D12Resource> lightIndicesBuffers_[kFrameCount];
+    LightClusterRange* mappedClusterRanges_[kFrameCount] = {};
+    uint32_t* mappedLightIndices_[kFrameCount] = {};
+    uint32_t frameIndex_ = 0;
+
+    // クラスター分割（ワーカースレッドで実行）
+    LightClusterBinning clusterBinning_;
+    LightClusterBinning::Statistics clusterStatistics_;
+    LightClusterView clusterView_;
+    std::vector<PointLightData> pointLightSnapshot_;
+    std::vector<SpotLightData> spotLightSnapshot_;
+    std::thread clusterWorker_;
+    std::mutex clusterMutex_;
+    std::condition_variable clusterStartCondition_;
+    std::condition_variable clusterDoneCondition_;
+    bool clusterRequested_ = false;
+    bool clusterPending_ = false;
+    bool clusterExit_ = false;
 
     // デバイスとリソースファクトリの保持
     ID3D12Device* device_ = nullptr;
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/// @brief ライト配列の差分転送（D3D12に依存しない）
+/// @details 前回見たライトの内容を保持しておき、Detect で変わったライトに全フレーム分のダーティビットを立てる。
+/// Upload はそのフレームのビットが立っている連続範囲だけを書き込み先にコピーする。
+/// Add*Light が返すポインタ経由の書き換えも比較で検出できるので、呼び出し側で変更を通知する必要はない。
+/// @tparam T ライトのデータ構造体（トリビアルコピー可能であること）
+/// @tparam FrameCount 書き込み先のバッファ数（フレーム数）
+template<typename T, uint32_t FrameCount>
+class LightUploadTracker {
+    static_assert(FrameCount <= 8, "ダーティビットは8フレームまで");
+
+public:
+    /// @brief 1回の転送結果
+    struct UploadResult {
+        uint32_t bytes = 0;      ///< コピーしたバイト数
+        uint32_t lightCount = 0; ///< コピーしたライト数
+        uint32_t rangeCount = 0; ///< memcpy の回数（連続範囲の数）
+    };
+
+    /// @brief 変更されたライトを検出してダーティビットを立てる
+    /// @param lights 現在のライト配列
+    /// @return 新たに変更されたライト数
+    uint32_t Detect(const std::vector<T>& lights)
+    {
+        // 増えた分は全フレームで未転送
+        if (shadow_.size() < lights.size()) {
+            dirty_.resize(lights.size(), kAllFrames);
+        } else {
+            dirty_.resize(lights.size());
+        }
+        size_t knownCount = (std::min)(shadow_.size(), lights.size());
+        shadow_.resize(lights.size());
+
+        uint32_t changed = 0;
+        for (size_t i = 0; i < lights.size(); ++i) {
+            if (i >= knownCount || std::memcmp(&shadow_[i], &lights[i], sizeof(T)) != 0) {
+                shadow_[i] = lights[i];
+                dirty_[i] = kAllFrames;
+                ++changed;
+            }
+        }
+        return changed;
+    }
+
+    /// @brief 指定フレームの書き込み先へ、変更された範囲だけをコピー
+    /// @param frameIndex フレーム番号
+    /// @param destination そのフレームの書き込み先（永続マップしたバッファなど）
+    UploadResult Upload(uint32_t frameIndex, T* destination)
+    {
+        UploadResult result;
+        const uint8_t frameBit = static_cast<uint8_t>(1u << frameIndex);
+        size_t i = 0;
+        while (i < dirty_.size()) {
+            if ((dirty_[i] & frameBit) == 0) {
+                ++i;
+                continue;
+            }
+            size_t begin = i;
+            while (i < dirty_.size() && (dirty_[i] & frameBit) != 0) {
+                dirty_[i] &= static_cast<uint8_t>(~frameBit);
+                ++i;
+            }
+            size_t count = i - begin;
+            std::memcpy(destination + begin, &shadow_[begin], sizeof(T) * count);
+            result.bytes += static_cast<uint32_t>(sizeof(T) * count);
+            result.lightCount += static_cast<uint32_t>(count);
+            ++result.rangeCount;
+        }
+        return result;
+    }
+
+    /// @brief 指定したライトを全フレームで再転送させる
+    void MarkDirty(size_t index)
+    {
+        if (index < dirty_.size()) {
+            dirty_[index] = kAllFrames;
+        }
+    }
+
+    /// @brief 記録を破棄（次の Detect で全ライトが変更扱いになる）
+    void Reset()
+    {
+        shadow_.clear();
+        dirty_.clear();
+    }
+
+private:
+    static constexpr uint8_t kAllFrames = static_cast<uint8_t>((1u << FrameCount) - 1);
+
+    std::vector<T> shadow_;     ///< 最後に検出したライトの内容
+    std::vector<uint8_t> dirty_; ///< ライトごとの未転送フレームのビット
+};
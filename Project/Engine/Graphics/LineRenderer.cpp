@@ -1,5 +1,6 @@
 #include "LineRenderer.h"
 
+#include <algorithm>
 #include <cassert>
 
 #include "Engine/Graphics/Resource/ResourceFactory.h"
@@ -8,37 +9,26 @@
 
 using namespace MathCore;
 
+namespace {
+    /// @brief 定数バッファの配置単位
+    constexpr uint32_t kConstantBufferAlignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT;
+    constexpr uint32_t kViewStride = (sizeof(Matrix4x4) + kConstantBufferAlignment - 1) & ~(kConstantBufferAlignment - 1);
+}
+
 void LineRenderer::Initialize(ID3D12Device* device)
 {
-    uint32_t bufferSize = static_cast<uint32_t>(sizeof(LineVertex) * maxVertexCount_);
-
-    // 頂点バッファ作成
-    D3D12_HEAP_PROPERTIES heapProp = { D3D12_HEAP_TYPE_UPLOAD };
-    D3D12_RESOURCE_DESC resDesc = {};
-    resDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-    resDesc.Width = bufferSize;
-    resDesc.Height = 1;
-    resDesc.DepthOrArraySize = 1;
-    resDesc.MipLevels = 1;
-    resDesc.SampleDesc.Count = 1;
-    resDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-
-    device->CreateCommittedResource(
-        &heapProp,
-        D3D12_HEAP_FLAG_NONE,
-        &resDesc,
-        D3D12_RESOURCE_STATE_GENERIC_READ,
-        nullptr,
-        IID_PPV_ARGS(&vertexBuffer_));
-
-    // 定数バッファ作成
-    wvpBuffer_ = ResourceFactory::CreateBufferResource(device, sizeof(Matrix4x4));
-    wvpBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&wvpData_));
-
-    // 頂点バッファビューの設定
-    vbView_.BufferLocation = vertexBuffer_->GetGPUVirtualAddress();
-    vbView_.SizeInBytes = bufferSize;
-    vbView_.StrideInBytes = sizeof(LineVertex);
+    device_ = device;
+
+    // フレームごとの頂点バッファとビュー・プロジェクション行列のバッファを作成
+    for (UINT frameIndex = 0; frameIndex < kFrameCount; ++frameIndex) {
+        currentFrameIndex_ = frameIndex;
+        EnsureVertexCapacity();
+
+        wvpBuffers_[frameIndex] = ResourceFactory::CreateBufferResource(device, kViewStride * kMaxViewsPerFrame);
+        wvpBuffers_[frameIndex]->Map(0, nullptr, reinterpret_cast<void**>(&wvpData_[frameIndex]));
+    }
+    currentFrameIndex_ = 0;
+    batch_.Begin(mappedVertices_[0], vertexCapacity_[0]);
 
     // シェーダーのコンパイル（Lineシェーダーを使用）
     ShaderCompiler compiler;
@@ -77,126 +67,91 @@ void LineRenderer::Initialize(ID3D12Device* device)
     pipelineState_ = psoManager_.GetPipelineState(BlendMode::kBlendModeNormal);
 }
 
-void LineRenderer::Draw(ID3D12GraphicsCommandList* cmdList, const Matrix4x4& view, const Matrix4x4& proj, const std::vector<Line>& lines)
+void LineRenderer::EnsureVertexCapacity()
 {
-    if (lines.empty()) {
+    if (vertexCapacity_[currentFrameIndex_] >= maxVertexCount_) {
         return;
     }
 
-    // 頂点データの更新
-    UpdateVertexBuffer(lines);
-
-    // 描画の前処理
-    PreDraw(cmdList, view, proj);
-
-    // 描画実行
-    cmdList->DrawInstanced(static_cast<UINT>(vertices_.size()), 1, 0, 0);
+    // このフレームのバッファを前回使ったコマンドは完了しているので、そのまま作り直す
+    auto& buffer = vertexBuffers_[currentFrameIndex_];
+    buffer = ResourceFactory::CreateBufferResource(device_, sizeof(LineVertex) * maxVertexCount_);
+    buffer->Map(0, nullptr, reinterpret_cast<void**>(&mappedVertices_[currentFrameIndex_]));
+    vertexCapacity_[currentFrameIndex_] = maxVertexCount_;
 }
 
-void LineRenderer::DrawLine(ID3D12GraphicsCommandList* cmdList, const Matrix4x4& view, const Matrix4x4& proj, const Line& line)
+void LineRenderer::BeginFrame(UINT frameIndex)
 {
-    std::vector<Line> singleLine = { line };
-    Draw(cmdList, view, proj, singleLine);
-}
+    lastStatistics_.vertexCount = batch_.GetVertexCount();
+    lastStatistics_.droppedLineCount = batch_.GetDroppedLineCount();
+    lastStatistics_.drawCallCount = drawCallCount_;
+    lastStatistics_.vertexCapacity = vertexCapacity_[currentFrameIndex_];
+
+    // 前フレームで溢れた分が収まるまで容量を倍にする
+    uint64_t required = static_cast<uint64_t>(batch_.GetVertexCount()) + static_cast<uint64_t>(batch_.GetDroppedLineCount()) * 2;
+    while (maxVertexCount_ < required && maxVertexCount_ < (1u << 30)) {
+        maxVertexCount_ *= 2;
+    }
 
-void LineRenderer::DrawSphere(ID3D12GraphicsCommandList* cmdList, const Matrix4x4& view, const Matrix4x4& proj, 
-    const Vector3& center, float radius, const Vector3& color, float alpha, int segments)
-{
-std::vector<Line> lines;
+    currentFrameIndex_ = frameIndex % kFrameCount;
+    EnsureVertexCapacity();
 
-// 緯度線を描画（複数の水平円）
-    for (int lat = 0; lat <= segments; ++lat) {
-        float theta = (static_cast<float>(lat) / segments) * std::numbers::pi_v<float>;
-   float sinTheta = std::sin(theta);
-        float cosTheta = std::cos(theta);
-    
-        for (int lon = 0; lon < segments; ++lon) {
-            float phi1 = (static_cast<float>(lon) / segments) * 2.0f * std::numbers::pi_v<float>;
-     float phi2 = (static_cast<float>(lon + 1) / segments) * 2.0f * std::numbers::pi_v<float>;
-            
-    float sinPhi1 = std::sin(phi1);
-            float cosPhi1 = std::cos(phi1);
-       float sinPhi2 = std::sin(phi2);
-        float cosPhi2 = std::cos(phi2);
-            
-            Vector3 p1 = {
-          center.x + radius * sinTheta * cosPhi1,
-                center.y + radius * cosTheta,
-         center.z + radius * sinTheta * sinPhi1
-  };
-            
-            Vector3 p2 = {
-     center.x + radius * sinTheta * cosPhi2,
-                center.y + radius * cosTheta,
- center.z + radius * sinTheta * sinPhi2
-            };
-            
-lines.push_back({ p1, p2, color, alpha });
-}
-    }
-    
-    // 経度線を描画（縦の線）
-    for (int lon = 0; lon < segments; ++lon) {
-        float phi = (static_cast<float>(lon) / segments) * 2.0f * std::numbers::pi_v<float>;
-        float sinPhi = std::sin(phi);
-  float cosPhi = std::cos(phi);
-        
-        for (int lat = 0; lat < segments; ++lat) {
-            float theta1 = (static_cast<float>(lat) / segments) * std::numbers::pi_v<float>;
-  float theta2 = (static_cast<float>(lat + 1) / segments) * std::numbers::pi_v<float>;
-       
-float sinTheta1 = std::sin(theta1);
-        float cosTheta1 = std::cos(theta1);
-   float sinTheta2 = std::sin(theta2);
-     float cosTheta2 = std::cos(theta2);
-     
-            Vector3 p1 = {
-                center.x + radius * sinTheta1 * cosPhi,
-    center.y + radius * cosTheta1,
-            center.z + radius * sinTheta1 * sinPhi
-            };
-            
-  Vector3 p2 = {
-     center.x + radius * sinTheta2 * cosPhi,
- center.y + radius * cosTheta2,
-              center.z + radius * sinTheta2 * sinPhi
-};
-            
-     lines.push_back({ p1, p2, color, alpha });
-     }
-    }
-    
-    Draw(cmdList, view, proj, lines);
+    batch_.Begin(mappedVertices_[currentFrameIndex_], vertexCapacity_[currentFrameIndex_]);
+    renderedVertexCount_ = 0;
+    viewCount_ = 0;
+    drawCallCount_ = 0;
 }
 
-void LineRenderer::PreDraw(ID3D12GraphicsCommandList* cmdList, const Matrix4x4& view, const Matrix4x4& proj)
+void LineRenderer::Render(ID3D12GraphicsCommandList* cmdList, const Matrix4x4& view, const Matrix4x4& proj)
 {
-    // ビュープロジェクション行列の更新
-    *wvpData_ = Matrix::Multiply(view, proj);
+    const uint32_t vertexCount = batch_.GetVertexCount() - renderedVertexCount_;
+    if (vertexCount == 0 || viewCount_ >= kMaxViewsPerFrame) {
+        return;
+    }
+
+    // ビュープロジェクション行列の更新（記録済みの描画が参照する行列は上書きしない）
+    const uint32_t viewOffset = kViewStride * viewCount_++;
+    *reinterpret_cast<Matrix4x4*>(wvpData_[currentFrameIndex_] + viewOffset) = Matrix::Multiply(view, proj);
+
+    D3D12_VERTEX_BUFFER_VIEW vbView{};
+    vbView.BufferLocation = vertexBuffers_[currentFrameIndex_]->GetGPUVirtualAddress();
+    vbView.SizeInBytes = static_cast<UINT>(sizeof(LineVertex) * vertexCapacity_[currentFrameIndex_]);
+    vbView.StrideInBytes = sizeof(LineVertex);
 
     // パイプラインの設定
     cmdList->SetGraphicsRootSignature(rootSignature_.Get());
     cmdList->SetPipelineState(pipelineState_.Get());
     cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
-    cmdList->IASetVertexBuffers(0, 1, &vbView_);
-    cmdList->SetGraphicsRootConstantBufferView(0, wvpBuffer_->GetGPUVirtualAddress());
+    cmdList->IASetVertexBuffers(0, 1, &vbView);
+    cmdList->SetGraphicsRootConstantBufferView(0, wvpBuffers_[currentFrameIndex_]->GetGPUVirtualAddress() + viewOffset);
+
+    // 前回の描画以降に追加した範囲だけを描画
+    cmdList->DrawInstanced(vertexCount, 1, renderedVertexCount_, 0);
+    renderedVertexCount_ += vertexCount;
+    ++drawCallCount_;
 }
 
-void LineRenderer::UpdateVertexBuffer(const std::vector<Line>& lines)
+void LineRenderer::Draw(ID3D12GraphicsCommandList* cmdList, const Matrix4x4& view, const Matrix4x4& proj, const std::vector<Line>& lines)
 {
-    vertices_.clear();
-
-    // ラインを頂点データに変換
-    for (const auto& line : lines) {
-        vertices_.push_back({ line.start, line.color, line.alpha });
-        vertices_.push_back({ line.end, line.color, line.alpha });
+    if (lines.empty()) {
+        return;
     }
 
-    // 頂点バッファの更新
-    uint32_t sizeInBytes = static_cast<uint32_t>(sizeof(LineVertex) * vertices_.size());
-    void* map = nullptr;
-    vertexBuffer_->Map(0, nullptr, &map);
-    memcpy(map, vertices_.data(), sizeInBytes);
-    vertexBuffer_->Unmap(0, nullptr);
-    vbView_.SizeInBytes = sizeInBytes;
-}
\ No newline at end of file
+    batch_.AddLines(lines);
+    Render(cmdList, view, proj);
+}
+
+void LineRenderer::DrawLine(ID3D12GraphicsCommandList* cmdList, const Matrix4x4& view, const Matrix4x4& proj, const Line& line)
+{
+    batch_.AddLine(line.start, line.end, line.color, line.alpha);
+    Render(cmdList, view, proj);
+}
+
+void LineRenderer::DrawSphere(ID3D12GraphicsCommandList* cmdList, const Matrix4x4& view, const Matrix4x4& proj,
+    const Vector3& center, float radius, const Vector3& color, float alpha, int segments)
+{
+    // 分割数ごとにキャッシュした単位球を拡大・移動して書き込む
+    Matrix4x4 world = Matrix::MakeAffine({ radius, radius, radius }, { 0.0f, 0.0f, 0.0f }, center);
+    batch_.AddTemplate(DebugLineBatch::GetUnitSphereGrid(static_cast<uint32_t>((std::max)(segments, 1))), world, color, alpha);
+    Render(cmdList, view, proj);
+}
@@ -6,28 +6,50 @@
 
 #include "Engine/Graphics/PipelineStateManager.h"
 #include "Engine/Graphics/RootSignatureManager.h"
+#include "Engine/Graphics/DebugLineBatch.h"
 #include "Math/Vector/Vector3.h"
 #include "MathCore.h"
 
+/// @brief デバッグ線の描画
+/// @details フレーム中に GetBatch() へ追加した線は、フレームごとの永続マップした頂点バッファへ直接書き込まれ、
+/// Render でまとめて1回の描画で発行される。Draw / DrawLine / DrawSphere も同じバッファに追記してから描画するため、
+/// 同じフレーム内で複数回呼んでも互いの頂点を上書きしない。
 class LineRenderer {
 public:
-    struct LineVertex {
-        Vector3 position;
-        Vector3 color;
-        float alpha;
-    };
+    using LineVertex = DebugLineVertex;
+    using Line = DebugLine;
+
+    /// @brief フレーム数（ダブルバッファリング）
+    static constexpr UINT kFrameCount = 2;
 
-    struct Line {
-        Vector3 start;
-        Vector3 end;
-        Vector3 color;
-        float alpha;
+    /// @brief 1フレームで Render できる回数（ビュー・プロジェクション行列の数）
+    static constexpr uint32_t kMaxViewsPerFrame = 16;
+
+    /// @brief 描画の統計
+    struct Statistics {
+        uint32_t vertexCount = 0;      ///< 書き込んだ頂点数
+        uint32_t droppedLineCount = 0; ///< 容量不足で描画できなかった線の数
+        uint32_t drawCallCount = 0;    ///< 発行した描画コマンド数
+        uint32_t vertexCapacity = 0;   ///< 頂点バッファの容量
     };
 
     /// @brief ラインレンダラーの初期化
     /// @param device DirectX12デバイス
     void Initialize(ID3D12Device* device);
 
+    /// @brief フレームの開始（頂点バッファを今フレームのものに切り替える）
+    /// @param frameIndex バックバッファのインデックス
+    void BeginFrame(UINT frameIndex);
+
+    /// @brief 今フレームの線の追加先
+    DebugLineBatch& GetBatch() { return batch_; }
+
+    /// @brief 前回の Render 以降に追加された線をまとめて描画
+    /// @param cmdList コマンドリスト
+    /// @param view ビュー行列
+    /// @param proj プロジェクション行列
+    void Render(ID3D12GraphicsCommandList* cmdList, const Matrix4x4& view, const Matrix4x4& proj);
+
     /// @brief ラインの描画
     /// @param cmdList コマンドリスト
     /// @param view ビュー行列
@@ -51,36 +73,43 @@ public:
     /// @param color ラインの色
     /// @param alpha ラインの透明度
     /// @param segments 分割数（デフォルト16）
-    void DrawSphere(ID3D12GraphicsCommandList* cmdList, const Matrix4x4& view, const Matrix4x4& proj, 
-         const Vector3& center, float radius, const Vector3& color = {1.0f, 1.0f, 1.0f}, 
+    void DrawSphere(ID3D12GraphicsCommandList* cmdList, const Matrix4x4& view, const Matrix4x4& proj,
+         const Vector3& center, float radius, const Vector3& color = {1.0f, 1.0f, 1.0f},
          float alpha = 1.0f, int segments = 16);
 
-private:
-    /// @brief 描画の前処理
-    /// @param cmdList コマンドリスト
-    /// @param view ビュー行列
-    /// @param proj プロジェクション行列
-    void PreDraw(ID3D12GraphicsCommandList* cmdList, const Matrix4x4& view, const Matrix4x4& proj);
+    /// @brief 前フレームの統計を取得
+    const Statistics& GetStatistics() const { return lastStatistics_; }
 
-    /// @brief 頂点データの更新
-    /// @param lines ライン配列
-    void UpdateVertexBuffer(const std::vector<Line>& lines);
+private:
+    /// @brief 今フレームの頂点バッファを必要な容量で作り直す
+    void EnsureVertexCapacity();
 
 private:
     PipelineStateManager psoManager_;
     RootSignatureManager rsManager_;
+    ID3D12Device* device_ = nullptr;
+
+    // ビュー・プロジェクション行列のバッファ（フレームごと、Render 1回につき1要素）
+    Microsoft::WRL::ComPtr<ID3D12Resource> wvpBuffers_[kFrameCount];
+    uint8_t* wvpData_[kFrameCount] = {};
+    uint32_t viewCount_ = 0;
+
+    // 頂点バッファ（フレームごと、永続マップ）
+    Microsoft::WRL::ComPtr<ID3D12Resource> vertexBuffers_[kFrameCount];
+    LineVertex* mappedVertices_[kFrameCount] = {};
+    uint32_t vertexCapacity_[kFrameCount] = {};
+    uint32_t maxVertexCount_ = 65536; // 1フレームの最大頂点数（足りなければ次のフレームから拡張）
 
-    // ワールド・ビュー・プロジェクション行列のバッファ
-    Microsoft::WRL::ComPtr<ID3D12Resource> wvpBuffer_;
-    Matrix4x4* wvpData_ = nullptr;
+    // 今フレームの書き込み
+    DebugLineBatch batch_;
+    UINT currentFrameIndex_ = 0;
+    uint32_t renderedVertexCount_ = 0; ///< 描画済みの頂点数
 
-    // 頂点バッファ
-    std::vector<LineVertex> vertices_;
-    Microsoft::WRL::ComPtr<ID3D12Resource> vertexBuffer_;
-    D3D12_VERTEX_BUFFER_VIEW vbView_{};
-    uint32_t maxVertexCount_ = 65536; // デフォルトの最大頂点数
+    // 統計
+    uint32_t drawCallCount_ = 0;
+    Statistics lastStatistics_;
 
     // PSOとルートシグネチャ
     Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState_;
     Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
-};
\ No newline at end of file
+};
@@ -0,0 +1,63 @@
+#include "MeshLod.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace MeshLodSelector {
+
+    float ComputeScreenScale(const Matrix4x4& world, const Matrix4x4& projection, const Vector3& cameraPosition)
+    {
+        // 行ベクトルなので各行の長さが各軸の拡大率
+        float maxScaleSq = 0.0f;
+        for (int row = 0; row < 3; ++row) {
+            float lengthSq = world.m[row][0] * world.m[row][0] + world.m[row][1] * world.m[row][1] + world.m[row][2] * world.m[row][2];
+            maxScaleSq = (std::max)(maxScaleSq, lengthSq);
+        }
+        const float scale = std::sqrt(maxScaleSq);
+
+        // 正射影は距離によらない（NDCの高さ2に対する割合）
+        if (projection.m[2][3] == 0.0f) {
+            return scale * projection.m[1][1] * 0.5f;
+        }
+
+        const float dx = world.m[3][0] - cameraPosition.x;
+        const float dy = world.m[3][1] - cameraPosition.y;
+        const float dz = world.m[3][2] - cameraPosition.z;
+        const float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (distance <= FLT_EPSILON) {
+            return FLT_MAX;
+        }
+        return scale * projection.m[1][1] * 0.5f / distance;
+    }
+
+    uint32_t Select(const std::vector<MeshLod>& lods, float screenScale, uint32_t currentLod, const MeshLodSettings& settings)
+    {
+        if (!settings.enabled || lods.size() <= 1) {
+            return 0;
+        }
+        const uint32_t lastLod = static_cast<uint32_t>(lods.size() - 1);
+        currentLod = (std::min)(currentLod, lastLod);
+
+        auto projectedError = [&](uint32_t lod) { return lods[lod].error * screenScale; };
+        const float coarsenThreshold = settings.errorThreshold * (1.0f - settings.hysteresis);
+        const float refineThreshold = settings.errorThreshold * (1.0f + settings.hysteresis);
+
+        // 余裕を持って閾値に収まる、より粗いLODがあれば切り替える
+        for (uint32_t lod = lastLod; lod > currentLod; --lod) {
+            if (projectedError(lod) <= coarsenThreshold) {
+                return lod;
+            }
+        }
+
+        // 今のLODが閾値を大きく超えたら、閾値に収まるLODまで戻す
+        if (projectedError(currentLod) > refineThreshold) {
+            uint32_t lod = currentLod;
+            while (lod > 0 && projectedError(lod) > settings.errorThreshold) {
+                --lod;
+            }
+            return lod;
+        }
+        return currentLod;
+    }
+}
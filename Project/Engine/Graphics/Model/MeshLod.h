@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Math/MathCore.h"
+
+/// @brief GPUに置いたLOD（全LODで1つのインデックスバッファと頂点バッファを共有する）
+struct MeshLod {
+    uint32_t startIndex = 0; ///< インデックスバッファ内の開始位置
+    uint32_t indexCount = 0; ///< インデックス数
+    float error = 0.0f;      ///< LOD0からの誤差（モデル空間の距離）
+};
+
+/// @brief LODの選び方（全Model共通）
+struct MeshLodSettings {
+    bool enabled = true;
+    float errorThreshold = 0.001f; ///< 許容する画面上の誤差（画面の高さに対する割合、1080pで約1ピクセル）
+    float hysteresis = 0.25f;      ///< 閾値の前後この割合の間は今のLODを保つ（境目でのちらつきを防ぐ）
+};
+
+/// @brief 画面上の大きさによるLODの選択（D3D12に依存しない）
+/// @details LODの誤差を画面上の大きさに換算し、閾値に収まる最も粗いLODを選ぶ。
+/// 粗くするときは閾値より小さく、細かくするときは閾値より大きくなるまで切り替えないので、
+/// 境目の距離で止まっていてもLODが毎フレーム入れ替わらない。
+namespace MeshLodSelector {
+
+    /// @brief モデル空間の長さ1が画面の高さに対して占める割合
+    /// @param world ワールド行列（原点の位置と最大の拡大率を使う）
+    /// @param projection 射影行列
+    /// @param cameraPosition カメラの位置
+    /// @return 割合（カメラが原点に重なる場合は非常に大きな値）
+    float ComputeScreenScale(const Matrix4x4& world, const Matrix4x4& projection, const Vector3& cameraPosition);
+
+    /// @brief 次に描くLODを選ぶ
+    /// @param lods LOD（粗くなる順、誤差は単調増加）
+    /// @param screenScale ComputeScreenScale の結果
+    /// @param currentLod 今のLOD
+    /// @param settings 選び方
+    /// @return LODの番号
+    uint32_t Select(const std::vector<MeshLod>& lods, float screenScale, uint32_t currentLod, const MeshLodSettings& settings);
+}
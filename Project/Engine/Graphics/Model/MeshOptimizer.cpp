@@ -0,0 +1,540 @@
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "Engine/Graphics/Shader/ShaderCacheFormat.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+
+namespace MeshOptimizer {
+
+    namespace {
+        constexpr uint32_t kUnused = UINT32_MAX;
+
+        /// @brief 結合の判定に使う頂点の内容（-0 は +0 として扱う）
+        struct VertexBits {
+            uint32_t values[9] = {};
+
+            bool operator==(const VertexBits& other) const
+            {
+                return std::memcmp(values, other.values, sizeof(values)) == 0;
+            }
+        };
+
+        uint32_t ToBits(float value)
+        {
+            if (value == 0.0f) {
+                value = 0.0f;
+            }
+            uint32_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        VertexBits MakeVertexBits(const VertexData& vertex)
+        {
+            VertexBits bits;
+            const float values[9] = {
+                vertex.position.x, vertex.position.y, vertex.position.z, vertex.position.w,
+                vertex.texcoord.x, vertex.texcoord.y,
+                vertex.normal.x, vertex.normal.y, vertex.normal.z,
+            };
+            for (size_t i = 0; i < 9; ++i) {
+                bits.values[i] = ToBits(values[i]);
+            }
+            return bits;
+        }
+
+        /// @brief 頂点ごとのウェイト（ジョイントの番号とウェイトのビット、ジョイント順）
+        using Influences = std::vector<std::pair<uint32_t, uint32_t>>;
+
+        std::vector<Influences> CollectInfluences(size_t vertexCount, const std::map<std::string, JointWeightData>& skinClusters)
+        {
+            std::vector<Influences> influences(skinClusters.empty() ? 0 : vertexCount);
+            uint32_t jointIndex = 0;
+            for (const auto& [name, joint] : skinClusters) {
+                for (const VertexWeightData& weight : joint.vertexWeights) {
+                    if (weight.vertexIndex < vertexCount) {
+                        influences[weight.vertexIndex].emplace_back(jointIndex, ToBits(weight.weight));
+                    }
+                }
+                ++jointIndex;
+            }
+            for (Influences& list : influences) {
+                std::sort(list.begin(), list.end());
+            }
+            return influences;
+        }
+
+        /// @brief 頂点を付け替える
+        /// @param remap 旧番号 -> 新番号（kUnused なら削除）
+        /// @param newCount 新しい頂点数
+        void RemapVertices(std::vector<VertexData>& vertices, std::vector<uint32_t>& indices,
+            std::map<std::string, JointWeightData>& skinClusters, const std::vector<uint32_t>& remap, uint32_t newCount)
+        {
+            std::vector<VertexData> remapped(newCount);
+            for (size_t i = 0; i < vertices.size(); ++i) {
+                if (remap[i] != kUnused) {
+                    remapped[remap[i]] = vertices[i];
+                }
+            }
+            vertices = std::move(remapped);
+
+            for (uint32_t& index : indices) {
+                index = remap[index];
+            }
+
+            // 結合した頂点は同じウェイトを持つので、ジョイントごとに1つだけ残す
+            std::vector<uint8_t> seen(newCount);
+            for (auto& [name, joint] : skinClusters) {
+                std::fill(seen.begin(), seen.end(), uint8_t(0));
+                std::vector<VertexWeightData> weights;
+                weights.reserve(joint.vertexWeights.size());
+                for (const VertexWeightData& weight : joint.vertexWeights) {
+                    if (weight.vertexIndex >= remap.size() || remap[weight.vertexIndex] == kUnused) {
+                        continue;
+                    }
+                    uint32_t newIndex = remap[weight.vertexIndex];
+                    if (!seen[newIndex]) {
+                        seen[newIndex] = 1;
+                        weights.push_back({ weight.weight, newIndex });
+                    }
+                }
+                joint.vertexWeights = std::move(weights);
+            }
+        }
+
+        struct Float3 {
+            double x = 0.0, y = 0.0, z = 0.0;
+        };
+
+        Float3 GetPosition(const std::vector<VertexData>& vertices, uint32_t index)
+        {
+            const VertexData& vertex = vertices[index];
+            return { vertex.position.x, vertex.position.y, vertex.position.z };
+        }
+    }
+
+    uint32_t WeldVertices(std::vector<VertexData>& vertices, std::vector<uint32_t>& indices,
+        std::map<std::string, JointWeightData>& skinClusters)
+    {
+        const size_t vertexCount = vertices.size();
+        std::vector<Influences> influences = CollectInfluences(vertexCount, skinClusters);
+
+        // ハッシュ -> 最初の代表頂点（衝突は chain でたどる）
+        std::unordered_map<uint64_t, uint32_t> buckets;
+        buckets.reserve(vertexCount);
+        std::vector<uint32_t> chain;           // 代表頂点ごとの次の候補
+        std::vector<uint32_t> representatives; // 新番号 -> 代表の旧番号
+        std::vector<VertexBits> representativeBits;
+        std::vector<uint32_t> remap(vertexCount, kUnused);
+
+        for (uint32_t i = 0; i < vertexCount; ++i) {
+            VertexBits bits = MakeVertexBits(vertices[i]);
+            uint64_t hash = ShaderCacheFormat::HashBytes(bits.values, sizeof(bits.values));
+            if (!influences.empty() && !influences[i].empty()) {
+                hash = ShaderCacheFormat::HashBytes(influences[i].data(), influences[i].size() * sizeof(Influences::value_type), hash);
+            }
+
+            auto [it, inserted] = buckets.try_emplace(hash, static_cast<uint32_t>(representatives.size()));
+            if (!inserted) {
+                uint32_t candidate = it->second;
+                while (candidate != kUnused) {
+                    uint32_t source = representatives[candidate];
+                    if (representativeBits[candidate] == bits &&
+                        (influences.empty() || influences[source] == influences[i])) {
+                        remap[i] = candidate;
+                        break;
+                    }
+                    if (chain[candidate] == kUnused) {
+                        chain[candidate] = static_cast<uint32_t>(representatives.size());
+                        candidate = kUnused;
+                    } else {
+                        candidate = chain[candidate];
+                    }
+                }
+                if (remap[i] != kUnused) {
+                    continue;
+                }
+            }
+
+            remap[i] = static_cast<uint32_t>(representatives.size());
+            representatives.push_back(i);
+            representativeBits.push_back(bits);
+            chain.push_back(kUnused);
+        }
+
+        const uint32_t newCount = static_cast<uint32_t>(representatives.size());
+        const uint32_t removed = static_cast<uint32_t>(vertexCount) - newCount;
+        if (removed > 0) {
+            RemapVertices(vertices, indices, skinClusters, remap, newCount);
+        }
+        return removed;
+    }
+
+    void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize,
+        std::vector<uint32_t>* outClusters, float clusterThreshold)
+    {
+        const size_t triangleCount = indices.size() / 3;
+        if (outClusters) {
+            outClusters->clear();
+        }
+        if (triangleCount == 0 || vertexCount == 0) {
+            return;
+        }
+
+        // 頂点 -> 使っている三角形
+        std::vector<uint32_t> liveCount(vertexCount, 0);
+        for (size_t i = 0; i < triangleCount * 3; ++i) {
+            ++liveCount[indices[i]];
+        }
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+        for (size_t v = 0; v < vertexCount; ++v) {
+            adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveCount[v];
+        }
+        std::vector<uint32_t> adjacency(adjacencyOffsets.back());
+        {
+            std::vector<uint32_t> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (size_t i = 0; i < triangleCount * 3; ++i) {
+                adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+            }
+        }
+
+        // 頂点がキャッシュに入った時刻（timeStamp - cacheTime <= cacheSize ならキャッシュ内）
+        std::vector<uint32_t> cacheTime(vertexCount, 0);
+        uint32_t timeStamp = cacheSize + 1;
+        std::vector<uint8_t> emitted(triangleCount, 0);
+        std::vector<uint32_t> deadEnd;
+        std::vector<uint32_t> candidates;
+
+        std::vector<uint32_t> output;
+        output.reserve(triangleCount * 3);
+        // クラスタの分割に使う情報（出力順の三角形ごと）
+        std::vector<uint8_t> triangleMisses;
+        std::vector<uint8_t> fanStart;  // ファンの先頭（分割してよい位置）
+        std::vector<uint8_t> hardStart; // 前と連続しない位置（必ず分割する）
+        triangleMisses.reserve(triangleCount);
+        fanStart.reserve(triangleCount);
+        hardStart.reserve(triangleCount);
+
+        uint32_t fanning = 0;
+        size_t scanCursor = 1;
+        bool jumped = true;
+        while (fanning != kUnused) {
+            candidates.clear();
+            bool firstInFan = true;
+            for (uint32_t a = adjacencyOffsets[fanning]; a < adjacencyOffsets[fanning + 1]; ++a) {
+                uint32_t triangle = adjacency[a];
+                if (emitted[triangle]) {
+                    continue;
+                }
+                emitted[triangle] = 1;
+
+                uint8_t misses = 0;
+                for (size_t corner = 0; corner < 3; ++corner) {
+                    uint32_t v = indices[triangle * 3 + corner];
+                    output.push_back(v);
+                    deadEnd.push_back(v);
+                    candidates.push_back(v);
+                    --liveCount[v];
+                    if (timeStamp - cacheTime[v] > cacheSize) {
+                        cacheTime[v] = timeStamp++;
+                        ++misses;
+                    }
+                }
+                triangleMisses.push_back(misses);
+                fanStart.push_back(firstInFan ? 1 : 0);
+                hardStart.push_back(firstInFan && jumped ? 1 : 0);
+                firstInFan = false;
+            }
+
+            // 次のファンの中心：キャッシュに残っていて、残りの三角形を出し切れる頂点のうち最も古いもの
+            uint32_t next = kUnused;
+            int64_t bestPriority = -1;
+            for (uint32_t v : candidates) {
+                if (liveCount[v] == 0) {
+                    continue;
+                }
+                int64_t priority = 0;
+                if (timeStamp - cacheTime[v] + 2 * liveCount[v] <= cacheSize) {
+                    priority = timeStamp - cacheTime[v];
+                }
+                if (priority > bestPriority) {
+                    bestPriority = priority;
+                    next = v;
+                }
+            }
+
+            jumped = false;
+            if (next == kUnused) {
+                // 行き止まり：最近出力した頂点から探し、なければ未処理の頂点を先頭から探す
+                while (!deadEnd.empty()) {
+                    uint32_t v = deadEnd.back();
+                    deadEnd.pop_back();
+                    if (liveCount[v] > 0) {
+                        next = v;
+                        break;
+                    }
+                }
+                while (next == kUnused && scanCursor < vertexCount) {
+                    if (liveCount[scanCursor] > 0) {
+                        next = static_cast<uint32_t>(scanCursor);
+                    }
+                    ++scanCursor;
+                }
+                jumped = true;
+            }
+            fanning = next;
+        }
+
+        // 面を持たない頂点から始まった場合などに残った三角形（通常はない）
+        for (size_t triangle = 0; triangle < triangleCount; ++triangle) {
+            if (!emitted[triangle]) {
+                output.insert(output.end(), indices.begin() + triangle * 3, indices.begin() + triangle * 3 + 3);
+                triangleMisses.push_back(3);
+                fanStart.push_back(1);
+                hardStart.push_back(1);
+            }
+        }
+
+        std::copy(output.begin(), output.end(), indices.begin());
+
+        if (!outClusters) {
+            return;
+        }
+
+        // クラスタ：連続しない位置で必ず分け、さらにクラスタ内の ACMR が全体の許容倍率以下に下がったファンの境目で分ける。
+        // 並べ替えるとクラスタの先頭ではキャッシュが空になるので、クラスタ内の ACMR は空のキャッシュから数える
+        // （小さいクラスタほど先頭のミスの割合が大きく、分かれにくい）。
+        uint64_t totalMisses = 0;
+        for (uint8_t misses : triangleMisses) {
+            totalMisses += misses;
+        }
+        const double threshold = static_cast<double>(totalMisses) / static_cast<double>(triangleCount) * clusterThreshold;
+
+        std::fill(cacheTime.begin(), cacheTime.end(), 0);
+        timeStamp = cacheSize + 1;
+        uint32_t clusterStartTime = timeStamp;
+        uint64_t clusterMisses = 0;
+        uint64_t clusterTriangles = 0;
+        for (size_t triangle = 0; triangle < triangleCount; ++triangle) {
+            bool split = triangle == 0 || hardStart[triangle];
+            if (!split && fanStart[triangle] && clusterTriangles > 0 &&
+                static_cast<double>(clusterMisses) / static_cast<double>(clusterTriangles) <= threshold) {
+                split = true;
+            }
+            if (split) {
+                outClusters->push_back(static_cast<uint32_t>(triangle));
+                clusterStartTime = timeStamp;
+                clusterMisses = 0;
+                clusterTriangles = 0;
+            }
+            for (size_t corner = 0; corner < 3; ++corner) {
+                uint32_t v = indices[triangle * 3 + corner];
+                if (cacheTime[v] < clusterStartTime || timeStamp - cacheTime[v] > cacheSize) {
+                    cacheTime[v] = timeStamp++;
+                    ++clusterMisses;
+                }
+            }
+            ++clusterTriangles;
+        }
+    }
+
+    void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<VertexData>& vertices,
+        const std::vector<uint32_t>& clusters)
+    {
+        const size_t triangleCount = indices.size() / 3;
+        if (clusters.size() < 2) {
+            return;
+        }
+
+        struct Cluster {
+            uint32_t begin = 0;
+            uint32_t end = 0;
+            Float3 centroid; // 面積で重み付けした重心
+            Float3 normal;   // 面積で重み付けした法線の和
+            double area = 0.0;
+            double sortKey = 0.0;
+        };
+
+        std::vector<Cluster> list(clusters.size());
+        Float3 meshCentroid;
+        double meshArea = 0.0;
+        for (size_t c = 0; c < clusters.size(); ++c) {
+            Cluster& cluster = list[c];
+            cluster.begin = clusters[c];
+            cluster.end = (c + 1 < clusters.size()) ? clusters[c + 1] : static_cast<uint32_t>(triangleCount);
+
+            for (uint32_t triangle = cluster.begin; triangle < cluster.end; ++triangle) {
+                Float3 p0 = GetPosition(vertices, indices[triangle * 3 + 0]);
+                Float3 p1 = GetPosition(vertices, indices[triangle * 3 + 1]);
+                Float3 p2 = GetPosition(vertices, indices[triangle * 3 + 2]);
+                Float3 e1{ p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+                Float3 e2{ p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+                Float3 cross{ e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z, e1.x * e2.y - e1.y * e2.x };
+                double area = std::sqrt(cross.x * cross.x + cross.y * cross.y + cross.z * cross.z) * 0.5;
+
+                cluster.centroid.x += (p0.x + p1.x + p2.x) / 3.0 * area;
+                cluster.centroid.y += (p0.y + p1.y + p2.y) / 3.0 * area;
+                cluster.centroid.z += (p0.z + p1.z + p2.z) / 3.0 * area;
+                cluster.normal.x += cross.x;
+                cluster.normal.y += cross.y;
+                cluster.normal.z += cross.z;
+                cluster.area += area;
+            }
+
+            meshCentroid.x += cluster.centroid.x;
+            meshCentroid.y += cluster.centroid.y;
+            meshCentroid.z += cluster.centroid.z;
+            meshArea += cluster.area;
+            if (cluster.area > 0.0) {
+                cluster.centroid.x /= cluster.area;
+                cluster.centroid.y /= cluster.area;
+                cluster.centroid.z /= cluster.area;
+            }
+        }
+        if (meshArea <= 0.0) {
+            return;
+        }
+        meshCentroid.x /= meshArea;
+        meshCentroid.y /= meshArea;
+        meshCentroid.z /= meshArea;
+
+        // 外側を向いたクラスタほど他を隠しやすいので先に描く（視点に依存しない目安）
+        for (Cluster& cluster : list) {
+            double length = std::sqrt(cluster.normal.x * cluster.normal.x + cluster.normal.y * cluster.normal.y + cluster.normal.z * cluster.normal.z);
+            if (length > 0.0) {
+                cluster.sortKey = ((cluster.centroid.x - meshCentroid.x) * cluster.normal.x +
+                    (cluster.centroid.y - meshCentroid.y) * cluster.normal.y +
+                    (cluster.centroid.z - meshCentroid.z) * cluster.normal.z) / length;
+            }
+        }
+        std::stable_sort(list.begin(), list.end(), [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+
+        std::vector<uint32_t> output;
+        output.reserve(indices.size());
+        for (const Cluster& cluster : list) {
+            output.insert(output.end(), indices.begin() + cluster.begin * 3, indices.begin() + cluster.end * 3);
+        }
+        std::copy(output.begin(), output.end(), indices.begin());
+    }
+
+    void OptimizeVertexFetch(std::vector<VertexData>& vertices, std::vector<uint32_t>& indices,
+        std::map<std::string, JointWeightData>& skinClusters)
+    {
+        std::vector<uint32_t> remap(vertices.size(), kUnused);
+        uint32_t newCount = 0;
+        bool identity = true;
+        for (uint32_t index : indices) {
+            if (remap[index] == kUnused) {
+                identity = identity && index == newCount;
+                remap[index] = newCount++;
+            }
+        }
+        if (identity && newCount == vertices.size()) {
+            return;
+        }
+        RemapVertices(vertices, indices, skinClusters, remap, newCount);
+    }
+
+    float ComputeACMR(const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize)
+    {
+        const size_t triangleCount = indices.size() / 3;
+        if (triangleCount == 0) {
+            return 0.0f;
+        }
+
+        // FIFO：入った時刻が cacheSize 以内ならヒット
+        std::vector<uint64_t> insertedAt(vertexCount, 0);
+        uint64_t time = static_cast<uint64_t>(cacheSize) + 1;
+        uint64_t misses = 0;
+        for (size_t i = 0; i < triangleCount * 3; ++i) {
+            uint32_t v = indices[i];
+            if (time - insertedAt[v] > cacheSize) {
+                insertedAt[v] = time++;
+                ++misses;
+            }
+        }
+        return static_cast<float>(static_cast<double>(misses) / static_cast<double>(triangleCount));
+    }
+
+    std::vector<MeshLodData> GenerateLods(const std::vector<VertexData>& vertices, const std::vector<uint32_t>& indices,
+        const MeshOptimizeSettings& settings)
+    {
+        // これより三角形の少ないメッシュは頂点処理の負荷にならないので分けない
+        constexpr size_t kMinLodTriangleCount = 32;
+        // 残した三角形がこの割合より多ければ簡略化できなかったとみなす
+        constexpr float kMinReduction = 0.9f;
+
+        std::vector<MeshLodData> lods;
+        const std::vector<uint32_t>* previous = &indices;
+        float previousError = 0.0f;
+        for (uint32_t level = 1; level < settings.lodCount; ++level) {
+            const size_t previousCount = previous->size();
+            if (previousCount / 3 < kMinLodTriangleCount) {
+                break;
+            }
+
+            // 前の段から簡略化する（誤差は段ごとの誤差の和で見積もる）
+            const size_t target = static_cast<size_t>(static_cast<float>(previousCount / 3) * settings.lodReduction) * 3;
+            float error = 0.0f;
+            MeshLodData lod;
+            lod.indices = MeshSimplifier::Simplify(vertices, *previous, target, settings.lodMaxError, &error);
+            if (lod.indices.empty() || static_cast<float>(lod.indices.size()) > static_cast<float>(previousCount) * kMinReduction) {
+                break;
+            }
+            if (settings.optimizeVertexCache) {
+                OptimizeVertexCache(lod.indices, vertices.size(), settings.cacheSize);
+            }
+            lod.error = previousError + error;
+            previousError = lod.error;
+
+            lods.push_back(std::move(lod));
+            previous = &lods.back().indices;
+        }
+        return lods;
+    }
+
+    MeshOptimizeStatistics Optimize(ModelData& model, const MeshOptimizeSettings& settings)
+    {
+        MeshOptimizeStatistics statistics;
+        statistics.sourceVertexCount = static_cast<uint32_t>(model.vertices.size());
+        statistics.indexCount = static_cast<uint32_t>(model.indices.size());
+        statistics.sourceBytes = model.vertices.size() * sizeof(VertexData) + model.indices.size() * sizeof(uint32_t);
+
+        std::vector<uint32_t> indices(model.indices.begin(), model.indices.end());
+        statistics.sourceAcmr = ComputeACMR(indices, model.vertices.size(), settings.cacheSize);
+
+        if (settings.weldVertices) {
+            WeldVertices(model.vertices, indices, model.skinClusterData);
+        }
+        if (settings.optimizeVertexCache) {
+            std::vector<uint32_t> clusters;
+            OptimizeVertexCache(indices, model.vertices.size(), settings.cacheSize,
+                settings.optimizeOverdraw ? &clusters : nullptr, settings.overdrawThreshold);
+            if (settings.optimizeOverdraw) {
+                OptimizeOverdraw(indices, model.vertices, clusters);
+                statistics.clusterCount = static_cast<uint32_t>(clusters.size());
+            }
+        }
+        OptimizeVertexFetch(model.vertices, indices, model.skinClusterData);
+
+        model.indices.assign(indices.begin(), indices.end());
+        model.lods = GenerateLods(model.vertices, indices, settings);
+
+        statistics.vertexCount = static_cast<uint32_t>(model.vertices.size());
+        statistics.acmr = ComputeACMR(indices, model.vertices.size(), settings.cacheSize);
+        statistics.use16BitIndices = CanUse16BitIndices(model.vertices.size());
+        statistics.lodIndexCounts.push_back(static_cast<uint32_t>(model.indices.size()));
+        size_t totalIndexCount = model.indices.size();
+        for (const MeshLodData& lod : model.lods) {
+            statistics.lodIndexCounts.push_back(static_cast<uint32_t>(lod.indices.size()));
+            totalIndexCount += lod.indices.size();
+        }
+        statistics.optimizedBytes = model.vertices.size() * sizeof(VertexData) +
+            totalIndexCount * (statistics.use16BitIndices ? sizeof(uint16_t) : sizeof(uint32_t));
+        return statistics;
+    }
+}
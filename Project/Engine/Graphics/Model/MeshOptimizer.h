@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Engine/Graphics/Structs/ModelData.h"
+
+/// @brief 最適化の設定（変換済みモデルのキャッシュのキーに含まれる）
+struct MeshOptimizeSettings {
+    bool weldVertices = true;       ///< 内容が同じ頂点を1つにまとめる
+    bool optimizeVertexCache = true; ///< 頂点キャッシュに合わせて三角形を並べ替える（Tipsify）
+    bool optimizeOverdraw = true;   ///< 外側を向いたクラスタから描くように並べ替える
+    uint32_t cacheSize = 16;        ///< 想定する頂点キャッシュのサイズ
+    float overdrawThreshold = 1.05f; ///< クラスタを分ける ACMR の許容倍率（大きいほど細かく分けて重ね描きを減らす）
+    uint32_t lodCount = 4;          ///< LODの数（LOD0を含む、1ならLODを作らない）
+    float lodReduction = 0.5f;      ///< LODごとに残す三角形の割合
+    float lodMaxError = 0.05f;      ///< 1段の簡略化で許容する誤差（メッシュの大きさに対する割合）
+};
+
+/// @brief 最適化の結果
+struct MeshOptimizeStatistics {
+    uint32_t sourceVertexCount = 0; ///< 最適化前の頂点数
+    uint32_t vertexCount = 0;       ///< 最適化後の頂点数
+    uint32_t indexCount = 0;        ///< インデックス数
+    uint32_t clusterCount = 0;      ///< 重ね描きの並べ替えに使ったクラスタ数
+    float sourceAcmr = 0.0f;        ///< 最適化前の三角形あたりの頂点キャッシュミス数
+    float acmr = 0.0f;              ///< 最適化後の三角形あたりの頂点キャッシュミス数
+    uint64_t sourceBytes = 0;       ///< 最適化前の頂点・インデックスのバイト数（32bitインデックス）
+    uint64_t optimizedBytes = 0;    ///< 最適化後の頂点・インデックスのバイト数
+    bool use16BitIndices = false;   ///< 16bitインデックスを使えるか
+    std::vector<uint32_t> lodIndexCounts; ///< LODごとのインデックス数（LOD0を含む）
+};
+
+/// @brief 読み込み時のメッシュの最適化（D3D12・Assimpに依存しない）
+/// @details Assimpの出力は面の角ごとの頂点をそのまま持ち、三角形の順序も元ファイルのままなので、
+/// 頂点の結合 → 頂点キャッシュ向けの並べ替え → 重ね描き向けのクラスタの並べ替え → 頂点の使用順への並べ替え
+/// → LODの生成 を行う。スキンクラスターの頂点番号も合わせて付け替える。
+namespace MeshOptimizer {
+
+    /// @brief 16bitインデックスで表せる頂点数か
+    inline bool CanUse16BitIndices(size_t vertexCount) { return vertexCount <= 0xFFFF; }
+
+    /// @brief 内容（位置・法線・UV・スキンのウェイト）がビット単位で同じ頂点を1つにまとめる
+    /// @return 減った頂点数
+    uint32_t WeldVertices(std::vector<VertexData>& vertices, std::vector<uint32_t>& indices,
+        std::map<std::string, JointWeightData>& skinClusters);
+
+    /// @brief 頂点キャッシュのミスが減るように三角形を並べ替える（Tipsify）
+    /// @param indices インデックス（三角形リスト）
+    /// @param vertexCount 頂点数
+    /// @param cacheSize 頂点キャッシュのサイズ
+    /// @param outClusters 重ね描きの並べ替えに使うクラスタの先頭三角形（nullptr可）
+    /// @param clusterThreshold クラスタを分ける ACMR の許容倍率
+    void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize,
+        std::vector<uint32_t>* outClusters = nullptr, float clusterThreshold = 1.05f);
+
+    /// @brief クラスタを外側を向いているものから順に並べ替える（クラスタ内の順序は保つ）
+    /// @param clusters OptimizeVertexCache で得たクラスタの先頭三角形
+    void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<VertexData>& vertices,
+        const std::vector<uint32_t>& clusters);
+
+    /// @brief 頂点をインデックスで最初に使われる順に並べ替える（使われない頂点は除く）
+    void OptimizeVertexFetch(std::vector<VertexData>& vertices, std::vector<uint32_t>& indices,
+        std::map<std::string, JointWeightData>& skinClusters);
+
+    /// @brief FIFOの頂点キャッシュでの三角形あたりのミス数（ACMR）
+    float ComputeACMR(const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize);
+
+    /// @brief LOD0のインデックスを順に簡略化してLOD1以降を作る（頂点はLOD0と共有）
+    /// @details 三角形が十分に減らなくなった段（誤差の上限に達した・形が単純すぎる）で打ち切る。
+    std::vector<MeshLodData> GenerateLods(const std::vector<VertexData>& vertices, const std::vector<uint32_t>& indices,
+        const MeshOptimizeSettings& settings);
+
+    /// @brief モデルの頂点・インデックス・スキンクラスターを最適化し、LODを作る
+    MeshOptimizeStatistics Optimize(ModelData& model, const MeshOptimizeSettings& settings = {});
+}
@@ -0,0 +1,527 @@
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+namespace MeshSimplifier {
+
+    namespace {
+        constexpr uint32_t kNone = UINT32_MAX;
+
+        /// @brief 縁の形を保つ平面の重み（三角形の平面に対する倍率）
+        constexpr double kBorderWeight = 10.0;
+
+        /// @brief 縮約の前後で三角形の法線が成す角の余弦の下限
+        constexpr double kMinNormalCos = 0.25;
+
+        /// @brief パス数の上限（1パスで縮約できなくなるか目標に達すれば先に終わる）
+        constexpr uint32_t kMaxPasses = 128;
+
+        struct Point {
+            double x = 0.0, y = 0.0, z = 0.0;
+        };
+
+        Point Subtract(const Point& a, const Point& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+        Point Cross(const Point& a, const Point& b) { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+        double Dot(const Point& a, const Point& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+        /// @brief 平面までの距離の2乗の和（重みで割ると平均の2乗誤差）
+        struct Quadric {
+            double a2 = 0.0, b2 = 0.0, c2 = 0.0, ab = 0.0, ac = 0.0, bc = 0.0, ad = 0.0, bd = 0.0, cd = 0.0, d2 = 0.0;
+            double weight = 0.0;
+
+            /// @param n 単位法線
+            /// @param d 平面の式 n・p + d = 0 の定数
+            /// @param w 重み
+            void AddPlane(const Point& n, double d, double w)
+            {
+                a2 += w * n.x * n.x; b2 += w * n.y * n.y; c2 += w * n.z * n.z;
+                ab += w * n.x * n.y; ac += w * n.x * n.z; bc += w * n.y * n.z;
+                ad += w * n.x * d; bd += w * n.y * d; cd += w * n.z * d;
+                d2 += w * d * d;
+                weight += w;
+            }
+
+            void Add(const Quadric& other)
+            {
+                a2 += other.a2; b2 += other.b2; c2 += other.c2;
+                ab += other.ab; ac += other.ac; bc += other.bc;
+                ad += other.ad; bd += other.bd; cd += other.cd;
+                d2 += other.d2;
+                weight += other.weight;
+            }
+
+            double Evaluate(const Point& p) const
+            {
+                double q = a2 * p.x * p.x + b2 * p.y * p.y + c2 * p.z * p.z +
+                    2.0 * (ab * p.x * p.y + ac * p.x * p.z + bc * p.y * p.z) +
+                    2.0 * (ad * p.x + bd * p.y + cd * p.z) + d2;
+                return std::fabs(q);
+            }
+        };
+
+        uint64_t EdgeKey(uint32_t a, uint32_t b)
+        {
+            if (a > b) {
+                std::swap(a, b);
+            }
+            return (static_cast<uint64_t>(a) << 32) | b;
+        }
+
+        /// @brief 縮約の候補（from の位置の頂点を to の位置へ寄せる）
+        struct Collapse {
+            uint32_t from = 0;
+            uint32_t to = 0;
+            double cost = 0.0;
+            bool borderEdge = false;
+        };
+
+        /// @brief 簡略化の作業領域（位置の番号は位置が同じ頂点の代表の番号）
+        class Simplifier {
+        public:
+            Simplifier(const std::vector<VertexData>& vertices, std::vector<uint32_t>& indices)
+                : indices_(indices), vertexCount_(vertices.size())
+            {
+                NormalizePositions(vertices);
+                GroupPositions();
+                // 位置の重なった三角形は面積がなく、縁や反転の判定を狂わせるので最初に除く
+                std::iota(collapseRemap_.begin(), collapseRemap_.end(), 0u);
+                RemoveDegenerateTriangles();
+                BuildQuadrics();
+            }
+
+            /// @return 誤差（正規化した座標での距離の2乗）
+            double Run(size_t targetTriangleCount, double maxCost)
+            {
+                double resultCost = 0.0;
+                for (uint32_t pass = 0; pass < kMaxPasses && indices_.size() / 3 > targetTriangleCount; ++pass) {
+                    BuildAdjacency();
+                    BuildCollapses();
+
+                    const size_t goal = indices_.size() / 3 - targetTriangleCount;
+                    size_t removed = 0;
+                    std::fill(touched_.begin(), touched_.end(), uint8_t(0));
+                    std::iota(collapseRemap_.begin(), collapseRemap_.end(), 0u);
+
+                    // 誤差の小さい順に、周りがこのパスでまだ変わっていないものだけ縮約する
+                    for (const Collapse& collapse : collapses_) {
+                        if (collapse.cost > maxCost || removed >= goal) {
+                            break;
+                        }
+                        if (touched_[collapse.from] || touched_[collapse.to] ||
+                            !CheckLink(collapse) || !MapWedges(collapse) || Flips(collapse)) {
+                            continue;
+                        }
+                        Apply(collapse);
+                        removed += collapse.borderEdge ? 1 : 2;
+                        resultCost = (std::max)(resultCost, collapse.cost);
+                    }
+                    if (removed == 0) {
+                        break;
+                    }
+                    RemoveDegenerateTriangles();
+                }
+                return resultCost;
+            }
+
+            double GetExtent() const { return extent_; }
+
+        private:
+            void NormalizePositions(const std::vector<VertexData>& vertices)
+            {
+                float minimum[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+                float maximum[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+                for (const VertexData& vertex : vertices) {
+                    const float values[3] = { vertex.position.x, vertex.position.y, vertex.position.z };
+                    for (int axis = 0; axis < 3; ++axis) {
+                        minimum[axis] = (std::min)(minimum[axis], values[axis]);
+                        maximum[axis] = (std::max)(maximum[axis], values[axis]);
+                    }
+                }
+                extent_ = (std::max)({ double(maximum[0]) - minimum[0], double(maximum[1]) - minimum[1], double(maximum[2]) - minimum[2] });
+                if (!(extent_ > 0.0)) {
+                    extent_ = 1.0;
+                }
+
+                // 誤差をメッシュの大きさに対する割合で扱えるように [0, 1] に収める
+                positions_.resize(vertexCount_);
+                for (size_t i = 0; i < vertexCount_; ++i) {
+                    const VertexData& vertex = vertices[i];
+                    positions_[i] = {
+                        (double(vertex.position.x) - minimum[0]) / extent_,
+                        (double(vertex.position.y) - minimum[1]) / extent_,
+                        (double(vertex.position.z) - minimum[2]) / extent_,
+                    };
+                }
+            }
+
+            /// @brief 位置が同じ頂点（UV・法線だけが違う頂点）に同じ位置の番号を付ける
+            void GroupPositions()
+            {
+                std::vector<uint32_t> order(vertexCount_);
+                std::iota(order.begin(), order.end(), 0u);
+                std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+                    const Point& pa = positions_[a];
+                    const Point& pb = positions_[b];
+                    if (pa.x != pb.x) return pa.x < pb.x;
+                    if (pa.y != pb.y) return pa.y < pb.y;
+                    if (pa.z != pb.z) return pa.z < pb.z;
+                    return a < b;
+                });
+
+                positionOf_.resize(vertexCount_);
+                for (size_t begin = 0; begin < order.size();) {
+                    size_t end = begin + 1;
+                    const Point& p = positions_[order[begin]];
+                    while (end < order.size() && positions_[order[end]].x == p.x &&
+                        positions_[order[end]].y == p.y && positions_[order[end]].z == p.z) {
+                        ++end;
+                    }
+                    // 番号の最も小さい頂点を代表にする（sort は番号順を保つ）
+                    for (size_t i = begin; i < end; ++i) {
+                        positionOf_[order[i]] = order[begin];
+                    }
+                    begin = end;
+                }
+
+                touched_.resize(vertexCount_);
+                collapseRemap_.resize(vertexCount_);
+                border_.resize(vertexCount_);
+                locked_.resize(vertexCount_);
+                adjacencyOffsets_.resize(vertexCount_ + 1);
+            }
+
+            /// @brief 三角形の平面と、開いた縁に垂直な平面から各位置の二次誤差を作る
+            void BuildQuadrics()
+            {
+                quadrics_.assign(vertexCount_, Quadric{});
+                const size_t triangleCount = indices_.size() / 3;
+                std::vector<std::pair<uint64_t, uint32_t>> edges;
+                edges.reserve(triangleCount * 3);
+
+                for (size_t t = 0; t < triangleCount; ++t) {
+                    Point normal;
+                    double area = 0.0;
+                    if (!GetTriangleNormal(t, normal, area)) {
+                        continue;
+                    }
+                    const double d = -Dot(normal, positions_[positionOf_[indices_[t * 3]]]);
+                    for (size_t k = 0; k < 3; ++k) {
+                        quadrics_[positionOf_[indices_[t * 3 + k]]].AddPlane(normal, d, area);
+                        edges.emplace_back(EdgeKey(positionOf_[indices_[t * 3 + k]], positionOf_[indices_[t * 3 + (k + 1) % 3]]),
+                            static_cast<uint32_t>(t));
+                    }
+                }
+
+                std::sort(edges.begin(), edges.end());
+                for (size_t begin = 0; begin < edges.size();) {
+                    size_t end = begin + 1;
+                    while (end < edges.size() && edges[end].first == edges[begin].first) {
+                        ++end;
+                    }
+                    if (end - begin == 1) {
+                        const uint32_t a = static_cast<uint32_t>(edges[begin].first >> 32);
+                        const uint32_t b = static_cast<uint32_t>(edges[begin].first & 0xFFFFFFFFu);
+                        Point faceNormal;
+                        double area = 0.0;
+                        GetTriangleNormal(edges[begin].second, faceNormal, area);
+
+                        const Point edge = Subtract(positions_[b], positions_[a]);
+                        Point planeNormal = Cross(edge, faceNormal);
+                        const double length = std::sqrt(Dot(planeNormal, planeNormal));
+                        if (length > 0.0) {
+                            planeNormal = { planeNormal.x / length, planeNormal.y / length, planeNormal.z / length };
+                            const double d = -Dot(planeNormal, positions_[a]);
+                            const double weight = Dot(edge, edge) * kBorderWeight;
+                            quadrics_[a].AddPlane(planeNormal, d, weight);
+                            quadrics_[b].AddPlane(planeNormal, d, weight);
+                        }
+                    }
+                    begin = end;
+                }
+            }
+
+            bool GetTriangleNormal(size_t triangle, Point& outNormal, double& outArea) const
+            {
+                const Point& p0 = positions_[positionOf_[indices_[triangle * 3 + 0]]];
+                const Point& p1 = positions_[positionOf_[indices_[triangle * 3 + 1]]];
+                const Point& p2 = positions_[positionOf_[indices_[triangle * 3 + 2]]];
+                Point normal = Cross(Subtract(p1, p0), Subtract(p2, p0));
+                const double length = std::sqrt(Dot(normal, normal));
+                if (!(length > 0.0)) {
+                    outNormal = {};
+                    outArea = 0.0;
+                    return false;
+                }
+                outNormal = { normal.x / length, normal.y / length, normal.z / length };
+                outArea = length * 0.5;
+                return true;
+            }
+
+            /// @brief 位置ごとの三角形の一覧と、縁・非多様体の頂点
+            void BuildAdjacency()
+            {
+                const size_t triangleCount = indices_.size() / 3;
+                std::fill(adjacencyOffsets_.begin(), adjacencyOffsets_.end(), 0u);
+                for (uint32_t index : indices_) {
+                    ++adjacencyOffsets_[positionOf_[index] + 1];
+                }
+                for (size_t v = 0; v < vertexCount_; ++v) {
+                    adjacencyOffsets_[v + 1] += adjacencyOffsets_[v];
+                }
+                adjacency_.resize(indices_.size());
+                std::vector<uint32_t> cursor(adjacencyOffsets_.begin(), adjacencyOffsets_.end() - 1);
+                for (size_t i = 0; i < indices_.size(); ++i) {
+                    adjacency_[cursor[positionOf_[indices_[i]]]++] = static_cast<uint32_t>(i / 3);
+                }
+
+                edges_.clear();
+                edges_.reserve(triangleCount * 3);
+                for (size_t t = 0; t < triangleCount; ++t) {
+                    for (size_t k = 0; k < 3; ++k) {
+                        edges_.push_back(EdgeKey(positionOf_[indices_[t * 3 + k]], positionOf_[indices_[t * 3 + (k + 1) % 3]]));
+                    }
+                }
+                std::sort(edges_.begin(), edges_.end());
+
+                // 1つの三角形にしか使われない辺は縁、3つ以上で使われる辺の頂点は動かさない
+                std::fill(border_.begin(), border_.end(), uint8_t(0));
+                std::fill(locked_.begin(), locked_.end(), uint8_t(0));
+                ForEachEdge([this](uint32_t a, uint32_t b, size_t count) {
+                    if (count == 1) {
+                        border_[a] = border_[b] = 1;
+                    } else if (count > 2) {
+                        locked_[a] = locked_[b] = 1;
+                    }
+                });
+            }
+
+            template<typename Function>
+            void ForEachEdge(Function function) const
+            {
+                for (size_t begin = 0; begin < edges_.size();) {
+                    size_t end = begin + 1;
+                    while (end < edges_.size() && edges_[end] == edges_[begin]) {
+                        ++end;
+                    }
+                    function(static_cast<uint32_t>(edges_[begin] >> 32), static_cast<uint32_t>(edges_[begin] & 0xFFFFFFFFu), end - begin);
+                    begin = end;
+                }
+            }
+
+            /// @brief 辺ごとに誤差の小さい向きを選び、誤差の小さい順に並べる
+            void BuildCollapses()
+            {
+                collapses_.clear();
+                ForEachEdge([this](uint32_t a, uint32_t b, size_t count) {
+                    if (count > 2) {
+                        return;
+                    }
+                    const bool borderEdge = count == 1;
+                    Collapse best;
+                    best.cost = DBL_MAX;
+                    for (int direction = 0; direction < 2; ++direction) {
+                        const uint32_t from = direction == 0 ? a : b;
+                        const uint32_t to = direction == 0 ? b : a;
+                        // 縁の頂点は縁に沿ってのみ動かす
+                        if (locked_[from] || (border_[from] && !borderEdge)) {
+                            continue;
+                        }
+                        Quadric quadric = quadrics_[from];
+                        quadric.Add(quadrics_[to]);
+                        const double cost = quadric.weight > 0.0 ? quadric.Evaluate(positions_[to]) / quadric.weight : 0.0;
+                        if (cost < best.cost) {
+                            best = { from, to, cost, borderEdge };
+                        }
+                    }
+                    if (best.cost != DBL_MAX) {
+                        collapses_.push_back(best);
+                    }
+                });
+                std::sort(collapses_.begin(), collapses_.end(), [](const Collapse& x, const Collapse& y) {
+                    return x.cost < y.cost;
+                });
+            }
+
+            void CollectNeighbors(uint32_t position, std::vector<uint32_t>& outNeighbors) const
+            {
+                outNeighbors.clear();
+                for (uint32_t i = adjacencyOffsets_[position]; i < adjacencyOffsets_[position + 1]; ++i) {
+                    const uint32_t triangle = adjacency_[i];
+                    for (size_t k = 0; k < 3; ++k) {
+                        const uint32_t other = positionOf_[indices_[triangle * 3 + k]];
+                        if (other != position) {
+                            outNeighbors.push_back(other);
+                        }
+                    }
+                }
+                std::sort(outNeighbors.begin(), outNeighbors.end());
+                outNeighbors.erase(std::unique(outNeighbors.begin(), outNeighbors.end()), outNeighbors.end());
+            }
+
+            /// @brief 両端に共通する隣接頂点が辺の両側の三角形の頂点だけか（薄い部分が潰れて面が重ならないように）
+            bool CheckLink(const Collapse& collapse)
+            {
+                CollectNeighbors(collapse.from, fromNeighbors_);
+                CollectNeighbors(collapse.to, toNeighbors_);
+                size_t common = 0;
+                for (size_t i = 0, j = 0; i < fromNeighbors_.size() && j < toNeighbors_.size();) {
+                    if (fromNeighbors_[i] < toNeighbors_[j]) {
+                        ++i;
+                    } else if (fromNeighbors_[i] > toNeighbors_[j]) {
+                        ++j;
+                    } else {
+                        ++common;
+                        ++i;
+                        ++j;
+                    }
+                }
+                return common == (collapse.borderEdge ? 1u : 2u);
+            }
+
+            /// @brief from の各頂点（UV・法線違い）の寄せ先を決める
+            /// @return 辺を共有する三角形で寄せ先が1つに決まらない頂点があれば false（シームを横切る縮約）
+            bool MapWedges(const Collapse& collapse)
+            {
+                wedgeMap_.clear();
+                for (uint32_t i = adjacencyOffsets_[collapse.from]; i < adjacencyOffsets_[collapse.from + 1]; ++i) {
+                    const uint32_t triangle = adjacency_[i];
+                    uint32_t fromVertex = kNone;
+                    uint32_t toVertex = kNone;
+                    for (size_t k = 0; k < 3; ++k) {
+                        const uint32_t vertex = indices_[triangle * 3 + k];
+                        if (positionOf_[vertex] == collapse.from) {
+                            fromVertex = vertex;
+                        } else if (positionOf_[vertex] == collapse.to) {
+                            toVertex = vertex;
+                        }
+                    }
+
+                    auto it = std::find_if(wedgeMap_.begin(), wedgeMap_.end(),
+                        [fromVertex](const std::pair<uint32_t, uint32_t>& entry) { return entry.first == fromVertex; });
+                    if (it == wedgeMap_.end()) {
+                        wedgeMap_.emplace_back(fromVertex, toVertex);
+                    } else if (it->second == kNone) {
+                        it->second = toVertex;
+                    } else if (toVertex != kNone && it->second != toVertex) {
+                        return false;
+                    }
+                }
+                for (const auto& [fromVertex, toVertex] : wedgeMap_) {
+                    if (toVertex == kNone) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            /// @brief 縮約で向きが反転する三角形があるか
+            bool Flips(const Collapse& collapse) const
+            {
+                const Point& target = positions_[collapse.to];
+                for (uint32_t i = adjacencyOffsets_[collapse.from]; i < adjacencyOffsets_[collapse.from + 1]; ++i) {
+                    const uint32_t triangle = adjacency_[i];
+                    Point corners[3];
+                    Point moved[3];
+                    bool containsTarget = false;
+                    for (size_t k = 0; k < 3; ++k) {
+                        const uint32_t position = positionOf_[indices_[triangle * 3 + k]];
+                        containsTarget = containsTarget || position == collapse.to;
+                        corners[k] = positions_[position];
+                        moved[k] = position == collapse.from ? target : corners[k];
+                    }
+                    if (containsTarget) {
+                        continue;
+                    }
+                    const Point before = Cross(Subtract(corners[1], corners[0]), Subtract(corners[2], corners[0]));
+                    const Point after = Cross(Subtract(moved[1], moved[0]), Subtract(moved[2], moved[0]));
+                    // 大きく傾く場合も反転とみなす（小さな回転の積み重ねで裏返るのを防ぐ）
+                    if (Dot(before, after) <= kMinNormalCos * std::sqrt(Dot(before, before) * Dot(after, after))) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void Apply(const Collapse& collapse)
+            {
+                for (const auto& [fromVertex, toVertex] : wedgeMap_) {
+                    collapseRemap_[fromVertex] = toVertex;
+                }
+                quadrics_[collapse.to].Add(quadrics_[collapse.from]);
+
+                // 形の変わった三角形の頂点はこのパスではもう動かさない
+                for (uint32_t i = adjacencyOffsets_[collapse.from]; i < adjacencyOffsets_[collapse.from + 1]; ++i) {
+                    const uint32_t triangle = adjacency_[i];
+                    for (size_t k = 0; k < 3; ++k) {
+                        touched_[positionOf_[indices_[triangle * 3 + k]]] = 1;
+                    }
+                }
+            }
+
+            void RemoveDegenerateTriangles()
+            {
+                size_t write = 0;
+                for (size_t i = 0; i + 2 < indices_.size(); i += 3) {
+                    const uint32_t v0 = collapseRemap_[indices_[i + 0]];
+                    const uint32_t v1 = collapseRemap_[indices_[i + 1]];
+                    const uint32_t v2 = collapseRemap_[indices_[i + 2]];
+                    const uint32_t p0 = positionOf_[v0];
+                    const uint32_t p1 = positionOf_[v1];
+                    const uint32_t p2 = positionOf_[v2];
+                    if (p0 == p1 || p1 == p2 || p0 == p2) {
+                        continue;
+                    }
+                    indices_[write++] = v0;
+                    indices_[write++] = v1;
+                    indices_[write++] = v2;
+                }
+                indices_.resize(write);
+            }
+
+            std::vector<uint32_t>& indices_;
+            size_t vertexCount_ = 0;
+            double extent_ = 1.0;
+
+            std::vector<Point> positions_;
+            std::vector<uint32_t> positionOf_;  ///< 頂点 -> 位置の番号
+            std::vector<Quadric> quadrics_;     ///< 位置ごとの二次誤差
+
+            std::vector<uint32_t> adjacencyOffsets_;
+            std::vector<uint32_t> adjacency_;
+            std::vector<uint64_t> edges_;
+            std::vector<uint8_t> border_;
+            std::vector<uint8_t> locked_;
+            std::vector<Collapse> collapses_;
+
+            std::vector<uint8_t> touched_;
+            std::vector<uint32_t> collapseRemap_;
+            std::vector<uint32_t> fromNeighbors_;
+            std::vector<uint32_t> toNeighbors_;
+            std::vector<std::pair<uint32_t, uint32_t>> wedgeMap_;
+        };
+    }
+
+    std::vector<uint32_t> Simplify(const std::vector<VertexData>& vertices, const std::vector<uint32_t>& indices,
+        size_t targetIndexCount, float targetError, float* outError)
+    {
+        if (outError) {
+            *outError = 0.0f;
+        }
+        std::vector<uint32_t> result(indices.begin(), indices.begin() + indices.size() / 3 * 3);
+        if (result.size() <= targetIndexCount || vertices.empty()) {
+            return result;
+        }
+
+        Simplifier simplifier(vertices, result);
+        const double maxCost = static_cast<double>(targetError) * static_cast<double>(targetError);
+        const double cost = simplifier.Run(targetIndexCount / 3, maxCost);
+        if (outError) {
+            *outError = static_cast<float>(std::sqrt(cost) * simplifier.GetExtent());
+        }
+        return result;
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Graphics/Structs/VertexData.h"
+
+/// @brief 二次誤差（Quadric Error Metrics）による辺の縮約でメッシュを簡略化する（D3D12・Assimpに依存しない）
+/// @details 頂点は既存の頂点へ寄せるだけで新しく作らないので、簡略化したインデックスは元の頂点バッファをそのまま参照できる
+/// （スキンのウェイトも共有できる）。位置が同じでUV・法線が違う頂点（シーム）は、シームに沿った縮約だけを許して
+/// テクスチャの継ぎ目が崩れないようにする。開いた縁の頂点は縁に沿ってのみ動かし、縁には重みの大きい平面を加えて形を保つ。
+namespace MeshSimplifier {
+
+    /// @brief 三角形を減らしたインデックスを作る
+    /// @param vertices 頂点
+    /// @param indices 元のインデックス（三角形リスト）
+    /// @param targetIndexCount 目標のインデックス数（誤差の上限に先に達した場合はそれより多く残る）
+    /// @param targetError 許容する誤差（メッシュの大きさに対する割合）
+    /// @param outError 結果の誤差（モデル空間の距離、nullptr可）
+    /// @return 簡略化したインデックス（元の頂点を参照する）
+    std::vector<uint32_t> Simplify(const std::vector<VertexData>& vertices, const std::vector<uint32_t>& indices,
+        size_t targetIndexCount, float targetError, float* outError = nullptr);
+}
@@ -12,6 +12,13 @@
 namespace {
 	DirectXCommon* sDxCommon_ = nullptr;
 	ResourceFactory* sResourceFactory_ = nullptr;
+	MeshLodSettings sLodSettings_;
+}
+
+Model::~Model() {
+	if (skinCluster_ && sDxCommon_) {
+		sDxCommon_->GetDescriptorManager()->Free(skinCluster_->paletteSrvAllocation);
+	}
 }
 
 void Model::Initialize(DirectXCommon* dxCommon, ResourceFactory* factory) {
@@ -106,8 +113,30 @@ void Model::Draw(const WorldTransform& transform, const ICamera* camera,
 		SetupNormalDrawCommands(cmdList, textureHandle);
 	}
 
-	// 描画実行
-	cmdList->DrawIndexedInstanced(resource_->indexCount_, 1, 0, 0, 0);
+	// 画面上の大きさに合ったLODの範囲を描画
+	UpdateLod(transform, camera);
+	const MeshLod& lod = resource_->lods_[currentLod_];
+	cmdList->DrawIndexedInstanced(lod.indexCount, 1, lod.startIndex, 0, 0);
+}
+
+void Model::UpdateLod(const WorldTransform& transform, const ICamera* camera) {
+	const std::vector<MeshLod>& lods = resource_->GetLods();
+	if (lods.size() <= 1) {
+		currentLod_ = 0;
+		return;
+	}
+
+	float screenScale = MeshLodSelector::ComputeScreenScale(
+		transform.GetWorldMatrix(), camera->GetProjectionMatrix(), camera->GetPosition());
+	currentLod_ = MeshLodSelector::Select(lods, screenScale, currentLod_, sLodSettings_);
+}
+
+void Model::SetLodSettings(const MeshLodSettings& settings) {
+	sLodSettings_ = settings;
+}
+
+const MeshLodSettings& Model::GetLodSettings() {
+	return sLodSettings_;
 }
 
 void Model::SetupNormalDrawCommands(ID3D12GraphicsCommandList* cmdList,
@@ -218,4 +247,5 @@ bool Model::IsAnimationFinished() const {
 
 void Model::SetModelResource(ModelResource* resource) {
    resource_ = resource;
+   currentLod_ = 0;
 }
@@ -32,8 +32,8 @@ public:
 	/// @brief デフォルトコンストラクタ
 	Model() = default;
 
-	/// @brief デストラクタ
-	~Model() = default;
+	/// @brief デストラクタ（SkinClusterのSRVを解放）
+	~Model();
 
 	/// @brief 静的初期化（全Modelインスタンス共通のリソースを初期化）
 	/// @param dxCommon DirectXCommonのポインタ
@@ -108,6 +108,26 @@ public:
 
 	void SetModelResource(ModelResource* resource);
 
+	/// @brief 描画したLODを取得
+	/// @return LODの番号（0が最も詳細）
+	uint32_t GetCurrentLod() const { return currentLod_; }
+
+	/// @brief LODの数を取得（LOD0を含む）
+	/// @return LODの数（リソース未設定時は0）
+	uint32_t GetLodCount() const { return resource_ ? resource_->GetLodCount() : 0; }
+
+	/// @brief LODの選び方を設定（全Model共通）
+	/// @param settings 選び方
+	static void SetLodSettings(const MeshLodSettings& settings);
+
+	/// @brief LODの選び方を取得
+	/// @return 選び方
+	static const MeshLodSettings& GetLodSettings();
+
+	/// @brief ローカル空間のバウンディング半径を取得
+	/// @return 半径（リソース未設定時は0）
+	float GetBoundingRadius() const { return resource_ ? resource_->GetBoundingRadius() : 0.0f; }
+
 private:
 	// 参照するModelResource
 	ModelResource* resource_ = nullptr;
@@ -127,10 +147,16 @@ private:
 	// アニメーションコントローラー
 	std::unique_ptr<IAnimationController> animationController_;
 
+	// 前回描画したLOD（切り替えの余裕に使う）
+	uint32_t currentLod_ = 0;
+
 	// 内部ヘルパーメソッド
 	/// @brief WVP行列データを更新
 	void UpdateTransformationMatrix(const WorldTransform& transform, const ICamera* camera);
 
+	/// @brief 画面上の大きさからLODを選ぶ
+	void UpdateLod(const WorldTransform& transform, const ICamera* camera);
+
 	/// @brief SkinClusterを更新（スケルトンアニメーションの場合のみ）
 	void UpdateSkinCluster();
 
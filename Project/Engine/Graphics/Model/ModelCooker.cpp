@@ -0,0 +1,300 @@
+#include "ModelCooker.h"
+#include "Engine/Graphics/Shader/ShaderCacheFormat.h"
+
+#include <cstring>
+#include <type_traits>
+
+namespace ModelCooker {
+
+    namespace {
+        /// @brief キャッシュファイルへの書き込み
+        class Writer {
+        public:
+            template<typename T>
+            void Write(const T& value)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                WriteBytes(&value, sizeof(T));
+            }
+
+            void WriteBytes(const void* data, size_t size)
+            {
+                const uint8_t* begin = static_cast<const uint8_t*>(data);
+                bytes_.insert(bytes_.end(), begin, begin + size);
+            }
+
+            void WriteString(const std::string& text)
+            {
+                Write(static_cast<uint32_t>(text.size()));
+                WriteBytes(text.data(), text.size());
+            }
+
+            const std::vector<uint8_t>& GetBytes() const { return bytes_; }
+
+        private:
+            std::vector<uint8_t> bytes_;
+        };
+
+        /// @brief キャッシュファイルからの読み込み（範囲外を読もうとしたら以降は全て失敗）
+        class Reader {
+        public:
+            Reader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+            template<typename T>
+            bool Read(T& outValue)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                return ReadBytes(&outValue, sizeof(T));
+            }
+
+            bool ReadBytes(void* outData, size_t size)
+            {
+                if (failed_ || size > size_ - offset_) {
+                    failed_ = true;
+                    return false;
+                }
+                std::memcpy(outData, data_ + offset_, size);
+                offset_ += size;
+                return true;
+            }
+
+            bool ReadString(std::string& outText)
+            {
+                uint32_t length = 0;
+                if (!Read(length) || length > size_ - offset_) {
+                    failed_ = true;
+                    return false;
+                }
+                outText.assign(reinterpret_cast<const char*>(data_ + offset_), length);
+                offset_ += length;
+                return true;
+            }
+
+            /// @brief count 個の要素を読める残りがあるか（壊れたファイルで巨大な確保をしない）
+            bool CanRead(uint64_t count, size_t elementSize) const
+            {
+                return !failed_ && count <= (size_ - offset_) / elementSize;
+            }
+
+            bool IsAtEnd() const { return !failed_ && offset_ == size_; }
+            bool Failed() const { return failed_; }
+
+        private:
+            const uint8_t* data_ = nullptr;
+            size_t size_ = 0;
+            size_t offset_ = 0;
+            bool failed_ = false;
+        };
+
+        constexpr uint32_t kMaxNodeDepth = 256;
+
+        void WriteNode(Writer& writer, const Node& node)
+        {
+            writer.Write(node.transform);
+            writer.Write(node.localMatrix);
+            writer.WriteString(node.name);
+            writer.Write(static_cast<uint32_t>(node.children.size()));
+            for (const Node& child : node.children) {
+                WriteNode(writer, child);
+            }
+        }
+
+        bool ReadNode(Reader& reader, Node& outNode, uint32_t depth)
+        {
+            uint32_t childCount = 0;
+            if (depth > kMaxNodeDepth ||
+                !reader.Read(outNode.transform) || !reader.Read(outNode.localMatrix) ||
+                !reader.ReadString(outNode.name) || !reader.Read(childCount) ||
+                !reader.CanRead(childCount, sizeof(uint32_t))) {
+                return false;
+            }
+            outNode.children.resize(childCount);
+            for (Node& child : outNode.children) {
+                if (!ReadNode(reader, child, depth + 1)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        std::string GetDirectoryPrefix(const std::string& directoryPath)
+        {
+            return directoryPath + "/";
+        }
+    }
+
+    uint64_t ComputeKey(const void* source, size_t size, const MeshOptimizeSettings& settings)
+    {
+        const char kTag[] = "Model";
+        uint64_t key = ShaderCacheFormat::HashBytes(kTag, sizeof(kTag));
+        key = ShaderCacheFormat::HashBytes(&kCookVersion, sizeof(kCookVersion), key);
+        key = ShaderCacheFormat::HashBytes(source, size, key);
+
+        // 設定は値を1つずつ加える（構造体のパディングを含めない）
+        const uint32_t flags = (settings.weldVertices ? 1u : 0u) |
+            (settings.optimizeVertexCache ? 2u : 0u) |
+            (settings.optimizeOverdraw ? 4u : 0u);
+        key = ShaderCacheFormat::HashBytes(&flags, sizeof(flags), key);
+        key = ShaderCacheFormat::HashBytes(&settings.cacheSize, sizeof(settings.cacheSize), key);
+        key = ShaderCacheFormat::HashBytes(&settings.overdrawThreshold, sizeof(settings.overdrawThreshold), key);
+        key = ShaderCacheFormat::HashBytes(&settings.lodCount, sizeof(settings.lodCount), key);
+        key = ShaderCacheFormat::HashBytes(&settings.lodReduction, sizeof(settings.lodReduction), key);
+        key = ShaderCacheFormat::HashBytes(&settings.lodMaxError, sizeof(settings.lodMaxError), key);
+        return key;
+    }
+
+    std::filesystem::path GetCachePath(const std::filesystem::path& cacheDirectory, uint64_t key)
+    {
+        return cacheDirectory / (ShaderCacheFormat::ToHexString(key) + ".model");
+    }
+
+    std::vector<uint8_t> Serialize(uint64_t key, const ModelData& model, const std::string& directoryPath)
+    {
+        Writer writer;
+
+        writer.Write(static_cast<uint32_t>(model.vertices.size()));
+        writer.WriteBytes(model.vertices.data(), model.vertices.size() * sizeof(VertexData));
+
+        // インデックス（頂点数が収まれば16bit）
+        const bool use16Bit = MeshOptimizer::CanUse16BitIndices(model.vertices.size());
+        writer.Write(static_cast<uint32_t>(use16Bit ? sizeof(uint16_t) : sizeof(uint32_t)));
+        auto writeIndices = [&writer, use16Bit](const auto& indices) {
+            writer.Write(static_cast<uint32_t>(indices.size()));
+            for (auto index : indices) {
+                if (use16Bit) {
+                    writer.Write(static_cast<uint16_t>(index));
+                } else {
+                    writer.Write(static_cast<uint32_t>(index));
+                }
+            }
+        };
+        writeIndices(model.indices);
+
+        // LOD（インデックスと誤差）
+        writer.Write(static_cast<uint32_t>(model.lods.size()));
+        for (const MeshLodData& lod : model.lods) {
+            writer.Write(lod.error);
+            writeIndices(lod.indices);
+        }
+
+        // スキンクラスター
+        writer.Write(static_cast<uint32_t>(model.skinClusterData.size()));
+        for (const auto& [name, joint] : model.skinClusterData) {
+            writer.WriteString(name);
+            writer.Write(joint.inverseBindPoseMatrix);
+            writer.Write(static_cast<uint32_t>(joint.vertexWeights.size()));
+            for (const VertexWeightData& weight : joint.vertexWeights) {
+                writer.Write(weight.weight);
+                writer.Write(weight.vertexIndex);
+            }
+        }
+
+        // テクスチャのパス（モデルのディレクトリ内ならその相対パス）
+        const std::string prefix = GetDirectoryPrefix(directoryPath);
+        const std::string& texturePath = model.material.textureFilePath;
+        const bool relative = texturePath.starts_with(prefix);
+        writer.Write(static_cast<uint32_t>(relative ? 1 : 0));
+        writer.WriteString(relative ? texturePath.substr(prefix.size()) : texturePath);
+
+        WriteNode(writer, model.rootNode);
+
+        const std::vector<uint8_t>& payload = writer.GetBytes();
+        return ShaderCacheFormat::SerializeBlob(key, payload.data(), payload.size());
+    }
+
+    bool Deserialize(const std::vector<uint8_t>& bytes, uint64_t key, const std::string& directoryPath, ModelData& outModel)
+    {
+        size_t payloadOffset = 0;
+        size_t payloadSize = 0;
+        if (!ShaderCacheFormat::DeserializeBlob(bytes, key, payloadOffset, payloadSize)) {
+            return false;
+        }
+        Reader reader(bytes.data() + payloadOffset, payloadSize);
+        ModelData model;
+
+        uint32_t vertexCount = 0;
+        if (!reader.Read(vertexCount) || !reader.CanRead(vertexCount, sizeof(VertexData))) {
+            return false;
+        }
+        model.vertices.resize(vertexCount);
+        reader.ReadBytes(model.vertices.data(), model.vertices.size() * sizeof(VertexData));
+
+        uint32_t indexSize = 0;
+        if (!reader.Read(indexSize) || (indexSize != sizeof(uint16_t) && indexSize != sizeof(uint32_t))) {
+            return false;
+        }
+        auto readIndices = [&reader, indexSize, vertexCount](auto& outIndices) {
+            uint32_t indexCount = 0;
+            if (!reader.Read(indexCount) || !reader.CanRead(indexCount, indexSize)) {
+                return false;
+            }
+            outIndices.resize(indexCount);
+            for (auto& index : outIndices) {
+                uint32_t value = 0;
+                if (indexSize == sizeof(uint16_t)) {
+                    uint16_t value16 = 0;
+                    reader.Read(value16);
+                    value = value16;
+                } else {
+                    reader.Read(value);
+                }
+                if (value >= vertexCount) {
+                    return false;
+                }
+                index = static_cast<std::remove_reference_t<decltype(index)>>(value);
+            }
+            return true;
+        };
+        if (!readIndices(model.indices)) {
+            return false;
+        }
+
+        uint32_t lodCount = 0;
+        if (!reader.Read(lodCount) || !reader.CanRead(lodCount, sizeof(float) + sizeof(uint32_t))) {
+            return false;
+        }
+        model.lods.resize(lodCount);
+        for (MeshLodData& lod : model.lods) {
+            if (!reader.Read(lod.error) || !readIndices(lod.indices)) {
+                return false;
+            }
+        }
+
+        uint32_t jointCount = 0;
+        if (!reader.Read(jointCount) || !reader.CanRead(jointCount, sizeof(uint32_t))) {
+            return false;
+        }
+        for (uint32_t i = 0; i < jointCount; ++i) {
+            std::string name;
+            JointWeightData joint{};
+            uint32_t weightCount = 0;
+            if (!reader.ReadString(name) || !reader.Read(joint.inverseBindPoseMatrix) ||
+                !reader.Read(weightCount) || !reader.CanRead(weightCount, sizeof(float) + sizeof(uint32_t))) {
+                return false;
+            }
+            joint.vertexWeights.resize(weightCount);
+            for (VertexWeightData& weight : joint.vertexWeights) {
+                reader.Read(weight.weight);
+                reader.Read(weight.vertexIndex);
+                if (weight.vertexIndex >= vertexCount) {
+                    return false;
+                }
+            }
+            model.skinClusterData.emplace(std::move(name), std::move(joint));
+        }
+
+        uint32_t relative = 0;
+        std::string texturePath;
+        if (!reader.Read(relative) || !reader.ReadString(texturePath)) {
+            return false;
+        }
+        model.material.textureFilePath = relative ? GetDirectoryPrefix(directoryPath) + texturePath : texturePath;
+
+        if (!ReadNode(reader, model.rootNode, 0) || !reader.IsAtEnd()) {
+            return false;
+        }
+
+        outModel = std::move(model);
+        return true;
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "MeshOptimizer.h"
+#include "Engine/Graphics/Structs/ModelData.h"
+
+/// @brief 変換済みモデルの読み込み結果
+struct ModelCookResult {
+    bool cached = false;                ///< キャッシュから読み込んだ
+    bool written = false;               ///< 最適化してキャッシュに保存した
+    std::filesystem::path cachePath;    ///< キャッシュファイル（キャッシュを使わない場合は空）
+    MeshOptimizeStatistics statistics;  ///< 最適化の結果（キャッシュから読み込んだ場合は頂点数・インデックス数・LODのインデックス数のみ）
+};
+
+/// @brief 変換済みモデルのキャッシュ（D3D12・Assimpに依存しない）
+/// @details 読み込んで最適化した ModelData を <ディレクトリ>/<キー>.model に保存する。
+/// キーは元ファイルの内容と最適化の設定から求めるので、モデルを差し替えれば自動的に作り直される。
+/// テクスチャのパスはモデルのディレクトリからの相対パスで保存し、同じ内容のモデルを別の場所に置いても使える。
+/// インデックス（LODを含む）は頂点数が収まれば16bitで保存する。
+/// キーに含めるのは元ファイル自身だけなので、外部ファイル（.mtl・.bin）だけを変えた場合はキャッシュを消すこと。
+namespace ModelCooker {
+
+    /// @brief 変換処理・ファイル形式のバージョン（出力が変わる修正をしたら上げる）
+    constexpr uint32_t kCookVersion = 2;
+
+    /// @brief キャッシュのキーを計算
+    /// @param source 元ファイルの内容
+    /// @param size バイト数
+    /// @param settings 最適化の設定
+    uint64_t ComputeKey(const void* source, size_t size, const MeshOptimizeSettings& settings);
+
+    /// @brief キャッシュファイルのパス（<ディレクトリ>/<キー>.model）
+    std::filesystem::path GetCachePath(const std::filesystem::path& cacheDirectory, uint64_t key);
+
+    /// @brief モデルをキャッシュファイルの形式にする
+    /// @param key キャッシュのキー
+    /// @param model 最適化済みのモデル
+    /// @param directoryPath モデルのディレクトリ（テクスチャのパスを相対にする）
+    std::vector<uint8_t> Serialize(uint64_t key, const ModelData& model, const std::string& directoryPath);
+
+    /// @brief キャッシュファイルからモデルを取り出す
+    /// @param bytes ファイルの内容
+    /// @param key キャッシュのキー
+    /// @param directoryPath モデルのディレクトリ（テクスチャのパスに付ける）
+    /// @param outModel 結果
+    /// @return 形式・バージョン・チェックサムが一致し、内容が壊れていなければtrue
+    bool Deserialize(const std::vector<uint8_t>& bytes, uint64_t key, const std::string& directoryPath, ModelData& outModel);
+}
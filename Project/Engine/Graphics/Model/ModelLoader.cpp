@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include "Engine/Graphics/Structs/VertexData.h"
+#include "Engine/Graphics/Texture/TextureCooker.h"
 #include "Engine/Math/MathCore.h"
 
 ModelData ModelLoader::LoadModelFile(const std::string& directoryPath, const std::string& filename)
@@ -61,7 +62,8 @@ ModelData ModelLoader::LoadModelFile(const std::string& directoryPath, const std
 			jointWeightData.inverseBindPoseMatrix = MathCore::Matrix::Inverse(bindPoseMatrix);
 
 			for (uint32_t weightIndex = 0; weightIndex < bone->mNumWeights; ++weightIndex) {
-				jointWeightData.vertexWeights.push_back({ bone->mWeights[weightIndex].mWeight, bone->mWeights[weightIndex].mVertexId });
+				// 頂点番号はメッシュ内のものなので、統合後の番号にする
+				jointWeightData.vertexWeights.push_back({ bone->mWeights[weightIndex].mWeight, baseVertexIndex + bone->mWeights[weightIndex].mVertexId });
 			}
 		}
 
@@ -83,6 +85,55 @@ ModelData ModelLoader::LoadModelFile(const std::string& directoryPath, const std
 	return result;
 }
 
+ModelData ModelLoader::LoadOptimizedModelFile(const std::string& directoryPath, const std::string& filename,
+	const std::filesystem::path& cacheDirectory, const MeshOptimizeSettings& settings, ModelCookResult* outResult)
+{
+	ModelCookResult result;
+	ModelData model;
+
+	// キャッシュのキーは元ファイルの内容から求めるので、モデルを差し替えれば作り直される
+	uint64_t key = 0;
+	if (!cacheDirectory.empty()) {
+		std::vector<uint8_t> source;
+		if (TextureCooker::ReadFile(directoryPath + "/" + filename, source)) {
+			key = ModelCooker::ComputeKey(source.data(), source.size(), settings);
+			result.cachePath = ModelCooker::GetCachePath(cacheDirectory, key);
+
+			std::vector<uint8_t> cached;
+			if (TextureCooker::ReadFile(result.cachePath, cached) &&
+				ModelCooker::Deserialize(cached, key, directoryPath, model)) {
+				result.cached = true;
+				result.statistics.sourceVertexCount = static_cast<uint32_t>(model.vertices.size());
+				result.statistics.vertexCount = static_cast<uint32_t>(model.vertices.size());
+				result.statistics.indexCount = static_cast<uint32_t>(model.indices.size());
+				result.statistics.use16BitIndices = MeshOptimizer::CanUse16BitIndices(model.vertices.size());
+				result.statistics.lodIndexCounts.push_back(static_cast<uint32_t>(model.indices.size()));
+				for (const MeshLodData& lod : model.lods) {
+					result.statistics.lodIndexCounts.push_back(static_cast<uint32_t>(lod.indices.size()));
+				}
+				if (outResult) {
+					*outResult = std::move(result);
+				}
+				return model;
+			}
+			// 読めないキャッシュは作り直す
+		}
+	}
+
+	model = LoadModelFile(directoryPath, filename);
+	result.statistics = MeshOptimizer::Optimize(model, settings);
+
+	if (!result.cachePath.empty()) {
+		std::error_code ec;
+		std::filesystem::create_directories(cacheDirectory, ec);
+		result.written = TextureCooker::WriteFileAtomic(result.cachePath, ModelCooker::Serialize(key, model, directoryPath));
+	}
+	if (outResult) {
+		*outResult = std::move(result);
+	}
+	return model;
+}
+
 const aiScene* ModelLoader::LoadAssimpFile(const std::string& filepath)
 {
 	static Assimp::Importer importer;
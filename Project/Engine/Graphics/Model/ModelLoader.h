@@ -4,8 +4,10 @@
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 
+#include <filesystem>
 #include <string>
 
+#include "Engine/Graphics/Model/ModelCooker.h"
 #include "Engine/Graphics/Structs/ModelData.h"
 #include "Engine/Graphics/Structs/Node.h"
 #include "Engine/Math/Matrix/Matrix4x4.h"
@@ -19,6 +21,17 @@ public:
 	/// @return 読み込んだモデルデータ
 	static ModelData LoadModelFile(const std::string& directoryPath, const std::string& filename);
 
+	/// @brief モデルファイルを読み込んで最適化する（変換済みのキャッシュがあればそれを読む）
+	/// @param directoryPath ディレクトリパス
+	/// @param filename ファイル名
+	/// @param cacheDirectory キャッシュのディレクトリ（空なら保存せず、毎回最適化する）
+	/// @param settings 最適化の設定
+	/// @param outResult 読み込み結果（nullptr可）
+	/// @return 最適化したモデルデータ
+	/// @details 実行時（ModelResource）とコマンドラインのクッカー（Tools/ModelCooker）で同じ処理を使う。
+	static ModelData LoadOptimizedModelFile(const std::string& directoryPath, const std::string& filename,
+		const std::filesystem::path& cacheDirectory, const MeshOptimizeSettings& settings = {}, ModelCookResult* outResult = nullptr);
+
 private:
 	/// @brief Assimpでファイルを読み込む
 	/// @param filepath ファイルパス
@@ -9,11 +9,12 @@
 #include <filesystem>
 #include <algorithm>
 
-void ModelManager::Initialize(DirectXCommon* dxCommon, ResourceFactory* factory)
+void ModelManager::Initialize(DirectXCommon* dxCommon, ResourceFactory* factory, const std::filesystem::path& cookCacheDirectory)
 {
 	assert(dxCommon && factory);
 	dxCommon_ = dxCommon;
 	resourceFactory_ = factory;
+	cookCacheDirectory_ = cookCacheDirectory;
 	Model::Initialize(dxCommon, factory);
 }
 
@@ -193,7 +194,7 @@ ModelResource* ModelManager::LoadModelResourceInternal(const std::string& direct
 
 	auto& textureManager = TextureManager::GetInstance();
 	resource->Initialize(dxCommon_, resourceFactory_, &textureManager);
-	resource->LoadFromFile(directoryPath, filename);
+	resource->LoadFromFile(directoryPath, filename, cookCacheDirectory_);
 
 	// キャッシュに登録
 	ModelResource* resourcePtr = resource.get();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <filesystem>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -26,7 +27,8 @@ public:
 	/// @brief 初期化
 	/// @param dxCommon DirectXCommonのポインタ
 	/// @param factory リソースファクトリのポインタ
-	void Initialize(DirectXCommon* dxCommon, ResourceFactory* factory);
+	/// @param cookCacheDirectory 最適化済みモデルを置くディレクトリ（空なら読み込むたびに最適化する）
+	void Initialize(DirectXCommon* dxCommon, ResourceFactory* factory, const std::filesystem::path& cookCacheDirectory = {});
 
 	/// @brief 静的モデルを作成（アニメーションなし）
 	/// @param filePath ファイルパス
@@ -83,6 +85,9 @@ private:
 	
 	// リソースファクトリ
 	ResourceFactory* resourceFactory_ = nullptr;
+
+	// 最適化済みモデルのキャッシュ
+	std::filesystem::path cookCacheDirectory_;
 	
 	// ファイルパスをキーとしたリソースキャッシュ
 	std::unordered_map<std::string, std::unique_ptr<ModelResource>> resourceCache_;
@@ -5,8 +5,14 @@
 #include "Engine/Graphics/Model/ModelLoader.h"
 #include "Engine/Graphics/Model/Skeleton/SkeletonLoader.h"
 #include "Engine/Graphics/Structs/VertexData.h"
+#include "Engine/Utility/Logger/Logger.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <format>
+#include <string>
+#include <vector>
 
 void ModelResource::Initialize(DirectXCommon* dxCommon, ResourceFactory* factory, TextureManager* textureMg)
 {
@@ -15,12 +21,25 @@ void ModelResource::Initialize(DirectXCommon* dxCommon, ResourceFactory* factory
     textureManager_ = textureMg;
 }
 
-void ModelResource::LoadFromFile(const std::string& directoryPath, const std::string& filename)
+void ModelResource::LoadFromFile(const std::string& directoryPath, const std::string& filename,
+    const std::filesystem::path& cookCacheDirectory)
 {
     assert(dxCommon_ && resourceFactory_ && textureManager_);
     
-    // ModelLoaderを使用してモデルデータを読み込む
-    ModelData modelData = ModelLoader::LoadModelFile(directoryPath, filename);
+    // ModelLoaderを使用してモデルデータを読み込む（最適化済みのキャッシュがあればそれを使う）
+    ModelCookResult cookResult;
+    ModelData modelData = ModelLoader::LoadOptimizedModelFile(directoryPath, filename, cookCacheDirectory, {}, &cookResult);
+    if (!cookResult.cached) {
+        const MeshOptimizeStatistics& stats = cookResult.statistics;
+        std::string lodIndices;
+        for (uint32_t count : stats.lodIndexCounts) {
+            lodIndices += (lodIndices.empty() ? "" : "/") + std::to_string(count);
+        }
+        Logger::GetInstance().Log(std::format("Optimized model: {}/{} (vertices {} -> {}, bytes {} -> {}, ACMR {:.2f} -> {:.2f}, {}bit indices, LOD indices {})",
+            directoryPath, filename, stats.sourceVertexCount, stats.vertexCount, stats.sourceBytes, stats.optimizedBytes,
+            stats.sourceAcmr, stats.acmr, stats.use16BitIndices ? 16 : 32, lodIndices),
+            LogLevel::INFO, LogCategory::Resource);
+    }
     
     // ModelDataを保存（スキンクラスター生成に必要）
     modelData_ = modelData;
@@ -36,41 +55,60 @@ void ModelResource::LoadFromFile(const std::string& directoryPath, const std::st
     
     // 頂点数を設定
     vertexCount_ = static_cast<UINT>(modelData.vertices.size());
+
+    // バウンディング半径を計算（カリング・空間分割用）
+    float maxDistanceSq = 0.0f;
+    for (const VertexData& vertex : modelData.vertices) {
+        float distanceSq = vertex.position.x * vertex.position.x + vertex.position.y * vertex.position.y + vertex.position.z * vertex.position.z;
+        maxDistanceSq = (std::max)(maxDistanceSq, distanceSq);
+    }
+    boundingRadius_ = std::sqrt(maxDistanceSq);
     
     // インデックス数を設定
     indexCount_ = static_cast<UINT>(modelData.indices.size());
     
-    // 頂点バッファの作成
-    vertexBuffer_ = ResourceFactory::CreateBufferResource(
-        dxCommon_->GetDevice(),
+    // 頂点バッファの作成（デフォルトヒープに置き、データはまとめてコピーする）
+    UploadManager* uploadManager = dxCommon_->GetUploadManager();
+    vertexBuffer_ = uploadManager->CreateStaticBuffer(
+        modelData.vertices.data(),
         sizeof(VertexData) * modelData.vertices.size());
 
     // 頂点バッファビューの設定
     vertexBufferView_.BufferLocation = vertexBuffer_->GetGPUVirtualAddress();
     vertexBufferView_.SizeInBytes = static_cast<UINT>(sizeof(VertexData) * modelData.vertices.size());
     vertexBufferView_.StrideInBytes = sizeof(VertexData);
-
-    // 頂点データをGPUメモリにコピー
-    void* mapped = nullptr;
-    vertexBuffer_->Map(0, nullptr, &mapped);
-    memcpy(mapped, modelData.vertices.data(), sizeof(VertexData) * modelData.vertices.size());
-    vertexBuffer_->Unmap(0, nullptr);
     
+    // LODの範囲（全LODを1つのインデックスバッファに続けて置く）
+    lods_.clear();
+    lods_.push_back({ 0, indexCount_, 0.0f });
+    size_t totalIndexCount = modelData.indices.size();
+    for (const MeshLodData& lod : modelData.lods) {
+        lods_.push_back({ static_cast<uint32_t>(totalIndexCount), static_cast<uint32_t>(lod.indices.size()), lod.error });
+        totalIndexCount += lod.indices.size();
+    }
+
     // インデックスバッファの作成
-    indexBuffer_ = ResourceFactory::CreateBufferResource(
-        dxCommon_->GetDevice(),
-        sizeof(uint32_t) * modelData.indices.size());
+    // 頂点数が収まれば16bitにしてバッファを半分にする
+    auto createIndexBuffer = [&](auto indexType, DXGI_FORMAT format) {
+        using Index = decltype(indexType);
+        std::vector<Index> indices;
+        indices.reserve(totalIndexCount);
+        indices.insert(indices.end(), modelData.indices.begin(), modelData.indices.end());
+        for (const MeshLodData& lod : modelData.lods) {
+            indices.insert(indices.end(), lod.indices.begin(), lod.indices.end());
+        }
+        indexBuffer_ = uploadManager->CreateStaticBuffer(indices.data(), sizeof(Index) * indices.size());
+        indexBufferView_.SizeInBytes = static_cast<UINT>(sizeof(Index) * indices.size());
+        indexBufferView_.Format = format;
+    };
+    if (MeshOptimizer::CanUse16BitIndices(modelData.vertices.size())) {
+        createIndexBuffer(uint16_t{}, DXGI_FORMAT_R16_UINT);
+    } else {
+        createIndexBuffer(uint32_t{}, DXGI_FORMAT_R32_UINT);
+    }
     
     // インデックスバッファビューの設定
     indexBufferView_.BufferLocation = indexBuffer_->GetGPUVirtualAddress();
-    indexBufferView_.SizeInBytes = static_cast<UINT>(sizeof(uint32_t) * modelData.indices.size());
-    indexBufferView_.Format = DXGI_FORMAT_R32_UINT;
-    
-    // インデックスデータをGPUメモリにコピー
-    void* mappedIndex = nullptr;
-    indexBuffer_->Map(0, nullptr, &mappedIndex);
-    memcpy(mappedIndex, modelData.indices.data(), sizeof(uint32_t) * modelData.indices.size());
-    indexBuffer_->Unmap(0, nullptr);
     
     // ファイルパスを保存（デバッグ用）
     filePath_ = directoryPath + "/" + filename;
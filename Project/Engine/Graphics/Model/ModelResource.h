@@ -2,13 +2,16 @@
 
 #include <d3d12.h>
 #include <wrl.h>
+#include <filesystem>
 #include <string>
 #include <map>
 #include <optional>
+#include <vector>
 
 #include "Engine/Graphics/Structs/MaterialData.h"
 #include "Engine/Graphics/Structs/ModelData.h"
 #include "Engine/Graphics/Structs/Node.h"
+#include "MeshLod.h"
 #include "Animation/Animation.h"
 #include "Skeleton/Skeleton.h"
 
@@ -37,7 +40,10 @@ public:
 	/// @brief モデルファイルの読み込みとGPU転送（OBJ、glTF、FBXなど対応）
 	/// @param directoryPath ディレクトリパス
 	/// @param filename ファイル名
-	void LoadFromFile(const std::string& directoryPath, const std::string& filename);
+	/// @param cookCacheDirectory 最適化済みモデルを置くディレクトリ（空なら毎回最適化する）
+	/// @details 頂点の結合・三角形の並べ替え・LODの生成を行い、頂点数が収まればインデックスを16bitにする。
+	void LoadFromFile(const std::string& directoryPath, const std::string& filename,
+		const std::filesystem::path& cookCacheDirectory = {});
 
 	/// @brief GPUリソースが作成されているか確認
 	/// @return リソースが有効ならtrue
@@ -51,6 +57,18 @@ public:
 	/// @return 頂点数
 	UINT GetVertexCount() const { return vertexCount_; }
 
+	/// @brief LODの数を取得（LOD0を含む）
+	/// @return LODの数
+	uint32_t GetLodCount() const { return static_cast<uint32_t>(lods_.size()); }
+
+	/// @brief 全LODを取得（粗くなる順）
+	/// @return LODの配列
+	const std::vector<MeshLod>& GetLods() const { return lods_; }
+
+	/// @brief ローカル原点を中心としたバウンディング半径を取得
+	/// @return 全頂点を含む球の半径
+	float GetBoundingRadius() const { return boundingRadius_; }
+
 	/// @brief RootNodeを取得
 	/// @return RootNode
 	const Node& GetRootNode() const { return rootNode_; }
@@ -92,6 +110,11 @@ private:
 	Microsoft::WRL::ComPtr<ID3D12Resource> indexBuffer_;
 	D3D12_INDEX_BUFFER_VIEW indexBufferView_{};
 	UINT indexCount_ = 0;
+
+	// LOD（インデックスバッファの先頭がLOD0、続けて粗いLODを置く）
+	std::vector<MeshLod> lods_;
+
+	float boundingRadius_ = 0.0f;
 	
 	ModelData modelData_;
 	MaterialData materialData_;
@@ -30,7 +30,7 @@ SkinCluster SkinClusterGenerator::CreateSkinCluster(
 	paletteSrvDesc.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
 	paletteSrvDesc.Buffer.NumElements = UINT(skeleton.joints.size());
 	paletteSrvDesc.Buffer.StructureByteStride = sizeof(WellForGPU);
-	descriptorManager->CreateSRV(skinCluster.paletteResource.Get(), paletteSrvDesc,
+	skinCluster.paletteSrvAllocation = descriptorManager->CreateSRV(skinCluster.paletteResource.Get(), paletteSrvDesc,
 		skinCluster.paletteSrvHandle.first, skinCluster.paletteSrvHandle.second, "SkinCluster Palette");
 
 	// influence用のResourceを確保。頂点ごとにinfluence情報を追加できるようにする
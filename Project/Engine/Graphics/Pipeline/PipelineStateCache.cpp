@@ -0,0 +1,330 @@
+#include "PipelineStateCache.h"
+
+#include <format>
+#include <fstream>
+#include <iterator>
+
+#include "Utility/Logger/Logger.h"
+
+namespace {
+    /// @brief シェーダーのバイトコードを加える
+    void AddShader(PipelineStateHasher& hasher, const D3D12_SHADER_BYTECODE& shader)
+    {
+        hasher.AddBytes(shader.pShaderBytecode, shader.pShaderBytecode ? shader.BytecodeLength : 0);
+    }
+
+    /// @brief ステンシルの操作を加える
+    void AddStencilOp(PipelineStateHasher& hasher, const D3D12_DEPTH_STENCILOP_DESC& op)
+    {
+        hasher.Add(static_cast<uint32_t>(op.StencilFailOp))
+            .Add(static_cast<uint32_t>(op.StencilDepthFailOp))
+            .Add(static_cast<uint32_t>(op.StencilPassOp))
+            .Add(static_cast<uint32_t>(op.StencilFunc));
+    }
+}
+
+PipelineStateCache& PipelineStateCache::GetInstance()
+{
+    static PipelineStateCache instance;
+    return instance;
+}
+
+void PipelineStateCache::Initialize(const std::filesystem::path& cacheDirectory)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    cacheDirectory_ = cacheDirectory;
+
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDirectory_, ec);
+    if (ec) {
+        // 保存できなくてもメモリ上の重複除去は使える
+        Logger::GetInstance().Log("Failed to create pipeline cache directory: " + ec.message(), LogLevel::WARNING, LogCategory::Graphics);
+    }
+
+    // 前回保存したライブラリを読み込む（デバイスが来るまで作成は待つ）
+    std::ifstream file(GetLibraryPath(), std::ios::binary);
+    if (file) {
+        libraryFile_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        if (!PipelineStateFormat::DeserializeLibrary(libraryFile_, libraryOffset_, librarySize_)) {
+            Logger::GetInstance().Log("Pipeline library file is invalid and will be rebuilt", LogLevel::WARNING, LogCategory::Graphics);
+            libraryFile_.clear();
+            libraryOffset_ = 0;
+            librarySize_ = 0;
+        }
+    }
+
+    initialized_ = true;
+}
+
+void PipelineStateCache::Finalize()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!initialized_) {
+        return;
+    }
+
+    // 追加したPSOがあればライブラリを保存
+    if (library_ && libraryDirty_) {
+        std::vector<uint8_t> serialized(library_->GetSerializedSize());
+        HRESULT hr = library_->Serialize(serialized.data(), serialized.size());
+        if (SUCCEEDED(hr)) {
+            std::vector<uint8_t> bytes = PipelineStateFormat::SerializeLibrary(serialized.data(), serialized.size());
+
+            // 書き込み途中のファイルを読まないよう、一時ファイルに書いてから置き換える
+            std::filesystem::path path = GetLibraryPath();
+            std::filesystem::path tempPath = path;
+            tempPath += ".tmp";
+            bool written = false;
+            {
+                std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+                if (file) {
+                    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+                    written = static_cast<bool>(file);
+                }
+            }
+            std::error_code ec;
+            if (written) {
+                std::filesystem::rename(tempPath, path, ec);
+            }
+            if (!written || ec) {
+                std::filesystem::remove(tempPath, ec);
+            }
+        } else {
+            Logger::GetInstance().Log(std::format("Failed to serialize pipeline library: 0x{:08X}", static_cast<uint32_t>(hr)),
+                LogLevel::WARNING, LogCategory::Graphics);
+        }
+    }
+
+    Statistics statistics = statistics_;
+    auto table = pipelineStates_.GetStatistics();
+    Logger::GetInstance().Log(
+        std::format("PipelineStateCache: {} PSOs, {} reused, {} from library, {} compiled, {} failed",
+            table.entryCount, table.hitCount, statistics.libraryHitCount, statistics.createCount, statistics.failedCount),
+        LogLevel::INFO, LogCategory::Graphics);
+
+    // ライブラリより先にPSOを解放する
+    pipelineStates_.Clear();
+    library_.Reset();
+    libraryFile_.clear();
+    libraryOffset_ = 0;
+    librarySize_ = 0;
+    libraryCreated_ = false;
+    libraryDirty_ = false;
+    rootSignatureKeys_.clear();
+    statistics_ = {};
+    initialized_ = false;
+}
+
+void PipelineStateCache::RegisterRootSignature(ID3D12RootSignature* rootSignature, const void* serialized, size_t size)
+{
+    if (!rootSignature) {
+        return;
+    }
+    uint64_t key = ShaderCacheFormat::HashBytes(serialized, size);
+
+    // 同じポインタが別の内容で作り直された場合も上書きする
+    std::lock_guard<std::mutex> lock(mutex_);
+    rootSignatureKeys_[rootSignature] = key;
+}
+
+ID3D12PipelineState* PipelineStateCache::GetOrCreate(ID3D12Device* device, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc)
+{
+    bool persistent = false;
+    uint64_t key = ComputeKey(desc, &persistent);
+
+    Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState = pipelineStates_.GetOrCreate(key, [&]() {
+        return Create(device, desc, key, persistent);
+    });
+
+    // 表が参照を持ち続けるので、返したポインタは Finalize まで有効
+    return pipelineState.Get();
+}
+
+uint64_t PipelineStateCache::ComputeKey(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, bool* outPersistent) const
+{
+    PipelineStateHasher hasher;
+    hasher.Add(PipelineStateFormat::kFormatVersion);
+
+    // ルートシグネチャ（登録済みなら内容、未登録ならポインタ値）
+    bool persistent = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = rootSignatureKeys_.find(desc.pRootSignature);
+        if (it != rootSignatureKeys_.end()) {
+            hasher.Add(it->second);
+            persistent = true;
+        } else {
+            hasher.Add(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(desc.pRootSignature)));
+        }
+    }
+    hasher.Add(static_cast<uint32_t>(persistent));
+    if (outPersistent) {
+        *outPersistent = persistent;
+    }
+
+    // シェーダー
+    AddShader(hasher, desc.VS);
+    AddShader(hasher, desc.PS);
+    AddShader(hasher, desc.DS);
+    AddShader(hasher, desc.HS);
+    AddShader(hasher, desc.GS);
+    hasher.Add(desc.StreamOutput.NumEntries);
+
+    // ブレンド
+    hasher.Add(static_cast<int32_t>(desc.BlendState.AlphaToCoverageEnable))
+        .Add(static_cast<int32_t>(desc.BlendState.IndependentBlendEnable));
+    for (const D3D12_RENDER_TARGET_BLEND_DESC& blend : desc.BlendState.RenderTarget) {
+        hasher.Add(static_cast<int32_t>(blend.BlendEnable))
+            .Add(static_cast<int32_t>(blend.LogicOpEnable))
+            .Add(static_cast<uint32_t>(blend.SrcBlend))
+            .Add(static_cast<uint32_t>(blend.DestBlend))
+            .Add(static_cast<uint32_t>(blend.BlendOp))
+            .Add(static_cast<uint32_t>(blend.SrcBlendAlpha))
+            .Add(static_cast<uint32_t>(blend.DestBlendAlpha))
+            .Add(static_cast<uint32_t>(blend.BlendOpAlpha))
+            .Add(static_cast<uint32_t>(blend.LogicOp))
+            .Add(static_cast<uint32_t>(blend.RenderTargetWriteMask));
+    }
+    hasher.Add(static_cast<uint32_t>(desc.SampleMask));
+
+    // ラスタライザ
+    const D3D12_RASTERIZER_DESC& rasterizer = desc.RasterizerState;
+    hasher.Add(static_cast<uint32_t>(rasterizer.FillMode))
+        .Add(static_cast<uint32_t>(rasterizer.CullMode))
+        .Add(static_cast<int32_t>(rasterizer.FrontCounterClockwise))
+        .Add(static_cast<int32_t>(rasterizer.DepthBias))
+        .Add(rasterizer.DepthBiasClamp)
+        .Add(rasterizer.SlopeScaledDepthBias)
+        .Add(static_cast<int32_t>(rasterizer.DepthClipEnable))
+        .Add(static_cast<int32_t>(rasterizer.MultisampleEnable))
+        .Add(static_cast<int32_t>(rasterizer.AntialiasedLineEnable))
+        .Add(static_cast<uint32_t>(rasterizer.ForcedSampleCount))
+        .Add(static_cast<uint32_t>(rasterizer.ConservativeRaster));
+
+    // 深度ステンシル
+    const D3D12_DEPTH_STENCIL_DESC& depthStencil = desc.DepthStencilState;
+    hasher.Add(static_cast<int32_t>(depthStencil.DepthEnable))
+        .Add(static_cast<uint32_t>(depthStencil.DepthWriteMask))
+        .Add(static_cast<uint32_t>(depthStencil.DepthFunc))
+        .Add(static_cast<int32_t>(depthStencil.StencilEnable))
+        .Add(static_cast<uint32_t>(depthStencil.StencilReadMask))
+        .Add(static_cast<uint32_t>(depthStencil.StencilWriteMask));
+    AddStencilOp(hasher, depthStencil.FrontFace);
+    AddStencilOp(hasher, depthStencil.BackFace);
+
+    // 入力レイアウト（セマンティック名はポインタではなく文字列で）
+    hasher.Add(static_cast<uint32_t>(desc.InputLayout.NumElements));
+    for (UINT i = 0; i < desc.InputLayout.NumElements; ++i) {
+        const D3D12_INPUT_ELEMENT_DESC& element = desc.InputLayout.pInputElementDescs[i];
+        hasher.AddString(element.SemanticName)
+            .Add(static_cast<uint32_t>(element.SemanticIndex))
+            .Add(static_cast<uint32_t>(element.Format))
+            .Add(static_cast<uint32_t>(element.InputSlot))
+            .Add(static_cast<uint32_t>(element.AlignedByteOffset))
+            .Add(static_cast<uint32_t>(element.InputSlotClass))
+            .Add(static_cast<uint32_t>(element.InstanceDataStepRate));
+    }
+    hasher.Add(static_cast<uint32_t>(desc.IBStripCutValue))
+        .Add(static_cast<uint32_t>(desc.PrimitiveTopologyType));
+
+    // 出力先
+    hasher.Add(static_cast<uint32_t>(desc.NumRenderTargets));
+    for (DXGI_FORMAT format : desc.RTVFormats) {
+        hasher.Add(static_cast<uint32_t>(format));
+    }
+    hasher.Add(static_cast<uint32_t>(desc.DSVFormat))
+        .Add(static_cast<uint32_t>(desc.SampleDesc.Count))
+        .Add(static_cast<uint32_t>(desc.SampleDesc.Quality))
+        .Add(static_cast<uint32_t>(desc.NodeMask))
+        .Add(static_cast<uint32_t>(desc.Flags));
+
+    return hasher.GetHash();
+}
+
+PipelineStateCache::Statistics PipelineStateCache::GetStatistics() const
+{
+    auto table = pipelineStates_.GetStatistics();
+    std::lock_guard<std::mutex> lock(mutex_);
+    Statistics statistics = statistics_;
+    statistics.memoryHitCount = table.hitCount;
+    statistics.entryCount = table.entryCount;
+    statistics.libraryAvailable = library_ != nullptr;
+    return statistics;
+}
+
+void PipelineStateCache::CreateLibrary(ID3D12Device* device)
+{
+    libraryCreated_ = true;
+
+    Microsoft::WRL::ComPtr<ID3D12Device1> device1;
+    if (FAILED(device->QueryInterface(IID_PPV_ARGS(&device1)))) {
+        return;
+    }
+
+    // 保存済みのライブラリを使う（ドライバー・アダプターが変わっていれば失敗する）
+    if (librarySize_ > 0) {
+        HRESULT hr = device1->CreatePipelineLibrary(libraryFile_.data() + libraryOffset_, librarySize_, IID_PPV_ARGS(&library_));
+        if (SUCCEEDED(hr)) {
+            return;
+        }
+        Logger::GetInstance().Log(std::format("Pipeline library is out of date and will be rebuilt: 0x{:08X}", static_cast<uint32_t>(hr)),
+            LogLevel::INFO, LogCategory::Graphics);
+        library_.Reset();
+        libraryFile_.clear();
+        libraryOffset_ = 0;
+        librarySize_ = 0;
+        libraryDirty_ = true;
+    }
+
+    // 空のライブラリを作成（対応していないドライバーならライブラリなしで続ける）
+    if (FAILED(device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&library_)))) {
+        library_.Reset();
+    }
+}
+
+Microsoft::WRL::ComPtr<ID3D12PipelineState> PipelineStateCache::Create(
+    ID3D12Device* device, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, uint64_t key, bool persistent)
+{
+    ID3D12PipelineLibrary* library = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (initialized_ && !libraryCreated_) {
+            CreateLibrary(device);
+        }
+        // 起動ごとにキーが変わるものはライブラリに入れない
+        if (persistent) {
+            library = library_.Get();
+        }
+    }
+
+    // ライブラリにあれば読み込む（記述が一致しなければ失敗するのでコンパイルする）
+    // ID3D12PipelineLibrary はスレッドセーフなのでロックの外で使う
+    std::wstring name = PipelineStateFormat::ToPipelineName(key);
+    Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState;
+    if (library && SUCCEEDED(library->LoadGraphicsPipeline(name.c_str(), &desc, IID_PPV_ARGS(&pipelineState)))) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++statistics_.libraryHitCount;
+        return pipelineState;
+    }
+
+    HRESULT hr = device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&pipelineState));
+    if (FAILED(hr)) {
+        Logger::GetInstance().Log(std::format("Failed to create pipeline state {}: 0x{:08X}", ShaderCacheFormat::ToHexString(key), static_cast<uint32_t>(hr)),
+            LogLevel::Error, LogCategory::Graphics);
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++statistics_.failedCount;
+        return nullptr;
+    }
+
+    bool stored = library && SUCCEEDED(library->StorePipeline(name.c_str(), pipelineState.Get()));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++statistics_.createCount;
+    libraryDirty_ = libraryDirty_ || stored;
+    return pipelineState;
+}
+
+std::filesystem::path PipelineStateCache::GetLibraryPath() const
+{
+    return cacheDirectory_ / "Pipelines.bin";
+}
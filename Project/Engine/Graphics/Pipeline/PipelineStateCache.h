@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <d3d12.h>
+#include <wrl.h>
+
+#include "PipelineStateHash.h"
+
+/// @brief 全レンダラーで共有するパイプラインステート（PSO）のキャッシュ
+/// @details PSOを記述全体（ルートシグネチャ・シェーダー・入力レイアウト・ラスタライザ・深度・ブレンド・
+/// レンダーターゲットのフォーマット）のハッシュで管理し、同じ記述のPSOはレンダラーをまたいで1つだけ作る。
+/// 作成したPSOはパイプラインライブラリ（Cache/Pipeline/Pipelines.bin）に保存し、次回起動時はドライバーの
+/// コンパイルを省略して読み込む。ドライバーが変わってライブラリが使えない場合は空のライブラリから作り直す。
+class PipelineStateCache {
+public:
+    /// @brief 統計情報
+    struct Statistics {
+        uint32_t memoryHitCount = 0;  ///< 作成済みのPSOを使った回数
+        uint32_t libraryHitCount = 0; ///< パイプラインライブラリから読み込んだ回数
+        uint32_t createCount = 0;     ///< ドライバーでコンパイルした回数
+        uint32_t failedCount = 0;     ///< 作成に失敗した回数
+        uint32_t entryCount = 0;      ///< 保持しているPSOの数
+        bool libraryAvailable = false; ///< パイプラインライブラリを使えるか
+    };
+
+    /// @brief インスタンスを取得
+    static PipelineStateCache& GetInstance();
+
+    /// @brief 初期化（保存済みのパイプラインライブラリを読み込む。ライブラリはデバイスが渡されたときに作る）
+    /// @param cacheDirectory キャッシュファイルを置くディレクトリ
+    void Initialize(const std::filesystem::path& cacheDirectory);
+
+    /// @brief 終了処理（パイプラインライブラリを保存し、全てのPSOを解放する）
+    void Finalize();
+
+    /// @brief ルートシグネチャを登録（キーにはポインタではなくシリアライズした内容を使う）
+    /// @param rootSignature ルートシグネチャ
+    /// @param serialized シリアライズしたバイナリ
+    /// @param size バイト数
+    void RegisterRootSignature(ID3D12RootSignature* rootSignature, const void* serialized, size_t size);
+
+    /// @brief PSOを取得（なければライブラリから読み込むか作成）
+    /// @param device デバイス
+    /// @param desc PSOの記述
+    /// @return PSO（キャッシュが保持する。失敗した場合はnullptr）
+    ID3D12PipelineState* GetOrCreate(ID3D12Device* device, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc);
+
+    /// @brief PSOの記述からキーを計算
+    /// @param desc PSOの記述
+    /// @param outPersistent 起動をまたいで同じキーになるか（未登録のルートシグネチャはポインタ値を使うのでfalse）
+    uint64_t ComputeKey(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, bool* outPersistent = nullptr) const;
+
+    /// @brief 統計情報を取得
+    Statistics GetStatistics() const;
+
+private:
+    PipelineStateCache() = default;
+    ~PipelineStateCache() = default;
+    PipelineStateCache(const PipelineStateCache&) = delete;
+    PipelineStateCache& operator=(const PipelineStateCache&) = delete;
+
+    /// @brief パイプラインライブラリを作成（初回のみ。保存済みのものが使えなければ空で作る）
+    void CreateLibrary(ID3D12Device* device);
+
+    /// @brief PSOを作成（ライブラリにあれば読み込み、なければコンパイルしてライブラリに追加）
+    Microsoft::WRL::ComPtr<ID3D12PipelineState> Create(
+        ID3D12Device* device, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, uint64_t key, bool persistent);
+
+    /// @brief ライブラリファイルのパス
+    std::filesystem::path GetLibraryPath() const;
+
+    std::filesystem::path cacheDirectory_;
+    bool initialized_ = false;
+
+    PipelineStateTable<Microsoft::WRL::ComPtr<ID3D12PipelineState>> pipelineStates_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<ID3D12RootSignature*, uint64_t> rootSignatureKeys_; // ルートシグネチャ -> 内容のハッシュ
+    std::vector<uint8_t> libraryFile_;       // 読み込んだライブラリファイル（ライブラリが参照するので保持する）
+    size_t libraryOffset_ = 0;
+    size_t librarySize_ = 0;
+    Microsoft::WRL::ComPtr<ID3D12PipelineLibrary> library_;
+    bool libraryCreated_ = false;
+    bool libraryDirty_ = false;              // 前回から追加したPSOがあるか
+    Statistics statistics_;
+};
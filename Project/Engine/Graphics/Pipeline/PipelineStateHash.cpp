@@ -0,0 +1,80 @@
+#include "PipelineStateHash.h"
+
+#include <cstring>
+
+// ===== PipelineStateHasher =====
+
+PipelineStateHasher& PipelineStateHasher::Add(uint32_t value)
+{
+    hash_ = ShaderCacheFormat::HashBytes(&value, sizeof(value), hash_);
+    return *this;
+}
+
+PipelineStateHasher& PipelineStateHasher::Add(int32_t value)
+{
+    return Add(static_cast<uint32_t>(value));
+}
+
+PipelineStateHasher& PipelineStateHasher::Add(uint64_t value)
+{
+    hash_ = ShaderCacheFormat::HashBytes(&value, sizeof(value), hash_);
+    return *this;
+}
+
+PipelineStateHasher& PipelineStateHasher::Add(float value)
+{
+    if (value == 0.0f) {
+        value = 0.0f;
+    }
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return Add(bits);
+}
+
+PipelineStateHasher& PipelineStateHasher::AddBytes(const void* data, size_t size)
+{
+    Add(static_cast<uint64_t>(size));
+    if (size > 0) {
+        hash_ = ShaderCacheFormat::HashBytes(data, size, hash_);
+    }
+    return *this;
+}
+
+PipelineStateHasher& PipelineStateHasher::AddString(const char* text)
+{
+    if (text == nullptr) {
+        return Add(UINT64_MAX);
+    }
+    return AddBytes(text, std::strlen(text));
+}
+
+// ===== PipelineStateFormat =====
+
+namespace PipelineStateFormat {
+
+    namespace {
+        /// @brief ライブラリファイルのキー（キャッシュファイルの形式を流用し、種類とバージョンの確認に使う）
+        uint64_t GetLibraryFileKey()
+        {
+            const char kTag[] = "PipelineLibrary";
+            uint64_t key = ShaderCacheFormat::HashBytes(kTag, sizeof(kTag));
+            return ShaderCacheFormat::HashBytes(&kFormatVersion, sizeof(kFormatVersion), key);
+        }
+    }
+
+    std::wstring ToPipelineName(uint64_t key)
+    {
+        std::string hex = ShaderCacheFormat::ToHexString(key);
+        return L"PSO_" + std::wstring(hex.begin(), hex.end());
+    }
+
+    std::vector<uint8_t> SerializeLibrary(const void* data, size_t size)
+    {
+        return ShaderCacheFormat::SerializeBlob(GetLibraryFileKey(), data, size);
+    }
+
+    bool DeserializeLibrary(const std::vector<uint8_t>& bytes, size_t& outOffset, size_t& outSize)
+    {
+        return ShaderCacheFormat::DeserializeBlob(bytes, GetLibraryFileKey(), outOffset, outSize);
+    }
+}
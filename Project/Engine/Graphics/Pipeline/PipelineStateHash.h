@@ -0,0 +1,143 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Engine/Graphics/Shader/ShaderCacheFormat.h"
+
+/// @brief パイプラインステートのキー計算（D3D12に依存しない）
+/// @details 構造体をそのままハッシュするとパディングやポインタ値が混ざるので、値を1つずつ加える。
+/// 可変長のもの（シェーダー・文字列）は長さも加え、並びが違えば別のキーになるようにする。
+class PipelineStateHasher {
+public:
+    PipelineStateHasher& Add(uint32_t value);
+    PipelineStateHasher& Add(int32_t value);
+    PipelineStateHasher& Add(uint64_t value);
+
+    /// @brief 浮動小数点数を加える（-0 と +0 は同じ値として扱う）
+    PipelineStateHasher& Add(float value);
+
+    /// @brief バイト列を加える（シェーダーのバイトコードなど）
+    PipelineStateHasher& AddBytes(const void* data, size_t size);
+
+    /// @brief 文字列を加える（nullptr と "" は区別する）
+    PipelineStateHasher& AddString(const char* text);
+
+    /// @brief 現在のハッシュ値
+    uint64_t GetHash() const { return hash_; }
+
+private:
+    uint64_t hash_ = ShaderCacheFormat::kHashSeed;
+};
+
+/// @brief パイプラインライブラリのファイル形式
+namespace PipelineStateFormat {
+
+    /// @brief キー計算・ファイル形式のバージョン（ハッシュする項目を変えたら上げる）
+    constexpr uint32_t kFormatVersion = 1;
+
+    /// @brief キーをパイプラインライブラリ内の名前にする
+    std::wstring ToPipelineName(uint64_t key);
+
+    /// @brief パイプラインライブラリをファイルの形式にする
+    std::vector<uint8_t> SerializeLibrary(const void* data, size_t size);
+
+    /// @brief ファイルからパイプラインライブラリを取り出す
+    /// @param bytes ファイルの内容
+    /// @param outOffset ライブラリの先頭位置
+    /// @param outSize ライブラリのバイト数
+    /// @return 形式・バージョン・チェックサムが一致すればtrue
+    bool DeserializeLibrary(const std::vector<uint8_t>& bytes, size_t& outOffset, size_t& outSize);
+}
+
+/// @brief キーで重複を除くパイプラインステートの表（D3D12に依存しない）
+/// @details 同じキーを複数のスレッドが同時に要求しても生成は1回だけ行い、他のスレッドはその結果を待つ。
+/// 生成に失敗した（空の値を返した）キーは登録しないので、次の要求で再び生成する。
+/// @tparam T 値（ComPtrなど。bool に変換でき、コピーできること）
+template<typename T>
+class PipelineStateTable {
+public:
+    /// @brief 統計
+    struct Statistics {
+        uint32_t hitCount = 0;    ///< 登録済みの値を返した回数（生成中のものを待った場合を含む）
+        uint32_t createCount = 0; ///< 生成した回数
+        uint32_t failedCount = 0; ///< 生成に失敗した回数
+        uint32_t entryCount = 0;  ///< 登録数
+    };
+
+    /// @brief 取得（なければ生成して登録）
+    /// @param key キー
+    /// @param create 生成関数（T を返す。失敗したら空の値）
+    template<typename Factory>
+    T GetOrCreate(uint64_t key, Factory&& create)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            ++statistics_.hitCount;
+            std::shared_future<T> future = it->second;
+            lock.unlock();
+            return future.get();
+        }
+        std::promise<T> promise;
+        entries_.emplace(key, promise.get_future().share());
+        lock.unlock();
+
+        // 生成はロックの外で行う（他のキーの取得を止めない）
+        T value;
+        try {
+            value = create();
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+            lock.lock();
+            ++statistics_.failedCount;
+            entries_.erase(key);
+            throw;
+        }
+        promise.set_value(value);
+
+        lock.lock();
+        if (value) {
+            ++statistics_.createCount;
+        } else {
+            ++statistics_.failedCount;
+            entries_.erase(key);
+        }
+        return value;
+    }
+
+    /// @brief 登録済みか（生成中のものを含む）
+    bool Contains(uint64_t key) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.contains(key);
+    }
+
+    /// @brief 全て破棄（生成中のものがないときに呼ぶ）
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+        statistics_ = {};
+    }
+
+    /// @brief 統計を取得
+    Statistics GetStatistics() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Statistics statistics = statistics_;
+        statistics.entryCount = static_cast<uint32_t>(entries_.size());
+        return statistics;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, std::shared_future<T>> entries_;
+    Statistics statistics_;
+};
@@ -1,4 +1,5 @@
 #include "PipelineStateManager.h"
+#include "Engine/Graphics/Pipeline/PipelineStateCache.h"
 
 #include <cassert>
 #include <stdexcept>
@@ -148,17 +149,13 @@ bool PipelineStateBuilder::Build(
 		targetModes.push_back(BlendMode::kBlendModeNone);
 	}
 
-	for (BlendMode mode : targetModes) {
-		D3D12_GRAPHICS_PIPELINE_STATE_DESC desc = CreatePipelineStateDesc(vs, ps, rootSignature, mode);
-
-		ComPtr<ID3D12PipelineState> pipelineState;
-		HRESULT result = device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&pipelineState));
+	manager_->SetSource(*this, device, vs, ps, rootSignature, targetModes);
 
-		if (FAILED(result)) {
+	// 指定されたモードはここで作成する
+	for (BlendMode mode : targetModes) {
+		if (!manager_->GetPipelineState(mode)) {
 			return false;
 		}
-
-		manager_->RegisterPipelineState(mode, pipelineState);
 	}
 
 	return true;
@@ -179,7 +176,10 @@ bool PipelineStateBuilder::BuildAllBlendModes(
 		BlendMode::kBlendModeScreen
 	};
 
-	return Build(device, vs, ps, rootSignature, allModes);
+	manager_->SetSource(*this, device, vs, ps, rootSignature, allModes);
+
+	// 設定の確認のため1つだけ作成し、他のモードは使われたときに作成する
+	return manager_->GetPipelineState(BlendMode::kBlendModeNone) != nullptr;
 }
 
 D3D12_BLEND_DESC PipelineStateBuilder::CreateBlendDesc(BlendMode mode) const
@@ -303,13 +303,47 @@ D3D12_GRAPHICS_PIPELINE_STATE_DESC PipelineStateBuilder::CreatePipelineStateDesc
 // PSOマネージャークラス
 // ================================================================================
 
+PipelineStateManager::PipelineStateManager(PipelineStateManager&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+PipelineStateManager& PipelineStateManager::operator=(PipelineStateManager&& other) noexcept
+{
+	if (this != &other) {
+		source_ = std::move(other.source_);
+		availableModes_.store(other.availableModes_.exchange(0));
+		for (size_t i = 0; i < kBlendModeCount; ++i) {
+			pipelineStates_[i].store(other.pipelineStates_[i].exchange(nullptr));
+		}
+	}
+	return *this;
+}
+
 ID3D12PipelineState* PipelineStateManager::GetPipelineState(BlendMode mode)
 {
-	auto it = pipelineStates_.find(mode);
-	if (it != pipelineStates_.end()) {
-		return it->second.Get();
+	size_t index = static_cast<size_t>(mode);
+	if (index >= kBlendModeCount || (availableModes_.load(std::memory_order_acquire) & (1u << index)) == 0) {
+		return nullptr;
+	}
+
+	ID3D12PipelineState* pipelineState = pipelineStates_[index].load(std::memory_order_acquire);
+	if (pipelineState) {
+		return pipelineState;
+	}
+
+	// 初めて使われたモードを作成（同時に呼ばれてもキャッシュが1つにまとめる）
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC desc = source_->builder.CreatePipelineStateDesc(
+		source_->vs.Get(), source_->ps.Get(), source_->rootSignature.Get(), mode);
+	pipelineState = PipelineStateCache::GetInstance().GetOrCreate(source_->device, desc);
+	if (!pipelineState) {
+		// 失敗したモードは以降作成しない（毎フレームのエラーログを避ける）
+		availableModes_.fetch_and(~(1u << index));
+		return nullptr;
 	}
-	return nullptr;
+
+	pipelineStates_[index].store(pipelineState, std::memory_order_release);
+	return pipelineState;
 }
 
 PipelineStateBuilder PipelineStateManager::CreateBuilder()
@@ -319,10 +353,24 @@ PipelineStateBuilder PipelineStateManager::CreateBuilder()
 
 void PipelineStateManager::Clear()
 {
-	pipelineStates_.clear();
+	availableModes_.store(0);
+	for (auto& pipelineState : pipelineStates_) {
+		pipelineState.store(nullptr);
+	}
+	source_.reset();
 }
 
-void PipelineStateManager::RegisterPipelineState(BlendMode mode, ComPtr<ID3D12PipelineState> pso)
+void PipelineStateManager::SetSource(const PipelineStateBuilder& builder, ID3D12Device* device, IDxcBlob* vs, IDxcBlob* ps,
+	ID3D12RootSignature* rootSignature, const std::vector<BlendMode>& modes)
 {
-	pipelineStates_[mode] = pso;
+	assert(device && vs && ps && rootSignature);
+	Clear();
+
+	source_ = std::make_unique<Source>(Source{ builder, device, vs, ps, rootSignature });
+
+	uint32_t availableModes = 0;
+	for (BlendMode mode : modes) {
+		availableModes |= 1u << static_cast<uint32_t>(mode);
+	}
+	availableModes_.store(availableModes, std::memory_order_release);
 }
@@ -2,7 +2,10 @@
 
 #include <d3d12.h>
 #include <dxcapi.h>
+#include <array>
+#include <atomic>
 #include <map>
+#include <memory>
 #include <vector>
 #include <wrl.h>
 
@@ -17,6 +20,9 @@ enum class BlendMode {
     kBlendModeScreen, // スクリーンブレンド
 };
 
+// ブレンドモードの数
+constexpr size_t kBlendModeCount = static_cast<size_t>(BlendMode::kBlendModeScreen) + 1;
+
 // 前方宣言
 class PipelineStateManager;
 
@@ -26,7 +32,7 @@ public:
     explicit PipelineStateBuilder(PipelineStateManager* manager);
 
     /// @brief 入力エレメントを追加
-    /// @param semanticName セマンティック名
+    /// @param semanticName セマンティック名（PSOは後から作成されることがあるので、文字列リテラルを渡す）
     /// @param semanticIndex インデックス
     /// @param format フォーマット
     /// @param alignedByteOffset アライメントされたバイトオフセット
@@ -92,6 +98,7 @@ public:
         bool enableAlpha = true);
 
     /// @brief ブレンドモードを指定してPSOを構築
+    /// @details 指定したモードのPSOはここで作成する（同じ記述のPSOは PipelineStateCache で共有される）
     /// @param device デバイス
     /// @param vs 頂点シェーダー
     /// @param ps ピクセルシェーダー
@@ -106,6 +113,7 @@ public:
         const std::vector<BlendMode>& modes = {});
 
     /// @brief 全ブレンドモードでPSOを構築
+    /// @details 設定の確認のため kBlendModeNone だけをここで作成し、他のモードは初めて取得したときに作成する
     /// @param device デバイス
     /// @param vs 頂点シェーダー
     /// @param ps ピクセルシェーダー
@@ -148,29 +156,51 @@ private:
 };
 
 /// @brief psoの管理クラス
+/// @details PSOの実体は PipelineStateCache が持ち、ここではブレンドモードごとのポインタと作成に使う設定を持つ。
+/// 取得はレンダリングのワーカースレッドから同時に呼ばれてもよい。
 class PipelineStateManager {
 public:
     PipelineStateManager() = default;
     ~PipelineStateManager() = default;
 
-    /// @brief psoの取得
+    // ムーブのみ可能（パーミュテーションのキャッシュに値で入れるため）
+    PipelineStateManager(PipelineStateManager&& other) noexcept;
+    PipelineStateManager& operator=(PipelineStateManager&& other) noexcept;
+    PipelineStateManager(const PipelineStateManager&) = delete;
+    PipelineStateManager& operator=(const PipelineStateManager&) = delete;
+
+    /// @brief psoの取得（まだ作成していなければ作成する）
     /// @param mode ブレンドモード
-    /// @return パイプラインステート(存在しない場合はnullptr)
+    /// @return パイプラインステート(Build していないモード・作成に失敗した場合はnullptr)
     ID3D12PipelineState* GetPipelineState(BlendMode mode = BlendMode::kBlendModeNone);
 
     /// @brief ビルダーを取得
     /// @return PipelineStateBuilderのインスタンス
     PipelineStateBuilder CreateBuilder();
 
-    /// @brief PSOをクリア
+    /// @brief PSOをクリア（PSOの実体は他のマネージャーと共有しているので PipelineStateCache に残る）
     void Clear();
 
 private:
     friend class PipelineStateBuilder;
 
-    // パイプラインステート
-    std::map<BlendMode, ComPtr<ID3D12PipelineState>> pipelineStates_;
-
-    /// @brief PSOを登録
-    void RegisterPipelineState(BlendMode mode, ComPtr<ID3D12PipelineState> pso);
+    /// @brief PSOの作成に使う設定
+    struct Source {
+        PipelineStateBuilder builder;
+        ID3D12Device* device = nullptr;
+        ComPtr<IDxcBlob> vs;
+        ComPtr<IDxcBlob> ps;
+        ComPtr<ID3D12RootSignature> rootSignature;
+    };
+
+    // 作成に使う設定（Build で登録）
+    std::unique_ptr<Source> source_;
+    // 取得できるブレンドモード（ビット）
+    std::atomic<uint32_t> availableModes_ = 0;
+    // 作成済みのパイプラインステート（PipelineStateCache が保持）
+    std::array<std::atomic<ID3D12PipelineState*>, kBlendModeCount> pipelineStates_ = {};
+
+    /// @brief 設定を登録（作成済みのPSOは破棄する）
+    void SetSource(const PipelineStateBuilder& builder, ID3D12Device* device, IDxcBlob* vs, IDxcBlob* ps,
+        ID3D12RootSignature* rootSignature, const std::vector<BlendMode>& modes);
 };
@@ -44,6 +44,19 @@ public:
     /// @brief ImGuiでパラメータを調整
     void DrawImGui() override;
 
+    /// @brief グリッチフェード以外は自ピクセルの色だけを読むのでまとめて描画できる
+    bool IsPerPixel() const override
+    {
+        // グリッチフェードの色収差は周囲のピクセルを読む（シェーダーと同じ範囲で判定）
+        return !(params_.fadeType >= 3.5f && params_.fadeType < 4.5f);
+    }
+
+    /// @brief パラメータの定数バッファのアドレスを取得
+    D3D12_GPU_VIRTUAL_ADDRESS GetParamsGpuAddress() const override
+    {
+        return constantBuffer_ ? constantBuffer_->GetGPUVirtualAddress() : 0;
+    }
+
     /// @brief フェード強度を設定
     /// @param alpha フェード強度 (0.0 = 透明, 1.0 = 完全フェード)
     void SetFadeAlpha(float alpha);
@@ -7,6 +7,9 @@ public:
     /// @brief ImGuiでパラメータを調整
     void DrawImGui() override;
 
+    /// @brief 自ピクセルの色だけを読むのでまとめて描画できる
+    bool IsPerPixel() const override { return true; }
+
 protected:
     const std::wstring& GetPixelShaderPath() const override
     {
@@ -24,6 +24,15 @@ public:
     /// @brief ImGuiでパラメータを調整
     void DrawImGui() override;
 
+    /// @brief 自ピクセルの色だけを読むのでまとめて描画できる
+    bool IsPerPixel() const override { return true; }
+
+    /// @brief パラメータの定数バッファのアドレスを取得
+    D3D12_GPU_VIRTUAL_ADDRESS GetParamsGpuAddress() const override
+    {
+        return constantBuffer_ ? constantBuffer_->GetGPUVirtualAddress() : 0;
+    }
+
     /// @brief パラメータを取得
     /// @return パラメータ構造体の参照
     const SepiaParams& GetParams() const { return params_; }
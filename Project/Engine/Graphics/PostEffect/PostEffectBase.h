@@ -29,6 +29,13 @@ public:
     /// @return 有効ならtrue
     bool IsEnabled() const { return enabled_; }
 
+    /// @brief 自ピクセルの色だけを読むエフェクトか（隣接するもの同士を1回の描画にまとめられる）
+    virtual bool IsPerPixel() const { return false; }
+
+    /// @brief パラメータの定数バッファのアドレスを取得（まとめて描画する際に使用）
+    /// @return 定数バッファを持たない場合は0
+    virtual D3D12_GPU_VIRTUAL_ADDRESS GetParamsGpuAddress() const { return 0; }
+
 protected:
     virtual const std::wstring& GetPixelShaderPath() const = 0;
     virtual void BindOptionalCBVs(ID3D12GraphicsCommandList*/* commandList*/) { }
@@ -19,76 +19,6 @@
 #include "Engine/Utility/Debug/ImGui/ImguiManager.h"
 #include <cassert>
 
-// =============================================================================
-// PingPongBuffer実装
-// =============================================================================
-
-PostEffectManager::PingPongBuffer::PingPongBuffer(DirectXCommon* dxCommon, Render* render)
-	: dxCommon_(dxCommon)
-	, render_(render)
-	, currentInput_()
-	, currentOutputIndex_(1)
-{
-}
-
-void PostEffectManager::PingPongBuffer::Reset(D3D12_GPU_DESCRIPTOR_HANDLE input)
-{
-	currentInput_ = input;
-	currentOutputIndex_ = 1;
-}
-
-bool PostEffectManager::PingPongBuffer::ApplyEffect(PostEffectBase* effect)
-{
-	if (!effect || !effect->IsEnabled()) {
-		return false;
-	}
-
-	// エフェクトを現在の出力バッファに描画
-	render_->OffscreenPreDraw(currentOutputIndex_);
-	effect->Draw(currentInput_);
-	render_->OffscreenPostDraw(currentOutputIndex_);
-
-	// 今書き込んだバッファが次の入力になる
-	currentInput_ = GetSrvHandle(currentOutputIndex_);
-
-	// 次回の出力先を切り替え（ping-pong）
-	currentOutputIndex_ = (currentOutputIndex_ == 0) ? 1 : 0;
-
-	return true;
-}
-
-D3D12_GPU_DESCRIPTOR_HANDLE PostEffectManager::PingPongBuffer::GetCurrentOutput() const
-{
-	return currentInput_;
-}
-
-void PostEffectManager::PingPongBuffer::EnsureOutputInBuffer1(PostEffectBase* fullScreenEffect)
-{
-	// 最後に書き込まれたバッファを特定（currentOutputIndexは次回の出力先なので、その反対が最後の書き込み先）
-	int lastWrittenIndex = (currentOutputIndex_ == 0) ? 1 : 0;
-
-	// 既にバッファ1にある場合は何もしない
-	if (lastWrittenIndex == 1) {
-		return;
-	}
-
-	// バッファ0にある場合、バッファ1にコピー
-	render_->OffscreenPreDraw(1);
-	fullScreenEffect->Draw(currentInput_);
-	render_->OffscreenPostDraw(1);
-
-	// 出力を更新
-	currentInput_ = GetSrvHandle(1);
-	currentOutputIndex_ = 0; // 次回は0に書き込む
-}
-
-D3D12_GPU_DESCRIPTOR_HANDLE PostEffectManager::PingPongBuffer::GetSrvHandle(int index) const
-{
-	return (index == 0)
-		? dxCommon_->GetOffScreenSrvHandle()
-		: dxCommon_->GetOffScreen2SrvHandle();
-}
-
 // =============================================================================
 // PostEffectManager実装
 // =============================================================================
@@ -105,6 +35,10 @@ void PostEffectManager::Initialize(DirectXCommon* dxCommon, Render* render)
 
 	RegisterAllEffects();
 
+	// ピクセル単位のエフェクトをまとめるUberシェーダー
+	uberEffect_ = std::make_unique<UberPostEffect>();
+	uberEffect_->Initialize(directXCommon_);
+
 	// 最終テクスチャハンドルの初期化
 	finalDisplayHandle_ = directXCommon_->GetOffScreenSrvHandle();
 }
@@ -171,34 +105,160 @@ std::vector<std::string> PostEffectManager::CollectEnabledEffectNames(
 D3D12_GPU_DESCRIPTOR_HANDLE PostEffectManager::ExecuteEffectChain(
 	D3D12_GPU_DESCRIPTOR_HANDLE inputSrvHandle)
 {
-	// 有効なエフェクト名を収集
-	auto enabledNames = CollectEnabledEffectNames(effectChain_);
+	// グラフは1枚目のオフスクリーンを入力として構築している
+	assert(inputSrvHandle.ptr == GetPhysicalSrvHandle(0).ptr);
+
+	CompileEffectGraph();
 
-	// 有効なエフェクトがない場合は入力をそのまま返す
-	if (enabledNames.empty()) {
+	// 実行するパスがない（またはコンパイル失敗）場合は入力をそのまま返す
+	if (!compiledGraph_.valid || compiledGraph_.passes.empty()) {
 		finalDisplayHandle_ = inputSrvHandle;
 		return inputSrvHandle;
 	}
 
-	// Ping-Pongバッファで順次エフェクトを適用
-	PingPongBuffer pingPong(directXCommon_, render_);
-	pingPong.Reset(inputSrvHandle);
-
-	for (const auto& name : enabledNames) {
-		if (auto* effect = GetEffectInternal(name)) {
-			pingPong.ApplyEffect(effect);
+	for (const auto& pass : compiledGraph_.passes) {
+		// 前のパスの出力を読み取り状態へ、今回の出力を書き込み状態へ（1回の呼び出しでまとめて遷移）
+		IssueBarriers(pass.barriers);
+		render_->BindOffscreenRenderTarget(static_cast<int>(pass.outputPhysical));
+
+		if (pass.passIndices.size() == 1) {
+			// 1パス = 1エフェクト
+			auto* effect = static_cast<PostEffectBase*>(effectGraph_.GetPass(pass.passIndices[0]).userData);
+			effect->Draw(GetPhysicalSrvHandle(pass.inputPhysical[0]));
+		} else {
+			// 連続するピクセル単位のエフェクトを1回の描画で適用
+			DrawMergedPass(pass);
 		}
 	}
 
-	auto* fullScreenEffect = GetEffect<FullScreen>(PostEffectNames::FullScreen);
-	assert(fullScreenEffect);
-	pingPong.EnsureOutputInBuffer1(fullScreenEffect);
+	// 全ターゲットを読み取り状態に戻す
+	IssueBarriers(compiledGraph_.finalBarriers);
 
-	// 最終結果を保存して返す
-	finalDisplayHandle_ = pingPong.GetCurrentOutput();
+	// 最終結果を保存して返す（最後に書き込んだターゲットをそのまま使うのでコピー不要）
+	finalDisplayHandle_ = GetPhysicalSrvHandle(compiledGraph_.finalPhysical);
 	return finalDisplayHandle_;
 }
 
+void PostEffectManager::CompileEffectGraph()
+{
+	// 有効状態・ピクセル単位かどうかが変わっていなければ前回の結果を使う（毎フレーム呼ぶので配列を作らずにその場で比べる）
+	const size_t effectCount = effectChain_.size();
+	bool changed = graphDirty_ || compiledEnabledStates_.size() != effectCount;
+	for (size_t i = 0; !changed && i < effectCount; ++i) {
+		const auto* effect = GetEffectInternal(effectChain_[i]);
+		changed = compiledEnabledStates_[i] != (effect && effect->IsEnabled()) ||
+			compiledPerPixelStates_[i] != (effect && effect->IsPerPixel());
+	}
+	if (!changed) {
+		return;
+	}
+	compiledEnabledStates_.resize(effectCount);
+	compiledPerPixelStates_.resize(effectCount);
+	for (size_t i = 0; i < effectCount; ++i) {
+		const auto* effect = GetEffectInternal(effectChain_[i]);
+		compiledEnabledStates_[i] = effect && effect->IsEnabled();
+		compiledPerPixelStates_[i] = effect && effect->IsPerPixel();
+	}
+	graphDirty_ = false;
+
+	// チェーン順にパスを宣言（無効なエフェクトもパススルーとして宣言し、コンパイルで除外する）
+	effectGraph_.Reset();
+	PostEffectGraph::ResourceId current = effectGraph_.ImportResource("SceneColor", 0);
+	for (size_t i = 0; i < effectChain_.size(); ++i) {
+		auto* effect = GetEffectInternal(effectChain_[i]);
+		if (!effect) {
+			continue;
+		}
+
+		PostEffectGraph::PassDesc pass;
+		pass.name = effectChain_[i];
+		pass.inputs = { current };
+		pass.output = effectGraph_.CreateTransient(effectChain_[i]);
+		pass.enabled = compiledEnabledStates_[i];
+		pass.perPixelOrder = compiledPerPixelStates_[i] ? UberPermutation::FindStage(effectChain_[i]) : -1;
+		pass.userData = effect;
+		effectGraph_.AddPass(pass);
+
+		current = pass.output;
+	}
+	effectGraph_.SetOutput(current);
+
+	PostEffectGraph::CompileOptions options;
+	options.maxPhysicalTargets = kPhysicalTargetCount;
+	options.mergePerPixelPasses = uberEnabled_;
+	bool compiled = effectGraph_.Compile(options, compiledGraph_);
+	assert(compiled && "Failed to compile post effect graph");
+	(void)compiled;
+
+	// まとめられたパスの組み合わせは描画前に用意しておく（初回のみシェーダーをコンパイル）
+	for (const auto& pass : compiledGraph_.passes) {
+		if (pass.passIndices.size() > 1) {
+			uberEffect_->Prepare(BuildMergedMask(pass));
+		}
+	}
+}
+
+UberPermutation::Mask PostEffectManager::BuildMergedMask(const PostEffectGraph::CompiledPass& pass) const
+{
+	// グラフは適用順が昇順の場合のみまとめるので、並びの確認はせずにビットを立てる（毎フレーム呼ぶので配列を作らない）
+	UberPermutation::Mask mask = 0;
+	for (uint32_t passIndex : pass.passIndices) {
+		int32_t order = effectGraph_.GetPass(passIndex).perPixelOrder;
+		assert(order >= 0 && order < static_cast<int32_t>(UberPermutation::kStageCount) && (mask >> order) == 0 &&
+			"Merged post effect pass is not in uber shader order");
+		mask |= UberPermutation::ToBit(static_cast<UberPermutation::Stage>(order));
+	}
+	return mask;
+}
+
+void PostEffectManager::DrawMergedPass(const PostEffectGraph::CompiledPass& pass)
+{
+	// 各エフェクトの定数バッファをそのまま割り当てる
+	D3D12_GPU_VIRTUAL_ADDRESS paramsAddresses[UberPermutation::kParamsSlotCount] = {};
+	for (uint32_t passIndex : pass.passIndices) {
+		const auto& desc = effectGraph_.GetPass(passIndex);
+		int32_t slot = UberPermutation::GetParamsRegister(static_cast<UberPermutation::Stage>(desc.perPixelOrder));
+		if (slot >= 0) {
+			paramsAddresses[slot] = static_cast<PostEffectBase*>(desc.userData)->GetParamsGpuAddress();
+		}
+	}
+
+	uberEffect_->Draw(BuildMergedMask(pass), GetPhysicalSrvHandle(pass.inputPhysical[0]), paramsAddresses);
+}
+
+void PostEffectManager::IssueBarriers(const std::vector<PostEffectGraph::Barrier>& barriers)
+{
+	if (barriers.empty()) {
+		return;
+	}
+
+	auto toD3D12State = [](PostEffectGraph::ResourceState state) {
+		return state == PostEffectGraph::ResourceState::RenderTarget
+			? D3D12_RESOURCE_STATE_RENDER_TARGET
+			: D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+	};
+
+	std::vector<D3D12_RESOURCE_BARRIER> d3dBarriers(barriers.size());
+	for (size_t i = 0; i < barriers.size(); ++i) {
+		D3D12_RESOURCE_BARRIER& barrier = d3dBarriers[i];
+		barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+		barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+		barrier.Transition.pResource = render_->GetOffscreenResource(static_cast<int>(barriers[i].physicalIndex));
+		barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+		barrier.Transition.StateBefore = toD3D12State(barriers[i].before);
+		barrier.Transition.StateAfter = toD3D12State(barriers[i].after);
+	}
+
+	directXCommon_->GetCommandList()->ResourceBarrier(static_cast<UINT>(d3dBarriers.size()), d3dBarriers.data());
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE PostEffectManager::GetPhysicalSrvHandle(uint32_t physicalIndex) const
+{
+	return (physicalIndex == 0)
+		? directXCommon_->GetOffScreenSrvHandle()
+		: directXCommon_->GetOffScreen2SrvHandle();
+}
+
 void PostEffectManager::ExecuteEffect(const std::string& name, D3D12_GPU_DESCRIPTOR_HANDLE inputSrvHandle)
 {
 	auto* effect = GetEffectInternal(name);
@@ -227,6 +287,7 @@ bool PostEffectManager::IsEffectEnabled(const std::string& effectName) const
 void PostEffectManager::SetEffectChain(const std::vector<std::string>& effectNames)
 {
 	effectChain_ = effectNames;
+	graphDirty_ = true;
 }
 
 const std::vector<std::string>& PostEffectManager::GetEffectChain() const
@@ -234,6 +295,14 @@ const std::vector<std::string>& PostEffectManager::GetEffectChain() const
 	return effectChain_;
 }
 
+void PostEffectManager::SetUberEnabled(bool enabled)
+{
+	if (uberEnabled_ != enabled) {
+		uberEnabled_ = enabled;
+		graphDirty_ = true;
+	}
+}
+
 void PostEffectManager::Update(float deltaTime)
 {
 	// 全エフェクトに対してUpdate呼び出し
@@ -275,6 +344,28 @@ void PostEffectManager::DrawImGui()
 					"エフェクトが無効 - 元の画像を描画中");
 			}
 
+			// レンダーグラフのコンパイル結果
+			ImGui::Text("実行パス数: %zu（除外: %u / 結合: %u）",
+				compiledGraph_.passes.size(), compiledGraph_.culledPassCount, compiledGraph_.mergedPassCount);
+			ImGui::Text("使用ターゲット数: %u / バリア数: %u",
+				compiledGraph_.physicalTargetCount, compiledGraph_.barrierCount);
+
+			// ピクセル単位のエフェクトのまとめ
+			bool uberEnabled = uberEnabled_;
+			if (ImGui::Checkbox("ピクセル単位のエフェクトをまとめる", &uberEnabled)) {
+				SetUberEnabled(uberEnabled);
+			}
+			for (const auto& pass : compiledGraph_.passes) {
+				if (pass.passIndices.size() > 1) {
+					ImGui::BulletText("まとめて描画: %s", UberPermutation::ToString(BuildMergedMask(pass)).c_str());
+				}
+			}
+			const auto& cache = uberEffect_->GetCache();
+			ImGui::Text("パーミュテーション: %zu 種（ヒット: %llu / ミス: %llu）",
+				cache.GetSize(),
+				static_cast<unsigned long long>(cache.GetHitCount()),
+				static_cast<unsigned long long>(cache.GetMissCount()));
+
 			ImGui::Separator();
 		}
 
@@ -8,6 +8,8 @@
 
 #include "Engine/Graphics/PostEffect/PostEffectBase.h"
 #include "Engine/Graphics/PostEffect/PostEffectNames.h"
+#include "Engine/Graphics/PostEffect/RenderGraph/PostEffectGraph.h"
+#include "Engine/Graphics/PostEffect/Uber/UberPostEffect.h"
 #include "PostEffectPresetManager.h"
 
 class DirectXCommon;
@@ -65,6 +67,13 @@ public:
     /// @return エフェクト名のリスト
     const std::vector<std::string>& GetEffectChain() const;
 
+    /// @brief 連続するピクセル単位のエフェクトを1回の描画にまとめるかを設定
+    /// @param enabled まとめるならtrue（falseなら全エフェクトを個別に描画）
+    void SetUberEnabled(bool enabled);
+
+    /// @brief 連続するピクセル単位のエフェクトをまとめているかを取得
+    bool IsUberEnabled() const { return uberEnabled_; }
+
     /// @brief 更新処理
     /// @param deltaTime フレーム時間
     void Update(float deltaTime);
@@ -81,39 +90,32 @@ public:
     D3D12_GPU_DESCRIPTOR_HANDLE GetFinalDisplayTextureHandle() const;
 
     /// @brief エフェクトチェーンを実行し、結果のテクスチャハンドルを取得
-    /// @param inputSrvHandle 入力テクスチャのSRVハンドル
-    /// @return 最終出力のSRVハンドル
+    /// @param inputSrvHandle 入力テクスチャのSRVハンドル（1枚目のオフスクリーン）
+    /// @return 最終出力のSRVハンドル（最後に書き込んだオフスクリーン）
     D3D12_GPU_DESCRIPTOR_HANDLE ExecuteEffectChain(D3D12_GPU_DESCRIPTOR_HANDLE inputSrvHandle);
 
 private:
-    /// @brief Ping-Pongバッファ管理用ヘルパークラス
-    class PingPongBuffer {
-    public:
-        PingPongBuffer(DirectXCommon* dxCommon, Render* render);
+    /// @brief 物理ターゲット（オフスクリーン）の数
+    static constexpr uint32_t kPhysicalTargetCount = 2;
 
-        /// @brief エフェクトを適用し、バッファを切り替える
-        /// @param effect 適用するエフェクト
-        /// @return 適用されたかどうか
-        bool ApplyEffect(PostEffectBase* effect);
+    /// @brief エフェクトチェーンからレンダーグラフを構築してコンパイル（チェーンと有効状態が変わったときのみ）
+    void CompileEffectGraph();
 
-        /// @brief 現在の出力SRVハンドルを取得
-        D3D12_GPU_DESCRIPTOR_HANDLE GetCurrentOutput() const;
+    /// @brief コンパイル済みグラフのバリアを発行
+    /// @param barriers 発行する遷移
+    void IssueBarriers(const std::vector<PostEffectGraph::Barrier>& barriers);
 
-        /// @brief 最終結果をオフスクリーン#1に保証する
-        /// @param fullScreenEffect FullScreenエフェクト（コピー用）
-        void EnsureOutputInBuffer1(PostEffectBase* fullScreenEffect);
+    /// @brief まとめられたパスのステージのマスクを作成
+    /// @param pass コンパイル済みパス（複数のエフェクトを含む）
+    UberPermutation::Mask BuildMergedMask(const PostEffectGraph::CompiledPass& pass) const;
 
-        /// @brief 入力をリセット
-        void Reset(D3D12_GPU_DESCRIPTOR_HANDLE input);
+    /// @brief まとめられたパスを描画
+    /// @param pass コンパイル済みパス（複数のエフェクトを含む）
+    void DrawMergedPass(const PostEffectGraph::CompiledPass& pass);
 
-    private:
-        DirectXCommon* dxCommon_;
-        Render* render_;
-        D3D12_GPU_DESCRIPTOR_HANDLE currentInput_;
-        int currentOutputIndex_;
-
-        D3D12_GPU_DESCRIPTOR_HANDLE GetSrvHandle(int index) const;
-    };
+    /// @brief 物理ターゲットのSRVハンドルを取得
+    /// @param physicalIndex 物理インデックス
+    D3D12_GPU_DESCRIPTOR_HANDLE GetPhysicalSrvHandle(uint32_t physicalIndex) const;
 
     /// @brief 全エフェクトを登録
     void RegisterAllEffects();
@@ -160,6 +162,17 @@ private:
     std::unique_ptr<PostEffectPresetManager> presetManager_;
     
     D3D12_GPU_DESCRIPTOR_HANDLE finalDisplayHandle_;
+
+    // レンダーグラフ
+    PostEffectGraph effectGraph_;
+    PostEffectGraph::CompiledGraph compiledGraph_;
+    std::vector<bool> compiledEnabledStates_;  // コンパイル時の各エフェクトの有効状態
+    std::vector<bool> compiledPerPixelStates_; // コンパイル時の各エフェクトがピクセル単位か（フェードの種類で変わる）
+    bool graphDirty_ = true;                   // チェーンまたはまとめ方が変更された
+
+    // ピクセル単位のエフェクトをまとめるUberシェーダー
+    std::unique_ptr<UberPostEffect> uberEffect_;
+    bool uberEnabled_ = true;
 };
 
 // =============================================================================
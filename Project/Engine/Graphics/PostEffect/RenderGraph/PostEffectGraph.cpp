@@ -0,0 +1,241 @@
+#include "PostEffectGraph.h"
+#include <algorithm>
+
+void PostEffectGraph::Reset()
+{
+	resources_.clear();
+	passes_.clear();
+	output_ = kInvalidResource;
+}
+
+PostEffectGraph::ResourceId PostEffectGraph::ImportResource(const std::string& name, uint32_t physicalIndex)
+{
+	Resource resource;
+	resource.name = name;
+	resource.imported = true;
+	resource.physicalIndex = physicalIndex;
+	resources_.push_back(resource);
+	return static_cast<ResourceId>(resources_.size() - 1);
+}
+
+PostEffectGraph::ResourceId PostEffectGraph::CreateTransient(const std::string& name)
+{
+	Resource resource;
+	resource.name = name;
+	resources_.push_back(resource);
+	return static_cast<ResourceId>(resources_.size() - 1);
+}
+
+uint32_t PostEffectGraph::AddPass(const PassDesc& desc)
+{
+	passes_.push_back(desc);
+	return static_cast<uint32_t>(passes_.size() - 1);
+}
+
+void PostEffectGraph::SetOutput(ResourceId resource)
+{
+	output_ = resource;
+}
+
+bool PostEffectGraph::Compile(const CompileOptions& options, CompiledGraph& out) const
+{
+	out = CompiledGraph{};
+
+	const size_t resourceCount = resources_.size();
+	if (output_ >= resourceCount) {
+		return false;
+	}
+
+	// ===== 1. 無効なパスを解決（出力を入力の別名にする） =====
+	// alias[r] : リソースrの実体（無効なパスの出力は入力を指す）
+	std::vector<ResourceId> alias(resourceCount);
+	std::vector<bool> written(resourceCount, false);
+	for (size_t i = 0; i < resourceCount; ++i) {
+		alias[i] = static_cast<ResourceId>(i);
+		written[i] = resources_[i].imported;
+	}
+
+	std::vector<std::vector<ResourceId>> resolvedInputs(passes_.size());
+	for (size_t p = 0; p < passes_.size(); ++p) {
+		const PassDesc& pass = passes_[p];
+		if (pass.output >= resourceCount || written[pass.output]) {
+			// 出力がない、または同じリソースへの二重書き込み
+			return false;
+		}
+
+		// 入力は宣言順で先に書き込まれている必要がある（宣言順 = 実行順）
+		for (ResourceId input : pass.inputs) {
+			if (input >= resourceCount || !written[input]) {
+				return false;
+			}
+			resolvedInputs[p].push_back(alias[input]);
+		}
+
+		written[pass.output] = true;
+		if (!pass.enabled) {
+			if (resolvedInputs[p].empty()) {
+				return false;
+			}
+			alias[pass.output] = resolvedInputs[p][0];
+		}
+	}
+
+	const ResourceId finalResource = alias[output_];
+
+	// ===== 2. 出力に寄与しないパスを除外 =====
+	std::vector<bool> needed(resourceCount, false);
+	std::vector<bool> live(passes_.size(), false);
+	needed[finalResource] = true;
+	for (size_t p = passes_.size(); p-- > 0;) {
+		const PassDesc& pass = passes_[p];
+		if (!pass.enabled || !needed[pass.output]) {
+			continue;
+		}
+		live[p] = true;
+		for (ResourceId input : resolvedInputs[p]) {
+			needed[input] = true;
+		}
+	}
+
+	// 有効なパスの読み取り回数
+	std::vector<uint32_t> readCount(resourceCount, 0);
+	for (size_t p = 0; p < passes_.size(); ++p) {
+		if (!live[p]) {
+			++out.culledPassCount;
+			continue;
+		}
+		for (ResourceId input : resolvedInputs[p]) {
+			++readCount[input];
+		}
+	}
+
+	// ===== 3. ピクセル単位のパスをまとめる =====
+	struct Node {
+		std::vector<uint32_t> passIndices;
+		std::vector<ResourceId> inputs;
+		ResourceId output = kInvalidResource;
+	};
+	std::vector<Node> nodes;
+	for (size_t p = 0; p < passes_.size(); ++p) {
+		if (!live[p]) {
+			continue;
+		}
+		const PassDesc& pass = passes_[p];
+
+		if (options.mergePerPixelPasses && !nodes.empty()) {
+			Node& last = nodes.back();
+			const PassDesc& lastPass = passes_[last.passIndices.back()];
+			// まとめたシェーダー内の適用順は固定なので、順番が昇順に並ぶ場合のみまとめる
+			bool canMerge = pass.perPixelOrder >= 0 && lastPass.perPixelOrder >= 0 &&
+				pass.perPixelOrder > lastPass.perPixelOrder &&
+				resolvedInputs[p].size() == 1 && resolvedInputs[p][0] == last.output &&
+				readCount[last.output] == 1 && last.output != finalResource;
+			if (canMerge) {
+				last.passIndices.push_back(static_cast<uint32_t>(p));
+				last.output = pass.output;
+				++out.mergedPassCount;
+				continue;
+			}
+		}
+
+		Node node;
+		node.passIndices.push_back(static_cast<uint32_t>(p));
+		node.inputs = resolvedInputs[p];
+		node.output = pass.output;
+		nodes.push_back(std::move(node));
+	}
+
+	// ===== 4. 物理ターゲットの割り当て（寿命が重ならないものは使い回す） =====
+	constexpr uint32_t kNone = 0xFFFFFFFFu;
+	constexpr size_t kForever = static_cast<size_t>(-1);
+
+	std::vector<size_t> lastUse(resourceCount, 0);
+	std::vector<bool> used(resourceCount, false);
+	for (size_t n = 0; n < nodes.size(); ++n) {
+		for (ResourceId input : nodes[n].inputs) {
+			lastUse[input] = n;
+			used[input] = true;
+		}
+	}
+	lastUse[finalResource] = kForever;
+	used[finalResource] = true;
+
+	std::vector<uint32_t> physical(resourceCount, kNone);
+	std::vector<bool> occupied(options.maxPhysicalTargets, false);
+	for (size_t r = 0; r < resourceCount; ++r) {
+		if (!resources_[r].imported) {
+			continue;
+		}
+		uint32_t index = resources_[r].physicalIndex;
+		if (index >= options.maxPhysicalTargets) {
+			return false;
+		}
+		physical[r] = index;
+		out.physicalTargetCount = (std::max)(out.physicalTargetCount, index + 1);
+		// 読まれない取り込みリソースは最初から空き扱い
+		occupied[index] = used[r];
+	}
+
+	std::vector<ResourceState> state(options.maxPhysicalTargets, ResourceState::ShaderResource);
+	auto transition = [&](std::vector<Barrier>& barriers, uint32_t index, ResourceState after) {
+		if (state[index] != after) {
+			barriers.push_back({ index, state[index], after });
+			state[index] = after;
+			++out.barrierCount;
+		}
+	};
+
+	for (size_t n = 0; n < nodes.size(); ++n) {
+		Node& node = nodes[n];
+
+		// 空いている物理ターゲットのうち番号の小さいものを使う
+		uint32_t outputIndex = kNone;
+		for (uint32_t i = 0; i < options.maxPhysicalTargets; ++i) {
+			if (!occupied[i]) {
+				outputIndex = i;
+				break;
+			}
+		}
+		if (outputIndex == kNone) {
+			return false;
+		}
+		occupied[outputIndex] = true;
+		physical[node.output] = outputIndex;
+		out.physicalTargetCount = (std::max)(out.physicalTargetCount, outputIndex + 1);
+
+		CompiledPass compiled;
+		compiled.passIndices = node.passIndices;
+		compiled.outputPhysical = outputIndex;
+		for (ResourceId input : node.inputs) {
+			compiled.inputPhysical.push_back(physical[input]);
+		}
+
+		// 遷移はパスの直前にまとめる（前のパスの出力を読み取り状態へ + 今回の出力を書き込み状態へ）
+		for (uint32_t inputIndex : compiled.inputPhysical) {
+			transition(compiled.barriers, inputIndex, ResourceState::ShaderResource);
+		}
+		transition(compiled.barriers, outputIndex, ResourceState::RenderTarget);
+
+		// このパスが最後の読み手なら物理ターゲットを解放
+		for (ResourceId input : node.inputs) {
+			if (lastUse[input] == n && input != node.output) {
+				occupied[physical[input]] = false;
+			}
+		}
+		// 誰にも読まれない出力（最終出力以外）は直ちに解放
+		if (!used[node.output]) {
+			occupied[outputIndex] = false;
+		}
+
+		out.passes.push_back(std::move(compiled));
+	}
+
+	// ===== 5. 全ターゲットを読み取り状態に戻す =====
+	for (uint32_t i = 0; i < options.maxPhysicalTargets; ++i) {
+		transition(out.finalBarriers, i, ResourceState::ShaderResource);
+	}
+
+	out.finalPhysical = physical[finalResource];
+	out.valid = out.finalPhysical != kNone;
+	return out.valid;
+}
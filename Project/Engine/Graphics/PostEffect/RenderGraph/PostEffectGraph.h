@@ -0,0 +1,114 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// @brief ポストエフェクト用の小さなレンダーグラフ
+/// @details パスの入出力を宣言し、Compile で実行順・物理レンダーターゲットの割り当て・バリアを決める。
+/// D3D12に依存しない純粋なCPU処理なので、単体で検証できる。
+/// - 無効なパスは入力をそのまま出力として扱い（パススルー）、実行対象から除外する
+/// - 最終出力に寄与しないパスも除外する
+/// - 連続するピクセル単位のパスは、適用順が昇順に並ぶ限り1つのパスにまとめられる（オプション）
+/// - 一時リソースは寿命が重ならない限り同じ物理ターゲットを使い回す
+/// - 状態遷移はパスの直前にまとめて発行し、不要な遷移は出さない
+class PostEffectGraph {
+public:
+    /// @brief 論理リソースID
+    using ResourceId = uint32_t;
+
+    /// @brief 無効なリソースID
+    static constexpr ResourceId kInvalidResource = 0xFFFFFFFFu;
+
+    /// @brief 物理リソースの状態
+    enum class ResourceState : uint8_t {
+        ShaderResource, ///< シェーダーから読み取り
+        RenderTarget,   ///< レンダーターゲットとして書き込み
+    };
+
+    /// @brief パスの宣言
+    struct PassDesc {
+        std::string name;                ///< パス名（デバッグ表示用）
+        std::vector<ResourceId> inputs;  ///< 読み取るリソース
+        ResourceId output = kInvalidResource; ///< 書き込むリソース
+        bool enabled = true;             ///< 無効なら先頭の入力をそのまま出力とみなす
+        int32_t perPixelOrder = -1;      ///< 自ピクセルのみを読むパスの適用順（-1はまとめられないパス）
+        void* userData = nullptr;        ///< 実行時に使うデータ（エフェクトのポインタなど）
+    };
+
+    /// @brief 状態遷移
+    struct Barrier {
+        uint32_t physicalIndex = 0;
+        ResourceState before = ResourceState::ShaderResource;
+        ResourceState after = ResourceState::ShaderResource;
+    };
+
+    /// @brief コンパイル済みパス（まとめられた場合は複数の元パスを持つ）
+    struct CompiledPass {
+        std::vector<uint32_t> passIndices;   ///< 元のパスインデックス（実行順）
+        std::vector<uint32_t> inputPhysical; ///< 入力の物理インデックス
+        uint32_t outputPhysical = 0;         ///< 出力の物理インデックス
+        std::vector<Barrier> barriers;       ///< パスの直前に発行する遷移
+    };
+
+    /// @brief コンパイルオプション
+    struct CompileOptions {
+        uint32_t maxPhysicalTargets = 2; ///< 使用できる物理ターゲット数
+        bool mergePerPixelPasses = false; ///< ピクセル単位のパスをまとめるか
+    };
+
+    /// @brief コンパイル結果
+    struct CompiledGraph {
+        std::vector<CompiledPass> passes;
+        std::vector<Barrier> finalBarriers;   ///< 全パス終了後に発行する遷移（全ターゲットを読み取り状態に戻す）
+        uint32_t finalPhysical = 0;           ///< 最終出力の物理インデックス
+        uint32_t physicalTargetCount = 0;     ///< 使用した物理ターゲット数
+        uint32_t culledPassCount = 0;         ///< 除外したパス数（無効・出力に寄与しない）
+        uint32_t mergedPassCount = 0;         ///< 他のパスにまとめられたパス数
+        uint32_t barrierCount = 0;            ///< 発行する遷移の総数
+        bool valid = false;
+    };
+
+    /// @brief グラフを空にする
+    void Reset();
+
+    /// @brief 外部のリソースを取り込む（シーンの描画結果など）
+    /// @param name リソース名
+    /// @param physicalIndex 割り当て済みの物理インデックス
+    /// @return リソースID
+    ResourceId ImportResource(const std::string& name, uint32_t physicalIndex);
+
+    /// @brief 一時リソースを作成（物理ターゲットはCompileで割り当てる）
+    /// @param name リソース名
+    /// @return リソースID
+    ResourceId CreateTransient(const std::string& name);
+
+    /// @brief パスを追加
+    /// @param desc パスの宣言
+    /// @return パスインデックス
+    uint32_t AddPass(const PassDesc& desc);
+
+    /// @brief 最終出力にするリソースを指定
+    /// @param resource リソースID
+    void SetOutput(ResourceId resource);
+
+    /// @brief パスの宣言を取得
+    const PassDesc& GetPass(uint32_t index) const { return passes_[index]; }
+
+    /// @brief コンパイル
+    /// @param options オプション
+    /// @param out 結果の出力先
+    /// @return 成功すればtrue（物理ターゲットが足りない場合などはfalse）
+    bool Compile(const CompileOptions& options, CompiledGraph& out) const;
+
+private:
+    /// @brief 論理リソース
+    struct Resource {
+        std::string name;
+        bool imported = false;
+        uint32_t physicalIndex = 0; ///< 取り込んだリソースの物理インデックス
+    };
+
+    std::vector<Resource> resources_;
+    std::vector<PassDesc> passes_;
+    ResourceId output_ = kInvalidResource;
+};
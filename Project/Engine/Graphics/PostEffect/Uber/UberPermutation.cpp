@@ -0,0 +1,85 @@
+#include "UberPermutation.h"
+#include "Engine/Graphics/PostEffect/PostEffectNames.h"
+
+namespace UberPermutation {
+
+	namespace {
+		struct StageInfo {
+			const char* effectName; // PostEffectNamesの名前
+			const wchar_t* define;  // UberColor.PS.hlsl のマクロ
+			int32_t paramsRegister; // 定数バッファのレジスタ（なければ-1）
+		};
+
+		// Stage の並びと一致させる
+		constexpr StageInfo kStageInfos[kStageCount] = {
+			{ PostEffectNames::FadeEffect,   L"UBER_FADE",          0 },
+			{ PostEffectNames::ColorGrading, L"UBER_COLOR_GRADING", 1 },
+			{ PostEffectNames::Sepia,        L"UBER_SEPIA",         2 },
+			{ PostEffectNames::Invert,       L"UBER_INVERT",       -1 },
+			{ PostEffectNames::GrayScale,    L"UBER_GRAYSCALE",    -1 },
+			{ PostEffectNames::Vignette,     L"UBER_VIGNETTE",      3 },
+		};
+	}
+
+	int32_t FindStage(const std::string& effectName)
+	{
+		for (uint32_t i = 0; i < kStageCount; ++i) {
+			if (effectName == kStageInfos[i].effectName) {
+				return static_cast<int32_t>(i);
+			}
+		}
+		return -1;
+	}
+
+	const char* GetStageName(Stage stage)
+	{
+		return (stage < Stage::Count) ? kStageInfos[static_cast<uint32_t>(stage)].effectName : "Unknown";
+	}
+
+	int32_t GetParamsRegister(Stage stage)
+	{
+		return (stage < Stage::Count) ? kStageInfos[static_cast<uint32_t>(stage)].paramsRegister : -1;
+	}
+
+	bool TryBuildMask(const std::vector<Stage>& stages, Mask& outMask)
+	{
+		outMask = 0;
+		int32_t previous = -1;
+		for (Stage stage : stages) {
+			int32_t index = static_cast<int32_t>(stage);
+			// シェーダー内の適用順と同じ順番でなければまとめられない
+			if (stage >= Stage::Count || index <= previous) {
+				outMask = 0;
+				return false;
+			}
+			outMask |= ToBit(stage);
+			previous = index;
+		}
+		return outMask != 0;
+	}
+
+	std::vector<std::wstring> GetDefines(Mask mask)
+	{
+		std::vector<std::wstring> defines;
+		for (uint32_t i = 0; i < kStageCount; ++i) {
+			if (mask & ToBit(static_cast<Stage>(i))) {
+				defines.push_back(kStageInfos[i].define);
+			}
+		}
+		return defines;
+	}
+
+	std::string ToString(Mask mask)
+	{
+		std::string result;
+		for (uint32_t i = 0; i < kStageCount; ++i) {
+			if (mask & ToBit(static_cast<Stage>(i))) {
+				if (!result.empty()) {
+					result += "+";
+				}
+				result += kStageInfos[i].effectName;
+			}
+		}
+		return result;
+	}
+}
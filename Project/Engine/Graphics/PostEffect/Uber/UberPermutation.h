@@ -0,0 +1,105 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// @brief ピクセル単位のエフェクトをまとめるUberシェーダーの組み合わせ（パーミュテーション）
+/// @details D3D12に依存しないので、組み合わせの選択とキャッシュは単体で検証できる。
+/// 適用順は Stage の並びで固定（UberColor.PS.hlsl と一致させること）。
+namespace UberPermutation {
+
+    /// @brief まとめられるエフェクト（値が適用順）
+    enum class Stage : uint8_t {
+        Fade,
+        ColorGrading,
+        Sepia,
+        Invert,
+        GrayScale,
+        Vignette,
+        Count
+    };
+
+    /// @brief 有効なステージのビットマスク（キャッシュのキー）
+    using Mask = uint32_t;
+
+    /// @brief ステージ数
+    constexpr uint32_t kStageCount = static_cast<uint32_t>(Stage::Count);
+
+    /// @brief 定数バッファを持つステージのルートCBV数（b0〜b3）
+    constexpr uint32_t kParamsSlotCount = 4;
+
+    /// @brief ステージのビットを取得
+    constexpr Mask ToBit(Stage stage) { return 1u << static_cast<uint32_t>(stage); }
+
+    /// @brief エフェクト名からステージを検索
+    /// @param effectName エフェクト名（PostEffectNames）
+    /// @return ステージの番号（まとめられないエフェクトは-1）
+    int32_t FindStage(const std::string& effectName);
+
+    /// @brief ステージ名を取得（デバッグ表示用）
+    const char* GetStageName(Stage stage);
+
+    /// @brief ステージの定数バッファのレジスタ番号を取得
+    /// @return b レジスタ番号（定数バッファを持たないステージは-1）
+    int32_t GetParamsRegister(Stage stage);
+
+    /// @brief 実行順に並んだステージからマスクを作成
+    /// @param stages ステージ（実行順）
+    /// @param outMask 作成したマスク
+    /// @return 適用順どおりに並んでいればtrue（重複・逆順・範囲外はfalse）
+    bool TryBuildMask(const std::vector<Stage>& stages, Mask& outMask);
+
+    /// @brief マスクに対応するマクロ定義（UBER_*）を取得
+    std::vector<std::wstring> GetDefines(Mask mask);
+
+    /// @brief マスクを表示用の文字列にする（例: "Sepia+Vignette"）
+    std::string ToString(Mask mask);
+
+    /// @brief マスクをキーにしたパーミュテーションのキャッシュ
+    /// @tparam T キャッシュする値（PSOなど）
+    template<typename T>
+    class PermutationCache {
+    public:
+        /// @brief 取得（なければ生成して登録）
+        /// @param mask キー
+        /// @param create 生成関数（T を返す）
+        /// @return キャッシュされた値
+        template<typename Factory>
+        T& GetOrCreate(Mask mask, Factory&& create)
+        {
+            auto it = entries_.find(mask);
+            if (it != entries_.end()) {
+                ++hitCount_;
+                return it->second;
+            }
+            ++missCount_;
+            return entries_.emplace(mask, create(mask)).first->second;
+        }
+
+        /// @brief 取得（なければnullptr、統計は変えない）
+        const T* Find(Mask mask) const
+        {
+            auto it = entries_.find(mask);
+            return it != entries_.end() ? &it->second : nullptr;
+        }
+
+        /// @brief 全て破棄
+        void Clear()
+        {
+            entries_.clear();
+            hitCount_ = 0;
+            missCount_ = 0;
+        }
+
+        size_t GetSize() const { return entries_.size(); }
+        uint64_t GetHitCount() const { return hitCount_; }
+        uint64_t GetMissCount() const { return missCount_; }
+
+    private:
+        std::unordered_map<Mask, T> entries_;
+        uint64_t hitCount_ = 0;
+        uint64_t missCount_ = 0;
+    };
+}
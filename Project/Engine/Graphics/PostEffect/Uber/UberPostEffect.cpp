@@ -0,0 +1,98 @@
+#include "UberPostEffect.h"
+#include "Engine/Graphics/Common/DirectXCommon.h"
+#include "Engine/Graphics/RootSignatureManager.h"
+#include <cassert>
+#include <stdexcept>
+
+void UberPostEffect::Initialize(DirectXCommon* dxCommon)
+{
+    assert(dxCommon);
+    directXCommon_ = dxCommon;
+
+    shaderCompiler_.Initialize();
+    fullscreenVertexShaderBlob_ = shaderCompiler_.CompileShader(
+        L"Resources/Shader/PostProcess/FullScreen.VS.hlsl", L"vs_6_0");
+
+    RootSignatureManager rootSignatureManager;
+
+    // Root Parameter 0: テクスチャ用ディスクリプタテーブル (t0, Pixel Shader)
+    RootSignatureManager::DescriptorRangeConfig textureRange;
+    textureRange.type = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+    textureRange.numDescriptors = 1;
+    textureRange.baseShaderRegister = 0;  // t0
+    rootSignatureManager.AddDescriptorTable({ textureRange }, D3D12_SHADER_VISIBILITY_PIXEL);
+
+    // Root Parameter 1〜4: 各エフェクトの定数バッファ (b0〜b3, Pixel Shader)
+    for (uint32_t i = 0; i < UberPermutation::kParamsSlotCount; ++i) {
+        RootSignatureManager::RootDescriptorConfig paramsCBV;
+        paramsCBV.shaderRegister = i;
+        paramsCBV.visibility = D3D12_SHADER_VISIBILITY_PIXEL;
+        rootSignatureManager.AddRootCBV(paramsCBV);
+    }
+
+    // Static Sampler (s0, Pixel Shader)
+    RootSignatureManager::StaticSamplerConfig samplerConfig;
+    samplerConfig.shaderRegister = 0;
+    samplerConfig.visibility = D3D12_SHADER_VISIBILITY_PIXEL;
+    samplerConfig.filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
+    samplerConfig.addressU = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+    samplerConfig.addressV = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+    samplerConfig.addressW = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+    samplerConfig.comparisonFunc = D3D12_COMPARISON_FUNC_NEVER;
+    samplerConfig.maxLOD = D3D12_FLOAT32_MAX;
+    rootSignatureManager.AddStaticSampler(samplerConfig);
+
+    rootSignatureManager.SetFlags(D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
+    rootSignatureManager.Create(dxCommon->GetDevice());
+    rootSignature_ = rootSignatureManager.GetRootSignature();
+}
+
+void UberPostEffect::Prepare(UberPermutation::Mask mask)
+{
+    GetOrCreatePipeline(mask);
+}
+
+void UberPostEffect::Draw(UberPermutation::Mask mask, D3D12_GPU_DESCRIPTOR_HANDLE inputSrvHandle,
+    const D3D12_GPU_VIRTUAL_ADDRESS (&paramsAddresses)[UberPermutation::kParamsSlotCount])
+{
+    PipelineStateManager& pipeline = GetOrCreatePipeline(mask);
+    auto* commandList = directXCommon_->GetCommandList();
+
+    commandList->SetGraphicsRootSignature(rootSignature_.Get());
+    commandList->SetPipelineState(pipeline.GetPipelineState(BlendMode::kBlendModeNone));
+
+    commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    commandList->SetGraphicsRootDescriptorTable(0, inputSrvHandle);
+
+    // マスクに含まれるステージの定数バッファのみバインド
+    for (uint32_t i = 0; i < UberPermutation::kStageCount; ++i) {
+        auto stage = static_cast<UberPermutation::Stage>(i);
+        int32_t slot = UberPermutation::GetParamsRegister(stage);
+        if ((mask & UberPermutation::ToBit(stage)) && slot >= 0) {
+            assert(paramsAddresses[slot] != 0);
+            commandList->SetGraphicsRootConstantBufferView(1 + slot, paramsAddresses[slot]);
+        }
+    }
+
+    commandList->DrawInstanced(3, 1, 0, 0);
+}
+
+PipelineStateManager& UberPostEffect::GetOrCreatePipeline(UberPermutation::Mask mask)
+{
+    return cache_.GetOrCreate(mask, [this](UberPermutation::Mask key) {
+        Microsoft::WRL::ComPtr<IDxcBlob> pixelShaderBlob = shaderCompiler_.CompileShader(
+            L"Resources/Shader/PostProcess/UberColor.PS.hlsl", L"ps_6_0", UberPermutation::GetDefines(key));
+
+        PipelineStateManager pipeline;
+        bool result = pipeline.CreateBuilder()
+            .SetRasterizer(D3D12_CULL_MODE_NONE, D3D12_FILL_MODE_SOLID)
+            .SetDepthStencil(false, false) // ポストエフェクトは深度不要
+            .SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE)
+            .Build(directXCommon_->GetDevice(), fullscreenVertexShaderBlob_.Get(), pixelShaderBlob.Get(), rootSignature_.Get());
+
+        if (!result) {
+            throw std::runtime_error("Failed to create PSO in UberPostEffect");
+        }
+        return pipeline;
+    });
+}
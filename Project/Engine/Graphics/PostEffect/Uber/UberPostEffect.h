@@ -0,0 +1,44 @@
+#pragma once
+#include <d3d12.h>
+#include <wrl.h>
+
+#include "Engine/Graphics/PipelineStateManager.h"
+#include "Engine/Graphics/Shader/ShaderCompiler.h"
+#include "UberPermutation.h"
+
+class DirectXCommon;
+
+/// @brief 連続するピクセル単位のエフェクトを1回の全画面描画でまとめて適用する
+/// @details 有効なエフェクトの組み合わせ（マスク）ごとに UberColor.PS.hlsl をコンパイルし、PSOをキャッシュする。
+class UberPostEffect {
+public:
+    /// @brief 初期化（ルートシグネチャの作成。シェーダーは組み合わせごとに初回使用時にコンパイル）
+    /// @param dxCommon DirectXCommonのポインタ
+    void Initialize(DirectXCommon* dxCommon);
+
+    /// @brief 組み合わせのPSOを事前に作成
+    /// @param mask 有効なステージのマスク
+    void Prepare(UberPermutation::Mask mask);
+
+    /// @brief まとめて描画
+    /// @param mask 有効なステージのマスク
+    /// @param inputSrvHandle 入力テクスチャのSRVハンドル
+    /// @param paramsAddresses 各ステージの定数バッファ（b0〜b3、マスクに含まれるもののみ使用）
+    void Draw(UberPermutation::Mask mask, D3D12_GPU_DESCRIPTOR_HANDLE inputSrvHandle,
+        const D3D12_GPU_VIRTUAL_ADDRESS (&paramsAddresses)[UberPermutation::kParamsSlotCount]);
+
+    /// @brief パーミュテーションのキャッシュを取得（統計表示用）
+    const UberPermutation::PermutationCache<PipelineStateManager>& GetCache() const { return cache_; }
+
+private:
+    /// @brief 組み合わせのPSOを取得（なければ作成）
+    PipelineStateManager& GetOrCreatePipeline(UberPermutation::Mask mask);
+
+    DirectXCommon* directXCommon_ = nullptr;
+
+    ShaderCompiler shaderCompiler_;
+    Microsoft::WRL::ComPtr<IDxcBlob> fullscreenVertexShaderBlob_;
+    Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
+
+    UberPermutation::PermutationCache<PipelineStateManager> cache_;
+};
@@ -61,6 +61,18 @@ void ModelRenderer::Initialize(ID3D12Device* device) {
     spotLightsRange.baseShaderRegister = 3;
     rootSignatureMg_->AddDescriptorTable({ spotLightsRange }, D3D12_SHADER_VISIBILITY_PIXEL);
     
+    // Root Parameter 8: クラスターごとのライト範囲用SRV (t4, PS)
+    RootSignatureManager::RootDescriptorConfig clusterRangesSRV;
+    clusterRangesSRV.shaderRegister = 4;
+    clusterRangesSRV.visibility = D3D12_SHADER_VISIBILITY_PIXEL;
+    rootSignatureMg_->AddRootSRV(clusterRangesSRV);
+    
+    // Root Parameter 9: ライトインデックスリスト用SRV (t5, PS)
+    RootSignatureManager::RootDescriptorConfig lightIndicesSRV;
+    lightIndicesSRV.shaderRegister = 5;
+    lightIndicesSRV.visibility = D3D12_SHADER_VISIBILITY_PIXEL;
+    rootSignatureMg_->AddRootSRV(lightIndicesSRV);
+    
     // Static Sampler (s0, PS)
     rootSignatureMg_->AddDefaultLinearSampler(0, D3D12_SHADER_VISIBILITY_PIXEL);
     
@@ -85,19 +97,15 @@ void ModelRenderer::Initialize(ID3D12Device* device) {
     if (!result) {
         throw std::runtime_error("Failed to create Pipeline State Object");
     }
-    
-    pipelineState_ = psoMg_->GetPipelineState(BlendMode::kBlendModeNone);
 }
 
 void ModelRenderer::BeginPass(ID3D12GraphicsCommandList* cmdList, BlendMode blendMode) {
     
-    if (blendMode != currentBlendMode_) {
-        currentBlendMode_ = blendMode;
-        pipelineState_ = psoMg_->GetPipelineState(blendMode);
-    }
+    // 並列記録で複数スレッドから呼ばれるため、メンバーを書き換えずに毎回取得する
+    ID3D12PipelineState* pipelineState = psoMg_->GetPipelineState(blendMode);
     
     cmdList->SetGraphicsRootSignature(rootSignatureMg_->GetRootSignature());
-    cmdList->SetPipelineState(pipelineState_);
+    cmdList->SetPipelineState(pipelineState);
     cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
     
     // カメラCBVを設定
@@ -112,7 +120,9 @@ void ModelRenderer::BeginPass(ID3D12GraphicsCommandList* cmdList, BlendMode blen
             ModelRendererRootParam::kLightCounts,
             ModelRendererRootParam::kDirectionalLights,
             ModelRendererRootParam::kPointLights,
-            ModelRendererRootParam::kSpotLights
+            ModelRendererRootParam::kSpotLights,
+            ModelRendererRootParam::kClusterRanges,
+            ModelRendererRootParam::kLightIndices
         );
     }
 }
@@ -20,6 +20,8 @@ namespace ModelRendererRootParam {
     static constexpr UINT kDirectionalLights = 5;     // t1: DirectionalLights (PS)
     static constexpr UINT kPointLights = 6;           // t2: PointLights (PS)
     static constexpr UINT kSpotLights = 7;            // t3: SpotLights (PS)
+    static constexpr UINT kClusterRanges = 8;         // t4: ClusterRanges (PS)
+    static constexpr UINT kLightIndices = 9;          // t5: LightIndices (PS)
 }
 
 /// @brief 通常モデル描画用レンダラー
@@ -40,8 +42,6 @@ private:
     std::unique_ptr<PipelineStateManager> psoMg_ = std::make_unique<PipelineStateManager>();
     std::unique_ptr<ShaderCompiler> shaderCompiler_ = std::make_unique<ShaderCompiler>();
     
-    ID3D12PipelineState* pipelineState_ = nullptr;
-    BlendMode currentBlendMode_;
     D3D12_GPU_VIRTUAL_ADDRESS cameraCBV_ = 0;
 
     class LightManager* lightManager_ = nullptr;
@@ -68,6 +68,18 @@ void SkinnedModelRenderer::Initialize(ID3D12Device* device) {
     spotLightsRange.baseShaderRegister = 3;
     rootSignatureMg_->AddDescriptorTable({ spotLightsRange }, D3D12_SHADER_VISIBILITY_PIXEL);
     
+    // Root Parameter 9: クラスターごとのライト範囲用SRV (t4, PS)
+    RootSignatureManager::RootDescriptorConfig clusterRangesSRV;
+    clusterRangesSRV.shaderRegister = 4;
+    clusterRangesSRV.visibility = D3D12_SHADER_VISIBILITY_PIXEL;
+    rootSignatureMg_->AddRootSRV(clusterRangesSRV);
+    
+    // Root Parameter 10: ライトインデックスリスト用SRV (t5, PS)
+    RootSignatureManager::RootDescriptorConfig lightIndicesSRV;
+    lightIndicesSRV.shaderRegister = 5;
+    lightIndicesSRV.visibility = D3D12_SHADER_VISIBILITY_PIXEL;
+    rootSignatureMg_->AddRootSRV(lightIndicesSRV);
+    
     // Static Sampler (s0, PS)
     rootSignatureMg_->AddDefaultLinearSampler(0, D3D12_SHADER_VISIBILITY_PIXEL);
     
@@ -94,19 +106,15 @@ void SkinnedModelRenderer::Initialize(ID3D12Device* device) {
     if (!skinningResult) {
         throw std::runtime_error("Failed to create Skinning Pipeline State Object");
     }
-    
-    pipelineState_ = psoMg_->GetPipelineState(BlendMode::kBlendModeNone);
 }
 
 void SkinnedModelRenderer::BeginPass(ID3D12GraphicsCommandList* cmdList, BlendMode blendMode) {
     
-    if (blendMode != currentBlendMode_) {
-        currentBlendMode_ = blendMode;
-        pipelineState_ = psoMg_->GetPipelineState(blendMode);
-    }
+    // 並列記録で複数スレッドから呼ばれるため、メンバーを書き換えずに毎回取得する
+    ID3D12PipelineState* pipelineState = psoMg_->GetPipelineState(blendMode);
     
     cmdList->SetGraphicsRootSignature(rootSignatureMg_->GetRootSignature());
-    cmdList->SetPipelineState(pipelineState_);
+    cmdList->SetPipelineState(pipelineState);
     cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
     
     if (cameraCBV_ != 0) {
@@ -119,7 +127,9 @@ void SkinnedModelRenderer::BeginPass(ID3D12GraphicsCommandList* cmdList, BlendMo
             SkinnedModelRendererRootParam::kLightCounts,
             SkinnedModelRendererRootParam::kDirectionalLights,
             SkinnedModelRendererRootParam::kPointLights,
-            SkinnedModelRendererRootParam::kSpotLights
+            SkinnedModelRendererRootParam::kSpotLights,
+            SkinnedModelRendererRootParam::kClusterRanges,
+            SkinnedModelRendererRootParam::kLightIndices
         );
     }
 }
@@ -21,6 +21,8 @@ namespace SkinnedModelRendererRootParam {
     static constexpr UINT kDirectionalLights = 6;     // t1: DirectionalLights (PS)
     static constexpr UINT kPointLights = 7;           // t2: PointLights (PS)
     static constexpr UINT kSpotLights = 8;            // t3: SpotLights (PS)
+    static constexpr UINT kClusterRanges = 9;         // t4: ClusterRanges (PS)
+    static constexpr UINT kLightIndices = 10;         // t5: LightIndices (PS)
 }
 
 /// @brief スキニングモデル描画用レンダラー
@@ -41,8 +43,6 @@ private:
     std::unique_ptr<PipelineStateManager> psoMg_ = std::make_unique<PipelineStateManager>();
     std::unique_ptr<ShaderCompiler> shaderCompiler_ = std::make_unique<ShaderCompiler>();
     
-    ID3D12PipelineState* pipelineState_ = nullptr;
-    BlendMode currentBlendMode_;
     D3D12_GPU_VIRTUAL_ADDRESS cameraCBV_ = 0;
 
     LightManager* lightManager_ = nullptr;
@@ -0,0 +1,21 @@
+#pragma once
+#include <cstdint>
+
+/// @brief 並列記録の書き込み先（ワーカーごとのコマンドリスト）を抽象化するインターフェース
+/// @details D3D12に依存しないため、偽の実装でチャンク分割と実行順序を検証できる
+class ICommandRecordingTarget {
+public:
+    virtual ~ICommandRecordingTarget() = default;
+
+    /// @brief ワーカー用コマンドリストの記録を開始（記録するスレッドから呼ばれる）
+    /// @param listIndex コマンドリストのインデックス（= チャンクのインデックス）
+    virtual void BeginRecording(uint32_t listIndex) = 0;
+
+    /// @brief ワーカー用コマンドリストの記録を終了（記録したスレッドから呼ばれる）
+    /// @param listIndex コマンドリストのインデックス
+    virtual void EndRecording(uint32_t listIndex) = 0;
+
+    /// @brief 記録済みのコマンドリストをインデックス順に実行
+    /// @param listCount 実行するコマンドリスト数（0 ～ listCount-1）
+    virtual void ExecuteRecorded(uint32_t listCount) = 0;
+};
@@ -0,0 +1,34 @@
+#include "ParallelRecorder.h"
+#include <algorithm>
+
+void ParallelRecorder::Initialize(uint32_t workerCount) {
+	workerCount_ = workerCount;
+	jobSystem_.Initialize(workerCount > 0 ? workerCount - 1 : 0);
+}
+
+void ParallelRecorder::Finalize() {
+	jobSystem_.Finalize();
+	workerCount_ = 0;
+}
+
+bool ParallelRecorder::ShouldRecordParallel(size_t itemCount, size_t minItemsPerChunk) const {
+	return enabled_ && workerCount_ > 0 && itemCount >= (std::max)(minItemsPerChunk, size_t{ 1 }) * 2;
+}
+
+uint32_t ParallelRecorder::Record(ICommandRecordingTarget& target, size_t itemCount, size_t minItemsPerChunk, const RecordFunction& recordFunc) {
+	// チャンクごとにコマンドリストを使うので、チャンク数はリスト数まで（ワーカーがいない場合も1チャンクとして記録する）
+	uint32_t maxChunks = (std::max)(workerCount_, 1u);
+	uint32_t chunkCount = jobSystem_.ParallelFor(itemCount, minItemsPerChunk, maxChunks,
+		[&](uint32_t chunkIndex, size_t begin, size_t end) {
+			target.BeginRecording(chunkIndex);
+			recordFunc(chunkIndex, begin, end);
+			target.EndRecording(chunkIndex);
+		});
+	if (chunkCount == 0) {
+		return 0;
+	}
+
+	// チャンク順に実行（描画順序を維持）
+	target.ExecuteRecorded(chunkCount);
+	return chunkCount;
+}
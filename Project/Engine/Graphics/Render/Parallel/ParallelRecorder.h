@@ -0,0 +1,52 @@
+#pragma once
+#include "ICommandRecordingTarget.h"
+#include "Engine/Utility/Job/JobSystem.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+/// @brief ソート済み描画キューをチャンクに分割し、ワーカースレッドで並列に記録する
+/// @details スレッドとチャンクの分配は JobSystem に任せる。呼び出しスレッドも1チャンクずつ記録に加わる。
+/// チャンクi はコマンドリストi に記録され、ExecuteRecorded でインデックス順に実行されるため、
+/// 描画順序はシリアル記録と同じになる。
+class ParallelRecorder {
+public:
+    /// @brief 記録関数（チャンクのインデックスと範囲を受け取る）
+    using RecordFunction = std::function<void(uint32_t chunkIndex, size_t begin, size_t end)>;
+
+    /// @brief ワーカースレッドを起動
+    /// @param workerCount 同時に記録するコマンドリスト数（呼び出しスレッドも記録するので、起動するスレッドは1つ少ない。
+    /// 0の場合は呼び出しスレッドで1チャンクとして記録する）
+    void Initialize(uint32_t workerCount);
+
+    /// @brief ワーカースレッドを停止
+    void Finalize();
+
+    /// @brief 同時に記録するコマンドリスト数を取得
+    uint32_t GetWorkerCount() const { return workerCount_; }
+
+    /// @brief 並列記録の有効/無効を切り替え
+    void SetEnabled(bool enabled) { enabled_ = enabled; }
+
+    /// @brief 並列記録が有効か
+    bool IsEnabled() const { return enabled_; }
+
+    /// @brief 並列に記録するか（falseなら呼び出し側がメインのコマンドリストにシリアルに記録する）
+    /// @details 無効・ワーカーなし・2チャンクに満たない場合はfalse（スレッドを使うコストが上回る）
+    /// @param itemCount 記録する要素数
+    /// @param minItemsPerChunk 1チャンクあたりの最小要素数
+    bool ShouldRecordParallel(size_t itemCount, size_t minItemsPerChunk) const;
+
+    /// @brief 並列に記録して実行
+    /// @param target 記録先
+    /// @param itemCount 記録する要素数
+    /// @param minItemsPerChunk 1チャンクあたりの最小要素数
+    /// @param recordFunc 記録関数
+    /// @return 使用したチャンク数
+    uint32_t Record(ICommandRecordingTarget& target, size_t itemCount, size_t minItemsPerChunk, const RecordFunction& recordFunc);
+
+private:
+    JobSystem jobSystem_;
+    uint32_t workerCount_ = 0;
+    bool enabled_ = false;
+};
@@ -72,6 +72,7 @@ void Render::OffscreenPreDrawCommon(ID3D12Resource* resource, const D3D12_CPU_DE
 	// RTV & DSV設定 - DirectXCommonからDSVハンドルを直接取得
 	D3D12_CPU_DESCRIPTOR_HANDLE dsvHandle = dxCommon_->GetDSVHandle();
 	cmdList->OMSetRenderTargets(1, &rtvHandle, false, &dsvHandle);
+	currentRtvHandle_ = rtvHandle;
 
 	// 指定した色で画面全体をクリアする
 	const float clearColor[4] = { 0.1f, 0.25f, 0.5f, 1.0f }; // 青っぽい色。RGBAの順
@@ -115,6 +116,7 @@ void Render::BackBufferPreDraw()
 	D3D12_CPU_DESCRIPTOR_HANDLE dsvHandle = dxCommon_->GetDSVHandle();
 
 	cmdList->OMSetRenderTargets(1, &rtvHandle, false, &dsvHandle);
+	currentRtvHandle_ = rtvHandle;
 	// 指定した色で画面全体をクリアする
 	const float clearColor[4] = { 0.1f, 0.25f, 0.5f, 1.0f }; //<青っぽい色。RGBAの順>
 	cmdList->ClearRenderTargetView(rtvHandle, clearColor, 0, nullptr);
@@ -184,6 +186,9 @@ void Render::BackBufferPostDraw()
 	HRESULT hr = cmdList->Close();
 	assert(SUCCEEDED(hr));
 
+	// このフレームで記録したテクスチャ・バッファのコピーを提出（描画はコピーの完了を待つ）
+	dxCommon_->GetUploadManager()->Flush();
+
 	// コマンドを実行
 	ID3D12CommandList* commandLists[] = { cmdList };
 	dxCommon_->GetCommandQueue()->ExecuteCommandLists(1, commandLists);
@@ -206,6 +211,9 @@ void Render::BackBufferPostDraw()
 		commandManager->WaitForFrame(nextFrameIndex);
 	}
 
+	// 次のフレームで解放したSRVの再利用と一時領域のリセット（GPU処理の完了後）
+	dxCommon_->GetDescriptorManager()->BeginFrame(nextFrameIndex);
+
 	// 次のフレーム用のコマンドアロケータをリセット
 	hr = commandManager->GetCommandAllocator(nextFrameIndex)->Reset();
 	assert(SUCCEEDED(hr));
@@ -213,6 +221,52 @@ void Render::BackBufferPostDraw()
 	// コマンドリストをリセット
 	hr = dxCommon_->GetCommandList()->Reset(commandManager->GetCommandAllocator(nextFrameIndex), nullptr);
 	assert(SUCCEEDED(hr));
+
+	// ワーカー用アロケータのリセットと使用中アロケータの切り替え
+	commandManager->BeginFrame(nextFrameIndex);
+}
+
+void Render::BindOffscreenRenderTarget(int offscreenIndex)
+{
+	auto* cmdList = dxCommon_->GetCommandList();
+
+	// 全画面パスは全ピクセルを上書きするのでクリア不要、深度も使わない
+	currentRtvHandle_ = (offscreenIndex == 0) ? offscreenRtvHandle_ : offscreen2RtvHandle_;
+	cmdList->OMSetRenderTargets(1, &currentRtvHandle_, false, nullptr);
+
+	ID3D12DescriptorHeap* descriptorHeaps[] = {
+		dxCommon_->GetSRVHeap(),
+	};
+	cmdList->SetDescriptorHeaps(1, descriptorHeaps);
+	cmdList->RSSetViewports(1, &viewport_);
+	cmdList->RSSetScissorRects(1, &scissorRect_);
+}
+
+ID3D12Resource* Render::GetOffscreenResource(int offscreenIndex) const
+{
+	switch (offscreenIndex) {
+	case 0:
+		return offscreenResource_;
+	case 1:
+		return offscreen2Resource_;
+	default:
+		assert(false && "Invalid offscreen index");
+		return nullptr;
+	}
+}
+
+void Render::ApplyRenderTargetState(ID3D12GraphicsCommandList* cmdList)
+{
+	// クリアやバリアは行わず、現在の描画先をそのまま設定する
+	D3D12_CPU_DESCRIPTOR_HANDLE dsvHandle = dxCommon_->GetDSVHandle();
+	cmdList->OMSetRenderTargets(1, &currentRtvHandle_, false, &dsvHandle);
+
+	ID3D12DescriptorHeap* descriptorHeaps[] = {
+		dxCommon_->GetSRVHeap(),
+	};
+	cmdList->SetDescriptorHeaps(1, descriptorHeaps);
+	cmdList->RSSetViewports(1, &viewport_);
+	cmdList->RSSetScissorRects(1, &scissorRect_);
 }
 
 void Render::ResourceBarrier(ID3D12Resource* resource, D3D12_RESOURCE_STATES stateBefore, D3D12_RESOURCE_STATES stateAfter)
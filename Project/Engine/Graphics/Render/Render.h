@@ -35,6 +35,19 @@ public: // メンバ関数
     /// @param stateAfter 遷移先のステート
     void ResourceBarrier(ID3D12Resource* resource, D3D12_RESOURCE_STATES stateBefore, D3D12_RESOURCE_STATES stateAfter);
 
+    /// @brief オフスクリーンを描画先に設定（クリア・バリア・深度なし。全画面パス用）
+    /// @param offscreenIndex オフスクリーンのインデックス（0=1枚目、1=2枚目）
+    void BindOffscreenRenderTarget(int offscreenIndex);
+
+    /// @brief オフスクリーンのリソースを取得
+    /// @param offscreenIndex オフスクリーンのインデックス（0=1枚目、1=2枚目）
+    /// @return リソース
+    ID3D12Resource* GetOffscreenResource(int offscreenIndex) const;
+
+    /// @brief 現在の描画先（RTV/DSV・ディスクリプタヒープ・ビューポート）を別のコマンドリストに設定
+    /// @param cmdList 設定先のコマンドリスト（並列記録用のリストやリセット後のリスト）
+    void ApplyRenderTargetState(ID3D12GraphicsCommandList* cmdList);
+
 private:
     /// @brief オフスクリーンの描画前処理（汎用）
     /// @param resource 対象のオフスクリーンリソース
@@ -58,6 +71,9 @@ private:
     ID3D12Resource* offscreen2Resource_ = nullptr;
     D3D12_CPU_DESCRIPTOR_HANDLE offscreen2RtvHandle_ {};
 
+    // 現在の描画先（PreDrawで設定したRTV）
+    D3D12_CPU_DESCRIPTOR_HANDLE currentRtvHandle_ {};
+
     // ビューポートとシザー矩形
     D3D12_VIEWPORT viewport_ {};
     D3D12_RECT scissorRect_ {};
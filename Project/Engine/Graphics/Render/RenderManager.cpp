@@ -3,8 +3,10 @@
 #include "Engine/Particle/ParticleSystem.h"
 #include "Engine/Graphics/Render/Particle/ParticleRenderer.h"
 #include "Engine/Graphics/Render/Particle/ModelParticleRenderer.h"
+#include "Engine/Graphics/Render/Sprite/SpriteRenderer.h"
 #include "Engine/Camera/CameraManager.h"
 #include "Engine/Camera/ICamera.h"
+#include "Engine/Graphics/Common/Core/CommandManager.h"
 #include <algorithm>
 
 void RenderManager::Initialize(ID3D12Device* device) {
@@ -69,15 +71,53 @@ const ICamera* RenderManager::GetCameraForPass(RenderPassType passType) {
 }
 
 void RenderManager::DrawAll() {
-	if (drawQueue_.empty() || !cmdList_) return;
+	lastParallelChunkCount_ = 0;
+	if (!cmdList_) return;
+	if (drawQueue_.empty()) {
+		FlushPendingSprites();
+		return;
+	}
 
 	SortDrawQueue();
 
+	// パスごとのカメラは記録前に設定しておく（並列記録中にレンダラーの状態を書き換えないため）
+	for (auto& [type, renderer] : renderers_) {
+		renderer->SetCamera(GetCameraForPass(type));
+	}
+
+	// ソート済みなので並列記録できるパスはキューの先頭に連続して並ぶ
+	size_t parallelEnd = 0;
+	while (parallelEnd < drawQueue_.size() && IsParallelSafePass(drawQueue_[parallelEnd].passType)) {
+		++parallelEnd;
+	}
+
+	size_t serialBegin = 0;
+	if (recorder_.ShouldRecordParallel(parallelEnd, kMinObjectsPerChunk)) {
+		RecordParallel(parallelEnd);
+		serialBegin = parallelEnd;
+	}
+
+	// 残りはメインのコマンドリストに記録
+	RecordRange(cmdList_, serialBegin, drawQueue_.size());
+
+	FlushPendingSprites();
+}
+
+void RenderManager::FlushPendingSprites() {
+	// スプライトパスの外で追加されたスプライト（Sprite::Drawなど）をまとめて描画
+	auto* spriteRenderer = static_cast<SpriteRenderer*>(GetRenderer(RenderPassType::Sprite));
+	if (spriteRenderer && spriteRenderer->HasPendingSprites()) {
+		spriteRenderer->Flush(cmdList_);
+	}
+}
+
+void RenderManager::RecordRange(ID3D12GraphicsCommandList* cmdList, size_t begin, size_t end) {
 	RenderPassType currentPass = RenderPassType::Invalid;
 	IRenderer* currentRenderer = nullptr;
 	const ICamera* currentCamera = nullptr;
 
-	for (const auto& cmd : drawQueue_) {
+	for (size_t i = begin; i < end; ++i) {
+		const auto& cmd = drawQueue_[i];
 		if (!cmd.object->IsActive()) continue;
 
 		// パスが切り替わったら処理
@@ -93,11 +133,10 @@ void RenderManager::DrawAll() {
 			if (it != renderers_.end()) {
 				currentRenderer = it->second.get();
 				
-				// パスに応じたカメラを取得
+				// パスに応じたカメラを取得（レンダラーへの設定はDrawAllで済んでいる）
 				currentCamera = GetCameraForPass(currentPass);
-				currentRenderer->SetCamera(currentCamera);
 				
-				currentRenderer->BeginPass(cmdList_, cmd.object->GetBlendMode());
+				currentRenderer->BeginPass(cmdList, cmd.object->GetBlendMode());
 			} else {
 				currentRenderer = nullptr;
 				currentCamera = nullptr;
@@ -132,13 +171,50 @@ void RenderManager::DrawAll() {
 	}
 }
 
+void RenderManager::RecordParallel(size_t end) {
+	// ここまでのメインリスト（描画先のクリアなど）をワーカーのリストより先に実行する
+	commandManager_->FlushCommandList();
+
+	lastParallelChunkCount_ = recorder_.Record(*commandManager_, end, kMinObjectsPerChunk,
+		[this](uint32_t chunkIndex, size_t begin, size_t chunkEnd) {
+			(void)chunkIndex;
+			// ワーカーのリストは状態を持たないので描画先を設定してから記録
+			ID3D12GraphicsCommandList* workerList = commandManager_->GetCommandList();
+			if (renderTargetSetup_) {
+				renderTargetSetup_(workerList);
+			}
+			RecordRange(workerList, begin, chunkEnd);
+		});
+
+	// リセットされたメインリストに描画先を設定し直す
+	if (renderTargetSetup_) {
+		renderTargetSetup_(cmdList_);
+	}
+}
+
+void RenderManager::InitializeParallelRecording(CommandManager* commandManager,
+	std::function<void(ID3D12GraphicsCommandList*)> renderTargetSetup, uint32_t workerCount) {
+	workerCount = (std::min)(workerCount, kMaxRecordingWorkers);
+
+	commandManager_ = commandManager;
+	renderTargetSetup_ = std::move(renderTargetSetup);
+	commandManager_->InitializeWorkerCommandLists(workerCount);
+	recorder_.Initialize(workerCount);
+}
+
+bool RenderManager::IsParallelSafePass(RenderPassType passType) {
+	// スプライト・パーティクルはレンダラー側でフレーム内のバッファ位置を共有しているため対象外
+	return passType == RenderPassType::Model || passType == RenderPassType::SkinnedModel;
+}
+
 void RenderManager::ClearQueue() {
 	drawQueue_.clear();
 }
 
 void RenderManager::SortDrawQueue() {
 	// 描画パスタイプでソート（パイプライン切り替え最小化）
-	std::sort(drawQueue_.begin(), drawQueue_.end(),
+	// 同じパス内の順序を保つため安定ソートを使う（並列記録でもシリアルと同じ描画順になる）
+	std::stable_sort(drawQueue_.begin(), drawQueue_.end(),
 		[](const DrawCommand& a, const DrawCommand& b) {
 			return static_cast<int>(a.passType) < static_cast<int>(b.passType);
 		});
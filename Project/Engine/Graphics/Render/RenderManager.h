@@ -3,7 +3,9 @@
 #include "IRenderer.h"
 #include "RenderPassType.h"
 #include "Engine/Graphics/PipelineStateManager.h"
+#include "Engine/Graphics/Render/Parallel/ParallelRecorder.h"
 #include <d3d12.h>
+#include <functional>
 #include <unordered_map>
 #include <vector>
 #include <memory>
@@ -12,10 +14,17 @@
 class IDrawable;
 class ICamera;
 class CameraManager;
+class CommandManager;
 
 /// @brief レンダリング全体を自動管理するマネージャー
 class RenderManager {
 public:
+    /// @brief 並列記録のワーカー数の上限
+    static constexpr uint32_t kMaxRecordingWorkers = 4;
+
+    /// @brief 1チャンクあたりの最小オブジェクト数（これ未満ならスレッド起動のコストが上回る）
+    static constexpr size_t kMinObjectsPerChunk = 32;
+
     /// @brief 初期化
     /// @param device D3D12デバイス
     void Initialize(ID3D12Device* device);
@@ -51,6 +60,25 @@ public:
     
     /// @brief フレーム終了時にキューをクリア
     void ClearQueue();
+
+    /// @brief 並列記録を有効化（ワーカースレッドとワーカー用コマンドリストを作成）
+    /// @param commandManager コマンドマネージャー
+    /// @param renderTargetSetup ワーカーのリストに現在の描画先を設定する関数
+    /// @param workerCount ワーカー数（kMaxRecordingWorkers以下に制限）
+    void InitializeParallelRecording(CommandManager* commandManager,
+        std::function<void(ID3D12GraphicsCommandList*)> renderTargetSetup, uint32_t workerCount);
+
+    /// @brief 並列記録の有効/無効を切り替え
+    void SetParallelRecordingEnabled(bool enabled) { recorder_.SetEnabled(enabled); }
+
+    /// @brief 並列記録が有効か
+    bool IsParallelRecordingEnabled() const { return recorder_.IsEnabled(); }
+
+    /// @brief 並列記録のワーカー数を取得
+    uint32_t GetRecordingWorkerCount() const { return recorder_.GetWorkerCount(); }
+
+    /// @brief 直近のDrawAllで並列記録に使用したチャンク数（0ならシリアル記録）
+    uint32_t GetLastParallelChunkCount() const { return lastParallelChunkCount_; }
     
 private:
     struct DrawCommand {
@@ -68,6 +96,28 @@ private:
     
     /// @brief 描画パスごとにソート
     void SortDrawQueue();
+
+    /// @brief キューの範囲を指定したコマンドリストに記録
+    /// @param cmdList 記録先
+    /// @param begin 先頭インデックス
+    /// @param end 終端インデックス（含まない）
+    void RecordRange(ID3D12GraphicsCommandList* cmdList, size_t begin, size_t end);
+
+    /// @brief キューの範囲をワーカースレッドで並列に記録して実行
+    /// @param end 終端インデックス（先頭から end までを並列記録する）
+    void RecordParallel(size_t end);
+
+    /// @brief 並列記録できる描画パスか（オブジェクトのDrawとBeginPassがスレッドセーフなもの）
+    static bool IsParallelSafePass(RenderPassType passType);
+
+    /// @brief 描画されずに残っているスプライトをメインのコマンドリストに描画
+    void FlushPendingSprites();
+
+    // 並列記録
+    ParallelRecorder recorder_;
+    CommandManager* commandManager_ = nullptr;
+    std::function<void(ID3D12GraphicsCommandList*)> renderTargetSetup_;
+    uint32_t lastParallelChunkCount_ = 0;
     
     /// @brief 描画パスタイプに応じた適切なカメラを取得
     /// @param passType 描画パスタイプ
@@ -0,0 +1,121 @@
+#include "SpriteBatch.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+	constexpr uint32_t kOrderBits = 24;
+	constexpr uint32_t kTextureBits = 20;
+	constexpr uint32_t kBlendBits = 4;
+	constexpr uint64_t kOrderMask = (1ull << kOrderBits) - 1;
+
+	/// @brief ローカル座標（z=0, w=1）を行列で変換
+	Vector4 TransformPoint(float x, float y, const Matrix4x4& m)
+	{
+		return {
+			x * m.m[0][0] + y * m.m[1][0] + m.m[3][0],
+			x * m.m[0][1] + y * m.m[1][1] + m.m[3][1],
+			x * m.m[0][2] + y * m.m[1][2] + m.m[3][2],
+			x * m.m[0][3] + y * m.m[1][3] + m.m[3][3],
+		};
+	}
+
+	/// @brief UV座標を変換（UV変換はアフィン変換なので、頂点で変換して補間しても結果は変わらない）
+	Vector2 TransformUV(float u, float v, const Matrix4x4& m)
+	{
+		return {
+			u * m.m[0][0] + v * m.m[1][0] + m.m[3][0],
+			u * m.m[0][1] + v * m.m[1][1] + m.m[3][1],
+		};
+	}
+}
+
+void SpriteBatch::Clear()
+{
+	vertices_.clear();
+	keys_.clear();
+	textureKeys_.clear();
+	textureIds_.clear();
+	runs_.clear();
+}
+
+bool SpriteBatch::Add(const SpriteQuadDesc& desc)
+{
+	uint32_t order = GetQuadCount();
+	if (order >= kMaxQuadCount) {
+		return false;
+	}
+	uint32_t textureId = GetTextureId(desc.textureKey);
+	if (textureId >= kMaxTextureCount) {
+		return false;
+	}
+
+	// 頂点（0=左下, 1=左上, 2=右下, 3=右上）
+	const float xs[kVerticesPerQuad] = { desc.left, desc.left, desc.right, desc.right };
+	const float ys[kVerticesPerQuad] = { desc.bottom, desc.top, desc.bottom, desc.top };
+	const float us[kVerticesPerQuad] = { desc.uvMin.x, desc.uvMin.x, desc.uvMax.x, desc.uvMax.x };
+	const float vs[kVerticesPerQuad] = { desc.uvMax.y, desc.uvMin.y, desc.uvMax.y, desc.uvMin.y };
+	for (uint32_t i = 0; i < kVerticesPerQuad; ++i) {
+		SpriteBatchVertex vertex;
+		vertex.position = TransformPoint(xs[i], ys[i], desc.wvp);
+		vertex.texcoord = TransformUV(us[i], vs[i], desc.uvTransform);
+		vertex.color = desc.color;
+		vertices_.push_back(vertex);
+	}
+
+	keys_.push_back(MakeSortKey(desc.layer, desc.blendMode, textureId, order));
+	textureKeys_.push_back(desc.textureKey);
+	return true;
+}
+
+void SpriteBatch::Build(SpriteBatchVertex* outVertices)
+{
+	runs_.clear();
+	if (keys_.empty()) {
+		return;
+	}
+
+	// 同じテクスチャのみの場合など、追加順のまま並んでいればソートしない
+	if (!std::is_sorted(keys_.begin(), keys_.end())) {
+		std::sort(keys_.begin(), keys_.end());
+	}
+
+	const uint64_t stateShift = kOrderBits;
+	for (uint32_t i = 0; i < keys_.size(); ++i) {
+		uint64_t key = keys_[i];
+		uint32_t order = static_cast<uint32_t>(key & kOrderMask);
+
+		// 頂点を並べ替えて書き出す
+		std::memcpy(&outVertices[i * kVerticesPerQuad], &vertices_[order * kVerticesPerQuad],
+			sizeof(SpriteBatchVertex) * kVerticesPerQuad);
+
+		// 状態（レイヤー・ブレンド・テクスチャ）が変わったら新しいラン
+		if (i == 0 || (keys_[i - 1] >> stateShift) != (key >> stateShift)) {
+			Run run;
+			run.textureKey = textureKeys_[order];
+			run.blendMode = static_cast<uint8_t>((key >> (kOrderBits + kTextureBits)) & ((1u << kBlendBits) - 1));
+			run.layer = static_cast<int32_t>(key >> (kOrderBits + kTextureBits + kBlendBits)) + INT16_MIN;
+			run.firstQuad = i;
+			runs_.push_back(run);
+		}
+		++runs_.back().quadCount;
+	}
+}
+
+uint64_t SpriteBatch::MakeSortKey(int32_t layer, uint8_t blendMode, uint32_t textureId, uint32_t order)
+{
+	// レイヤーは16bitに収めて符号なしにずらす（負のレイヤーが先に並ぶ）
+	int32_t clamped = (std::clamp)(layer, static_cast<int32_t>(INT16_MIN), static_cast<int32_t>(INT16_MAX));
+	uint64_t layerBits = static_cast<uint64_t>(clamped - INT16_MIN);
+
+	uint64_t key = layerBits;
+	key = (key << kBlendBits) | (blendMode & ((1u << kBlendBits) - 1));
+	key = (key << kTextureBits) | textureId;
+	key = (key << kOrderBits) | order;
+	return key;
+}
+
+uint32_t SpriteBatch::GetTextureId(uint64_t textureKey)
+{
+	auto it = textureIds_.try_emplace(textureKey, static_cast<uint32_t>(textureIds_.size())).first;
+	return it->second;
+}
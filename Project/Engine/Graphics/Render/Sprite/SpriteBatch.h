@@ -0,0 +1,108 @@
+#pragma once
+#include "Matrix/Matrix4x4.h"
+#include "Vector/Vector2.h"
+#include "Vector/Vector4.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/// @brief バッチ描画用の頂点（変換済み、シェーダーと完全一致）
+struct SpriteBatchVertex {
+    Vector4 position; ///< クリップ空間の位置
+    Vector2 texcoord; ///< UV変換適用済みのUV座標
+    Vector4 color;    ///< 乗算する色
+};
+
+/// @brief 1枚分のスプライトの描画要求
+struct SpriteQuadDesc {
+    /// @brief 単位行列
+    static constexpr Matrix4x4 kIdentity = { { { 1.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f } } };
+
+    Matrix4x4 wvp = kIdentity;                      ///< ローカル座標からクリップ空間への変換
+    float left = 0.0f;                              ///< ローカル座標の左端
+    float right = 1.0f;                             ///< ローカル座標の右端
+    float top = 0.0f;                               ///< ローカル座標の上端
+    float bottom = 1.0f;                            ///< ローカル座標の下端
+    Vector2 uvMin = { 0.0f, 0.0f };                 ///< UV座標範囲（左上）
+    Vector2 uvMax = { 1.0f, 1.0f };                 ///< UV座標範囲（右下）
+    Matrix4x4 uvTransform = kIdentity;              ///< UV変換行列
+    Vector4 color = { 1.0f, 1.0f, 1.0f, 1.0f };     ///< 色
+    uint64_t textureKey = 0;                        ///< テクスチャの識別子（SRVのGPUハンドル）
+    uint8_t blendMode = 0;                          ///< ブレンドモード（BlendModeの値）
+    int32_t layer = 0;                              ///< 描画レイヤー（小さいほど先に描画）
+};
+
+/// @brief スプライトのバッチ構築（変換・ソート・ラン分割）
+/// @details D3D12に依存しないので、単体で検証・計測できる。
+/// Add で頂点をCPU側で変換して追加し、Build で レイヤー → ブレンドモード → テクスチャ → 追加順 に並べて書き出す。
+/// 同じレイヤー・ブレンドモード・テクスチャが連続する範囲（ラン）は1回の描画にまとめられる。
+/// 同じレイヤー内ではテクスチャ順になるため、重なり順を保証したいスプライトはレイヤーを分けること。
+class SpriteBatch {
+public:
+    /// @brief 同じ状態で描画できる連続したスプライトの範囲
+    struct Run {
+        uint64_t textureKey = 0;
+        uint8_t blendMode = 0;
+        int32_t layer = 0;
+        uint32_t firstQuad = 0; ///< 書き出した頂点配列内の先頭スプライト
+        uint32_t quadCount = 0; ///< スプライト数
+    };
+
+    /// @brief 1クワッドあたりの頂点数
+    static constexpr uint32_t kVerticesPerQuad = 4;
+
+    /// @brief 1クワッドあたりのインデックス数
+    static constexpr uint32_t kIndicesPerQuad = 6;
+
+    /// @brief 1回のバッチで扱える最大スプライト数（ソートキーの追加順のビット数で決まる）
+    static constexpr uint32_t kMaxQuadCount = 1u << 24;
+
+    /// @brief 1回のバッチで扱える最大テクスチャ数
+    static constexpr uint32_t kMaxTextureCount = 1u << 20;
+
+    /// @brief 追加したスプライトを破棄（確保したメモリは残す）
+    void Clear();
+
+    /// @brief スプライトを追加（頂点はこの時点で変換する）
+    /// @param desc 描画要求
+    /// @return 追加できればtrue（上限に達した場合はfalse）
+    bool Add(const SpriteQuadDesc& desc);
+
+    /// @brief ソートして頂点を書き出し、ランを求める
+    /// @param outVertices 書き出し先（GetQuadCount() * kVerticesPerQuad 個分）
+    void Build(SpriteBatchVertex* outVertices);
+
+    /// @brief 追加したスプライト数
+    uint32_t GetQuadCount() const { return static_cast<uint32_t>(keys_.size()); }
+
+    /// @brief スプライトが追加されていないか
+    bool IsEmpty() const { return keys_.empty(); }
+
+    /// @brief Build で求めたラン
+    const std::vector<Run>& GetRuns() const { return runs_; }
+
+    /// @brief クワッドのインデックス（0=左下, 1=左上, 2=右下, 3=右上）
+    /// @param quadIndex クワッド番号
+    /// @param out 6個分の書き出し先
+    template<typename Index>
+    static void WriteQuadIndices(uint32_t quadIndex, Index* out)
+    {
+        constexpr uint32_t kOffsets[kIndicesPerQuad] = { 0, 1, 2, 1, 3, 2 };
+        for (uint32_t i = 0; i < kIndicesPerQuad; ++i) {
+            out[i] = static_cast<Index>(quadIndex * kVerticesPerQuad + kOffsets[i]);
+        }
+    }
+
+private:
+    /// @brief ソートキーを作成（上位から レイヤー16bit / ブレンド4bit / テクスチャ20bit / 追加順24bit）
+    static uint64_t MakeSortKey(int32_t layer, uint8_t blendMode, uint32_t textureId, uint32_t order);
+
+    /// @brief テクスチャを初出順の番号に変換
+    uint32_t GetTextureId(uint64_t textureKey);
+
+    std::vector<SpriteBatchVertex> vertices_;        ///< 追加順の変換済み頂点
+    std::vector<uint64_t> keys_;                     ///< ソートキー（下位ビットが追加順）
+    std::vector<uint64_t> textureKeys_;              ///< 追加順のテクスチャ
+    std::unordered_map<uint64_t, uint32_t> textureIds_;
+    std::vector<Run> runs_;
+};
@@ -1,28 +1,17 @@
 #include "SpriteRenderer.h"
 #include "Engine/Camera/ICamera.h"
-#include "Engine/Graphics/Structs/SpriteMaterial.h"
 #include "WinApp/WinApp.h"
+#include <algorithm>
 #include <cassert>
 
 void SpriteRenderer::Initialize(ID3D12Device* device) {
-    // 基本的な初期化のみ（定数バッファプールは作らない）
+    // 基本的な初期化のみ（頂点バッファは作らない）
     shaderCompiler_->Initialize();
     
     // ===== RootSignatureの初期化 =====
+    // 変換・色・UV変換は頂点に含めるため、定数バッファは使わない
     
-    // Root Parameter 0: マテリアル用CBV (b0, Pixel Shader)
-    RootSignatureManager::RootDescriptorConfig materialCBV;
-    materialCBV.shaderRegister = 0;
-    materialCBV.visibility = D3D12_SHADER_VISIBILITY_PIXEL;
-    rootSignatureMg_->AddRootCBV(materialCBV);
-    
-    // Root Parameter 1: トランスフォーム用CBV (b1, Vertex Shader)
-    RootSignatureManager::RootDescriptorConfig transformCBV;
-    transformCBV.shaderRegister = 1;
-    transformCBV.visibility = D3D12_SHADER_VISIBILITY_VERTEX;
-    rootSignatureMg_->AddRootCBV(transformCBV);
-    
-    // Root Parameter 2: テクスチャ用ディスクリプタテーブル (t0, Pixel Shader)
+    // Root Parameter 0: テクスチャ用ディスクリプタテーブル (t0, Pixel Shader)
     RootSignatureManager::DescriptorRangeConfig textureRange;
     textureRange.type = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
     textureRange.numDescriptors = 1;
@@ -41,11 +30,11 @@ void SpriteRenderer::Initialize(ID3D12Device* device) {
     auto pixelShaderBlob = shaderCompiler_->CompileShader(L"Resources/Shader/Sprite/Sprite.PS.hlsl", L"ps_6_0");
     assert(pixelShaderBlob != nullptr);
     
-    // ビルダーパターンでPSOを構築
+    // ビルダーパターンでPSOを構築（入力レイアウトは SpriteBatchVertex と一致させる）
     bool result = psoMg_->CreateBuilder()
         .AddInputElement("POSITION", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, D3D12_APPEND_ALIGNED_ELEMENT)
         .AddInputElement("TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, D3D12_APPEND_ALIGNED_ELEMENT)
-        .AddInputElement("NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, D3D12_APPEND_ALIGNED_ELEMENT)
+        .AddInputElement("COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, D3D12_APPEND_ALIGNED_ELEMENT)
         .SetRasterizer(D3D12_CULL_MODE_NONE, D3D12_FILL_MODE_SOLID)
         .SetDepthStencil(false, false) // スプライトは深度テスト無効
         .SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE)
@@ -54,9 +43,6 @@ void SpriteRenderer::Initialize(ID3D12Device* device) {
     if (!result) {
         throw std::runtime_error("Failed to create Sprite Pipeline State Object");
     }
-    
-    pipelineState_ = psoMg_->GetPipelineState(BlendMode::kBlendModeNormal); // スプライトはデフォルトでアルファブレンド
-    currentBlendMode_ = BlendMode::kBlendModeNormal;
 }
 
 void SpriteRenderer::Initialize(DirectXCommon* dxCommon, ResourceFactory* resourceFactory) {
@@ -66,46 +52,73 @@ void SpriteRenderer::Initialize(DirectXCommon* dxCommon, ResourceFactory* resour
     // デバイスを使って基本初期化
     Initialize(dxCommon->GetDevice());
     
-    // フレームごとに定数バッファプールを作成（ダブルバッファリング対応）
+    // 共有インデックスバッファを作成
+    CreateIndexBuffer();
+    
+    // フレームごとに頂点バッファを作成（ダブルバッファリング対応）
     for (UINT frameIndex = 0; frameIndex < kFrameCount; ++frameIndex) {
-        auto& matResources = materialResources_[frameIndex];
-        auto& tfResources = transformResources_[frameIndex];
-        auto& matData = materialDataPool_[frameIndex];
-        auto& tfData = transformDataPool_[frameIndex];
-        
-        matResources.resize(kMaxSpriteCount);
-        tfResources.resize(kMaxSpriteCount);
-        matData.resize(kMaxSpriteCount);
-        tfData.resize(kMaxSpriteCount);
-        
-        for (size_t i = 0; i < kMaxSpriteCount; ++i) {
-            // マテリアル用定数バッファを作成してマップ
-            matResources[i] = resourceFactory_->CreateBufferResource(dxCommon_->GetDevice(), sizeof(SpriteMaterial));
-            matResources[i]->Map(0, nullptr, reinterpret_cast<void**>(&matData[i]));
-            
-            // トランスフォーム用定数バッファを作成してマップ
-            tfResources[i] = resourceFactory_->CreateBufferResource(dxCommon_->GetDevice(), sizeof(TransformationMatrix));
-            tfResources[i]->Map(0, nullptr, reinterpret_cast<void**>(&tfData[i]));
-        }
+        currentFrameIndex_ = frameIndex;
+        EnsureVertexCapacity(kInitialQuadCapacity);
     }
+    currentFrameIndex_ = 0;
 }
 
-void SpriteRenderer::BeginPass(ID3D12GraphicsCommandList* cmdList, BlendMode blendMode) {
-    currentBufferIndex_ = 0;
-    currentFrameIndex_ = dxCommon_->GetSwapChain()->GetCurrentBackBufferIndex();
+void SpriteRenderer::CreateIndexBuffer() {
+    const UINT indexCount = kMaxQuadsPerDraw * SpriteBatch::kIndicesPerQuad;
+    std::vector<uint16_t> indices(indexCount);
+    for (uint32_t quad = 0; quad < kMaxQuadsPerDraw; ++quad) {
+        SpriteBatch::WriteQuadIndices(quad, indices.data() + quad * SpriteBatch::kIndicesPerQuad);
+    }
+    // 中身は変わらないのでデフォルトヒープに置く
+    indexResource_ = dxCommon_->GetUploadManager()->CreateStaticBuffer(indices.data(), sizeof(uint16_t) * indexCount);
     
-    if (blendMode != currentBlendMode_) {
-        currentBlendMode_ = blendMode;
-        pipelineState_ = psoMg_->GetPipelineState(blendMode);
+    indexBufferView_.BufferLocation = indexResource_->GetGPUVirtualAddress();
+    indexBufferView_.SizeInBytes = sizeof(uint16_t) * indexCount;
+    indexBufferView_.Format = DXGI_FORMAT_R16_UINT;
+}
+
+void SpriteRenderer::EnsureVertexCapacity(uint32_t requiredQuads) {
+    uint32_t capacity = quadCapacity_[currentFrameIndex_];
+    if (requiredQuads <= capacity) {
+        return;
     }
     
-    cmdList->SetGraphicsRootSignature(rootSignatureMg_->GetRootSignature());
-    cmdList->SetPipelineState(pipelineState_);
-    cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    uint32_t newCapacity = (std::max)(capacity, kInitialQuadCapacity);
+    while (newCapacity < requiredQuads) {
+        newCapacity *= 2;
+    }
+    
+    // 今フレームで記録済みの描画が古いバッファを参照しているので、破棄は次にこのフレームを使うときまで待つ
+    auto& resource = vertexResources_[currentFrameIndex_];
+    if (resource) {
+        retiredVertexResources_[currentFrameIndex_].push_back(resource);
+    }
+    
+    const size_t sizeInBytes = sizeof(SpriteBatchVertex) * SpriteBatch::kVerticesPerQuad * newCapacity;
+    resource = resourceFactory_->CreateBufferResource(dxCommon_->GetDevice(), sizeInBytes);
+    // アップロードヒープなのでマップしたまま使う
+    resource->Map(0, nullptr, reinterpret_cast<void**>(&mappedVertices_[currentFrameIndex_]));
+    quadCapacity_[currentFrameIndex_] = newCapacity;
+}
+
+void SpriteRenderer::BeginFrame() {
+    currentFrameIndex_ = dxCommon_->GetSwapChain()->GetCurrentBackBufferIndex();
+    quadCursor_ = 0;
+    retiredVertexResources_[currentFrameIndex_].clear();
+    
+    lastStatistics_ = frameStatistics_;
+    frameStatistics_ = Statistics{};
+}
+
+void SpriteRenderer::BeginPass(ID3D12GraphicsCommandList* cmdList, BlendMode blendMode) {
+    // ブレンドモードはスプライトごとに持つので、描画時にランごとに設定する
+    (void)blendMode;
+    cmdList_ = cmdList;
 }
 
 void SpriteRenderer::EndPass() {
-    // 今は空
+    Flush(cmdList_);
+    cmdList_ = nullptr;
 }
 
 void SpriteRenderer::SetCamera(const ICamera* camera) {
@@ -113,11 +126,57 @@ void SpriteRenderer::SetCamera(const ICamera* camera) {
     (void)camera;
 }
 
-size_t SpriteRenderer::GetAvailableConstantBuffer() {
-    // 循環バッファ方式でインデックスを管理
-    size_t bufferIndex = currentBufferIndex_;
-    currentBufferIndex_ = (currentBufferIndex_ + 1) % kMaxSpriteCount;
-    return bufferIndex;
+void SpriteRenderer::Submit(const SpriteQuadDesc& desc) {
+    if (!batch_.Add(desc)) {
+        assert(false && "SpriteBatch capacity exceeded");
+    }
+}
+
+void SpriteRenderer::Flush(ID3D12GraphicsCommandList* cmdList) {
+    if (!cmdList || batch_.IsEmpty()) {
+        return;
+    }
+    
+    // 今フレームの頂点バッファの続きに書き込む
+    const uint32_t quadCount = batch_.GetQuadCount();
+    EnsureVertexCapacity(quadCursor_ + quadCount);
+    batch_.Build(mappedVertices_[currentFrameIndex_] + quadCursor_ * SpriteBatch::kVerticesPerQuad);
+    
+    ID3D12Resource* vertexResource = vertexResources_[currentFrameIndex_].Get();
+    D3D12_VERTEX_BUFFER_VIEW vertexBufferView{};
+    vertexBufferView.BufferLocation = vertexResource->GetGPUVirtualAddress();
+    vertexBufferView.SizeInBytes = static_cast<UINT>(sizeof(SpriteBatchVertex) * SpriteBatch::kVerticesPerQuad * quadCapacity_[currentFrameIndex_]);
+    vertexBufferView.StrideInBytes = sizeof(SpriteBatchVertex);
+    
+    cmdList->SetGraphicsRootSignature(rootSignatureMg_->GetRootSignature());
+    cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    cmdList->IASetVertexBuffers(0, 1, &vertexBufferView);
+    cmdList->IASetIndexBuffer(&indexBufferView_);
+    
+    int currentBlendMode = -1;
+    for (const SpriteBatch::Run& run : batch_.GetRuns()) {
+        if (run.blendMode != currentBlendMode) {
+            currentBlendMode = run.blendMode;
+            cmdList->SetPipelineState(psoMg_->GetPipelineState(static_cast<BlendMode>(run.blendMode)));
+        }
+        D3D12_GPU_DESCRIPTOR_HANDLE textureHandle{ run.textureKey };
+        cmdList->SetGraphicsRootDescriptorTable(SpriteRendererRootParam::kTexture, textureHandle);
+        
+        // インデックスバッファの範囲を超える分はベース頂点をずらして分割
+        for (uint32_t offset = 0; offset < run.quadCount; offset += kMaxQuadsPerDraw) {
+            uint32_t count = (std::min)(run.quadCount - offset, kMaxQuadsPerDraw);
+            INT baseVertex = static_cast<INT>((quadCursor_ + run.firstQuad + offset) * SpriteBatch::kVerticesPerQuad);
+            cmdList->DrawIndexedInstanced(count * SpriteBatch::kIndicesPerQuad, 1, 0, baseVertex, 0);
+            ++frameStatistics_.drawCallCount;
+        }
+    }
+    
+    frameStatistics_.spriteCount += quadCount;
+    frameStatistics_.runCount += static_cast<uint32_t>(batch_.GetRuns().size());
+    frameStatistics_.quadCapacity = quadCapacity_[currentFrameIndex_];
+    
+    quadCursor_ += quadCount;
+    batch_.Clear();
 }
 
 Matrix4x4 SpriteRenderer::CalculateWVPMatrix(const Vector3& position, const Vector3& scale, const Vector3& rotation) const {
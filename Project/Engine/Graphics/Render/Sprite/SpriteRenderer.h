@@ -5,36 +5,40 @@
 #include "Engine/Graphics/Shader/ShaderCompiler.h"
 #include "Engine/Graphics/Common/DirectXCommon.h"
 #include "Engine/Graphics/Resource/ResourceFactory.h"
+#include "SpriteBatch.h"
 #include "MathCore.h"
 #include <d3d12.h>
 #include <wrl.h>
 #include <memory>
 #include <vector>
 
-// 前方宣言
-struct SpriteMaterial;
-
 // Sprite用 Root Parameter インデックス定数
 namespace SpriteRendererRootParam {
-    static constexpr UINT kMaterial = 0;     // マテリアル用CBV (b0, PS)
-    static constexpr UINT kTransform = 1;    // トランスフォーム用CBV (b1, VS)
-    static constexpr UINT kTexture = 2;      // テクスチャ用SRV (t0, PS)
+    static constexpr UINT kTexture = 0;      // テクスチャ用SRV (t0, PS)
 }
 
 /// @brief スプライト描画用レンダラー
+/// @details スプライトは Submit で SpriteBatch に溜め、パスの終了時（Flush）にまとめて描画する。
+/// 頂点はフレームごとに1つの永続マップした頂点バッファへ書き込み、
+/// 同じレイヤー・ブレンドモード・テクスチャが続く範囲（ラン）を1回の描画で発行する。
 class SpriteRenderer : public IRenderer {
 public:
-    /// @brief トランスフォーム行列
-    struct TransformationMatrix {
-        Matrix4x4 WVP;
-        Matrix4x4 world;
-    };
-    
-    /// @brief 最大スプライト数
-    static constexpr size_t kMaxSpriteCount = 1024;
-    
     /// @brief フレーム数（ダブルバッファリング）
     static constexpr UINT kFrameCount = 2;
+
+    /// @brief 頂点バッファの初期容量（スプライト数、足りなければ倍々に拡張）
+    static constexpr uint32_t kInitialQuadCapacity = 1024;
+
+    /// @brief 1回の描画で扱える最大スプライト数（16bitインデックスで表せる頂点数）
+    static constexpr uint32_t kMaxQuadsPerDraw = 65536 / SpriteBatch::kVerticesPerQuad;
+
+    /// @brief 描画の統計
+    struct Statistics {
+        uint32_t spriteCount = 0;   ///< 描画したスプライト数
+        uint32_t runCount = 0;      ///< ラン数
+        uint32_t drawCallCount = 0; ///< 発行した描画コマンド数
+        uint32_t quadCapacity = 0;  ///< 頂点バッファの容量（スプライト数）
+    };
     
     // IRendererインターフェースの実装
     void Initialize(ID3D12Device* device) override;
@@ -51,9 +55,22 @@ public:
     /// @brief ルートシグネチャを取得
     ID3D12RootSignature* GetRootSignature() const { return rootSignatureMg_->GetRootSignature(); }
     
-    /// @brief 利用可能な定数バッファのインデックスを取得
-    /// @return バッファインデックス
-    size_t GetAvailableConstantBuffer();
+    /// @brief フレームの開始（頂点バッファの書き込み位置を先頭に戻す）
+    void BeginFrame();
+
+    /// @brief スプライトを描画キューに追加（描画はFlushでまとめて行う）
+    /// @param desc 描画要求
+    void Submit(const SpriteQuadDesc& desc);
+
+    /// @brief 溜めたスプライトを描画
+    /// @param cmdList コマンドリスト
+    void Flush(ID3D12GraphicsCommandList* cmdList);
+
+    /// @brief 描画していないスプライトがあるか
+    bool HasPendingSprites() const { return !batch_.IsEmpty(); }
+
+    /// @brief 前フレームの統計を取得
+    const Statistics& GetStatistics() const { return lastStatistics_; }
     
     /// @brief WVP行列を計算
     /// @param position 位置
@@ -76,37 +93,44 @@ public:
     /// @brief ResourceFactoryを取得
     ResourceFactory* GetResourceFactory() { return resourceFactory_; }
     
-    /// @brief マテリアルデータプールを取得
-    std::vector<SpriteMaterial*>& GetMaterialDataPool() { return materialDataPool_[currentFrameIndex_]; }
-    
-    /// @brief トランスフォームデータプールを取得
-    std::vector<TransformationMatrix*>& GetTransformDataPool() { return transformDataPool_[currentFrameIndex_]; }
-    
-    /// @brief マテリアルリソースを取得
-    Microsoft::WRL::ComPtr<ID3D12Resource>& GetMaterialResource(size_t index) { return materialResources_[currentFrameIndex_][index]; }
-    
-    /// @brief トランスフォームリソースを取得
-    Microsoft::WRL::ComPtr<ID3D12Resource>& GetTransformResource(size_t index) { return transformResources_[currentFrameIndex_][index]; }
+private:
+    /// @brief 今フレームの頂点バッファの容量を確保
+    /// @param requiredQuads 必要なスプライト数
+    void EnsureVertexCapacity(uint32_t requiredQuads);
+
+    /// @brief 共有インデックスバッファを作成
+    void CreateIndexBuffer();
     
 private:
     std::unique_ptr<RootSignatureManager> rootSignatureMg_ = std::make_unique<RootSignatureManager>();
     std::unique_ptr<PipelineStateManager> psoMg_ = std::make_unique<PipelineStateManager>();
     std::unique_ptr<ShaderCompiler> shaderCompiler_ = std::make_unique<ShaderCompiler>();
     
-    ID3D12PipelineState* pipelineState_ = nullptr;
-    BlendMode currentBlendMode_ = BlendMode::kBlendModeAdd;
+    ID3D12GraphicsCommandList* cmdList_ = nullptr;
     
     // DirectXCommonとResourceFactory
     DirectXCommon* dxCommon_ = nullptr;
     ResourceFactory* resourceFactory_ = nullptr;
     
-    // 定数バッファプール（フレームごとに分離）
-    std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> materialResources_[kFrameCount];
-    std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> transformResources_[kFrameCount];
-    std::vector<SpriteMaterial*> materialDataPool_[kFrameCount];
-    std::vector<TransformationMatrix*> transformDataPool_[kFrameCount];
-    
-    // 現在のバッファインデックスとフレームインデックス
-    size_t currentBufferIndex_ = 0;
+    // バッチ構築（CPU側）
+    SpriteBatch batch_;
+
+    // 頂点バッファ（フレームごとに分離、永続マップ）
+    Microsoft::WRL::ComPtr<ID3D12Resource> vertexResources_[kFrameCount];
+    SpriteBatchVertex* mappedVertices_[kFrameCount] = {};
+    uint32_t quadCapacity_[kFrameCount] = {};
+    // フレームの途中で拡張した場合、記録済みの描画が参照する古いバッファはそのフレームが再利用されるまで残す
+    std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> retiredVertexResources_[kFrameCount];
+
+    // 全フレーム共通のインデックスバッファ（0,1,2,1,3,2 の繰り返し）
+    Microsoft::WRL::ComPtr<ID3D12Resource> indexResource_;
+    D3D12_INDEX_BUFFER_VIEW indexBufferView_{};
+
+    // 今フレームの書き込み位置（スプライト数）とフレームインデックス
+    uint32_t quadCursor_ = 0;
     UINT currentFrameIndex_ = 0;
+
+    // 統計
+    Statistics frameStatistics_;
+    Statistics lastStatistics_;
 };
@@ -41,5 +41,37 @@ Microsoft::WRL::ComPtr<ID3D12Resource> ResourceFactory::CreateBufferResource(Mic
     }
 
 
+    return bufferResource;
+}
+
+Microsoft::WRL::ComPtr<ID3D12Resource> ResourceFactory::CreateDefaultBufferResource(Microsoft::WRL::ComPtr<ID3D12Device> device, size_t sizeInBytes)
+{
+    // GPUだけが読むのでデフォルトヒープに置く
+    D3D12_HEAP_PROPERTIES heapProperties {};
+    heapProperties.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+    D3D12_RESOURCE_DESC resourceDesc {};
+    resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    resourceDesc.Width = (sizeInBytes + 255) & ~0xFF;
+    resourceDesc.Height = 1;
+    resourceDesc.DepthOrArraySize = 1;
+    resourceDesc.MipLevels = 1;
+    resourceDesc.SampleDesc.Count = 1;
+    resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+    // バッファはCOMMONから描画時に暗黙的に昇格するので、バリアは不要
+    Microsoft::WRL::ComPtr<ID3D12Resource> bufferResource;
+    HRESULT hr = device->CreateCommittedResource(
+        &heapProperties,
+        D3D12_HEAP_FLAG_NONE,
+        &resourceDesc,
+        D3D12_RESOURCE_STATE_COMMON,
+        nullptr,
+        IID_PPV_ARGS(&bufferResource));
+
+    if (FAILED(hr)) {
+        throw std::runtime_error("Failed to create default BufferResource");
+    }
+
     return bufferResource;
 }
@@ -7,4 +7,7 @@ class ResourceFactory {
 public:
     // Resourceの生成
     static Microsoft::WRL::ComPtr<ID3D12Resource> CreateBufferResource(Microsoft::WRL::ComPtr<ID3D12Device> device, size_t sizeInBytes);
+
+    // デフォルトヒープのバッファの生成（COMMON状態。UploadManagerでデータを転送する）
+    static Microsoft::WRL::ComPtr<ID3D12Resource> CreateDefaultBufferResource(Microsoft::WRL::ComPtr<ID3D12Device> device, size_t sizeInBytes);
 };
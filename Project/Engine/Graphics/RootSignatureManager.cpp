@@ -1,4 +1,5 @@
 #include "RootSignatureManager.h"
+#include "Engine/Graphics/Pipeline/PipelineStateCache.h"
 
 #include <cassert>
 
@@ -128,6 +129,10 @@ void RootSignatureManager::Create(ID3D12Device* device)
         signatureBlob_->GetBufferSize(),
         IID_PPV_ARGS(&rootSignature_));
     assert(SUCCEEDED(hr));
+
+    // PSOキャッシュのキーに使うため、内容を登録しておく
+    PipelineStateCache::GetInstance().RegisterRootSignature(
+        rootSignature_.Get(), signatureBlob_->GetBufferPointer(), signatureBlob_->GetBufferSize());
 }
 
 void RootSignatureManager::Clear()
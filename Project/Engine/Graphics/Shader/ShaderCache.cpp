@@ -0,0 +1,265 @@
+#include "ShaderCache.h"
+#include "ShaderCompiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+
+#include "Utility/Logger/Logger.h"
+
+ShaderCache& ShaderCache::GetInstance()
+{
+    static ShaderCache instance;
+    return instance;
+}
+
+void ShaderCache::Initialize(const std::filesystem::path& cacheDirectory)
+{
+    cacheDirectory_ = cacheDirectory;
+
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDirectory_, ec);
+    if (ec) {
+        // ディスクに保存できなくてもメモリ上のキャッシュは使える
+        Logger::GetInstance().Log("Failed to create shader cache directory: " + ec.message(), LogLevel::WARNING, LogCategory::Shader);
+    }
+
+    // 前回使用したシェーダーの一覧を読み込む
+    std::string manifestText;
+    if (ReadFile(GetManifestPath(), manifestText)) {
+        manifest_ = ShaderCacheFormat::ParseManifest(manifestText);
+    }
+
+    initialized_ = true;
+}
+
+void ShaderCache::Finalize()
+{
+    if (!initialized_) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // 存在しなくなったシェーダーを一覧から外し、現在のキーを集める
+    std::vector<ShaderCompileRequest> validRequests;
+    std::unordered_set<std::string> liveFiles;
+    for (const auto& request : manifest_) {
+        uint64_t key = 0;
+        if (ShaderCacheFormat::ComputeKey(request, includeDirs_, &ShaderCache::ReadFile, key)) {
+            validRequests.push_back(request);
+            liveFiles.insert(GetBlobPath(key).filename().string());
+        }
+    }
+
+    // シェーダー一覧を保存
+    std::ofstream manifestFile(GetManifestPath(), std::ios::binary | std::ios::trunc);
+    if (manifestFile) {
+        manifestFile << ShaderCacheFormat::SerializeManifest(validRequests);
+    }
+
+    // ソースが変更されて使われなくなったキャッシュファイルを削除
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(cacheDirectory_, ec)) {
+        if (entry.path().extension() == ".dxil" && !liveFiles.contains(entry.path().filename().string())) {
+            std::filesystem::remove(entry.path(), ec);
+        }
+    }
+
+    blobs_.clear();
+    manifest_.clear();
+    initialized_ = false;
+}
+
+void ShaderCache::Precompile(uint32_t workerCount)
+{
+    if (!initialized_) {
+        return;
+    }
+
+    std::vector<ShaderCompileRequest> requests;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        requests = manifest_;
+    }
+    if (requests.empty()) {
+        return;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    // ワーカーが要求を順番に取り出して処理する
+    std::atomic<size_t> nextIndex = 0;
+    auto worker = [&]() {
+        for (size_t i = nextIndex++; i < requests.size(); i = nextIndex++) {
+            // 削除されたシェーダーは飛ばす（一覧からは終了時に外れる）
+            std::error_code ec;
+            if (!std::filesystem::exists(requests[i].filePath, ec)) {
+                continue;
+            }
+            if (IDxcBlob* blob = GetOrCompile(requests[i])) {
+                blob->Release();
+            }
+        }
+    };
+
+    uint32_t threadCount = (std::min)((std::max)(workerCount, 1u), static_cast<uint32_t>(requests.size()));
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+    Statistics statistics;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        statistics_.precompileMilliseconds = elapsed;
+        statistics = statistics_;
+    }
+    Logger::GetInstance().Log(std::format(
+        "Shader precompile: {} shaders, {} from disk, {} compiled, {} failed, {:.1f} ms ({} threads)",
+        requests.size(), statistics.diskHitCount, statistics.compileCount, statistics.failedCount, elapsed, threadCount),
+        LogLevel::INFO, LogCategory::Shader);
+}
+
+IDxcBlob* ShaderCache::GetOrCompile(const ShaderCompileRequest& request)
+{
+    // キーを計算できない（ファイルが読めない）場合はそのままコンパイルしてエラーを出す
+    uint64_t key = 0;
+    if (!ShaderCacheFormat::ComputeKey(request, includeDirs_, &ShaderCache::ReadFile, key)) {
+        return GetThreadCompiler().CompileDirect(request);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (std::find(manifest_.begin(), manifest_.end(), request) == manifest_.end()) {
+            manifest_.push_back(request);
+        }
+
+        auto it = blobs_.find(key);
+        if (it != blobs_.end()) {
+            ++statistics_.memoryHitCount;
+            it->second->AddRef();
+            return it->second.Get();
+        }
+    }
+
+    // ディスクにあれば読み込み、なければコンパイルして保存（ロックの外で行う）
+    bool fromDisk = true;
+    Microsoft::WRL::ComPtr<IDxcBlob> blob = LoadFromDisk(key);
+    if (!blob) {
+        fromDisk = false;
+        blob.Attach(GetThreadCompiler().CompileDirect(request));
+        if (blob) {
+            SaveToDisk(key, blob.Get());
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!blob) {
+        ++statistics_.failedCount;
+        return nullptr;
+    }
+    if (fromDisk) {
+        ++statistics_.diskHitCount;
+    } else {
+        ++statistics_.compileCount;
+    }
+
+    // 他のスレッドが先に登録していればそちらを使う
+    auto [it, inserted] = blobs_.emplace(key, blob);
+    it->second->AddRef();
+    return it->second.Get();
+}
+
+ShaderCache::Statistics ShaderCache::GetStatistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_;
+}
+
+bool ShaderCache::ReadFile(const std::filesystem::path& path, std::string& outContents)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    outContents = stream.str();
+    return true;
+}
+
+ShaderCompiler& ShaderCache::GetThreadCompiler()
+{
+    thread_local ShaderCompiler compiler;
+    thread_local bool initialized = false;
+    if (!initialized) {
+        compiler.Initialize();
+        initialized = true;
+    }
+    return compiler;
+}
+
+Microsoft::WRL::ComPtr<IDxcBlob> ShaderCache::LoadFromDisk(uint64_t key)
+{
+    std::string contents;
+    if (!ReadFile(GetBlobPath(key), contents)) {
+        return nullptr;
+    }
+
+    // 形式・キー・チェックサムが一致しなければ破損とみなしてコンパイルし直す
+    std::vector<uint8_t> bytes(contents.begin(), contents.end());
+    size_t offset = 0;
+    size_t size = 0;
+    if (!ShaderCacheFormat::DeserializeBlob(bytes, key, offset, size)) {
+        return nullptr;
+    }
+
+    Microsoft::WRL::ComPtr<IDxcBlob> blob;
+    blob.Attach(GetThreadCompiler().CreateBlob(bytes.data() + offset, size));
+    return blob;
+}
+
+void ShaderCache::SaveToDisk(uint64_t key, IDxcBlob* blob)
+{
+    std::vector<uint8_t> bytes = ShaderCacheFormat::SerializeBlob(key, blob->GetBufferPointer(), blob->GetBufferSize());
+
+    // 書き込み途中のファイルを読まないよう、一時ファイルに書いてから置き換える
+    std::filesystem::path path = GetBlobPath(key);
+    std::filesystem::path tempPath = path;
+    tempPath += std::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return;
+        }
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+    }
+}
+
+std::filesystem::path ShaderCache::GetBlobPath(uint64_t key) const
+{
+    return cacheDirectory_ / (ShaderCacheFormat::ToHexString(key) + ".dxil");
+}
+
+std::filesystem::path ShaderCache::GetManifestPath() const
+{
+    return cacheDirectory_ / "manifest.txt";
+}
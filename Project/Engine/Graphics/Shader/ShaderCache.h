@@ -0,0 +1,87 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <dxcapi.h>
+#include <wrl.h>
+
+#include "ShaderCacheFormat.h"
+
+class ShaderCompiler;
+
+/// @brief 全レンダラーで共有するシェーダーキャッシュ
+/// @details コンパイル結果をソース・インクルード・マクロ定義・プロファイルのハッシュで管理し、
+/// メモリとディスク（Cache/Shader/<キー>.dxil）に保存する。
+/// 使用したシェーダーの一覧を保存しておき、次回起動時はキャッシュにないものだけを並列にコンパイルする。
+class ShaderCache {
+public:
+    /// @brief 統計情報
+    struct Statistics {
+        uint32_t memoryHitCount = 0;   ///< メモリ上のキャッシュを使った回数
+        uint32_t diskHitCount = 0;     ///< ディスクのキャッシュを使った回数
+        uint32_t compileCount = 0;     ///< DXCでコンパイルした回数
+        uint32_t failedCount = 0;      ///< コンパイルに失敗した回数
+        double precompileMilliseconds = 0.0; ///< 起動時の事前コンパイルにかかった時間
+    };
+
+    /// @brief インスタンスを取得
+    static ShaderCache& GetInstance();
+
+    /// @brief 初期化（保存済みのシェーダー一覧を読み込む）
+    /// @param cacheDirectory キャッシュファイルを置くディレクトリ
+    void Initialize(const std::filesystem::path& cacheDirectory);
+
+    /// @brief 終了処理（シェーダー一覧を保存し、使われなくなったキャッシュファイルを削除）
+    void Finalize();
+
+    /// @brief 初期化済みか
+    bool IsInitialized() const { return initialized_; }
+
+    /// @brief 前回使用したシェーダーを並列に用意する（キャッシュにないものだけコンパイル）
+    /// @param workerCount ワーカースレッド数
+    void Precompile(uint32_t workerCount);
+
+    /// @brief コンパイル結果を取得（なければディスクから読み込むかコンパイル）
+    /// @param request コンパイル要求
+    /// @return コンパイル結果（呼び出し側が参照を1つ持つ。失敗した場合はnullptr）
+    IDxcBlob* GetOrCompile(const ShaderCompileRequest& request);
+
+    /// @brief 統計情報を取得
+    Statistics GetStatistics() const;
+
+private:
+    ShaderCache() = default;
+    ~ShaderCache() = default;
+    ShaderCache(const ShaderCache&) = delete;
+    ShaderCache& operator=(const ShaderCache&) = delete;
+
+    /// @brief ファイルを読み込む（キー計算用）
+    static bool ReadFile(const std::filesystem::path& path, std::string& outContents);
+
+    /// @brief スレッドごとのコンパイラを取得（DXCのインスタンスはスレッド間で共有しない）
+    static ShaderCompiler& GetThreadCompiler();
+
+    /// @brief ディスクのキャッシュを読み込む
+    Microsoft::WRL::ComPtr<IDxcBlob> LoadFromDisk(uint64_t key);
+
+    /// @brief ディスクにキャッシュを書き込む
+    void SaveToDisk(uint64_t key, IDxcBlob* blob);
+
+    /// @brief キャッシュファイルのパス
+    std::filesystem::path GetBlobPath(uint64_t key) const;
+
+    /// @brief シェーダー一覧のパス
+    std::filesystem::path GetManifestPath() const;
+
+    std::filesystem::path cacheDirectory_;
+    std::vector<std::filesystem::path> includeDirs_ = { "Resources/Shader" };
+    bool initialized_ = false;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, Microsoft::WRL::ComPtr<IDxcBlob>> blobs_; // キー -> コンパイル結果
+    std::vector<ShaderCompileRequest> manifest_; // 使用したシェーダーの一覧（前回分を含む）
+    Statistics statistics_;
+};
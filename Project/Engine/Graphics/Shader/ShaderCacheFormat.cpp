@@ -0,0 +1,342 @@
+#include "ShaderCacheFormat.h"
+
+#include <cstring>
+#include <sstream>
+#include <unordered_set>
+
+namespace ShaderCacheFormat {
+
+	namespace {
+		/// @brief キャッシュファイルの識別子 ("KSCB")
+		constexpr uint32_t kBlobMagic = 0x4243534Bu;
+
+		/// @brief キャッシュファイルのヘッダー
+		struct BlobHeader {
+			uint32_t magic;
+			uint32_t version;
+			uint64_t key;
+			uint64_t dataSize;
+			uint64_t checksum;
+		};
+
+		constexpr uint64_t kFnvPrime = 0x100000001b3ull;
+
+		/// @brief ワイド文字列をUTF-8に変換
+		std::string ToUtf8(const std::wstring& text)
+		{
+			std::u8string u8 = std::filesystem::path(text).u8string();
+			return std::string(u8.begin(), u8.end());
+		}
+
+		/// @brief UTF-8をワイド文字列に変換
+		std::wstring FromUtf8(const std::string& text)
+		{
+			return std::filesystem::path(std::u8string(text.begin(), text.end())).wstring();
+		}
+
+		/// @brief パスを比較・ハッシュ用の文字列にする
+		std::string NormalizePath(const std::filesystem::path& path)
+		{
+			std::u8string u8 = path.lexically_normal().generic_u8string();
+			return std::string(u8.begin(), u8.end());
+		}
+
+		/// @brief 文字列をハッシュ（区切りとして終端の0も含める）
+		uint64_t HashString(const std::string& text, uint64_t seed)
+		{
+			return HashBytes(text.c_str(), text.size() + 1, seed);
+		}
+
+		/// @brief コメントを空白に置き換える（改行は残す）
+		std::string StripComments(const std::string& source)
+		{
+			std::string result = source;
+			bool inLineComment = false;
+			bool inBlockComment = false;
+			for (size_t i = 0; i < result.size(); ++i) {
+				char c = result[i];
+				char next = (i + 1 < result.size()) ? result[i + 1] : '\0';
+				if (inLineComment) {
+					if (c == '\n') {
+						inLineComment = false;
+					} else {
+						result[i] = ' ';
+					}
+				} else if (inBlockComment) {
+					if (c == '*' && next == '/') {
+						result[i] = ' ';
+						result[i + 1] = ' ';
+						++i;
+						inBlockComment = false;
+					} else if (c != '\n') {
+						result[i] = ' ';
+					}
+				} else if (c == '/' && next == '/') {
+					inLineComment = true;
+					result[i] = ' ';
+				} else if (c == '/' && next == '*') {
+					inBlockComment = true;
+					result[i] = ' ';
+					result[i + 1] = ' ';
+					++i;
+				}
+			}
+			return result;
+		}
+	}
+
+	uint64_t HashBytes(const void* data, size_t size, uint64_t seed)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		uint64_t hash = seed;
+		for (size_t i = 0; i < size; ++i) {
+			hash ^= bytes[i];
+			hash *= kFnvPrime;
+		}
+		return hash;
+	}
+
+	std::vector<std::string> ExtractIncludes(const std::string& source)
+	{
+		std::vector<std::string> includes;
+		std::istringstream stream(StripComments(source));
+		std::string line;
+		while (std::getline(stream, line)) {
+			size_t pos = line.find_first_not_of(" \t");
+			if (pos == std::string::npos || line[pos] != '#') {
+				continue;
+			}
+			pos = line.find_first_not_of(" \t", pos + 1);
+			if (pos == std::string::npos || line.compare(pos, 7, "include") != 0) {
+				continue;
+			}
+			// #include"a.hlsli" のように空白がない書き方も許可
+			pos = line.find_first_not_of(" \t", pos + 7);
+			if (pos == std::string::npos || (line[pos] != '"' && line[pos] != '<')) {
+				continue;
+			}
+			char close = (line[pos] == '"') ? '"' : '>';
+			size_t end = line.find(close, pos + 1);
+			if (end == std::string::npos || end == pos + 1) {
+				continue;
+			}
+			// 引用符と山括弧を区別できるよう、山括弧の場合は先頭に '<' を残す
+			std::string name = line.substr(pos + 1, end - pos - 1);
+			includes.push_back(close == '>' ? "<" + name : name);
+		}
+		return includes;
+	}
+
+	bool CollectDependencies(
+		const std::filesystem::path& filePath,
+		const std::vector<std::filesystem::path>& includeDirs,
+		const FileReader& reader,
+		std::vector<std::filesystem::path>& outDependencies,
+		std::vector<std::string>& outContents)
+	{
+		outDependencies.clear();
+		outContents.clear();
+
+		std::unordered_set<std::string> visited;
+		std::unordered_set<std::string> missing; // 見つからなかったパス（同じ探索を繰り返さない）
+
+		auto tryRead = [&](const std::filesystem::path& path, std::string& contents) {
+			std::string key = NormalizePath(path);
+			if (missing.contains(key)) {
+				return false;
+			}
+			if (!reader(path.lexically_normal(), contents)) {
+				missing.insert(key);
+				return false;
+			}
+			return true;
+		};
+
+		// 深さ優先で記述順に辿る（同じファイルは1回だけ）
+		std::function<void(const std::filesystem::path&, std::string&&)> visit =
+			[&](const std::filesystem::path& path, std::string&& contents) {
+			std::vector<std::string> includes = ExtractIncludes(contents);
+			outDependencies.push_back(path.lexically_normal());
+			outContents.push_back(std::move(contents));
+
+			for (const std::string& include : includes) {
+				bool angled = !include.empty() && include[0] == '<';
+				std::filesystem::path name = std::filesystem::path(
+					std::u8string(include.begin() + (angled ? 1 : 0), include.end()));
+
+				// "..." はインクルード元のディレクトリを先に探す
+				std::vector<std::filesystem::path> candidates;
+				if (!angled) {
+					candidates.push_back(path.parent_path() / name);
+				}
+				for (const auto& dir : includeDirs) {
+					candidates.push_back(dir / name);
+				}
+
+				for (const auto& candidate : candidates) {
+					std::string key = NormalizePath(candidate);
+					if (visited.contains(key)) {
+						break;
+					}
+					std::string includeContents;
+					if (tryRead(candidate, includeContents)) {
+						visited.insert(key);
+						visit(candidate, std::move(includeContents));
+						break;
+					}
+				}
+			}
+		};
+
+		std::string contents;
+		if (!reader(filePath, contents)) {
+			return false;
+		}
+		visited.insert(NormalizePath(filePath));
+		visit(filePath, std::move(contents));
+		return true;
+	}
+
+	bool ComputeKey(
+		const ShaderCompileRequest& request,
+		const std::vector<std::filesystem::path>& includeDirs,
+		const FileReader& reader,
+		uint64_t& outKey,
+		std::vector<std::filesystem::path>* outDependencies)
+	{
+		std::vector<std::filesystem::path> dependencies;
+		std::vector<std::string> contents;
+		if (!CollectDependencies(request.filePath, includeDirs, reader, dependencies, contents)) {
+			return false;
+		}
+
+		uint64_t hash = HashBytes(&kFormatVersion, sizeof(kFormatVersion));
+		hash = HashString(ToUtf8(request.profile), hash);
+		for (const auto& define : request.defines) {
+			hash = HashString(ToUtf8(define), hash);
+		}
+		hash = HashString("|", hash);
+
+		// ファイルのパスと内容（インクルード先の変更・差し替えもキーに反映される）
+		for (size_t i = 0; i < dependencies.size(); ++i) {
+			hash = HashString(NormalizePath(dependencies[i]), hash);
+			uint64_t size = contents[i].size();
+			hash = HashBytes(&size, sizeof(size), hash);
+			hash = HashBytes(contents[i].data(), contents[i].size(), hash);
+		}
+
+		outKey = hash;
+		if (outDependencies) {
+			*outDependencies = std::move(dependencies);
+		}
+		return true;
+	}
+
+	std::string ToHexString(uint64_t key)
+	{
+		static const char kDigits[] = "0123456789abcdef";
+		std::string result(16, '0');
+		for (int i = 15; i >= 0; --i) {
+			result[i] = kDigits[key & 0xF];
+			key >>= 4;
+		}
+		return result;
+	}
+
+	std::vector<uint8_t> SerializeBlob(uint64_t key, const void* data, size_t size)
+	{
+		BlobHeader header{};
+		header.magic = kBlobMagic;
+		header.version = kFormatVersion;
+		header.key = key;
+		header.dataSize = size;
+		header.checksum = HashBytes(data, size);
+
+		std::vector<uint8_t> bytes(sizeof(BlobHeader) + size);
+		std::memcpy(bytes.data(), &header, sizeof(BlobHeader));
+		if (size > 0) {
+			std::memcpy(bytes.data() + sizeof(BlobHeader), data, size);
+		}
+		return bytes;
+	}
+
+	bool DeserializeBlob(const std::vector<uint8_t>& bytes, uint64_t expectedKey, size_t& outOffset, size_t& outSize)
+	{
+		if (bytes.size() < sizeof(BlobHeader)) {
+			return false;
+		}
+		BlobHeader header{};
+		std::memcpy(&header, bytes.data(), sizeof(BlobHeader));
+
+		if (header.magic != kBlobMagic || header.version != kFormatVersion || header.key != expectedKey) {
+			return false;
+		}
+		// 書き込み途中で終了した場合などの破損を検出
+		if (header.dataSize != bytes.size() - sizeof(BlobHeader)) {
+			return false;
+		}
+		const uint8_t* data = bytes.data() + sizeof(BlobHeader);
+		if (HashBytes(data, static_cast<size_t>(header.dataSize)) != header.checksum) {
+			return false;
+		}
+
+		outOffset = sizeof(BlobHeader);
+		outSize = static_cast<size_t>(header.dataSize);
+		return true;
+	}
+
+	std::string SerializeManifest(const std::vector<ShaderCompileRequest>& requests)
+	{
+		// profile<TAB>define1;define2<TAB>path
+		std::string text;
+		for (const auto& request : requests) {
+			text += ToUtf8(request.profile);
+			text += '\t';
+			for (size_t i = 0; i < request.defines.size(); ++i) {
+				if (i > 0) {
+					text += ';';
+				}
+				text += ToUtf8(request.defines[i]);
+			}
+			text += '\t';
+			text += ToUtf8(request.filePath);
+			text += '\n';
+		}
+		return text;
+	}
+
+	std::vector<ShaderCompileRequest> ParseManifest(const std::string& text)
+	{
+		std::vector<ShaderCompileRequest> requests;
+		std::istringstream stream(text);
+		std::string line;
+		while (std::getline(stream, line)) {
+			if (!line.empty() && line.back() == '\r') {
+				line.pop_back();
+			}
+			size_t first = line.find('\t');
+			size_t second = (first == std::string::npos) ? std::string::npos : line.find('\t', first + 1);
+			if (second == std::string::npos || first == 0 || second + 1 >= line.size()) {
+				continue;
+			}
+
+			ShaderCompileRequest request;
+			request.profile = FromUtf8(line.substr(0, first));
+			std::string defines = line.substr(first + 1, second - first - 1);
+			size_t begin = 0;
+			while (begin < defines.size()) {
+				size_t end = defines.find(';', begin);
+				if (end == std::string::npos) {
+					end = defines.size();
+				}
+				if (end > begin) {
+					request.defines.push_back(FromUtf8(defines.substr(begin, end - begin)));
+				}
+				begin = end + 1;
+			}
+			request.filePath = FromUtf8(line.substr(second + 1));
+			requests.push_back(std::move(request));
+		}
+		return requests;
+	}
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+/// @brief シェーダーのコンパイル要求
+struct ShaderCompileRequest {
+    std::wstring filePath;             ///< シェーダーファイルのパス
+    std::wstring profile;              ///< シェーダープロファイル（vs_6_0 など）
+    std::vector<std::wstring> defines; ///< マクロ定義（"NAME" または "NAME=VALUE"）
+
+    bool operator==(const ShaderCompileRequest& other) const = default;
+};
+
+/// @brief シェーダーキャッシュのキー計算・依存関係の収集・ファイル形式
+/// @details DXCやD3D12に依存しないので、単体で検証できる。
+/// キーはソースとインクルードしたファイルの内容・マクロ定義・プロファイルから求めるため、
+/// どれかが変わればキーが変わり、古いキャッシュは使われなくなる。
+namespace ShaderCacheFormat {
+
+    /// @brief ファイル読み込み関数（読めなければfalse）
+    using FileReader = std::function<bool(const std::filesystem::path& path, std::string& outContents)>;
+
+    /// @brief キャッシュ形式のバージョン（コンパイル引数を変えたら上げる）
+    constexpr uint32_t kFormatVersion = 1;
+
+    /// @brief FNV-1a 64bit の初期値
+    constexpr uint64_t kHashSeed = 0xcbf29ce484222325ull;
+
+    /// @brief バイト列のハッシュ（FNV-1a 64bit）
+    /// @param data データ
+    /// @param size バイト数
+    /// @param seed 初期値（続けてハッシュする場合は前回の結果）
+    uint64_t HashBytes(const void* data, size_t size, uint64_t seed = kHashSeed);
+
+    /// @brief ソースから #include のファイル名を取り出す（コメント内のものは除く）
+    /// @param source シェーダーソース
+    /// @return インクルードするファイル名（記述順）
+    std::vector<std::string> ExtractIncludes(const std::string& source);
+
+    /// @brief シェーダーファイルとインクルードしたファイルを再帰的に集める
+    /// @param filePath シェーダーファイル
+    /// @param includeDirs インクルードディレクトリ（"" はインクルード元と同じディレクトリの次に探す）
+    /// @param reader ファイル読み込み関数
+    /// @param outDependencies 依存ファイル（先頭はシェーダーファイル自身、見つからないインクルードは含まない）
+    /// @param outContents 各依存ファイルの内容（outDependencies と同じ順）
+    /// @return シェーダーファイル自身が読めればtrue
+    bool CollectDependencies(
+        const std::filesystem::path& filePath,
+        const std::vector<std::filesystem::path>& includeDirs,
+        const FileReader& reader,
+        std::vector<std::filesystem::path>& outDependencies,
+        std::vector<std::string>& outContents);
+
+    /// @brief コンパイル要求のキャッシュキーを計算
+    /// @param request コンパイル要求
+    /// @param includeDirs インクルードディレクトリ
+    /// @param reader ファイル読み込み関数
+    /// @param outKey キャッシュキー
+    /// @param outDependencies 依存ファイル（不要ならnullptr）
+    /// @return シェーダーファイルが読めればtrue
+    bool ComputeKey(
+        const ShaderCompileRequest& request,
+        const std::vector<std::filesystem::path>& includeDirs,
+        const FileReader& reader,
+        uint64_t& outKey,
+        std::vector<std::filesystem::path>* outDependencies = nullptr);
+
+    /// @brief キーを16桁の16進文字列にする（キャッシュファイル名に使用）
+    std::string ToHexString(uint64_t key);
+
+    /// @brief コンパイル結果をキャッシュファイルの形式にする
+    /// @param key キャッシュキー
+    /// @param data コンパイル結果
+    /// @param size バイト数
+    std::vector<uint8_t> SerializeBlob(uint64_t key, const void* data, size_t size);
+
+    /// @brief キャッシュファイルからコンパイル結果を取り出す
+    /// @param bytes キャッシュファイルの内容
+    /// @param expectedKey 期待するキー
+    /// @param outOffset コンパイル結果の先頭位置
+    /// @param outSize コンパイル結果のバイト数
+    /// @return 形式・バージョン・キー・チェックサムが一致すればtrue
+    bool DeserializeBlob(const std::vector<uint8_t>& bytes, uint64_t expectedKey, size_t& outOffset, size_t& outSize);
+
+    /// @brief コンパイル要求の一覧を保存用のテキストにする（1行1要求）
+    std::string SerializeManifest(const std::vector<ShaderCompileRequest>& requests);
+
+    /// @brief 保存したテキストからコンパイル要求の一覧を読み込む（壊れた行は無視）
+    std::vector<ShaderCompileRequest> ParseManifest(const std::string& text);
+}
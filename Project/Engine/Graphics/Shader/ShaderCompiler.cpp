@@ -2,6 +2,7 @@
 
 #include <cassert>
 
+#include "ShaderCache.h"
 #include "Utility/Logger/Logger.h"
 
 void ShaderCompiler::Initialize()
@@ -24,6 +25,34 @@ void ShaderCompiler::Initialize()
 
 IDxcBlob* ShaderCompiler::CompileShader(const std::wstring& filePath, const wchar_t* profile)
 {
+    return CompileShader(filePath, profile, {});
+}
+
+IDxcBlob* ShaderCompiler::CompileShader(const std::wstring& filePath, const wchar_t* profile, const std::vector<std::wstring>& defines)
+{
+    ShaderCompileRequest request;
+    request.filePath = filePath;
+    request.profile = profile;
+    request.defines = defines;
+
+    // 共有キャッシュがあればそちらを使う（同じシェーダーの再コンパイルを避ける）
+    IDxcBlob* shaderBlob = nullptr;
+    ShaderCache& shaderCache = ShaderCache::GetInstance();
+    if (shaderCache.IsInitialized()) {
+        shaderBlob = shaderCache.GetOrCompile(request);
+    } else {
+        shaderBlob = CompileDirect(request);
+    }
+
+    // コンパイルが上手く行かなかったら落とす
+    assert(shaderBlob != nullptr);
+    return shaderBlob;
+}
+
+IDxcBlob* ShaderCompiler::CompileDirect(const ShaderCompileRequest& request)
+{
+    const std::wstring& filePath = request.filePath;
+    const wchar_t* profile = request.profile.c_str();
 
     // これからシェーダーをコンパイルする旨をログ出力
     Logger::GetInstance().Log(std::format(L"Begin CompileShader, path:{}, profile:{}", filePath, profile), LogLevel::INFO, LogCategory::Shader);
@@ -31,8 +60,11 @@ IDxcBlob* ShaderCompiler::CompileShader(const std::wstring& filePath, const wcha
     // hlslファイルを読み込む
     IDxcBlobEncoding* shaderSource = nullptr;
     HRESULT hr = dxcUtils->LoadFile(filePath.c_str(), nullptr, &shaderSource);
-    // 読めなかったら落とす
-    assert(SUCCEEDED(hr));
+    // 読めなかったら失敗
+    if (FAILED(hr)) {
+        Logger::GetInstance().Log(std::format(L"Failed to load shader, path:{}", filePath), LogLevel::Error, LogCategory::Shader);
+        return nullptr;
+    }
     // 読み込んだファイルの内容を設定する
     DxcBuffer shaderSourceBuffer;
     shaderSourceBuffer.Ptr = shaderSource->GetBufferPointer();
@@ -40,8 +72,8 @@ IDxcBlob* ShaderCompiler::CompileShader(const std::wstring& filePath, const wcha
     // UTF-8の文字コード
     shaderSourceBuffer.Encoding = DXC_CP_UTF8;
 
-    // コンパイルする
-    LPCWSTR arguments[] = {
+    // コンパイルする（引数を変えた場合は ShaderCacheFormat::kFormatVersion を上げること）
+    std::vector<LPCWSTR> arguments = {
 
         filePath.c_str(), // コンパイル対象のhlslファイル
         L"-E",
@@ -53,26 +85,37 @@ IDxcBlob* ShaderCompiler::CompileShader(const std::wstring& filePath, const wcha
         L"-Zpr", // メモリレイアウトは行優先
         L"-I", L"Resources/Shader", // インクルードディレクトリを追加
     };
+    // マクロ定義を追加
+    for (const std::wstring& define : request.defines) {
+        arguments.push_back(L"-D");
+        arguments.push_back(define.c_str());
+    }
 
     // 実際にshaderをcompileする
     IDxcResult* shaderResult = nullptr;
     hr = dxcCompiler->Compile(&shaderSourceBuffer, // 読み込んだファイル
-        arguments, // コンパイルオプション
-        _countof(arguments), // コンパイルオプションの数
+        arguments.data(), // コンパイルオプション
+        static_cast<UINT32>(arguments.size()), // コンパイルオプションの数
         includeHandler.Get(), // includeの設定
         IID_PPV_ARGS(&shaderResult) // 結果
     );
 
-    // コンパイルが上手く行かなかったら落とす
-    assert(SUCCEEDED(hr));
+    // コンパイルが上手く行かなかったら失敗
+    if (FAILED(hr)) {
+        shaderSource->Release();
+        return nullptr;
+    }
 
-    // 警告・エラーが出たらログ出力
+    // 警告・エラーが出たらログ出力して失敗
     IDxcBlobUtf8* shaderError = nullptr;
     shaderResult->GetOutput(DXC_OUT_ERRORS, IID_PPV_ARGS(&shaderError), nullptr);
     if (shaderError != nullptr && shaderError->GetStringLength() != 0) {
         std::string errorMessage(shaderError->GetStringPointer());
         Logger::GetInstance().Log(errorMessage, LogLevel::Error, LogCategory::Shader);
-        assert(false);
+        shaderError->Release();
+        shaderResult->Release();
+        shaderSource->Release();
+        return nullptr;
     }
 
     // コンパイル結果から実行用のバイナリを取得
@@ -85,9 +128,23 @@ IDxcBlob* ShaderCompiler::CompileShader(const std::wstring& filePath, const wcha
     Logger::GetInstance().Log(std::format(L"Compile Succeeded, path:{}, profile:{}", filePath, profile), LogLevel::INFO, LogCategory::Shader);
 
     // 使わないリソースを解放
+    if (shaderError != nullptr) {
+        shaderError->Release();
+    }
     shaderResult->Release();
     shaderSource->Release();
 
     // 生成したバイナリを返す
     return shaderBlob;
 }
+
+IDxcBlob* ShaderCompiler::CreateBlob(const void* data, size_t size)
+{
+    // データはコピーされるので、呼び出し側のバッファはすぐに破棄してよい
+    IDxcBlobEncoding* blob = nullptr;
+    HRESULT hr = dxcUtils->CreateBlob(data, static_cast<UINT32>(size), DXC_CP_ACP, &blob);
+    if (FAILED(hr)) {
+        return nullptr;
+    }
+    return blob;
+}
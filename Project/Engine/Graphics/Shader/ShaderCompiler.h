@@ -1,10 +1,17 @@
 #pragma once
 #include <string>
+#include <vector>
 #include <wrl.h>
 
 #include <dxcapi.h>
 #pragma comment(lib, "dxcompiler.lib")
 
+#include "ShaderCacheFormat.h"
+
+/// <summary>
+/// DXCによるシェーダーコンパイル
+/// ShaderCacheが初期化されていれば、CompileShaderは共有キャッシュ経由でコンパイルする
+/// </summary>
 class ShaderCompiler {
 public:
     /// <summary>
@@ -22,6 +29,33 @@ public:
         const std::wstring& filePath,
         const wchar_t* profile);
 
+    /// <summary>
+    /// マクロ定義付きでシェーダーコンパイル
+    /// </summary>
+    /// <param name="filePath">Compileするシェーダのファイルパス</param>
+    /// <param name="profile">compileに使用するprofile</param>
+    /// <param name="defines">定義するマクロ名（"NAME" または "NAME=VALUE"）</param>
+    /// <returns></returns>
+    IDxcBlob* CompileShader(
+        const std::wstring& filePath,
+        const wchar_t* profile,
+        const std::vector<std::wstring>& defines);
+
+    /// <summary>
+    /// キャッシュを使わずにコンパイル（ShaderCacheから使用）
+    /// </summary>
+    /// <param name="request">コンパイル要求</param>
+    /// <returns>コンパイル結果（失敗した場合はnullptr）</returns>
+    IDxcBlob* CompileDirect(const ShaderCompileRequest& request);
+
+    /// <summary>
+    /// バイト列からBlobを作成（キャッシュファイルの読み込み用）
+    /// </summary>
+    /// <param name="data">データ</param>
+    /// <param name="size">バイト数</param>
+    /// <returns>作成したBlob（失敗した場合はnullptr）</returns>
+    IDxcBlob* CreateBlob(const void* data, size_t size);
+
 private:
     Microsoft::WRL::ComPtr<IDxcUtils> dxcUtils = nullptr;
     Microsoft::WRL::ComPtr<IDxcCompiler3> dxcCompiler = nullptr;
@@ -1,11 +1,7 @@
 #include "Sprite.h"
-#include "Engine/Graphics/Common/DirectXCommon.h"
-#include "Engine/Graphics/Resource/ResourceFactory.h"
 #include "Engine/Graphics/TextureManager.h"
 #include "Engine/Graphics/Material/MaterialManager.h"
 #include "Engine/Graphics/Render/Sprite/SpriteRenderer.h"
-#include "Engine/Graphics/Structs/VertexData.h"
-#include "Engine/Graphics/Structs/SpriteMaterial.h"
 #include "Engine/Math/Vector/Vector4.h"
 #include <cmath>
 
@@ -21,8 +17,6 @@ void Sprite::Initialize(SpriteRenderer* spriteRenderer)
 	spriteRenderer_ = spriteRenderer;
 	// デフォルト値を設定
 	Reset();
-	// 頂点バッファを作成
-	CreateVertexBuffer();
 }
 
 void Sprite::Initialize(SpriteRenderer* spriteRenderer, const std::string& textureFilePath)
@@ -34,9 +28,6 @@ void Sprite::Initialize(SpriteRenderer* spriteRenderer, const std::string& textu
 
 	// テクスチャサイズを自動設定
 	SetSizeFromTexture(textureFilePath);
-
-	// 頂点バッファを作成
-	CreateVertexBuffer();
 }
 
 void Sprite::SetSizeFromTexture(const std::string& textureFilePath)
@@ -53,98 +44,10 @@ void Sprite::SetSizeFromTexture(const std::string& textureFilePath)
 	// scale_ = { 1.0f, 1.0f, 1.0f }; // 既にResetで設定済み
 }
 
-void Sprite::CreateVertexBuffer()
-{
-	if (!spriteRenderer_) return;
-
-	// SpriteRenderer経由でDirectXCommonとResourceFactoryを取得
-	DirectXCommon* dxCommon = spriteRenderer_->GetDirectXCommon();
-	ResourceFactory* resourceFactory = spriteRenderer_->GetResourceFactory();
-
-	if (!dxCommon || !resourceFactory) return;
-
-	// 個別頂点バッファの生成（4頂点のクワッド）
-	vertexResource_ = resourceFactory->CreateBufferResource(
-		dxCommon->GetDevice(),
-		sizeof(VertexData) * 4);
-
-	// 頂点バッファビューの設定
-	vertexBufferView_.BufferLocation = vertexResource_->GetGPUVirtualAddress();
-	vertexBufferView_.SizeInBytes = sizeof(VertexData) * 4;
-	vertexBufferView_.StrideInBytes = sizeof(VertexData);
-
-	// 個別インデックスバッファの生成
-	indexResource_ = resourceFactory->CreateBufferResource(
-		dxCommon->GetDevice(),
-		sizeof(uint32_t) * 6);
-
-	uint32_t* indexData = nullptr;
-	indexResource_->Map(0, nullptr, reinterpret_cast<void**>(&indexData));
-
-	// インデックスデータ設定（時計回り）
-	indexData[0] = 0; indexData[1] = 1; indexData[2] = 2; // 一枚目
-	indexData[3] = 1; indexData[4] = 3; indexData[5] = 2; // 二枚目
-
-	indexResource_->Unmap(0, nullptr);
-
-	// インデックスバッファビューの設定
-	indexBufferView_.BufferLocation = indexResource_->GetGPUVirtualAddress();
-	indexBufferView_.SizeInBytes = sizeof(uint32_t) * 6;
-	indexBufferView_.Format = DXGI_FORMAT_R32_UINT;
-
-	// 初期頂点データを設定
-	UpdateVertexData();
-}
-
-void Sprite::UpdateVertexData()
-{
-	VertexData* vertexData = nullptr;
-	vertexResource_->Map(0, nullptr, reinterpret_cast<void**>(&vertexData));
-
-	// アンカーポイントを考慮した頂点位置計算
-	// 0-1の正規化座標（アンカーポイント適用済み）
-	float left = -anchorPoint_.x;
-	float right = 1.0f - anchorPoint_.x;
-	float top = -anchorPoint_.y;
-	float bottom = 1.0f - anchorPoint_.y;
-
-	// 頂点データ設定（0=左下, 1=左上, 2=右下, 3=右上）
-	vertexData[0].position = { left, bottom, 0.0f, 1.0f };   // 左下
-	vertexData[0].texcoord = { uvMin_.x, uvMax_.y };          // UV左下
-	vertexData[0].normal = { 0.0f, 0.0f, -1.0f };
-
-	vertexData[1].position = { left, top, 0.0f, 1.0f };       // 左上
-	vertexData[1].texcoord = { uvMin_.x, uvMin_.y };          // UV左上
-	vertexData[1].normal = { 0.0f, 0.0f, -1.0f };
-
-	vertexData[2].position = { right, bottom, 0.0f, 1.0f };   // 右下
-	vertexData[2].texcoord = { uvMax_.x, uvMax_.y };          // UV右下
-	vertexData[2].normal = { 0.0f, 0.0f, -1.0f };
-
-	vertexData[3].position = { right, top, 0.0f, 1.0f };      // 右上
-	vertexData[3].texcoord = { uvMax_.x, uvMin_.y };          // UV右上
-	vertexData[3].normal = { 0.0f, 0.0f, -1.0f };
-
-	vertexResource_->Unmap(0, nullptr);
-}
-
-
-
 void Sprite::Draw(D3D12_GPU_DESCRIPTOR_HANDLE textureHandle)
 {
 	if (!spriteRenderer_) return;
 
-	// CommandListを一度だけ取得
-	auto* commandList = spriteRenderer_->GetDirectXCommon()->GetCommandList();
-
-	// 定数バッファを取得してデータを設定
-	size_t bufferIndex = spriteRenderer_->GetAvailableConstantBuffer();
-
-	// マテリアルデータ設定
-	auto& materialData = spriteRenderer_->GetMaterialDataPool()[bufferIndex];
-	materialData->color = color_;
-	materialData->uvTransform = uvTransform_;
-
 	// 実際の描画サイズを計算（テクスチャサイズ × スケール）
 	Vector3 actualScale = {
 		textureSize_.x * scale_.x,
@@ -152,23 +55,25 @@ void Sprite::Draw(D3D12_GPU_DESCRIPTOR_HANDLE textureHandle)
 		scale_.z
 	};
 
-	// 変換行列設定（アンカーポイント補正なし、頂点データ側で対応済み）
-	auto& transformData = spriteRenderer_->GetTransformDataPool()[bufferIndex];
-	Matrix4x4 worldMatrix = Matrix::MakeAffine(actualScale, rotation_, position_);
-	transformData->WVP = spriteRenderer_->CalculateWVPMatrix(position_, actualScale, rotation_);
-	transformData->world = worldMatrix;
-
-	// 定数バッファ設定
-	commandList->SetGraphicsRootConstantBufferView(0, spriteRenderer_->GetMaterialResource(bufferIndex)->GetGPUVirtualAddress());
-	commandList->SetGraphicsRootConstantBufferView(1, spriteRenderer_->GetTransformResource(bufferIndex)->GetGPUVirtualAddress());
-	commandList->SetGraphicsRootDescriptorTable(2, textureHandle);
-
-	// 個別頂点バッファ・インデックスバッファを設定
-	commandList->IASetVertexBuffers(0, 1, &vertexBufferView_);
-	commandList->IASetIndexBuffer(&indexBufferView_);
-
-	// 描画
-	commandList->DrawIndexedInstanced(6, 1, 0, 0, 0);
+	SpriteQuadDesc desc;
+	desc.wvp = spriteRenderer_->CalculateWVPMatrix(position_, actualScale, rotation_);
+
+	// アンカーポイントを考慮した頂点位置（0-1の正規化座標）
+	desc.left = -anchorPoint_.x;
+	desc.right = 1.0f - anchorPoint_.x;
+	desc.top = -anchorPoint_.y;
+	desc.bottom = 1.0f - anchorPoint_.y;
+
+	desc.uvMin = uvMin_;
+	desc.uvMax = uvMax_;
+	desc.uvTransform = uvTransform_;
+	desc.color = color_;
+	desc.textureKey = textureHandle.ptr;
+	desc.blendMode = static_cast<uint8_t>(BlendMode::kBlendModeNormal);
+	desc.layer = layer_;
+
+	// 描画はスプライトパスの終了時（またはRenderManager::DrawAllの最後）にまとめて行う
+	spriteRenderer_->Submit(desc);
 }
 
 void Sprite::Reset()
@@ -182,11 +87,6 @@ void Sprite::Reset()
 	anchorPoint_ = { 0.0f, 0.0f };  // デフォルトを左上に設定
 	uvMin_ = { 0.0f, 0.0f };
 	uvMax_ = { 1.0f, 1.0f };
-
-	// 頂点データを更新
-	if (vertexResource_) {
-		UpdateVertexData();
-	}
 }
 
 void Sprite::SetUVOffset(float offsetX, float offsetY)
@@ -237,16 +137,11 @@ void Sprite::ChangeAnchorKeepingPosition(const Vector2& newAnchor)
 	}
 
 	anchorPoint_ = newAnchor;
-	UpdateVertexData();
 }
 
 void Sprite::SetAnchor(const Vector2& anchor)
 {
 	anchorPoint_ = anchor;
-	// 頂点データを更新（アンカーポイント変更を反映）
-	if (vertexResource_) {
-		UpdateVertexData();
-	}
 }
 
 
@@ -266,9 +161,6 @@ void Sprite::SetTextureRect(float texLeft, float texTop, float texWidth, float t
 	uvMin_.y = texTop / textureHeight;
 	uvMax_.x = (texLeft + texWidth) / textureWidth;
 	uvMax_.y = (texTop + texHeight) / textureHeight;
-
-	// 頂点データを更新
-	UpdateVertexData();
 }
 
 void Sprite::SetUVRect(float uvLeft, float uvTop, float uvRight, float uvBottom)
@@ -278,9 +170,6 @@ void Sprite::SetUVRect(float uvLeft, float uvTop, float uvRight, float uvBottom)
 	uvMin_.y = uvTop;
 	uvMax_.x = uvRight;
 	uvMax_.y = uvBottom;
-
-	// 頂点データを更新
-	UpdateVertexData();
 }
 
 bool Sprite::DrawImGui(const std::string& label, EulerTransform* uvTransform)
@@ -363,8 +252,6 @@ bool Sprite::DrawImGui(const std::string& label, EulerTransform* uvTransform)
 			if (std::abs(anchorDiff.y) > changeThreshold) {
 				position_.y += anchorDiff.y * actualHeight;
 			}
-			// 頂点データを更新
-			UpdateVertexData();
 			changed = true;
 		}
 
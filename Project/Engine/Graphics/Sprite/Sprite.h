@@ -26,8 +26,7 @@ public:
 	void Initialize(SpriteRenderer* spriteRenderer, const std::string& textureFilePath);
 
 
-	/// @brief 単体描画
-	/// @param commandList コマンドリスト
+	/// @brief 描画（SpriteRendererに追加し、まとめて描画される）
 	/// @param textureHandle テクスチャハンドル
 	void Draw(D3D12_GPU_DESCRIPTOR_HANDLE textureHandle);
 
@@ -66,6 +65,10 @@ public:
 	void SetAnchor(const Vector2& anchor);
 	Vector2 GetAnchor() const { return anchorPoint_; }
 
+	/// @brief 描画レイヤーを設定（小さいほど先に描画、同じレイヤー内はテクスチャごとにまとめて描画）
+	void SetLayer(int32_t layer) { layer_ = layer; }
+	int32_t GetLayer() const { return layer_; }
+
 
 	/// @brief UV座標をオフセット（移動）
 	/// @param offsetX X方向のオフセット
@@ -111,12 +114,6 @@ private://メンバ関数
 	/// @note 既に初期化済みのスプライトに対して後からサイズを設定する場合に使用
 	void SetSizeFromTexture(const std::string& textureFilePath);
 
-	/// @brief 頂点バッファを作成
-	void CreateVertexBuffer();
-
-	/// @brief 頂点データを更新
-	void UpdateVertexData();
-
 	/// @brief UV変換行列を計算（ImGui用ヘルパー）
 	/// @param uvTransform UV変換パラメータ
 	void UpdateUVTransformMatrix(const EulerTransform& uvTransform);
@@ -144,11 +141,8 @@ private:// メンバ変数
 	// アンカーポイント（0.0f, 0.0f = 左上、0.5f, 0.5f = 中央、1.0f, 1.0f = 右下）
 	Vector2 anchorPoint_ = { 0.0f, 0.0f };
 
-	// 頂点バッファ
-	ComPtr<ID3D12Resource> vertexResource_;
-	D3D12_VERTEX_BUFFER_VIEW vertexBufferView_{};
-	ComPtr<ID3D12Resource> indexResource_;
-	D3D12_INDEX_BUFFER_VIEW indexBufferView_{};
+	// 描画レイヤー
+	int32_t layer_ = 0;
 
 	// UV座標範囲
 	Vector2 uvMin_ = { 0.0f, 0.0f };
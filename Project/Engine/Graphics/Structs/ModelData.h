@@ -16,6 +16,12 @@ struct JointWeightData {
 	std::vector<VertexWeightData> vertexWeights;
 };
 
+/// @brief 簡略化したLOD（インデックスはLOD0と同じ頂点を参照する）
+struct MeshLodData {
+	std::vector<uint32_t> indices; // インデックスデータ
+	float error = 0.0f;            // LOD0からの誤差（モデル空間の距離）
+};
+
 /// @brief モデルデータを表す構造体
 struct ModelData {
 	std::map<std::string, JointWeightData> skinClusterData; // スキンクラスター（ジョイントと頂点のウェイト情報）
@@ -23,5 +29,6 @@ struct ModelData {
 	std::vector<int32_t> indices;   // インデックスデータ
 	MaterialData material;        // マテリアルデータ
 	Node rootNode;             // Node階層構造のルート
+	std::vector<MeshLodData> lods; // LOD1以降（粗くなる順）
 };
 
@@ -5,6 +5,7 @@
 #include <d3d12.h>
 #include <wrl.h>
 
+#include "Engine/Graphics/Common/Core/DescriptorAllocator.h"
 #include "Engine/Math/Matrix/Matrix4x4.h"
 
 ///  頂点に影響を与えるジョイントの最大数
@@ -36,4 +37,5 @@ struct SkinCluster {
 	Microsoft::WRL::ComPtr<ID3D12Resource> paletteResource;    // Palette用リソース
 	std::span<WellForGPU> mappedPalette;                       // Paletteデータをマップしたもの
 	std::pair<D3D12_CPU_DESCRIPTOR_HANDLE, D3D12_GPU_DESCRIPTOR_HANDLE> paletteSrvHandle; // PaletteのSRV
+	DescriptorAllocation paletteSrvAllocation;                 // PaletteのSRVの割り当て（持ち主が解放する）
 };
@@ -0,0 +1,420 @@
+#include "BlockCompression.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace {
+    constexpr int kPixelCount = 16;
+
+    /// @brief ブロック内の色の主成分
+    struct PrincipalAxis {
+        float mean[4] = {};
+        float direction[4] = {};
+    };
+
+    /// @brief 先頭 channelCount チャンネルの主成分を求める（べき乗法）
+    PrincipalAxis ComputePrincipalAxis(const uint8_t* rgba, int channelCount)
+    {
+        PrincipalAxis axis;
+        for (int i = 0; i < kPixelCount; ++i) {
+            for (int c = 0; c < channelCount; ++c) {
+                axis.mean[c] += rgba[i * 4 + c];
+            }
+        }
+        for (int c = 0; c < channelCount; ++c) {
+            axis.mean[c] /= kPixelCount;
+        }
+
+        float covariance[4][4] = {};
+        for (int i = 0; i < kPixelCount; ++i) {
+            float d[4] = {};
+            for (int c = 0; c < channelCount; ++c) {
+                d[c] = rgba[i * 4 + c] - axis.mean[c];
+            }
+            for (int r = 0; r < channelCount; ++r) {
+                for (int c = 0; c < channelCount; ++c) {
+                    covariance[r][c] += d[r] * d[c];
+                }
+            }
+        }
+
+        // 対角成分が最大の軸から始めると収束が早い
+        int start = 0;
+        for (int c = 1; c < channelCount; ++c) {
+            if (covariance[c][c] > covariance[start][start]) {
+                start = c;
+            }
+        }
+        float v[4] = {};
+        for (int c = 0; c < channelCount; ++c) {
+            v[c] = covariance[start][c];
+        }
+
+        for (int iteration = 0; iteration < 8; ++iteration) {
+            float next[4] = {};
+            float length = 0.0f;
+            for (int r = 0; r < channelCount; ++r) {
+                for (int c = 0; c < channelCount; ++c) {
+                    next[r] += covariance[r][c] * v[c];
+                }
+                length += next[r] * next[r];
+            }
+            if (length < 1e-12f) {
+                break;
+            }
+            float inverse = 1.0f / std::sqrt(length);
+            for (int c = 0; c < channelCount; ++c) {
+                v[c] = next[c] * inverse;
+            }
+        }
+
+        float length = 0.0f;
+        for (int c = 0; c < channelCount; ++c) {
+            length += v[c] * v[c];
+        }
+        if (length < 1e-12f) {
+            // 単色などで方向が決まらない
+            for (int c = 0; c < channelCount; ++c) {
+                v[c] = 1.0f;
+            }
+            length = static_cast<float>(channelCount);
+        }
+        float inverse = 1.0f / std::sqrt(length);
+        for (int c = 0; c < channelCount; ++c) {
+            axis.direction[c] = v[c] * inverse;
+        }
+        return axis;
+    }
+
+    /// @brief 主成分の方向の両端を端点にする
+    void ComputeEndpoints(const uint8_t* rgba, const PrincipalAxis& axis, int channelCount, float* outLow, float* outHigh)
+    {
+        float minProjection = 0.0f;
+        float maxProjection = 0.0f;
+        for (int i = 0; i < kPixelCount; ++i) {
+            float projection = 0.0f;
+            for (int c = 0; c < channelCount; ++c) {
+                projection += (rgba[i * 4 + c] - axis.mean[c]) * axis.direction[c];
+            }
+            minProjection = (std::min)(minProjection, projection);
+            maxProjection = (std::max)(maxProjection, projection);
+        }
+        for (int c = 0; c < channelCount; ++c) {
+            outLow[c] = (std::clamp)(axis.mean[c] + axis.direction[c] * minProjection, 0.0f, 255.0f);
+            outHigh[c] = (std::clamp)(axis.mean[c] + axis.direction[c] * maxProjection, 0.0f, 255.0f);
+        }
+    }
+
+    /// @brief 選んだインデックスに対して端点を最小二乗で求め直す
+    /// @param weights 各ピクセルの補間係数（0で端点0、1で端点1）
+    /// @return 解けなければfalse（全ピクセルが同じ係数など）
+    bool RefineEndpoints(const uint8_t* rgba, const float* weights, int channelCount, float* outEndpoint0, float* outEndpoint1)
+    {
+        float a = 0.0f;
+        float b = 0.0f;
+        float c = 0.0f;
+        float x0[4] = {};
+        float x1[4] = {};
+        for (int i = 0; i < kPixelCount; ++i) {
+            float t = weights[i];
+            float s = 1.0f - t;
+            a += s * s;
+            b += s * t;
+            c += t * t;
+            for (int ch = 0; ch < channelCount; ++ch) {
+                x0[ch] += s * rgba[i * 4 + ch];
+                x1[ch] += t * rgba[i * 4 + ch];
+            }
+        }
+        float determinant = a * c - b * b;
+        if (std::fabs(determinant) < 1e-6f) {
+            return false;
+        }
+        float inverse = 1.0f / determinant;
+        for (int ch = 0; ch < channelCount; ++ch) {
+            outEndpoint0[ch] = (std::clamp)((c * x0[ch] - b * x1[ch]) * inverse, 0.0f, 255.0f);
+            outEndpoint1[ch] = (std::clamp)((a * x1[ch] - b * x0[ch]) * inverse, 0.0f, 255.0f);
+        }
+        return true;
+    }
+
+    // ===== BC1 =====
+
+    uint16_t Pack565(const float* rgb)
+    {
+        uint32_t r = static_cast<uint32_t>(rgb[0] * 31.0f / 255.0f + 0.5f);
+        uint32_t g = static_cast<uint32_t>(rgb[1] * 63.0f / 255.0f + 0.5f);
+        uint32_t b = static_cast<uint32_t>(rgb[2] * 31.0f / 255.0f + 0.5f);
+        return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    void Unpack565(uint16_t color, int* outRgb)
+    {
+        int r = (color >> 11) & 31;
+        int g = (color >> 5) & 63;
+        int b = color & 31;
+        outRgb[0] = (r << 3) | (r >> 2);
+        outRgb[1] = (g << 2) | (g >> 4);
+        outRgb[2] = (b << 3) | (b >> 2);
+    }
+
+    /// @brief BC1の1ブロック分の結果
+    struct BC1Block {
+        uint16_t color0 = 0;
+        uint16_t color1 = 0;
+        uint8_t indices[kPixelCount] = {};
+        uint32_t error = UINT32_MAX;
+    };
+
+    /// @brief 2色から4色モードのパレットを作り、各ピクセルに最も近い色を選ぶ
+    BC1Block EvaluateBC1(const uint8_t* rgba, uint16_t color0, uint16_t color1)
+    {
+        // 4色モードは color0 > color1 が条件
+        if (color0 < color1) {
+            std::swap(color0, color1);
+        }
+
+        BC1Block block;
+        block.color0 = color0;
+        block.color1 = color1;
+
+        int palette[4][3];
+        Unpack565(color0, palette[0]);
+        Unpack565(color1, palette[1]);
+        int paletteCount = 4;
+        if (color0 == color1) {
+            paletteCount = 1; // 3色モードになるので端点0だけを使う
+        } else {
+            for (int c = 0; c < 3; ++c) {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+            }
+        }
+
+        block.error = 0;
+        for (int i = 0; i < kPixelCount; ++i) {
+            uint32_t best = UINT32_MAX;
+            for (int k = 0; k < paletteCount; ++k) {
+                uint32_t error = 0;
+                for (int c = 0; c < 3; ++c) {
+                    int d = rgba[i * 4 + c] - palette[k][c];
+                    error += static_cast<uint32_t>(d * d);
+                }
+                if (error < best) {
+                    best = error;
+                    block.indices[i] = static_cast<uint8_t>(k);
+                }
+            }
+            block.error += best;
+        }
+        return block;
+    }
+
+    // ===== BC7（モード6） =====
+
+    constexpr int kBC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    /// @brief モード6の1ブロック分の結果
+    struct BC7Block {
+        uint8_t endpoint0[4] = {}; ///< 7bit
+        uint8_t endpoint1[4] = {};
+        uint8_t pBit0 = 0;
+        uint8_t pBit1 = 0;
+        uint8_t indices[kPixelCount] = {};
+        uint32_t error = UINT32_MAX;
+    };
+
+    /// @brief Pビットの組み合わせを全て試し、最も誤差の小さいものを best に残す
+    void EvaluateBC7(const uint8_t* rgba, const float* endpoint0, const float* endpoint1, BC7Block& best)
+    {
+        for (uint8_t p0 = 0; p0 < 2; ++p0) {
+            for (uint8_t p1 = 0; p1 < 2; ++p1) {
+                BC7Block block;
+                block.pBit0 = p0;
+                block.pBit1 = p1;
+                int e0[4];
+                int e1[4];
+                for (int c = 0; c < 4; ++c) {
+                    block.endpoint0[c] = static_cast<uint8_t>((std::clamp)(static_cast<int>(std::floor((endpoint0[c] - p0) * 0.5f + 0.5f)), 0, 127));
+                    block.endpoint1[c] = static_cast<uint8_t>((std::clamp)(static_cast<int>(std::floor((endpoint1[c] - p1) * 0.5f + 0.5f)), 0, 127));
+                    e0[c] = (block.endpoint0[c] << 1) | p0;
+                    e1[c] = (block.endpoint1[c] << 1) | p1;
+                }
+
+                int palette[16][4];
+                for (int k = 0; k < 16; ++k) {
+                    for (int c = 0; c < 4; ++c) {
+                        palette[k][c] = ((64 - kBC7Weights[k]) * e0[c] + kBC7Weights[k] * e1[c] + 32) >> 6;
+                    }
+                }
+
+                // 端点を結ぶ線への射影で目星を付け、前後1段階だけを比べる
+                float axis[4];
+                float axisLength = 0.0f;
+                for (int c = 0; c < 4; ++c) {
+                    axis[c] = static_cast<float>(e1[c] - e0[c]);
+                    axisLength += axis[c] * axis[c];
+                }
+                float inverseLength = (axisLength > 0.0f) ? 15.0f / axisLength : 0.0f;
+
+                block.error = 0;
+                for (int i = 0; i < kPixelCount; ++i) {
+                    const uint8_t* pixel = rgba + i * 4;
+                    float projection = 0.0f;
+                    for (int c = 0; c < 4; ++c) {
+                        projection += (pixel[c] - e0[c]) * axis[c];
+                    }
+                    int guess = (std::clamp)(static_cast<int>(projection * inverseLength + 0.5f), 0, 15);
+
+                    uint32_t bestError = UINT32_MAX;
+                    for (int k = (std::max)(guess - 1, 0); k <= (std::min)(guess + 1, 15); ++k) {
+                        uint32_t error = 0;
+                        for (int c = 0; c < 4; ++c) {
+                            int d = pixel[c] - palette[k][c];
+                            error += static_cast<uint32_t>(d * d);
+                        }
+                        if (error < bestError) {
+                            bestError = error;
+                            block.indices[i] = static_cast<uint8_t>(k);
+                        }
+                    }
+                    block.error += bestError;
+                }
+
+                if (block.error < best.error) {
+                    best = block;
+                }
+            }
+        }
+    }
+
+    /// @brief 下位ビットから順に書き込む
+    struct BitWriter {
+        uint8_t* out;
+        uint32_t position = 0;
+
+        void Write(uint32_t value, int bitCount)
+        {
+            for (int i = 0; i < bitCount; ++i) {
+                if ((value >> i) & 1) {
+                    out[position >> 3] |= static_cast<uint8_t>(1u << (position & 7));
+                }
+                ++position;
+            }
+        }
+    };
+}
+
+namespace BlockCompression {
+
+    void EncodeBC1(const uint8_t* rgba, uint8_t* out)
+    {
+        PrincipalAxis axis = ComputePrincipalAxis(rgba, 3);
+        float low[4];
+        float high[4];
+        ComputeEndpoints(rgba, axis, 3, low, high);
+        BC1Block best = EvaluateBC1(rgba, Pack565(high), Pack565(low));
+
+        // インデックスを固定して端点を詰め直す
+        if (best.error > 0 && best.color0 != best.color1) {
+            constexpr float kWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+            float weights[kPixelCount];
+            for (int i = 0; i < kPixelCount; ++i) {
+                weights[i] = kWeights[best.indices[i]];
+            }
+            float endpoint0[4];
+            float endpoint1[4];
+            if (RefineEndpoints(rgba, weights, 3, endpoint0, endpoint1)) {
+                BC1Block refined = EvaluateBC1(rgba, Pack565(endpoint0), Pack565(endpoint1));
+                if (refined.error < best.error) {
+                    best = refined;
+                }
+            }
+        }
+
+        uint32_t indexBits = 0;
+        for (int i = 0; i < kPixelCount; ++i) {
+            indexBits |= static_cast<uint32_t>(best.indices[i]) << (i * 2);
+        }
+        out[0] = static_cast<uint8_t>(best.color0);
+        out[1] = static_cast<uint8_t>(best.color0 >> 8);
+        out[2] = static_cast<uint8_t>(best.color1);
+        out[3] = static_cast<uint8_t>(best.color1 >> 8);
+        for (int i = 0; i < 4; ++i) {
+            out[4 + i] = static_cast<uint8_t>(indexBits >> (i * 8));
+        }
+    }
+
+    void EncodeBC4(const uint8_t* rgba, uint8_t* out)
+    {
+        int maxValue = 0;
+        int minValue = 255;
+        for (int i = 0; i < kPixelCount; ++i) {
+            maxValue = (std::max)(maxValue, static_cast<int>(rgba[i * 4]));
+            minValue = (std::min)(minValue, static_cast<int>(rgba[i * 4]));
+        }
+
+        // red0 > red1 で8段階モード（index 0 = red0, 1 = red1, 2～7 = その間）
+        out[0] = static_cast<uint8_t>(maxValue);
+        out[1] = static_cast<uint8_t>(minValue);
+        uint64_t indexBits = 0;
+        if (maxValue > minValue) {
+            int range = maxValue - minValue;
+            for (int i = 0; i < kPixelCount; ++i) {
+                int step = ((maxValue - rgba[i * 4]) * 7 + range / 2) / range;
+                uint64_t index = (step == 0) ? 0 : (step == 7) ? 1 : static_cast<uint64_t>(step + 1);
+                indexBits |= index << (i * 3);
+            }
+        }
+        for (int i = 0; i < 6; ++i) {
+            out[2 + i] = static_cast<uint8_t>(indexBits >> (i * 8));
+        }
+    }
+
+    void EncodeBC7(const uint8_t* rgba, uint8_t* out)
+    {
+        PrincipalAxis axis = ComputePrincipalAxis(rgba, 4);
+        float low[4];
+        float high[4];
+        ComputeEndpoints(rgba, axis, 4, low, high);
+
+        BC7Block best;
+        EvaluateBC7(rgba, low, high, best);
+
+        if (best.error > 0) {
+            float weights[kPixelCount];
+            for (int i = 0; i < kPixelCount; ++i) {
+                weights[i] = kBC7Weights[best.indices[i]] / 64.0f;
+            }
+            float endpoint0[4];
+            float endpoint1[4];
+            if (RefineEndpoints(rgba, weights, 4, endpoint0, endpoint1)) {
+                EvaluateBC7(rgba, endpoint0, endpoint1, best);
+            }
+        }
+
+        // 先頭ピクセルのインデックスは最上位ビットが0でなければならない（アンカー）
+        if (best.indices[0] >= 8) {
+            std::swap(best.endpoint0, best.endpoint1);
+            std::swap(best.pBit0, best.pBit1);
+            for (int i = 0; i < kPixelCount; ++i) {
+                best.indices[i] = static_cast<uint8_t>(15 - best.indices[i]);
+            }
+        }
+
+        std::memset(out, 0, 16);
+        BitWriter writer{ out };
+        writer.Write(1u << 6, 7); // モード6
+        for (int c = 0; c < 4; ++c) {
+            writer.Write(best.endpoint0[c], 7);
+            writer.Write(best.endpoint1[c], 7);
+        }
+        writer.Write(best.pBit0, 1);
+        writer.Write(best.pBit1, 1);
+        writer.Write(best.indices[0], 3);
+        for (int i = 1; i < kPixelCount; ++i) {
+            writer.Write(best.indices[i], 4);
+        }
+    }
+}
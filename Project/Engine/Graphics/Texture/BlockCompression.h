@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdint>
+
+/// @brief 4x4ピクセル単位のブロック圧縮（D3D12に依存しない）
+/// @details 入力は常に RGBA8 の16ピクセル（行優先、64バイト）。
+/// 端点は主成分の方向で求め、最小二乗で1回だけ詰め直す。品質より速度と単純さを優先した実装。
+namespace BlockCompression {
+
+    /// @brief BC1（不透明の4色モードのみ、アルファは無視）
+    /// @param rgba 16ピクセル
+    /// @param out 8バイト
+    void EncodeBC1(const uint8_t* rgba, uint8_t* out);
+
+    /// @brief BC4（Rチャンネルのみ、8段階モード）
+    /// @param rgba 16ピクセル
+    /// @param out 8バイト
+    void EncodeBC4(const uint8_t* rgba, uint8_t* out);
+
+    /// @brief BC7（モード6: 1サブセット・RGBA7bit + Pビット・4bitインデックス）
+    /// @param rgba 16ピクセル
+    /// @param out 16バイト
+    void EncodeBC7(const uint8_t* rgba, uint8_t* out);
+}
@@ -0,0 +1,618 @@
+#include "PngDecoder.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+    // ===== Deflate（RFC 1951） =====
+
+    /// @brief 最大の符号長
+    constexpr int kMaxCodeBits = 15;
+
+    /// @brief 下位ビットから順に読む
+    struct BitReader {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        size_t position = 0;
+        uint64_t buffer = 0;
+        int bitCount = 0;
+        bool overrun = false;
+
+        uint32_t Bits(int need)
+        {
+            while (bitCount < need) {
+                if (position >= size) {
+                    overrun = true;
+                    return 0;
+                }
+                buffer |= static_cast<uint64_t>(data[position++]) << bitCount;
+                bitCount += 8;
+            }
+            uint32_t value = static_cast<uint32_t>(buffer & ((1ull << need) - 1));
+            buffer >>= need;
+            bitCount -= need;
+            return value;
+        }
+
+        /// @brief バイト境界まで読み飛ばす
+        void AlignToByte()
+        {
+            buffer = 0;
+            bitCount = 0;
+        }
+    };
+
+    /// @brief 正規化ハフマン符号（符号長ごとの数と、符号順のシンボル）
+    struct Huffman {
+        uint16_t count[kMaxCodeBits + 1] = {};
+        uint16_t symbol[288] = {};
+
+        /// @brief 符号長の配列から作成
+        /// @return 符号が過剰に割り当てられていればfalse
+        bool Build(const uint8_t* lengths, int symbolCount)
+        {
+            std::memset(count, 0, sizeof(count));
+            for (int i = 0; i < symbolCount; ++i) {
+                ++count[lengths[i]];
+            }
+            if (count[0] == symbolCount) {
+                return true; // 符号なし（距離符号で起こり得る）
+            }
+            int left = 1;
+            for (int length = 1; length <= kMaxCodeBits; ++length) {
+                left <<= 1;
+                left -= count[length];
+                if (left < 0) {
+                    return false;
+                }
+            }
+
+            uint16_t offsets[kMaxCodeBits + 1] = {};
+            for (int length = 1; length < kMaxCodeBits; ++length) {
+                offsets[length + 1] = offsets[length] + count[length];
+            }
+            for (int i = 0; i < symbolCount; ++i) {
+                if (lengths[i] != 0) {
+                    symbol[offsets[lengths[i]]++] = static_cast<uint16_t>(i);
+                }
+            }
+            return true;
+        }
+
+        /// @brief 1シンボル読む（失敗したら -1）
+        int Decode(BitReader& reader) const
+        {
+            int code = 0;
+            int first = 0;
+            int index = 0;
+            for (int length = 1; length <= kMaxCodeBits; ++length) {
+                code |= static_cast<int>(reader.Bits(1));
+                int lengthCount = count[length];
+                if (code - lengthCount < first) {
+                    return symbol[index + (code - first)];
+                }
+                index += lengthCount;
+                first += lengthCount;
+                first <<= 1;
+                code <<= 1;
+                if (reader.overrun) {
+                    return -1;
+                }
+            }
+            return -1;
+        }
+    };
+
+    constexpr uint16_t kLengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    constexpr uint8_t kLengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    constexpr uint16_t kDistanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+    constexpr uint8_t kDistanceExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+    /// @brief ハフマン符号化されたブロックを展開
+    bool InflateCodes(BitReader& reader, const Huffman& lengthCode, const Huffman& distanceCode,
+        std::vector<uint8_t>& out, size_t streamStart)
+    {
+        while (true) {
+            int symbol = lengthCode.Decode(reader);
+            if (symbol < 0) {
+                return false;
+            }
+            if (symbol < 256) {
+                out.push_back(static_cast<uint8_t>(symbol));
+                continue;
+            }
+            if (symbol == 256) {
+                return !reader.overrun;
+            }
+
+            symbol -= 257;
+            if (symbol >= 29) {
+                return false;
+            }
+            size_t length = kLengthBase[symbol] + reader.Bits(kLengthExtra[symbol]);
+
+            symbol = distanceCode.Decode(reader);
+            if (symbol < 0 || symbol >= 30) {
+                return false;
+            }
+            size_t distance = kDistanceBase[symbol] + reader.Bits(kDistanceExtra[symbol]);
+            if (reader.overrun || distance > out.size() - streamStart) {
+                return false;
+            }
+
+            // 重なる場合があるので1バイトずつコピー
+            size_t from = out.size() - distance;
+            for (size_t i = 0; i < length; ++i) {
+                out.push_back(out[from + i]);
+            }
+        }
+    }
+
+    /// @brief 固定ハフマン符号
+    void BuildFixedCodes(Huffman& lengthCode, Huffman& distanceCode)
+    {
+        uint8_t lengths[288];
+        int i = 0;
+        for (; i < 144; ++i) {
+            lengths[i] = 8;
+        }
+        for (; i < 256; ++i) {
+            lengths[i] = 9;
+        }
+        for (; i < 280; ++i) {
+            lengths[i] = 7;
+        }
+        for (; i < 288; ++i) {
+            lengths[i] = 8;
+        }
+        lengthCode.Build(lengths, 288);
+
+        std::fill(lengths, lengths + 30, static_cast<uint8_t>(5));
+        distanceCode.Build(lengths, 30);
+    }
+
+    /// @brief 動的ハフマン符号を読む
+    bool ReadDynamicCodes(BitReader& reader, Huffman& lengthCode, Huffman& distanceCode)
+    {
+        constexpr uint8_t kOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+        int lengthCount = static_cast<int>(reader.Bits(5)) + 257;
+        int distanceCount = static_cast<int>(reader.Bits(5)) + 1;
+        int codeCount = static_cast<int>(reader.Bits(4)) + 4;
+        if (lengthCount > 286 || distanceCount > 30) {
+            return false;
+        }
+
+        uint8_t lengths[320] = {};
+        for (int i = 0; i < codeCount; ++i) {
+            lengths[kOrder[i]] = static_cast<uint8_t>(reader.Bits(3));
+        }
+        Huffman codeLengthCode;
+        if (!codeLengthCode.Build(lengths, 19)) {
+            return false;
+        }
+
+        std::memset(lengths, 0, sizeof(lengths));
+        int index = 0;
+        while (index < lengthCount + distanceCount) {
+            int symbol = codeLengthCode.Decode(reader);
+            if (symbol < 0) {
+                return false;
+            }
+            if (symbol < 16) {
+                lengths[index++] = static_cast<uint8_t>(symbol);
+                continue;
+            }
+
+            uint8_t value = 0;
+            int repeat = 0;
+            if (symbol == 16) {
+                if (index == 0) {
+                    return false;
+                }
+                value = lengths[index - 1];
+                repeat = 3 + static_cast<int>(reader.Bits(2));
+            } else if (symbol == 17) {
+                repeat = 3 + static_cast<int>(reader.Bits(3));
+            } else {
+                repeat = 11 + static_cast<int>(reader.Bits(7));
+            }
+            if (index + repeat > lengthCount + distanceCount) {
+                return false;
+            }
+            while (repeat-- > 0) {
+                lengths[index++] = value;
+            }
+        }
+
+        // ブロック終端の符号がなければ壊れている
+        if (lengths[256] == 0 || reader.overrun) {
+            return false;
+        }
+        return lengthCode.Build(lengths, lengthCount) && distanceCode.Build(lengths + lengthCount, distanceCount);
+    }
+
+    // ===== PNG =====
+
+    constexpr uint8_t kSignature[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+
+    uint32_t ReadBigEndian32(const uint8_t* p)
+    {
+        return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) | (static_cast<uint32_t>(p[2]) << 8) | p[3];
+    }
+
+    /// @brief 画像ヘッダー
+    struct Header {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint8_t bitDepth = 0;
+        uint8_t colorType = 0;
+        uint8_t interlace = 0;
+
+        uint32_t GetChannelCount() const
+        {
+            switch (colorType) {
+            case 0: return 1; // グレー
+            case 2: return 3; // RGB
+            case 3: return 1; // パレット
+            case 4: return 2; // グレー + アルファ
+            case 6: return 4; // RGBA
+            default: return 0;
+            }
+        }
+
+        uint32_t GetBitsPerPixel() const { return GetChannelCount() * bitDepth; }
+
+        size_t GetRowBytes(uint32_t width) const { return (static_cast<size_t>(width) * GetBitsPerPixel() + 7) / 8; }
+
+        bool IsValid() const
+        {
+            switch (colorType) {
+            case 0: return bitDepth == 1 || bitDepth == 2 || bitDepth == 4 || bitDepth == 8 || bitDepth == 16;
+            case 3: return bitDepth == 1 || bitDepth == 2 || bitDepth == 4 || bitDepth == 8;
+            case 2:
+            case 4:
+            case 6: return bitDepth == 8 || bitDepth == 16;
+            default: return false;
+            }
+        }
+    };
+
+    /// @brief 透過情報とパレット
+    struct Palette {
+        uint8_t colors[256][4] = {};
+        uint32_t colorCount = 0;
+        bool hasColorKey = false;
+        uint16_t colorKey[3] = {}; ///< グレーまたはRGBの透過色（ビット深度のままの値）
+    };
+
+    int Paeth(int a, int b, int c)
+    {
+        int p = a + b - c;
+        int pa = std::abs(p - a);
+        int pb = std::abs(p - b);
+        int pc = std::abs(p - c);
+        if (pa <= pb && pa <= pc) {
+            return a;
+        }
+        return (pb <= pc) ? b : c;
+    }
+
+    /// @brief 1行のフィルターを元に戻す
+    bool Unfilter(uint8_t filter, uint8_t* row, const uint8_t* previous, size_t rowBytes, size_t bytesPerPixel)
+    {
+        switch (filter) {
+        case 0:
+            return true;
+        case 1:
+            for (size_t i = bytesPerPixel; i < rowBytes; ++i) {
+                row[i] = static_cast<uint8_t>(row[i] + row[i - bytesPerPixel]);
+            }
+            return true;
+        case 2:
+            for (size_t i = 0; i < rowBytes; ++i) {
+                row[i] = static_cast<uint8_t>(row[i] + previous[i]);
+            }
+            return true;
+        case 3:
+            for (size_t i = 0; i < rowBytes; ++i) {
+                int left = (i >= bytesPerPixel) ? row[i - bytesPerPixel] : 0;
+                row[i] = static_cast<uint8_t>(row[i] + ((left + previous[i]) >> 1));
+            }
+            return true;
+        case 4:
+            for (size_t i = 0; i < rowBytes; ++i) {
+                int left = (i >= bytesPerPixel) ? row[i - bytesPerPixel] : 0;
+                int upperLeft = (i >= bytesPerPixel) ? previous[i - bytesPerPixel] : 0;
+                row[i] = static_cast<uint8_t>(row[i] + Paeth(left, previous[i], upperLeft));
+            }
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /// @brief 行から index 番目のサンプルを読む（ビット深度のままの値）
+    uint32_t ReadSample(const uint8_t* row, size_t index, uint8_t bitDepth)
+    {
+        if (bitDepth == 8) {
+            return row[index];
+        }
+        if (bitDepth == 16) {
+            return (static_cast<uint32_t>(row[index * 2]) << 8) | row[index * 2 + 1];
+        }
+        size_t bit = index * bitDepth;
+        uint32_t shift = 8 - bitDepth - static_cast<uint32_t>(bit % 8);
+        return (row[bit / 8] >> shift) & ((1u << bitDepth) - 1);
+    }
+
+    /// @brief サンプルを8bitに変換
+    uint8_t ToByte(uint32_t sample, uint8_t bitDepth)
+    {
+        if (bitDepth == 16) {
+            return static_cast<uint8_t>(sample >> 8);
+        }
+        if (bitDepth == 8) {
+            return static_cast<uint8_t>(sample);
+        }
+        return static_cast<uint8_t>(sample * 255 / ((1u << bitDepth) - 1));
+    }
+
+    /// @brief フィルターを戻した1行を RGBA8 に変換して書き込む
+    void ConvertRow(const Header& header, const Palette& palette, const uint8_t* row, uint32_t count,
+        TextureImage& image, uint32_t x0, uint32_t y, uint32_t dx)
+    {
+        const uint8_t depth = header.bitDepth;
+        for (uint32_t i = 0; i < count; ++i) {
+            uint8_t* pixel = image.At(x0 + i * dx, y);
+            switch (header.colorType) {
+            case 0: {
+                uint32_t gray = ReadSample(row, i, depth);
+                pixel[0] = pixel[1] = pixel[2] = ToByte(gray, depth);
+                pixel[3] = (palette.hasColorKey && gray == palette.colorKey[0]) ? 0 : 255;
+                break;
+            }
+            case 2: {
+                uint32_t r = ReadSample(row, i * 3 + 0, depth);
+                uint32_t g = ReadSample(row, i * 3 + 1, depth);
+                uint32_t b = ReadSample(row, i * 3 + 2, depth);
+                pixel[0] = ToByte(r, depth);
+                pixel[1] = ToByte(g, depth);
+                pixel[2] = ToByte(b, depth);
+                bool keyed = palette.hasColorKey && r == palette.colorKey[0] && g == palette.colorKey[1] && b == palette.colorKey[2];
+                pixel[3] = keyed ? 0 : 255;
+                break;
+            }
+            case 3: {
+                uint32_t index = ReadSample(row, i, depth);
+                std::memcpy(pixel, palette.colors[index], 4);
+                break;
+            }
+            case 4:
+                pixel[0] = pixel[1] = pixel[2] = ToByte(ReadSample(row, i * 2, depth), depth);
+                pixel[3] = ToByte(ReadSample(row, i * 2 + 1, depth), depth);
+                break;
+            case 6:
+                for (uint32_t c = 0; c < 4; ++c) {
+                    pixel[c] = ToByte(ReadSample(row, i * 4 + c, depth), depth);
+                }
+                break;
+            }
+        }
+    }
+
+    void SetError(std::string* outError, const char* message)
+    {
+        if (outError) {
+            *outError = message;
+        }
+    }
+}
+
+namespace PngDecoder {
+
+    bool Inflate(const uint8_t* data, size_t size, std::vector<uint8_t>& outData)
+    {
+        if (size < 2) {
+            return false;
+        }
+        // zlibヘッダー（deflate・プリセット辞書なし）
+        uint8_t cmf = data[0];
+        uint8_t flags = data[1];
+        if ((cmf & 0x0F) != 8 || ((cmf << 8) | flags) % 31 != 0 || (flags & 0x20) != 0) {
+            return false;
+        }
+
+        BitReader reader;
+        reader.data = data + 2;
+        reader.size = size - 2;
+        const size_t streamStart = outData.size();
+
+        Huffman fixedLength;
+        Huffman fixedDistance;
+        bool fixedBuilt = false;
+
+        bool last = false;
+        while (!last) {
+            last = reader.Bits(1) != 0;
+            uint32_t type = reader.Bits(2);
+            if (reader.overrun) {
+                return false;
+            }
+
+            if (type == 0) {
+                // 非圧縮ブロック
+                reader.AlignToByte();
+                if (reader.position + 4 > reader.size) {
+                    return false;
+                }
+                const uint8_t* p = reader.data + reader.position;
+                uint32_t length = p[0] | (p[1] << 8);
+                uint32_t inverse = p[2] | (p[3] << 8);
+                if ((length ^ 0xFFFF) != inverse || reader.position + 4 + length > reader.size) {
+                    return false;
+                }
+                outData.insert(outData.end(), p + 4, p + 4 + length);
+                reader.position += 4 + length;
+            } else if (type == 1) {
+                if (!fixedBuilt) {
+                    BuildFixedCodes(fixedLength, fixedDistance);
+                    fixedBuilt = true;
+                }
+                if (!InflateCodes(reader, fixedLength, fixedDistance, outData, streamStart)) {
+                    return false;
+                }
+            } else if (type == 2) {
+                Huffman lengthCode;
+                Huffman distanceCode;
+                if (!ReadDynamicCodes(reader, lengthCode, distanceCode) ||
+                    !InflateCodes(reader, lengthCode, distanceCode, outData, streamStart)) {
+                    return false;
+                }
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Decode(const uint8_t* data, size_t size, TextureImage& outImage, std::string* outError)
+    {
+        if (size < sizeof(kSignature) || std::memcmp(data, kSignature, sizeof(kSignature)) != 0) {
+            SetError(outError, "not a PNG file");
+            return false;
+        }
+
+        Header header;
+        Palette palette;
+        std::vector<uint8_t> compressed;
+        bool hasHeader = false;
+
+        // ===== チャンクを読む =====
+        size_t offset = sizeof(kSignature);
+        while (offset + 12 <= size) {
+            uint32_t length = ReadBigEndian32(data + offset);
+            const uint8_t* type = data + offset + 4;
+            const uint8_t* body = data + offset + 8;
+            if (length > size - offset - 12) {
+                SetError(outError, "truncated chunk");
+                return false;
+            }
+            offset += 12 + static_cast<size_t>(length);
+
+            if (std::memcmp(type, "IHDR", 4) == 0) {
+                if (length != 13) {
+                    SetError(outError, "invalid IHDR");
+                    return false;
+                }
+                header.width = ReadBigEndian32(body);
+                header.height = ReadBigEndian32(body + 4);
+                header.bitDepth = body[8];
+                header.colorType = body[9];
+                header.interlace = body[12];
+                if (!header.IsValid() || body[10] != 0 || body[11] != 0 || header.interlace > 1 ||
+                    header.width == 0 || header.height == 0 || header.width > 32768 || header.height > 32768) {
+                    SetError(outError, "unsupported PNG format");
+                    return false;
+                }
+                hasHeader = true;
+            } else if (std::memcmp(type, "PLTE", 4) == 0) {
+                palette.colorCount = (std::min)(length / 3, 256u);
+                for (uint32_t i = 0; i < palette.colorCount; ++i) {
+                    palette.colors[i][0] = body[i * 3 + 0];
+                    palette.colors[i][1] = body[i * 3 + 1];
+                    palette.colors[i][2] = body[i * 3 + 2];
+                    palette.colors[i][3] = 255;
+                }
+            } else if (std::memcmp(type, "tRNS", 4) == 0) {
+                if (header.colorType == 3) {
+                    for (uint32_t i = 0; i < (std::min)(length, 256u); ++i) {
+                        palette.colors[i][3] = body[i];
+                    }
+                } else if (header.colorType == 0 && length >= 2) {
+                    palette.hasColorKey = true;
+                    palette.colorKey[0] = static_cast<uint16_t>((body[0] << 8) | body[1]);
+                } else if (header.colorType == 2 && length >= 6) {
+                    palette.hasColorKey = true;
+                    for (int c = 0; c < 3; ++c) {
+                        palette.colorKey[c] = static_cast<uint16_t>((body[c * 2] << 8) | body[c * 2 + 1]);
+                    }
+                }
+            } else if (std::memcmp(type, "IDAT", 4) == 0) {
+                compressed.insert(compressed.end(), body, body + length);
+            } else if (std::memcmp(type, "IEND", 4) == 0) {
+                break;
+            }
+        }
+
+        if (!hasHeader || compressed.empty()) {
+            SetError(outError, "missing IHDR or IDAT");
+            return false;
+        }
+        if (header.colorType == 3 && palette.colorCount == 0) {
+            SetError(outError, "missing palette");
+            return false;
+        }
+
+        // ===== 展開 =====
+        constexpr uint32_t kStartX[7] = { 0, 4, 0, 2, 0, 1, 0 };
+        constexpr uint32_t kStartY[7] = { 0, 0, 4, 0, 2, 0, 1 };
+        constexpr uint32_t kStepX[7] = { 8, 8, 4, 4, 2, 2, 1 };
+        constexpr uint32_t kStepY[7] = { 8, 8, 8, 4, 4, 2, 2 };
+        const uint32_t passCount = header.interlace ? 7 : 1;
+
+        size_t expected = 0;
+        for (uint32_t pass = 0; pass < passCount; ++pass) {
+            uint32_t sx = header.interlace ? kStartX[pass] : 0;
+            uint32_t sy = header.interlace ? kStartY[pass] : 0;
+            uint32_t dx = header.interlace ? kStepX[pass] : 1;
+            uint32_t dy = header.interlace ? kStepY[pass] : 1;
+            uint32_t w = (header.width > sx) ? (header.width - sx + dx - 1) / dx : 0;
+            uint32_t h = (header.height > sy) ? (header.height - sy + dy - 1) / dy : 0;
+            if (w > 0 && h > 0) {
+                expected += static_cast<size_t>(h) * (1 + header.GetRowBytes(w));
+            }
+        }
+
+        std::vector<uint8_t> raw;
+        raw.reserve(expected);
+        if (!Inflate(compressed.data(), compressed.size(), raw) || raw.size() < expected) {
+            SetError(outError, "corrupt image data");
+            return false;
+        }
+
+        // ===== フィルターを戻して RGBA8 に変換 =====
+        outImage.width = header.width;
+        outImage.height = header.height;
+        outImage.pixels.assign(static_cast<size_t>(header.width) * header.height * 4, 0);
+
+        const size_t bytesPerPixel = (std::max)(header.GetBitsPerPixel() / 8, 1u);
+        size_t position = 0;
+        for (uint32_t pass = 0; pass < passCount; ++pass) {
+            uint32_t sx = header.interlace ? kStartX[pass] : 0;
+            uint32_t sy = header.interlace ? kStartY[pass] : 0;
+            uint32_t dx = header.interlace ? kStepX[pass] : 1;
+            uint32_t dy = header.interlace ? kStepY[pass] : 1;
+            uint32_t w = (header.width > sx) ? (header.width - sx + dx - 1) / dx : 0;
+            uint32_t h = (header.height > sy) ? (header.height - sy + dy - 1) / dy : 0;
+            if (w == 0 || h == 0) {
+                continue;
+            }
+
+            size_t rowBytes = header.GetRowBytes(w);
+            std::vector<uint8_t> previous(rowBytes, 0);
+            for (uint32_t y = 0; y < h; ++y) {
+                uint8_t filter = raw[position];
+                uint8_t* row = &raw[position + 1];
+                if (!Unfilter(filter, row, previous.data(), rowBytes, bytesPerPixel)) {
+                    SetError(outError, "invalid filter type");
+                    return false;
+                }
+                ConvertRow(header, palette, row, w, outImage, sx, sy + y * dy, dx);
+                std::memcpy(previous.data(), row, rowBytes);
+                position += 1 + rowBytes;
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// @brief RGBA8 の画像（行は上から順、1ピクセル4バイト）
+struct TextureImage {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> pixels;
+
+    /// @brief ピクセルの先頭
+    uint8_t* At(uint32_t x, uint32_t y) { return &pixels[(static_cast<size_t>(y) * width + x) * 4]; }
+    const uint8_t* At(uint32_t x, uint32_t y) const { return &pixels[(static_cast<size_t>(y) * width + x) * 4]; }
+};
+
+/// @brief PNGの読み込み（WICやzlibに依存しない）
+/// @details テクスチャのクッカーをWindows以外でも動かすための最小限の実装。
+/// 全てのカラータイプ・ビット深度・インターレースに対応し、RGBA8 に変換して返す（16bitは上位8bitを使う）。
+/// ガンマやカラープロファイルのチャンクは無視する。
+namespace PngDecoder {
+
+    /// @brief PNGをデコード
+    /// @param data ファイルの内容
+    /// @param size バイト数
+    /// @param outImage 結果
+    /// @param outError 失敗した理由（nullptr可）
+    /// @return 成功すればtrue
+    bool Decode(const uint8_t* data, size_t size, TextureImage& outImage, std::string* outError = nullptr);
+
+    /// @brief zlib形式のデータを展開
+    /// @param data 圧縮データ（2バイトのヘッダーを含む）
+    /// @param size バイト数
+    /// @param outData 展開結果（後ろに追記する）
+    /// @return 成功すればtrue
+    bool Inflate(const uint8_t* data, size_t size, std::vector<uint8_t>& outData);
+}
@@ -0,0 +1,412 @@
+#include "TextureCooker.h"
+#include "BlockCompression.h"
+#include "Engine/Graphics/Shader/ShaderCacheFormat.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+
+namespace {
+    // DXGI_FORMAT の値（dxgiformat.h に依存しないよう数値で持つ）
+    constexpr uint32_t kDxgiRGBA8 = 28;
+    constexpr uint32_t kDxgiRGBA8Srgb = 29;
+    constexpr uint32_t kDxgiBC1 = 71;
+    constexpr uint32_t kDxgiBC1Srgb = 72;
+    constexpr uint32_t kDxgiBC4 = 80;
+    constexpr uint32_t kDxgiBC7 = 98;
+    constexpr uint32_t kDxgiBC7Srgb = 99;
+
+    /// @brief 1ワーカーあたりの最低ブロック数（これより少なければスレッドを増やさない）
+    constexpr size_t kBlocksPerWorker = 256;
+
+    /// @brief sRGB → リニア（8bit → 0～1）
+    const float* GetSrgbToLinearTable()
+    {
+        static const auto table = [] {
+            std::vector<float> values(256);
+            for (int i = 0; i < 256; ++i) {
+                float c = i / 255.0f;
+                values[i] = (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return values;
+        }();
+        return table.data();
+    }
+
+    /// @brief リニア → sRGB（0～1を4096段階 → 8bit）
+    constexpr int kLinearTableSize = 4096;
+    const uint8_t* GetLinearToSrgbTable()
+    {
+        static const auto table = [] {
+            std::vector<uint8_t> values(kLinearTableSize + 1);
+            for (int i = 0; i <= kLinearTableSize; ++i) {
+                float c = static_cast<float>(i) / kLinearTableSize;
+                float s = (c <= 0.0031308f) ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+                values[i] = static_cast<uint8_t>((std::clamp)(s * 255.0f + 0.5f, 0.0f, 255.0f));
+            }
+            return values;
+        }();
+        return table.data();
+    }
+
+    bool IsBlockCompressed(TextureCookFormat format)
+    {
+        return format == TextureCookFormat::BC1 || format == TextureCookFormat::BC4 || format == TextureCookFormat::BC7;
+    }
+
+    uint32_t GetBlockBytes(TextureCookFormat format)
+    {
+        return (format == TextureCookFormat::BC7) ? 16u : 8u;
+    }
+
+    uint32_t GetDxgiFormat(TextureCookFormat format, bool srgb)
+    {
+        switch (format) {
+        case TextureCookFormat::BC1: return srgb ? kDxgiBC1Srgb : kDxgiBC1;
+        case TextureCookFormat::BC4: return kDxgiBC4;
+        case TextureCookFormat::BC7: return srgb ? kDxgiBC7Srgb : kDxgiBC7;
+        default: return srgb ? kDxgiRGBA8Srgb : kDxgiRGBA8;
+        }
+    }
+
+    /// @brief ミップレベルのバイト数
+    size_t GetLevelBytes(TextureCookFormat format, uint32_t width, uint32_t height)
+    {
+        if (IsBlockCompressed(format)) {
+            size_t blocksX = (std::max)(1u, (width + 3) / 4);
+            size_t blocksY = (std::max)(1u, (height + 3) / 4);
+            return blocksX * blocksY * GetBlockBytes(format);
+        }
+        return static_cast<size_t>(width) * height * 4;
+    }
+
+    void PutU32(std::vector<uint8_t>& out, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i) {
+            out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+        }
+    }
+
+    /// @brief DDSヘッダー（DX10拡張付き）を書き込む
+    void WriteDdsHeader(std::vector<uint8_t>& out, uint32_t width, uint32_t height, uint32_t mipCount, TextureCookFormat format, bool srgb)
+    {
+        constexpr uint32_t kCaps = 0x1;
+        constexpr uint32_t kHeight = 0x2;
+        constexpr uint32_t kWidth = 0x4;
+        constexpr uint32_t kPitch = 0x8;
+        constexpr uint32_t kPixelFormat = 0x1000;
+        constexpr uint32_t kMipMapCount = 0x20000;
+        constexpr uint32_t kLinearSize = 0x80000;
+        constexpr uint32_t kFourCC = 0x4;
+        constexpr uint32_t kCapsComplex = 0x8;
+        constexpr uint32_t kCapsTexture = 0x1000;
+        constexpr uint32_t kCapsMipMap = 0x400000;
+
+        const bool compressed = IsBlockCompressed(format);
+        uint32_t flags = kCaps | kHeight | kWidth | kPixelFormat | kMipMapCount;
+        flags |= compressed ? kLinearSize : kPitch;
+        uint32_t pitchOrLinearSize = compressed
+            ? static_cast<uint32_t>(GetLevelBytes(format, width, height))
+            : width * 4;
+        uint32_t caps = kCapsTexture;
+        if (mipCount > 1) {
+            caps |= kCapsComplex | kCapsMipMap;
+        }
+
+        PutU32(out, 0x20534444); // "DDS "
+        PutU32(out, 124);        // DDS_HEADER のサイズ
+        PutU32(out, flags);
+        PutU32(out, height);
+        PutU32(out, width);
+        PutU32(out, pitchOrLinearSize);
+        PutU32(out, 0);          // depth
+        PutU32(out, mipCount);
+        for (int i = 0; i < 11; ++i) {
+            PutU32(out, 0);      // reserved1
+        }
+        // DDS_PIXELFORMAT
+        PutU32(out, 32);
+        PutU32(out, kFourCC);
+        PutU32(out, 0x30315844); // "DX10"
+        for (int i = 0; i < 5; ++i) {
+            PutU32(out, 0);      // RGBBitCount・各マスク
+        }
+        PutU32(out, caps);
+        for (int i = 0; i < 4; ++i) {
+            PutU32(out, 0);      // caps2～4・reserved2
+        }
+        // DDS_HEADER_DXT10
+        PutU32(out, GetDxgiFormat(format, srgb));
+        PutU32(out, 3);          // D3D10_RESOURCE_DIMENSION_TEXTURE2D
+        PutU32(out, 0);          // miscFlag
+        PutU32(out, 1);          // arraySize
+        PutU32(out, 0);          // miscFlags2
+    }
+
+    /// @brief 1ブロック分のピクセルを集める（画像の外は端のピクセルで埋める）
+    void GatherBlock(const TextureImage& image, uint32_t blockX, uint32_t blockY, uint8_t* outPixels)
+    {
+        for (uint32_t y = 0; y < 4; ++y) {
+            uint32_t sy = (std::min)(blockY * 4 + y, image.height - 1);
+            for (uint32_t x = 0; x < 4; ++x) {
+                uint32_t sx = (std::min)(blockX * 4 + x, image.width - 1);
+                std::memcpy(outPixels + (y * 4 + x) * 4, image.At(sx, sy), 4);
+            }
+        }
+    }
+
+    /// @brief ブロック1行分を圧縮
+    void EncodeBlockRow(const TextureImage& image, TextureCookFormat format, uint32_t blockY, uint8_t* out)
+    {
+        const uint32_t blocksX = (std::max)(1u, (image.width + 3) / 4);
+        const uint32_t blockBytes = GetBlockBytes(format);
+        uint8_t pixels[64];
+        for (uint32_t blockX = 0; blockX < blocksX; ++blockX) {
+            GatherBlock(image, blockX, blockY, pixels);
+            uint8_t* block = out + static_cast<size_t>(blockX) * blockBytes;
+            switch (format) {
+            case TextureCookFormat::BC1: BlockCompression::EncodeBC1(pixels, block); break;
+            case TextureCookFormat::BC4: BlockCompression::EncodeBC4(pixels, block); break;
+            default: BlockCompression::EncodeBC7(pixels, block); break;
+            }
+        }
+    }
+}
+
+namespace TextureCooker {
+
+    uint64_t ComputeKey(const void* source, size_t size, const TextureCookSettings& settings)
+    {
+        uint64_t key = ShaderCacheFormat::HashBytes(source, size);
+        uint32_t parameters[4] = {
+            kCookVersion,
+            static_cast<uint32_t>(settings.format),
+            settings.srgb ? 1u : 0u,
+            settings.generateMips ? 1u : 0u,
+        };
+        return ShaderCacheFormat::HashBytes(parameters, sizeof(parameters), key);
+    }
+
+    std::filesystem::path GetCachePath(const std::filesystem::path& cacheDirectory, uint64_t key)
+    {
+        return cacheDirectory / (ShaderCacheFormat::ToHexString(key) + ".dds");
+    }
+
+    TextureCookFormat ChooseFormat(const TextureImage& image, const TextureCookSettings& settings)
+    {
+        if (settings.format != TextureCookFormat::Auto) {
+            return settings.format;
+        }
+        if (settings.srgb) {
+            return TextureCookFormat::BC7;
+        }
+
+        // リニアで不透明なグレースケール（ラフネス・AOなど）は1チャンネルで足りる
+        for (size_t i = 0; i < image.pixels.size(); i += 4) {
+            const uint8_t* p = &image.pixels[i];
+            if (p[0] != p[1] || p[0] != p[2] || p[3] != 255) {
+                return TextureCookFormat::BC7;
+            }
+        }
+        return TextureCookFormat::BC4;
+    }
+
+    void BuildMipChain(const TextureImage& image, bool srgb, std::vector<TextureImage>& outMips)
+    {
+        const float* toLinear = GetSrgbToLinearTable();
+        const uint8_t* toSrgb = GetLinearToSrgbTable();
+
+        outMips.clear();
+        outMips.push_back(image);
+        while (outMips.back().width > 1 || outMips.back().height > 1) {
+            const TextureImage& source = outMips.back();
+            TextureImage level;
+            level.width = (std::max)(1u, source.width / 2);
+            level.height = (std::max)(1u, source.height / 2);
+            level.pixels.resize(static_cast<size_t>(level.width) * level.height * 4);
+
+            for (uint32_t y = 0; y < level.height; ++y) {
+                uint32_t y0 = (std::min)(y * 2, source.height - 1);
+                uint32_t y1 = (std::min)(y * 2 + 1, source.height - 1);
+                for (uint32_t x = 0; x < level.width; ++x) {
+                    uint32_t x0 = (std::min)(x * 2, source.width - 1);
+                    uint32_t x1 = (std::min)(x * 2 + 1, source.width - 1);
+                    const uint8_t* samples[4] = { source.At(x0, y0), source.At(x1, y0), source.At(x0, y1), source.At(x1, y1) };
+
+                    // 透明なピクセルの色が混ざらないよう、色はアルファで重み付けして平均する
+                    float weighted[3] = {};
+                    float plain[3] = {};
+                    float alphaSum = 0.0f;
+                    for (const uint8_t* sample : samples) {
+                        float alpha = sample[3] / 255.0f;
+                        for (int c = 0; c < 3; ++c) {
+                            float value = srgb ? toLinear[sample[c]] : sample[c] / 255.0f;
+                            weighted[c] += value * alpha;
+                            plain[c] += value;
+                        }
+                        alphaSum += alpha;
+                    }
+
+                    uint8_t* pixel = level.At(x, y);
+                    for (int c = 0; c < 3; ++c) {
+                        float value = (alphaSum > 0.0f) ? weighted[c] / alphaSum : plain[c] * 0.25f;
+                        value = (std::clamp)(value, 0.0f, 1.0f);
+                        pixel[c] = srgb
+                            ? toSrgb[static_cast<int>(value * kLinearTableSize + 0.5f)]
+                            : static_cast<uint8_t>(value * 255.0f + 0.5f);
+                    }
+                    pixel[3] = static_cast<uint8_t>(alphaSum * 0.25f * 255.0f + 0.5f);
+                }
+            }
+            outMips.push_back(std::move(level));
+        }
+    }
+
+    void Cook(const TextureImage& image, const TextureCookSettings& settings, CookedTexture& out, uint32_t workerCount)
+    {
+        TextureCookFormat format = ChooseFormat(image, settings);
+        if (IsBlockCompressed(format) && (image.width % 4 != 0 || image.height % 4 != 0)) {
+            format = TextureCookFormat::RGBA8;
+        }
+
+        std::vector<TextureImage> mips;
+        if (settings.generateMips) {
+            BuildMipChain(image, settings.srgb, mips);
+        } else {
+            mips.push_back(image);
+        }
+
+        out.width = image.width;
+        out.height = image.height;
+        out.mipCount = static_cast<uint32_t>(mips.size());
+        out.format = format;
+        out.srgb = settings.srgb && format != TextureCookFormat::BC4; // BC4にsRGBのフォーマットはない
+        out.dds.clear();
+        WriteDdsHeader(out.dds, out.width, out.height, out.mipCount, format, out.srgb);
+
+        // 各ミップレベルの書き込み位置
+        const size_t headerBytes = out.dds.size();
+        std::vector<size_t> levelOffsets(mips.size());
+        size_t totalBytes = headerBytes;
+        for (size_t level = 0; level < mips.size(); ++level) {
+            levelOffsets[level] = totalBytes;
+            totalBytes += GetLevelBytes(format, mips[level].width, mips[level].height);
+        }
+        out.dds.resize(totalBytes);
+
+        if (!IsBlockCompressed(format)) {
+            for (size_t level = 0; level < mips.size(); ++level) {
+                std::memcpy(out.dds.data() + levelOffsets[level], mips[level].pixels.data(), mips[level].pixels.size());
+            }
+            return;
+        }
+
+        // ブロック1行を1タスクとして、全ミップレベルをまとめて並列に圧縮する
+        struct RowTask {
+            uint32_t level;
+            uint32_t blockY;
+        };
+        std::vector<RowTask> tasks;
+        size_t blockCount = 0;
+        for (uint32_t level = 0; level < mips.size(); ++level) {
+            uint32_t blocksX = (std::max)(1u, (mips[level].width + 3) / 4);
+            uint32_t blocksY = (std::max)(1u, (mips[level].height + 3) / 4);
+            for (uint32_t blockY = 0; blockY < blocksY; ++blockY) {
+                tasks.push_back({ level, blockY });
+            }
+            blockCount += static_cast<size_t>(blocksX) * blocksY;
+        }
+
+        auto encodeTask = [&](const RowTask& task) {
+            const TextureImage& mip = mips[task.level];
+            size_t rowBytes = static_cast<size_t>((std::max)(1u, (mip.width + 3) / 4)) * GetBlockBytes(format);
+            EncodeBlockRow(mip, format, task.blockY, out.dds.data() + levelOffsets[task.level] + rowBytes * task.blockY);
+        };
+
+        if (workerCount == 0) {
+            workerCount = (std::max)(1u, std::thread::hardware_concurrency());
+        }
+        size_t usefulWorkers = (std::max)(blockCount / kBlocksPerWorker, static_cast<size_t>(1));
+        workerCount = static_cast<uint32_t>((std::min)(static_cast<size_t>(workerCount), usefulWorkers));
+
+        if (workerCount <= 1) {
+            for (const RowTask& task : tasks) {
+                encodeTask(task);
+            }
+            return;
+        }
+
+        std::atomic<size_t> nextTask{ 0 };
+        std::vector<std::thread> workers;
+        workers.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i) {
+            workers.emplace_back([&] {
+                for (size_t index = nextTask.fetch_add(1); index < tasks.size(); index = nextTask.fetch_add(1)) {
+                    encodeTask(tasks[index]);
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    bool DecodeImage(const uint8_t* data, size_t size, TextureImage& outImage, std::string* outError)
+    {
+        return PngDecoder::Decode(data, size, outImage, outError);
+    }
+
+    bool WriteFileAtomic(const std::filesystem::path& path, const std::vector<uint8_t>& bytes)
+    {
+        std::filesystem::path tempPath = path;
+        tempPath += '.';
+        tempPath += std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        tempPath += ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            if (!file) {
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, path, ec);
+        if (ec) {
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+        return true;
+    }
+
+    bool ReadFile(const std::filesystem::path& path, std::vector<uint8_t>& outBytes)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            return false;
+        }
+        std::streamsize size = file.tellg();
+        file.seekg(0, std::ios::beg);
+        outBytes.resize(static_cast<size_t>(size));
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(outBytes.data()), size));
+    }
+
+    const char* GetFormatName(TextureCookFormat format)
+    {
+        switch (format) {
+        case TextureCookFormat::Auto: return "auto";
+        case TextureCookFormat::BC7: return "bc7";
+        case TextureCookFormat::BC1: return "bc1";
+        case TextureCookFormat::BC4: return "bc4";
+        case TextureCookFormat::RGBA8: return "rgba8";
+        }
+        return "unknown";
+    }
+}
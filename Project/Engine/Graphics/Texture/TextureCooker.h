@@ -0,0 +1,85 @@
+#pragma once
+#include "PngDecoder.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/// @brief 変換後のフォーマット
+enum class TextureCookFormat : uint32_t {
+    Auto,  ///< 内容から選ぶ（リニアのグレースケールはBC4、それ以外はBC7）
+    BC7,   ///< RGBA 8bpp（高品質）
+    BC1,   ///< RGB 4bpp（アルファなし、容量優先）
+    BC4,   ///< R 4bpp（リニアのみ）
+    RGBA8, ///< 無圧縮
+};
+
+/// @brief 変換の設定（キャッシュのキーに含まれる）
+struct TextureCookSettings {
+    TextureCookFormat format = TextureCookFormat::Auto;
+    bool srgb = true;         ///< 色をsRGBとして扱う（ミップマップの平均をリニア空間で取る）
+    bool generateMips = true; ///< 1x1までのミップマップを作る
+};
+
+/// @brief 変換結果
+struct CookedTexture {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t mipCount = 0;
+    TextureCookFormat format = TextureCookFormat::RGBA8; ///< 実際に使ったフォーマット（Auto以外）
+    bool srgb = true;
+    std::vector<uint8_t> dds; ///< DDSファイルの内容（DX10ヘッダー付き）
+};
+
+/// @brief テクスチャの事前変換（D3D12に依存しない）
+/// @details 画像からミップマップを作ってブロック圧縮し、DDSとしてキャッシュディレクトリに保存する。
+/// キャッシュファイル名は元ファイルの内容と設定のハッシュなので、元画像を差し替えれば自動的に作り直される。
+/// 実行時（TextureManager）とコマンドラインのクッカー（Tools/TextureCooker）で同じ処理を使う。
+namespace TextureCooker {
+
+    /// @brief 変換処理のバージョン（出力が変わる修正をしたら上げる）
+    constexpr uint32_t kCookVersion = 1;
+
+    /// @brief キャッシュのキーを計算
+    /// @param source 元ファイルの内容
+    /// @param size バイト数
+    /// @param settings 変換の設定
+    uint64_t ComputeKey(const void* source, size_t size, const TextureCookSettings& settings);
+
+    /// @brief キャッシュファイルのパス（<ディレクトリ>/<キー>.dds）
+    std::filesystem::path GetCachePath(const std::filesystem::path& cacheDirectory, uint64_t key);
+
+    /// @brief Auto のときに使うフォーマットを決める
+    TextureCookFormat ChooseFormat(const TextureImage& image, const TextureCookSettings& settings);
+
+    /// @brief ミップマップを作る（先頭は元画像のコピー）
+    /// @param image 元画像
+    /// @param srgb sRGBとして扱うか
+    /// @param outMips 結果（1x1まで）
+    void BuildMipChain(const TextureImage& image, bool srgb, std::vector<TextureImage>& outMips);
+
+    /// @brief 画像を変換
+    /// @param image 元画像（RGBA8）
+    /// @param settings 変換の設定
+    /// @param out 結果
+    /// @param workerCount 圧縮に使うスレッド数（0ならハードウェアのスレッド数）
+    /// @details 幅・高さが4の倍数でなければブロック圧縮できないので RGBA8 になる。
+    void Cook(const TextureImage& image, const TextureCookSettings& settings, CookedTexture& out, uint32_t workerCount = 0);
+
+    /// @brief ファイルの内容から画像をデコード（現在はPNGのみ）
+    /// @param data ファイルの内容
+    /// @param size バイト数
+    /// @param outImage 結果
+    /// @param outError 失敗した理由（nullptr可）
+    bool DecodeImage(const uint8_t* data, size_t size, TextureImage& outImage, std::string* outError = nullptr);
+
+    /// @brief 一時ファイルに書いてから置き換える（書き込み途中のファイルを読ませない）
+    bool WriteFileAtomic(const std::filesystem::path& path, const std::vector<uint8_t>& bytes);
+
+    /// @brief ファイルを読み込む
+    bool ReadFile(const std::filesystem::path& path, std::vector<uint8_t>& outBytes);
+
+    /// @brief フォーマット名（ログ・コマンドライン用）
+    const char* GetFormatName(TextureCookFormat format);
+}
@@ -1,11 +1,12 @@
 #include "TextureManager.h"
 #include "Engine/Graphics/Common/DirectXCommon.h"
-#include "Engine/Graphics/Resource/ResourceFactory.h"
 #include "Engine/Utility/Logger/Logger.h"
 
 #include "externals/DirectXTex/d3dx12.h"
 #include <vector>
 #include <cassert>
+#include <cstring>
+#include <format>
 #include <stdexcept>
 
 using namespace Microsoft::WRL;
@@ -18,12 +19,23 @@ TextureManager& TextureManager::GetInstance()
 }
 
 // 初期化
-void TextureManager::Initialize(DirectXCommon* dxCommon)
+void TextureManager::Initialize(DirectXCommon* dxCommon, const std::filesystem::path& cookCacheDirectory)
 {
 	std::lock_guard<std::mutex> lock(cacheMutex_);
 
 	assert(dxCommon != nullptr);
 	dxCommon_ = dxCommon;
+
+	cookCacheDirectory_ = cookCacheDirectory;
+	if (!cookCacheDirectory_.empty()) {
+		std::error_code ec;
+		std::filesystem::create_directories(cookCacheDirectory_, ec);
+		if (ec) {
+			Logger::GetInstance().Log("Failed to create texture cache directory: " + ec.message(), LogLevel::WARNING, LogCategory::Resource);
+			cookCacheDirectory_.clear();
+		}
+	}
+
 	isInitialized_ = true;
 }
 
@@ -50,6 +62,9 @@ TextureManager::LoadedTexture TextureManager::Load(const std::string& filePath)
 	if (filePathW.ends_with(L".dds")) { // DDSファイルの場合
 		hr = DirectX::LoadFromDDSFile(filePathW.c_str(), DirectX::DDS_FLAGS_NONE, nullptr, image);
 
+	} else if (!cookCacheDirectory_.empty() && LoadCooked(filePath, image)) { // 変換済みのテクスチャがある場合
+		hr = S_OK;
+
 	} else { // その他の形式の場合
 
 		hr = DirectX::LoadFromWICFile(filePathW.c_str(), DirectX::WIC_FLAGS_FORCE_SRGB, nullptr, image);
@@ -61,8 +76,8 @@ TextureManager::LoadedTexture TextureManager::Load(const std::string& filePath)
 
 	DirectX::ScratchImage mipImages;
 
-	if (DirectX::IsCompressed(image.GetMetadata().format)) { //圧縮フォーマットか調べる
-		mipImages = std::move(image); //圧縮フォーマットの場合はミップマップ生成せずそのまま使う
+	if (DirectX::IsCompressed(image.GetMetadata().format) || image.GetMetadata().mipLevels > 1) { //圧縮フォーマット・ミップマップ生成済みか調べる
+		mipImages = std::move(image); //その場合はミップマップ生成せずそのまま使う
 
 	} else {
 		// 画像サイズが1x1の場合はミップマップ生成をスキップ
@@ -104,29 +119,18 @@ TextureManager::LoadedTexture TextureManager::Load(const std::string& filePath)
 		&heapProperties,
 		D3D12_HEAP_FLAG_NONE,
 		&resourceDesc,
-		D3D12_RESOURCE_STATE_COPY_DEST,
+		D3D12_RESOURCE_STATE_COMMON, // コピーキューで転送し、描画時に暗黙的に昇格させる
 		nullptr,
 		IID_PPV_ARGS(&result.texture));
 	if (FAILED(hr)) {
 		throw std::runtime_error("Failed to create texture resource: " + filePath);
 	}
 
-	// 3. アップロードリソースの作成とデータ転送
+	// 3. データ転送（ステージングに書き込み、次の提出時に他のテクスチャ・バッファとまとめてコピーする）
 	std::vector<D3D12_SUBRESOURCE_DATA> subResources;
 	DirectX::PrepareUpload(dxCommon_->GetDevice(), mipImages.GetImages(), mipImages.GetImageCount(), texMetadata, subResources);
 
-	uint64_t intermediateSize = GetRequiredIntermediateSize(result.texture.Get(), 0, UINT(subResources.size()));
-	result.intermediate = ResourceFactory::CreateBufferResource(dxCommon_->GetDevice(), intermediateSize);
-
-	UpdateSubresources(dxCommon_->GetCommandList(), result.texture.Get(), result.intermediate.Get(), 0, 0, UINT(subResources.size()), subResources.data());
-
-	D3D12_RESOURCE_BARRIER barrier{};
-	barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-	barrier.Transition.pResource = result.texture.Get();
-	barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-	barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
-	barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_GENERIC_READ;
-	dxCommon_->GetCommandList()->ResourceBarrier(1, &barrier);
+	dxCommon_->GetUploadManager()->UploadTexture(result.texture.Get(), subResources.data(), 0, UINT(subResources.size()));
 
 	// 4. SRV作成
 	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
@@ -149,7 +153,7 @@ TextureManager::LoadedTexture TextureManager::Load(const std::string& filePath)
 	// DescriptorManager経由でSRVを作成
 	D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle{};
 	D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle{};
-	dxCommon_->GetDescriptorManager()->CreateSRV(
+	result.srvAllocation = dxCommon_->GetDescriptorManager()->CreateSRV(
 		result.texture.Get(),
 		srvDesc,
 		cpuHandle,
@@ -195,10 +199,82 @@ DirectX::TexMetadata TextureManager::GetMetadata(const std::string& filePath)
 	return texMetadata;
 }
 
+bool TextureManager::LoadCooked(const std::string& filePath, DirectX::ScratchImage& outImage)
+{
+	std::vector<uint8_t> source;
+	if (!TextureCooker::ReadFile(filePath, source)) {
+		return false;
+	}
+
+	// キャッシュのキーは元ファイルの内容から求めるので、画像を差し替えれば作り直される
+	uint64_t key = TextureCooker::ComputeKey(source.data(), source.size(), cookSettings_);
+	std::filesystem::path cachePath = TextureCooker::GetCachePath(cookCacheDirectory_, key);
+
+	std::error_code ec;
+	if (std::filesystem::exists(cachePath, ec)) {
+		if (SUCCEEDED(DirectX::LoadFromDDSFile(cachePath.c_str(), DirectX::DDS_FLAGS_NONE, nullptr, outImage))) {
+			return true;
+		}
+		// 読めないキャッシュは作り直す
+	}
+
+	TextureImage decoded;
+	if (!DecodeSource(filePath, source, decoded)) {
+		return false;
+	}
+
+	CookedTexture cooked;
+	TextureCooker::Cook(decoded, cookSettings_, cooked);
+	if (!TextureCooker::WriteFileAtomic(cachePath, cooked.dds)) {
+		Logger::GetInstance().Log("Failed to write cooked texture: " + cachePath.string(), LogLevel::WARNING, LogCategory::Resource);
+	}
+	Logger::GetInstance().Log(std::format("Cooked texture: {} ({}x{}, {}, {} mips)",
+		filePath, cooked.width, cooked.height, TextureCooker::GetFormatName(cooked.format), cooked.mipCount),
+		LogLevel::INFO, LogCategory::Resource);
+
+	return SUCCEEDED(DirectX::LoadFromDDSMemory(cooked.dds.data(), cooked.dds.size(), DirectX::DDS_FLAGS_NONE, nullptr, outImage));
+}
+
+bool TextureManager::DecodeSource(const std::string& filePath, const std::vector<uint8_t>& source, TextureImage& outImage)
+{
+	if (filePath.ends_with(".png") && TextureCooker::DecodeImage(source.data(), source.size(), outImage)) {
+		return true;
+	}
+
+	// PNG以外はWICで読み込み、RGBA8にそろえる（sRGBかどうかは変えない）
+	DirectX::ScratchImage wicImage;
+	if (FAILED(DirectX::LoadFromWICMemory(source.data(), source.size(), DirectX::WIC_FLAGS_FORCE_SRGB, nullptr, wicImage))) {
+		return false;
+	}
+	const DirectX::Image* top = wicImage.GetImage(0, 0, 0);
+	DirectX::ScratchImage converted;
+	if (top->format != DXGI_FORMAT_R8G8B8A8_UNORM_SRGB && top->format != DXGI_FORMAT_R8G8B8A8_UNORM) {
+		DXGI_FORMAT format = DirectX::IsSRGB(top->format) ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM;
+		if (FAILED(DirectX::Convert(*top, format, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, converted))) {
+			return false;
+		}
+		top = converted.GetImage(0, 0, 0);
+	}
+
+	outImage.width = static_cast<uint32_t>(top->width);
+	outImage.height = static_cast<uint32_t>(top->height);
+	outImage.pixels.resize(top->width * top->height * 4);
+	for (size_t y = 0; y < top->height; ++y) {
+		std::memcpy(outImage.At(0, static_cast<uint32_t>(y)), top->pixels + y * top->rowPitch, top->width * 4);
+	}
+	return true;
+}
+
 void TextureManager::Clear()
 {
 	std::lock_guard<std::mutex> lock(cacheMutex_);
 
+	// SRVを解放（GPUの処理が終わるまでは再利用されない）
+	if (dxCommon_) {
+		for (auto& [path, texture] : textureCache_) {
+			dxCommon_->GetDescriptorManager()->Free(texture.srvAllocation);
+		}
+	}
 	textureCache_.clear();
 	metadataCache_.clear();
 }
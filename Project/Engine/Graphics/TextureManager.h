@@ -2,11 +2,15 @@
 
 #include <d3d12.h>
 #include <externals/DirectXTex/DirectXTex.h>
+#include <filesystem>
 #include <string>
 #include <wrl.h>
 #include <unordered_map>
 #include <mutex>
 
+#include "Engine/Graphics/Common/Core/DescriptorAllocator.h"
+#include "Engine/Graphics/Texture/TextureCooker.h"
+
 class GameScene;
 class DirectXCommon;
 
@@ -14,9 +18,9 @@ class TextureManager {
 public:
 	struct LoadedTexture {
 		Microsoft::WRL::ComPtr<ID3D12Resource> texture;
-		Microsoft::WRL::ComPtr<ID3D12Resource> intermediate;
 		D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle;
 		D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle;
+		DescriptorAllocation srvAllocation; // Clear で解放する
 	};
 
 	// シングルトンアクセス
@@ -30,11 +34,14 @@ public:
 
 	/// @brief 初期化処理
 	/// @param dxCommon dxCommonへのポインタ
-	void Initialize(DirectXCommon* dxCommon);
+	/// @param cookCacheDirectory 変換済みテクスチャ（DDS）を置くディレクトリ（空なら変換しない）
+	void Initialize(DirectXCommon* dxCommon, const std::filesystem::path& cookCacheDirectory = {});
 
 	/// @brief テクスチャの読み込み
 	/// @param filePath ファイルパス
 	/// @return 読み込まれたテクスチャ
+	/// @details DDS以外はキャッシュディレクトリの変換済みテクスチャ（ミップマップ・ブロック圧縮済み）を読む。
+	/// なければその場で変換してキャッシュに保存し、次回以降はデコードやミップマップ生成を行わない。
 	LoadedTexture Load(const std::string& filePath);
 
 	/// @brief テクスチャのメタデータを取得
@@ -46,7 +53,7 @@ public:
 	/// @return 初期化済みならtrue
 	bool IsInitialized() const { return isInitialized_; }
 
-	/// @brief 全てのテクスチャをクリア（デバッグ用）
+	/// @brief 全てのテクスチャをクリア（SRVも解放する。以降、取得済みのハンドルは使えない）
 	void Clear();
 
 private:
@@ -54,9 +61,22 @@ private:
 	TextureManager() = default;
 	~TextureManager() = default;
 
+	/// @brief 変換済みテクスチャを読み込む（なければ変換してキャッシュに保存）
+	/// @param filePath 元ファイルのパス
+	/// @param outImage 読み込んだテクスチャ
+	/// @return 失敗した場合はfalse（従来の読み込みに切り替える）
+	bool LoadCooked(const std::string& filePath, DirectX::ScratchImage& outImage);
+
+	/// @brief 元ファイルを RGBA8 の画像にする（PNGは自前のデコーダー、それ以外はWIC）
+	bool DecodeSource(const std::string& filePath, const std::vector<uint8_t>& source, TextureImage& outImage);
+
 	DirectXCommon* dxCommon_ = nullptr;
 	bool isInitialized_ = false;
 
+	// 変換済みテクスチャのキャッシュ
+	std::filesystem::path cookCacheDirectory_;
+	TextureCookSettings cookSettings_; // 従来の読み込みと同じくsRGBとして扱う
+
 	// ファイルパスごとにテクスチャを保持
 	std::unordered_map<std::string, LoadedTexture> textureCache_;
 	// メタデータキャッシュ
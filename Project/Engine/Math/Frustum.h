@@ -0,0 +1,105 @@
+#pragma once
+#include "MathCore.h"
+#include "BoundingBox.h"
+#include <cmath>
+
+/// @brief 視錐台（6平面で表現）
+/// @details 平面は ax + by + cz + d >= 0 を内側とする
+struct Frustum {
+    /// @brief 平面（法線 + 距離）
+    struct Plane {
+        Vector3 normal = { 0.0f, 0.0f, 0.0f };
+        float d = 0.0f;
+    };
+
+    Plane planes[6]; ///< 左, 右, 下, 上, 近, 遠
+
+    /// @brief ビュー×プロジェクション行列から視錐台を構築
+    /// @param viewProjection ビュー行列 × プロジェクション行列（行ベクトル規約）
+    /// @return 視錐台
+    static Frustum FromMatrix(const Matrix4x4& viewProjection) {
+        const auto& m = viewProjection.m;
+        auto column = [&m](int c) {
+            return Vector4{ m[0][c], m[1][c], m[2][c], m[3][c] };
+        };
+        Vector4 c0 = column(0);
+        Vector4 c1 = column(1);
+        Vector4 c2 = column(2);
+        Vector4 c3 = column(3);
+
+        Frustum frustum;
+        frustum.SetPlane(0, c3.x + c0.x, c3.y + c0.y, c3.z + c0.z, c3.w + c0.w); // 左
+        frustum.SetPlane(1, c3.x - c0.x, c3.y - c0.y, c3.z - c0.z, c3.w - c0.w); // 右
+        frustum.SetPlane(2, c3.x + c1.x, c3.y + c1.y, c3.z + c1.z, c3.w + c1.w); // 下
+        frustum.SetPlane(3, c3.x - c1.x, c3.y - c1.y, c3.z - c1.z, c3.w - c1.w); // 上
+        frustum.SetPlane(4, c2.x, c2.y, c2.z, c2.w);                             // 近（D3Dは z ∈ [0,1]）
+        frustum.SetPlane(5, c3.x - c2.x, c3.y - c2.y, c3.z - c2.z, c3.w - c2.w); // 遠
+        return frustum;
+    }
+
+    /// @brief 球と視錐台の交差判定
+    /// @param center 球の中心
+    /// @param radius 球の半径
+    /// @return 一部でも内側にあればtrue
+    bool IntersectsSphere(const Vector3& center, float radius) const {
+        for (const Plane& plane : planes) {
+            float distance = plane.normal.x * center.x + plane.normal.y * center.y + plane.normal.z * center.z + plane.d;
+            if (distance < -radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief AABBと視錐台の交差判定
+    /// @param box 判定するAABB
+    /// @return 一部でも内側にあればtrue
+    bool IntersectsAABB(const BoundingBox& box) const {
+        for (const Plane& plane : planes) {
+            // 法線方向に最も遠い頂点（正頂点）だけを調べる
+            Vector3 positive = {
+                plane.normal.x >= 0.0f ? box.max.x : box.min.x,
+                plane.normal.y >= 0.0f ? box.max.y : box.min.y,
+                plane.normal.z >= 0.0f ? box.max.z : box.min.z
+            };
+            float distance = plane.normal.x * positive.x + plane.normal.y * positive.y + plane.normal.z * positive.z + plane.d;
+            if (distance < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief AABBが視錐台に完全に含まれるか判定
+    /// @param box 判定するAABB
+    /// @return 完全に内側にあればtrue
+    bool ContainsAABB(const BoundingBox& box) const {
+        for (const Plane& plane : planes) {
+            // 法線と逆方向に最も遠い頂点（負頂点）が内側なら全体が内側
+            Vector3 negative = {
+                plane.normal.x >= 0.0f ? box.min.x : box.max.x,
+                plane.normal.y >= 0.0f ? box.min.y : box.max.y,
+                plane.normal.z >= 0.0f ? box.min.z : box.max.z
+            };
+            float distance = plane.normal.x * negative.x + plane.normal.y * negative.y + plane.normal.z * negative.z + plane.d;
+            if (distance < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    /// @brief 平面を正規化して設定
+    void SetPlane(int index, float a, float b, float c, float d) {
+        float length = std::sqrt(a * a + b * b + c * c);
+        if (length > 0.0f) {
+            a /= length;
+            b /= length;
+            c /= length;
+            d /= length;
+        }
+        planes[index].normal = { a, b, c };
+        planes[index].d = d;
+    }
+};
@@ -171,8 +171,8 @@ namespace MathCore {
 		}
 
 		Matrix4x4 RotationX(float radian) {
-			float cosR = std::cosf(radian);
-			float sinR = std::sinf(radian);
+			float cosR = std::cos(radian);
+			float sinR = std::sin(radian);
 			return {
 				1.0f, 0.0f, 0.0f, 0.0f,
 				0.0f, cosR, sinR, 0.0f,
@@ -182,8 +182,8 @@ namespace MathCore {
 		}
 
 		Matrix4x4 RotationY(float radian) {
-			float cosR = std::cosf(radian);
-			float sinR = std::sinf(radian);
+			float cosR = std::cos(radian);
+			float sinR = std::sin(radian);
 			return {
 				cosR, 0.0f, -sinR, 0.0f,
 				0.0f, 1.0f, 0.0f, 0.0f,
@@ -193,8 +193,8 @@ namespace MathCore {
 		}
 
 		Matrix4x4 RotationZ(float radian) {
-			float cosR = std::cosf(radian);
-			float sinR = std::sinf(radian);
+			float cosR = std::cos(radian);
+			float sinR = std::sin(radian);
 			return {
 			 cosR, sinR, 0.0f, 0.0f,
 	  -sinR, cosR, 0.0f, 0.0f,
@@ -204,12 +204,12 @@ namespace MathCore {
 		}
 
 		Matrix4x4 MakeAffine(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
-			float cosX = std::cosf(rotate.x);
-			float sinX = std::sinf(rotate.x);
-			float cosY = std::cosf(rotate.y);
-			float sinY = std::sinf(rotate.y);
-			float cosZ = std::cosf(rotate.z);
-			float sinZ = std::sinf(rotate.z);
+			float cosX = std::cos(rotate.x);
+			float sinX = std::sin(rotate.x);
+			float cosY = std::cos(rotate.y);
+			float sinY = std::sin(rotate.y);
+			float cosZ = std::cos(rotate.z);
+			float sinZ = std::sin(rotate.z);
 
 			return {
 		  scale.x * (cosY * cosZ),
@@ -266,8 +266,8 @@ namespace MathCore {
 			const Vector3 a0 = Vector::Subtract(rx0, p0);
 			const Vector3 b0 = Vector::Cross(n, a0);
 			const Vector3 exp = Vector::Add(p0,
-				Vector::Add(Vector::Multiply(std::cosf(radian), a0),
-					Vector::Multiply(std::sinf(radian), b0)));
+				Vector::Add(Vector::Multiply(std::cos(radian), a0),
+					Vector::Multiply(std::sin(radian), b0)));
 
 			// ---- ey を回す ----
 			const Vector3 ry0 = { 0.0f, 1.0f, 0.0f };
@@ -275,8 +275,8 @@ namespace MathCore {
 			const Vector3 a1 = Vector::Subtract(ry0, p1);
 			const Vector3 b1 = Vector::Cross(n, a1);
 			const Vector3 eyp = Vector::Add(p1,
-				Vector::Add(Vector::Multiply(std::cosf(radian), a1),
-					Vector::Multiply(std::sinf(radian), b1)));
+				Vector::Add(Vector::Multiply(std::cos(radian), a1),
+					Vector::Multiply(std::sin(radian), b1)));
 
 			// ---- ez を回す ----
 			const Vector3 rz0 = { 0.0f, 0.0f, 1.0f };
@@ -284,8 +284,8 @@ namespace MathCore {
 			const Vector3 a2 = Vector::Subtract(rz0, p2);
 			const Vector3 b2 = Vector::Cross(n, a2);
 			const Vector3 ezp = Vector::Add(p2,
-				Vector::Add(Vector::Multiply(std::cosf(radian), a2),
-					Vector::Multiply(std::sinf(radian), b2)));
+				Vector::Add(Vector::Multiply(std::cos(radian), a2),
+					Vector::Multiply(std::sin(radian), b2)));
 
 			Matrix4x4 R{};
 			R.m[0][0] = exp.x;
@@ -353,7 +353,7 @@ namespace MathCore {
 			Vector3 axis = Vector::Cross(normalizedFrom, normalizedTo);
 
 			// 回転角度を内積から求める
-			float angle = std::acosf(std::clamp(dot, -1.0f, 1.0f));
+			float angle = std::acos(std::clamp(dot, -1.0f, 1.0f));
 
 			// 任意軸回転行列を作成
 			return MakeRotateAxisAngle(axis, angle);
@@ -456,8 +456,8 @@ namespace MathCore {
 
 			// 半角の計算
 			float halfAngle = radian * 0.5f;
-			float sinHalf = std::sinf(halfAngle);
-			float cosHalf = std::cosf(halfAngle);
+			float sinHalf = std::sin(halfAngle);
+			float cosHalf = std::cos(halfAngle);
 
 			Quaternion result;
 			// 虚部：sin(θ/2) * 正規化された軸
@@ -562,12 +562,12 @@ namespace MathCore {
 			}
 
 			// θを計算
-			float theta = std::acosf(dot);
-			float sinTheta = std::sinf(theta);
+			float theta = std::acos(dot);
+			float sinTheta = std::sin(theta);
 
 			// スケーリング係数を計算
-			float scale0 = std::sinf((1.0f - t) * theta) / sinTheta;
-			float scale1 = std::sinf(t * theta) / sinTheta;
+			float scale0 = std::sin((1.0f - t) * theta) / sinTheta;
+			float scale1 = std::sin(t * theta) / sinTheta;
 
 			// 補間結果を計算
 			Quaternion result;
@@ -621,8 +621,8 @@ namespace MathCore {
 	namespace Rendering {
 		Matrix4x4 PerspectiveFov(float fovY, float aspectRatio, float nearClip, float farClip) {
 			return {
-				1.0f / (aspectRatio * std::tanf(fovY / 2.0f)), 0.0f, 0.0f, 0.0f,
-				0.0f, 1.0f / std::tanf(fovY / 2.0f), 0.0f, 0.0f,
+				1.0f / (aspectRatio * std::tan(fovY / 2.0f)), 0.0f, 0.0f, 0.0f,
+				0.0f, 1.0f / std::tan(fovY / 2.0f), 0.0f, 0.0f,
 				0.0f, 0.0f, farClip / (farClip - nearClip), 1.0f,
 				0.0f, 0.0f, -nearClip * farClip / (farClip - nearClip), 0.0f
 			};
@@ -47,7 +47,7 @@ struct Vector2 {
     }
 
     Vector2 Normalize() const {
-        float length = std::sqrtf(x * x + y * y);
+        float length = std::sqrt(x * x + y * y);
         if (length == 0.0f) {
             return { 0.0f, 0.0f };
         }
@@ -55,7 +55,7 @@ struct Vector2 {
 	}
 
     float Length() const {
-        return std::sqrtf(x * x + y * y);
+        return std::sqrt(x * x + y * y);
     }
 };
 
@@ -72,6 +72,7 @@ bool Object3d::DrawImGui() {
 		if (model_) {
 			const char* renderTypeName = (GetRenderType() == Model::RenderType::Normal) ? "Normal" : "Skinning";
 			ImGui::Text("レンダータイプ: %s", renderTypeName);
+			ImGui::Text("LOD: %u / %u", model_->GetCurrentLod(), model_->GetLodCount());
 		}
 
 		// ブレンドモード（変更可能）
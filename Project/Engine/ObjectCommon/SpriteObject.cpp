@@ -3,10 +3,6 @@
 #include "Engine/Graphics/TextureManager.h"
 #include "Engine/Graphics/Render/RenderManager.h"
 #include "Engine/Graphics/Render/Sprite/SpriteRenderer.h"
-#include "Engine/Graphics/Common/DirectXCommon.h"
-#include "Engine/Graphics/Resource/ResourceFactory.h"
-#include "Engine/Graphics/Structs/VertexData.h"
-#include "Engine/Graphics/Structs/SpriteMaterial.h"
 #include <cmath>
 #include <imgui.h>
 
@@ -25,9 +21,6 @@ void SpriteObject::Initialize(const std::string& textureFilePath) {
     // テクスチャサイズを自動設定
     SetSizeFromTexture(textureFilePath);
     
-    // 頂点バッファを作成
-    CreateVertexBuffer();
-    
     // デフォルト値を設定
     Reset();
     
@@ -43,79 +36,6 @@ void SpriteObject::SetSizeFromTexture(const std::string& textureFilePath) {
     textureSize_.y = static_cast<float>(metadata.height);
 }
 
-void SpriteObject::CreateVertexBuffer() {
-    if (!spriteRenderer_) return;
-    
-    DirectXCommon* dxCommon = spriteRenderer_->GetDirectXCommon();
-    ResourceFactory* resourceFactory = spriteRenderer_->GetResourceFactory();
-    
-    if (!dxCommon || !resourceFactory) return;
-    
-    // 頂点バッファの生成（4頂点のクワッド）
-    vertexResource_ = resourceFactory->CreateBufferResource(
-        dxCommon->GetDevice(),
-        sizeof(VertexData) * 4);
-    
-    vertexBufferView_.BufferLocation = vertexResource_->GetGPUVirtualAddress();
-    vertexBufferView_.SizeInBytes = sizeof(VertexData) * 4;
-    vertexBufferView_.StrideInBytes = sizeof(VertexData);
-    
-    // インデックスバッファの生成
-    indexResource_ = resourceFactory->CreateBufferResource(
-        dxCommon->GetDevice(),
-        sizeof(uint32_t) * 6);
-    
-    uint32_t* indexData = nullptr;
-    indexResource_->Map(0, nullptr, reinterpret_cast<void**>(&indexData));
-    
-    indexData[0] = 0; indexData[1] = 1; indexData[2] = 2;
-    indexData[3] = 1; indexData[4] = 3; indexData[5] = 2;
-    
-    indexResource_->Unmap(0, nullptr);
-    
-    indexBufferView_.BufferLocation = indexResource_->GetGPUVirtualAddress();
-    indexBufferView_.SizeInBytes = sizeof(uint32_t) * 6;
-    indexBufferView_.Format = DXGI_FORMAT_R32_UINT;
-    
-    UpdateVertexData();
-}
-
-void SpriteObject::UpdateVertexData() {
-    if (!vertexResource_) return;
-    
-    VertexData* vertexData = nullptr;
-    vertexResource_->Map(0, nullptr, reinterpret_cast<void**>(&vertexData));
-    
-    // アンカーポイントを考慮したローカル座標
-     // anchorPoint_ : (0,0)=左上, (1,1)=右下
-    float left = -anchorPoint_.x;
-    float right = 1.0f - anchorPoint_.x;
-    float top = anchorPoint_.y;        // 上は +Y（カメラ2Dに合わせる）
-    float bottom = anchorPoint_.y - 1.0f; // 下は -Y
-
-    // 左下
-    vertexData[0].position = { left,  bottom, 0.0f, 1.0f };
-    vertexData[0].texcoord = { uvMin_.x, uvMax_.y };  // (0,1) テクスチャ下側
-    vertexData[0].normal = { 0.0f, 0.0f, -1.0f };
-
-    // 左上
-    vertexData[1].position = { left,  top,    0.0f, 1.0f };
-    vertexData[1].texcoord = { uvMin_.x, uvMin_.y };  // (0,0) テクスチャ上側
-    vertexData[1].normal = { 0.0f, 0.0f, -1.0f };
-
-    // 右下
-    vertexData[2].position = { right, bottom, 0.0f, 1.0f };
-    vertexData[2].texcoord = { uvMax_.x, uvMax_.y };  // (1,1)
-    vertexData[2].normal = { 0.0f, 0.0f, -1.0f };
-
-    // 右上
-    vertexData[3].position = { right, top,    0.0f, 1.0f };
-    vertexData[3].texcoord = { uvMax_.x, uvMin_.y };  // (1,0)
-    vertexData[3].normal = { 0.0f, 0.0f, -1.0f };
-
-    vertexResource_->Unmap(0, nullptr);
-}
-
 void SpriteObject::Update() {
     if (!isActive_) return;
 }
@@ -123,15 +43,6 @@ void SpriteObject::Update() {
 void SpriteObject::Draw2D(const ICamera* camera) {
     if (!spriteRenderer_) return;
     
-    auto* commandList = spriteRenderer_->GetDirectXCommon()->GetCommandList();
-    
-    size_t bufferIndex = spriteRenderer_->GetAvailableConstantBuffer();
-    
-    // マテリアルデータ設定（必ず最新の値で上書き）
-    auto& materialData = spriteRenderer_->GetMaterialDataPool()[bufferIndex];
-    materialData->color = color_;
-    materialData->uvTransform = uvTransform_;
-    
     // 実際の描画サイズを計算（テクスチャサイズ × スケール）
     Vector3 actualScale = {
         textureSize_.x * transform_.scale.x,
@@ -139,25 +50,27 @@ void SpriteObject::Draw2D(const ICamera* camera) {
         transform_.scale.z
     };
     
-    // 変換行列設定（必ず最新の値で上書き）
-    auto& transformData = spriteRenderer_->GetTransformDataPool()[bufferIndex];
-    Matrix4x4 worldMatrix = Matrix::MakeAffine(actualScale, transform_.rotate, transform_.translate);
-    
+    SpriteQuadDesc desc;
     // カメラを使用してWVP行列を計算
-    transformData->WVP = spriteRenderer_->CalculateWVPMatrix(transform_.translate, actualScale, transform_.rotate, camera);
-    transformData->world = worldMatrix;
+    desc.wvp = spriteRenderer_->CalculateWVPMatrix(transform_.translate, actualScale, transform_.rotate, camera);
     
-    // 定数バッファ設定
-    commandList->SetGraphicsRootConstantBufferView(0, spriteRenderer_->GetMaterialResource(bufferIndex)->GetGPUVirtualAddress());
-    commandList->SetGraphicsRootConstantBufferView(1, spriteRenderer_->GetTransformResource(bufferIndex)->GetGPUVirtualAddress());
-    commandList->SetGraphicsRootDescriptorTable(2, textureHandle_.gpuHandle);
+    // アンカーポイントを考慮したローカル座標
+    // anchorPoint_ : (0,0)=左上, (1,1)=右下
+    desc.left = -anchorPoint_.x;
+    desc.right = 1.0f - anchorPoint_.x;
+    desc.top = anchorPoint_.y;          // 上は +Y（カメラ2Dに合わせる）
+    desc.bottom = anchorPoint_.y - 1.0f; // 下は -Y
     
-    // 頂点バッファ・インデックスバッファを設定
-    commandList->IASetVertexBuffers(0, 1, &vertexBufferView_);
-    commandList->IASetIndexBuffer(&indexBufferView_);
+    desc.uvMin = uvMin_;
+    desc.uvMax = uvMax_;
+    desc.uvTransform = uvTransform_;
+    desc.color = color_;
+    desc.textureKey = textureHandle_.gpuHandle.ptr;
+    desc.blendMode = static_cast<uint8_t>(GetBlendMode());
+    desc.layer = layer_;
     
-    // 描画
-    commandList->DrawIndexedInstanced(6, 1, 0, 0, 0);
+    // 描画はパスの終了時にまとめて行う
+    spriteRenderer_->Submit(desc);
 }
 
 void SpriteObject::Reset() {
@@ -169,10 +82,6 @@ void SpriteObject::Reset() {
     anchorPoint_ = { 0.5f, 0.5f };  // デフォルトを中央に変更
     uvMin_ = { 0.0f, 0.0f };
     uvMax_ = { 1.0f, 1.0f };
-    
-    if (vertexResource_) {
-        UpdateVertexData();
-    }
 }
 
 void SpriteObject::SetTexture(const std::string& textureFilePath) {
@@ -182,9 +91,6 @@ void SpriteObject::SetTexture(const std::string& textureFilePath) {
 
 void SpriteObject::SetAnchor(const Vector2& anchor) {
     anchorPoint_ = anchor;
-    if (vertexResource_) {
-        UpdateVertexData();
-    }
 }
 
 void SpriteObject::SetTextureRect(float texLeft, float texTop, float texWidth, float texHeight,
@@ -199,8 +105,6 @@ void SpriteObject::SetTextureRect(float texLeft, float texTop, float texWidth, f
     uvMin_.y = texTop / textureHeight;
     uvMax_.x = (texLeft + texWidth) / textureWidth;
     uvMax_.y = (texTop + texHeight) / textureHeight;
-    
-    UpdateVertexData();
 }
 
 void SpriteObject::SetUVRect(float uvLeft, float uvTop, float uvRight, float uvBottom) {
@@ -208,8 +112,6 @@ void SpriteObject::SetUVRect(float uvLeft, float uvTop, float uvRight, float uvB
     uvMin_.y = uvTop;
     uvMax_.x = uvRight;
     uvMax_.y = uvBottom;
-    
-    UpdateVertexData();
 }
 
 void SpriteObject::SetUVOffset(float offsetX, float offsetY) {
@@ -238,9 +140,6 @@ void SpriteObject::UpdateUVTransformMatrix(const EulerTransform& uvTransform) {
 void SpriteObject::ChangeAnchorKeepingPosition(const Vector2& newAnchor) {
     // アンカーポイントを変更（座標は変更しない）
     anchorPoint_ = newAnchor;
-    if (vertexResource_) {
-        UpdateVertexData();
-    }
 }
 
 bool SpriteObject::DrawImGui() {
@@ -5,10 +5,6 @@
 #include "Engine/Graphics/TextureManager.h"
 #include <memory>
 #include <string>
-#include <d3d12.h>
-#include <wrl.h>
-
-using Microsoft::WRL::ComPtr;
 
 /// @brief スプライトオブジェクト - Object2d基底クラスを継承してRenderManager対応
 class SpriteObject : public Object2d {
@@ -59,6 +55,10 @@ public:
     void SetAnchor(const Vector2& anchor);
     Vector2 GetAnchor() const { return anchorPoint_; }
     
+    /// @brief 描画レイヤーを設定（小さいほど先に描画、同じレイヤー内はテクスチャごとにまとめて描画）
+    void SetLayer(int32_t layer) { layer_ = layer; }
+    int32_t GetLayer() const { return layer_; }
+    
     /// @brief テクスチャの実際のサイズを取得（ピクセル）
     Vector2 GetTextureSize() const { return textureSize_; }
     
@@ -90,12 +90,6 @@ private:
     /// @brief テクスチャサイズを自動設定
     void SetSizeFromTexture(const std::string& textureFilePath);
     
-    /// @brief 頂点バッファを作成
-    void CreateVertexBuffer();
-    
-    /// @brief 頂点データを更新
-    void UpdateVertexData();
-    
     /// @brief UV変換行列を計算
     void UpdateUVTransformMatrix(const EulerTransform& uvTransform);
     
@@ -120,11 +114,8 @@ private:
     /// @brief アンカーポイント（0.0f, 0.0f = 左上、0.5f, 0.5f = 中央、1.0f, 1.0f = 右下）
     Vector2 anchorPoint_ = { 0.5f, 0.5f };  // デフォルトを中央に変更
     
-    /// @brief 頂点バッファ
-    ComPtr<ID3D12Resource> vertexResource_;
-    D3D12_VERTEX_BUFFER_VIEW vertexBufferView_{};
-    ComPtr<ID3D12Resource> indexResource_;
-    D3D12_INDEX_BUFFER_VIEW indexBufferView_{};
+    /// @brief 描画レイヤー
+    int32_t layer_ = 0;
     
     /// @brief UV座標範囲
     Vector2 uvMin_ = { 0.0f, 0.0f };
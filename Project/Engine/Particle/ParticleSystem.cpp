@@ -11,6 +11,14 @@
 
 using namespace MathCore;
 
+ParticleSystem::~ParticleSystem()
+{
+    // インスタンシング用のSRVを解放
+    if (dxCommon_) {
+        dxCommon_->GetDescriptorManager()->Free(instancingSrv_);
+    }
+}
+
 // 初期化関数
 void ParticleSystem::Initialize(DirectXCommon* dxCommon, ResourceFactory* resourceFactory)
 {
@@ -514,7 +522,7 @@ void ParticleSystem::CreateSRV()
     instancingSrvDesc.Buffer.NumElements = kNumMaxInstance;
     instancingSrvDesc.Buffer.StructureByteStride = sizeof(ParticleForGPU);
 
-    dxCommon_->GetDescriptorManager()->CreateSRV(
+    instancingSrv_ = dxCommon_->GetDescriptorManager()->CreateSRV(
         instancingResource_.Get(),
         instancingSrvDesc,
         instancingSrvHandleCPU_,
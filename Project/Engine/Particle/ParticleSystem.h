@@ -79,7 +79,7 @@ public:
     static constexpr uint32_t kNumMaxInstance = 4096; // パーティクルの最大数
 
     ParticleSystem() = default;
-    ~ParticleSystem() override = default;
+    ~ParticleSystem() override;
 
     /// @brief 初期化
     /// @param dxCommon DirectXCommon
@@ -308,6 +308,7 @@ private:
     Microsoft::WRL::ComPtr<ID3D12Resource> instancingResource_;
     D3D12_CPU_DESCRIPTOR_HANDLE instancingSrvHandleCPU_ = {};
     D3D12_GPU_DESCRIPTOR_HANDLE instancingSrvHandleGPU_ = {};
+    DescriptorAllocation instancingSrv_; // デストラクタで解放
     ParticleForGPU* instancingData_ = nullptr;
 
     // ──────────────────────────────────────────────────────────
@@ -7,9 +7,11 @@
 #include "Engine/Graphics/Common/DirectXCommon.h"
 #include "Engine/Graphics/Light/LightManager.h"
 #include "Engine/Graphics/Render/RenderManager.h"
+#include "Engine/Graphics/Render/Sprite/SpriteRenderer.h"
 #include "Engine/Graphics/LineRenderer.h"
 #include "WinApp/WinApp.h"
 #include "Object3d.h"
+#include "Engine/Math/Frustum.h"
 #include <numbers>
 
 #ifdef _DEBUG
@@ -20,6 +22,10 @@ void BaseScene::Initialize(EngineSystem* engine)
 {
    engine_ = engine;
 
+   // 空間インデックス（アリーナ全体を覆う範囲で作成）
+   spatialIndex_ = std::make_unique<LooseOctree>();
+   spatialIndex_->Initialize({ 0.0f, 0.0f, 0.0f }, 256.0f);
+
    //カメラ
    SetupCamera();
 
@@ -54,12 +60,6 @@ void BaseScene::Update()
 	  cameraManager_->Update();
    }
 
-   // ライトマネージャーの更新
-   auto lightManager = engine_->GetComponent<LightManager>();
-   if (lightManager) {
-	  lightManager->UpdateAll();
-   }
-
 #ifdef _DEBUG
    // カメラマネージャーのImGui
    if (cameraManager_) {
@@ -69,8 +69,20 @@ void BaseScene::Update()
    DrawGameObjectsImGui();
 #endif
 
-   // ゲームオブジェクトの更新
+   // 追加されたオブジェクトを空間インデックスに登録
+   SyncSpatialIndex();
+   if (spatialIndex_) {
+	  spatialIndex_->ResetFrameStats();
+   }
+
+   // ゲームオブジェクトの更新（TransferMatrix で空間インデックスも更新される）
    UpdateGameObjects();
+
+   // ライトマネージャーの更新（オブジェクトが動かしたライトを反映し、クラスターの振り分けを開始する）
+   auto lightManager = engine_->GetComponent<LightManager>();
+   if (lightManager) {
+	  lightManager->UpdateAll(cameraManager_ ? cameraManager_->GetActiveCamera(CameraType::Camera3D) : nullptr);
+   }
 }
 
 void BaseScene::Draw()
@@ -90,10 +102,19 @@ void BaseScene::Draw()
    renderManager->SetCameraManager(cameraManager_.get());
    renderManager->SetCommandList(cmdList);
 
-   // 全てのゲームオブジェクトを描画キューに追加
-   for (const auto& obj : gameObjects_) {
-	  if (obj && obj->IsActive()) {
-		 renderManager->AddDrawable(obj.get());
+   // 空間インデックスに登録済みのオブジェクトは視錐台内のものだけ描画キューに追加
+   SyncSpatialIndex();
+   Matrix4x4 viewProjection = MathCore::Matrix::Multiply(activeCamera3D->GetViewMatrix(), activeCamera3D->GetProjectionMatrix());
+   visibleObjects_.clear();
+   spatialIndex_->QueryFrustum(Frustum::FromMatrix(viewProjection), visibleObjects_);
+   for (void* visible : visibleObjects_) {
+	  renderManager->AddDrawable(static_cast<IDrawable*>(visible));
+   }
+
+   // 登録対象外のオブジェクトは常に描画キューに追加
+   for (IDrawable* obj : unpartitionedObjects_) {
+	  if (obj->IsActive()) {
+		 renderManager->AddDrawable(obj);
 	  }
    }
 
@@ -109,8 +130,18 @@ void BaseScene::Draw()
 
 void BaseScene::Finalize()
 {
-   // ゲームオブジェクトをクリア
+   // ゲームオブジェクトをクリア（WorldTransform の破棄で空間インデックスからも外れる）
    gameObjects_.clear();
+   pendingSpatialObjects_.clear();
+   unpartitionedObjects_.clear();
+}
+
+void BaseScene::RemoveGameObject(IDrawable* object)
+{
+   // 登録待ち・常に描画する一覧からも外す（空間インデックスからは WorldTransform の破棄で外れる）
+   std::erase(pendingSpatialObjects_, object);
+   std::erase(unpartitionedObjects_, object);
+   std::erase_if(gameObjects_, [object](const std::unique_ptr<IDrawable>& owned) { return owned.get() == object; });
 }
 
 void BaseScene::SetupCamera()
@@ -180,6 +211,38 @@ void BaseScene::UpdateGameObjects()
    }
 }
 
+void BaseScene::SyncSpatialIndex()
+{
+   if (!spatialIndex_) {
+	  return;
+   }
+
+   for (IDrawable* obj : pendingSpatialObjects_) {
+	  if (!obj) {
+		 continue;
+	  }
+
+	  // モデルを持つ3Dオブジェクトのみ登録（スカイボックスは常に描画）
+	  auto* object3d = dynamic_cast<Object3d*>(obj);
+	  RenderPassType passType = obj->GetRenderPassType();
+	  bool partitioned = object3d && object3d->GetModel() &&
+		 (passType == RenderPassType::Model || passType == RenderPassType::SkinnedModel);
+
+	  if (partitioned) {
+		 float radius = object3d->GetModel()->GetBoundingRadius();
+		 // スキニングモデルはバインドポーズより大きく動くため余裕を持たせる
+		 if (passType == RenderPassType::SkinnedModel) {
+			radius *= 1.5f;
+		 }
+		 object3d->GetTransform().BindSpatialIndex(spatialIndex_.get(), obj, radius > 0.0f ? radius : 1.0f);
+	  } else {
+		 unpartitionedObjects_.push_back(obj);
+	  }
+   }
+
+   pendingSpatialObjects_.clear();
+}
+
 void BaseScene::DrawGameObjectsImGui()
 {
 #ifdef _DEBUG
@@ -192,6 +255,50 @@ void BaseScene::DrawGameObjectsImGui()
 	  }
 
 	  ImGui::Separator();
+
+	  // 空間インデックスの統計
+	  if (spatialIndex_ && ImGui::TreeNode("空間インデックス")) {
+		 const LooseOctree::Stats& stats = spatialIndex_->GetStats();
+		 ImGui::Text("オブジェクト数: %u", stats.objectCount);
+		 ImGui::Text("ノード数: %u", stats.nodeCount);
+		 ImGui::Text("位置更新: %u", stats.updateCount);
+		 ImGui::Text("ノード移動: %u", stats.reinsertCount);
+		 ImGui::Text("描画対象: %zu", visibleObjects_.size());
+		 ImGui::TreePop();
+	  }
+
+	  // 並列コマンド記録
+	  auto renderManager = engine_->GetComponent<RenderManager>();
+	  if (renderManager && ImGui::TreeNode("並列コマンド記録")) {
+		 bool parallel = renderManager->IsParallelRecordingEnabled();
+		 if (ImGui::Checkbox("有効", &parallel)) {
+			renderManager->SetParallelRecordingEnabled(parallel);
+		 }
+		 ImGui::Text("ワーカー数: %u", renderManager->GetRecordingWorkerCount());
+		 ImGui::Text("使用チャンク数: %u", renderManager->GetLastParallelChunkCount());
+		 ImGui::TreePop();
+	  }
+
+	  // スプライトのバッチ描画
+	  auto spriteRenderer = renderManager ? static_cast<SpriteRenderer*>(renderManager->GetRenderer(RenderPassType::Sprite)) : nullptr;
+	  if (spriteRenderer && ImGui::TreeNode("スプライトバッチ")) {
+		 const SpriteRenderer::Statistics& stats = spriteRenderer->GetStatistics();
+		 ImGui::Text("スプライト数: %u", stats.spriteCount);
+		 ImGui::Text("ラン数: %u", stats.runCount);
+		 ImGui::Text("描画コマンド数: %u", stats.drawCallCount);
+		 ImGui::Text("頂点バッファ容量: %u", stats.quadCapacity);
+		 ImGui::TreePop();
+	  }
+
+	  // デバッグ線
+	  auto lineRenderer = engine_->GetComponent<LineRenderer>();
+	  if (lineRenderer && ImGui::TreeNode("デバッグ線")) {
+		 const LineRenderer::Statistics& stats = lineRenderer->GetStatistics();
+		 ImGui::Text("頂点数: %u / %u", stats.vertexCount, stats.vertexCapacity);
+		 ImGui::Text("描画コマンド数: %u", stats.drawCallCount);
+		 ImGui::Text("溢れた線: %u", stats.droppedLineCount);
+		 ImGui::TreePop();
+	  }
    }
    ImGui::End();
 #endif // _DEBUG
@@ -199,7 +306,7 @@ void BaseScene::DrawGameObjectsImGui()
 
 void BaseScene::DrawDebug()
 {
-   // デフォルトでは何もしない（派生クラスでオーバーライド可能）
+   // フレーム中に追加されたデバッグ線をまとめて描画（派生クラスでオーバーライド可能）
    auto lineRenderer = engine_->GetComponent<LineRenderer>();
    auto dxCommon = engine_->GetComponent<DirectXCommon>();
    ICamera* activeCamera = cameraManager_->GetActiveCamera(CameraType::Camera3D);
@@ -208,16 +315,9 @@ void BaseScene::DrawDebug()
 	  return;
    }
 
-   // ゲームオブジェクトのデバッグ描画
-   std::vector<LineRenderer::Line> debugLines;
-
-   if (!debugLines.empty()) {
-	  ID3D12GraphicsCommandList* cmdList = dxCommon->GetCommandList();
-	  lineRenderer->Draw(
-		 cmdList,
-		 activeCamera->GetViewMatrix(),
-		 activeCamera->GetProjectionMatrix(),
-		 debugLines
-	  );
-   }
+   lineRenderer->Render(
+	  dxCommon->GetCommandList(),
+	  activeCamera->GetViewMatrix(),
+	  activeCamera->GetProjectionMatrix()
+   );
 }
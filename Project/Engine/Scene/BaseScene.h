@@ -3,6 +3,7 @@
 #include "IScene.h"
 #include "Engine/Graphics/Light/LightData.h"
 #include "ObjectCommon/IDrawable.h"
+#include "Engine/Scene/SpatialIndex/LooseOctree.h"
 #include <memory>
 #include <vector>
 
@@ -29,6 +30,23 @@ public:
    /// @brief 解放（共通処理 + 派生クラスの解放）
    virtual void Finalize() override;
 
+   /// @brief 空間インデックスを取得（描画カリングに使用。ゲーム側の近傍検索にも使える）
+   /// @return 空間インデックス（userData は IDrawable*）
+   LooseOctree* GetSpatialIndex() const { return spatialIndex_.get(); }
+
+protected:
+
+   /// @brief ゲームオブジェクトを追加（次の更新・描画の前に空間インデックスへ登録される）
+   /// @return 追加したオブジェクト（所有権はシーン）
+   template<typename T>
+   T* AddGameObject(std::unique_ptr<T> object);
+
+   /// @brief ゲームオブジェクトを取り除いて破棄（オブジェクトの更新中には呼ばない）
+   void RemoveGameObject(IDrawable* object);
+
+   /// @brief ゲームオブジェクトの一覧
+   const std::vector<std::unique_ptr<IDrawable>>& GetGameObjects() const { return gameObjects_; }
+
 private:
 
    /// @brief カメラのセットアップ
@@ -43,6 +61,9 @@ private:
    /// @brief ゲームオブジェクトのImGuiデバッグUI表示
    void DrawGameObjectsImGui();
 
+   /// @brief 追加されたゲームオブジェクトを空間インデックスに登録
+   void SyncSpatialIndex();
+
    /// @brief デバッグ描画を行う（派生クラスでオーバーライド可能）
    virtual void DrawDebug();
 
@@ -52,6 +73,28 @@ protected:
    std::unique_ptr<CameraManager> cameraManager_;
    DirectionalLightData* directionalLight_ = nullptr;
 
-   // ゲームオブジェクト管理
+   // 空間インデックス（描画カリング・近傍検索）
+   // gameObjects_ より先に宣言し、オブジェクトの登録解除より後に破棄されるようにする
+   std::unique_ptr<LooseOctree> spatialIndex_;
+
+private:
+   // ゲームオブジェクト管理（追加・削除は AddGameObject・RemoveGameObject を通す）
    std::vector<std::unique_ptr<IDrawable>> gameObjects_;
+
+   // 追加されたが空間インデックスにまだ登録していないオブジェクト
+   std::vector<IDrawable*> pendingSpatialObjects_;
+
+   // 空間インデックスに登録しないオブジェクト（スカイボックス・パーティクル・スプライトなど）
+   std::vector<IDrawable*> unpartitionedObjects_;
+
+   // 視錐台検索の結果バッファ（毎フレームの確保を避けるため保持）
+   std::vector<void*> visibleObjects_;
 };
+
+template<typename T>
+inline T* BaseScene::AddGameObject(std::unique_ptr<T> object) {
+   T* added = object.get();
+   pendingSpatialObjects_.push_back(added);
+   gameObjects_.push_back(std::move(object));
+   return added;
+}
@@ -3,6 +3,7 @@
 #include "Engine/Graphics/Common/DirectXCommon.h"
 #include "Engine/Graphics/Light/LightManager.h"
 #include "Engine/Utility/FrameRate/FrameRateController.h"
+#include "Engine/Utility/Timer/TimerService.h"
 
 void SceneManager::Initialize(EngineSystem* engine) {
 	engine_ = engine;
@@ -53,6 +54,8 @@ void SceneManager::Update() {
 
 	// トランジションがブロック中でない場合のみシーンを更新
 	if (currentScene_ && !sceneTransition_->IsBlocking()) {
+		// ゲームのタイマー（GameTimer）を進めてからシーンを更新する
+		TimerService::GetInstance().Update(deltaTime);
 		currentScene_->Update();
 	}
 }
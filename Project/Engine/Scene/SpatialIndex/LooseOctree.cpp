@@ -0,0 +1,381 @@
+#include "LooseOctree.h"
+#include <algorithm>
+#include <cassert>
+#include <queue>
+#include <utility>
+
+void LooseOctree::Initialize(const Vector3& center, float halfSize, uint32_t maxDepth)
+{
+	worldCenter_ = center;
+	worldHalfSize_ = halfSize;
+	maxDepth_ = maxDepth;
+	Clear();
+}
+
+void LooseOctree::Clear()
+{
+	nodes_.clear();
+	entries_.clear();
+	freeHandles_.clear();
+
+	// ルートノードを作成
+	Node root;
+	root.center = worldCenter_;
+	root.halfSize = worldHalfSize_;
+	nodes_.push_back(std::move(root));
+
+	stats_ = {};
+	stats_.nodeCount = 1;
+}
+
+LooseOctree::Handle LooseOctree::Insert(void* userData, const Vector3& center, float radius)
+{
+	if (nodes_.empty()) {
+		Clear();
+	}
+
+	// 空きハンドルを再利用
+	Handle handle;
+	if (!freeHandles_.empty()) {
+		handle = freeHandles_.back();
+		freeHandles_.pop_back();
+	} else {
+		handle = static_cast<Handle>(entries_.size());
+		entries_.emplace_back();
+	}
+
+	Entry& entry = entries_[handle];
+	entry.center = center;
+	entry.radius = radius;
+	entry.userData = userData;
+	entry.alive = true;
+
+	AttachToNode(handle, FindNode(center, radius));
+	++stats_.objectCount;
+	return handle;
+}
+
+void LooseOctree::Update(Handle handle, const Vector3& center, float radius)
+{
+	if (handle >= entries_.size() || !entries_[handle].alive) {
+		return;
+	}
+
+	Entry& entry = entries_[handle];
+	entry.center = center;
+	entry.radius = radius;
+	++stats_.updateCount;
+
+	// 現在のノードに留まれる場合は何もしない（ほとんどのフレームはここで終わる）
+	if (FitsInNode(nodes_[entry.node], center, radius)) {
+		return;
+	}
+
+	int32_t newNode = FindNode(center, radius);
+	if (newNode == entries_[handle].node) {
+		return;
+	}
+
+	DetachFromNode(handle);
+	AttachToNode(handle, newNode);
+	++stats_.reinsertCount;
+}
+
+void LooseOctree::Remove(Handle handle)
+{
+	if (handle >= entries_.size() || !entries_[handle].alive) {
+		return;
+	}
+
+	DetachFromNode(handle);
+	entries_[handle] = Entry{};
+	freeHandles_.push_back(handle);
+	--stats_.objectCount;
+}
+
+void LooseOctree::QueryFrustum(const Frustum& frustum, std::vector<void*>& outResults) const
+{
+	if (nodes_.empty()) {
+		return;
+	}
+	QueryFrustumRecursive(0, frustum, outResults);
+}
+
+void LooseOctree::QueryRadius(const Vector3& center, float radius, std::vector<void*>& outResults) const
+{
+	if (nodes_.empty()) {
+		return;
+	}
+	QueryRadiusRecursive(0, center, radius, outResults);
+}
+
+void LooseOctree::QueryNearest(const Vector3& point, size_t count, std::vector<void*>& outResults, const void* exclude) const
+{
+	if (nodes_.empty() || count == 0) {
+		return;
+	}
+
+	// (距離の2乗, インデックス) の組
+	using Candidate = std::pair<float, uint32_t>;
+
+	// 未探索ノード（近い順に取り出す）
+	std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> openNodes;
+	// 現時点の候補（最も遠いものを先頭に保持）
+	std::priority_queue<Candidate> best;
+
+	openNodes.push({ 0.0f, 0u });
+
+	while (!openNodes.empty()) {
+		auto [nodeDistanceSq, nodeIndex] = openNodes.top();
+		openNodes.pop();
+
+		// これ以上近いオブジェクトは見つからない
+		if (best.size() >= count && nodeDistanceSq > best.top().first) {
+			break;
+		}
+
+		const Node& node = nodes_[nodeIndex];
+		for (Handle handle : node.entries) {
+			const Entry& entry = entries_[handle];
+			if (entry.userData == exclude) {
+				continue;
+			}
+			Vector3 diff = entry.center - point;
+			float distanceSq = diff.x * diff.x + diff.y * diff.y + diff.z * diff.z;
+			if (best.size() < count) {
+				best.push({ distanceSq, handle });
+			} else if (distanceSq < best.top().first) {
+				best.pop();
+				best.push({ distanceSq, handle });
+			}
+		}
+
+		for (int32_t child : node.children) {
+			if (child < 0 || nodes_[child].subtreeCount == 0) {
+				continue;
+			}
+			float childDistanceSq = DistanceSquaredToBox(point, GetLooseBounds(nodes_[child]));
+			if (best.size() < count || childDistanceSq <= best.top().first) {
+				openNodes.push({ childDistanceSq, static_cast<uint32_t>(child) });
+			}
+		}
+	}
+
+	// 遠い順に取り出されるので逆順に格納
+	size_t base = outResults.size();
+	outResults.resize(base + best.size());
+	for (size_t i = outResults.size(); i > base; --i) {
+		outResults[i - 1] = entries_[best.top().second].userData;
+		best.pop();
+	}
+}
+
+void LooseOctree::ResetFrameStats()
+{
+	stats_.updateCount = 0;
+	stats_.reinsertCount = 0;
+}
+
+int32_t LooseOctree::FindNode(const Vector3& center, float radius)
+{
+	int32_t nodeIndex = 0;
+
+	while (true) {
+		const Node& node = nodes_[nodeIndex];
+
+		// 最大深度に達した
+		if (node.depth >= maxDepth_) {
+			break;
+		}
+
+		// 子ノードのルーズ領域（= 親セルと同じ幅）に収まらない
+		float childHalfSize = node.halfSize * 0.5f;
+		if (radius > childHalfSize) {
+			break;
+		}
+
+		// ルートセルの外側にある場合はルートに留める
+		Vector3 offset = center - node.center;
+		if (std::abs(offset.x) > node.halfSize || std::abs(offset.y) > node.halfSize || std::abs(offset.z) > node.halfSize) {
+			break;
+		}
+
+		int octant = (offset.x >= 0.0f ? 1 : 0) | (offset.y >= 0.0f ? 2 : 0) | (offset.z >= 0.0f ? 4 : 0);
+		nodeIndex = GetOrCreateChild(nodeIndex, octant);
+	}
+
+	return nodeIndex;
+}
+
+bool LooseOctree::FitsInNode(const Node& node, const Vector3& center, float radius) const
+{
+	// セル外に出た（ルートは範囲外も受け入れる）
+	Vector3 offset = center - node.center;
+	bool insideCell = std::abs(offset.x) <= node.halfSize && std::abs(offset.y) <= node.halfSize && std::abs(offset.z) <= node.halfSize;
+	if (node.parent >= 0 && !insideCell) {
+		return false;
+	}
+
+	// ルーズ領域からはみ出す
+	if (node.parent >= 0 && radius > node.halfSize) {
+		return false;
+	}
+
+	// より深いノードへ移動できる
+	if (insideCell && node.depth < maxDepth_ && radius <= node.halfSize * 0.5f) {
+		return false;
+	}
+
+	return true;
+}
+
+int32_t LooseOctree::GetOrCreateChild(int32_t nodeIndex, int octant)
+{
+	if (nodes_[nodeIndex].children[octant] >= 0) {
+		return nodes_[nodeIndex].children[octant];
+	}
+
+	const Node& parent = nodes_[nodeIndex];
+	float childHalfSize = parent.halfSize * 0.5f;
+
+	Node child;
+	child.center = {
+		parent.center.x + ((octant & 1) ? childHalfSize : -childHalfSize),
+		parent.center.y + ((octant & 2) ? childHalfSize : -childHalfSize),
+		parent.center.z + ((octant & 4) ? childHalfSize : -childHalfSize)
+	};
+	child.halfSize = childHalfSize;
+	child.depth = parent.depth + 1;
+	child.parent = nodeIndex;
+
+	// push_back で parent 参照が無効になるため、インデックスで扱う
+	int32_t childIndex = static_cast<int32_t>(nodes_.size());
+	nodes_.push_back(std::move(child));
+	nodes_[nodeIndex].children[octant] = childIndex;
+	++stats_.nodeCount;
+
+	return childIndex;
+}
+
+void LooseOctree::AttachToNode(Handle handle, int32_t nodeIndex)
+{
+	Entry& entry = entries_[handle];
+	Node& node = nodes_[nodeIndex];
+
+	entry.node = nodeIndex;
+	entry.slot = static_cast<uint32_t>(node.entries.size());
+	node.entries.push_back(handle);
+
+	// 親をたどって部分木のオブジェクト数を更新
+	for (int32_t i = nodeIndex; i >= 0; i = nodes_[i].parent) {
+		++nodes_[i].subtreeCount;
+	}
+}
+
+void LooseOctree::DetachFromNode(Handle handle)
+{
+	Entry& entry = entries_[handle];
+	Node& node = nodes_[entry.node];
+	assert(entry.slot < node.entries.size() && node.entries[entry.slot] == handle);
+
+	// 末尾と入れ替えて削除（O(1)）
+	Handle moved = node.entries.back();
+	node.entries[entry.slot] = moved;
+	entries_[moved].slot = entry.slot;
+	node.entries.pop_back();
+
+	for (int32_t i = entry.node; i >= 0; i = nodes_[i].parent) {
+		--nodes_[i].subtreeCount;
+	}
+
+	entry.node = -1;
+}
+
+BoundingBox LooseOctree::GetLooseBounds(const Node& node) const
+{
+	float looseHalfSize = node.halfSize * 2.0f;
+	Vector3 extent = { looseHalfSize, looseHalfSize, looseHalfSize };
+	return BoundingBox(node.center - extent, node.center + extent);
+}
+
+void LooseOctree::CollectSubtree(int32_t nodeIndex, std::vector<void*>& outResults) const
+{
+	const Node& node = nodes_[nodeIndex];
+	for (Handle handle : node.entries) {
+		outResults.push_back(entries_[handle].userData);
+	}
+	for (int32_t child : node.children) {
+		if (child >= 0 && nodes_[child].subtreeCount > 0) {
+			CollectSubtree(child, outResults);
+		}
+	}
+}
+
+void LooseOctree::QueryFrustumRecursive(int32_t nodeIndex, const Frustum& frustum, std::vector<void*>& outResults) const
+{
+	const Node& node = nodes_[nodeIndex];
+	if (node.subtreeCount == 0) {
+		return;
+	}
+
+	// ルートはワールド範囲外のオブジェクトも持つため領域判定を行わない
+	if (node.parent >= 0) {
+		BoundingBox bounds = GetLooseBounds(node);
+		if (!frustum.IntersectsAABB(bounds)) {
+			return;
+		}
+		// 完全に内側なら個別判定を省略
+		if (frustum.ContainsAABB(bounds)) {
+			CollectSubtree(nodeIndex, outResults);
+			return;
+		}
+	}
+
+	for (Handle handle : node.entries) {
+		const Entry& entry = entries_[handle];
+		if (frustum.IntersectsSphere(entry.center, entry.radius)) {
+			outResults.push_back(entry.userData);
+		}
+	}
+
+	for (int32_t child : node.children) {
+		if (child >= 0) {
+			QueryFrustumRecursive(child, frustum, outResults);
+		}
+	}
+}
+
+void LooseOctree::QueryRadiusRecursive(int32_t nodeIndex, const Vector3& center, float radius, std::vector<void*>& outResults) const
+{
+	const Node& node = nodes_[nodeIndex];
+	if (node.subtreeCount == 0) {
+		return;
+	}
+
+	if (node.parent >= 0 && DistanceSquaredToBox(center, GetLooseBounds(node)) > radius * radius) {
+		return;
+	}
+
+	for (Handle handle : node.entries) {
+		const Entry& entry = entries_[handle];
+		Vector3 diff = entry.center - center;
+		float reach = radius + entry.radius;
+		if (diff.x * diff.x + diff.y * diff.y + diff.z * diff.z <= reach * reach) {
+			outResults.push_back(entry.userData);
+		}
+	}
+
+	for (int32_t child : node.children) {
+		if (child >= 0) {
+			QueryRadiusRecursive(child, center, radius, outResults);
+		}
+	}
+}
+
+float LooseOctree::DistanceSquaredToBox(const Vector3& point, const BoundingBox& box)
+{
+	float dx = (std::max)({ box.min.x - point.x, 0.0f, point.x - box.max.x });
+	float dy = (std::max)({ box.min.y - point.y, 0.0f, point.y - box.max.y });
+	float dz = (std::max)({ box.min.z - point.z, 0.0f, point.z - box.max.z });
+	return dx * dx + dy * dy + dz * dz;
+}
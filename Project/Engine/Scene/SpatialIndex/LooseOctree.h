@@ -0,0 +1,141 @@
+#pragma once
+#include "Engine/Math/MathCore.h"
+#include "Engine/Math/BoundingBox.h"
+#include "Engine/Math/Frustum.h"
+#include <cstdint>
+#include <vector>
+
+/// @brief シーンオブジェクト用のルーズ八分木
+/// @details 各ノードの判定領域を通常セルの2倍に広げることで、
+/// オブジェクトが少し動いただけではノードを移動しない（再挿入が起きにくい）。
+/// WorldTransform::TransferMatrix から Update が呼ばれ、常に最新の位置を保持する。
+/// 描画の視錐台カリングに使い、球検索・最近傍検索はゲーム側の近傍探索用に公開している。
+class LooseOctree {
+public:
+	/// @brief オブジェクトハンドル
+	using Handle = uint32_t;
+
+	/// @brief 無効なハンドル
+	static constexpr Handle kInvalidHandle = 0xFFFFFFFFu;
+
+	/// @brief 統計情報（デバッグ表示用）
+	struct Stats {
+		uint32_t objectCount = 0;   ///< 登録オブジェクト数
+		uint32_t nodeCount = 0;     ///< 確保済みノード数
+		uint32_t updateCount = 0;   ///< このフレームの位置更新回数
+		uint32_t reinsertCount = 0; ///< このフレームのノード移動回数
+	};
+
+	/// @brief 初期化
+	/// @param center ワールド中心
+	/// @param halfSize ワールドの半径（ルートセルの半分の幅）
+	/// @param maxDepth 最大分割深度（深すぎると小さなオブジェクトごとにノードができ、検索が全件走査より遅くなる）
+	void Initialize(const Vector3& center, float halfSize, uint32_t maxDepth = 5);
+
+	/// @brief 全オブジェクトとノードを破棄（初期化パラメータは維持）
+	void Clear();
+
+	/// @brief オブジェクトを登録
+	/// @param userData 検索結果として返すポインタ
+	/// @param center バウンディングスフィアの中心（ワールド座標）
+	/// @param radius バウンディングスフィアの半径
+	/// @return ハンドル
+	Handle Insert(void* userData, const Vector3& center, float radius);
+
+	/// @brief オブジェクトの位置・半径を更新
+	/// @param handle Insertで取得したハンドル
+	/// @param center 新しい中心
+	/// @param radius 新しい半径
+	void Update(Handle handle, const Vector3& center, float radius);
+
+	/// @brief オブジェクトを登録解除
+	/// @param handle Insertで取得したハンドル
+	void Remove(Handle handle);
+
+	/// @brief 視錐台と交差するオブジェクトを取得
+	/// @param frustum 視錐台
+	/// @param outResults 結果の出力先（末尾に追加される）
+	void QueryFrustum(const Frustum& frustum, std::vector<void*>& outResults) const;
+
+	/// @brief 球と交差するオブジェクトを取得
+	/// @param center 検索中心
+	/// @param radius 検索半径
+	/// @param outResults 結果の出力先（末尾に追加される）
+	void QueryRadius(const Vector3& center, float radius, std::vector<void*>& outResults) const;
+
+	/// @brief 指定点に近い順にN個のオブジェクトを取得
+	/// @param point 検索点
+	/// @param count 取得する最大数
+	/// @param outResults 結果の出力先（末尾に近い順で追加される）
+	/// @param exclude 結果から除外するユーザーデータ（自分自身など）
+	void QueryNearest(const Vector3& point, size_t count, std::vector<void*>& outResults, const void* exclude = nullptr) const;
+
+	/// @brief フレーム単位の統計をリセット
+	void ResetFrameStats();
+
+	/// @brief 統計情報を取得
+	/// @return 統計情報
+	const Stats& GetStats() const { return stats_; }
+
+private:
+	/// @brief 八分木ノード
+	struct Node {
+		Vector3 center = { 0.0f, 0.0f, 0.0f }; ///< セル中心
+		float halfSize = 0.0f;                 ///< セルの半分の幅（ルーズ領域はこの2倍）
+		uint32_t depth = 0;                    ///< 深度
+		int32_t parent = -1;                   ///< 親ノード
+		int32_t children[8] = { -1, -1, -1, -1, -1, -1, -1, -1 }; ///< 子ノード（未作成は-1）
+		uint32_t subtreeCount = 0;             ///< 部分木に含まれるオブジェクト数
+		std::vector<Handle> entries;           ///< このノードに直接属するオブジェクト
+	};
+
+	/// @brief 登録オブジェクト
+	struct Entry {
+		Vector3 center = { 0.0f, 0.0f, 0.0f };
+		float radius = 0.0f;
+		void* userData = nullptr;
+		int32_t node = -1;  ///< 所属ノード
+		uint32_t slot = 0;  ///< ノードのentries内の位置
+		bool alive = false;
+	};
+
+	/// @brief オブジェクトを格納すべきノードを探索（必要なら子ノードを作成）
+	int32_t FindNode(const Vector3& center, float radius);
+
+	/// @brief オブジェクトが現在のノードに留まれるか判定
+	bool FitsInNode(const Node& node, const Vector3& center, float radius) const;
+
+	/// @brief 子ノードを取得または作成
+	int32_t GetOrCreateChild(int32_t nodeIndex, int octant);
+
+	/// @brief ノードにエントリを追加
+	void AttachToNode(Handle handle, int32_t nodeIndex);
+
+	/// @brief ノードからエントリを取り外す
+	void DetachFromNode(Handle handle);
+
+	/// @brief ノードのルーズ領域を取得
+	BoundingBox GetLooseBounds(const Node& node) const;
+
+	/// @brief 部分木の全オブジェクトを無条件に追加
+	void CollectSubtree(int32_t nodeIndex, std::vector<void*>& outResults) const;
+
+	/// @brief 視錐台検索の再帰処理
+	void QueryFrustumRecursive(int32_t nodeIndex, const Frustum& frustum, std::vector<void*>& outResults) const;
+
+	/// @brief 球検索の再帰処理
+	void QueryRadiusRecursive(int32_t nodeIndex, const Vector3& center, float radius, std::vector<void*>& outResults) const;
+
+	/// @brief 点とAABBの距離の2乗
+	static float DistanceSquaredToBox(const Vector3& point, const BoundingBox& box);
+
+	std::vector<Node> nodes_;
+	std::vector<Entry> entries_;
+	std::vector<Handle> freeHandles_;
+
+	Vector3 worldCenter_ = { 0.0f, 0.0f, 0.0f };
+	float worldHalfSize_ = 256.0f;
+	uint32_t maxDepth_ = 5;
+
+	Stats stats_;
+};
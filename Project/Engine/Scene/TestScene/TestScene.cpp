@@ -35,49 +35,49 @@ void TestScene::Initialize(EngineSystem* engine)
 	auto sphere = std::make_unique<SphereObject>();
 	sphere->Initialize();
 	sphere->SetActive(false);  // Skeletonテスト中は非表示
-	gameObjects_.push_back(std::move(sphere));
+	AddGameObject(std::move(sphere));
 
 	// Fenceオブジェクト
 	auto fence = std::make_unique<FenceObject>();
 	fence->Initialize();
 	fence->SetActive(false);  // Skeletonテスト中は非表示
-	gameObjects_.push_back(std::move(fence));
+	AddGameObject(std::move(fence));
 
 	// Terrainオブジェクト
 	auto terrain = std::make_unique<TerrainObject>();
 	terrain->Initialize();
 	terrain->SetActive(false);  // Skeletonテスト中は非表示
-	gameObjects_.push_back(std::move(terrain));
+	AddGameObject(std::move(terrain));
 
 	// AnimatedCubeオブジェクト
 	auto animatedCube = std::make_unique<AnimatedCubeObject>();
 	animatedCube->Initialize();
 	animatedCube->SetActive(false);  // Skeletonテスト中は非表示
-	gameObjects_.push_back(std::move(animatedCube));
+	AddGameObject(std::move(animatedCube));
 
 	// SkeletonModelオブジェクト
 	auto skeletonModel = std::make_unique<SkeletonModelObject>();
 	skeletonModel->Initialize();
 	skeletonModel->SetActive(true);
-	gameObjects_.push_back(std::move(skeletonModel));
+	AddGameObject(std::move(skeletonModel));
 
 	// WalkModelオブジェクト
 	auto walkModel = std::make_unique<WalkModelObject>();
 	walkModel->Initialize();
 	walkModel->SetActive(true);
-	gameObjects_.push_back(std::move(walkModel));
+	AddGameObject(std::move(walkModel));
 
 	// SneakWalkModelオブジェクト
 	auto sneakWalkModel = std::make_unique<SneakWalkModelObject>();
 	sneakWalkModel->Initialize();
 	sneakWalkModel->SetActive(true);
-	gameObjects_.push_back(std::move(sneakWalkModel));
+	AddGameObject(std::move(sneakWalkModel));
 
-	// SkyBoxの初期化（gameObjects_に追加）
+	// SkyBoxの初期化（AddGameObject で追加）
 	auto skyBox = std::make_unique<SkyBoxObject>();
 	skyBox->Initialize();
 	skyBox->SetActive(false);
-	gameObjects_.push_back(std::move(skyBox));
+	AddGameObject(std::move(skyBox));
 
 	// スプライトオブジェクトの初期化（複数作成）
 	// 画面中央を(0,0)とする座標系に変更
@@ -86,7 +86,7 @@ void TestScene::Initialize(EngineSystem* engine)
 	sprite1->GetTransform().translate = { -200.0f, 100.0f, 0.0f };  // 左上付近
 	sprite1->GetTransform().scale = { 0.5f, 0.5f, 1.0f };
 	sprite1->SetActive(false);
-	gameObjects_.push_back(std::move(sprite1));
+	AddGameObject(std::move(sprite1));
 
 	// スプライト2: circle（画面中央）
 	auto sprite2 = std::make_unique<SpriteObject>();
@@ -94,7 +94,7 @@ void TestScene::Initialize(EngineSystem* engine)
 	sprite2->GetTransform().translate = { 0.0f, 0.0f, 0.0f };  // 画面中央
 	sprite2->GetTransform().scale = { 1.0f, 1.0f, 1.0f };
 	sprite2->SetActive(false);
-	gameObjects_.push_back(std::move(sprite2));
+	AddGameObject(std::move(sprite2));
 
 	// スプライト3: 別のuvChecker（右下）
 	auto sprite3 = std::make_unique<SpriteObject>();
@@ -102,7 +102,7 @@ void TestScene::Initialize(EngineSystem* engine)
 	sprite3->GetTransform().translate = { 200.0f, -100.0f, 0.0f };  // 右下付近
 	sprite3->GetTransform().scale = { 0.8f, 0.8f, 1.0f };
 	sprite3->SetActive(false);
-	gameObjects_.push_back(std::move(sprite3));
+	AddGameObject(std::move(sprite3));
 
 	// ===== パーティクルシステムの初期化 =====
 	auto particleSystem = std::make_unique<ParticleSystem>();
@@ -114,7 +114,7 @@ void TestScene::Initialize(EngineSystem* engine)
 	particleSystem->SetBillboardType(BillboardType::ViewFacing);
 	particleSystem_= particleSystem.get();
 
-	gameObjects_.push_back(std::move(particleSystem));
+	AddGameObject(std::move(particleSystem));
 
 	// エミッションモジュールの設定
 	{
@@ -192,7 +192,7 @@ void TestScene::Initialize(EngineSystem* engine)
 	modelParticleSystem->SetBlendMode(BlendMode::kBlendModeNormal);  // 通常合成
 	modelParticleSystem_ = modelParticleSystem.get();
 
-	gameObjects_.push_back(std::move(modelParticleSystem));
+	AddGameObject(std::move(modelParticleSystem));
 
 	// エミッションモジュールの設定（モデルパーティクル用）
 	{
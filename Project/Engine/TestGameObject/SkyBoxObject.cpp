@@ -111,33 +111,21 @@ void SkyBoxObject::CreateBoxVertices() {
 	  22, 21, 23,
    };
 
-   // 頂点バッファの作成
-   vertexBuffer_ = ResourceFactory::CreateBufferResource(dxCommon->GetDevice(), sizeof(vertices));
+   // 頂点バッファの作成（デフォルトヒープに置き、データはまとめてコピーする）
+   vertexBuffer_ = dxCommon->GetUploadManager()->CreateStaticBuffer(vertices, sizeof(vertices));
 
    // 頂点バッファビューの作成
    vertexBufferView_.BufferLocation = vertexBuffer_->GetGPUVirtualAddress();
    vertexBufferView_.SizeInBytes = sizeof(vertices);
    vertexBufferView_.StrideInBytes = sizeof(SkyBoxVertex);
 
-   // 頂点データをマップ
-   SkyBoxVertex* vertexData = nullptr;
-   vertexBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&vertexData));
-   std::memcpy(vertexData, vertices, sizeof(vertices));
-   vertexBuffer_->Unmap(0, nullptr);
-
    // インデックスバッファの作成
-   indexBuffer_ = ResourceFactory::CreateBufferResource(dxCommon->GetDevice(), sizeof(indices));
+   indexBuffer_ = dxCommon->GetUploadManager()->CreateStaticBuffer(indices, sizeof(indices));
 
    // インデックスバッファビューの作成
    indexBufferView_.BufferLocation = indexBuffer_->GetGPUVirtualAddress();
    indexBufferView_.SizeInBytes = sizeof(indices);
    indexBufferView_.Format = DXGI_FORMAT_R32_UINT;
-
-   // インデックスデータをマップ
-   uint32_t* indexData = nullptr;
-   indexBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&indexData));
-   std::memcpy(indexData, indices, sizeof(indices));
-   indexBuffer_->Unmap(0, nullptr);
 }
 
 void SkyBoxObject::Update() {
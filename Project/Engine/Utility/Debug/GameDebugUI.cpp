@@ -4,6 +4,7 @@
 #include <EngineSystem.h>
 #include "Engine/Utility/FrameRate/FrameRateController.h"
 #include "Engine/Scene/SceneManager.h"
+#include "Engine/Graphics/Model/Model.h"
 
 #include <Psapi.h>
 #include <algorithm>
@@ -170,6 +171,12 @@ void GameDebugUI::ShowEngineInfoUI()
 			ImGui::EndTabItem();
 		}
 		
+		// ========== タブ4: ライトバッファの転送量 ==========
+		if (ImGui::BeginTabItem("ライト転送")) {
+			ShowLightUploadTab();
+			ImGui::EndTabItem();
+		}
+		
 		ImGui::EndTabBar();
 	}
 }
@@ -357,6 +364,51 @@ void GameDebugUI::ShowDetailedPerformanceTab(FrameRateController* frameRate)
 	
 }
 
+void GameDebugUI::ShowLightUploadTab()
+{
+	auto lightManager = engine_->GetComponent<LightManager>();
+	if (!lightManager) {
+		ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "LightManager: 利用不可");
+		return;
+	}
+
+	const LightManager::UploadStatistics& stats = lightManager->GetUploadStatistics();
+
+	ImGui::TextColored(ImVec4(0.2f, 1.0f, 0.8f, 1.0f), "[前フレームの転送量]");
+	ImGui::Spacing();
+
+	ImGui::Columns(2, "LightUploadColumns", true);
+	ImGui::SetColumnWidth(0, 150);
+
+	auto row = [](const char* label, uint32_t bytes) {
+		ImGui::Text("%s", label);
+		ImGui::NextColumn();
+		ImGui::Text("%u B", bytes);
+		ImGui::NextColumn();
+	};
+	row("ディレクショナル", stats.directionalBytes);
+	row("ポイント", stats.pointBytes);
+	row("スポット", stats.spotBytes);
+	row("ライトカウント", stats.countsBytes);
+	row("クラスター分割", stats.clusterBytes);
+
+	ImGui::Text("ライトの合計");
+	ImGui::NextColumn();
+	// 何も変わらなかったフレームは転送を丸ごと省略している
+	ImVec4 totalColor = stats.GetLightBytes() == 0 ?
+		ImVec4(0.0f, 1.0f, 0.0f, 1.0f) : ImVec4(1.0f, 0.8f, 0.0f, 1.0f);
+	ImGui::PushStyleColor(ImGuiCol_Text, totalColor);
+	ImGui::Text("%u B", stats.GetLightBytes());
+	ImGui::PopStyleColor();
+	ImGui::NextColumn();
+
+	ImGui::Columns(1);
+
+	ImGui::Spacing();
+	ImGui::Text("書き込んだライト: %u（%u 範囲）", stats.changedLightCount, stats.rangeCount);
+	ImGui::Text("起動からの合計: %.2f KB", static_cast<double>(lightManager->GetTotalUploadedBytes()) / 1024.0);
+}
+
 void GameDebugUI::ShowSystemStatusTab()
 {
 	ImGui::TextColored(ImVec4(0.2f, 0.8f, 1.0f, 1.0f), "[エンジンシステム状態]");
@@ -422,6 +474,66 @@ void GameDebugUI::ShowSystemStatusTab()
 	
 	ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f),
 		"利用可能なコンポーネント: %d / %d", availableCount, (int)components.size());
+
+	// ディスクリプタヒープの使用状況
+	if (directXCommon) {
+		ImGui::Spacing();
+		ImGui::Separator();
+		ImGui::Spacing();
+
+		ImGui::TextColored(ImVec4(0.2f, 0.8f, 1.0f, 1.0f), "[ディスクリプタ (SRV/CBV/UAV)]");
+		ImGui::Spacing();
+
+		DescriptorManager* descriptorManager = directXCommon->GetDescriptorManager();
+		DescriptorAllocator::Statistics stats = descriptorManager->GetSRVStatistics();
+		float usageRate = descriptorManager->GetSRVUsageRate();
+		ImGui::ProgressBar(usageRate, ImVec2(-1.0f, 0.0f));
+		ImGui::Text("使用中: %u / %u (割り当て %u 件, 最大 %u)",
+			stats.allocatedCount, stats.capacity, stats.allocationCount, stats.peakAllocatedCount);
+		ImGui::Text("解放待ち: %u  使用範囲: %u", stats.retiredCount, stats.committedCount);
+		ImGui::Text("空き範囲: %u 個 (断片化の目安)", stats.freeRangeCount);
+		ImGui::Text("一時領域: %u / %u (最大 %u)",
+			descriptorManager->GetUsedTransientSRVCount(), DescriptorManager::kTransientSRVDescriptorsPerFrame,
+			descriptorManager->GetPeakTransientSRVCount());
+		if (stats.staleFreeCount > 0) {
+			ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "不正な解放: %u 回", stats.staleFreeCount);
+		}
+
+		// アップロード（ステージング）の使用状況
+		ImGui::Spacing();
+		ImGui::TextColored(ImVec4(0.2f, 0.8f, 1.0f, 1.0f), "[アップロード]");
+		ImGui::Spacing();
+
+		UploadManager::Statistics uploadStats = directXCommon->GetUploadManager()->GetStatistics();
+		const float toMB = 1.0f / (1024.0f * 1024.0f);
+		ImGui::ProgressBar(static_cast<float>(uploadStats.ring.usedSize) / static_cast<float>(uploadStats.ring.capacity), ImVec2(-1.0f, 0.0f));
+		ImGui::Text("リング: %.1f / %.1f MB (最大 %.1f MB, 折り返し %u 回)",
+			uploadStats.ring.usedSize * toMB, uploadStats.ring.capacity * toMB,
+			uploadStats.ring.peakUsedSize * toMB, uploadStats.ring.wrapCount);
+		ImGui::Text("提出: %u 回  テクスチャ: %u  バッファ: %u  転送: %.1f MB",
+			uploadStats.submitCount, uploadStats.textureCount, uploadStats.bufferCount, uploadStats.uploadedBytes * toMB);
+		if (uploadStats.stallCount > 0 || uploadStats.dedicatedCount > 0) {
+			ImGui::TextColored(ImVec4(1.0f, 0.8f, 0.3f, 1.0f), "空き待ち: %u 回  一時バッファ: %u 回",
+				uploadStats.stallCount, uploadStats.dedicatedCount);
+		}
+	}
+
+	// モデルのLOD
+	ImGui::Spacing();
+	ImGui::TextColored(ImVec4(0.2f, 0.8f, 1.0f, 1.0f), "[モデルLOD]");
+	ImGui::Spacing();
+
+	MeshLodSettings lodSettings = Model::GetLodSettings();
+	bool lodChanged = ImGui::Checkbox("LOD有効", &lodSettings.enabled);
+	float thresholdPixels = lodSettings.errorThreshold * 1080.0f;
+	if (ImGui::SliderFloat("許容誤差 (1080p換算px)", &thresholdPixels, 0.1f, 16.0f, "%.1f")) {
+		lodSettings.errorThreshold = thresholdPixels / 1080.0f;
+		lodChanged = true;
+	}
+	lodChanged |= ImGui::SliderFloat("切り替えの余裕", &lodSettings.hysteresis, 0.0f, 0.9f, "%.2f");
+	if (lodChanged) {
+		Model::SetLodSettings(lodSettings);
+	}
 }
 
 void GameDebugUI::RegisterWindowsForDocking()
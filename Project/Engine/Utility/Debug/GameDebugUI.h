@@ -72,6 +72,9 @@ private: // デバッグ用のUIを表示するためのメソッド
     /// @brief システム状態タブを表示
     void ShowSystemStatusTab();
 
+    /// @brief ライトバッファの転送量タブを表示
+    void ShowLightUploadTab();
+
     /// @brief ライティングデバッグUIを表示（独立ウィンドウ）
     void ShowLightingDebugUI();
 
@@ -0,0 +1,120 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+namespace {
+	// 処理時間のばらつきを均すため、スレッド数より多めに分ける
+	constexpr uint32_t kChunksPerThread = 4;
+}
+
+JobSystem::~JobSystem() {
+	Finalize();
+}
+
+void JobSystem::Initialize(uint32_t workerCount) {
+	Finalize();
+
+	exit_ = false;
+	workers_.reserve(workerCount);
+	for (uint32_t i = 0; i < workerCount; ++i) {
+		workers_.emplace_back(&JobSystem::WorkerMain, this, generation_);
+	}
+}
+
+void JobSystem::Finalize() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		exit_ = true;
+	}
+	startCondition_.notify_all();
+
+	for (auto& worker : workers_) {
+		if (worker.joinable()) {
+			worker.join();
+		}
+	}
+	workers_.clear();
+}
+
+uint32_t JobSystem::GetChunkCount(size_t itemCount, size_t minItemsPerChunk) const {
+	return GetChunkCount(itemCount, minItemsPerChunk, (GetWorkerCount() + 1) * kChunksPerThread);
+}
+
+uint32_t JobSystem::GetChunkCount(size_t itemCount, size_t minItemsPerChunk, uint32_t maxChunkCount) {
+	if (itemCount == 0 || maxChunkCount == 0) {
+		return 0;
+	}
+	size_t minItems = (std::max)(minItemsPerChunk, size_t(1));
+	return static_cast<uint32_t>((std::min)(static_cast<size_t>(maxChunkCount), (std::max)(itemCount / minItems, size_t(1))));
+}
+
+uint32_t JobSystem::ParallelFor(size_t itemCount, size_t minItemsPerChunk, const RangeFunction& func) {
+	return ParallelFor(itemCount, minItemsPerChunk, (GetWorkerCount() + 1) * kChunksPerThread, func);
+}
+
+uint32_t JobSystem::ParallelFor(size_t itemCount, size_t minItemsPerChunk, uint32_t maxChunkCount, const RangeFunction& func) {
+	uint32_t chunkCount = GetChunkCount(itemCount, minItemsPerChunk, maxChunkCount);
+	if (chunkCount == 0) {
+		return 0;
+	}
+
+	func_ = &func;
+	itemCount_ = itemCount;
+	chunkCount_ = chunkCount;
+	nextChunk_.store(0, std::memory_order_relaxed);
+
+	if (workers_.empty() || chunkCount == 1) {
+		RunChunks();
+	} else {
+		// ワーカーを起こし、呼び出しスレッドも処理に加わる
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			pendingCount_ = GetWorkerCount();
+			++generation_;
+		}
+		startCondition_.notify_all();
+
+		RunChunks();
+
+		std::unique_lock<std::mutex> lock(mutex_);
+		doneCondition_.wait(lock, [this] { return pendingCount_ == 0; });
+	}
+
+	func_ = nullptr;
+	return chunkCount;
+}
+
+void JobSystem::WorkerMain(uint64_t startGeneration) {
+	uint64_t seenGeneration = startGeneration;
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			startCondition_.wait(lock, [&] { return exit_ || generation_ != seenGeneration; });
+			if (exit_) {
+				return;
+			}
+			seenGeneration = generation_;
+		}
+
+		RunChunks();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			--pendingCount_;
+		}
+		doneCondition_.notify_one();
+	}
+}
+
+void JobSystem::RunChunks() {
+	// 余りは先頭のチャンクから1つずつ配る
+	const size_t baseSize = itemCount_ / chunkCount_;
+	const size_t remainder = itemCount_ % chunkCount_;
+
+	for (uint32_t chunk = nextChunk_.fetch_add(1, std::memory_order_relaxed); chunk < chunkCount_;
+		chunk = nextChunk_.fetch_add(1, std::memory_order_relaxed)) {
+		size_t begin = chunk * baseSize + (std::min)(static_cast<size_t>(chunk), remainder);
+		size_t end = begin + baseSize + (chunk < remainder ? 1 : 0);
+		(*func_)(chunk, begin, end);
+	}
+}
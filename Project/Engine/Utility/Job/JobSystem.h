@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief 要素の範囲を連続したチャンクに分け、ワーカースレッドと呼び出しスレッドで並列に処理する
+/// @details チャンクは先頭から順に隙間なく並び、チャンク番号は範囲の順と一致する。
+/// どのスレッドがどのチャンクを処理するかは毎回変わるので、結果をチャンクごとに分けて書き、
+/// チャンク番号の順にまとめれば、スレッド数によらず同じ順の結果になる。
+class JobSystem {
+public:
+    /// @brief 処理関数（チャンクの番号と範囲を受け取る）
+    using RangeFunction = std::function<void(uint32_t chunkIndex, size_t begin, size_t end)>;
+
+    ~JobSystem();
+
+    /// @brief ワーカースレッドを起動
+    /// @param workerCount ワーカー数（0の場合は呼び出しスレッドだけで処理する）
+    void Initialize(uint32_t workerCount);
+
+    /// @brief ワーカースレッドを停止
+    void Finalize();
+
+    /// @brief ワーカー数を取得
+    uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workers_.size()); }
+
+    /// @brief 範囲を分けて並列に処理し、すべて終わるまで待つ
+    /// @param itemCount 要素数
+    /// @param minItemsPerChunk 1チャンクあたりの最小要素数
+    /// @param func 処理関数（複数のスレッドから同時に呼ばれる）
+    /// @return チャンク数
+    uint32_t ParallelFor(size_t itemCount, size_t minItemsPerChunk, const RangeFunction& func);
+
+    /// @brief チャンク数の上限を指定して並列に処理する（チャンクごとに書き込み先を用意する場合など）
+    /// @param maxChunkCount チャンク数の上限
+    uint32_t ParallelFor(size_t itemCount, size_t minItemsPerChunk, uint32_t maxChunkCount, const RangeFunction& func);
+
+    /// @brief ParallelFor が使うチャンク数を求める
+    uint32_t GetChunkCount(size_t itemCount, size_t minItemsPerChunk) const;
+
+    /// @brief チャンク数の上限を指定したときのチャンク数を求める
+    static uint32_t GetChunkCount(size_t itemCount, size_t minItemsPerChunk, uint32_t maxChunkCount);
+
+private:
+    /// @brief ワーカースレッドのメインループ
+    void WorkerMain(uint64_t startGeneration);
+
+    /// @brief 残っているチャンクを取り出して処理する
+    void RunChunks();
+
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable startCondition_;
+    std::condition_variable doneCondition_;
+    uint64_t generation_ = 0;   // ジョブ発行ごとに進む
+    uint32_t pendingCount_ = 0; // 未完了のワーカー数
+    bool exit_ = false;
+
+    // 実行中のジョブ
+    const RangeFunction* func_ = nullptr;
+    size_t itemCount_ = 0;
+    uint32_t chunkCount_ = 0;
+    std::atomic<uint32_t> nextChunk_ = 0;
+};
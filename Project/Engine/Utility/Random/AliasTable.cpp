@@ -0,0 +1,82 @@
+#include "AliasTable.h"
+
+namespace {
+    constexpr double kProbabilityScale = 4294967296.0; // 2^32
+
+    uint32_t ToProbability(double probability)
+    {
+        if (probability >= 1.0) {
+            return UINT32_MAX;
+        }
+        if (probability <= 0.0) {
+            return 0;
+        }
+        return static_cast<uint32_t>(probability * kProbabilityScale);
+    }
+}
+
+bool AliasTable::Build(const float* weights, size_t count)
+{
+    double total = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        if (weights[i] > 0.0f) {
+            total += weights[i];
+        }
+    }
+    if (count == 0 || total <= 0.0) {
+        Clear();
+        return false;
+    }
+
+    probabilities_.resize(count);
+    aliases_.resize(count);
+    scaled_.resize(count);
+    small_.clear();
+    large_.clear();
+
+    // 平均が 1 になるように揃え、1 未満と 1 以上に分ける
+    const double scale = static_cast<double>(count) / total;
+    for (size_t i = 0; i < count; ++i) {
+        scaled_[i] = weights[i] > 0.0f ? weights[i] * scale : 0.0;
+        (scaled_[i] < 1.0 ? small_ : large_).push_back(static_cast<uint32_t>(i));
+    }
+
+    // 1 未満の列の残りを 1 以上の列で埋める
+    uint32_t lastLarge = large_.empty() ? 0 : large_.back();
+    while (!small_.empty() && !large_.empty()) {
+        const uint32_t less = small_.back();
+        small_.pop_back();
+        const uint32_t more = large_.back();
+        large_.pop_back();
+
+        probabilities_[less] = ToProbability(scaled_[less]);
+        aliases_[less] = more;
+
+        scaled_[more] = (scaled_[more] + scaled_[less]) - 1.0;
+        (scaled_[more] < 1.0 ? small_ : large_).push_back(more);
+        lastLarge = more;
+    }
+
+    // 残りは誤差を除けばちょうど 1
+    for (uint32_t index : large_) {
+        probabilities_[index] = UINT32_MAX;
+        aliases_[index] = index;
+    }
+    for (uint32_t index : small_) {
+        if (scaled_[index] > 0.0) {
+            probabilities_[index] = UINT32_MAX;
+            aliases_[index] = index;
+        } else {
+            // 重み 0 が誤差で残った場合は選ばれないようにする
+            probabilities_[index] = 0;
+            aliases_[index] = lastLarge;
+        }
+    }
+    return true;
+}
+
+void AliasTable::Clear()
+{
+    probabilities_.clear();
+    aliases_.clear();
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief 重み付きの選択を O(1) で行う表（Vose のエイリアス法）
+/// @details Build で O(n) かけて表を作り、Sample は乱数1つで選ぶ。
+/// 重みが変わったときだけ作り直す使い方を想定している。作り直しも、同じ数以下なら確保しない。
+class AliasTable {
+public:
+    /// @brief 表を作る
+    /// @param weights 重み（0 未満は 0 として扱う）
+    /// @param count 重みの数
+    /// @return 重みの合計が正なら true（false の場合は選べない）
+    bool Build(const float* weights, size_t count);
+
+    /// @brief 重みに比例した確率で番号を選ぶ
+    /// @param random 一様な32ビットの乱数
+    uint32_t Sample(uint32_t random) const
+    {
+        // 上位で列を、残りのビットで列の中の当たり外れを決める
+        const uint64_t scaled = static_cast<uint64_t>(random) * probabilities_.size();
+        const uint32_t column = static_cast<uint32_t>(scaled >> 32);
+        const uint32_t coin = static_cast<uint32_t>(scaled);
+        return coin < probabilities_[column] ? column : aliases_[column];
+    }
+
+    /// @brief 選べる状態か
+    bool IsValid() const { return !probabilities_.empty(); }
+
+    /// @brief 表の大きさ
+    size_t GetCount() const { return probabilities_.size(); }
+
+    /// @brief 表を空にする
+    void Clear();
+
+private:
+    std::vector<uint32_t> probabilities_; // 列の番号そのものが選ばれる確率（2^32 倍）
+    std::vector<uint32_t> aliases_;       // 外れたときに選ぶ番号
+
+    // Build の作業用（作り直しのたびに確保しない）
+    std::vector<double> scaled_;
+    std::vector<uint32_t> small_;
+    std::vector<uint32_t> large_;
+};
@@ -1,99 +1,73 @@
 #include "GameTimer.h"
 #include <algorithm>
 #include <cmath>
+#include <utility>
 
 #ifdef _DEBUG
 #include <imgui.h>
 #endif
 
-GameTimer::GameTimer(float duration, bool loop) 
-    : duration_(duration), loop_(loop) {
-}
-
-void GameTimer::Update(float deltaTime) {
-    if (!isActive_) return;
-    
-    // 前フレームのループフラグをリセット
-    loopedThisFrame_ = false;
-    
-    // タイムスケールを適用
-    float scaledDeltaTime = deltaTime * timeScale_;
-    currentTime_ += scaledDeltaTime;
-    
-    // コールバックをチェック
-    CheckAndExecuteCallbacks();
-    
-    if (currentTime_ >= duration_) {
-        finished_ = true;
-        
-        if (loop_) {
-            currentTime_ = 0.0f;
-            finished_ = false;  // ループ時は完了フラグをリセット
-            loopedThisFrame_ = true;  // ループ発生をマーク
-            
-            // ループ時はコールバックの発火状態もリセット
-            for (auto& callback : callbacks_) {
-                callback.triggered = false;
-            }
-        } else {
-            isActive_ = false;
+GameTimer::GameTimer(float duration, bool loop) {
+    TimerService& service = TimerService::GetInstance();
+    handle_ = service.Create();
+    service.SetDuration(handle_, duration);
+    service.SetLoop(handle_, loop);
+}
+
+GameTimer::~GameTimer() {
+    if (handle_.IsValid()) {
+        TimerService::GetInstance().Destroy(handle_);
+    }
+}
+
+GameTimer::GameTimer(GameTimer&& other) noexcept
+    : handle_(std::exchange(other.handle_, TimerHandle{})) {
+}
+
+GameTimer& GameTimer::operator=(GameTimer&& other) noexcept {
+    if (this != &other) {
+        if (handle_.IsValid()) {
+            TimerService::GetInstance().Destroy(handle_);
         }
+        handle_ = std::exchange(other.handle_, TimerHandle{});
     }
+    return *this;
+}
+
+void GameTimer::SetGroup(TimerGroupId group) {
+    TimerService::GetInstance().SetGroup(Acquire(), group);
 }
 
 void GameTimer::Start(float duration, bool loop) {
-    duration_ = duration;
-    loop_ = loop;
-    currentTime_ = 0.0f;
-    isActive_ = true;
-    finished_ = false;
-    useFrameMode_ = false;
-    loopedThisFrame_ = false;  // ループフラグもリセット
-    
-    // コールバックの発火状態をリセット
-    for (auto& callback : callbacks_) {
-        callback.triggered = false;
-    }
+    TimerService::GetInstance().Start(Acquire(), duration, loop);
 }
 
 void GameTimer::Stop() {
-    isActive_ = false;
+    TimerService::GetInstance().Pause(handle_);
 }
 
 void GameTimer::Reset() {
-    currentTime_ = 0.0f;
-    isActive_ = false;
-    finished_ = false;
-    loopedThisFrame_ = false;  // ループフラグもリセット
-    
-    // コールバックの発火状態をリセット
-    for (auto& callback : callbacks_) {
-        callback.triggered = false;
-    }
+    TimerService::GetInstance().Reset(handle_);
 }
 
 void GameTimer::Pause() {
-    isActive_ = false;
+    TimerService::GetInstance().Pause(handle_);
 }
 
 void GameTimer::Resume() {
-    if (currentTime_ < duration_) {
-        isActive_ = true;
-        finished_ = false;
-    }
+    TimerService::GetInstance().Resume(handle_);
 }
 
 bool GameTimer::IsActive() const {
-    return isActive_;
+    return TimerService::GetInstance().IsActive(handle_);
 }
 
 bool GameTimer::IsFinished() const {
-    return finished_;
+    return TimerService::GetInstance().IsFinished(handle_);
 }
 
 float GameTimer::GetProgress() const {
-    if (duration_ <= 0.0f) return 1.0f;
-    return (std::min)(1.0f, currentTime_ / duration_);
+    return TimerService::GetInstance().GetProgress(handle_);
 }
 
 float GameTimer::GetEasedProgress(EasingUtil::Type easingType) const {
@@ -102,182 +76,163 @@ float GameTimer::GetEasedProgress(EasingUtil::Type easingType) const {
 }
 
 float GameTimer::GetRemainingTime() const {
-    return (std::max)(0.0f, duration_ - currentTime_);
+    return (std::max)(0.0f, GetDuration() - GetElapsedTime());
 }
 
 float GameTimer::GetElapsedTime() const {
-    return currentTime_;
+    return TimerService::GetInstance().GetElapsedTime(handle_);
 }
 
 float GameTimer::GetDuration() const {
-    return duration_;
+    return TimerService::GetInstance().GetDuration(handle_);
 }
 
 bool GameTimer::IsLoop() const {
-    return loop_;
+    return TimerService::GetInstance().IsLoop(handle_);
 }
 
 bool GameTimer::HasLooped() const {
-    return loopedThisFrame_;
+    return TimerService::GetInstance().HasLooped(handle_);
 }
 
 void GameTimer::SetDuration(float duration) {
-    duration_ = duration;
-    // 現在時間が新しい継続時間を超えている場合の処理
-    if (currentTime_ >= duration_ && isActive_) {
-        finished_ = true;
-        if (!loop_) {
-            isActive_ = false;
-        }
-    }
+    TimerService::GetInstance().SetDuration(Acquire(), duration);
 }
 
 void GameTimer::SetLoop(bool loop) {
-    loop_ = loop;
+    TimerService::GetInstance().SetLoop(Acquire(), loop);
 }
 
 // ★★★ 新機能：フレームカウンター ★★★
 
 void GameTimer::StartFrames(int frameCount, bool loop, float targetFPS) {
-    totalFrames_ = frameCount;
-    targetFPS_ = targetFPS;
-    duration_ = frameCount / targetFPS;  // フレーム数をタイムに変換
-    loop_ = loop;
-    currentTime_ = 0.0f;
-    isActive_ = true;
-    finished_ = false;
-    useFrameMode_ = true;
-    loopedThisFrame_ = false;  // ループフラグもリセット
-    
-    // コールバックの発火状態をリセット
-    for (auto& callback : callbacks_) {
-        callback.triggered = false;
-    }
+    TimerService::GetInstance().StartFrames(Acquire(), frameCount, loop, targetFPS);
 }
 
 int GameTimer::GetCurrentFrame() const {
-    if (!useFrameMode_) return 0;
-    return static_cast<int>(currentTime_ * targetFPS_);
+    return TimerService::GetInstance().GetCurrentFrame(handle_);
 }
 
 int GameTimer::GetTotalFrames() const {
-    return totalFrames_;
+    return TimerService::GetInstance().GetTotalFrames(handle_);
 }
 
 // ★★★ 新機能：タイムスケール ★★★
 
 void GameTimer::SetTimeScale(float scale) {
-    timeScale_ = (std::max)(0.0f, scale);  // 負の値は防ぐ
+    TimerService::GetInstance().SetTimeScale(Acquire(), scale);  // 負の値は防ぐ
 }
 
 float GameTimer::GetTimeScale() const {
-    return timeScale_;
+    return TimerService::GetInstance().GetTimeScale(handle_);
 }
 
 // ★★★ 新機能：コールバック ★★★
 
 void GameTimer::AddCallback(float triggerTime, std::function<void()> callback) {
-    TimerCallback timerCallback;
-    timerCallback.triggerTime = triggerTime;
-    timerCallback.callback = callback;
-    timerCallback.triggered = false;
-    callbacks_.push_back(timerCallback);
+    TimerService::GetInstance().AddCallback(Acquire(), triggerTime, std::move(callback));
 }
 
 void GameTimer::AddCallbackAtProgress(float progress, std::function<void()> callback) {
-    float triggerTime = duration_ * progress;
-    AddCallback(triggerTime, callback);
+    float triggerTime = GetDuration() * progress;
+    AddCallback(triggerTime, std::move(callback));
 }
 
 void GameTimer::ClearCallbacks() {
-    callbacks_.clear();
+    TimerService::GetInstance().ClearCallbacks(handle_);
 }
 
 // ★★★ 新機能：デバッグ表示 ★★★
 #ifdef _DEBUG
 void GameTimer::DrawImGui(const char* label) {
     ImGui::PushID(this);  // 複数のタイマーがある場合のID衝突を防ぐ
-    
+
     if (ImGui::CollapsingHeader(label)) {
-        ImGui::Text("Name: %s", name_.c_str());
-        ImGui::Text("Status: %s", isActive_ ? "ACTIVE" : (finished_ ? "FINISHED" : "STOPPED"));
-        
+        TimerService& service = TimerService::GetInstance();
+        const bool isActive = IsActive();
+        const float duration = GetDuration();
+        const float currentTime = GetElapsedTime();
+
+        ImGui::Text("Name: %s", service.GetName(handle_));
+        ImGui::Text("Status: %s", isActive ? "ACTIVE" : (IsFinished() ? "FINISHED" : "STOPPED"));
+
         // 基本情報
         ImGui::Separator();
-        ImGui::Text("Time: %.3f / %.3f sec", currentTime_, duration_);
+        ImGui::Text("Time: %.3f / %.3f sec", currentTime, duration);
         ImGui::Text("Progress: %.1f%%", GetProgress() * 100.0f);
         ImGui::Text("Remaining: %.3f sec", GetRemainingTime());
-        
+
         // プログレスバー
         ImGui::ProgressBar(GetProgress(), ImVec2(-1.0f, 0.0f));
-        
+
         // フレームモード情報
-        if (useFrameMode_) {
+        if (service.IsFrameMode(handle_)) {
             ImGui::Separator();
-            ImGui::Text("Frame Mode: %d / %d frames", GetCurrentFrame(), totalFrames_);
-            ImGui::Text("Target FPS: %.1f", targetFPS_);
+            ImGui::Text("Frame Mode: %d / %d frames", GetCurrentFrame(), GetTotalFrames());
+            ImGui::Text("Target FPS: %.1f", service.GetTargetFPS(handle_));
         }
-        
+
         // タイムスケール
         ImGui::Separator();
-        ImGui::Text("Time Scale: %.2fx", timeScale_);
-        if (ImGui::SliderFloat("##TimeScale", &timeScale_, 0.0f, 3.0f, "%.2fx")) {
-            SetTimeScale(timeScale_);
+        float timeScale = GetTimeScale();
+        ImGui::Text("Time Scale: %.2fx", timeScale);
+        if (ImGui::SliderFloat("##TimeScale", &timeScale, 0.0f, 3.0f, "%.2fx")) {
+            SetTimeScale(timeScale);
         }
-        
+
         // 制御ボタン
         ImGui::Separator();
-        if (ImGui::Button("Start")) { Start(duration_, loop_); }
+        bool loop = IsLoop();
+        if (ImGui::Button("Start")) { Start(duration, loop); }
         ImGui::SameLine();
         if (ImGui::Button("Stop")) { Stop(); }
         ImGui::SameLine();
         if (ImGui::Button("Reset")) { Reset(); }
-        
-        if (isActive_) {
+
+        if (isActive) {
             if (ImGui::Button("Pause")) { Pause(); }
-        } else if (currentTime_ < duration_) {
+        } else if (currentTime < duration) {
             if (ImGui::Button("Resume")) { Resume(); }
         }
-        
+
         // ループ設定とループ状態表示
-        ImGui::Checkbox("Loop", &loop_);
-        if (loop_) {
+        if (ImGui::Checkbox("Loop", &loop)) {
+            SetLoop(loop);
+        }
+        if (loop) {
             ImGui::SameLine();
-            if (loopedThisFrame_) {
+            if (HasLooped()) {
                 ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "[LOOPED THIS FRAME]");
             } else {
                 ImGui::Text("[Loop Enabled]");
             }
         }
-        
+
         // コールバック情報
-        if (!callbacks_.empty()) {
+        const size_t callbackCount = service.GetCallbackCount(handle_);
+        if (callbackCount > 0) {
             ImGui::Separator();
-            ImGui::Text("Callbacks: %zu", callbacks_.size());
-            for (size_t i = 0; i < callbacks_.size(); ++i) {
-                const auto& cb = callbacks_[i];
-                ImGui::Text("  [%zu] %.3fs %s", i, cb.triggerTime, cb.triggered ? "(FIRED)" : "");
+            ImGui::Text("Callbacks: %zu", callbackCount);
+            for (size_t i = 0; i < callbackCount; ++i) {
+                ImGui::Text("  [%zu] %.3fs %s", i, service.GetCallbackTime(handle_, i),
+                    service.IsCallbackTriggered(handle_, i) ? "(FIRED)" : "");
             }
         }
     }
-    
+
     ImGui::PopID();
 }
 #endif
 
 void GameTimer::SetName(const char* name) {
-    name_ = name;
+    TimerService::GetInstance().SetName(Acquire(), name);
 }
 
 // ★★★ プライベートメソッド ★★★
 
-void GameTimer::CheckAndExecuteCallbacks() {
-    for (auto& callback : callbacks_) {
-        if (!callback.triggered && currentTime_ >= callback.triggerTime) {
-            callback.triggered = true;
-            if (callback.callback) {
-                callback.callback();
-            }
-        }
+TimerHandle GameTimer::Acquire() {
+    if (!handle_.IsValid()) {
+        handle_ = TimerService::GetInstance().Create();
     }
-}
\ No newline at end of file
+    return handle_;
+}
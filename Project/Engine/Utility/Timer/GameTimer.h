@@ -1,21 +1,15 @@
 #pragma once
 
 #include <functional>
-#include <vector>
-#include <string>
 #include "Engine/Math/Easing/EasingUtil.h"
+#include "TimerService.h"
 
 /// @brief ゲーム用タイマークラス
 /// シーン遷移、ゲーム内演出のタイミング制御に使用（イージングは分離）
+/// 時間は TimerService がまとめて進めるので、持ち主が毎フレーム更新する必要はない。
+/// このクラスは TimerService のタイマーへのハンドルで、破棄するとタイマーも破棄される。
 class GameTimer {
 public:
-	/// @brief コールバック情報
-	struct TimerCallback {
-		float triggerTime;                          // 発火時間
-		std::function<void()> callback;             // コールバック関数
-		bool triggered = false;                     // 既に発火したか
-	};
-
 	/// @brief デフォルトコンストラクタ
 	GameTimer() = default;
 
@@ -24,9 +18,16 @@ public:
 	/// @param loop ループするかどうか
 	GameTimer(float duration, bool loop = false);
 
-	/// @brief タイマーの更新
-	/// @param deltaTime 前フレームからの経過時間（秒）
-	void Update(float deltaTime);
+	~GameTimer();
+
+	GameTimer(GameTimer&& other) noexcept;
+	GameTimer& operator=(GameTimer&& other) noexcept;
+	GameTimer(const GameTimer&) = delete;
+	GameTimer& operator=(const GameTimer&) = delete;
+
+	/// @brief 時間を進めるグループを設定（一時停止・タイムスケールをグループ単位で掛ける）
+	/// @param group TimerService::CreateGroup で作ったグループ
+	void SetGroup(TimerGroupId group);
 
 	/// @brief タイマーを開始
 	/// @param duration タイマーの継続時間（秒）
@@ -92,7 +93,7 @@ public:
 
 	// フレームカウンター機能
 
-	/// @brief フレーム単位でタイマーを開始
+	/// @brief フレーム単位でタイマーを開始（グループの更新回数で数える）
 	/// @param frameCount フレーム数
 	/// @param loop ループするかどうか
 	/// @param targetFPS 目標FPS（デフォルト60）
@@ -118,7 +119,7 @@ public:
 
 	// ★★★ コールバック機能 ★★★
 
-	/// @brief 指定時間でコールバックを追加
+	/// @brief 指定時間でコールバックを追加（TimerService::Update の中で呼ばれる）
 	/// @param triggerTime 発火時間（秒）
 	/// @param callback コールバック関数
 	void AddCallback(float triggerTime, std::function<void()> callback);
@@ -144,25 +145,8 @@ public:
 	void SetName(const char* name);
 
 private:
-	float currentTime_ = 0.0f;          ///< 現在の経過時間
-	float duration_ = 0.0f;             ///< タイマーの継続時間
-	bool isActive_ = false;             ///< タイマーがアクティブかどうか
-	bool loop_ = false;                 ///< ループするかどうか
-	bool finished_ = false;             ///< タイマーが完了したかどうか
-	bool loopedThisFrame_ = false;      ///< このフレームでループしたかどうか
-
-	// タイムスケール機能
-	float timeScale_ = 1.0f;            ///< タイムスケール
-
-	// フレーム機能
-	int totalFrames_ = 0;               ///< 総フレーム数（フレーム単位使用時）
-	bool useFrameMode_ = false;         ///< フレーム単位モードかどうか
-	float targetFPS_ = 60.0f;           ///< 目標FPS（フレーム単位モード用）
-
-	// コールバック・デバッグ機能
-	std::vector<TimerCallback> callbacks_;  ///< コールバックリスト
-	std::string name_ = "Timer";             ///< タイマー名（デバッグ用）
+	TimerHandle handle_;                ///< TimerService のタイマー
 
-	/// @brief コールバックをチェックして実行
-	void CheckAndExecuteCallbacks();
+	/// @brief タイマーがなければ作る
+	TimerHandle Acquire();
 };
\ No newline at end of file
@@ -0,0 +1,548 @@
+#include "TimerService.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+#ifdef _DEBUG
+#include <imgui.h>
+#endif
+
+TimerService& TimerService::GetInstance() {
+    static TimerService instance;
+    return instance;
+}
+
+TimerService::TimerService() {
+    CreateGroup("Default");
+}
+
+void TimerService::Update(float deltaTime) {
+    const auto start = std::chrono::steady_clock::now();
+    ++frameCount_;
+    stats_.firedCount = 0;
+
+    const auto onExpire = [this](uint32_t index, uint32_t tag) {
+        ++stats_.firedCount;
+        OnExpire(index, tag);
+    };
+
+    // 止まっているグループは時計を進めないので、中のタイマーには触らない
+    for (Group& group : groups_) {
+        if (group.isPaused || group.timeScale <= 0.0f) {
+            continue;
+        }
+        group.time += static_cast<double>(deltaTime) * group.timeScale;
+        group.frame += 1.0;
+        group.seconds.Advance(group.time, onExpire);
+        group.frames.Advance(group.frame, onExpire);
+    }
+
+    stats_.microseconds = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+TimerGroupId TimerService::CreateGroup(const char* name) {
+    Group& group = groups_.emplace_back();
+    group.name = name;
+    group.seconds.Initialize(kSecondsResolution);
+    group.frames.Initialize(1.0);
+    return static_cast<TimerGroupId>(groups_.size() - 1);
+}
+
+void TimerService::SetGroupPaused(TimerGroupId group, bool paused) {
+    assert(group < groups_.size() && "Invalid timer group!");
+    groups_[group].isPaused = paused;
+}
+
+bool TimerService::IsGroupPaused(TimerGroupId group) const {
+    assert(group < groups_.size() && "Invalid timer group!");
+    return groups_[group].isPaused;
+}
+
+void TimerService::SetGroupTimeScale(TimerGroupId group, float scale) {
+    assert(group < groups_.size() && "Invalid timer group!");
+    groups_[group].timeScale = (std::max)(0.0f, scale);
+}
+
+float TimerService::GetGroupTimeScale(TimerGroupId group) const {
+    assert(group < groups_.size() && "Invalid timer group!");
+    return groups_[group].timeScale;
+}
+
+TimerHandle TimerService::Create(TimerGroupId group) {
+    assert(group < groups_.size() && "Invalid timer group!");
+    uint32_t index;
+    if (!freeTimers_.empty()) {
+        index = freeTimers_.back();
+        freeTimers_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(timers_.size());
+        timers_.emplace_back();
+    }
+
+    Timer& timer = timers_[index];
+    const uint32_t generation = timer.generation;
+    timer = Timer{};
+    timer.generation = generation;
+    timer.group = group;
+    timer.isUsed = true;
+    return { index, generation };
+}
+
+void TimerService::Destroy(TimerHandle handle) {
+    Timer* timer = Find(handle);
+    if (!timer) {
+        return;
+    }
+    Unschedule(*timer);
+    SetActive(*timer, false);
+    timer->callbacks.clear();
+    timer->isUsed = false;
+    ++timer->generation;
+    ++timer->epoch;
+    freeTimers_.push_back(handle.index);
+}
+
+bool TimerService::IsValid(TimerHandle handle) const {
+    return Find(handle) != nullptr;
+}
+
+void TimerService::Start(TimerHandle handle, float duration, bool loop) {
+    Timer* timer = Find(handle);
+    if (!timer) {
+        return;
+    }
+    // 単位（ホイール）が変わる前に前回の期限を外す
+    Unschedule(*timer);
+    timer->frameMode = false;
+    timer->totalFrames = 0;
+    timer->duration = duration;
+    timer->loop = loop;
+    timer->baseElapsed = 0.0;
+    timer->anchorClock = GetClock(*timer);
+    timer->isFinished = false;
+    timer->loopFrame = UINT64_MAX;
+    for (Callback& callback : timer->callbacks) {
+        callback.triggered = false;
+    }
+    ++timer->epoch;
+    SetActive(*timer, true);
+    Schedule(handle.index);
+}
+
+void TimerService::StartFrames(TimerHandle handle, int frameCount, bool loop, float targetFPS) {
+    Timer* timer = Find(handle);
+    if (!timer) {
+        return;
+    }
+    // 単位（ホイール）が変わる前に前回の期限を外す
+    Unschedule(*timer);
+    timer->frameMode = true;
+    timer->totalFrames = frameCount;
+    timer->targetFPS = targetFPS;
+    timer->duration = static_cast<float>(frameCount);
+    timer->loop = loop;
+    timer->baseElapsed = 0.0;
+    timer->anchorClock = GetClock(*timer);
+    timer->isFinished = false;
+    timer->loopFrame = UINT64_MAX;
+    for (Callback& callback : timer->callbacks) {
+        callback.triggered = false;
+    }
+    ++timer->epoch;
+    SetActive(*timer, true);
+    Schedule(handle.index);
+}
+
+void TimerService::Pause(TimerHandle handle) {
+    Timer* timer = Find(handle);
+    if (!timer || !timer->isActive) {
+        return;
+    }
+    Reanchor(*timer);
+    Unschedule(*timer);
+    ++timer->epoch;
+    SetActive(*timer, false);
+}
+
+void TimerService::Resume(TimerHandle handle) {
+    Timer* timer = Find(handle);
+    if (!timer || timer->isActive || timer->baseElapsed >= timer->duration) {
+        return;
+    }
+    timer->anchorClock = GetClock(*timer);
+    timer->isFinished = false;
+    ++timer->epoch;
+    SetActive(*timer, true);
+    Schedule(handle.index);
+}
+
+void TimerService::Reset(TimerHandle handle) {
+    Timer* timer = Find(handle);
+    if (!timer) {
+        return;
+    }
+    Unschedule(*timer);
+    SetActive(*timer, false);
+    timer->baseElapsed = 0.0;
+    timer->isFinished = false;
+    timer->loopFrame = UINT64_MAX;
+    for (Callback& callback : timer->callbacks) {
+        callback.triggered = false;
+    }
+    ++timer->epoch;
+}
+
+void TimerService::SetGroup(TimerHandle handle, TimerGroupId group) {
+    assert(group < groups_.size() && "Invalid timer group!");
+    Timer* timer = Find(handle);
+    if (!timer || timer->group == group) {
+        return;
+    }
+    Reanchor(*timer);
+    Unschedule(*timer);
+    timer->group = group;
+    timer->anchorClock = GetClock(*timer);
+    ++timer->epoch;
+    Schedule(handle.index);
+}
+
+void TimerService::SetDuration(TimerHandle handle, float duration) {
+    Timer* timer = Find(handle);
+    if (!timer) {
+        return;
+    }
+    Reanchor(*timer);
+    timer->duration = static_cast<float>(ToTimerUnits(*timer, duration));
+    ++timer->epoch;
+    // 経過時間が新しい継続時間を超えていれば終わらせる（ループなら次の Update で周回する）
+    if (timer->isActive && !timer->loop && timer->baseElapsed >= timer->duration) {
+        Unschedule(*timer);
+        timer->baseElapsed = timer->duration;
+        timer->isFinished = true;
+        SetActive(*timer, false);
+        return;
+    }
+    Schedule(handle.index);
+}
+
+void TimerService::SetLoop(TimerHandle handle, bool loop) {
+    if (Timer* timer = Find(handle)) {
+        timer->loop = loop;
+    }
+}
+
+void TimerService::SetTimeScale(TimerHandle handle, float scale) {
+    Timer* timer = Find(handle);
+    if (!timer) {
+        return;
+    }
+    Reanchor(*timer);
+    timer->timeScale = (std::max)(0.0f, scale);
+    ++timer->epoch;
+    Schedule(handle.index);
+}
+
+float TimerService::GetElapsedTime(TimerHandle handle) const {
+    const Timer* timer = Find(handle);
+    if (!timer) {
+        return 0.0f;
+    }
+    const double elapsed = ComputeElapsed(*timer);
+    return static_cast<float>(timer->frameMode ? elapsed / timer->targetFPS : elapsed);
+}
+
+float TimerService::GetDuration(TimerHandle handle) const {
+    const Timer* timer = Find(handle);
+    if (!timer) {
+        return 0.0f;
+    }
+    return timer->frameMode ? timer->duration / timer->targetFPS : timer->duration;
+}
+
+float TimerService::GetProgress(TimerHandle handle) const {
+    const Timer* timer = Find(handle);
+    if (!timer || timer->duration <= 0.0f) {
+        return 1.0f;
+    }
+    return (std::min)(1.0f, static_cast<float>(ComputeElapsed(*timer) / timer->duration));
+}
+
+bool TimerService::IsActive(TimerHandle handle) const {
+    const Timer* timer = Find(handle);
+    return timer && timer->isActive;
+}
+
+bool TimerService::IsFinished(TimerHandle handle) const {
+    const Timer* timer = Find(handle);
+    return timer && timer->isFinished;
+}
+
+bool TimerService::IsLoop(TimerHandle handle) const {
+    const Timer* timer = Find(handle);
+    return timer && timer->loop;
+}
+
+bool TimerService::IsFrameMode(TimerHandle handle) const {
+    const Timer* timer = Find(handle);
+    return timer && timer->frameMode;
+}
+
+bool TimerService::HasLooped(TimerHandle handle) const {
+    const Timer* timer = Find(handle);
+    return timer && timer->loopFrame == frameCount_;
+}
+
+float TimerService::GetTimeScale(TimerHandle handle) const {
+    const Timer* timer = Find(handle);
+    return timer ? timer->timeScale : 1.0f;
+}
+
+int TimerService::GetCurrentFrame(TimerHandle handle) const {
+    const Timer* timer = Find(handle);
+    if (!timer || !timer->frameMode) {
+        return 0;
+    }
+    return static_cast<int>(ComputeElapsed(*timer));
+}
+
+int TimerService::GetTotalFrames(TimerHandle handle) const {
+    const Timer* timer = Find(handle);
+    return timer ? timer->totalFrames : 0;
+}
+
+float TimerService::GetTargetFPS(TimerHandle handle) const {
+    const Timer* timer = Find(handle);
+    return timer ? timer->targetFPS : 60.0f;
+}
+
+void TimerService::AddCallback(TimerHandle handle, float triggerTime, std::function<void()> callback) {
+    Timer* timer = Find(handle);
+    if (!timer) {
+        return;
+    }
+    Callback& entry = timer->callbacks.emplace_back();
+    entry.triggerTime = triggerTime;
+    entry.function = std::move(callback);
+
+    // 動いていればこのコールバックの期限だけを入れる（過ぎていれば次の Update で発火する）
+    const double trigger = ToTimerUnits(*timer, triggerTime);
+    if (timer->isActive && timer->timeScale > 0.0f && trigger <= timer->duration) {
+        const double deadline = timer->anchorClock + (trigger - timer->baseElapsed) / timer->timeScale;
+        entry.entry = GetWheel(*timer).Insert(deadline, handle.index, static_cast<uint32_t>(timer->callbacks.size() - 1));
+    }
+}
+
+void TimerService::ClearCallbacks(TimerHandle handle) {
+    Timer* timer = Find(handle);
+    if (!timer) {
+        return;
+    }
+    TimerWheel& wheel = GetWheel(*timer);
+    for (Callback& callback : timer->callbacks) {
+        if (callback.entry != TimerWheel::kInvalidEntry) {
+            wheel.Cancel(callback.entry);
+        }
+    }
+    timer->callbacks.clear();
+}
+
+size_t TimerService::GetCallbackCount(TimerHandle handle) const {
+    const Timer* timer = Find(handle);
+    return timer ? timer->callbacks.size() : 0;
+}
+
+float TimerService::GetCallbackTime(TimerHandle handle, size_t index) const {
+    const Timer* timer = Find(handle);
+    return timer && index < timer->callbacks.size() ? timer->callbacks[index].triggerTime : 0.0f;
+}
+
+bool TimerService::IsCallbackTriggered(TimerHandle handle, size_t index) const {
+    const Timer* timer = Find(handle);
+    return timer && index < timer->callbacks.size() && timer->callbacks[index].triggered;
+}
+
+void TimerService::SetName(TimerHandle handle, const char* name) {
+    if (Timer* timer = Find(handle)) {
+        timer->name = name;
+    }
+}
+
+const char* TimerService::GetName(TimerHandle handle) const {
+    const Timer* timer = Find(handle);
+    return timer ? timer->name.c_str() : "";
+}
+
+TimerService::Timer* TimerService::Find(TimerHandle handle) {
+    if (handle.index >= timers_.size()) {
+        return nullptr;
+    }
+    Timer& timer = timers_[handle.index];
+    return timer.isUsed && timer.generation == handle.generation ? &timer : nullptr;
+}
+
+const TimerService::Timer* TimerService::Find(TimerHandle handle) const {
+    return const_cast<TimerService*>(this)->Find(handle);
+}
+
+double TimerService::ComputeElapsed(const Timer& timer) const {
+    if (!timer.isActive) {
+        return timer.baseElapsed;
+    }
+    const double elapsed = timer.baseElapsed + (GetClock(timer) - timer.anchorClock) * timer.timeScale;
+    // 期限を過ぎてから Update で処理するまでの間も継続時間を超えないようにする
+    return (std::min)(elapsed, static_cast<double>(timer.duration));
+}
+
+double TimerService::GetClock(const Timer& timer) const {
+    const Group& group = groups_[timer.group];
+    return timer.frameMode ? group.frame : group.time;
+}
+
+TimerWheel& TimerService::GetWheel(Timer& timer) {
+    Group& group = groups_[timer.group];
+    return timer.frameMode ? group.frames : group.seconds;
+}
+
+void TimerService::Schedule(uint32_t index) {
+    Timer& timer = timers_[index];
+    Unschedule(timer);
+    if (!timer.isActive || timer.timeScale <= 0.0f) {
+        return;
+    }
+
+    TimerWheel& wheel = GetWheel(timer);
+    const double inverseScale = 1.0 / timer.timeScale;
+
+    // 同じ時刻ならコールバックを先に発火させるため、終了より先に入れる
+    for (uint32_t i = 0; i < timer.callbacks.size(); ++i) {
+        Callback& callback = timer.callbacks[i];
+        const double trigger = ToTimerUnits(timer, callback.triggerTime);
+        if (callback.triggered || trigger > timer.duration) {
+            continue;
+        }
+        callback.entry = wheel.Insert(timer.anchorClock + (trigger - timer.baseElapsed) * inverseScale, index, i);
+    }
+    timer.finishEntry = wheel.Insert(timer.anchorClock + (timer.duration - timer.baseElapsed) * inverseScale, index, kFinishTag);
+}
+
+void TimerService::Unschedule(Timer& timer) {
+    TimerWheel& wheel = GetWheel(timer);
+    if (timer.finishEntry != TimerWheel::kInvalidEntry) {
+        wheel.Cancel(timer.finishEntry);
+        timer.finishEntry = TimerWheel::kInvalidEntry;
+    }
+    for (Callback& callback : timer.callbacks) {
+        if (callback.entry != TimerWheel::kInvalidEntry) {
+            wheel.Cancel(callback.entry);
+            callback.entry = TimerWheel::kInvalidEntry;
+        }
+    }
+}
+
+void TimerService::Reanchor(Timer& timer) {
+    if (timer.isActive) {
+        timer.baseElapsed = ComputeElapsed(timer);
+        timer.anchorClock = GetClock(timer);
+    }
+}
+
+void TimerService::SetActive(Timer& timer, bool active) {
+    if (timer.isActive != active) {
+        timer.isActive = active;
+        active ? ++activeCount_ : --activeCount_;
+    }
+}
+
+void TimerService::OnExpire(uint32_t index, uint32_t tag) {
+    Timer& timer = timers_[index];
+    if (tag == kFinishTag) {
+        timer.finishEntry = TimerWheel::kInvalidEntry;
+        const double deadline = timer.anchorClock + (timer.duration - timer.baseElapsed) * (1.0 / timer.timeScale);
+        Finish(index, deadline);
+    } else {
+        timer.callbacks[tag].entry = TimerWheel::kInvalidEntry;
+        Fire(index, tag);
+    }
+}
+
+void TimerService::Finish(uint32_t index, double deadlineClock) {
+    // 終了と同じ Update で期限が来たコールバックを先に呼ぶ（呼んだ先で操作されたらそちらを優先する）
+    const uint32_t generation = timers_[index].generation;
+    const uint32_t epoch = timers_[index].epoch;
+    for (uint32_t i = 0; i < timers_[index].callbacks.size(); ++i) {
+        Timer& timer = timers_[index];
+        Callback& callback = timer.callbacks[i];
+        if (callback.triggered || ToTimerUnits(timer, callback.triggerTime) > timer.duration) {
+            continue;
+        }
+        if (callback.entry != TimerWheel::kInvalidEntry) {
+            GetWheel(timer).Cancel(callback.entry);
+            callback.entry = TimerWheel::kInvalidEntry;
+        }
+        Fire(index, i);
+        const Timer& current = timers_[index];
+        if (!current.isUsed || current.generation != generation || current.epoch != epoch) {
+            return;
+        }
+    }
+
+    Timer& timer = timers_[index];
+    if (timer.loop) {
+        // 期限を起点に次の周を始める（1フレームで何周も遅れた分は捨てる）
+        timer.loopFrame = frameCount_;
+        timer.baseElapsed = 0.0;
+        timer.anchorClock = deadlineClock;
+        if ((GetClock(timer) - timer.anchorClock) * timer.timeScale >= timer.duration) {
+            timer.anchorClock = GetClock(timer);
+        }
+        for (Callback& callback : timer.callbacks) {
+            callback.triggered = false;
+        }
+        Schedule(index);
+    } else {
+        Unschedule(timer);
+        timer.baseElapsed = timer.duration;
+        timer.isFinished = true;
+        SetActive(timer, false);
+    }
+}
+
+void TimerService::Fire(uint32_t index, uint32_t callbackIndex) {
+    Callback& callback = timers_[index].callbacks[callbackIndex];
+    callback.triggered = true;
+    // 呼んだ先で ClearCallbacks やタイマーの追加をされても呼び出し中の関数が消えないように写す
+    const std::function<void()> function = callback.function;
+    if (function) {
+        function();
+    }
+}
+
+double TimerService::ToTimerUnits(const Timer& timer, float seconds) const {
+    return timer.frameMode ? static_cast<double>(seconds) * timer.targetFPS : seconds;
+}
+
+void TimerService::DrawImGui() {
+#ifdef _DEBUG
+    if (!ImGui::Begin("Timers")) {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Text("動いているタイマー: %u / %zu", activeCount_, timers_.size() - freeTimers_.size());
+    ImGui::Text("更新: %.1f us, 処理した期限: %u", stats_.microseconds, stats_.firedCount);
+
+    for (size_t i = 0; i < groups_.size(); ++i) {
+        Group& group = groups_[i];
+        ImGui::PushID(static_cast<int>(i));
+        ImGui::Separator();
+        ImGui::Text("%s: %.2f s, %.0f フレーム, 期限 %u", group.name.c_str(), group.time, group.frame,
+            group.seconds.GetCount() + group.frames.GetCount());
+        ImGui::Checkbox("一時停止", &group.isPaused);
+        ImGui::SameLine();
+        ImGui::SliderFloat("タイムスケール", &group.timeScale, 0.0f, 3.0f, "%.2fx");
+        ImGui::PopID();
+    }
+
+    ImGui::End();
+#endif
+}
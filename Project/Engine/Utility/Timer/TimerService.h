@@ -0,0 +1,218 @@
+#pragma once
+#include "TimerWheel.h"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+/// @brief TimerService に登録したタイマーの番号（GameTimer が持つ）
+struct TimerHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return index != UINT32_MAX; }
+};
+
+/// @brief 一時停止・タイムスケールをまとめて掛けるタイマーのグループ
+using TimerGroupId = uint32_t;
+
+/// @brief 全タイマーの時間をまとめて進めるサービス
+/// @details グループごとに時計（秒とフレーム数）と階層タイミングホイールを持つ。
+/// タイマーは開始時に「終わる時刻」と「コールバックの時刻」をホイールに入れるだけで、
+/// 毎フレームの Update は期限が来たものだけを処理する（動いているタイマーの数によらない）。
+/// 経過時間や進行率は、聞かれたときに開始時刻とグループの時計から求める。
+///
+/// グループの一時停止は時計を止めるだけなので、グループ内のタイマーの数によらず O(1)。
+/// グループのタイムスケールは時計の進み方を変えるだけで、入れ直しは不要。
+/// タイマーごとのタイムスケールを変えたときはそのタイマーの期限だけを入れ直す。
+class TimerService {
+public:
+    static constexpr TimerGroupId kDefaultGroup = 0;
+
+    /// @brief 直前の Update の記録
+    struct Stats {
+        uint32_t firedCount = 0;     // 期限が来て処理したエントリ（終了・ループ・コールバック）
+        float microseconds = 0.0f;
+    };
+
+    /// @brief インスタンスを取得（シングルトンパターン）
+    static TimerService& GetInstance();
+
+    /// @brief 全グループの時計を進め、期限が来たタイマーを処理する（SceneManager が毎フレーム呼ぶ）
+    void Update(float deltaTime);
+
+    /// @brief Update を呼んだ回数（HasLooped の判定に使う）
+    uint64_t GetFrameCount() const { return frameCount_; }
+
+    // グループ
+
+    /// @brief グループを作成（名前はデバッグ表示用）
+    TimerGroupId CreateGroup(const char* name);
+
+    /// @brief グループを一時停止（グループ内のタイマーの時間が止まる）
+    void SetGroupPaused(TimerGroupId group, bool paused);
+    bool IsGroupPaused(TimerGroupId group) const;
+
+    /// @brief グループのタイムスケールを設定（0以上）
+    void SetGroupTimeScale(TimerGroupId group, float scale);
+    float GetGroupTimeScale(TimerGroupId group) const;
+
+    // タイマー（GameTimer から使う）
+
+    /// @brief タイマーを作成（停止状態）
+    TimerHandle Create(TimerGroupId group = kDefaultGroup);
+
+    /// @brief タイマーを破棄（コールバックも取り消す）
+    void Destroy(TimerHandle handle);
+
+    bool IsValid(TimerHandle handle) const;
+
+    /// @brief 秒単位で開始
+    void Start(TimerHandle handle, float duration, bool loop);
+
+    /// @brief フレーム単位で開始（グループの Update の回数で数える）
+    /// @param targetFPS 秒で聞かれたときの換算に使う
+    void StartFrames(TimerHandle handle, int frameCount, bool loop, float targetFPS);
+
+    /// @brief 止める（経過時間は残る）
+    void Pause(TimerHandle handle);
+
+    /// @brief 止めたところから再開する（終わっていなければ）
+    void Resume(TimerHandle handle);
+
+    /// @brief 止めて経過時間を0に戻す
+    void Reset(TimerHandle handle);
+
+    /// @brief 所属するグループを変更（動いている場合は経過時間を引き継ぐ）
+    void SetGroup(TimerHandle handle, TimerGroupId group);
+
+    void SetDuration(TimerHandle handle, float duration);
+    void SetLoop(TimerHandle handle, bool loop);
+    void SetTimeScale(TimerHandle handle, float scale);
+
+    /// @brief 経過時間（秒。開始時刻とグループの時計から求める）
+    float GetElapsedTime(TimerHandle handle) const;
+
+    /// @brief 継続時間（秒）
+    float GetDuration(TimerHandle handle) const;
+
+    /// @brief 進行率（0.0～1.0）
+    float GetProgress(TimerHandle handle) const;
+
+    bool IsActive(TimerHandle handle) const;
+    bool IsFinished(TimerHandle handle) const;
+    bool IsLoop(TimerHandle handle) const;
+    bool IsFrameMode(TimerHandle handle) const;
+    bool HasLooped(TimerHandle handle) const;
+    float GetTimeScale(TimerHandle handle) const;
+    int GetCurrentFrame(TimerHandle handle) const;
+    int GetTotalFrames(TimerHandle handle) const;
+    float GetTargetFPS(TimerHandle handle) const;
+
+    /// @brief 経過時間（秒）でコールバックを追加（ループ時は毎周発火する）
+    void AddCallback(TimerHandle handle, float triggerTime, std::function<void()> callback);
+
+    void ClearCallbacks(TimerHandle handle);
+
+    /// @brief コールバックの発火時間と発火済みかどうか（デバッグ表示用）
+    size_t GetCallbackCount(TimerHandle handle) const;
+    float GetCallbackTime(TimerHandle handle, size_t index) const;
+    bool IsCallbackTriggered(TimerHandle handle, size_t index) const;
+
+    void SetName(TimerHandle handle, const char* name);
+    const char* GetName(TimerHandle handle) const;
+
+    /// @brief 動いているタイマーの数
+    uint32_t GetActiveCount() const { return activeCount_; }
+
+    const Stats& GetStats() const { return stats_; }
+
+    /// @brief ImGuiでのデバッグ表示（グループの一時停止・タイムスケール）
+    void DrawImGui();
+
+private:
+    TimerService();
+    ~TimerService() = default;
+    TimerService(const TimerService&) = delete;
+    TimerService& operator=(const TimerService&) = delete;
+
+    static constexpr uint32_t kFinishTag = UINT32_MAX; // ホイールのタグ（それ以外はコールバックの番号）
+    static constexpr double kSecondsResolution = 0.001;
+
+    struct Group {
+        std::string name;
+        double time = 0.0;       // タイムスケールを掛けた経過時間
+        double frame = 0.0;      // 進めたフレーム数
+        float timeScale = 1.0f;
+        bool isPaused = false;
+        TimerWheel seconds;      // 秒のタイマーの期限
+        TimerWheel frames;       // フレームのタイマーの期限
+    };
+
+    struct Callback {
+        float triggerTime = 0.0f;       // 秒
+        std::function<void()> function;
+        uint32_t entry = TimerWheel::kInvalidEntry;
+        bool triggered = false;
+    };
+
+    struct Timer {
+        uint32_t generation = 0;
+        uint32_t epoch = 0;          // 開始・停止などで増やす（コールバックの中で操作されたかの判定用）
+        TimerGroupId group = kDefaultGroup;
+        bool isUsed = false;
+        bool isActive = false;
+        bool isFinished = false;
+        bool loop = false;
+        bool frameMode = false;
+        float duration = 0.0f;       // 秒（フレーム単位ではフレーム数）
+        float timeScale = 1.0f;
+        float targetFPS = 60.0f;
+        int totalFrames = 0;
+        double baseElapsed = 0.0;    // anchorClock の時点の経過時間（タイマーの単位）
+        double anchorClock = 0.0;    // 動いている間の基準にしたグループの時計
+        uint64_t loopFrame = UINT64_MAX;
+        uint32_t finishEntry = TimerWheel::kInvalidEntry;
+        std::vector<Callback> callbacks;
+        std::string name = "Timer";
+    };
+
+    Timer* Find(TimerHandle handle);
+    const Timer* Find(TimerHandle handle) const;
+
+    /// @brief タイマーの単位の経過時間（動いている間はグループの時計から求める）
+    double ComputeElapsed(const Timer& timer) const;
+
+    double GetClock(const Timer& timer) const;
+    TimerWheel& GetWheel(Timer& timer);
+
+    /// @brief 今の経過時間から終了とコールバックの期限をホイールに入れ直す
+    void Schedule(uint32_t index);
+
+    /// @brief ホイールに入れた期限をすべて取り消す
+    void Unschedule(Timer& timer);
+
+    /// @brief 経過時間を今の値で固定する（動いている場合は今の時計を基準にし直す）
+    void Reanchor(Timer& timer);
+
+    void SetActive(Timer& timer, bool active);
+
+    /// @brief ホイールの期限が来た
+    void OnExpire(uint32_t index, uint32_t tag);
+
+    /// @brief 終了・ループ（まだ呼んでいないその周のコールバックを先に呼ぶ）
+    void Finish(uint32_t index, double deadlineClock);
+
+    /// @brief コールバックを呼ぶ（呼んだ先でタイマーが破棄されてもよい）
+    void Fire(uint32_t index, uint32_t callbackIndex);
+
+    double ToTimerUnits(const Timer& timer, float seconds) const;
+
+    std::deque<Group> groups_;       // コールバックの中で追加されても動かないように deque
+    std::vector<Timer> timers_;
+    std::vector<uint32_t> freeTimers_;
+    uint64_t frameCount_ = 0;
+    uint32_t activeCount_ = 0;
+    Stats stats_;
+};
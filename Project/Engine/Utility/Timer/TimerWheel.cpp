@@ -0,0 +1,161 @@
+#include "TimerWheel.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+void TimerWheel::Initialize(double resolution) {
+    assert(resolution > 0.0 && "TimerWheel resolution must be positive!");
+    resolution_ = resolution;
+    inverseResolution_ = 1.0 / resolution;
+    entries_.clear();
+    for (std::vector<uint32_t>& slot : slots_) {
+        slot.clear();
+    }
+    cascading_.clear();
+    expired_.clear();
+    freeHead_ = kInvalidEntry;
+    count_ = 0;
+    time_ = 0.0;
+    currentTick_ = 0;
+    isAdvancing_ = false;
+}
+
+uint32_t TimerWheel::Insert(double deadline, uint32_t owner, uint32_t tag) {
+    uint32_t entry = freeHead_;
+    if (entry != kInvalidEntry) {
+        freeHead_ = entries_[entry].position;
+    } else {
+        entry = static_cast<uint32_t>(entries_.size());
+        entries_.emplace_back();
+    }
+
+    Entry& e = entries_[entry];
+    e.deadline = deadline;
+    e.owner = owner;
+    e.tag = tag;
+    Place(entry);
+    ++count_;
+    return entry;
+}
+
+void TimerWheel::Cancel(uint32_t entry) {
+    assert(entry < entries_.size() && entries_[entry].slot != kInvalidEntry && "Invalid TimerWheel entry!");
+    if (entries_[entry].slot == kExpiredSlot) {
+        // Advance が順に処理している配列なので、詰めずに印だけ付ける
+        expired_[entries_[entry].position] = kInvalidEntry;
+    } else {
+        Remove(entry);
+    }
+    Free(entry);
+}
+
+uint64_t TimerWheel::ToTick(double time) const {
+    const double tick = std::floor(time * inverseResolution_);
+    return tick > 0.0 ? static_cast<uint64_t>(tick) : 0;
+}
+
+void TimerWheel::Place(uint32_t entry) {
+    uint64_t tick = ToTick(entries_[entry].deadline);
+    // 過ぎた期限は今の tick のスロットへ（次の Advance で取り出す）
+    if (tick < currentTick_) {
+        tick = currentTick_;
+    }
+    // 最上段より遠い期限は最上段の最後に入れておき、カスケードのたびに入れ直す
+    const uint64_t delta = (std::min)(tick - currentTick_, kMaxDelta);
+    tick = currentTick_ + delta;
+
+    uint32_t slot;
+    if (delta < kLevel0Size) {
+        slot = static_cast<uint32_t>(tick & (kLevel0Size - 1));
+    } else {
+        uint32_t level = 0;
+        uint32_t shift = kLevel0Bits;
+        while (level + 1 < kUpperLevelCount && delta >= (1ull << (shift + kLevelBits))) {
+            ++level;
+            shift += kLevelBits;
+        }
+        slot = kLevel0Size + level * kLevelSize + static_cast<uint32_t>((tick >> shift) & (kLevelSize - 1));
+    }
+
+    Entry& e = entries_[entry];
+    e.slot = slot;
+    e.position = static_cast<uint32_t>(slots_[slot].size());
+    slots_[slot].push_back(entry);
+}
+
+void TimerWheel::Remove(uint32_t entry) {
+    Entry& e = entries_[entry];
+    std::vector<uint32_t>& slot = slots_[e.slot];
+    const uint32_t last = slot.back();
+    slot[e.position] = last;
+    entries_[last].position = e.position;
+    slot.pop_back();
+}
+
+void TimerWheel::MoveToExpired(uint32_t entry) {
+    Entry& e = entries_[entry];
+    e.slot = kExpiredSlot;
+    e.position = static_cast<uint32_t>(expired_.size());
+    expired_.push_back(entry);
+}
+
+void TimerWheel::Free(uint32_t entry) {
+    Entry& e = entries_[entry];
+    e.slot = kInvalidEntry;
+    e.position = freeHead_;
+    freeHead_ = entry;
+    --count_;
+}
+
+void TimerWheel::Cascade(uint32_t level, uint32_t slot) {
+    // 振り分け先が同じスロットになることもあるので、中身を取り出してから入れ直す
+    cascading_.swap(slots_[kLevel0Size + level * kLevelSize + slot]);
+    for (uint32_t entry : cascading_) {
+        Place(entry);
+    }
+    cascading_.clear();
+}
+
+void TimerWheel::CollectExpired(double time) {
+    if (time < time_) {
+        return;
+    }
+    time_ = time;
+    const uint64_t targetTick = ToTick(time);
+
+    while (currentTick_ < targetTick) {
+        // この tick の期限はすべて time より前
+        std::vector<uint32_t>& slot = slots_[currentTick_ & (kLevel0Size - 1)];
+        for (uint32_t entry : slot) {
+            MoveToExpired(entry);
+        }
+        slot.clear();
+
+        ++currentTick_;
+        // 1段目が1周したら上の段の次のスロットを下ろす（上の段も1周していればさらに上から）
+        if ((currentTick_ & (kLevel0Size - 1)) == 0) {
+            uint32_t shift = kLevel0Bits;
+            for (uint32_t level = 0; level < kUpperLevelCount; ++level) {
+                const uint32_t index = static_cast<uint32_t>((currentTick_ >> shift) & (kLevelSize - 1));
+                Cascade(level, index);
+                if (index != 0) {
+                    break;
+                }
+                shift += kLevelBits;
+            }
+        }
+    }
+
+    // 今の tick は途中までなので、期限を過ぎたものだけを取り出す（残りは順番を保って詰める）
+    std::vector<uint32_t>& slot = slots_[currentTick_ & (kLevel0Size - 1)];
+    uint32_t kept = 0;
+    for (uint32_t entry : slot) {
+        if (entries_[entry].deadline <= time) {
+            MoveToExpired(entry);
+        } else {
+            entries_[entry].position = kept;
+            slot[kept++] = entry;
+        }
+    }
+    slot.resize(kept);
+}
@@ -0,0 +1,114 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief 階層タイミングホイール
+/// @details 期限を tick（resolution 単位）に丸め、近いものは1段目（256スロット、1tick ずつ）、
+/// 遠いものは上の段（64スロットずつ、256・16384・1048576 tick 刻み）に入れる。
+/// 1段目が1周するたびに上の段の次のスロットを下の段へ振り分け直す（カスケード）。
+/// 挿入・取り消しは O(1)。Advance は進めた tick 数と期限が来たエントリの数に比例し、
+/// 期限がまだ先のエントリには触らない。
+///
+/// スロットはエントリの番号の配列で、エントリは自分のスロットと配列の中の位置を持つ
+/// （取り消しは末尾と入れ替えて外す）。連結リストと違い、追加・取り消しで隣のエントリに触らない。
+///
+/// 期限そのもの（double）も持ち、今の tick の中では期限を過ぎたものだけを取り出すので、
+/// 時刻が期限以上になった最初の Advance で必ず取り出される（tick への丸めで遅れることはない）。
+class TimerWheel {
+public:
+    static constexpr uint32_t kInvalidEntry = UINT32_MAX;
+
+    /// @brief 初期化（時刻 0 から始める）
+    /// @param resolution 1tick の長さ（秒で使う場合は 0.001 など、フレーム数で使う場合は 1）
+    void Initialize(double resolution);
+
+    /// @brief エントリを追加
+    /// @param deadline 期限（Advance に渡す時刻と同じ単位。過去なら次の Advance で取り出す）
+    /// @param owner, tag 期限が来たときに渡す値
+    /// @return エントリの番号（取り出されるか取り消すまで有効）
+    uint32_t Insert(double deadline, uint32_t owner, uint32_t tag);
+
+    /// @brief エントリを取り消す
+    void Cancel(uint32_t entry);
+
+    /// @brief 時刻を進め、期限が来たエントリを取り除いて onExpire(owner, tag) を呼ぶ
+    /// @details tick の順に呼ぶ（同じ tick の中の順番は決めない）。onExpire の中で Insert・Cancel してよい。
+    /// その中で追加した期限切れのエントリは次の Advance で取り出す。
+    template<typename Func>
+    void Advance(double time, Func&& onExpire);
+
+    double GetTime() const { return time_; }
+    uint32_t GetCount() const { return count_; }
+
+private:
+    static constexpr uint32_t kLevel0Bits = 8;
+    static constexpr uint32_t kLevelBits = 6;
+    static constexpr uint32_t kLevel0Size = 1u << kLevel0Bits;
+    static constexpr uint32_t kLevelSize = 1u << kLevelBits;
+    static constexpr uint32_t kUpperLevelCount = 3;
+    static constexpr uint32_t kSlotCount = kLevel0Size + kLevelSize * kUpperLevelCount;
+    static constexpr uint32_t kExpiredSlot = kSlotCount;   // 取り出し中（expired_ に入っている）
+    static constexpr uint64_t kMaxDelta = (1ull << (kLevel0Bits + kLevelBits * kUpperLevelCount)) - 1;
+
+    struct Entry {
+        double deadline = 0.0;
+        uint32_t slot = kInvalidEntry;   // 空きエントリでは kInvalidEntry
+        uint32_t position = 0;           // スロットの中の位置（空きエントリでは次の空き）
+        uint32_t owner = 0;
+        uint32_t tag = 0;
+    };
+
+    uint64_t ToTick(double time) const;
+
+    /// @brief 今の tick からの距離に応じたスロットに入れる
+    void Place(uint32_t entry);
+
+    /// @brief スロットから外す（末尾のエントリを空いた位置へ移す）
+    void Remove(uint32_t entry);
+
+    void MoveToExpired(uint32_t entry);
+    void Free(uint32_t entry);
+
+    /// @brief 上の段のスロットを振り分け直す
+    void Cascade(uint32_t level, uint32_t slot);
+
+    /// @brief 期限が来たエントリを expired_ へ移す
+    void CollectExpired(double time);
+
+    std::vector<Entry> entries_;
+    std::vector<uint32_t> slots_[kSlotCount];
+    std::vector<uint32_t> cascading_;   // カスケード中のスロットの中身
+    std::vector<uint32_t> expired_;     // 取り出し中に取り消されたものは kInvalidEntry
+    uint32_t freeHead_ = kInvalidEntry;
+    uint32_t count_ = 0;
+
+    double resolution_ = 1.0;
+    double inverseResolution_ = 1.0;
+    double time_ = 0.0;
+    uint64_t currentTick_ = 0;   // この tick より前のスロットは空
+    bool isAdvancing_ = false;
+};
+
+template<typename Func>
+inline void TimerWheel::Advance(double time, Func&& onExpire) {
+    assert(!isAdvancing_ && "TimerWheel::Advance is not reentrant!");
+    isAdvancing_ = true;
+    CollectExpired(time);
+
+    // 1つずつ外してから呼ぶ（呼んだ先で残りを取り消してもよい）
+    for (std::size_t i = 0; i < expired_.size(); ++i) {
+        const uint32_t entry = expired_[i];
+        if (entry == kInvalidEntry) {
+            continue;
+        }
+        expired_[i] = kInvalidEntry;
+        const uint32_t owner = entries_[entry].owner;
+        const uint32_t tag = entries_[entry].tag;
+        Free(entry);
+        onExpire(owner, tag);
+    }
+    expired_.clear();
+    isAdvancing_ = false;
+}
@@ -1,5 +1,7 @@
 #include "WorldTransform.h"
 #include "Engine/Graphics/Resource/ResourceFactory.h"
+#include "Engine/Scene/SpatialIndex/LooseOctree.h"
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 
@@ -9,6 +11,11 @@
 
 using namespace MathCore;
 
+WorldTransform::~WorldTransform()
+{
+    UnbindSpatialIndex();
+}
+
 void WorldTransform::Initialize(ID3D12Device* device)
 {
     // 定数バッファを作成
@@ -46,6 +53,9 @@ void WorldTransform::TransferMatrix()
     if (mapped_) {
         mapped_->matWorld = matWorld_;
     }
+
+    // 空間インデックスを更新
+    UpdateSpatialIndex();
 }
 
 D3D12_GPU_VIRTUAL_ADDRESS WorldTransform::GetGPUVirtualAddress() const
@@ -66,6 +76,56 @@ void WorldTransform::SetWorldMatrix(const Matrix4x4& matrix)
     if (mapped_) {
         mapped_->matWorld = matWorld_;
     }
+
+    // 空間インデックスを更新
+    UpdateSpatialIndex();
+}
+
+void WorldTransform::BindSpatialIndex(LooseOctree* index, void* userData, float localRadius)
+{
+    if (spatialIndex_ && spatialIndex_ != index) {
+        UnbindSpatialIndex();
+    }
+
+    spatialLocalRadius_ = localRadius;
+
+    if (spatialIndex_) {
+        // 既に同じインデックスに登録済みなら半径だけ更新
+        UpdateSpatialIndex();
+        return;
+    }
+
+    if (!index) {
+        return;
+    }
+
+    spatialIndex_ = index;
+    spatialHandle_ = spatialIndex_->Insert(userData, GetWorldPosition(), spatialLocalRadius_);
+    UpdateSpatialIndex();
+}
+
+void WorldTransform::UnbindSpatialIndex()
+{
+    if (spatialIndex_) {
+        spatialIndex_->Remove(spatialHandle_);
+    }
+    spatialIndex_ = nullptr;
+    spatialHandle_ = LooseOctree::kInvalidHandle;
+}
+
+void WorldTransform::UpdateSpatialIndex()
+{
+    if (!spatialIndex_) {
+        return;
+    }
+
+    // 各軸のスケールのうち最大のものを半径に反映
+    auto axisLengthSq = [this](int row) {
+        return matWorld_.m[row][0] * matWorld_.m[row][0] + matWorld_.m[row][1] * matWorld_.m[row][1] + matWorld_.m[row][2] * matWorld_.m[row][2];
+    };
+    float maxScale = std::sqrt((std::max)({ axisLengthSq(0), axisLengthSq(1), axisLengthSq(2) }));
+
+    spatialIndex_->Update(spatialHandle_, GetWorldPosition(), spatialLocalRadius_ * maxScale);
 }
 
 void WorldTransform::EulerToQuaternion()
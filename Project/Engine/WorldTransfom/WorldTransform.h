@@ -4,6 +4,9 @@
 #include <d3d12.h>
 #include <wrl.h>
 #include <string>
+#include <cstdint>
+
+class LooseOctree;
 
 // 定数バッファ用データ
 struct ConstantBufferDataWorldTransform {
@@ -22,6 +25,13 @@ public:
         Quaternion  // クォータニオンによる回転
     };
 
+    WorldTransform() = default;
+    ~WorldTransform();
+
+    // 空間インデックスのハンドルを共有しないようコピーを禁止
+    WorldTransform(const WorldTransform&) = delete;
+    WorldTransform& operator=(const WorldTransform&) = delete;
+
     // === トランスフォームパラメータ（直接アクセス可能） ===
     Vector3 scale = { 1.0f, 1.0f, 1.0f };      // スケール
     Vector3 rotate = { 0.0f, 0.0f, 0.0f };     // 回転角（ラジアン）- オイラー角モード用
@@ -100,7 +110,31 @@ public:
     /// </summary>
     void QuaternionToEuler();
 
+    /// <summary>
+    /// 空間インデックスに登録する
+    /// 以後 TransferMatrix / SetWorldMatrix のたびに位置が更新される
+    /// </summary>
+    /// <param name="index">登録先の空間インデックス</param>
+    /// <param name="userData">検索結果として返すポインタ（通常は所有オブジェクト）</param>
+    /// <param name="localRadius">ローカル空間でのバウンディング半径</param>
+    void BindSpatialIndex(LooseOctree* index, void* userData, float localRadius);
+
+    /// <summary>
+    /// 空間インデックスから登録解除
+    /// </summary>
+    void UnbindSpatialIndex();
+
+    /// <summary>
+    /// 空間インデックスに登録済みか
+    /// </summary>
+    bool IsSpatialIndexBound() const { return spatialIndex_ != nullptr; }
+
 private:
+    /// <summary>
+    /// 現在のワールド行列で空間インデックスを更新
+    /// </summary>
+    void UpdateSpatialIndex();
+
     // 定数バッファリソース
     Microsoft::WRL::ComPtr<ID3D12Resource> constantBuffer_;
     // マッピング済みポインタ
@@ -111,4 +145,9 @@ private:
     const WorldTransform* parent_ = nullptr;
     // 回転モード
     RotationMode rotationMode_ = RotationMode::Euler;
+
+    // 空間インデックス（未登録時はnullptr）
+    LooseOctree* spatialIndex_ = nullptr;
+    uint32_t spatialHandle_ = 0xFFFFFFFFu;
+    float spatialLocalRadius_ = 0.0f;
 };
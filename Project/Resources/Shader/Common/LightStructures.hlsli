@@ -40,5 +40,33 @@ struct LightCounts
     uint directionalLightCount;
     uint pointLightCount;
     uint spotLightCount;
-    uint padding;
-};
\ No newline at end of file
+    uint clusterEnabled;    // クラスター分割の有効フラグ（0なら全ライトを計算）
+    uint3 clusterCount;     // クラスターの分割数（横・縦・奥行き）
+    uint padding;           // パディング
+    float2 projScale;       // 透視投影行列の m[0][0], m[1][1]
+    float sliceScale;       // 奥行き分割 slice = log(z) * sliceScale + sliceBias
+    float sliceBias;
+    float4x4 view;          // クラスター分割に使ったビュー行列
+};
+
+/// @brief クラスターごとのライト範囲
+/// offset から (lightCount & 0xFFFF) 個がポイントライト、その後ろ (lightCount >> 16) 個がスポットライトのインデックス
+struct LightClusterRange
+{
+    uint offset;
+    uint lightCount;
+};
+
+/// @brief ワールド座標が属するクラスターの番号を求める
+uint GetLightClusterIndex(LightCounts counts, float3 worldPosition)
+{
+    float3 viewPosition = mul(float4(worldPosition, 1.0f), counts.view).xyz;
+    float depth = max(viewPosition.z, 1.0e-4f);
+    
+    // NDC → タイル（画面外やニアクリップより手前は端のクラスターに寄せる）
+    float2 ndc = viewPosition.xy * counts.projScale / depth;
+    float2 tile = clamp(floor((ndc * 0.5f + 0.5f) * float2(counts.clusterCount.xy)), 0.0f, float2(counts.clusterCount.xy) - 1.0f);
+    float slice = clamp(floor(log(depth) * counts.sliceScale + counts.sliceBias), 0.0f, float(counts.clusterCount.z) - 1.0f);
+    
+    return uint(tile.x) + (uint(tile.y) + uint(slice) * counts.clusterCount.y) * counts.clusterCount.x;
+}
\ No newline at end of file
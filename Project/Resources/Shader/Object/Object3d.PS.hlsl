@@ -36,6 +36,10 @@ StructuredBuffer<DirectionalLightData> gDirectionalLights : register(t1);
 StructuredBuffer<PointLightData> gPointLights : register(t2);
 StructuredBuffer<SpotLightData> gSpotLights : register(t3);
 
+// ===== クラスター分割 =====
+StructuredBuffer<LightClusterRange> gClusterRanges : register(t4);
+StructuredBuffer<uint> gLightIndices : register(t5);
+
 // ディザリングパターン関数（4x4 Bayer Matrix）
 float GetDitheringThreshold(float2 screenPos)
 {
@@ -144,21 +148,39 @@ PixelShaderOutput main(VertexShaderOutput input)
             }
         }
         
+        //==============================
+        // クラスター分割：このピクセルのクラスターに届くライトだけを計算
+        //==============================
+        bool useClusters = gLightCounts.clusterEnabled != 0;
+        uint pointOffset = 0;
+        uint pointCount = gLightCounts.pointLightCount;
+        uint spotOffset = 0;
+        uint spotCount = gLightCounts.spotLightCount;
+        if (useClusters)
+        {
+            LightClusterRange range = gClusterRanges[GetLightClusterIndex(gLightCounts, input.worldPosition)];
+            pointOffset = range.offset;
+            pointCount = range.lightCount & 0xFFFF;
+            spotOffset = range.offset + pointCount;
+            spotCount = range.lightCount >> 16;
+        }
+        
         //==============================
         // ポイントライトの計算（複数対応）
         //==============================
-        for (uint j = 0; j < gLightCounts.pointLightCount; ++j)
+        for (uint j = 0; j < pointCount; ++j)
         {
-            if (gPointLights[j].enabled != 0)
+            uint pointIndex = useClusters ? gLightIndices[pointOffset + j] : j;
+            if (gPointLights[pointIndex].enabled != 0)
             {
                 LightingResult result = CalculatePointLight(
                     input.normal,
-                    gPointLights[j].position,
+                    gPointLights[pointIndex].position,
                     input.worldPosition,
-                    gPointLights[j].color.rgb,
-                    gPointLights[j].intensity,
-                    gPointLights[j].radius,
-                    gPointLights[j].decay,
+                    gPointLights[pointIndex].color.rgb,
+                    gPointLights[pointIndex].intensity,
+                    gPointLights[pointIndex].radius,
+                    gPointLights[pointIndex].decay,
                     toEye,
                     gMaterial.color.rgb,
                     textureColor,
@@ -174,21 +196,22 @@ PixelShaderOutput main(VertexShaderOutput input)
         //==============================
         // スポットライトの計算（複数対応）
         //==============================
-        for (uint k = 0; k < gLightCounts.spotLightCount; ++k)
+        for (uint k = 0; k < spotCount; ++k)
         {
-            if (gSpotLights[k].enabled != 0)
+            uint spotIndex = useClusters ? gLightIndices[spotOffset + k] : k;
+            if (gSpotLights[spotIndex].enabled != 0)
             {
                 LightingResult result = CalculateSpotLight(
                     input.normal,
-                    gSpotLights[k].position,
-                    gSpotLights[k].direction,
+                    gSpotLights[spotIndex].position,
+                    gSpotLights[spotIndex].direction,
                     input.worldPosition,
-                    gSpotLights[k].color.rgb,
-                    gSpotLights[k].intensity,
-                    gSpotLights[k].distance,
-                    gSpotLights[k].decay,
-                    gSpotLights[k].cosAngle,
-                    gSpotLights[k].cosFalloffStart,
+                    gSpotLights[spotIndex].color.rgb,
+                    gSpotLights[spotIndex].intensity,
+                    gSpotLights[spotIndex].distance,
+                    gSpotLights[spotIndex].decay,
+                    gSpotLights[spotIndex].cosAngle,
+                    gSpotLights[spotIndex].cosFalloffStart,
                     toEye,
                     gMaterial.color.rgb,
                     textureColor,
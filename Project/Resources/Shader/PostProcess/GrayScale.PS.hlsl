@@ -1,3 +1,5 @@
+#include "PerPixelEffects.hlsli"
+
 Texture2D<float4> gTexture : register(t0);
 SamplerState gSampler : register(s0);
 
@@ -19,11 +21,8 @@ PixelShaderOutput main(PixelShaderInput input)
     // サンプル
     output.color = gTexture.Sample(gSampler, input.texcoord);
 
-    // Rec.709 輝度係数（0.2125, 0.7154, 0.0721）
-    float value = dot(output.color.rgb, float3(0.2125f, 0.7154f, 0.0721f));
-
-    // RGB を同値で上書き（αは維持）
-    output.color.rgb = float3(value, value, value);
+    // RGB を輝度で上書き（αは維持）
+    output.color.rgb = ApplyGrayScale(output.color.rgb);
     
     //output.color.rgb = value * float3(1.0f, 74.0f / 107.0f, 43.0f / 107.0f);
 
@@ -1,3 +1,5 @@
+#include "PerPixelEffects.hlsli"
+
 // テクスチャとサンプラー
 Texture2D gTexture : register(t0);
 SamplerState gSampler : register(s0);
@@ -21,8 +23,7 @@ PSOutput main(PSInput input)
     output.color = gTexture.Sample(gSampler, input.texcoord);
 
     // 色を反転（ネガポジ効果）
-    // RGB各成分を 1.0 から減算することで反転
-    output.color.rgb = 1.0f - output.color.rgb;
+    output.color.rgb = ApplyInvert(output.color.rgb);
     
     // アルファ値はそのまま保持
     // output.color.a はそのまま
@@ -0,0 +1,355 @@
+// ピクセル単位のポストエフェクト（自ピクセルの色だけを読むもの）の共通処理
+// 個別のシェーダーと、複数をまとめて適用する UberColor.PS.hlsl の両方から使う
+
+// ===== パラメータ =====
+
+struct FadeParams
+{
+    float fadeAlpha;        // フェード強度 (0.0 = 透明, 1.0 = 完全フェード)
+    float fadeType;         // フェードタイプ (0:Black, 1:White, 2:Spiral, 3:Ripple, 4:Glitch, 5:Portal)
+    float time;             // 時間パラメータ
+    float spiralPower;      // 渦巻きの強さ
+    float rippleFreq;       // 波紋の周波数
+    float glitchIntensity;  // グリッチの強さ
+    float portalSize;       // ポータルサイズ
+    float colorShift;       // 色相シフト
+    float2 padding;         // パディング
+};
+
+struct ColorGradingParams
+{
+    float hue;                    // 色相調整
+    float saturation;             // 彩度調整
+    float value;                  // 明度調整
+    float contrast;               // コントラスト
+
+    float gamma;                  // ガンマ補正
+    float temperature;            // 色温度
+    float tint;                   // ティント
+    float exposure;               // 露出調整
+
+    float3 shadowLift;            // Shadow Lift (RGB)
+    float3 midtoneGamma;          // Midtone Gamma (RGB)
+    float3 highlightGain;         // Highlight Gain (RGB)
+    float padding;
+};
+
+struct SepiaParams
+{
+    float intensity;      // セピア効果強度
+    float toneRed;        // 赤色調整
+    float toneGreen;      // 緑色調整
+    float toneBlue;       // 青色調整
+};
+
+struct VignetteParams
+{
+    float intensity;      // ヴィネット強度
+    float smoothness;     // 滑らかさ
+    float size;           // サイズ
+    float padding;        // パディング
+};
+
+// ===== 共通関数 =====
+
+// RGB to HSV変換
+float3 RGBtoHSV(float3 rgb)
+{
+    float4 K = float4(0.0, -1.0 / 3.0, 2.0 / 3.0, -1.0);
+    float4 p = lerp(float4(rgb.bg, K.wz), float4(rgb.gb, K.xy), step(rgb.b, rgb.g));
+    float4 q = lerp(float4(p.xyw, rgb.r), float4(rgb.r, p.yzx), step(p.x, rgb.r));
+
+    float d = q.x - min(q.w, q.y);
+    float e = 1.0e-10;
+    return float3(abs(q.z + (q.w - q.y) / (6.0 * d + e)), d / (q.x + e), q.x);
+}
+
+// HSV to RGB変換
+float3 HSVtoRGB(float3 hsv)
+{
+    float4 K = float4(1.0, 2.0 / 3.0, 1.0 / 3.0, 3.0);
+    float3 p = abs(frac(hsv.xxx + K.xyz) * 6.0 - K.www);
+    return hsv.z * lerp(K.xxx, saturate(p - K.xxx), hsv.y);
+}
+
+// ランダム関数
+float random(float2 st)
+{
+    return frac(sin(dot(st.xy, float2(12.9898, 78.233))) * 43758.5453123);
+}
+
+// ノイズ関数
+float noise(float2 st)
+{
+    float2 i = floor(st);
+    float2 f = frac(st);
+
+    float a = random(i);
+    float b = random(i + float2(1.0, 0.0));
+    float c = random(i + float2(0.0, 1.0));
+    float d = random(i + float2(1.0, 1.0));
+
+    float2 u = f * f * (3.0 - 2.0 * f);
+
+    return lerp(a, b, u.x) + (c - a) * u.y * (1.0 - u.x) + (d - b) * u.x * u.y;
+}
+
+// ===== フェード =====
+
+// 渦巻きフェード
+float SpiralFade(float2 uv, float alpha, float power, float t)
+{
+    float2 center = float2(0.5, 0.5);
+    float2 toCenter = uv - center;
+    float dist = length(toCenter);
+    float angle = atan2(toCenter.y, toCenter.x);
+
+    // 渦巻きの計算
+    float spiral = angle + dist * power + t * 2.0;
+    float spiralMask = sin(spiral * 3.14159) * 0.5 + 0.5;
+
+    // 距離に基づくフェード
+    float distanceFade = 1.0 - smoothstep(0.0, 0.7, dist);
+
+    return saturate(spiralMask * alpha + (1.0 - distanceFade) * alpha);
+}
+
+// 波紋フェード
+float RippleFade(float2 uv, float alpha, float freq, float t)
+{
+    float2 center = float2(0.5, 0.5);
+    float dist = length(uv - center);
+
+    // 波紋の計算
+    float ripple = sin(dist * freq - t * 5.0) * 0.5 + 0.5;
+    float rippleMask = smoothstep(0.0, 1.0, ripple);
+
+    // 中心からの距離に基づくフェード
+    float distanceFade = smoothstep(0.0, 1.0, dist);
+
+    return saturate(rippleMask * alpha + distanceFade * alpha);
+}
+
+// グリッチフェード
+float GlitchFade(float2 uv, float alpha, float intensity, float t)
+{
+    // デジタルノイズ
+    float2 noiseUV = uv * 50.0 + t * 10.0;
+    float digitalNoise = step(0.5, noise(noiseUV));
+
+    // 水平ライン
+    float horizontalLine = step(0.99, sin(uv.y * 100.0 + t * 20.0));
+
+    // グリッチマスク
+    float glitchMask = saturate(digitalNoise * intensity + horizontalLine * intensity);
+
+    return saturate(glitchMask * alpha + alpha * 0.3);
+}
+
+// ポータルフェード
+float PortalFade(float2 uv, float alpha, float size, float t)
+{
+    float2 center = float2(0.5, 0.5);
+    float dist = length(uv - center);
+
+    // ポータルの輪郭
+    float portal = smoothstep(size - 0.1, size, dist) - smoothstep(size, size + 0.1, dist);
+
+    // 回転効果
+    float angle = atan2(uv.y - 0.5, uv.x - 0.5) + t * 2.0;
+    float rotation = sin(angle * 4.0) * 0.5 + 0.5;
+
+    // エネルギー効果
+    float energy = sin(dist * 10.0 - t * 8.0) * 0.5 + 0.5;
+
+    float portalMask = portal * rotation * energy;
+    float centerFade = 1.0 - smoothstep(0.0, size, dist);
+
+    return saturate(portalMask * alpha + centerFade * alpha);
+}
+
+// フェードを適用
+// グリッチフェードの色収差は周囲のピクセルを読むため、呼び出し側で originalColor に反映しておくこと
+float3 ApplyFade(float3 originalColor, float2 uv, FadeParams p)
+{
+    float finalAlpha = p.fadeAlpha;
+    float3 fadeColor = float3(0.0, 0.0, 0.0); // デフォルトは黒
+
+    // フェードタイプに応じた処理
+    if (p.fadeType < 0.5) {
+        // 黒フェード
+        fadeColor = float3(0.0, 0.0, 0.0);
+    }
+    else if (p.fadeType < 1.5) {
+        // 白フェード
+        fadeColor = float3(1.0, 1.0, 1.0);
+    }
+    else if (p.fadeType < 2.5) {
+        // 渦巻きフェード
+        finalAlpha = SpiralFade(uv, p.fadeAlpha, p.spiralPower, p.time);
+
+        // 色相シフトを適用
+        float3 hsv = RGBtoHSV(originalColor);
+        hsv.x += p.colorShift;
+        originalColor = HSVtoRGB(hsv);
+
+        fadeColor = float3(0.2, 0.1, 0.4); // 紫っぽい色
+    }
+    else if (p.fadeType < 3.5) {
+        // 波紋フェード
+        finalAlpha = RippleFade(uv, p.fadeAlpha, p.rippleFreq, p.time);
+
+        // 青っぽい神秘的な色
+        fadeColor = float3(0.1, 0.3, 0.6);
+    }
+    else if (p.fadeType < 4.5) {
+        // グリッチフェード
+        finalAlpha = GlitchFade(uv, p.fadeAlpha, p.glitchIntensity, p.time);
+
+        fadeColor = float3(1.0, 0.0, 0.5); // マゼンタ
+    }
+    else {
+        // ポータルフェード
+        finalAlpha = PortalFade(uv, p.fadeAlpha, p.portalSize, p.time);
+
+        // エネルギー的な色
+        fadeColor = float3(0.0, 1.0, 0.8);
+    }
+
+    // フェード強度に基づいて色を補間
+    return lerp(originalColor, fadeColor, finalAlpha);
+}
+
+// ===== カラーグレーディング =====
+
+// 色温度調整関数
+float3 ApplyTemperature(float3 color, float temp, float tintValue)
+{
+    // 色温度調整のための行列
+    float3x3 tempMatrix;
+
+    if (temp > 0.0) // 暖色
+    {
+        tempMatrix = float3x3(
+            1.0 + temp * 0.3, 0.0, 0.0,
+            0.0, 1.0, 0.0,
+            0.0, 0.0, 1.0 - temp * 0.2
+        );
+    }
+    else // 寒色
+    {
+        tempMatrix = float3x3(
+            1.0 + temp * 0.2, 0.0, 0.0,
+            0.0, 1.0, 0.0,
+            0.0, 0.0, 1.0 - temp * 0.3
+        );
+    }
+
+    // ティント調整
+    float3x3 tintMatrix = float3x3(
+        1.0, 0.0, 0.0,
+        tintValue * 0.2, 1.0, 0.0,
+        0.0, tintValue * -0.2, 1.0
+    );
+
+    color = mul(tempMatrix, color);
+    color = mul(tintMatrix, color);
+
+    return color;
+}
+
+// Shadow/Midtone/Highlight調整
+float3 ApplySMH(float3 color, float3 shadowLiftRGB, float3 midtoneGammaRGB, float3 highlightGainRGB)
+{
+    // 輝度計算
+    float luminance = dot(color, float3(0.299, 0.587, 0.114));
+
+    // Shadow, Midtone, Highlightのウェイト計算
+    float shadowWeight = 1.0 - smoothstep(0.0, 0.5, luminance);
+    float highlightWeight = smoothstep(0.5, 1.0, luminance);
+    float midtoneWeight = 1.0 - shadowWeight - highlightWeight;
+
+    // 各調整の適用
+    float3 shadowAdjust = color + shadowLiftRGB * shadowWeight;
+    float3 midtoneAdjust = pow(abs(shadowAdjust), 1.0 / midtoneGammaRGB) * sign(shadowAdjust);
+    float3 highlightAdjust = midtoneAdjust * (highlightGainRGB * highlightWeight + (1.0 - highlightWeight));
+
+    return highlightAdjust;
+}
+
+// カラーグレーディングを適用
+float3 ApplyColorGrading(float3 color, ColorGradingParams p)
+{
+    // 露出調整
+    color *= pow(2.0, p.exposure);
+
+    // 色温度とティント調整
+    color = ApplyTemperature(color, p.temperature, p.tint);
+
+    // HSV調整
+    float3 hsv = RGBtoHSV(color);
+    hsv.x = frac(hsv.x + p.hue); // 色相
+    hsv.y = saturate(hsv.y * p.saturation); // 彩度
+    hsv.z = hsv.z * p.value; // 明度
+    color = HSVtoRGB(hsv);
+
+    // コントラスト調整
+    color = (color - 0.5) * p.contrast + 0.5;
+
+    // ガンマ補正
+    color = pow(abs(color), 1.0 / p.gamma) * sign(color);
+
+    // Shadow/Midtone/Highlight調整
+    color = ApplySMH(color, p.shadowLift, p.midtoneGamma, p.highlightGain);
+
+    // 最終的な色の調整
+    return saturate(color);
+}
+
+// ===== セピア・反転・グレースケール・ヴィネット =====
+
+// セピアを適用
+float3 ApplySepia(float3 color, SepiaParams p)
+{
+    // 元の色をグレースケールに変換（輝度計算）
+    float luminance = dot(color, float3(0.299f, 0.587f, 0.114f));
+
+    // セピア色調の基準となる色（茶色系）
+    float3 sepiaColor = luminance * float3(p.toneRed, p.toneGreen, p.toneBlue);
+
+    // 元の色とセピア色を混合
+    return lerp(color, sepiaColor, p.intensity);
+}
+
+// 色を反転（ネガポジ効果）
+float3 ApplyInvert(float3 color)
+{
+    return 1.0f - color;
+}
+
+// グレースケールに変換（Rec.709 輝度係数）
+float3 ApplyGrayScale(float3 color)
+{
+    float value = dot(color, float3(0.2125f, 0.7154f, 0.0721f));
+    return float3(value, value, value);
+}
+
+// ヴィネットを適用
+float3 ApplyVignette(float3 color, float2 uv, VignetteParams p)
+{
+    // 周囲ほどに、中心ほど明るくなるように計算で調整
+    float2 correct = uv * (1.0f - uv.yx);
+
+    // correctだけで計算すると中心の最大値が0.0625で暗すぎるので調整
+    // この例では指定されたサイズ倍して最大値を1にしている
+    float vignette = correct.x * correct.y * p.size;
+
+    // 滑らかさパラメータを適用
+    vignette = saturate(pow(vignette, p.smoothness));
+
+    // 強度パラメータを適用
+    vignette = lerp(0.0f, vignette, p.intensity);
+
+    // 係数として乗算
+    return color * vignette;
+}
@@ -0,0 +1,66 @@
+// ピクセル単位のポストエフェクトをまとめて適用するシェーダー
+// UBER_* の定義の組み合わせごとにコンパイルされる（組み合わせは UberPermutation が決める）
+// 適用順は Fade -> ColorGrading -> Sepia -> Invert -> GrayScale -> Vignette で固定
+#include "PerPixelEffects.hlsli"
+
+// 入力テクスチャ
+Texture2D<float4> gTexture : register(t0);
+SamplerState gSampler : register(s0);
+
+// 定数バッファ（各エフェクトの定数バッファをそのまま割り当てる）
+#ifdef UBER_FADE
+ConstantBuffer<FadeParams> gFade : register(b0);
+#endif
+#ifdef UBER_COLOR_GRADING
+ConstantBuffer<ColorGradingParams> gColorGrading : register(b1);
+#endif
+#ifdef UBER_SEPIA
+ConstantBuffer<SepiaParams> gSepia : register(b2);
+#endif
+#ifdef UBER_VIGNETTE
+ConstantBuffer<VignetteParams> gVignette : register(b3);
+#endif
+
+// 入力構造体
+struct PixelShaderInput
+{
+    float4 position : SV_POSITION;
+    float2 texcoord : TEXCOORD0;
+};
+
+// 出力構造体
+struct PixelShaderOutput
+{
+    float4 color : SV_Target;
+};
+
+PixelShaderOutput main(PixelShaderInput input)
+{
+    PixelShaderOutput output;
+
+    float2 uv = input.texcoord;
+    output.color = gTexture.Sample(gSampler, uv);
+
+#ifdef UBER_FADE
+    output.color.rgb = ApplyFade(output.color.rgb, uv, gFade);
+    output.color.a = 1.0;
+#endif
+#ifdef UBER_COLOR_GRADING
+    output.color.rgb = ApplyColorGrading(output.color.rgb, gColorGrading);
+    output.color.a = 1.0;
+#endif
+#ifdef UBER_SEPIA
+    output.color.rgb = ApplySepia(output.color.rgb, gSepia);
+#endif
+#ifdef UBER_INVERT
+    output.color.rgb = ApplyInvert(output.color.rgb);
+#endif
+#ifdef UBER_GRAYSCALE
+    output.color.rgb = ApplyGrayScale(output.color.rgb);
+#endif
+#ifdef UBER_VIGNETTE
+    output.color.rgb = ApplyVignette(output.color.rgb, uv, gVignette);
+#endif
+
+    return output;
+}
@@ -1,15 +1,11 @@
+#include "PerPixelEffects.hlsli"
+
 // テクスチャとサンプラー
 Texture2D gTexture : register(t0);
 SamplerState gSampler : register(s0);
 
 // ヴィネットパラメータ用の定数バッファ
-cbuffer VignetteParams : register(b0)
-{
-    float intensity;      // ヴィネット強度
-    float smoothness;     // 滑らかさ
-    float size;           // サイズ
-    float padding;        // パディング
-};
+ConstantBuffer<VignetteParams> gVignette : register(b0);
 
 struct PSInput
 {
@@ -29,21 +25,8 @@ PSOutput main(PSInput input)
     // 入力テクスチャカラー取得
     output.color = gTexture.Sample(gSampler, input.texcoord);
 
-    // 周囲ほどに、中心ほど明るくなるように計算で調整
-    float2 correct = input.texcoord * (1.0f - input.texcoord.yx);
-
-    // correctだけで計算すると中心の最大値が0.0625で暗すぎるので調整
-    // この例では指定されたサイズ倍して最大値を1にしている
-    float vignette = correct.x * correct.y * size;
-
-    // 滑らかさパラメータを適用
-    vignette = saturate(pow(vignette, smoothness));
-
-    // 強度パラメータを適用
-    vignette = lerp(0.0f, vignette, intensity);
-
-    // 係数として乗算
-    output.color.rgb *= vignette;
+    // ヴィネット係数を乗算
+    output.color.rgb = ApplyVignette(output.color.rgb, input.texcoord, gVignette);
 
     return output;
 }
\ No newline at end of file
@@ -1,22 +1,18 @@
 #include "Sprite.hlsli"
 
-cbuffer TransformationMatrix : register(b1)
-{
-    float4x4 WVP;
-    float4x4 World;
-}
-
+// 頂点はSpriteBatchでクリップ空間まで変換済み（UV変換・色も頂点に含まれる）
 struct VertexShaderInput
 {
     float4 position : POSITION0;
     float2 texcoord : TEXCOORD0;
-    float3 normal : NORMAL0;
+    float4 color : COLOR0;
 };
 
 VertexShaderOutput main(VertexShaderInput input)
 {
     VertexShaderOutput output;
-    output.position = mul(input.position, WVP);
+    output.position = input.position;
     output.texcoord = input.texcoord;
+    output.color = input.color;
     return output;
-}
\ No newline at end of file
+}
@@ -2,16 +2,5 @@ struct VertexShaderOutput
 {
     float4 position : SV_POSITION;
     float2 texcoord : TEXCOORD0;
+    float4 color : COLOR0;
 };
-
-struct TransformationMatrix
-{
-    float4x4 WVP;
-    float4x4 World;
-};
-
-struct Material
-{
-    float4 color;
-    float4x4 uvTransform;
-};
\ No newline at end of file
@@ -0,0 +1,356 @@
+// AIの並列フェーズ（AIParallelPhase）の決定性の確認
+// 同じ初期状態から、ワーカー数を変えて数千フレームのシミュレーションを行い、
+// 毎フレームの世界の状態がビット単位で一致することを確かめる（一致しなければ終了コード1）。
+//
+// 1フレームの流れ: 世界の状態をスナップショットにする → 全エージェントを並列に考えさせる →
+// 意図をエージェントの順に1つずつ適用する
+//
+// 使い方: AIDeterminismTest [--agents <数>] [--frames <数>] [--threads <数,数,...>]
+//   --agents <数>   エージェント数（既定: 2000）
+//   --frames <数>   フレーム数（既定: 3000）
+//   --threads <...> 比べるワーカー数（既定: 0,1,2,3,7 とハードウェアのスレッド数-1）
+
+#include "Application/TD2_2/AI/Parallel/AIParallelPhase.h"
+#include "Application/TD2_2/AI/BehaviorTree/BehaviorTree.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    constexpr float kDeltaTime = 1.0f / 60.0f;
+    constexpr float kMaxHp = 100.0f;
+    constexpr uint32_t kNeighborCount = 8; // 近くの敵として調べるエージェント数
+
+    enum SoldierState : uint32_t {
+        kPatrol,
+        kCombat,
+        kRetreat,
+    };
+
+    // ---- 思考（スナップショットを読み、意図を出すだけ）----
+
+    /// @brief 番号の近いエージェントから一番近い敵を探す（見つからなければ UINT32_MAX）
+    uint32_t FindNearestEnemy(const AIThinkContext& context, float range)
+    {
+        const auto& agents = context.world.agents;
+        const uint32_t count = static_cast<uint32_t>(agents.size());
+        uint32_t nearest = UINT32_MAX;
+        float nearestDistance = range * range;
+        for (uint32_t i = 1; i <= kNeighborCount && i < count; ++i) {
+            const uint32_t other = (context.index + i) % count;
+            const AIAgentSnapshot& target = agents[other];
+            if (target.team == context.self.team || target.hp <= 0.0f) {
+                continue;
+            }
+            const float dx = target.position.x - context.self.position.x;
+            const float dz = target.position.z - context.self.position.z;
+            const float distance = dx * dx + dz * dz;
+            if (distance < nearestDistance) {
+                nearestDistance = distance;
+                nearest = other;
+            }
+        }
+        return nearest;
+    }
+
+    Vector3 Toward(const Vector3& from, const Vector3& to, float speed)
+    {
+        const float dx = to.x - from.x;
+        const float dz = to.z - from.z;
+        const float length = std::sqrt(dx * dx + dz * dz);
+        if (length < 1e-4f) {
+            return { 0.0f, 0.0f, 0.0f };
+        }
+        return { dx / length * speed, 0.0f, dz / length * speed };
+    }
+
+    bool IsLowHp(AIThinkContext& context) { return context.self.hp < 30.0f; }
+    bool HasEnemyInRange(AIThinkContext& context) { return FindNearestEnemy(context, 2.0f) != UINT32_MAX; }
+    bool HasEnemyInSight(AIThinkContext& context) { return FindNearestEnemy(context, 15.0f) != UINT32_MAX; }
+
+    NodeState Retreat(AIThinkContext& context, float)
+    {
+        if (context.self.state != kRetreat) {
+            context.intents.ChangeState(kRetreat);
+        }
+        const Vector3 away = Toward(context.world.playerPosition, context.self.position, 3.0f);
+        context.intents.Move(away);
+        return context.self.hp > 60.0f ? NodeState::Success : NodeState::Running;
+    }
+
+    NodeState Strike(AIThinkContext& context, float)
+    {
+        const uint32_t target = FindNearestEnemy(context, 2.0f);
+        if (target == UINT32_MAX) {
+            return NodeState::Failure;
+        }
+        if (context.self.state != kCombat) {
+            context.intents.ChangeState(kCombat);
+        }
+        context.intents.Attack(target, 4.0f + context.RandomFloat(1) * 4.0f);
+        context.intents.Move({ 0.0f, 0.0f, 0.0f });
+        return NodeState::Success;
+    }
+
+    NodeState Approach(AIThinkContext& context, float)
+    {
+        const uint32_t target = FindNearestEnemy(context, 15.0f);
+        if (target == UINT32_MAX) {
+            return NodeState::Failure;
+        }
+        context.intents.Move(Toward(context.self.position, context.world.agents[target].position, 4.0f));
+        return NodeState::Running;
+    }
+
+    NodeState Wander(AIThinkContext& context, float)
+    {
+        if (context.self.state != kPatrol) {
+            context.intents.ChangeState(kPatrol);
+        }
+        const float angle = context.RandomFloat(2) * 6.2831853f;
+        context.intents.Move({ std::cos(angle) * 1.5f, 0.0f, std::sin(angle) * 1.5f });
+        return NodeState::Success;
+    }
+
+    NodeState Regroup(AIThinkContext& context, float)
+    {
+        context.intents.Move(Toward(context.self.position, context.world.playerPosition, 2.0f));
+        return NodeState::Success;
+    }
+
+    /// @brief ツリーを使わない思考（ステートマシンのように状態ごとに振る舞いを変える）
+    void ThinkScout(AIThinkContext& context)
+    {
+        switch (context.self.state) {
+            case kRetreat:
+                Retreat(context, kDeltaTime);
+                break;
+            case kCombat:
+                if (IsLowHp(context)) {
+                    context.intents.ChangeState(kRetreat);
+                } else if (Strike(context, kDeltaTime) == NodeState::Failure) {
+                    context.intents.ChangeState(kPatrol);
+                }
+                break;
+            default:
+                if (HasEnemyInRange(context)) {
+                    context.intents.ChangeState(kCombat);
+                } else {
+                    Wander(context, kDeltaTime);
+                }
+                break;
+        }
+    }
+
+    std::shared_ptr<const CompiledBehaviorTree> BuildSoldierTree()
+    {
+        return BehaviorTreeFactory::CreateCompiled([](BehaviorTreeBuilder& builder) {
+            builder.Selector()
+                .Sequence()
+                .AgentCondition<AIThinkContext>(&IsLowHp)
+                .AgentAction<AIThinkContext>(&Retreat)
+                .End()
+                .Sequence()
+                .AgentCondition<AIThinkContext>(&HasEnemyInRange)
+                .AgentAction<AIThinkContext>(&Strike)
+                .End()
+                .Sequence()
+                .AgentCondition<AIThinkContext>(&HasEnemyInSight)
+                .AgentAction<AIThinkContext>(&Approach)
+                .End()
+                .WeightedSelector()
+                .NextWeight(3.0f)
+                .AgentAction<AIThinkContext>(&Wander)
+                .NextWeight(1.0f)
+                .AgentAction<AIThinkContext>(&Regroup)
+                .End()
+                .End();
+        });
+    }
+
+    // ---- 世界（意図を適用するのはメインスレッドだけ）----
+
+    struct World {
+        uint64_t frame = 0;
+        std::vector<AIAgentSnapshot> agents;
+    };
+
+    World CreateWorld(size_t agentCount)
+    {
+        World world;
+        world.agents.resize(agentCount);
+        for (size_t i = 0; i < agentCount; ++i) {
+            AIAgentSnapshot& agent = world.agents[i];
+            agent.position = { static_cast<float>(i % 64) * 1.3f - 40.0f, 0.0f, static_cast<float>(i / 64) * 1.1f - 20.0f };
+            agent.hp = kMaxHp - static_cast<float>(i % 5) * 10.0f;
+            agent.team = static_cast<uint32_t>(i % 3);
+        }
+        return world;
+    }
+
+    Vector3 PlayerPosition(uint64_t frame)
+    {
+        const float time = static_cast<float>(frame) * kDeltaTime;
+        return { std::cos(time * 0.2f) * 25.0f, 0.0f, std::sin(time * 0.3f) * 15.0f };
+    }
+
+    void ApplyIntents(World& world, const std::vector<AIIntent>& intents)
+    {
+        for (const AIIntent& intent : intents) {
+            AIAgentSnapshot& agent = world.agents[intent.agent];
+            switch (intent.type) {
+                case AIIntentType::Move:
+                    agent.velocity = intent.vector;
+                    break;
+                case AIIntentType::Attack: {
+                    AIAgentSnapshot& target = world.agents[intent.target];
+                    target.hp = (std::max)(target.hp - intent.value, 0.0f);
+                    break;
+                }
+                case AIIntentType::ChangeState:
+                    agent.state = intent.target;
+                    break;
+            }
+        }
+
+        // 移動・回復・倒れたエージェントの復活
+        for (size_t i = 0; i < world.agents.size(); ++i) {
+            AIAgentSnapshot& agent = world.agents[i];
+            agent.position.x += agent.velocity.x * kDeltaTime;
+            agent.position.z += agent.velocity.z * kDeltaTime;
+            if (agent.state == kRetreat) {
+                agent.hp = (std::min)(agent.hp + 20.0f * kDeltaTime, kMaxHp);
+            }
+            if (agent.hp <= 0.0f) {
+                agent.hp = kMaxHp;
+                agent.state = kPatrol;
+                agent.velocity = { 0.0f, 0.0f, 0.0f };
+                agent.position = { static_cast<float>(i % 64) * 1.3f - 40.0f, 0.0f, static_cast<float>(i / 64) * 1.1f - 20.0f };
+            }
+        }
+        ++world.frame;
+    }
+
+    uint64_t HashWorld(const World& world)
+    {
+        uint64_t hash = 1469598103934665603ull;
+        auto mix = [&hash](const void* data, size_t size) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; ++i) {
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+            }
+        };
+        for (const AIAgentSnapshot& agent : world.agents) {
+            mix(&agent.position, sizeof(agent.position));
+            mix(&agent.velocity, sizeof(agent.velocity));
+            mix(&agent.hp, sizeof(agent.hp));
+            mix(&agent.state, sizeof(agent.state));
+        }
+        return hash;
+    }
+
+    struct RunResult {
+        std::vector<uint64_t> frameHashes;
+        double thinkSeconds = 0.0;
+        size_t intentCount = 0;
+    };
+
+    RunResult Run(size_t agentCount, uint32_t frameCount, uint32_t workerCount, const std::shared_ptr<const CompiledBehaviorTree>& tree)
+    {
+        AIParallelPhase phase;
+        phase.Initialize(workerCount);
+        for (uint32_t i = 0; i < agentCount; ++i) {
+            // 4体に1体はツリーを使わない思考
+            if (i % 4 == 3) {
+                phase.AddAgent(&ThinkScout);
+            } else {
+                phase.AddAgent(tree, i + 1);
+            }
+        }
+
+        World world = CreateWorld(agentCount);
+        AIWorldSnapshot snapshot;
+        std::vector<AIIntent> intents;
+        RunResult result;
+        result.frameHashes.reserve(frameCount);
+        for (uint32_t frame = 0; frame < frameCount; ++frame) {
+            snapshot.frame = world.frame;
+            snapshot.deltaTime = kDeltaTime;
+            snapshot.playerPosition = PlayerPosition(world.frame);
+            snapshot.agents = world.agents;
+
+            const auto start = std::chrono::steady_clock::now();
+            phase.Think(snapshot, intents);
+            result.thinkSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            result.intentCount += intents.size();
+
+            ApplyIntents(world, intents);
+            result.frameHashes.push_back(HashWorld(world));
+        }
+        return result;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    size_t agentCount = 2000;
+    uint32_t frameCount = 3000;
+    const uint32_t hardwareWorkers = (std::max)(std::thread::hardware_concurrency(), 1u) - 1;
+    std::vector<uint32_t> workerCounts = { 0, 1, 2, 3, 7, hardwareWorkers };
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--agents") == 0 && i + 1 < argc) {
+            agentCount = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frameCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            workerCounts.clear();
+            for (char* text = argv[++i]; *text != '\0';) {
+                char* next = nullptr;
+                workerCounts.push_back(static_cast<uint32_t>(std::strtoul(text, &next, 10)));
+                text = *next == ',' ? next + 1 : next;
+            }
+        } else {
+            std::printf("usage: AIDeterminismTest [--agents <n>] [--frames <n>] [--threads <n,n,...>]\n");
+            return 1;
+        }
+    }
+    std::sort(workerCounts.begin(), workerCounts.end());
+    workerCounts.erase(std::unique(workerCounts.begin(), workerCounts.end()), workerCounts.end());
+
+    const auto tree = BuildSoldierTree();
+    std::printf("agents %zu, frames %u\n", agentCount, frameCount);
+
+    RunResult reference;
+    bool isDeterministic = true;
+    for (size_t run = 0; run < workerCounts.size(); ++run) {
+        RunResult result = Run(agentCount, frameCount, workerCounts[run], tree);
+        const double milliseconds = result.thinkSeconds * 1000.0 / frameCount;
+        if (run == 0) {
+            reference = std::move(result);
+            std::printf("workers %2u: think %.3f ms/frame, intents %zu, final hash %016llx (reference)\n",
+                workerCounts[run], milliseconds, reference.intentCount,
+                static_cast<unsigned long long>(reference.frameHashes.empty() ? 0 : reference.frameHashes.back()));
+            continue;
+        }
+
+        // 最初に食い違ったフレームを探す
+        const auto mismatch = std::mismatch(reference.frameHashes.begin(), reference.frameHashes.end(), result.frameHashes.begin());
+        if (mismatch.first != reference.frameHashes.end()) {
+            isDeterministic = false;
+            std::printf("workers %2u: MISMATCH at frame %zu\n",
+                workerCounts[run], static_cast<size_t>(mismatch.first - reference.frameHashes.begin()));
+        } else {
+            std::printf("workers %2u: think %.3f ms/frame, identical over %u frames\n", workerCounts[run], milliseconds, frameCount);
+        }
+    }
+
+    std::printf("%s\n", isDeterministic ? "deterministic" : "NOT deterministic");
+    return isDeterministic ? 0 : 1;
+}
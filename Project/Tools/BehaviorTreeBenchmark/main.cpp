@@ -0,0 +1,611 @@
+// ビヘイビアツリーの実行速度の比較
+// 同じ構造のツリーを、エージェントごとに組んだポインタのツリー（BehaviorTree）と、
+// 全エージェントで共有するコンパイル済みのツリー（BehaviorTreeAgentGroup）で実行し、1秒あたりのTick数を比べる。
+// 両者の結果（エージェントの状態）が一致することも確かめる。
+//
+// 続けて、ほとんどの時間を待機して過ごす見張りを、毎フレーム条件を調べるツリーと、
+// ブラックボードの変更でだけ起きるツリー（ObserveBlackboard・WaitForEvent）で実行して比べる。
+//
+// 最後に、64個の行動から重み付きで1つ選ぶ判断を 1000 体が毎フレーム行い、以前の選び方
+// （判断のたびに重みの配列を確保し、すべての評価関数を呼んで線形に探す）と WeightedRandomSelectorNode
+// （固定の重みは評価せず、ブラックボードに依存する重みは変わったときだけ評価し、エイリアス表で選ぶ）を比べる。
+//
+// おまけとして、同じ 1000 体×64個の行動の重みを、距離・HP割合の Evaluator（仮想呼び出しと std::function）で
+// 1つずつ求める場合と、同じ曲線を UtilityScorer で SoA の入力からまとめて求める場合も比べる。
+//
+// 実際のゲームでは描画などの処理の間にキャッシュが入れ替わるので、既定ではフレームごとに
+// 大きなバッファを書き換えてから Tick する（--warm でキャッシュに載ったままの速度も測れる）。
+//
+// 使い方: BehaviorTreeBenchmark [--agents <数>] [--frames <数>] [--warm]
+//   --agents <数>  エージェント数（既定: 500）
+//   --frames <数>  フレーム数（既定: 600）
+//   --warm         フレーム間でキャッシュを追い出さない
+
+#include "Application/TD2_2/AI/BehaviorTree/BehaviorTree.h"
+#include "Application/TD2_2/AI/Scoring/UtilityScoring.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+    constexpr float kDeltaTime = 1.0f / 60.0f; // WaitNode と同じ固定の時間
+
+    /// @brief 雑魚敵
+    struct Minion {
+        float x = 0.0f;
+        float z = 0.0f;
+        float homeX = 0.0f;
+        float patrolDirection = 1.0f;
+        float hp = 100.0f;
+        float attackTimer = 0.0f;
+        uint32_t attackCount = 0;
+        uint32_t chaseFrames = 0;
+        uint32_t patrolFrames = 0;
+        uint32_t fleeFrames = 0;
+    };
+
+    // 全エージェント共通の状態
+    float gTargetX = 0.0f;
+    float gTargetZ = 0.0f;
+    bool gIsAlarm = false;
+
+    float DistanceToTarget(const Minion& minion)
+    {
+        const float dx = gTargetX - minion.x;
+        const float dz = gTargetZ - minion.z;
+        return std::sqrt(dx * dx + dz * dz);
+    }
+
+    bool IsLowHp(Minion& minion) { return minion.hp < 20.0f; }
+    bool IsInAttackRange(Minion& minion) { return DistanceToTarget(minion) < 1.5f; }
+    bool CanSeeTarget(Minion& minion) { return DistanceToTarget(minion) < 12.0f; }
+    bool IsAlarm() { return gIsAlarm; }
+
+    NodeState Flee(Minion& minion, float deltaTime)
+    {
+        minion.hp += 30.0f * deltaTime;
+        ++minion.fleeFrames;
+        return minion.hp > 50.0f ? NodeState::Success : NodeState::Running;
+    }
+
+    NodeState Attack(Minion& minion, float deltaTime)
+    {
+        minion.attackTimer += deltaTime;
+        if (minion.attackTimer < 0.3f) {
+            return NodeState::Running;
+        }
+        minion.attackTimer = 0.0f;
+        minion.hp -= 7.0f;
+        ++minion.attackCount;
+        return NodeState::Success;
+    }
+
+    NodeState Chase(Minion& minion, float deltaTime)
+    {
+        const float distance = DistanceToTarget(minion);
+        if (distance < 1.5f) {
+            return NodeState::Success;
+        }
+        const float step = 4.0f * deltaTime / distance;
+        minion.x += (gTargetX - minion.x) * step;
+        minion.z += (gTargetZ - minion.z) * step;
+        ++minion.chaseFrames;
+        return distance > 12.0f ? NodeState::Failure : NodeState::Running;
+    }
+
+    NodeState Patrol(Minion& minion, float deltaTime)
+    {
+        minion.x += minion.patrolDirection * 2.0f * deltaTime;
+        ++minion.patrolFrames;
+        if (std::abs(minion.x - minion.homeX) > 3.0f) {
+            minion.patrolDirection = -minion.patrolDirection;
+            return NodeState::Success;
+        }
+        return NodeState::Running;
+    }
+
+    /// @brief ツリーを組む（葉の追加方法だけを切り替える）
+    /// @details 逃走 → 攻撃 → 追跡 → 巡回 の優先順。Inverter・Parallel・Wait・Repeater も通す。
+    template<typename AddCondition, typename AddAction>
+    void BuildMinionTree(BehaviorTreeBuilder& builder, AddCondition addCondition, AddAction addAction)
+    {
+        builder.Selector()
+            .Sequence();
+        addCondition(builder, &IsLowHp);
+        builder.Condition([] { return !IsAlarm(); });
+        addAction(builder, &Flee);
+        builder.End()
+            .Sequence();
+        addCondition(builder, &IsInAttackRange);
+        builder.Repeater(2)
+            .Sequence();
+        addAction(builder, &Attack);
+        builder.End()
+            .End()
+            .End()
+            .Sequence()
+            .Inverter()
+            .Sequence();
+        addCondition(builder, &IsLowHp);
+        builder.End()
+            .End();
+        addCondition(builder, &CanSeeTarget);
+        addAction(builder, &Chase);
+        builder.End()
+            .Parallel(ParallelPolicy::SuccessWhenAllSucceed);
+        addAction(builder, &Patrol);
+        builder.Wait(0.5f)
+            .End();
+    }
+
+    void InitializeMinions(std::vector<Minion>& minions)
+    {
+        for (size_t i = 0; i < minions.size(); ++i) {
+            Minion& minion = minions[i];
+            minion = Minion{};
+            minion.x = static_cast<float>(i % 50) * 1.7f - 40.0f;
+            minion.z = static_cast<float>(i / 50) * 1.9f - 10.0f;
+            minion.homeX = minion.x;
+            minion.hp = 20.0f + static_cast<float>(i % 7) * 12.0f;
+        }
+    }
+
+    void UpdateWorld(uint32_t frame)
+    {
+        const float time = static_cast<float>(frame) * kDeltaTime;
+        gTargetX = std::cos(time * 0.3f) * 30.0f;
+        gTargetZ = std::sin(time * 0.7f) * 8.0f;
+        gIsAlarm = (frame / 240) % 2 == 1;
+    }
+
+    /// @brief 見張り（警報を受けたときだけ持ち場へ向かう）
+    struct Sentry {
+        bool isAlerted = false; // ポーリング版が見る値（ブラックボード版は Blackboard に持つ）
+        float travel = 0.0f;
+        uint32_t responseCount = 0;
+    };
+
+    bool IsSentryAlerted(Sentry& sentry) { return sentry.isAlerted; }
+    bool IsAlerted(const bool& isAlerted) { return isAlerted; }
+
+    NodeState Respond(Sentry& sentry, float deltaTime)
+    {
+        sentry.travel += deltaTime;
+        if (sentry.travel < 0.5f) {
+            return NodeState::Running;
+        }
+        sentry.travel = 0.0f;
+        ++sentry.responseCount;
+        return NodeState::Success;
+    }
+
+    // Running を返すとセレクターが待機から再開し、警報を調べなくなるので毎回終える
+    NodeState Idle(Sentry&, float) { return NodeState::Success; }
+
+    /// @brief 警報を受けている見張りを決める（約1%、45フレームごとに入れ替わる）
+    bool IsAlertedAt(size_t index, uint32_t frame)
+    {
+        uint32_t x = static_cast<uint32_t>(index) * 0x9E3779B1u ^ (frame / 45) * 0x85EBCA77u;
+        x ^= x >> 15;
+        x *= 0x2C1B3C6Du;
+        x ^= x >> 12;
+        return x % 100 == 0;
+    }
+
+    /// @brief フレームごとに警報の状態が変わる見張り（ゲームではイベントとして届く）
+    std::vector<std::vector<uint32_t>> MakeAlertEvents(size_t agentCount, uint32_t frameCount)
+    {
+        std::vector<std::vector<uint32_t>> events(frameCount);
+        for (uint32_t frame = 0; frame < frameCount; ++frame) {
+            for (uint32_t i = 0; i < agentCount; ++i) {
+                const bool isAlerted = IsAlertedAt(i, frame);
+                if (frame == 0 ? isAlerted : isAlerted != IsAlertedAt(i, frame - 1)) {
+                    events[frame].push_back(i);
+                }
+            }
+        }
+        return events;
+    }
+
+    constexpr size_t kUtilityAgentCount = 1000;
+    constexpr uint32_t kUtilityActionCount = 64;
+
+    /// @brief 行動の重みが見るブラックボード
+    struct UtilityKeys {
+        BlackboardKey<float> distance;
+        BlackboardKey<float> hpRatio;
+    };
+
+    /// @brief 行動の重みの元になる値（約2%のエージェントが毎フレーム変わる）
+    float UtilityDistanceAt(size_t index, uint32_t frame) { return static_cast<float>((index * 7 + (frame + index) / 50) % 20); }
+    float UtilityHpRatioAt(size_t index, uint32_t frame) { return 1.0f - static_cast<float>(((frame + index * 3) / 60) % 10) * 0.1f; }
+    float UtilityAggressionAt(size_t index, uint32_t frame) { return 1.0f + static_cast<float>(((frame + index) / 30) % 3); }
+
+    /// @brief 行動 action の重みの評価関数
+    /// @details 4つに1つは固定、8つに1つはエージェントの値を毎回読み、残りはブラックボードだけを読む。
+    /// @param watchedKeys 評価関数が読むブラックボードのキー（固定・毎回読む重みでは 0）
+    std::unique_ptr<IEvaluator> MakeUtilityEvaluator(uint32_t action, const Blackboard* blackboard, const UtilityKeys& keys,
+        const float* aggression, uint64_t& watchedKeys)
+    {
+        const float bias = static_cast<float>(action % 5) * 0.25f;
+        watchedKeys = 0;
+        if (action % 4 == 0) {
+            return nullptr;
+        }
+        if (action % 8 == 7) {
+            return std::make_unique<LambdaEvaluator>([aggression, bias] { return *aggression * 0.5f + bias; });
+        }
+        if (action % 2 == 1) {
+            watchedKeys = uint64_t{ 1 } << keys.distance.index;
+            return std::make_unique<LambdaEvaluator>([blackboard, keys, bias] {
+                return std::max(0.0f, 1.0f - blackboard->Get(keys.distance) / 20.0f) + bias;
+            });
+        }
+        watchedKeys = uint64_t{ 1 } << keys.hpRatio.index;
+        return std::make_unique<LambdaEvaluator>([blackboard, keys, bias] { return blackboard->Get(keys.hpRatio) * 2.0f + bias; });
+    }
+
+    float UtilityStaticWeight(uint32_t action) { return 0.5f + static_cast<float>(action % 5) * 0.25f; }
+
+    /// @brief 以前の WeightedRandomSelectorNode の選び方
+    struct LinearWeightedSelector {
+        std::vector<std::unique_ptr<IEvaluator>> evaluators;
+
+        uint32_t Select(std::mt19937& rng) const
+        {
+            std::vector<float> weights;
+            weights.reserve(evaluators.size());
+            for (auto& evaluator : evaluators) {
+                weights.push_back(std::max(0.0f, evaluator->Evaluate()));
+            }
+            const float totalWeight = std::accumulate(weights.begin(), weights.end(), 0.0f);
+            std::uniform_real_distribution<float> dist(0.0f, totalWeight);
+            const float r = dist(rng);
+            float cumulative = 0.0f;
+            for (size_t i = 0; i < weights.size(); ++i) {
+                cumulative += weights[i];
+                if (r <= cumulative) {
+                    return static_cast<uint32_t>(i);
+                }
+            }
+            return static_cast<uint32_t>(weights.size() - 1);
+        }
+    };
+
+    /// @brief 採点の入力（フレームごとに全員が動く）
+    float ScoringDistanceAt(size_t index, uint32_t frame) { return static_cast<float>((index * 13 + frame * 7) % 400) * 0.05f; }
+    float ScoringHpRatioAt(size_t index, uint32_t frame) { return static_cast<float>((index * 5 + frame) % 101) * 0.01f; }
+
+    /// @brief 行動 action の距離・HP割合の曲線（行動ごとに範囲を変える）
+    ScoreCurve MakeScoringDistanceCurve(uint32_t action, uint32_t input)
+    {
+        const float minDistance = static_cast<float>(action % 8);
+        return ScoreCurve::MakeDistance(input, 1.0f, 0.1f * static_cast<float>(action % 3), minDistance, minDistance + 4.0f + static_cast<float>(action % 5));
+    }
+    ScoreCurve MakeScoringHpCurve(uint32_t action, uint32_t input)
+    {
+        return ScoreCurve::MakeHpRatio(input, 0.2f + 0.1f * static_cast<float>(action % 4), 1.0f, 0.05f * static_cast<float>(action % 6), 0.9f);
+    }
+
+    /// @brief フレームの他の処理の代わりにキャッシュを追い出す
+    void EvictCache(std::vector<uint8_t>& buffer)
+    {
+        for (size_t i = 0; i < buffer.size(); i += 64) {
+            ++buffer[i];
+        }
+    }
+
+    /// @brief フレームごとの Tick の時間の合計（キャッシュの追い出しは含めない）
+    template<typename TickFunc>
+    double MeasureSeconds(uint32_t frameCount, bool isWarm, TickFunc tick)
+    {
+        std::vector<uint8_t> evictBuffer(isWarm ? 0 : 64u * 1024u * 1024u);
+        double seconds = 0.0;
+        for (uint32_t frame = 0; frame < frameCount; ++frame) {
+            UpdateWorld(frame);
+            EvictCache(evictBuffer);
+            const auto start = std::chrono::steady_clock::now();
+            tick();
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        return seconds;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    size_t agentCount = 500;
+    uint32_t frameCount = 600;
+    bool isWarm = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--agents") == 0 && i + 1 < argc) {
+            agentCount = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frameCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--warm") == 0) {
+            isWarm = true;
+        } else {
+            std::printf("usage: BehaviorTreeBenchmark [--agents <n>] [--frames <n>] [--warm]\n");
+            return 1;
+        }
+    }
+
+    // ポインタのツリー（エージェントごとにノードを持つ）
+    std::vector<Minion> pointerMinions(agentCount);
+    InitializeMinions(pointerMinions);
+    std::vector<std::unique_ptr<BehaviorTree>> pointerTrees;
+    pointerTrees.reserve(agentCount);
+    for (Minion& minion : pointerMinions) {
+        Minion* agent = &minion;
+        pointerTrees.push_back(BehaviorTreeFactory::Create([agent](BehaviorTreeBuilder& builder) {
+            BuildMinionTree(builder,
+                [agent](BehaviorTreeBuilder& b, bool (*condition)(Minion&)) { b.Condition([agent, condition] { return condition(*agent); }); },
+                [agent](BehaviorTreeBuilder& b, NodeState (*action)(Minion&, float)) {
+                    b.Action<ActionNode>([agent, action] { return action(*agent, kDeltaTime); });
+                });
+        }));
+    }
+
+    // コンパイル済みのツリー（全エージェントで1つ）
+    std::vector<Minion> compiledMinions(agentCount);
+    InitializeMinions(compiledMinions);
+    auto compiled = BehaviorTreeFactory::CreateCompiled([](BehaviorTreeBuilder& builder) {
+        BuildMinionTree(builder,
+            [](BehaviorTreeBuilder& b, bool (*condition)(Minion&)) { b.AgentCondition<Minion>(condition); },
+            [](BehaviorTreeBuilder& b, NodeState (*action)(Minion&, float)) { b.AgentAction<Minion>(action); });
+    });
+    BehaviorTreeAgentGroup<Minion> group(compiled);
+    for (Minion& minion : compiledMinions) {
+        group.Add(&minion);
+    }
+
+    const double pointerSeconds = MeasureSeconds(frameCount, isWarm, [&] {
+        for (auto& tree : pointerTrees) {
+            tree->Tick();
+        }
+    });
+    const double compiledSeconds = MeasureSeconds(frameCount, isWarm, [&] { group.Tick(kDeltaTime); });
+
+    // 同じ順に同じ葉が呼ばれていれば、状態はビット単位で一致する
+    size_t mismatchCount = 0;
+    uint64_t attackTotal = 0;
+    for (size_t i = 0; i < agentCount; ++i) {
+        const Minion& a = pointerMinions[i];
+        const Minion& b = compiledMinions[i];
+        if (a.x != b.x || a.z != b.z || a.hp != b.hp || a.attackCount != b.attackCount || a.chaseFrames != b.chaseFrames ||
+            a.patrolFrames != b.patrolFrames || a.fleeFrames != b.fleeFrames) {
+            ++mismatchCount;
+        }
+        attackTotal += a.attackCount;
+    }
+
+    const double totalTicks = static_cast<double>(agentCount) * frameCount;
+    std::printf("agents %zu, frames %u, %s cache, tree nodes %u, state %zu bytes/agent\n",
+        agentCount, frameCount, isWarm ? "warm" : "cold", compiled->GetNodeCount(), compiled->GetStateSize() * sizeof(uint32_t));
+    std::printf("pointer tree : %10.0f ticks/s (%.3f ms/frame)\n", totalTicks / pointerSeconds, pointerSeconds * 1000.0 / frameCount);
+    std::printf("compiled tree: %10.0f ticks/s (%.3f ms/frame)\n", totalTicks / compiledSeconds, compiledSeconds * 1000.0 / frameCount);
+    std::printf("speedup %.2fx, attacks %llu, mismatched agents %zu\n",
+        pointerSeconds / compiledSeconds, static_cast<unsigned long long>(attackTotal), mismatchCount);
+
+    // 見張り: 毎フレーム条件を調べる版と、ブラックボードの変更で起きる版
+    std::vector<Sentry> pollingSentries(agentCount);
+    auto pollingTree = BehaviorTreeFactory::CreateCompiled([](BehaviorTreeBuilder& builder) {
+        builder.Selector()
+            .Sequence()
+            .AgentCondition<Sentry>(&IsSentryAlerted)
+            .AgentAction<Sentry>(&Respond)
+            .End()
+            .AgentAction<Sentry>(&Idle)
+            .End();
+    });
+    BehaviorTreeAgentGroup<Sentry> pollingGroup(pollingTree);
+    for (Sentry& sentry : pollingSentries) {
+        pollingGroup.Add(&sentry);
+    }
+
+    auto layout = std::make_shared<BlackboardLayout>();
+    const BlackboardKey<bool> alertKey = layout->Add<bool>("IsAlerted", false);
+    std::vector<Sentry> reactiveSentries(agentCount);
+    std::vector<Blackboard> blackboards(agentCount, Blackboard(layout));
+    auto reactiveTree = BehaviorTreeFactory::CreateCompiled([&](BehaviorTreeBuilder& builder) {
+        builder.Selector()
+            .ObserveBlackboard(alertKey, &IsAlerted, ObserverAbort::LowerPriority)
+            .AgentAction<Sentry>(&Respond)
+            .End()
+            .WaitForEvent()
+            .End();
+    });
+    BehaviorTreeAgentGroup<Sentry> reactiveGroup(reactiveTree);
+    for (size_t i = 0; i < agentCount; ++i) {
+        reactiveGroup.Add(&reactiveSentries[i], &blackboards[i]);
+    }
+
+    // 警報の変化はどちらも同じイベントの列から反映する
+    const std::vector<std::vector<uint32_t>> alertEvents = MakeAlertEvents(agentCount, frameCount);
+    uint32_t pollingFrame = 0;
+    const double pollingSeconds = MeasureSeconds(frameCount, isWarm, [&] {
+        for (uint32_t index : alertEvents[pollingFrame]) {
+            pollingSentries[index].isAlerted = !pollingSentries[index].isAlerted;
+        }
+        pollingGroup.Tick(kDeltaTime);
+        ++pollingFrame;
+    });
+    uint32_t reactiveFrame = 0;
+    const double reactiveSeconds = MeasureSeconds(frameCount, isWarm, [&] {
+        for (uint32_t index : alertEvents[reactiveFrame]) {
+            blackboards[index].Set(alertKey, !blackboards[index].Get(alertKey));
+        }
+        reactiveGroup.Tick(kDeltaTime);
+        ++reactiveFrame;
+    });
+
+    // 警報への応じ方は同じなので、応じた回数も一致する
+    uint64_t responseTotal = 0;
+    size_t sentryMismatchCount = 0;
+    size_t sleepingCount = 0;
+    for (uint32_t i = 0; i < agentCount; ++i) {
+        responseTotal += pollingSentries[i].responseCount;
+        if (pollingSentries[i].responseCount != reactiveSentries[i].responseCount || pollingSentries[i].travel != reactiveSentries[i].travel) {
+            ++sentryMismatchCount;
+        }
+        sleepingCount += reactiveGroup.IsSleeping(i) ? 1 : 0;
+    }
+    std::printf("sentry polling : %10.0f ticks/s (%.3f ms/frame)\n", totalTicks / pollingSeconds, pollingSeconds * 1000.0 / frameCount);
+    std::printf("sentry reactive: %10.0f ticks/s (%.3f ms/frame), sleeping at end %zu/%zu\n",
+        totalTicks / reactiveSeconds, reactiveSeconds * 1000.0 / frameCount, sleepingCount, agentCount);
+    std::printf("speedup %.2fx, responses %llu, mismatched sentries %zu\n",
+        pollingSeconds / reactiveSeconds, static_cast<unsigned long long>(responseTotal), sentryMismatchCount);
+
+    // 重み付きの行動選択: 以前の選び方と WeightedRandomSelectorNode
+    auto utilityLayout = std::make_shared<BlackboardLayout>();
+    UtilityKeys utilityKeys;
+    utilityKeys.distance = utilityLayout->Add<float>("Distance", 0.0f);
+    utilityKeys.hpRatio = utilityLayout->Add<float>("HpRatio", 1.0f);
+    std::vector<Blackboard> utilityBlackboards(kUtilityAgentCount, Blackboard(utilityLayout));
+    std::vector<float> aggressions(kUtilityAgentCount, 1.0f);
+
+    std::vector<LinearWeightedSelector> linearSelectors(kUtilityAgentCount);
+    std::vector<std::unique_ptr<WeightedRandomSelectorNode>> aliasSelectors(kUtilityAgentCount);
+    std::vector<uint64_t> linearCounts(kUtilityActionCount, 0);
+    std::vector<uint64_t> aliasCounts(kUtilityActionCount, 0);
+    for (size_t i = 0; i < kUtilityAgentCount; ++i) {
+        aliasSelectors[i] = std::make_unique<WeightedRandomSelectorNode>();
+        aliasSelectors[i]->SetBlackboard(&utilityBlackboards[i]);
+        for (uint32_t action = 0; action < kUtilityActionCount; ++action) {
+            uint64_t watchedKeys = 0;
+            auto linearEvaluator = MakeUtilityEvaluator(action, &utilityBlackboards[i], utilityKeys, &aggressions[i], watchedKeys);
+            if (!linearEvaluator) {
+                const float weight = UtilityStaticWeight(action);
+                linearEvaluator = std::make_unique<LambdaEvaluator>([weight] { return weight; });
+            }
+            linearSelectors[i].evaluators.push_back(std::move(linearEvaluator));
+
+            uint64_t* count = &aliasCounts[action];
+            auto leaf = std::make_unique<ActionNode>([count] { ++*count; return NodeState::Success; });
+            auto aliasEvaluator = MakeUtilityEvaluator(action, &utilityBlackboards[i], utilityKeys, &aggressions[i], watchedKeys);
+            if (!aliasEvaluator) {
+                aliasSelectors[i]->AddChild(std::move(leaf), UtilityStaticWeight(action));
+            } else {
+                aliasSelectors[i]->AddChild(std::move(leaf), std::move(aliasEvaluator), watchedKeys);
+            }
+        }
+    }
+
+    // どちらも同じフレームに同じ値を書く（同じ値の Set は変更にならない）
+    auto updateUtilityInputs = [&](uint32_t frame) {
+        for (size_t i = 0; i < kUtilityAgentCount; ++i) {
+            utilityBlackboards[i].Set(utilityKeys.distance, UtilityDistanceAt(i, frame));
+            utilityBlackboards[i].Set(utilityKeys.hpRatio, UtilityHpRatioAt(i, frame));
+            aggressions[i] = UtilityAggressionAt(i, frame);
+        }
+    };
+
+    std::mt19937 linearRng(1);
+    uint32_t linearFrame = 0;
+    const double linearSeconds = MeasureSeconds(frameCount, isWarm, [&] {
+        updateUtilityInputs(linearFrame++);
+        for (const LinearWeightedSelector& selector : linearSelectors) {
+            ++linearCounts[selector.Select(linearRng)];
+        }
+    });
+    uint32_t aliasFrame = 0;
+    const double aliasSeconds = MeasureSeconds(frameCount, isWarm, [&] {
+        updateUtilityInputs(aliasFrame++);
+        for (auto& selector : aliasSelectors) {
+            selector->Tick();
+        }
+    });
+
+    // 乱数の使い方が違うので一致はしないが、行動ごとの選ばれた割合はほぼ同じになる
+    const double decisionTotal = static_cast<double>(kUtilityAgentCount) * frameCount;
+    double maxShareDifference = 0.0;
+    for (uint32_t action = 0; action < kUtilityActionCount; ++action) {
+        const double difference = std::abs(static_cast<double>(linearCounts[action]) - static_cast<double>(aliasCounts[action])) / decisionTotal;
+        maxShareDifference = std::max(maxShareDifference, difference);
+    }
+    std::printf("utility linear: %10.0f decisions/s (%.3f ms/frame), %u actions, %zu agents\n",
+        decisionTotal / linearSeconds, linearSeconds * 1000.0 / frameCount, kUtilityActionCount, kUtilityAgentCount);
+    std::printf("utility alias : %10.0f decisions/s (%.3f ms/frame)\n", decisionTotal / aliasSeconds, aliasSeconds * 1000.0 / frameCount);
+    std::printf("speedup %.2fx, max difference of action share %.4f%%\n", linearSeconds / aliasSeconds, maxShareDifference * 100.0);
+
+    // 曲線の採点: 1つずつの Evaluator と、SoA の入力からまとめて計算する UtilityScorer
+    std::vector<float> scoringDistances(kUtilityAgentCount);
+    std::vector<float> scoringHpRatios(kUtilityAgentCount);
+    struct EvaluatorPair {
+        std::unique_ptr<IEvaluator> distance;
+        std::unique_ptr<IEvaluator> hpRatio;
+    };
+    std::vector<EvaluatorPair> scoringEvaluators;
+    scoringEvaluators.reserve(kUtilityAgentCount * kUtilityActionCount);
+    for (size_t i = 0; i < kUtilityAgentCount; ++i) {
+        const float* distance = &scoringDistances[i];
+        const float* hpRatio = &scoringHpRatios[i];
+        for (uint32_t action = 0; action < kUtilityActionCount; ++action) {
+            const ScoreCurve distanceCurve = MakeScoringDistanceCurve(action, 0);
+            const ScoreCurve hpCurve = MakeScoringHpCurve(action, 0);
+            scoringEvaluators.push_back({
+                std::make_unique<DistanceEvaluator>(distanceCurve.outputMin, distanceCurve.outputMax, [distance] { return *distance; },
+                    distanceCurve.inputMin, distanceCurve.inputMax),
+                std::make_unique<HpRatioEvaluator>(hpCurve.outputMin, hpCurve.outputMax, [hpRatio] { return *hpRatio; },
+                    hpCurve.inputMin, hpCurve.inputMax) });
+        }
+    }
+    std::vector<float> evaluatorScores(kUtilityAgentCount * kUtilityActionCount);
+
+    ScoreInputTable scoringInputs;
+    const uint32_t distanceColumn = scoringInputs.AddColumn("Distance");
+    const uint32_t hpRatioColumn = scoringInputs.AddColumn("HpRatio");
+    scoringInputs.Resize(kUtilityAgentCount);
+    UtilityScorer scorer;
+    for (uint32_t action = 0; action < kUtilityActionCount; ++action) {
+        scorer.AddOption({ { MakeScoringDistanceCurve(action, distanceColumn), MakeScoringHpCurve(action, hpRatioColumn) } });
+    }
+
+    auto updateScoringInputs = [&](uint32_t frame) {
+        for (size_t i = 0; i < kUtilityAgentCount; ++i) {
+            scoringDistances[i] = ScoringDistanceAt(i, frame);
+            scoringHpRatios[i] = ScoringHpRatioAt(i, frame);
+        }
+    };
+
+    uint32_t evaluatorFrame = 0;
+    const double evaluatorSeconds = MeasureSeconds(frameCount, isWarm, [&] {
+        updateScoringInputs(evaluatorFrame++);
+        for (size_t pair = 0; pair < scoringEvaluators.size(); ++pair) {
+            evaluatorScores[pair] = scoringEvaluators[pair].distance->Evaluate() * scoringEvaluators[pair].hpRatio->Evaluate();
+        }
+    });
+    uint32_t scorerFrame = 0;
+    const double scorerSeconds = MeasureSeconds(frameCount, isWarm, [&] {
+        updateScoringInputs(scorerFrame++);
+        std::memcpy(scoringInputs.GetColumn(distanceColumn), scoringDistances.data(), kUtilityAgentCount * sizeof(float));
+        std::memcpy(scoringInputs.GetColumn(hpRatioColumn), scoringHpRatios.data(), kUtilityAgentCount * sizeof(float));
+        scorer.Score(scoringInputs);
+    });
+
+    // 最後のフレームの値は同じ曲線なので一致する
+    size_t scoreMismatchCount = 0;
+    for (size_t i = 0; i < kUtilityAgentCount; ++i) {
+        for (uint32_t action = 0; action < kUtilityActionCount; ++action) {
+            if (evaluatorScores[i * kUtilityActionCount + action] != scorer.GetScore(action, i)) {
+                ++scoreMismatchCount;
+            }
+        }
+    }
+    const double pairTotal = static_cast<double>(kUtilityAgentCount) * kUtilityActionCount * frameCount;
+    std::printf("scoring evaluators: %10.0f pairs/s (%.3f ms/frame), %zu pairs/frame\n",
+        pairTotal / evaluatorSeconds, evaluatorSeconds * 1000.0 / frameCount, scoringEvaluators.size());
+    std::printf("scoring batch     : %10.0f pairs/s (%.3f ms/frame)\n", pairTotal / scorerSeconds, scorerSeconds * 1000.0 / frameCount);
+    std::printf("speedup %.2fx, mismatched scores %zu\n", evaluatorSeconds / scorerSeconds, scoreMismatchCount);
+
+    return mismatchCount == 0 && sentryMismatchCount == 0 && scoreMismatchCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,255 @@
+// ディスクリプタの割り当て（DescriptorAllocator / TransientDescriptorAllocator）の確認
+// 割り当て・即時解放・解放待ち・フレームの完了・解放済みの割り当ての再解放をランダムに繰り返し、
+// 位置ごとの状態（空き・使用中・解放待ち）を別に持って次を確かめる（1つでも失敗すれば終了コード1）。
+//   - 重なり: 割り当てた範囲は管理範囲の中で、使用中・解放待ちの位置と重ならない
+//   - 先頭から最初に入る空き範囲を使う
+//   - 結合: 空き範囲の数は、使用を始めた範囲の中の空きの連続の数と同じ（隣り合う空き範囲が残らない）
+//   - 古い割り当て: 解放済みのものは IsAlive が false で、Free・Retire しても何もしない
+//   - 統計: 割り当て中・解放待ちの数が一致する。全部解放すると空き範囲は1つに戻る
+// あわせて割り当て・解放の速度を測る。
+//
+// 使い方: DescriptorAllocatorTest [--steps <数>] [--seed <数>]
+//   --steps <数>  ランダムな操作の回数（既定: 400000）
+//   --seed <数>   乱数の種（既定: 7）
+
+#include "Engine/Graphics/Common/Core/DescriptorAllocator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    constexpr uint32_t kFirstIndex = 1;     // ImGui などが先頭を使う場合と同じくずらす
+    constexpr uint32_t kCapacity = 5000;
+    constexpr uint32_t kPageSize = 64;
+    constexpr uint32_t kFrameCount = 2;
+    constexpr uint32_t kCheckInterval = 500; // 重い確認（結合・全件の生存）をする間隔
+
+    enum class Slot : uint8_t { Free, Live, Retired };
+
+    uint32_t failureCount = 0;
+
+    void Check(bool condition, const char* description, uint32_t step)
+    {
+        if (!condition) {
+            // 同じ失敗が続いても出力が埋まらないように最初の数件だけ出す
+            if (failureCount < 10) {
+                std::printf("FAILED at step %u: %s\n", step, description);
+            }
+            ++failureCount;
+        }
+    }
+
+    /// @brief 位置ごとの状態（管理範囲内の位置で引く）
+    struct Shadow {
+        std::vector<Slot> slots = std::vector<Slot>(kCapacity, Slot::Free);
+
+        void Set(const DescriptorAllocation& allocation, Slot slot)
+        {
+            std::fill_n(slots.begin() + (allocation.index - kFirstIndex), allocation.count, slot);
+        }
+
+        /// @brief [0, committed) で count 個入る最初の空きの連続（無ければ UINT32_MAX）
+        uint32_t FirstFit(uint32_t count, uint32_t committed) const
+        {
+            uint32_t run = 0;
+            for (uint32_t i = 0; i < committed; ++i) {
+                run = slots[i] == Slot::Free ? run + 1 : 0;
+                if (run == count) {
+                    return i + 1 - count;
+                }
+            }
+            return UINT32_MAX;
+        }
+
+        /// @brief [0, committed) の空きの連続の数
+        uint32_t CountFreeRuns(uint32_t committed) const
+        {
+            uint32_t runs = 0;
+            for (uint32_t i = 0; i < committed; ++i) {
+                runs += (slots[i] == Slot::Free && (i == 0 || slots[i - 1] != Slot::Free)) ? 1 : 0;
+            }
+            return runs;
+        }
+
+        uint32_t Count(Slot slot) const
+        {
+            return static_cast<uint32_t>(std::count(slots.begin(), slots.end(), slot));
+        }
+    };
+
+    void RunRandomized(uint32_t steps, uint32_t seed)
+    {
+        DescriptorAllocator allocator;
+        allocator.Initialize(kFirstIndex, kCapacity, kPageSize, kFrameCount);
+
+        Shadow shadow;
+        std::vector<DescriptorAllocation> live;
+        std::vector<DescriptorAllocation> dead;
+        std::vector<DescriptorAllocation> retired[kFrameCount];
+        uint32_t frame = 0;
+        uint32_t allocateFailures = 0;
+        uint32_t staleAttempts = 0;
+
+        std::mt19937 random(seed);
+        for (uint32_t step = 0; step < steps; ++step) {
+            const uint32_t operation = random() % 10;
+            if (operation < 5) {
+                // 割り当て（4回に1回は複数個）
+                const uint32_t count = (random() % 4 == 0) ? 1 + random() % 16 : 1;
+                const uint32_t committed = allocator.GetStatistics().committedCount;
+                const uint32_t expected = (step % 16 == 0) ? shadow.FirstFit(count, committed) : UINT32_MAX;
+                const DescriptorAllocation allocation = allocator.Allocate(count);
+                if (!allocation.IsValid()) {
+                    ++allocateFailures;
+                    Check(allocator.GetLargestFreeRange() < count, "allocation failed although a range was free", step);
+                    continue;
+                }
+                Check(allocation.count == count, "allocation count", step);
+                const bool isInside = allocation.index >= kFirstIndex && allocation.index + count <= kFirstIndex + kCapacity;
+                Check(isInside, "allocation outside the managed range", step);
+                if (!isInside) {
+                    continue;
+                }
+                const uint32_t begin = allocation.index - kFirstIndex;
+                Check(std::all_of(shadow.slots.begin() + begin, shadow.slots.begin() + begin + count,
+                    [](Slot slot) { return slot == Slot::Free; }), "allocation overlaps a live or retired range", step);
+                Check(expected == UINT32_MAX || begin == expected, "allocation is not first-fit", step);
+                Check(allocator.IsAlive(allocation), "new allocation is not alive", step);
+                shadow.Set(allocation, Slot::Live);
+                live.push_back(allocation);
+            } else if (operation < 8 && !live.empty()) {
+                // 即時解放か解放待ち
+                const size_t k = random() % live.size();
+                const DescriptorAllocation allocation = live[k];
+                live[k] = live.back();
+                live.pop_back();
+                if (random() % 2 == 0) {
+                    Check(allocator.Free(allocation), "Free of a live allocation failed", step);
+                    shadow.Set(allocation, Slot::Free);
+                } else {
+                    Check(allocator.Retire(allocation, frame), "Retire of a live allocation failed", step);
+                    shadow.Set(allocation, Slot::Retired);
+                    retired[frame].push_back(allocation);
+                }
+                Check(!allocator.IsAlive(allocation), "allocation is alive after Free/Retire", step);
+                dead.push_back(allocation);
+            } else if (operation == 8) {
+                // 次のフレームへ（そのフレームの解放待ちは GPU が終わったとして空きに戻す）
+                frame = (frame + 1) % kFrameCount;
+                allocator.ReleaseRetired(frame);
+                for (const DescriptorAllocation& allocation : retired[frame]) {
+                    shadow.Set(allocation, Slot::Free);
+                }
+                retired[frame].clear();
+            } else if (!dead.empty()) {
+                // 解放済みの割り当ては、同じ場所が割り当て直されていても受け付けない
+                const DescriptorAllocation allocation = dead[random() % dead.size()];
+                Check(!allocator.IsAlive(allocation), "stale allocation is alive", step);
+                Check(!allocator.Free(allocation), "stale allocation was freed", step);
+                Check(!allocator.Retire(allocation, frame), "stale allocation was retired", step);
+                staleAttempts += 2;
+            }
+
+            if (step % kCheckInterval == 0 || step + 1 == steps) {
+                const DescriptorAllocator::Statistics statistics = allocator.GetStatistics();
+                Check(statistics.freeRangeCount == shadow.CountFreeRuns(statistics.committedCount), "free ranges are not coalesced", step);
+                Check(statistics.allocatedCount == kCapacity - shadow.Count(Slot::Free), "allocated count", step);
+                Check(statistics.retiredCount == shadow.Count(Slot::Retired), "retired count", step);
+                Check(statistics.allocationCount == live.size(), "allocation count (retired ones are not counted)", step);
+                Check(statistics.staleFreeCount == staleAttempts, "stale free count", step);
+                Check(std::all_of(live.begin(), live.end(), [&](const DescriptorAllocation& a) { return allocator.IsAlive(a); }),
+                    "live allocation is not alive", step);
+            }
+        }
+
+        // 全部解放すると1つの空き範囲に戻る
+        for (const DescriptorAllocation& allocation : live) {
+            allocator.Free(allocation);
+        }
+        for (uint32_t i = 0; i < kFrameCount; ++i) {
+            allocator.ReleaseRetired(i);
+        }
+        const DescriptorAllocator::Statistics statistics = allocator.GetStatistics();
+        Check(statistics.allocatedCount == 0 && statistics.retiredCount == 0 && statistics.allocationCount == 0, "counts after freeing all", steps);
+        Check(statistics.freeRangeCount == 1, "free ranges after freeing all", steps);
+        Check(allocator.GetLargestFreeRange() == kCapacity, "largest free range after freeing all", steps);
+
+        std::printf("randomized: %u steps, committed %u, peak %u, allocate failures %u, stale attempts %u\n",
+            steps, statistics.committedCount, statistics.peakAllocatedCount, allocateFailures, staleAttempts);
+    }
+
+    void RunTransient()
+    {
+        TransientDescriptorAllocator allocator;
+        allocator.Initialize(100, 10, 2);
+        allocator.BeginFrame(1);
+        Check(allocator.Allocate(4) == 110, "transient allocation starts at the frame's region", 0);
+        Check(allocator.Allocate(6) == 114, "transient allocations are consecutive", 0);
+        Check(allocator.Allocate(1) == DescriptorAllocation::kInvalidIndex, "transient allocation fails when full", 0);
+        Check(allocator.Allocate(0) == DescriptorAllocation::kInvalidIndex, "transient allocation of 0 fails", 0);
+        allocator.BeginFrame(0);
+        Check(allocator.Allocate(1) == 100, "BeginFrame rewinds the frame's region", 0);
+        Check(allocator.GetPeakUsedCount() == 10, "transient peak", 0);
+    }
+
+    void RunTiming()
+    {
+        constexpr uint32_t kRounds = 20;
+        constexpr uint32_t kCount = 30000;
+        DescriptorAllocator allocator;
+        allocator.Initialize(0, 65536, 256, kFrameCount);
+        std::vector<DescriptorAllocation> allocations;
+        allocations.reserve(kCount);
+
+        const Clock::time_point start = Clock::now();
+        for (uint32_t round = 0; round < kRounds; ++round) {
+            for (uint32_t i = 0; i < kCount; ++i) {
+                allocations.push_back(allocator.Allocate());
+            }
+            // 割り当てと逆順でない順番で解放する（結合が前後両方に起こる）
+            for (size_t i = 0; i < allocations.size(); i += 2) {
+                allocator.Free(allocations[i]);
+            }
+            for (size_t i = 1; i < allocations.size(); i += 2) {
+                allocator.Free(allocations[i]);
+            }
+            allocations.clear();
+        }
+        const double milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        std::printf("timing: %u allocations + frees in %.1f ms (%.1f ns each)\n",
+            kRounds * kCount, milliseconds, milliseconds * 1.0e6 / (kRounds * kCount));
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t steps = 400000;
+    uint32_t seed = 7;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--steps") == 0 && i + 1 < argc) {
+            steps = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::printf("usage: DescriptorAllocatorTest [--steps <n>] [--seed <n>]\n");
+            return 1;
+        }
+    }
+
+    RunRandomized(steps, seed);
+    RunTransient();
+    RunTiming();
+
+    std::printf("%s (%u failures)\n", failureCount == 0 ? "passed" : "FAILED", failureCount);
+    return failureCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,216 @@
+// ライトのクラスター分割（LightClusterBinning）の確認と計測
+// LightManager と同じ分割（16 × 9 × 24）と最大数（ポイントライト512・スポットライト256）で、
+// 傾けたカメラの前にライトをばらまいて振り分け、次を確かめる（1つでも失敗すれば終了コード1）。
+//   - 取りこぼし: 視錐台の中の点をたくさん選び、その点を照らすライト（全ライトを調べて求める）が
+//     点の属するクラスター（シェーダーと同じ FindCluster）に入っているか
+//   - 無効なライトはどのクラスターにも入らない
+//   - 各クラスターの中はライト番号順、インデックス数は統計と一致し、容量不足で捨てたものが無い
+// あわせて Bin 1回あたりの時間を測る。
+// SIMD版とスカラー版は LIGHT_CLUSTER_BINNING_NO_SIMD の有無で別の実行ファイルになる。
+//
+// 使い方: LightClusterBinningTest [--points <数>] [--spots <数>] [--samples <数>] [--repeat <数>]
+//   --points <数>   ポイントライト数（既定: 512）
+//   --spots <数>    スポットライト数（既定: 256）
+//   --samples <数>  取りこぼしを調べる点の数（既定: 200000）
+//   --repeat <数>   時間を測る Bin の回数（既定: 200）
+
+#include "Engine/Graphics/Light/LightClusterBinning.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    constexpr uint32_t kTileCountX = 16;
+    constexpr uint32_t kTileCountY = 9;
+    constexpr uint32_t kSliceCount = 24;
+    constexpr uint32_t kAverageLightsPerCluster = 32;
+    constexpr uint32_t kDisabledInterval = 16;   // この数ごとに1つ無効なライトを混ぜる
+
+#ifdef LIGHT_CLUSTER_BINNING_NO_SIMD
+    constexpr const char* kPathName = "scalar";
+#else
+    constexpr const char* kPathName = "SIMD";
+#endif
+
+    double ElapsedMilliseconds(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    float DistanceSquared(const Vector3& a, const Vector3& b)
+    {
+        const Vector3 diff = { a.x - b.x, a.y - b.y, a.z - b.z };
+        return diff.x * diff.x + diff.y * diff.y + diff.z * diff.z;
+    }
+
+    bool IsLit(const PointLightData& light, const Vector3& position)
+    {
+        return light.enabled && DistanceSquared(light.position, position) < light.radius * light.radius;
+    }
+
+    bool IsLit(const SpotLightData& light, const Vector3& position)
+    {
+        const Vector3 diff = { position.x - light.position.x, position.y - light.position.y, position.z - light.position.z };
+        const float distance = std::sqrt(diff.x * diff.x + diff.y * diff.y + diff.z * diff.z);
+        if (!light.enabled || distance >= light.distance || distance <= 0.0f) {
+            return false;
+        }
+        const Vector3& d = light.direction;
+        const float length = std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z);
+        return (diff.x * d.x + diff.y * d.y + diff.z * d.z) / (distance * length) > light.cosAngle;
+    }
+
+    bool Contains(const std::vector<uint32_t>& indices, uint32_t first, uint32_t count, uint32_t light)
+    {
+        return std::find(indices.begin() + first, indices.begin() + first + count, light) != indices.begin() + first + count;
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t pointCount = 512;
+    uint32_t spotCount = 256;
+    uint32_t sampleCount = 200000;
+    uint32_t repeat = 200;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--points") == 0 && i + 1 < argc) {
+            pointCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--spots") == 0 && i + 1 < argc) {
+            spotCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            sampleCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = (std::max)(1u, static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10)));
+        } else {
+            std::printf("usage: LightClusterBinningTest [--points <n>] [--spots <n>] [--samples <n>] [--repeat <n>]\n");
+            return 1;
+        }
+    }
+
+    // 少し見下ろして横を向いたカメラ
+    const Matrix4x4 camera = MathCore::Matrix::MakeAffine(
+        Vector3{ 1.0f, 1.0f, 1.0f }, Vector3{ 0.25f, 0.4f, 0.0f }, Vector3{ -10.0f, 12.0f, -30.0f });
+    const Matrix4x4 projection = MathCore::Rendering::PerspectiveFov(0.45f, 16.0f / 9.0f, 0.1f, 100.0f);
+    LightClusterView view;
+    if (!LightClusterView::FromMatrices(MathCore::Matrix::Inverse(camera), projection, 0.0f, view)) {
+        std::printf("FromMatrices failed\n");
+        return 1;
+    }
+
+    // ライトはカメラから見える範囲のまわりにばらまく（ビュー空間で決めてワールドに戻す）
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> depth(10.0f, 90.0f);
+    auto randomWorldPosition = [&]() {
+        const float z = depth(random);
+        const Vector3 viewPosition = { unit(random) * z / view.projScaleX * 1.2f, unit(random) * z / view.projScaleY * 1.2f, z };
+        return MathCore::CoordinateTransform::TransformCoord(viewPosition, camera);
+    };
+
+    std::vector<PointLightData> points(pointCount);
+    for (uint32_t i = 0; i < pointCount; ++i) {
+        PointLightData& light = points[i];
+        light = {};
+        light.position = randomWorldPosition();
+        light.radius = 1.0f + std::abs(unit(random)) * 5.0f;
+        light.enabled = (i % kDisabledInterval) != kDisabledInterval - 1;
+    }
+    std::vector<SpotLightData> spots(spotCount);
+    for (uint32_t i = 0; i < spotCount; ++i) {
+        SpotLightData& light = spots[i];
+        light = {};
+        light.position = randomWorldPosition();
+        // 向きは正規化しない（Bin の側で正規化する）
+        light.direction = { unit(random), unit(random), unit(random) + 0.01f };
+        light.distance = 3.0f + std::abs(unit(random)) * 7.0f;
+        light.cosAngle = 0.1f + std::abs(unit(random)) * 0.85f;
+        light.cosFalloffStart = 1.0f;
+        light.enabled = (i % kDisabledInterval) != kDisabledInterval - 1;
+    }
+
+    LightClusterBinning binning;
+    binning.Initialize(kTileCountX, kTileCountY, kSliceCount, kTileCountX * kTileCountY * kSliceCount * kAverageLightsPerCluster);
+    binning.Bin(view, points.data(), pointCount, spots.data(), spotCount);
+
+    const LightClusterBinning::Statistics& statistics = binning.GetStatistics();
+    const std::vector<LightClusterRange>& ranges = binning.GetRanges();
+    const std::vector<uint32_t>& indices = binning.GetIndices();
+    bool isConsistent = statistics.droppedIndexCount == 0;
+
+    // インデックスの数・並び・無効なライト
+    uint32_t listedCount = 0;
+    uint32_t badListCount = 0;
+    for (const LightClusterRange& range : ranges) {
+        const uint32_t pointListed = range.lightCount & 0xFFFF;
+        const uint32_t spotListed = range.lightCount >> 16;
+        for (uint32_t k = 0; k < pointListed + spotListed; ++k) {
+            const uint32_t light = indices[range.offset + k];
+            const bool isPoint = k < pointListed;
+            const bool isEnabled = isPoint ? (light < pointCount && points[light].enabled) : (light < spotCount && spots[light].enabled);
+            const bool isOrdered = k == 0 || k == pointListed || indices[range.offset + k - 1] < light;
+            badListCount += (isEnabled && isOrdered) ? 0 : 1;
+        }
+        listedCount += pointListed + spotListed;
+    }
+    isConsistent = isConsistent && badListCount == 0 && listedCount == statistics.indexCount;
+
+    // 取りこぼし（近くほど多く調べる）
+    uint64_t litCount = 0;
+    uint64_t missedCount = 0;
+    uint32_t insideCount = 0;
+    std::uniform_real_distribution<float> zero2one(0.0f, 1.0f);
+    for (uint32_t s = 0; s < sampleCount; ++s) {
+        const float t = zero2one(random);
+        const float z = view.nearZ + t * t * (view.farZ - view.nearZ);
+        const Vector3 viewPosition = { unit(random) * z / view.projScaleX, unit(random) * z / view.projScaleY, z };
+        const uint32_t cluster = binning.FindCluster(view, viewPosition);
+        if (cluster == UINT32_MAX) {
+            continue;
+        }
+        ++insideCount;
+        const Vector3 worldPosition = MathCore::CoordinateTransform::TransformCoord(viewPosition, camera);
+        const LightClusterRange& range = ranges[cluster];
+        const uint32_t pointListed = range.lightCount & 0xFFFF;
+        const uint32_t spotListed = range.lightCount >> 16;
+        for (uint32_t i = 0; i < pointCount; ++i) {
+            if (IsLit(points[i], worldPosition)) {
+                ++litCount;
+                missedCount += Contains(indices, range.offset, pointListed, i) ? 0 : 1;
+            }
+        }
+        for (uint32_t i = 0; i < spotCount; ++i) {
+            if (IsLit(spots[i], worldPosition)) {
+                ++litCount;
+                missedCount += Contains(indices, range.offset + pointListed, spotListed, i) ? 0 : 1;
+            }
+        }
+    }
+    isConsistent = isConsistent && missedCount == 0 && litCount > 0;
+
+    // 時間
+    const Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < repeat; ++i) {
+        binning.Bin(view, points.data(), pointCount, spots.data(), spotCount);
+    }
+    const double binMilliseconds = ElapsedMilliseconds(start) / repeat;
+
+    std::printf("%s: %u point lights, %u spot lights, %u clusters\n", kPathName, pointCount, spotCount, binning.GetClusterCount());
+    std::printf("  bin      %8.3f ms\n", binMilliseconds);
+    std::printf("  indices  %u (dropped %u), occupied clusters %u, max per cluster %u, bad entries %u\n",
+        statistics.indexCount, statistics.droppedIndexCount, statistics.occupiedClusterCount, statistics.maxLightsPerCluster, badListCount);
+    std::printf("  samples  %u inside, %llu lit (point, light) pairs, missed %llu\n",
+        insideCount, static_cast<unsigned long long>(litCount), static_cast<unsigned long long>(missedCount));
+    std::printf("%s\n", isConsistent ? "consistent" : "NOT consistent");
+    return isConsistent ? 0 : 1;
+}
@@ -0,0 +1,180 @@
+// モデルの事前最適化ツール
+// 実行時と同じキー・同じ処理でキャッシュ（<出力先>/<キー>.model）を作るので、
+// 変換済みのモデルは初回読み込み時の頂点の結合・三角形の並べ替えが不要になる。
+//
+// 使い方: ModelCooker [オプション] <ファイルまたはディレクトリ>...
+//   -o <ディレクトリ>  出力先（既定: Cache/Model、Project ディレクトリから実行する想定）
+//   --cache-size <数>  想定する頂点キャッシュのサイズ（既定: 16）
+//   --no-weld         頂点を結合しない
+//   --no-reorder      三角形を並べ替えない（重ね描きの並べ替えも行わない）
+//   --no-overdraw     重ね描きの並べ替えを行わない
+//   --lods <数>       LODの数（LOD0を含む、既定: 4、1ならLODを作らない）
+//   --force           キャッシュがあっても作り直す
+//
+// 実行時の設定（既定値）と異なるオプションで作ったキャッシュは、キーが違うので実行時には使われない。
+
+#include "Engine/Graphics/Model/ModelLoader.h"
+#include "Engine/Graphics/Texture/TextureCooker.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+    void PrintUsage()
+    {
+        std::printf(
+            "usage: ModelCooker [options] <file or directory>...\n"
+            "  -o <dir>            output cache directory (default: Cache/Model)\n"
+            "  --cache-size <n>    vertex cache size to optimize for (default: 16)\n"
+            "  --no-weld           do not weld identical vertices\n"
+            "  --no-reorder        do not reorder triangles for the vertex cache\n"
+            "  --no-overdraw       do not reorder clusters for overdraw\n"
+            "  --lods <n>          number of LODs including LOD0 (default: 4, 1 disables)\n"
+            "  --force             cook even if the cache file exists\n");
+    }
+
+    bool IsModelFile(const std::filesystem::path& path)
+    {
+        std::string extension = path.extension().string();
+        for (char& c : extension) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return extension == ".obj" || extension == ".gltf" || extension == ".glb" || extension == ".fbx";
+    }
+
+    /// @brief 入力を変換対象のファイル一覧にする（ディレクトリは再帰的にモデルファイルを探す）
+    void CollectInputs(const std::filesystem::path& input, std::vector<std::filesystem::path>& outFiles)
+    {
+        std::error_code ec;
+        if (!std::filesystem::is_directory(input, ec)) {
+            outFiles.push_back(input);
+            return;
+        }
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(input, ec)) {
+            if (entry.is_regular_file() && IsModelFile(entry.path())) {
+                outFiles.push_back(entry.path());
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::filesystem::path cacheDirectory = "Cache/Model";
+    MeshOptimizeSettings settings;
+    bool force = false;
+    std::vector<std::filesystem::path> files;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "-o") == 0 && i + 1 < argc) {
+            cacheDirectory = argv[++i];
+        } else if (std::strcmp(arg, "--cache-size") == 0 && i + 1 < argc) {
+            int cacheSize = std::atoi(argv[++i]);
+            if (cacheSize < 3) {
+                std::fprintf(stderr, "invalid cache size: %s\n", argv[i]);
+                return 2;
+            }
+            settings.cacheSize = static_cast<uint32_t>(cacheSize);
+        } else if (std::strcmp(arg, "--no-weld") == 0) {
+            settings.weldVertices = false;
+        } else if (std::strcmp(arg, "--no-reorder") == 0) {
+            settings.optimizeVertexCache = false;
+            settings.optimizeOverdraw = false;
+        } else if (std::strcmp(arg, "--no-overdraw") == 0) {
+            settings.optimizeOverdraw = false;
+        } else if (std::strcmp(arg, "--lods") == 0 && i + 1 < argc) {
+            int lodCount = std::atoi(argv[++i]);
+            if (lodCount < 1) {
+                std::fprintf(stderr, "invalid LOD count: %s\n", argv[i]);
+                return 2;
+            }
+            settings.lodCount = static_cast<uint32_t>(lodCount);
+        } else if (std::strcmp(arg, "--force") == 0) {
+            force = true;
+        } else if (arg[0] == '-') {
+            PrintUsage();
+            return 2;
+        } else {
+            CollectInputs(arg, files);
+        }
+    }
+
+    if (files.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    uint32_t cookedCount = 0;
+    uint32_t cachedCount = 0;
+    uint32_t failedCount = 0;
+    uint64_t sourceVertices = 0;
+    uint64_t cookedVertices = 0;
+    uint64_t sourceBytes = 0;
+    uint64_t cookedBytes = 0;
+
+    for (const std::filesystem::path& file : files) {
+        std::vector<uint8_t> source;
+        if (!TextureCooker::ReadFile(file, source)) {
+            std::fprintf(stderr, "failed  %s: cannot read\n", file.string().c_str());
+            ++failedCount;
+            continue;
+        }
+
+        const uint64_t key = ModelCooker::ComputeKey(source.data(), source.size(), settings);
+        const std::filesystem::path cachePath = ModelCooker::GetCachePath(cacheDirectory, key);
+        std::error_code ec;
+        if (std::filesystem::exists(cachePath, ec)) {
+            if (!force) {
+                std::printf("cached  %s -> %s\n", file.string().c_str(), cachePath.filename().string().c_str());
+                ++cachedCount;
+                continue;
+            }
+            std::filesystem::remove(cachePath, ec);
+        }
+
+        // 実行時と同じ関数で読み込み・最適化・保存する
+        auto start = std::chrono::steady_clock::now();
+        ModelCookResult result;
+        ModelLoader::LoadOptimizedModelFile(file.parent_path().generic_string(), file.filename().string(),
+            cacheDirectory, settings, &result);
+        double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (!result.written) {
+            std::fprintf(stderr, "failed  %s: cannot write %s\n", file.string().c_str(), cachePath.string().c_str());
+            ++failedCount;
+            continue;
+        }
+
+        const MeshOptimizeStatistics& stats = result.statistics;
+        std::string lodIndices;
+        for (uint32_t count : stats.lodIndexCounts) {
+            lodIndices += (lodIndices.empty() ? "" : "/") + std::to_string(count);
+        }
+        std::printf("cooked  %s -> %s (vertices %u -> %u, %llu -> %llu bytes, ACMR %.2f -> %.2f, %u clusters, %s indices, LOD indices %s, %.1f ms)\n",
+            file.string().c_str(), cachePath.filename().string().c_str(),
+            stats.sourceVertexCount, stats.vertexCount,
+            static_cast<unsigned long long>(stats.sourceBytes), static_cast<unsigned long long>(stats.optimizedBytes),
+            stats.sourceAcmr, stats.acmr, stats.clusterCount, stats.use16BitIndices ? "16bit" : "32bit",
+            lodIndices.c_str(), milliseconds);
+        ++cookedCount;
+        sourceVertices += stats.sourceVertexCount;
+        cookedVertices += stats.vertexCount;
+        sourceBytes += stats.sourceBytes;
+        cookedBytes += stats.optimizedBytes;
+    }
+
+    std::printf("%u cooked, %u cached, %u failed", cookedCount, cachedCount, failedCount);
+    if (cookedCount > 0) {
+        std::printf(" (vertices %llu -> %llu, %.2f MB -> %.2f MB)",
+            static_cast<unsigned long long>(sourceVertices), static_cast<unsigned long long>(cookedVertices),
+            sourceBytes / 1048576.0, cookedBytes / 1048576.0);
+    }
+    std::printf("\n");
+    return failedCount > 0 ? 1 : 0;
+}
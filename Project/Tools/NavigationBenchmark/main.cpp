@@ -0,0 +1,316 @@
+// フローフィールド（FlowField）の速度の計測
+// グリッドの大きさごとに、障害物を散らしたアリーナで次を測る。
+//   - 構築: 中央の目標への場を最初から作る（ワーカー数ごと。比較用に1スレッドの Dijkstra（8近傍）も測る）
+//   - 差分更新: 障害物を1つずつ毎フレーム1セル動かし、ApplyGridChanges で反映する
+//   - 参照: 多数のエージェントが自分の位置の向きを読む
+// あわせて、ワーカー数を変えた結果がビット単位で一致すること、差分更新の結果が最初から作り直した結果と
+// 丸め誤差の範囲で一致することを確かめる（一致しなければ終了コード1）。
+//
+// 使い方: NavigationBenchmark [--sizes <数,数,...>] [--threads <数,数,...>] [--frames <数>]
+//   --sizes <...>   グリッドの一辺のセル数（既定: 64,128,256,512）
+//   --threads <...> 比べるワーカー数（既定: 0,1,3 とハードウェアのスレッド数-1）
+//   --frames <数>   差分更新のフレーム数（既定: 60）
+
+#include "Application/TD2_2/AI/Navigation/FlowField.h"
+#include "Engine/Utility/Job/JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    constexpr uint32_t kAgentCount = 100000; // 参照の計測のエージェント数
+    constexpr float kObstacleRadius = 3.0f;  // 動かす障害物の半径（セル）
+
+    double ElapsedMilliseconds(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    std::vector<uint32_t> ParseList(char* text)
+    {
+        std::vector<uint32_t> values;
+        while (*text != '\0') {
+            char* next = nullptr;
+            values.push_back(static_cast<uint32_t>(std::strtoul(text, &next, 10)));
+            text = *next == ',' ? next + 1 : next;
+        }
+        return values;
+    }
+
+    /// @brief 障害物
+    struct Obstacle {
+        Vector2 center;
+        std::vector<uint32_t> cells;
+    };
+
+    /// @brief アリーナを作る（壁数本と、散らばった岩。セルの一辺は 1）
+    void BuildArena(NavigationGrid& grid, uint32_t size, std::vector<Obstacle>& outMovers)
+    {
+        grid.Initialize({ 0.0f, 0.0f }, { static_cast<float>(size), static_cast<float>(size) }, 1.0f);
+        std::mt19937 random(size);
+        std::uniform_real_distribution<float> position(0.0f, static_cast<float>(size));
+
+        // 中央を囲む、隙間のある壁
+        const float center = size * 0.5f;
+        const float half = size * 0.3f;
+        const float thickness = (std::max)(1.0f, size / 64.0f);
+        const float gap = size * 0.08f;
+        std::vector<uint32_t> cells;
+        grid.CollectBoxCells({ center - half, center + half - thickness }, { center + half, center + half }, cells);
+        grid.CollectBoxCells({ center - half, center - half }, { center - gap, center - half + thickness }, cells);
+        grid.CollectBoxCells({ center + gap, center - half }, { center + half, center - half + thickness }, cells);
+        grid.CollectBoxCells({ center - half, center - half }, { center - half + thickness, center + half }, cells);
+        grid.AddBlocker(cells);
+
+        // 岩（面積の1割ほど）
+        const uint32_t rockCount = size * size / 200;
+        for (uint32_t i = 0; i < rockCount; ++i) {
+            cells.clear();
+            grid.CollectCircleCells({ position(random), position(random) }, 1.0f + (random() % 3), cells);
+            grid.AddBlocker(cells);
+        }
+
+        // 動かす障害物
+        outMovers.clear();
+        for (uint32_t i = 0; i < 4; ++i) {
+            Obstacle obstacle;
+            obstacle.center = { position(random), position(random) };
+            grid.CollectCircleCells(obstacle.center, kObstacleRadius, obstacle.cells);
+            grid.AddBlocker(obstacle.cells);
+            outMovers.push_back(std::move(obstacle));
+        }
+        grid.ClearChangedCells();
+    }
+
+    /// @brief 比較用の 8近傍 Dijkstra（1スレッド）
+    double RunDijkstra(const NavigationGrid& grid, uint32_t target, std::vector<float>& distances)
+    {
+        const Clock::time_point start = Clock::now();
+        const int width = static_cast<int>(grid.GetWidth());
+        const int height = static_cast<int>(grid.GetHeight());
+        distances.assign(grid.GetCellCount(), FlowField::kUnreachable);
+
+        using Entry = std::pair<float, uint32_t>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+        distances[target] = 0.0f;
+        open.push({ 0.0f, target });
+        while (!open.empty()) {
+            const auto [distance, index] = open.top();
+            open.pop();
+            if (distance > distances[index]) {
+                continue;
+            }
+            const int x = static_cast<int>(grid.GetX(index));
+            const int y = static_cast<int>(grid.GetY(index));
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    const int nx = x + dx;
+                    const int ny = y + dy;
+                    if ((dx == 0 && dy == 0) || nx < 0 || ny < 0 || nx >= width || ny >= height) {
+                        continue;
+                    }
+                    const uint32_t neighbor = grid.GetIndex(static_cast<uint32_t>(nx), static_cast<uint32_t>(ny));
+                    if (grid.IsBlocked(neighbor)) {
+                        continue;
+                    }
+                    const float next = distance + (dx != 0 && dy != 0 ? 1.41421356f : 1.0f);
+                    if (next < distances[neighbor]) {
+                        distances[neighbor] = next;
+                        open.push({ next, neighbor });
+                    }
+                }
+            }
+        }
+        return ElapsedMilliseconds(start);
+    }
+
+    /// @brief 2つの場のセルごとの距離と向きがビット単位で一致するか
+    bool IsSameField(const NavigationGrid& grid, const FlowField& a, const FlowField& b)
+    {
+        for (uint32_t i = 0; i < grid.GetCellCount(); ++i) {
+            const float da = a.GetCellDistance(i);
+            const float db = b.GetCellDistance(i);
+            if (std::memcmp(&da, &db, sizeof(float)) != 0 ||
+                std::memcmp(&a.GetCellDirection(i), &b.GetCellDirection(i), sizeof(Vector2)) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief 2つの場の到達できるセルが同じで、距離が丸め誤差の範囲で一致するか
+    /// @details 差分更新と作り直しでは掃引の順が違い、浮動小数点の丸めの分だけ値がずれることがある
+    bool IsCloseField(const NavigationGrid& grid, const FlowField& a, const FlowField& b)
+    {
+        for (uint32_t i = 0; i < grid.GetCellCount(); ++i) {
+            const float da = a.GetCellDistance(i);
+            const float db = b.GetCellDistance(i);
+            if ((da == FlowField::kUnreachable) != (db == FlowField::kUnreachable)) {
+                return false;
+            }
+            if (da != FlowField::kUnreachable && std::abs(da - db) > 1.0e-5f * (std::max)(1.0f, da)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief 中央に一番近い通れるセル
+    uint32_t FindCenterCell(const NavigationGrid& grid)
+    {
+        const Vector2 center = { grid.GetWidth() * 0.5f, grid.GetHeight() * 0.5f };
+        uint32_t best = grid.WorldToIndex(center);
+        float bestDistance = FlowField::kUnreachable;
+        for (uint32_t i = 0; i < grid.GetCellCount(); ++i) {
+            const Vector2 offset = grid.GetCellCenter(i) - center;
+            const float distance = offset.x * offset.x + offset.y * offset.y;
+            if (!grid.IsBlocked(i) && distance < bestDistance) {
+                best = i;
+                bestDistance = distance;
+            }
+        }
+        return best;
+    }
+
+    /// @brief 1つのグリッドの大きさで計測する
+    bool RunSize(uint32_t size, const std::vector<uint32_t>& workerCounts, uint32_t frameCount)
+    {
+        NavigationGrid grid;
+        std::vector<Obstacle> movers;
+        BuildArena(grid, size, movers);
+        const uint32_t target = FindCenterCell(grid);
+        const uint32_t repeat = (std::max)(1u, 262144u / (size * size)) * 4;
+
+        std::printf("grid %ux%u (%u cells, blocked %.1f%%)\n", size, size, grid.GetCellCount(),
+            100.0 * grid.GetBlockedCount() / grid.GetCellCount());
+
+        std::vector<float> dijkstraDistances;
+        double dijkstraMilliseconds = 0.0;
+        for (uint32_t i = 0; i < repeat; ++i) {
+            dijkstraMilliseconds += RunDijkstra(grid, target, dijkstraDistances);
+        }
+        std::printf("  Dijkstra (8-neighbour, 1 thread)   build %8.3f ms\n", dijkstraMilliseconds / repeat);
+
+        bool isConsistent = true;
+        FlowField reference;
+        reference.Initialize(&grid);
+        reference.Build(target);
+
+        for (uint32_t workerCount : workerCounts) {
+            JobSystem jobSystem;
+            jobSystem.Initialize(workerCount);
+
+            // 構築
+            FlowField field;
+            field.Initialize(&grid);
+            double buildMilliseconds = 0.0;
+            for (uint32_t i = 0; i < repeat; ++i) {
+                const Clock::time_point start = Clock::now();
+                field.Build(target, &jobSystem);
+                buildMilliseconds += ElapsedMilliseconds(start);
+            }
+            const FlowFieldStats buildStats = field.GetStats();
+            if (!IsSameField(grid, field, reference)) {
+                std::printf("  workers %2u: MISMATCH against the single-thread build\n", workerCount);
+                isConsistent = false;
+            }
+
+            // 差分更新（障害物を1つずつ順に動かす。グリッドは最後に元に戻す）
+            NavigationGrid movedGrid = grid;
+            std::vector<Obstacle> moved = movers;
+            field.Initialize(&movedGrid);
+            field.Build(target, &jobSystem);
+            double updateMilliseconds = 0.0;
+            uint64_t updateBlocks = 0;
+            uint64_t resetCells = 0;
+            for (uint32_t frame = 0; frame < frameCount; ++frame) {
+                Obstacle& obstacle = moved[frame % moved.size()];
+                const float step = (frame / moved.size()) % 20 < 10 ? 1.0f : -1.0f;
+                obstacle.center.x = std::clamp(obstacle.center.x + step, 0.0f, static_cast<float>(size - 1));
+                std::vector<uint32_t> cells;
+                movedGrid.CollectCircleCells(obstacle.center, kObstacleRadius, cells);
+                movedGrid.AddBlocker(cells);
+                movedGrid.RemoveBlocker(obstacle.cells);
+                obstacle.cells.swap(cells);
+
+                const Clock::time_point start = Clock::now();
+                field.ApplyGridChanges(movedGrid.GetChangedCells(), &jobSystem);
+                updateMilliseconds += ElapsedMilliseconds(start);
+                updateBlocks += field.GetStats().blockUpdates;
+                resetCells += field.GetStats().resetCells;
+                movedGrid.ClearChangedCells();
+            }
+            FlowField rebuilt;
+            rebuilt.Initialize(&movedGrid);
+            rebuilt.Build(target);
+            if (!IsCloseField(movedGrid, field, rebuilt)) {
+                std::printf("  workers %2u: MISMATCH between incremental update and rebuild\n", workerCount);
+                isConsistent = false;
+            }
+
+            // 参照（エージェントは決まった乱数の位置。向きを足し合わせて最適化で消えないようにする）
+            std::mt19937 random(7);
+            std::uniform_real_distribution<float> position(0.0f, static_cast<float>(size));
+            std::vector<Vector2> agents(kAgentCount);
+            for (Vector2& agent : agents) {
+                agent = { position(random), position(random) };
+            }
+            Vector2 sum = { 0.0f, 0.0f };
+            const Clock::time_point sampleStart = Clock::now();
+            for (const Vector2& agent : agents) {
+                sum += field.SampleDirection(agent);
+            }
+            const double sampleNanoseconds = ElapsedMilliseconds(sampleStart) * 1.0e6 / kAgentCount;
+
+            std::printf("  workers %2u: flow field build %8.3f ms (%u sweeps, %u block sweeps), "
+                "update %7.3f ms/frame (%.1f block sweeps, %.1f cells reset), sample %.1f ns/agent (sum %.1f)\n",
+                workerCount, buildMilliseconds / repeat, buildStats.sweepCount, buildStats.blockUpdates,
+                updateMilliseconds / frameCount, static_cast<double>(updateBlocks) / frameCount,
+                static_cast<double>(resetCells) / frameCount,
+                sampleNanoseconds, sum.x + sum.y);
+        }
+        return isConsistent;
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<uint32_t> sizes = { 64, 128, 256, 512 };
+    const uint32_t hardwareWorkers = (std::max)(std::thread::hardware_concurrency(), 1u) - 1;
+    std::vector<uint32_t> workerCounts = { 0, 1, 3, hardwareWorkers };
+    uint32_t frameCount = 60;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--sizes") == 0 && i + 1 < argc) {
+            sizes = ParseList(argv[++i]);
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            workerCounts = ParseList(argv[++i]);
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frameCount = (std::max)(1u, static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10)));
+        } else {
+            std::printf("usage: NavigationBenchmark [--sizes <n,n,...>] [--threads <n,n,...>] [--frames <n>]\n");
+            return 1;
+        }
+    }
+    std::sort(workerCounts.begin(), workerCounts.end());
+    workerCounts.erase(std::unique(workerCounts.begin(), workerCounts.end()), workerCounts.end());
+
+    bool isConsistent = true;
+    for (uint32_t size : sizes) {
+        isConsistent = RunSize((std::max)(size, 1u), workerCounts, frameCount) && isConsistent;
+    }
+    std::printf("%s\n", isConsistent ? "consistent" : "NOT consistent");
+    return isConsistent ? 0 : 1;
+}
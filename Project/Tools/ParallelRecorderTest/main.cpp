@@ -0,0 +1,327 @@
+// 描画コマンドの並列記録（ParallelRecorder）の確認
+// コマンドリストの代わりに、記録した要素の番号を貯める偽の ICommandRecordingTarget を使い、
+// RenderManager::DrawAll と同じ分岐（並列に記録しないときはメインのリストに記録する）で毎フレーム記録して
+// 次を確かめる（1つでも失敗すれば終了コード1）。
+//   - 記録: 各リストは Begin → 記録 → End の順に、同じスレッドで1回だけ記録される
+//   - 実行: ExecuteRecorded は記録したフレームに1回だけ、チャンク数を渡して呼び出しスレッドから呼ばれる。
+//     実行される要素の並びはシリアル記録と同じ（全要素がちょうど1回ずつ、順番どおり）
+//   - チャンク: 範囲は先頭から隙間なく並び、数はワーカー数（0なら1）まで。要素がなければ記録も実行もしない
+//   - ワーカー数（0・1・2・4・8）を変えても実行される並びは同じ
+//   - シリアル記録: 無効・ワーカーなし・2チャンクに満たない場合は並列に記録しない
+//
+// 使い方: ParallelRecorderTest [--frames <数>] [--seed <数>]
+//   --frames <数>  ワーカー数ごとに記録するフレーム数（既定: 2000）
+//   --seed <数>    乱数の種（既定: 7）
+
+#include "Engine/Graphics/Render/Parallel/ParallelRecorder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    constexpr size_t kMinItemsPerChunk = 32; // RenderManager::kMinObjectsPerChunk と同じ
+    constexpr uint32_t kMaxListCount = 8;
+
+    uint32_t failureCount = 0;
+
+    void Check(bool condition, const char* description)
+    {
+        if (!condition) {
+            std::printf("FAILED: %s\n", description);
+            ++failureCount;
+        }
+    }
+
+    /// @brief 記録した要素の番号を貯める偽のコマンドリスト群
+    /// @details 各リストは記録中のスレッドだけが触り、ExecuteRecorded は記録が全て終わってから呼ばれる
+    class FakeRecordingTarget : public ICommandRecordingTarget {
+    public:
+        void BeginFrame()
+        {
+            submitted_.clear();
+            executeCount_ = 0;
+            executedListCount_ = 0;
+            for (List& list : lists_) {
+                list.state = ListState::Idle;
+            }
+        }
+
+        void BeginRecording(uint32_t listIndex) override
+        {
+            if (listIndex >= kMaxListCount || lists_[listIndex].state != ListState::Idle) {
+                ++errorCount_;
+                return;
+            }
+            List& list = lists_[listIndex];
+            list.state = ListState::Recording;
+            list.thread = std::this_thread::get_id();
+            list.commands.clear();
+        }
+
+        /// @brief 描画コマンドの代わりに要素の番号を記録
+        void Record(uint32_t listIndex, uint32_t item)
+        {
+            if (listIndex >= kMaxListCount || !IsRecordingHere(lists_[listIndex])) {
+                ++errorCount_;
+                return;
+            }
+            lists_[listIndex].commands.push_back(item);
+        }
+
+        void EndRecording(uint32_t listIndex) override
+        {
+            if (listIndex >= kMaxListCount || !IsRecordingHere(lists_[listIndex])) {
+                ++errorCount_;
+                return;
+            }
+            lists_[listIndex].state = ListState::Closed;
+        }
+
+        void ExecuteRecorded(uint32_t listCount) override
+        {
+            ++executeCount_;
+            executedListCount_ = listCount;
+            for (uint32_t i = 0; i < kMaxListCount; ++i) {
+                List& list = lists_[i];
+                // 実行するリストは全て記録済みで、それ以外は記録されていない
+                if ((i < listCount) != (list.state == ListState::Closed)) {
+                    ++errorCount_;
+                }
+                if (i < listCount) {
+                    submitted_.insert(submitted_.end(), list.commands.begin(), list.commands.end());
+                    threads_.insert(list.thread);
+                    list.state = ListState::Idle;
+                }
+            }
+        }
+
+        const std::vector<uint32_t>& GetSubmitted() const { return submitted_; }
+        uint32_t GetExecuteCount() const { return executeCount_; }
+        uint32_t GetExecutedListCount() const { return executedListCount_; }
+        uint32_t GetErrorCount() const { return errorCount_; }
+        size_t GetThreadCount() const { return threads_.size(); }
+
+    private:
+        enum class ListState : uint8_t { Idle, Recording, Closed };
+
+        struct List {
+            ListState state = ListState::Idle;
+            std::thread::id thread;
+            std::vector<uint32_t> commands;
+        };
+
+        static bool IsRecordingHere(const List& list)
+        {
+            return list.state == ListState::Recording && list.thread == std::this_thread::get_id();
+        }
+
+        List lists_[kMaxListCount];
+        std::vector<uint32_t> submitted_;
+        std::set<std::thread::id> threads_;
+        std::atomic<uint32_t> errorCount_ = 0;
+        uint32_t executeCount_ = 0;
+        uint32_t executedListCount_ = 0;
+    };
+
+    /// @brief チャンクごとの範囲（チャンクは別々のスレッドで記録されるので、番号ごとに書き込む）
+    struct ChunkRange {
+        size_t begin = 0;
+        size_t end = 0;
+        bool isRecorded = false;
+    };
+
+    /// @brief 1フレーム分記録する（RenderManager::DrawAll と同じ分岐）
+    /// @return 並列記録に使ったチャンク数（0ならメインのリストにシリアルに記録した）
+    uint32_t DrawFrame(ParallelRecorder& recorder, FakeRecordingTarget& target, size_t itemCount, size_t minItemsPerChunk,
+        std::vector<uint32_t>& mainList, std::vector<ChunkRange>& ranges)
+    {
+        target.BeginFrame();
+        mainList.clear();
+        ranges.assign(kMaxListCount, ChunkRange{});
+        if (recorder.ShouldRecordParallel(itemCount, minItemsPerChunk)) {
+            return recorder.Record(target, itemCount, minItemsPerChunk,
+                [&](uint32_t chunkIndex, size_t begin, size_t end) {
+                    if (chunkIndex < kMaxListCount) {
+                        ranges[chunkIndex] = { begin, end, true };
+                    }
+                    for (size_t i = begin; i < end; ++i) {
+                        target.Record(chunkIndex, static_cast<uint32_t>(i));
+                    }
+                });
+        }
+        for (size_t i = 0; i < itemCount; ++i) {
+            mainList.push_back(static_cast<uint32_t>(i));
+        }
+        return 0;
+    }
+
+    /// @brief チャンクが先頭から隙間なく並んでいるか
+    bool IsContiguous(const std::vector<ChunkRange>& ranges, uint32_t chunkCount, size_t itemCount)
+    {
+        size_t next = 0;
+        for (uint32_t i = 0; i < kMaxListCount; ++i) {
+            if (i >= chunkCount) {
+                if (ranges[i].isRecorded) {
+                    return false;
+                }
+                continue;
+            }
+            if (!ranges[i].isRecorded || ranges[i].begin != next || ranges[i].end <= ranges[i].begin) {
+                return false;
+            }
+            next = ranges[i].end;
+        }
+        return next == itemCount;
+    }
+
+    void TestSerialPath()
+    {
+        FakeRecordingTarget target;
+        std::vector<uint32_t> mainList;
+        std::vector<ChunkRange> ranges;
+
+        ParallelRecorder recorder;
+        recorder.Initialize(4);
+        Check(!recorder.IsEnabled(), "serial: parallel recording is off by default");
+        Check(!recorder.ShouldRecordParallel(1000, kMinItemsPerChunk), "serial: disabled recorder records serially");
+        Check(DrawFrame(recorder, target, 1000, kMinItemsPerChunk, mainList, ranges) == 0, "serial: disabled frame uses no chunks");
+        Check(target.GetExecuteCount() == 0 && target.GetSubmitted().empty(), "serial: disabled frame does not touch worker lists");
+        Check(mainList.size() == 1000, "serial: disabled frame records everything on the main list");
+
+        recorder.SetEnabled(true);
+        Check(!recorder.ShouldRecordParallel(kMinItemsPerChunk * 2 - 1, kMinItemsPerChunk), "serial: fewer than two chunks records serially");
+        Check(recorder.ShouldRecordParallel(kMinItemsPerChunk * 2, kMinItemsPerChunk), "serial: two chunks record in parallel");
+        Check(!recorder.ShouldRecordParallel(0, 0), "serial: nothing to record");
+        Check(DrawFrame(recorder, target, 1000, kMinItemsPerChunk, mainList, ranges) > 1, "serial: enabled frame uses worker lists");
+        Check(mainList.empty() && target.GetSubmitted().size() == 1000, "serial: enabled frame records nothing on the main list");
+        recorder.SetEnabled(false);
+        Check(DrawFrame(recorder, target, 1000, kMinItemsPerChunk, mainList, ranges) == 0, "serial: disabling again returns to serial");
+        recorder.Finalize();
+
+        // ワーカーがなければ有効でもシリアル。Record を直接呼ぶと呼び出しスレッドで1チャンクとして記録する
+        ParallelRecorder single;
+        single.Initialize(0);
+        single.SetEnabled(true);
+        Check(!single.ShouldRecordParallel(1000, kMinItemsPerChunk), "serial: no workers records serially");
+        target.BeginFrame();
+        const uint32_t chunkCount = single.Record(target, 1000, kMinItemsPerChunk,
+            [&](uint32_t chunkIndex, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    target.Record(chunkIndex, static_cast<uint32_t>(i));
+                }
+            });
+        Check(chunkCount == 1 && target.GetExecutedListCount() == 1 && target.GetSubmitted().size() == 1000,
+            "serial: no workers records one chunk");
+        single.Finalize();
+        Check(target.GetErrorCount() == 0, "serial: lists are recorded and executed in order");
+    }
+
+    void TestEmpty()
+    {
+        ParallelRecorder recorder;
+        recorder.Initialize(4);
+        FakeRecordingTarget target;
+        target.BeginFrame();
+        const uint32_t chunkCount = recorder.Record(target, 0, kMinItemsPerChunk, [](uint32_t, size_t, size_t) {});
+        Check(chunkCount == 0 && target.GetExecuteCount() == 0, "empty: nothing is recorded or executed");
+        recorder.Finalize();
+    }
+
+    void RunFrames(uint32_t frames, uint32_t seed)
+    {
+        const uint32_t workerCounts[] = { 0, 1, 2, 4, 8 };
+        std::vector<std::unique_ptr<ParallelRecorder>> recorders;
+        std::vector<std::unique_ptr<FakeRecordingTarget>> targets;
+        for (uint32_t workerCount : workerCounts) {
+            recorders.push_back(std::make_unique<ParallelRecorder>());
+            recorders.back()->Initialize(workerCount);
+            recorders.back()->SetEnabled(true);
+            targets.push_back(std::make_unique<FakeRecordingTarget>());
+        }
+        ParallelRecorder serial;
+        serial.Initialize(0);
+        FakeRecordingTarget serialTarget;
+
+        std::mt19937 random(seed);
+        uint32_t parallelFrames = 0;
+        uint32_t mismatchCount = 0;
+        uint32_t badChunkCount = 0;
+        uint32_t badExecuteCount = 0;
+        std::vector<uint32_t> expected;
+        std::vector<uint32_t> mainList;
+        std::vector<ChunkRange> ranges;
+        for (uint32_t frame = 0; frame < frames; ++frame) {
+            // 少ない（シリアルになる）フレームも混ぜる
+            const size_t itemCount = random() % 4 == 0 ? random() % 64 : random() % 5000;
+            const size_t minItemsPerChunk = 1 + random() % 64;
+            DrawFrame(serial, serialTarget, itemCount, minItemsPerChunk, expected, ranges);
+
+            for (size_t r = 0; r < recorders.size(); ++r) {
+                ParallelRecorder& recorder = *recorders[r];
+                FakeRecordingTarget& target = *targets[r];
+                const uint32_t chunkCount = DrawFrame(recorder, target, itemCount, minItemsPerChunk, mainList, ranges);
+                const std::vector<uint32_t>& executed = chunkCount > 0 ? target.GetSubmitted() : mainList;
+                mismatchCount += executed == expected ? 0 : 1;
+
+                if (chunkCount == 0) {
+                    badExecuteCount += target.GetExecuteCount() == 0 ? 0 : 1;
+                    continue;
+                }
+                ++parallelFrames;
+                const uint32_t maxChunks = (std::max)(workerCounts[r], 1u);
+                const bool isChunkValid = chunkCount <= maxChunks &&
+                    chunkCount == JobSystem::GetChunkCount(itemCount, minItemsPerChunk, maxChunks) &&
+                    IsContiguous(ranges, chunkCount, itemCount);
+                badChunkCount += isChunkValid ? 0 : 1;
+                badExecuteCount += target.GetExecuteCount() == 1 && target.GetExecutedListCount() == chunkCount ? 0 : 1;
+            }
+        }
+
+        Check(mismatchCount == 0, "frames: executed items match serial recording for every worker count");
+        Check(badChunkCount == 0, "frames: chunks are contiguous and within the list count");
+        Check(badExecuteCount == 0, "frames: ExecuteRecorded runs once per parallel frame with the chunk count");
+        uint32_t errorCount = serialTarget.GetErrorCount();
+        for (size_t r = 0; r < recorders.size(); ++r) {
+            errorCount += targets[r]->GetErrorCount();
+            std::printf("workers %u: recorded on %zu threads\n", workerCounts[r], targets[r]->GetThreadCount());
+            recorders[r]->Finalize();
+        }
+        serial.Finalize();
+        Check(errorCount == 0, "frames: each list is begun, recorded and ended on one thread before execution");
+        std::printf("frames: %u frames x %zu worker counts, %u parallel\n", frames, recorders.size(), parallelFrames);
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t frames = 2000;
+    uint32_t seed = 7;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::printf("usage: ParallelRecorderTest [--frames <n>] [--seed <n>]\n");
+            return 1;
+        }
+    }
+
+    TestSerialPath();
+    TestEmpty();
+    RunFrames(frames, seed);
+
+    std::printf("%s (%u failures)\n", failureCount == 0 ? "passed" : "FAILED", failureCount);
+    return failureCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,215 @@
+// パイプラインステートのキー計算・重複除去（PipelineStateHasher / PipelineStateFormat / PipelineStateTable）の確認
+// 次を確かめる（1つでも失敗すれば終了コード1）。
+//   - キー計算: 加える順番・文字列の区切り・nullptr と "" を区別し、-0 と +0 は同じにする。
+//     カリング・ブレンド・フォーマット・深度の組み合わせで衝突しない
+//   - ファイル形式: 読み戻せる。中身の破損・シェーダーキャッシュなど別の形式のファイルは読まない
+//   - 重複除去: 同じキーを複数のスレッドが同時に要求しても生成は1回で、全員が同じ値を受け取る。
+//     生成に失敗した（空の値・例外）キーは登録されず、次の要求で生成し直す
+//
+// 使い方: PipelineStateHashTest [--threads <数>] [--keys <数>]
+//   --threads <数>  同時に要求するスレッド数（既定: 8）
+//   --keys <数>     負荷試験で使うキーの数（既定: 64）
+
+#include "Engine/Graphics/Pipeline/PipelineStateHash.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    uint32_t failureCount = 0;
+
+    void Check(bool condition, const char* description)
+    {
+        if (!condition) {
+            std::printf("FAILED: %s\n", description);
+            ++failureCount;
+        }
+    }
+
+    template<typename Func>
+    uint64_t Hash(Func&& add)
+    {
+        PipelineStateHasher hasher;
+        add(hasher);
+        return hasher.GetHash();
+    }
+
+    void TestHasher()
+    {
+        Check(Hash([](auto& h) { h.Add(1u).Add(2u); }) != Hash([](auto& h) { h.Add(2u).Add(1u); }), "order changes the hash");
+        Check(Hash([](auto& h) { h.Add(0.0f); }) == Hash([](auto& h) { h.Add(-0.0f); }), "-0 and +0 hash the same");
+        Check(Hash([](auto& h) { h.Add(1.0f); }) != Hash([](auto& h) { h.Add(-1.0f); }), "sign of non-zero floats matters");
+        Check(Hash([](auto& h) { h.AddString(nullptr); }) != Hash([](auto& h) { h.AddString(""); }), "nullptr and \"\" differ");
+        Check(Hash([](auto& h) { h.AddString("ab").AddString("c"); }) != Hash([](auto& h) { h.AddString("a").AddString("bc"); }),
+            "string boundaries are part of the hash");
+        Check(Hash([](auto& h) { h.AddBytes("ab", 2).AddBytes("c", 1); }) != Hash([](auto& h) { h.AddBytes("a", 1).AddBytes("bc", 2); }),
+            "byte boundaries are part of the hash");
+        Check(Hash([](auto& h) { h.AddBytes("ab", 2); }) == Hash([](auto& h) { h.AddBytes("ab", 2); }), "same bytes hash the same");
+
+        // パイプラインの状態の組み合わせで衝突しない
+        std::set<uint64_t> keys;
+        uint32_t stateCount = 0;
+        for (uint32_t cull = 0; cull < 3; ++cull) {
+            for (uint32_t blend = 0; blend < 6; ++blend) {
+                for (uint32_t format = 0; format < 40; ++format) {
+                    for (int32_t depth = 0; depth < 2; ++depth) {
+                        PipelineStateHasher hasher;
+                        hasher.Add(cull).Add(blend).Add(format).Add(depth).AddString("POSITION");
+                        keys.insert(hasher.GetHash());
+                        ++stateCount;
+                    }
+                }
+            }
+        }
+        Check(keys.size() == stateCount, "no collisions over the state grid");
+    }
+
+    void TestFormat()
+    {
+        std::vector<uint8_t> library(1000);
+        for (size_t i = 0; i < library.size(); ++i) {
+            library[i] = static_cast<uint8_t>(i * 7);
+        }
+        std::vector<uint8_t> file = PipelineStateFormat::SerializeLibrary(library.data(), library.size());
+        size_t offset = 0;
+        size_t size = 0;
+        Check(PipelineStateFormat::DeserializeLibrary(file, offset, size) && size == library.size() &&
+            std::memcmp(file.data() + offset, library.data(), size) == 0, "library round-trips");
+
+        std::vector<uint8_t> broken = file;
+        broken[offset + 5] ^= 1;
+        Check(!PipelineStateFormat::DeserializeLibrary(broken, offset, size), "corrupted library is rejected");
+        broken.assign(file.begin(), file.end() - 1);
+        Check(!PipelineStateFormat::DeserializeLibrary(broken, offset, size), "truncated library is rejected");
+        broken = ShaderCacheFormat::SerializeBlob(123, library.data(), library.size());
+        Check(!PipelineStateFormat::DeserializeLibrary(broken, offset, size), "shader cache blob is rejected");
+        Check(!PipelineStateFormat::DeserializeLibrary({}, offset, size), "empty file is rejected");
+
+        Check(PipelineStateFormat::ToPipelineName(0x1234) == L"PSO_0000000000001234", "pipeline name");
+    }
+
+    void TestTable()
+    {
+        // 4つのキーを8スレッドが同時に要求する（生成に時間がかかる間に他のスレッドが来る）
+        PipelineStateTable<std::shared_ptr<int>> table;
+        std::atomic<int> createCount{ 0 };
+        std::vector<std::shared_ptr<int>> results(64);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < 8; ++i) {
+                    const uint64_t key = i % 4;
+                    results[t * 8 + i] = table.GetOrCreate(key, [&] {
+                        ++createCount;
+                        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                        return std::make_shared<int>(static_cast<int>(key));
+                    });
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        Check(createCount == 4, "each key is created once under contention");
+
+        bool isShared = true;
+        for (int i = 0; i < 64; ++i) {
+            const uint64_t key = (i % 8) % 4;
+            const std::shared_ptr<int> again = table.GetOrCreate(key, [] { return std::shared_ptr<int>(); });
+            isShared = isShared && results[i] && *results[i] == static_cast<int>(key) && results[i] == again;
+        }
+        Check(isShared, "every caller receives the same value");
+        PipelineStateTable<std::shared_ptr<int>>::Statistics statistics = table.GetStatistics();
+        Check(statistics.createCount == 4 && statistics.entryCount == 4 && statistics.hitCount == 60 + 64, "table statistics");
+
+        // 失敗は登録しない
+        Check(!table.GetOrCreate(99, [] { return std::shared_ptr<int>(); }), "failed creation returns empty");
+        Check(!table.Contains(99), "failed creation is not cached");
+        const std::shared_ptr<int> retried = table.GetOrCreate(99, [] { return std::make_shared<int>(5); });
+        Check(retried && *retried == 5, "failed key is created again on the next request");
+        bool isThrown = false;
+        try {
+            table.GetOrCreate(100, []() -> std::shared_ptr<int> { throw 1; });
+        } catch (int) {
+            isThrown = true;
+        }
+        Check(isThrown, "exception from the factory reaches the caller");
+        Check(!table.Contains(100), "key whose factory threw is not cached");
+        statistics = table.GetStatistics();
+        Check(statistics.failedCount == 2 && statistics.entryCount == 5, "failure statistics");
+    }
+
+    void TestTableStress(uint32_t threadCount, uint32_t keyCount)
+    {
+        // 多数のスレッドがばらばらの順でキーを要求する
+        constexpr uint32_t kRequestsPerThread = 2000;
+        PipelineStateTable<std::shared_ptr<uint64_t>> table;
+        std::vector<std::atomic<uint32_t>> createCounts(keyCount);
+        std::atomic<uint32_t> mismatchCount{ 0 };
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&, t] {
+                std::mt19937 random(t);
+                for (uint32_t i = 0; i < kRequestsPerThread; ++i) {
+                    const uint64_t key = random() % keyCount;
+                    const std::shared_ptr<uint64_t> value = table.GetOrCreate(key, [&] {
+                        ++createCounts[key];
+                        return std::make_shared<uint64_t>(key);
+                    });
+                    if (!value || *value != key) {
+                        ++mismatchCount;
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        bool isCreatedOnce = true;
+        for (const std::atomic<uint32_t>& count : createCounts) {
+            isCreatedOnce = isCreatedOnce && count <= 1;
+        }
+        const PipelineStateTable<std::shared_ptr<uint64_t>>::Statistics statistics = table.GetStatistics();
+        Check(isCreatedOnce, "stress: no key is created twice");
+        Check(mismatchCount == 0, "stress: every request returns its key's value");
+        Check(statistics.hitCount + statistics.createCount == threadCount * kRequestsPerThread, "stress: every request is counted");
+        std::printf("stress: %u threads x %u requests over %u keys, %u created\n",
+            threadCount, kRequestsPerThread, keyCount, statistics.createCount);
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t threadCount = 8;
+    uint32_t keyCount = 64;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threadCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--keys") == 0 && i + 1 < argc) {
+            keyCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::printf("usage: PipelineStateHashTest [--threads <n>] [--keys <n>]\n");
+            return 1;
+        }
+    }
+
+    TestHasher();
+    TestFormat();
+    TestTable();
+    TestTableStress((std::max)(threadCount, 1u), (std::max)(keyCount, 1u));
+
+    std::printf("%s (%u failures)\n", failureCount == 0 ? "passed" : "FAILED", failureCount);
+    return failureCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,476 @@
+// ポストエフェクトのレンダーグラフ（PostEffectGraph::Compile）の確認
+// コンパイル結果を物理ターゲットの中身と状態を追いながら実行し、宣言どおりに評価した結果と比べて
+// 次を確かめる（1つでも失敗すれば終了コード1）。
+//   - パススルー: 全パスが無効なら実行するパスはなく、取り込んだリソースがそのまま最終出力になる
+//   - まとめ: ピクセル単位のパスは適用順が昇順に並ぶときだけまとめる。オプションが無効ならまとめない
+//   - 使い回し: 物理ターゲットは maxPhysicalTargets 以内で、まだ読まれる中身を上書きしない。
+//     パスは自分の出力を読まない。足りない場合はコンパイルに失敗する
+//   - 状態遷移: 各遷移の before は直前の状態と同じで、after と異なる。パスの実行時には入力が読み取り状態、
+//     出力が書き込み状態。finalBarriers の後は全ターゲットが読み取り状態。barrierCount は遷移の総数
+// あわせてランダムなグラフ（直列・分岐・無効なパス・出力に寄与しないパスを含む）で同じことを確かめる。
+//
+// 使い方: PostEffectGraphTest [--graphs <数>] [--seed <数>]
+//   --graphs <数>  ランダムなグラフの数（既定: 20000）
+//   --seed <数>    乱数の種（既定: 7）
+
+#include "Engine/Graphics/PostEffect/RenderGraph/PostEffectGraph.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+    using ResourceId = PostEffectGraph::ResourceId;
+    using ResourceState = PostEffectGraph::ResourceState;
+
+    uint32_t failureCount = 0;
+
+    void Check(bool condition, const char* description)
+    {
+        if (!condition) {
+            std::printf("FAILED: %s\n", description);
+            ++failureCount;
+        }
+    }
+
+    /// @brief 中身の式に使う名前（"R3"・"P5" など）
+    std::string Label(char prefix, uint32_t index)
+    {
+        std::string label(1, prefix);
+        label += std::to_string(index);
+        return label;
+    }
+
+    /// @brief 宣言と一緒に、各リソースの中身を式の文字列として持つグラフ
+    /// @details 取り込んだリソースは "R<番号>"、有効なパスは "P<番号>(入力,...)"、無効なパスは先頭の入力と同じ
+    struct TestGraph {
+        PostEffectGraph graph;
+        std::vector<std::string> values;
+        std::vector<std::pair<uint32_t, ResourceId>> imports; // 物理インデックスとリソース
+        uint32_t passCount = 0;
+        ResourceId output = PostEffectGraph::kInvalidResource;
+
+        ResourceId Import(uint32_t physicalIndex)
+        {
+            ResourceId id = graph.ImportResource("Import", physicalIndex);
+            values.push_back(Label('R', id));
+            imports.push_back({ physicalIndex, id });
+            return id;
+        }
+
+        ResourceId AddPass(const std::vector<ResourceId>& inputs, bool enabled, int32_t perPixelOrder)
+        {
+            PostEffectGraph::PassDesc pass;
+            pass.name = "Pass";
+            pass.inputs = inputs;
+            pass.output = graph.CreateTransient("Transient");
+            pass.enabled = enabled;
+            pass.perPixelOrder = perPixelOrder;
+            graph.AddPass(pass);
+
+            std::string value = values[inputs[0]];
+            if (enabled) {
+                value = Label('P', passCount) + "(";
+                for (size_t i = 0; i < inputs.size(); ++i) {
+                    if (i > 0) {
+                        value += ',';
+                    }
+                    value += values[inputs[i]];
+                }
+                value += ")";
+            }
+            values.push_back(value);
+            ++passCount;
+            return pass.output;
+        }
+
+        void SetOutput(ResourceId resource)
+        {
+            graph.SetOutput(resource);
+            output = resource;
+        }
+
+        /// @brief 取り込んだリソースから始まる直列のパスを組む（各パスの有効・適用順は引数）
+        void Chain(const std::vector<bool>& enabled, const std::vector<int32_t>& orders)
+        {
+            ResourceId current = Import(0);
+            for (size_t i = 0; i < enabled.size(); ++i) {
+                current = AddPass({ current }, enabled[i], orders[i]);
+            }
+            SetOutput(current);
+        }
+    };
+
+    /// @brief 遷移を発行して状態を進める（before が直前の状態と違えば失敗）
+    bool ApplyBarriers(const std::vector<PostEffectGraph::Barrier>& barriers, std::vector<ResourceState>& states, uint32_t& barrierCount)
+    {
+        bool isValid = true;
+        for (const PostEffectGraph::Barrier& barrier : barriers) {
+            if (barrier.physicalIndex >= states.size()) {
+                return false;
+            }
+            isValid = isValid && barrier.before == states[barrier.physicalIndex] && barrier.before != barrier.after;
+            states[barrier.physicalIndex] = barrier.after;
+            ++barrierCount;
+        }
+        return isValid;
+    }
+
+    /// @brief コンパイル結果を実行し、宣言どおりの結果になるか確かめる
+    /// @return 問題がなければ true（理由は description に書く）
+    bool Execute(const TestGraph& test, const PostEffectGraph::CompileOptions& options,
+        const PostEffectGraph::CompiledGraph& compiled, const char*& description)
+    {
+        const uint32_t targetCount = options.maxPhysicalTargets;
+        std::vector<std::string> contents(targetCount);
+        std::vector<ResourceState> states(targetCount, ResourceState::ShaderResource);
+        for (const auto& [physicalIndex, id] : test.imports) {
+            contents[physicalIndex] = test.values[id];
+        }
+
+        if (!compiled.valid || compiled.physicalTargetCount > targetCount || compiled.finalPhysical >= targetCount) {
+            description = "targets stay within maxPhysicalTargets";
+            return false;
+        }
+
+        uint32_t barrierCount = 0;
+        uint32_t executedCount = 0;
+        std::vector<bool> executed(test.passCount, false);
+        for (const PostEffectGraph::CompiledPass& pass : compiled.passes) {
+            if (pass.passIndices.empty() || pass.outputPhysical >= compiled.physicalTargetCount) {
+                description = "each compiled pass has passes and a target in range";
+                return false;
+            }
+            if (!ApplyBarriers(pass.barriers, states, barrierCount)) {
+                description = "barrier before states chain from the previous state";
+                return false;
+            }
+            if (states[pass.outputPhysical] != ResourceState::RenderTarget) {
+                description = "output is in render target state when the pass runs";
+                return false;
+            }
+
+            std::string value;
+            int32_t lastOrder = -1;
+            for (size_t k = 0; k < pass.passIndices.size(); ++k) {
+                const uint32_t passIndex = pass.passIndices[k];
+                if (passIndex >= test.passCount || executed[passIndex] || !test.graph.GetPass(passIndex).enabled) {
+                    description = "only enabled passes run, each once";
+                    return false;
+                }
+                executed[passIndex] = true;
+                ++executedCount;
+                const PostEffectGraph::PassDesc& desc = test.graph.GetPass(passIndex);
+
+                if (k == 0) {
+                    if (pass.inputPhysical.size() != desc.inputs.size()) {
+                        description = "compiled pass reads every declared input";
+                        return false;
+                    }
+                    value = Label('P', passIndex) + "(";
+                    for (size_t i = 0; i < pass.inputPhysical.size(); ++i) {
+                        const uint32_t input = pass.inputPhysical[i];
+                        if (input >= targetCount || input == pass.outputPhysical || states[input] != ResourceState::ShaderResource) {
+                            description = "inputs are other targets in shader resource state";
+                            return false;
+                        }
+                        if (i > 0) {
+                            value += ',';
+                        }
+                        value += contents[input];
+                    }
+                    value += ")";
+                } else {
+                    // まとめられたパスは前のパスの結果だけを読み、適用順は昇順
+                    if (desc.inputs.size() != 1 || desc.perPixelOrder < 0 || desc.perPixelOrder <= lastOrder) {
+                        description = "merged passes are per-pixel in increasing order";
+                        return false;
+                    }
+                    value = Label('P', passIndex) + "(" + value + ")";
+                }
+                lastOrder = desc.perPixelOrder;
+            }
+            if (pass.passIndices.size() > 1 && (!options.mergePerPixelPasses || test.graph.GetPass(pass.passIndices[0]).perPixelOrder < 0)) {
+                description = "passes merge only when enabled and per-pixel";
+                return false;
+            }
+            contents[pass.outputPhysical] = value;
+        }
+
+        if (!ApplyBarriers(compiled.finalBarriers, states, barrierCount)) {
+            description = "final barrier before states chain from the previous state";
+            return false;
+        }
+        for (ResourceState state : states) {
+            if (state != ResourceState::ShaderResource) {
+                description = "every target ends in shader resource state";
+                return false;
+            }
+        }
+        if (barrierCount != compiled.barrierCount) {
+            description = "barrierCount matches the issued barriers";
+            return false;
+        }
+        if (executedCount + compiled.culledPassCount != test.passCount ||
+            compiled.passes.size() + compiled.mergedPassCount != executedCount) {
+            description = "run, culled and merged counts add up";
+            return false;
+        }
+        if (contents[compiled.finalPhysical] != test.values[test.output]) {
+            description = "final target holds the declared output";
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief コンパイルして実行結果を確かめる
+    bool CompileAndCheck(const TestGraph& test, uint32_t maxPhysicalTargets, bool merge,
+        PostEffectGraph::CompiledGraph& compiled, const char* description)
+    {
+        PostEffectGraph::CompileOptions options;
+        options.maxPhysicalTargets = maxPhysicalTargets;
+        options.mergePerPixelPasses = merge;
+        bool isCompiled = test.graph.Compile(options, compiled);
+        Check(isCompiled, description);
+        if (!isCompiled) {
+            return false;
+        }
+        const char* reason = "";
+        bool isValid = Execute(test, options, compiled, reason);
+        if (!isValid) {
+            std::printf("FAILED: %s: %s\n", description, reason);
+            ++failureCount;
+        }
+        return isValid;
+    }
+
+    void TestPassThrough()
+    {
+        TestGraph test;
+        test.Chain({ false, false, false, false, false }, { 1, -1, 3, 4, -1 });
+        PostEffectGraph::CompiledGraph compiled;
+        if (CompileAndCheck(test, 2, true, compiled, "pass-through: all disabled compiles")) {
+            Check(compiled.passes.empty(), "pass-through: no pass runs");
+            Check(compiled.finalPhysical == 0, "pass-through: the imported target is the output");
+            Check(compiled.culledPassCount == 5, "pass-through: every pass is culled");
+            Check(compiled.barrierCount == 0 && compiled.finalBarriers.empty(), "pass-through: no barriers");
+        }
+
+        // 寄与しないパスは有効でも除外し、ターゲットを使わない
+        TestGraph unused;
+        ResourceId scene = unused.Import(0);
+        ResourceId kept = unused.AddPass({ scene }, true, -1);
+        unused.AddPass({ kept }, true, -1);
+        unused.SetOutput(kept);
+        if (CompileAndCheck(unused, 2, false, compiled, "unused pass: compiles")) {
+            Check(compiled.passes.size() == 1 && compiled.culledPassCount == 1, "unused pass: culled");
+        }
+    }
+
+    void TestMerge()
+    {
+        PostEffectGraph::CompiledGraph compiled;
+
+        TestGraph ordered;
+        ordered.Chain({ true, true, true, true }, { 1, 3, 5, 7 });
+        if (CompileAndCheck(ordered, 2, true, compiled, "merge: increasing orders compile")) {
+            Check(compiled.passes.size() == 1 && compiled.passes[0].passIndices.size() == 4, "merge: increasing orders become one pass");
+            Check(compiled.mergedPassCount == 3, "merge: mergedPassCount");
+        }
+        if (CompileAndCheck(ordered, 2, false, compiled, "merge off: compiles")) {
+            Check(compiled.passes.size() == 4 && compiled.mergedPassCount == 0, "merge off: one pass per effect");
+        }
+
+        TestGraph reversed;
+        reversed.Chain({ true, true }, { 3, 1 });
+        if (CompileAndCheck(reversed, 2, true, compiled, "merge: decreasing orders compile")) {
+            Check(compiled.passes.size() == 2, "merge: decreasing orders stay separate");
+        }
+
+        TestGraph duplicate;
+        duplicate.Chain({ true, true }, { 2, 2 });
+        if (CompileAndCheck(duplicate, 2, true, compiled, "merge: equal orders compile")) {
+            Check(compiled.passes.size() == 2, "merge: equal orders stay separate");
+        }
+
+        TestGraph blocked;
+        blocked.Chain({ true, true, true }, { 1, -1, 2 });
+        if (CompileAndCheck(blocked, 2, true, compiled, "merge: non per-pixel pass compiles")) {
+            Check(compiled.passes.size() == 3, "merge: a non per-pixel pass breaks the run");
+        }
+
+        // 無効なパスはまとめる対象から外れるだけで、前後はまとめる
+        TestGraph skipped;
+        skipped.Chain({ true, false, true }, { 1, 4, 5 });
+        if (CompileAndCheck(skipped, 2, true, compiled, "merge: disabled pass in the run compiles")) {
+            Check(compiled.passes.size() == 1 && compiled.passes[0].passIndices == std::vector<uint32_t>{ 0, 2 },
+                "merge: disabled pass is skipped inside a run");
+        }
+
+        // 途中の結果を別のパスも読むならまとめない
+        TestGraph shared;
+        ResourceId scene = shared.Import(0);
+        ResourceId first = shared.AddPass({ scene }, true, 1);
+        ResourceId second = shared.AddPass({ first }, true, 2);
+        shared.SetOutput(shared.AddPass({ first, second }, true, -1));
+        if (CompileAndCheck(shared, 3, true, compiled, "merge: shared intermediate compiles")) {
+            Check(compiled.passes.size() == 3 && compiled.mergedPassCount == 0, "merge: shared intermediate is not merged");
+        }
+    }
+
+    void TestAliasing()
+    {
+        PostEffectGraph::CompiledGraph compiled;
+
+        // 直列なら2枚を交互に使う
+        TestGraph chain;
+        chain.Chain(std::vector<bool>(10, true), std::vector<int32_t>(10, -1));
+        if (CompileAndCheck(chain, 2, false, compiled, "aliasing: chain fits in two targets")) {
+            Check(compiled.physicalTargetCount == 2, "aliasing: chain uses two targets");
+            bool isAlternating = true;
+            for (size_t i = 0; i < compiled.passes.size(); ++i) {
+                isAlternating = isAlternating && compiled.passes[i].outputPhysical == (i % 2 == 0 ? 1u : 0u);
+            }
+            Check(isAlternating, "aliasing: chain ping-pongs between targets");
+        }
+        PostEffectGraph::CompileOptions one;
+        one.maxPhysicalTargets = 1;
+        Check(!chain.graph.Compile(one, compiled) && !compiled.valid, "aliasing: one target is not enough");
+
+        // 2つの結果を合わせるパスは3枚必要
+        TestGraph diamond;
+        ResourceId scene = diamond.Import(0);
+        ResourceId left = diamond.AddPass({ scene }, true, -1);
+        ResourceId right = diamond.AddPass({ scene }, true, -1);
+        ResourceId joined = diamond.AddPass({ left, right }, true, -1);
+        diamond.SetOutput(diamond.AddPass({ joined }, true, -1));
+        PostEffectGraph::CompileOptions two;
+        two.maxPhysicalTargets = 2;
+        Check(!diamond.graph.Compile(two, compiled), "aliasing: diamond does not fit in two targets");
+        if (CompileAndCheck(diamond, 3, false, compiled, "aliasing: diamond fits in three targets")) {
+            Check(compiled.physicalTargetCount == 3, "aliasing: diamond uses three targets");
+        }
+
+        // 取り込んだリソースの番号がターゲットの数を超えれば失敗
+        TestGraph outside;
+        outside.SetOutput(outside.AddPass({ outside.Import(2) }, true, -1));
+        Check(!outside.graph.Compile(two, compiled), "aliasing: import outside maxPhysicalTargets fails");
+    }
+
+    void TestBarriers()
+    {
+        TestGraph chain;
+        chain.Chain({ true, true, true }, { -1, -1, -1 });
+        PostEffectGraph::CompiledGraph compiled;
+        if (!CompileAndCheck(chain, 2, false, compiled, "barriers: chain compiles") || compiled.passes.size() != 3) {
+            return;
+        }
+
+        using Barrier = PostEffectGraph::Barrier;
+        auto same = [](const std::vector<Barrier>& barriers, const std::vector<Barrier>& expected) {
+            if (barriers.size() != expected.size()) {
+                return false;
+            }
+            for (size_t i = 0; i < barriers.size(); ++i) {
+                if (barriers[i].physicalIndex != expected[i].physicalIndex || barriers[i].before != expected[i].before ||
+                    barriers[i].after != expected[i].after) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        constexpr ResourceState kRead = ResourceState::ShaderResource;
+        constexpr ResourceState kWrite = ResourceState::RenderTarget;
+        Check(same(compiled.passes[0].barriers, { { 1, kRead, kWrite } }), "barriers: first pass only makes its output writable");
+        Check(same(compiled.passes[1].barriers, { { 1, kWrite, kRead }, { 0, kRead, kWrite } }), "barriers: second pass swaps the targets");
+        Check(same(compiled.passes[2].barriers, { { 0, kWrite, kRead }, { 1, kRead, kWrite } }), "barriers: third pass swaps back");
+        Check(same(compiled.finalBarriers, { { 1, kWrite, kRead } }), "barriers: final barriers return the output to read");
+        Check(compiled.barrierCount == 6, "barriers: barrierCount");
+    }
+
+    void RunRandomized(uint32_t graphCount, uint32_t seed)
+    {
+        std::mt19937 random(seed);
+        uint32_t compiledCount = 0;
+        uint32_t rejectedCount = 0;
+        uint32_t mergedCount = 0;
+        uint32_t reported = failureCount;
+        for (uint32_t g = 0; g < graphCount && failureCount - reported < 10; ++g) {
+            TestGraph test;
+            const bool isLinear = random() % 2 == 0;
+            std::vector<ResourceId> written = { test.Import(0) };
+            if (!isLinear && random() % 3 == 0) {
+                written.push_back(test.Import(1));
+            }
+            ResourceId current = written[0];
+            const uint32_t passCount = random() % 13;
+            for (uint32_t p = 0; p < passCount; ++p) {
+                std::vector<ResourceId> inputs = { current };
+                if (!isLinear) {
+                    inputs.assign(1 + random() % 3, 0);
+                    for (ResourceId& input : inputs) {
+                        input = written[random() % written.size()];
+                    }
+                }
+                const bool enabled = random() % 4 != 0;
+                const int32_t order = random() % 2 == 0 ? -1 : static_cast<int32_t>(random() % 8);
+                current = test.AddPass(inputs, enabled, order);
+                written.push_back(current);
+            }
+            test.SetOutput(isLinear ? current : written[random() % written.size()]);
+
+            const bool merge = random() % 2 == 0;
+            const uint32_t maxTargets = 2 + random() % 3;
+            PostEffectGraph::CompileOptions options;
+            options.maxPhysicalTargets = maxTargets;
+            options.mergePerPixelPasses = merge;
+            PostEffectGraph::CompiledGraph compiled;
+            if (test.graph.Compile(options, compiled)) {
+                const char* reason = "";
+                if (!Execute(test, options, compiled, reason)) {
+                    std::printf("FAILED: random graph %u (%u passes, %u targets, merge %d): %s\n", g, passCount, maxTargets, merge, reason);
+                    ++failureCount;
+                }
+                ++compiledCount;
+                mergedCount += compiled.mergedPassCount;
+            } else {
+                // 直列は2枚で足りる。それ以外はターゲットが十分あればコンパイルできる
+                Check(!isLinear, "random: linear chains always fit in two targets");
+                ++rejectedCount;
+                CompileAndCheck(test, static_cast<uint32_t>(written.size()) + 2, merge, compiled, "random: compiles with enough targets");
+            }
+        }
+        std::printf("random: %u graphs compiled, %u needed more targets, %u passes merged\n", compiledCount, rejectedCount, mergedCount);
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t graphs = 20000;
+    uint32_t seed = 7;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--graphs") == 0 && i + 1 < argc) {
+            graphs = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::printf("usage: PostEffectGraphTest [--graphs <n>] [--seed <n>]\n");
+            return 1;
+        }
+    }
+
+    TestPassThrough();
+    TestMerge();
+    TestAliasing();
+    TestBarriers();
+    RunRandomized(graphs, seed);
+
+    std::printf("%s (%u failures)\n", failureCount == 0 ? "passed" : "FAILED", failureCount);
+    return failureCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,213 @@
+// シェーダーキャッシュの形式（ShaderCacheFormat）の確認
+// メモリ上のファイル（パス→内容の表）を読ませて、次を確かめる（1つでも失敗すれば終了コード1）。
+//   - インクルードの抽出: コメントの中の #include を無視する、"..." と <...> を区別する
+//   - 依存ファイルの収集: "..." はインクルード元のディレクトリから、<...> はインクルードディレクトリだけから探す。
+//     循環インクルードでも止まり、同じファイルは1回だけ。元のファイルが無ければ失敗
+//   - キャッシュキー: 同じ入力では同じ。インクルード先の内容・プロファイル・マクロ定義が変わると変わる
+//   - キャッシュファイル: 読み戻せる。キーの違い・途中で切れたもの・中身の破損・ヘッダーより短いものは読まない
+//   - マニフェスト: 書いたものを読み戻せる。壊れた行は読み飛ばす
+//
+// 使い方: ShaderCacheTest
+
+#include "Engine/Graphics/Shader/ShaderCacheFormat.h"
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+    using namespace ShaderCacheFormat;
+
+    uint32_t failureCount = 0;
+
+    void Check(bool condition, const char* description)
+    {
+        if (!condition) {
+            std::printf("FAILED: %s\n", description);
+            ++failureCount;
+        }
+    }
+
+    /// @brief メモリ上のファイル（キーは正規化した '/' 区切りのパス）
+    struct MemoryFiles {
+        std::map<std::string, std::string> files;
+
+        FileReader Reader()
+        {
+            return [this](const std::filesystem::path& path, std::string& outContents) {
+                const auto it = files.find(path.lexically_normal().generic_string());
+                if (it == files.end()) {
+                    return false;
+                }
+                outContents = it->second;
+                return true;
+            };
+        }
+    };
+
+    std::vector<std::string> ToStrings(const std::vector<std::filesystem::path>& paths)
+    {
+        std::vector<std::string> result;
+        for (const auto& path : paths) {
+            result.push_back(path.generic_string());
+        }
+        return result;
+    }
+
+    void TestExtractIncludes()
+    {
+        const std::string source =
+            "#include \"a.hlsli\"\n"
+            "  #  include<b.hlsli>\n"
+            "// #include \"line.hlsli\"\n"
+            "float x; // #include \"trailing.hlsli\"\n"
+            "/* #include \"block.hlsli\"\n"
+            "   #include <block2.hlsli> */#include\"c.hlsli\"\n"
+            "#include \"\"\n"
+            "#include \"unterminated.hlsli\n"
+            "#define include \"not_include.hlsli\"\n";
+        const std::vector<std::string> expected = { "a.hlsli", "<b.hlsli", "c.hlsli" };
+        Check(ExtractIncludes(source) == expected, "ExtractIncludes skips comments and keeps <...> marked");
+    }
+
+    void TestCollectDependencies()
+    {
+        MemoryFiles memory;
+        memory.files = {
+            { "S/P/x.hlsl", "#include \"y.hlsli\"\n#include \"../C/z.hlsli\"\n#include <w.hlsli>\n" },
+            { "S/P/y.hlsli", "#include \"../C/z.hlsli\"\nY" },
+            { "S/P/w.hlsli", "local w" },     // "..." なら見つかるが <...> では探さない
+            { "S/C/z.hlsli", "Z" },
+            { "S/w.hlsli", "include dir w" },
+        };
+        const FileReader reader = memory.Reader();
+        const std::vector<std::filesystem::path> includeDirs = { "S" };
+
+        std::vector<std::filesystem::path> dependencies;
+        std::vector<std::string> contents;
+        Check(CollectDependencies("S/P/x.hlsl", includeDirs, reader, dependencies, contents),
+            "CollectDependencies succeeds");
+        const std::vector<std::string> expected = { "S/P/x.hlsl", "S/P/y.hlsli", "S/C/z.hlsli", "S/w.hlsli" };
+        Check(ToStrings(dependencies) == expected, "dependencies are depth-first, once each, <...> from include dirs only");
+        Check(contents.size() == dependencies.size() && contents.back() == "include dir w", "contents match dependencies");
+
+        // 循環インクルード（z → y → z）
+        memory.files["S/C/z.hlsli"] = "#include \"../P/y.hlsli\"\n";
+        Check(CollectDependencies("S/P/x.hlsl", includeDirs, reader, dependencies, contents), "cyclic includes succeed");
+        Check(ToStrings(dependencies) == expected, "cyclic includes visit each file once");
+
+        // 見つからないインクルードは飛ばし、元のファイルが無いときだけ失敗
+        memory.files["S/P/y.hlsli"] = "#include \"missing.hlsli\"\n#include <missing.hlsli>\n";
+        Check(CollectDependencies("S/P/x.hlsl", includeDirs, reader, dependencies, contents), "missing includes are skipped");
+        Check(dependencies.size() == 4, "missing includes are not listed");
+        Check(!CollectDependencies("S/P/none.hlsl", includeDirs, reader, dependencies, contents), "missing source fails");
+    }
+
+    void TestComputeKey()
+    {
+        MemoryFiles memory;
+        memory.files = {
+            { "S/P/x.hlsl", "#include \"y.hlsli\"\n" },
+            { "S/P/y.hlsli", "#include <z.hlsli>\n" },
+            { "S/z.hlsli", "Z" },
+        };
+        const FileReader reader = memory.Reader();
+        const std::vector<std::filesystem::path> includeDirs = { "S" };
+
+        ShaderCompileRequest request{ L"S/P/x.hlsl", L"ps_6_0", {} };
+        uint64_t base = 0;
+        uint64_t key = 0;
+        std::vector<std::filesystem::path> dependencies;
+        Check(ComputeKey(request, includeDirs, reader, base, &dependencies), "ComputeKey succeeds");
+        Check(dependencies.size() == 3, "ComputeKey reports dependencies");
+        Check(ComputeKey(request, includeDirs, reader, key) && key == base, "same input gives same key");
+
+        memory.files["S/z.hlsli"] = "Z2";
+        Check(ComputeKey(request, includeDirs, reader, key) && key != base, "editing a nested include changes the key");
+        memory.files["S/z.hlsli"] = "Z";
+        Check(ComputeKey(request, includeDirs, reader, key) && key == base, "restoring the include restores the key");
+
+        // 内容が同じでも別のファイルに差し替わればキーが変わる
+        memory.files["S/P/z.hlsli"] = "Z";
+        memory.files["S/P/y.hlsli"] = "#include \"z.hlsli\"\n";
+        Check(ComputeKey(request, includeDirs, reader, key) && key != base, "resolving to another file changes the key");
+        memory.files["S/P/y.hlsli"] = "#include <z.hlsli>\n";
+
+        request.profile = L"vs_6_0";
+        Check(ComputeKey(request, includeDirs, reader, key) && key != base, "profile change changes the key");
+        request.profile = L"ps_6_0";
+
+        request.defines = { L"A" };
+        uint64_t withA = 0;
+        Check(ComputeKey(request, includeDirs, reader, withA) && withA != base, "adding a define changes the key");
+        request.defines = { L"A=1" };
+        Check(ComputeKey(request, includeDirs, reader, key) && key != withA, "define value change changes the key");
+        // 区切りを含めてハッシュするので、連結すると同じになる組み合わせでも区別する
+        request.defines = { L"AB" };
+        uint64_t joined = 0;
+        ComputeKey(request, includeDirs, reader, joined);
+        request.defines = { L"A", L"B" };
+        Check(ComputeKey(request, includeDirs, reader, key) && key != joined, "define boundaries are part of the key");
+
+        request.filePath = L"S/P/none.hlsl";
+        Check(!ComputeKey(request, includeDirs, reader, key), "ComputeKey fails for a missing source");
+    }
+
+    void TestBlob()
+    {
+        const char data[] = "dxil bytecode";
+        const size_t dataSize = sizeof(data) - 1;
+        const std::vector<uint8_t> blob = SerializeBlob(42, data, dataSize);
+
+        size_t offset = 0;
+        size_t size = 0;
+        Check(DeserializeBlob(blob, 42, offset, size) && size == dataSize &&
+            std::memcmp(blob.data() + offset, data, dataSize) == 0, "blob round-trips");
+        Check(!DeserializeBlob(blob, 43, offset, size), "wrong key is rejected");
+
+        std::vector<uint8_t> broken = blob;
+        broken.back() ^= 1;
+        Check(!DeserializeBlob(broken, 42, offset, size), "corrupted data is rejected");
+
+        bool isTruncatedRejected = true;
+        for (size_t length = 0; length < blob.size(); ++length) {
+            broken.assign(blob.begin(), blob.begin() + length);
+            isTruncatedRejected = !DeserializeBlob(broken, 42, offset, size) && isTruncatedRejected;
+        }
+        Check(isTruncatedRejected, "every truncated blob is rejected");
+
+        broken = blob;
+        broken.push_back(0);
+        Check(!DeserializeBlob(broken, 42, offset, size), "trailing bytes are rejected");
+
+        const std::vector<uint8_t> empty = SerializeBlob(7, nullptr, 0);
+        Check(DeserializeBlob(empty, 7, offset, size) && size == 0, "empty blob round-trips");
+    }
+
+    void TestManifest()
+    {
+        const std::vector<ShaderCompileRequest> requests = {
+            { L"Resources/Shader/a.hlsl", L"vs_6_0", {} },
+            { L"b.hlsl", L"ps_6_0", { L"X", L"Y=1" } },
+        };
+        Check(ParseManifest(SerializeManifest(requests)) == requests, "manifest round-trips");
+        Check(ParseManifest("garbage\n\t\t\nps_6_0\t\t\n").empty(), "broken manifest lines are skipped");
+        Check(ToHexString(0xabc) == "0000000000000abc", "ToHexString pads to 16 digits");
+    }
+
+}
+
+int main()
+{
+    TestExtractIncludes();
+    TestCollectDependencies();
+    TestComputeKey();
+    TestBlob();
+    TestManifest();
+
+    std::printf("%s (%u failures)\n", failureCount == 0 ? "passed" : "FAILED", failureCount);
+    return failureCount == 0 ? 0 : 1;
+}
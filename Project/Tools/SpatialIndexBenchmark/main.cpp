@@ -0,0 +1,255 @@
+// 空間インデックス（LooseOctree）の速度の計測
+// オブジェクトの数ごとに、アリーナ（BaseScene と同じ ±256 の範囲）を動き回るオブジェクトで次を測る。
+//   - 位置更新: 全オブジェクトを毎フレーム動かして Update する（WorldTransform::TransferMatrix と同じ呼び方）
+//   - 視錐台検索: 描画カリングと同じ透視カメラの視錐台
+//   - 球検索: 半径20の近傍検索（QueryRadius）
+//   - 最近傍検索: 近い順に8個（QueryNearest）
+// 比較用に全オブジェクトを調べる方式も測り、結果が一致することを確かめる（一致しなければ終了コード1）。
+//
+// 使い方: SpatialIndexBenchmark [--counts <数,数,...>] [--frames <数>] [--queries <数>]
+//   --counts <...>  オブジェクトの数（既定: 10000,100000）
+//   --frames <数>   位置更新のフレーム数（既定: 60）
+//   --queries <数>  球検索・最近傍検索の回数（既定: 1000）
+//   --depth <数>    八分木の最大分割深度（既定: 5。BaseScene と同じ）
+
+#include "Engine/Scene/SpatialIndex/LooseOctree.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    constexpr float kWorldHalfSize = 256.0f;  // BaseScene と同じ
+    constexpr float kArenaHalfSize = 240.0f;  // オブジェクトが動く範囲
+    constexpr float kQueryRadius = 20.0f;
+    constexpr size_t kNearestCount = 8;
+
+    double ElapsedMilliseconds(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    std::vector<uint32_t> ParseList(char* text)
+    {
+        std::vector<uint32_t> values;
+        while (*text != '\0') {
+            char* next = nullptr;
+            values.push_back(static_cast<uint32_t>(std::strtoul(text, &next, 10)));
+            text = *next == ',' ? next + 1 : next;
+        }
+        return values;
+    }
+
+    /// @brief 動き回るオブジェクト（userData は番号+1）
+    struct Objects {
+        std::vector<Vector3> centers;
+        std::vector<Vector3> velocities;
+        std::vector<float> radii;
+        std::vector<LooseOctree::Handle> handles;
+    };
+
+    void* ToUserData(uint32_t index)
+    {
+        return reinterpret_cast<void*>(static_cast<uintptr_t>(index) + 1);
+    }
+
+    float DistanceSquared(const Vector3& a, const Vector3& b)
+    {
+        const Vector3 diff = { a.x - b.x, a.y - b.y, a.z - b.z };
+        return diff.x * diff.x + diff.y * diff.y + diff.z * diff.z;
+    }
+
+    /// @brief 1フレーム分動かす（範囲の端で跳ね返る）
+    void Move(Objects& objects, uint32_t index, float deltaTime)
+    {
+        Vector3& center = objects.centers[index];
+        Vector3& velocity = objects.velocities[index];
+        center = { center.x + velocity.x * deltaTime, center.y + velocity.y * deltaTime, center.z + velocity.z * deltaTime };
+        float* position[3] = { &center.x, &center.y, &center.z };
+        float* speed[3] = { &velocity.x, &velocity.y, &velocity.z };
+        for (int axis = 0; axis < 3; ++axis) {
+            if (std::fabs(*position[axis]) > kArenaHalfSize) {
+                *speed[axis] = -*speed[axis];
+            }
+        }
+    }
+
+    /// @brief 結果が同じ集合か（並びは問わない）
+    bool SameSet(std::vector<void*> a, std::vector<void*> b)
+    {
+        std::sort(a.begin(), a.end());
+        std::sort(b.begin(), b.end());
+        return a == b;
+    }
+
+    bool RunCount(uint32_t count, uint32_t frames, uint32_t queries, uint32_t maxDepth)
+    {
+        std::mt19937 random(count);
+        std::uniform_real_distribution<float> position(-kArenaHalfSize, kArenaHalfSize);
+        std::uniform_real_distribution<float> height(0.0f, 20.0f);
+        std::uniform_real_distribution<float> speed(-8.0f, 8.0f);
+        std::uniform_real_distribution<float> radius(0.5f, 3.0f);
+
+        Objects objects;
+        objects.centers.resize(count);
+        objects.velocities.resize(count);
+        objects.radii.resize(count);
+        objects.handles.resize(count);
+
+        LooseOctree octree;
+        octree.Initialize({ 0.0f, 0.0f, 0.0f }, kWorldHalfSize, maxDepth);
+        Clock::time_point start = Clock::now();
+        for (uint32_t i = 0; i < count; ++i) {
+            objects.centers[i] = { position(random), height(random), position(random) };
+            objects.velocities[i] = { speed(random), 0.0f, speed(random) };
+            objects.radii[i] = radius(random);
+            objects.handles[i] = octree.Insert(ToUserData(i), objects.centers[i], objects.radii[i]);
+        }
+        const double insertMilliseconds = ElapsedMilliseconds(start);
+
+        // 位置更新
+        uint64_t reinsertCount = 0;
+        start = Clock::now();
+        for (uint32_t frame = 0; frame < frames; ++frame) {
+            octree.ResetFrameStats();
+            for (uint32_t i = 0; i < count; ++i) {
+                Move(objects, i, 1.0f / 60.0f);
+                octree.Update(objects.handles[i], objects.centers[i], objects.radii[i]);
+            }
+            reinsertCount += octree.GetStats().reinsertCount;
+        }
+        const double refitMilliseconds = ElapsedMilliseconds(start) / frames;
+
+        bool isConsistent = true;
+        std::vector<void*> results;
+        std::vector<void*> expected;
+
+        // 視錐台検索（アリーナの端から中央を見下ろすカメラ）
+        const Matrix4x4 view = MathCore::Matrix::Inverse(
+            MathCore::Matrix::MakeAffine(Vector3{ 1.0f, 1.0f, 1.0f }, Vector3{ 0.4f, 0.0f, 0.0f }, Vector3{ 0.0f, 60.0f, -kArenaHalfSize }));
+        const Matrix4x4 projection = MathCore::Rendering::PerspectiveFov(0.45f, 16.0f / 9.0f, 0.1f, 400.0f);
+        const Frustum frustum = Frustum::FromMatrix(MathCore::Matrix::Multiply(view, projection));
+        constexpr uint32_t kFrustumRepeat = 20;
+        start = Clock::now();
+        for (uint32_t i = 0; i < kFrustumRepeat; ++i) {
+            results.clear();
+            octree.QueryFrustum(frustum, results);
+        }
+        const double frustumMilliseconds = ElapsedMilliseconds(start) / kFrustumRepeat;
+        start = Clock::now();
+        for (uint32_t i = 0; i < kFrustumRepeat; ++i) {
+            expected.clear();
+            for (uint32_t j = 0; j < count; ++j) {
+                if (frustum.IntersectsSphere(objects.centers[j], objects.radii[j])) {
+                    expected.push_back(ToUserData(j));
+                }
+            }
+        }
+        const double frustumBruteMilliseconds = ElapsedMilliseconds(start) / kFrustumRepeat;
+        const size_t visibleCount = results.size();
+        const bool isFrustumSame = SameSet(results, expected);
+
+        // 球検索
+        std::vector<Vector3> points(queries);
+        for (Vector3& point : points) {
+            point = { position(random), height(random), position(random) };
+        }
+        uint64_t radiusHits = 0;
+        uint32_t radiusMismatches = 0;
+        double radiusMicroseconds = 0.0;
+        double radiusBruteMicroseconds = 0.0;
+        for (const Vector3& point : points) {
+            results.clear();
+            start = Clock::now();
+            octree.QueryRadius(point, kQueryRadius, results);
+            radiusMicroseconds += ElapsedMilliseconds(start) * 1000.0;
+
+            expected.clear();
+            start = Clock::now();
+            for (uint32_t j = 0; j < count; ++j) {
+                const float reach = kQueryRadius + objects.radii[j];
+                if (DistanceSquared(objects.centers[j], point) <= reach * reach) {
+                    expected.push_back(ToUserData(j));
+                }
+            }
+            radiusBruteMicroseconds += ElapsedMilliseconds(start) * 1000.0;
+            radiusHits += results.size();
+            radiusMismatches += SameSet(results, expected) ? 0 : 1;
+        }
+
+        // 最近傍検索（同じ距離は無いとして、近い順の並びまで比べる）
+        uint32_t nearestMismatches = 0;
+        double nearestMicroseconds = 0.0;
+        double nearestBruteMicroseconds = 0.0;
+        std::vector<std::pair<float, uint32_t>> sorted(count);
+        for (const Vector3& point : points) {
+            results.clear();
+            start = Clock::now();
+            octree.QueryNearest(point, kNearestCount, results);
+            nearestMicroseconds += ElapsedMilliseconds(start) * 1000.0;
+
+            start = Clock::now();
+            for (uint32_t j = 0; j < count; ++j) {
+                sorted[j] = { DistanceSquared(objects.centers[j], point), j };
+            }
+            std::partial_sort(sorted.begin(), sorted.begin() + kNearestCount, sorted.end());
+            nearestBruteMicroseconds += ElapsedMilliseconds(start) * 1000.0;
+            bool isSame = results.size() == kNearestCount;
+            for (size_t k = 0; isSame && k < kNearestCount; ++k) {
+                isSame = results[k] == ToUserData(sorted[k].second);
+            }
+            nearestMismatches += isSame ? 0 : 1;
+        }
+        isConsistent = isFrustumSame && radiusMismatches == 0 && nearestMismatches == 0 && isConsistent;
+
+        const LooseOctree::Stats& stats = octree.GetStats();
+        std::printf("%7u objects: insert %.2f ms, nodes %u\n", count, insertMilliseconds, stats.nodeCount);
+        std::printf("  refit    %8.3f ms/frame (%.1f reinserts/frame)\n", refitMilliseconds, static_cast<double>(reinsertCount) / frames);
+        std::printf("  frustum  %8.3f ms/query (brute %.3f ms), visible %zu, %s\n",
+            frustumMilliseconds, frustumBruteMilliseconds, visibleCount, isFrustumSame ? "match" : "MISMATCH");
+        std::printf("  radius   %8.2f us/query (brute %.2f us), %.1f hits/query, mismatches %u\n",
+            radiusMicroseconds / queries, radiusBruteMicroseconds / queries, static_cast<double>(radiusHits) / queries, radiusMismatches);
+        std::printf("  nearest  %8.2f us/query (brute %.2f us), k=%zu, mismatches %u\n",
+            nearestMicroseconds / queries, nearestBruteMicroseconds / queries, kNearestCount, nearestMismatches);
+        return isConsistent;
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<uint32_t> counts = { 10000, 100000 };
+    uint32_t frames = 60;
+    uint32_t queries = 1000;
+    uint32_t maxDepth = 5;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--counts") == 0 && i + 1 < argc) {
+            counts = ParseList(argv[++i]);
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = (std::max)(1u, static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10)));
+        } else if (std::strcmp(argv[i], "--queries") == 0 && i + 1 < argc) {
+            queries = (std::max)(1u, static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10)));
+        } else if (std::strcmp(argv[i], "--depth") == 0 && i + 1 < argc) {
+            maxDepth = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::printf("usage: SpatialIndexBenchmark [--counts <n,n,...>] [--frames <n>] [--queries <n>] [--depth <n>]\n");
+            return 1;
+        }
+    }
+
+    bool isConsistent = true;
+    for (uint32_t count : counts) {
+        isConsistent = RunCount((std::max)(count, 1u), frames, queries, maxDepth) && isConsistent;
+    }
+    std::printf("%s\n", isConsistent ? "consistent" : "NOT consistent");
+    return isConsistent ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+// スプライトのバッチ構築（SpriteBatch）の速度の計測
+// スプライトの数ごとに、毎フレーム全スプライトを Add して Build する時間（CPU側のみ）を測る。
+//   - 混在: テクスチャ・レイヤー・ブレンドモードをばらばらに使う（文字やUIの部品が混ざった画面）
+//   - 整列済み: 1枚のテクスチャ・1レイヤー・1ブレンドモードだけ（ソートを省く場合）
+// 描画回数は、スプライトごとに描いていた場合（スプライト数）とランの数を並べて出す。
+// 比較用に追加順で安定ソートした並びも作り、書き出した頂点の並びとランが一致することを確かめる
+// （一致しなければ終了コード1）。
+//
+// 使い方: SpriteBatchBenchmark [--counts <数,数,...>] [--frames <数>] [--textures <数>] [--layers <数>]
+//   --counts <...>   スプライトの数（既定: 1000,10000,50000）
+//   --frames <数>    計測するフレーム数（既定: 60）
+//   --textures <数>  使うテクスチャの数（既定: 8）
+//   --layers <数>    使うレイヤーの数（既定: 2）
+
+#include "Engine/Graphics/Render/Sprite/SpriteBatch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    double ElapsedMilliseconds(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    std::vector<uint32_t> ParseList(char* text)
+    {
+        std::vector<uint32_t> values;
+        while (*text != '\0') {
+            char* next = nullptr;
+            values.push_back(static_cast<uint32_t>(std::strtoul(text, &next, 10)));
+            text = *next == ',' ? next + 1 : next;
+        }
+        return values;
+    }
+
+    /// @brief 描画要求を作る（左端の x に番号を入れ、書き出した頂点から元のスプライトが分かるようにする）
+    std::vector<SpriteQuadDesc> MakeDescs(uint32_t count, uint32_t textures, uint32_t layers, bool isBlendMixed, uint32_t seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<uint32_t> texture(0, textures - 1);
+        std::uniform_int_distribution<uint32_t> layer(0, layers - 1);
+        std::uniform_int_distribution<uint32_t> blend(0, 9);
+
+        std::vector<SpriteQuadDesc> descs(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            SpriteQuadDesc& desc = descs[i];
+            desc.wvp.m[0][0] = 16.0f;
+            desc.wvp.m[1][1] = 16.0f;
+            desc.wvp.m[3][0] = static_cast<float>(i);
+            desc.left = 0.0f;
+            desc.right = 1.0f;
+            desc.textureKey = 0x1000 + texture(random) * 0x20;
+            desc.layer = static_cast<int32_t>(layer(random)) - 1;
+            desc.blendMode = (isBlendMixed && blend(random) == 0) ? 2 : 1;   // 混在させる場合は1割だけ加算
+        }
+        return descs;
+    }
+
+    /// @brief 追加順で安定ソートした場合の並び（レイヤー → ブレンド → テクスチャの初出順）と比べる
+    bool IsSameAsReference(const std::vector<SpriteQuadDesc>& descs, const std::vector<SpriteBatchVertex>& vertices,
+        const std::vector<SpriteBatch::Run>& runs)
+    {
+        std::unordered_map<uint64_t, uint32_t> firstSeen;
+        for (const SpriteQuadDesc& desc : descs) {
+            firstSeen.try_emplace(desc.textureKey, static_cast<uint32_t>(firstSeen.size()));
+        }
+        std::vector<uint32_t> order(descs.size());
+        for (uint32_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            const SpriteQuadDesc& da = descs[a];
+            const SpriteQuadDesc& db = descs[b];
+            if (da.layer != db.layer) {
+                return da.layer < db.layer;
+            }
+            if (da.blendMode != db.blendMode) {
+                return da.blendMode < db.blendMode;
+            }
+            return firstSeen[da.textureKey] < firstSeen[db.textureKey];
+        });
+
+        // 頂点の並び
+        for (uint32_t i = 0; i < order.size(); ++i) {
+            if (vertices[i * SpriteBatch::kVerticesPerQuad].position.x != static_cast<float>(order[i])) {
+                return false;
+            }
+        }
+
+        // ランは状態が変わるところで切れ、全体を隙間なく覆う
+        uint32_t next = 0;
+        for (const SpriteBatch::Run& run : runs) {
+            if (run.firstQuad != next || run.quadCount == 0) {
+                return false;
+            }
+            for (uint32_t i = run.firstQuad; i < run.firstQuad + run.quadCount; ++i) {
+                const SpriteQuadDesc& desc = descs[order[i]];
+                if (desc.textureKey != run.textureKey || desc.blendMode != run.blendMode || desc.layer != run.layer) {
+                    return false;
+                }
+            }
+            if (next > 0) {
+                const SpriteQuadDesc& previous = descs[order[next - 1]];
+                if (previous.textureKey == run.textureKey && previous.blendMode == run.blendMode && previous.layer == run.layer) {
+                    return false;
+                }
+            }
+            next += run.quadCount;
+        }
+        return next == order.size();
+    }
+
+    bool RunCase(const char* name, const std::vector<SpriteQuadDesc>& descs, uint32_t frames)
+    {
+        SpriteBatch batch;
+        std::vector<SpriteBatchVertex> vertices(descs.size() * SpriteBatch::kVerticesPerQuad);
+        double addMilliseconds = 0.0;
+        double buildMilliseconds = 0.0;
+        for (uint32_t frame = 0; frame < frames; ++frame) {
+            Clock::time_point start = Clock::now();
+            batch.Clear();
+            for (const SpriteQuadDesc& desc : descs) {
+                batch.Add(desc);
+            }
+            addMilliseconds += ElapsedMilliseconds(start);
+
+            start = Clock::now();
+            batch.Build(vertices.data());
+            buildMilliseconds += ElapsedMilliseconds(start);
+        }
+
+        const bool isSame = IsSameAsReference(descs, vertices, batch.GetRuns());
+        std::printf("  %-8s add %7.3f ms, build %7.3f ms, total %7.3f ms/frame, draws %zu (per sprite %zu), %s\n",
+            name, addMilliseconds / frames, buildMilliseconds / frames, (addMilliseconds + buildMilliseconds) / frames,
+            batch.GetRuns().size(), descs.size(), isSame ? "match" : "MISMATCH");
+        return isSame;
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<uint32_t> counts = { 1000, 10000, 50000 };
+    uint32_t frames = 60;
+    uint32_t textures = 8;
+    uint32_t layers = 2;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--counts") == 0 && i + 1 < argc) {
+            counts = ParseList(argv[++i]);
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = (std::max)(1u, static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10)));
+        } else if (std::strcmp(argv[i], "--textures") == 0 && i + 1 < argc) {
+            textures = (std::max)(1u, static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10)));
+        } else if (std::strcmp(argv[i], "--layers") == 0 && i + 1 < argc) {
+            layers = (std::max)(1u, static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10)));
+        } else {
+            std::printf("usage: SpriteBatchBenchmark [--counts <n,n,...>] [--frames <n>] [--textures <n>] [--layers <n>]\n");
+            return 1;
+        }
+    }
+
+    bool isConsistent = true;
+    for (uint32_t count : counts) {
+        count = (std::clamp)(count, 1u, SpriteBatch::kMaxQuadCount);
+        std::printf("%u sprites (%u textures, %u layers)\n", count, textures, layers);
+        isConsistent = RunCase("mixed", MakeDescs(count, textures, layers, true, count), frames) && isConsistent;
+        isConsistent = RunCase("sorted", MakeDescs(count, 1, 1, false, count), frames) && isConsistent;
+    }
+    std::printf("%s\n", isConsistent ? "consistent" : "NOT consistent");
+    return isConsistent ? 0 : 1;
+}
@@ -0,0 +1,171 @@
+// テクスチャの事前変換ツール
+// 実行時と同じキー・同じ処理でキャッシュ（<出力先>/<キー>.dds）を作るので、
+// 変換済みのテクスチャは初回読み込み時の変換が不要になる。
+//
+// 使い方: TextureCooker [オプション] <ファイルまたはディレクトリ>...
+//   -o <ディレクトリ>  出力先（既定: Cache/Texture、Project ディレクトリから実行する想定）
+//   --format <名前>    auto / bc7 / bc1 / bc4 / rgba8（既定: auto）
+//   --linear          sRGBとして扱わない
+//   --no-mips         ミップマップを作らない
+//   --force           キャッシュがあっても作り直す
+//   -j <数>           圧縮のスレッド数（既定: ハードウェアのスレッド数）
+
+#include "Engine/Graphics/Texture/TextureCooker.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+    void PrintUsage()
+    {
+        std::printf(
+            "usage: TextureCooker [options] <file or directory>...\n"
+            "  -o <dir>         output cache directory (default: Cache/Texture)\n"
+            "  --format <name>  auto | bc7 | bc1 | bc4 | rgba8 (default: auto)\n"
+            "  --linear         treat colors as linear instead of sRGB\n"
+            "  --no-mips        do not generate mipmaps\n"
+            "  --force          cook even if the cache file exists\n"
+            "  -j <count>       encoder threads (default: hardware threads)\n");
+    }
+
+    bool ParseFormat(const char* name, TextureCookFormat& outFormat)
+    {
+        const TextureCookFormat formats[] = {
+            TextureCookFormat::Auto, TextureCookFormat::BC7, TextureCookFormat::BC1,
+            TextureCookFormat::BC4, TextureCookFormat::RGBA8,
+        };
+        for (TextureCookFormat format : formats) {
+            if (std::strcmp(name, TextureCooker::GetFormatName(format)) == 0) {
+                outFormat = format;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief 入力を変換対象のファイル一覧にする（ディレクトリは再帰的にPNGを探す）
+    void CollectInputs(const std::filesystem::path& input, std::vector<std::filesystem::path>& outFiles)
+    {
+        std::error_code ec;
+        if (!std::filesystem::is_directory(input, ec)) {
+            outFiles.push_back(input);
+            return;
+        }
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(input, ec)) {
+            if (!entry.is_regular_file()) {
+                continue;
+            }
+            std::string extension = entry.path().extension().string();
+            for (char& c : extension) {
+                c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+            if (extension == ".png") {
+                outFiles.push_back(entry.path());
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::filesystem::path cacheDirectory = "Cache/Texture";
+    TextureCookSettings settings;
+    bool force = false;
+    uint32_t workerCount = 0;
+    std::vector<std::filesystem::path> files;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "-o") == 0 && i + 1 < argc) {
+            cacheDirectory = argv[++i];
+        } else if (std::strcmp(arg, "--format") == 0 && i + 1 < argc) {
+            if (!ParseFormat(argv[++i], settings.format)) {
+                std::fprintf(stderr, "unknown format: %s\n", argv[i]);
+                return 2;
+            }
+        } else if (std::strcmp(arg, "--linear") == 0) {
+            settings.srgb = false;
+        } else if (std::strcmp(arg, "--no-mips") == 0) {
+            settings.generateMips = false;
+        } else if (std::strcmp(arg, "--force") == 0) {
+            force = true;
+        } else if (std::strcmp(arg, "-j") == 0 && i + 1 < argc) {
+            workerCount = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (arg[0] == '-') {
+            PrintUsage();
+            return 2;
+        } else {
+            CollectInputs(arg, files);
+        }
+    }
+
+    if (files.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDirectory, ec);
+
+    uint32_t cookedCount = 0;
+    uint32_t cachedCount = 0;
+    uint32_t failedCount = 0;
+    uint64_t sourceBytes = 0;
+    uint64_t cookedBytes = 0;
+
+    for (const std::filesystem::path& file : files) {
+        std::vector<uint8_t> source;
+        if (!TextureCooker::ReadFile(file, source)) {
+            std::fprintf(stderr, "failed  %s: cannot read\n", file.string().c_str());
+            ++failedCount;
+            continue;
+        }
+
+        std::filesystem::path cachePath = TextureCooker::GetCachePath(
+            cacheDirectory, TextureCooker::ComputeKey(source.data(), source.size(), settings));
+        if (!force && std::filesystem::exists(cachePath, ec)) {
+            std::printf("cached  %s\n", file.string().c_str());
+            ++cachedCount;
+            continue;
+        }
+
+        TextureImage image;
+        std::string error;
+        if (!TextureCooker::DecodeImage(source.data(), source.size(), image, &error)) {
+            std::fprintf(stderr, "failed  %s: %s\n", file.string().c_str(), error.c_str());
+            ++failedCount;
+            continue;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        CookedTexture cooked;
+        TextureCooker::Cook(image, settings, cooked, workerCount);
+        double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (!TextureCooker::WriteFileAtomic(cachePath, cooked.dds)) {
+            std::fprintf(stderr, "failed  %s: cannot write %s\n", file.string().c_str(), cachePath.string().c_str());
+            ++failedCount;
+            continue;
+        }
+
+        std::printf("cooked  %s -> %s (%ux%u, %s%s, %u mips, %zu bytes, %.1f ms)\n",
+            file.string().c_str(), cachePath.filename().string().c_str(),
+            cooked.width, cooked.height, TextureCooker::GetFormatName(cooked.format), cooked.srgb ? " srgb" : "",
+            cooked.mipCount, cooked.dds.size(), milliseconds);
+        ++cookedCount;
+        sourceBytes += image.pixels.size();
+        cookedBytes += cooked.dds.size();
+    }
+
+    std::printf("%u cooked, %u cached, %u failed", cookedCount, cachedCount, failedCount);
+    if (cookedCount > 0) {
+        std::printf(" (%.1f MB RGBA8 -> %.1f MB)", sourceBytes / 1048576.0, cookedBytes / 1048576.0);
+    }
+    std::printf("\n");
+    return failedCount > 0 ? 1 : 0;
+}
@@ -0,0 +1,383 @@
+// タイマー（TimerService・GameTimer）の速度の計測
+// 動いているタイマーの数ごとに次を測る。
+//   - 更新: ループするタイマー（進行率 25%・75% のコールバック付き）を毎フレーム進める
+//           比較用に、以前の GameTimer と同じく各タイマーを個別に Update してコールバックの配列を走査する方式も測る
+//   - 開始・停止: 全タイマーを Start してから Stop する1回あたりの時間
+//   - 一時停止したグループ: 全タイマーのグループを止めたときの更新
+//   - フレーム単位: StartFrames のタイマーの更新
+//   - 長いタイマー: 10～60秒のタイマー（計測中はほとんど期限が来ない）の更新を個別に Update する方式と比べる
+// あわせて、TimerWheel が期限の来た最初の Advance で必ず取り出すこと（数時間先の期限・取り消しを含む）と、
+// ループしないタイマーの終わるフレームが個別に Update する方式と1フレーム以内で一致することを確かめる
+// （一致しなければ終了コード1）。
+//
+// 使い方: TimerBenchmark [--counts <数,数,...>] [--frames <数>]
+//   --counts <...> 動かすタイマーの数（既定: 1000,10000,100000）
+//   --frames <数>  更新のフレーム数（既定: 600）
+
+#include "Engine/Utility/Timer/GameTimer.h"
+#include "Engine/Utility/Timer/TimerService.h"
+#include "Engine/Utility/Timer/TimerWheel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    constexpr float kDeltaTime = 1.0f / 60.0f;
+
+    double ElapsedMicroseconds(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    }
+
+    std::vector<uint32_t> ParseList(char* text)
+    {
+        std::vector<uint32_t> values;
+        while (*text != '\0') {
+            char* next = nullptr;
+            values.push_back(static_cast<uint32_t>(std::strtoul(text, &next, 10)));
+            text = *next == ',' ? next + 1 : next;
+        }
+        return values;
+    }
+
+    /// @brief 以前の GameTimer の更新（持ち主が毎フレーム Update し、コールバックの配列を毎回走査する）
+    class PolledTimer {
+    public:
+        void Start(float duration, bool loop)
+        {
+            duration_ = duration;
+            loop_ = loop;
+            currentTime_ = 0.0f;
+            isActive_ = true;
+            finished_ = false;
+            for (auto& callback : callbacks_) {
+                callback.triggered = false;
+            }
+        }
+
+        void AddCallback(float triggerTime, std::function<void()> callback)
+        {
+            callbacks_.push_back({ triggerTime, std::move(callback), false });
+        }
+
+        void Update(float deltaTime)
+        {
+            if (!isActive_) return;
+            currentTime_ += deltaTime;
+            for (auto& callback : callbacks_) {
+                if (!callback.triggered && currentTime_ >= callback.triggerTime) {
+                    callback.triggered = true;
+                    if (callback.callback) {
+                        callback.callback();
+                    }
+                }
+            }
+            if (currentTime_ >= duration_) {
+                finished_ = true;
+                if (loop_) {
+                    currentTime_ = 0.0f;
+                    finished_ = false;
+                    for (auto& callback : callbacks_) {
+                        callback.triggered = false;
+                    }
+                } else {
+                    isActive_ = false;
+                }
+            }
+        }
+
+        bool IsFinished() const { return finished_; }
+
+    private:
+        struct TimerCallback {
+            float triggerTime;
+            std::function<void()> callback;
+            bool triggered;
+        };
+
+        float currentTime_ = 0.0f;
+        float duration_ = 0.0f;
+        bool isActive_ = false;
+        bool loop_ = false;
+        bool finished_ = false;
+        std::vector<TimerCallback> callbacks_;
+    };
+
+    std::vector<float> MakeDurations(uint32_t count, uint32_t seed, float minDuration = 0.5f, float maxDuration = 5.0f)
+    {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> distribution(minDuration, maxDuration);
+        std::vector<float> durations(count);
+        for (float& duration : durations) {
+            duration = distribution(random);
+        }
+        return durations;
+    }
+
+    /// @brief TimerWheel を総当たりと比べる（期限が来た最初の Advance で1回だけ取り出されるか）
+    bool ValidateWheel()
+    {
+        std::mt19937 random(7);
+        TimerWheel wheel;
+        wheel.Initialize(0.001);
+
+        struct Expected {
+            double deadline;
+            uint32_t entry;
+            bool isPending;
+            bool isCancelled;
+        };
+        std::vector<Expected> expected;
+        std::vector<uint8_t> fired;
+        double time = 0.0;
+        uint32_t errors = 0;
+        uint64_t firedCount = 0;
+
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        for (uint32_t step = 0; step < 20000; ++step) {
+            // 近い期限から数時間先（最上段を超える）まで
+            const uint32_t insertCount = 1 + random() % 8;
+            for (uint32_t i = 0; i < insertCount; ++i) {
+                const double range = std::pow(10.0, unit(random) * 5.0 - 1.0); // 0.1秒～1万秒
+                const double deadline = time + unit(random) * range - 0.01;
+                const uint32_t id = static_cast<uint32_t>(expected.size());
+                expected.push_back({ deadline, wheel.Insert(deadline, id, 0), true, false });
+                fired.push_back(0);
+            }
+            if (random() % 4 == 0 && !expected.empty()) {
+                Expected& target = expected[random() % expected.size()];
+                if (target.isPending) {
+                    wheel.Cancel(target.entry);
+                    target.isPending = false;
+                    target.isCancelled = true;
+                }
+            }
+
+            // たまに大きく進める（カスケードと最上段の入れ直しを通す）
+            const double advance = random() % 500 == 0 ? unit(random) * 5000.0 : unit(random) * 0.05;
+            time += advance;
+            wheel.Advance(time, [&](uint32_t owner, uint32_t) {
+                Expected& item = expected[owner];
+                if (!item.isPending || item.deadline > time) {
+                    ++errors;
+                }
+                item.isPending = false;
+                ++fired[owner];
+                ++firedCount;
+            });
+
+            for (size_t i = 0; i < expected.size(); ++i) {
+                if (expected[i].isPending && expected[i].deadline <= time) {
+                    ++errors; // 期限が来たのに取り出されていない
+                    expected[i].isPending = false;
+                }
+            }
+        }
+        for (size_t i = 0; i < expected.size(); ++i) {
+            if (fired[i] > 1 || (expected[i].isCancelled && fired[i] != 0)) {
+                ++errors;
+            }
+        }
+
+        std::printf("TimerWheel の整合性: エントリ %zu, 取り出し %llu, 残り %u, 誤り %u\n",
+            expected.size(), static_cast<unsigned long long>(firedCount), wheel.GetCount(), errors);
+        return errors == 0;
+    }
+
+    /// @brief ループしないタイマーの終わるフレームを、個別に Update する方式と比べる
+    bool ValidateFinishFrames(uint32_t count)
+    {
+        const std::vector<float> durations = MakeDurations(count, 3);
+        std::vector<PolledTimer> polled(count);
+        std::vector<GameTimer> timers(count);
+        std::vector<int> polledFrame(count, -1);
+        std::vector<int> serviceFrame(count, -1);
+        for (uint32_t i = 0; i < count; ++i) {
+            polled[i].Start(durations[i], false);
+            timers[i].Start(durations[i], false);
+        }
+
+        TimerService& service = TimerService::GetInstance();
+        for (int frame = 0; frame < 400; ++frame) {
+            service.Update(kDeltaTime);
+            for (uint32_t i = 0; i < count; ++i) {
+                polled[i].Update(kDeltaTime);
+                if (polledFrame[i] < 0 && polled[i].IsFinished()) {
+                    polledFrame[i] = frame;
+                }
+                if (serviceFrame[i] < 0 && timers[i].IsFinished()) {
+                    serviceFrame[i] = frame;
+                }
+            }
+        }
+
+        uint32_t mismatches = 0;
+        int maxDifference = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            const int difference = std::abs(polledFrame[i] - serviceFrame[i]);
+            if (difference != 0) {
+                ++mismatches;
+            }
+            maxDifference = (std::max)(maxDifference, difference);
+        }
+        std::printf("終わるフレームの比較: %u 個中 %u 個が異なる（最大 %d フレーム。float の累積誤差による）\n",
+            count, mismatches, maxDifference);
+        return maxDifference <= 1;
+    }
+
+    void BenchmarkUpdate(uint32_t count, uint32_t frames)
+    {
+        const std::vector<float> durations = MakeDurations(count, 1);
+        uint64_t callbackCount = 0;
+        const auto onCallback = [&callbackCount]() { ++callbackCount; };
+
+        // 個別に Update する方式
+        double polledMicroseconds = 0.0;
+        uint64_t polledCallbacks = 0;
+        {
+            std::vector<PolledTimer> timers(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                timers[i].AddCallback(durations[i] * 0.25f, onCallback);
+                timers[i].AddCallback(durations[i] * 0.75f, onCallback);
+                timers[i].Start(durations[i], true);
+            }
+            callbackCount = 0;
+            const Clock::time_point start = Clock::now();
+            for (uint32_t frame = 0; frame < frames; ++frame) {
+                for (PolledTimer& timer : timers) {
+                    timer.Update(kDeltaTime);
+                }
+            }
+            polledMicroseconds = ElapsedMicroseconds(start) / frames;
+            polledCallbacks = callbackCount;
+        }
+
+        // TimerService
+        TimerService& service = TimerService::GetInstance();
+        double serviceMicroseconds = 0.0;
+        double pausedMicroseconds = 0.0;
+        double startStopNanoseconds = 0.0;
+        uint64_t serviceCallbacks = 0;
+        uint64_t firedCount = 0;
+        {
+            const TimerGroupId group = service.CreateGroup("Benchmark");
+            std::vector<GameTimer> timers(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                timers[i].SetGroup(group);
+                timers[i].Start(durations[i], true);
+                timers[i].AddCallbackAtProgress(0.25f, onCallback);
+                timers[i].AddCallbackAtProgress(0.75f, onCallback);
+            }
+            callbackCount = 0;
+            Clock::time_point start = Clock::now();
+            for (uint32_t frame = 0; frame < frames; ++frame) {
+                service.Update(kDeltaTime);
+                firedCount += service.GetStats().firedCount;
+            }
+            serviceMicroseconds = ElapsedMicroseconds(start) / frames;
+            serviceCallbacks = callbackCount;
+
+            service.SetGroupPaused(group, true);
+            start = Clock::now();
+            for (uint32_t frame = 0; frame < frames; ++frame) {
+                service.Update(kDeltaTime);
+            }
+            pausedMicroseconds = ElapsedMicroseconds(start) / frames;
+            service.SetGroupPaused(group, false);
+
+            start = Clock::now();
+            for (GameTimer& timer : timers) {
+                timer.Stop();
+            }
+            for (uint32_t i = 0; i < count; ++i) {
+                timers[i].Start(durations[i], true);
+            }
+            startStopNanoseconds = ElapsedMicroseconds(start) * 1000.0 / (2.0 * count);
+        }
+
+        // フレーム単位
+        double frameMicroseconds = 0.0;
+        {
+            std::vector<GameTimer> timers(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                timers[i].StartFrames(30 + static_cast<int>(i % 270), true);
+            }
+            const Clock::time_point start = Clock::now();
+            for (uint32_t frame = 0; frame < frames; ++frame) {
+                service.Update(kDeltaTime);
+            }
+            frameMicroseconds = ElapsedMicroseconds(start) / frames;
+        }
+
+        // 長いタイマー（クールダウンなど。期間中はほとんど期限が来ない）
+        double longPolledMicroseconds = 0.0;
+        double longServiceMicroseconds = 0.0;
+        {
+            const std::vector<float> longDurations = MakeDurations(count, 2, 10.0f, 60.0f);
+            std::vector<PolledTimer> polled(count);
+            std::vector<GameTimer> timers(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                polled[i].Start(longDurations[i], false);
+                timers[i].Start(longDurations[i], false);
+            }
+            Clock::time_point start = Clock::now();
+            for (uint32_t frame = 0; frame < frames; ++frame) {
+                for (PolledTimer& timer : polled) {
+                    timer.Update(kDeltaTime);
+                }
+            }
+            longPolledMicroseconds = ElapsedMicroseconds(start) / frames;
+            start = Clock::now();
+            for (uint32_t frame = 0; frame < frames; ++frame) {
+                service.Update(kDeltaTime);
+            }
+            longServiceMicroseconds = ElapsedMicroseconds(start) / frames;
+        }
+
+        std::printf("%7u 個: 個別に Update %9.1f us/フレーム（コールバック %llu） | TimerService %7.1f us/フレーム（コールバック %llu, 期限 %.0f 個/フレーム）\n",
+            count, polledMicroseconds, static_cast<unsigned long long>(polledCallbacks),
+            serviceMicroseconds, static_cast<unsigned long long>(serviceCallbacks), static_cast<double>(firedCount) / frames);
+        std::printf("          一時停止したグループ %.2f us/フレーム | フレーム単位 %.1f us/フレーム | 開始・停止 %.0f ns/回\n",
+            pausedMicroseconds, frameMicroseconds, startStopNanoseconds);
+        std::printf("          長いタイマー（10～60秒、ループなし）: 個別に Update %.1f us/フレーム | TimerService %.2f us/フレーム\n",
+            longPolledMicroseconds, longServiceMicroseconds);
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<uint32_t> counts = { 1000, 10000, 100000 };
+    uint32_t frames = 600;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--counts") == 0 && i + 1 < argc) {
+            counts = ParseList(argv[++i]);
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::printf("使い方: TimerBenchmark [--counts <数,数,...>] [--frames <数>]\n");
+            return 1;
+        }
+    }
+
+    bool isValid = ValidateWheel();
+    isValid = ValidateFinishFrames(10000) && isValid;
+
+    std::printf("\n%u フレーム（%.4f 秒刻み）、ループするタイマー（0.5～5秒）、進行率 25%%・75%% のコールバック\n", frames, kDeltaTime);
+    for (uint32_t count : counts) {
+        BenchmarkUpdate(count, frames);
+    }
+
+    return isValid ? 0 : 1;
+}
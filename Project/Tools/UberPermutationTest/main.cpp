@@ -0,0 +1,207 @@
+// Uberシェーダーの組み合わせの選択とキャッシュ（UberPermutation）の確認
+// 次を確かめる（1つでも失敗すれば終了コード1）。
+//   - TryBuildMask: 適用順が狭義の昇順に並んだステージだけを受け付け、そのステージのビットを立てる。
+//     逆順・重複・範囲外・空は失敗し、マスクは0になる（長さ4までの並びを全て試す）
+//   - ステージの情報: 名前からステージを引き戻せる。まとめられないエフェクトは-1。
+//     定数バッファのレジスタは Fade=b0・ColorGrading=b1・Sepia=b2・Vignette=b3 で、持たないステージは-1
+//   - マクロ定義・表示用の文字列: マスクのビットと同じ数・順番
+//   - キャッシュ: 初回は生成（ミス）、2回目以降は生成せずに同じ値を返す（ヒット）。
+//     Find は統計を変えない。Clear で空になり統計も戻る
+//
+// 使い方: UberPermutationTest
+
+#include "Engine/Graphics/PostEffect/Uber/UberPermutation.h"
+#include "Engine/Graphics/PostEffect/PostEffectNames.h"
+
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+    using UberPermutation::Mask;
+    using UberPermutation::Stage;
+    using UberPermutation::kStageCount;
+
+    uint32_t failureCount = 0;
+
+    void Check(bool condition, const char* description)
+    {
+        if (!condition) {
+            std::printf("FAILED: %s\n", description);
+            ++failureCount;
+        }
+    }
+
+    void TestBuildMask()
+    {
+        Mask mask = 0xFFu;
+        Check(!UberPermutation::TryBuildMask({}, mask) && mask == 0, "empty stages are rejected");
+
+        // 範囲外（Stage::Count）も含めた長さ4までの並びを全て試す
+        constexpr uint32_t kValueCount = kStageCount + 1;
+        uint32_t sequenceCount = 0;
+        uint32_t acceptedCount = 0;
+        bool isMaskCorrect = true;
+        bool isRejectionCorrect = true;
+        for (uint32_t length = 1; length <= 4; ++length) {
+            uint32_t total = 1;
+            for (uint32_t i = 0; i < length; ++i) {
+                total *= kValueCount;
+            }
+            for (uint32_t code = 0; code < total; ++code) {
+                std::vector<Stage> stages(length);
+                uint32_t rest = code;
+                for (Stage& stage : stages) {
+                    stage = static_cast<Stage>(rest % kValueCount);
+                    rest /= kValueCount;
+                }
+
+                bool isIncreasing = true;
+                Mask expected = 0;
+                for (size_t i = 0; i < stages.size(); ++i) {
+                    isIncreasing = isIncreasing && stages[i] < Stage::Count && (i == 0 || stages[i - 1] < stages[i]);
+                    if (stages[i] < Stage::Count) {
+                        expected |= UberPermutation::ToBit(stages[i]);
+                    }
+                }
+
+                mask = 0xFFu;
+                const bool isBuilt = UberPermutation::TryBuildMask(stages, mask);
+                if (isIncreasing) {
+                    isMaskCorrect = isMaskCorrect && isBuilt && mask == expected &&
+                        std::popcount(mask) == static_cast<int>(length);
+                    ++acceptedCount;
+                } else {
+                    isRejectionCorrect = isRejectionCorrect && !isBuilt && mask == 0;
+                }
+                ++sequenceCount;
+            }
+        }
+        Check(isMaskCorrect, "increasing stages build a mask of their bits");
+        Check(isRejectionCorrect, "out-of-order, duplicate and out-of-range stages are rejected with mask 0");
+        std::printf("TryBuildMask: %u sequences, %u accepted\n", sequenceCount, acceptedCount);
+
+        Check(UberPermutation::TryBuildMask({ Stage::Sepia, Stage::Vignette }, mask) && mask == 0x24u, "Sepia+Vignette is bits 2 and 5");
+        Check(!UberPermutation::TryBuildMask({ Stage::Vignette, Stage::Sepia }, mask), "Vignette before Sepia is rejected");
+        Check(!UberPermutation::TryBuildMask({ Stage::Invert, Stage::Invert }, mask), "duplicate Invert is rejected");
+
+        std::vector<Stage> all;
+        for (uint32_t i = 0; i < kStageCount; ++i) {
+            all.push_back(static_cast<Stage>(i));
+        }
+        Check(UberPermutation::TryBuildMask(all, mask) && mask == (1u << kStageCount) - 1, "every stage in order sets every bit");
+    }
+
+    void TestStageInfo()
+    {
+        // 名前からステージを引き戻せる
+        bool isRoundTrip = true;
+        for (uint32_t i = 0; i < kStageCount; ++i) {
+            isRoundTrip = isRoundTrip && UberPermutation::FindStage(UberPermutation::GetStageName(static_cast<Stage>(i))) == static_cast<int32_t>(i);
+        }
+        Check(isRoundTrip, "FindStage(GetStageName(stage)) returns the stage");
+        Check(UberPermutation::FindStage(PostEffectNames::FadeEffect) == 0, "FadeEffect is the first stage");
+        Check(UberPermutation::FindStage(PostEffectNames::Vignette) == static_cast<int32_t>(Stage::Vignette), "Vignette is found");
+        Check(UberPermutation::FindStage(PostEffectNames::Blur) == -1, "Blur cannot be merged");
+        Check(UberPermutation::FindStage(PostEffectNames::Shockwave) == -1, "Shockwave cannot be merged");
+        Check(UberPermutation::FindStage("") == -1, "empty name is not a stage");
+        Check(std::string(UberPermutation::GetStageName(Stage::Count)) == "Unknown", "out-of-range stage name");
+
+        // 定数バッファのスロット（UberColor.PS.hlsl の register(bN) と一致）
+        Check(UberPermutation::GetParamsRegister(Stage::Fade) == 0, "Fade params are b0");
+        Check(UberPermutation::GetParamsRegister(Stage::ColorGrading) == 1, "ColorGrading params are b1");
+        Check(UberPermutation::GetParamsRegister(Stage::Sepia) == 2, "Sepia params are b2");
+        Check(UberPermutation::GetParamsRegister(Stage::Invert) == -1, "Invert has no params");
+        Check(UberPermutation::GetParamsRegister(Stage::GrayScale) == -1, "GrayScale has no params");
+        Check(UberPermutation::GetParamsRegister(Stage::Vignette) == 3, "Vignette params are b3");
+        Check(UberPermutation::GetParamsRegister(Stage::Count) == -1, "out-of-range stage has no params");
+
+        // 定数バッファを持つステージはスロットを1つずつ使う
+        uint32_t usedSlots = 0;
+        bool isUnique = true;
+        for (uint32_t i = 0; i < kStageCount; ++i) {
+            const int32_t slot = UberPermutation::GetParamsRegister(static_cast<Stage>(i));
+            if (slot < 0) {
+                continue;
+            }
+            isUnique = isUnique && slot < static_cast<int32_t>(UberPermutation::kParamsSlotCount) && (usedSlots & (1u << slot)) == 0;
+            usedSlots |= 1u << slot;
+        }
+        Check(isUnique && usedSlots == (1u << UberPermutation::kParamsSlotCount) - 1, "params slots are distinct and fill kParamsSlotCount");
+    }
+
+    void TestDefines()
+    {
+        bool isConsistent = true;
+        for (Mask mask = 0; mask < (1u << kStageCount); ++mask) {
+            const std::vector<std::wstring> defines = UberPermutation::GetDefines(mask);
+            isConsistent = isConsistent && defines.size() == static_cast<size_t>(std::popcount(mask));
+            for (const std::wstring& define : defines) {
+                isConsistent = isConsistent && define.rfind(L"UBER_", 0) == 0;
+            }
+        }
+        Check(isConsistent, "one UBER_ define per mask bit");
+
+        const Mask mask = UberPermutation::ToBit(Stage::Sepia) | UberPermutation::ToBit(Stage::Vignette);
+        const std::vector<std::wstring> defines = UberPermutation::GetDefines(mask);
+        Check(defines.size() == 2 && defines[0] == L"UBER_SEPIA" && defines[1] == L"UBER_VIGNETTE", "defines follow stage order");
+        Check(UberPermutation::ToString(mask) == "Sepia+Vignette", "ToString joins stage names in order");
+        Check(UberPermutation::ToString(0).empty(), "ToString of an empty mask");
+    }
+
+    void TestCache()
+    {
+        UberPermutation::PermutationCache<uint32_t> cache;
+        uint32_t createCount = 0;
+        auto create = [&createCount](Mask mask) {
+            ++createCount;
+            return mask * 10 + 1;
+        };
+
+        const Mask fadeSepia = UberPermutation::ToBit(Stage::Fade) | UberPermutation::ToBit(Stage::Sepia);
+        Check(cache.Find(fadeSepia) == nullptr, "cache: Find misses before creation");
+        uint32_t& first = cache.GetOrCreate(fadeSepia, create);
+        Check(first == fadeSepia * 10 + 1 && createCount == 1, "cache: first request creates");
+        Check(cache.GetMissCount() == 1 && cache.GetHitCount() == 0, "cache: first request is a miss");
+
+        uint32_t& second = cache.GetOrCreate(fadeSepia, create);
+        Check(&second == &first && createCount == 1, "cache: second request returns the same value without creating");
+        Check(cache.GetMissCount() == 1 && cache.GetHitCount() == 1, "cache: second request is a hit");
+
+        const uint32_t* found = cache.Find(fadeSepia);
+        Check(found == &first && cache.GetHitCount() == 1 && cache.GetMissCount() == 1, "cache: Find does not change the statistics");
+
+        // 全ての組み合わせを2回ずつ要求する（値の場所は登録が増えても変わらない）
+        constexpr Mask kMaskCount = 1u << kStageCount;
+        for (uint32_t round = 0; round < 2; ++round) {
+            for (Mask mask = 1; mask < kMaskCount; ++mask) {
+                cache.GetOrCreate(mask, create);
+            }
+        }
+        Check(cache.GetSize() == kMaskCount - 1, "cache: one entry per mask");
+        Check(createCount == kMaskCount - 1, "cache: every mask is created once");
+        // ヒットは先の1回 + 1周目の fadeSepia + 2周目の全て
+        Check(cache.GetMissCount() == kMaskCount - 1 && cache.GetHitCount() == 1 + 1 + (kMaskCount - 1), "cache: hits and misses over every mask");
+        Check(cache.Find(fadeSepia) == &first, "cache: values stay in place as entries are added");
+
+        cache.Clear();
+        Check(cache.GetSize() == 0 && cache.GetHitCount() == 0 && cache.GetMissCount() == 0, "cache: Clear empties and resets statistics");
+        cache.GetOrCreate(fadeSepia, create);
+        Check(createCount == kMaskCount && cache.GetMissCount() == 1, "cache: requests after Clear create again");
+    }
+
+}
+
+int main()
+{
+    TestBuildMask();
+    TestStageInfo();
+    TestDefines();
+    TestCache();
+
+    std::printf("%s (%u failures)\n", failureCount == 0 ? "passed" : "FAILED", failureCount);
+    return failureCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,216 @@
+// アップロード用リングバッファ（UploadRingAllocator）の確認
+// 割り当て・提出（フェンス値に結び付ける）・GPUの完了（フェンス値を進めて Release）をランダムに繰り返し、
+// バイトごとに使用中かどうかを別に持って次を確かめる（1つでも失敗すれば終了コード1）。
+//   - 重なり: 割り当てた範囲は容量の中で、アライメントが合い、完了していない範囲と重ならない
+//   - 解放: 完了したフェンス値までの提出がまとめて空きに戻り、完了を待つ提出の数・最も古いフェンス値が一致する。
+//     すべて完了すると使用量が0に戻り、先頭から容量いっぱいまで割り当てられる
+//   - 古いフェンス値: 完了済みより前の値で Release しても何も変わらない
+//   - 統計: 使用量は使用中のバイト数以上・容量以下（折り返しで飛ばした分を含むため）
+// あわせて割り当て・提出・解放の速度を測る。
+//
+// 使い方: UploadRingAllocatorTest [--steps <数>] [--seed <数>]
+//   --steps <数>  ランダムな操作の回数（既定: 200000）
+//   --seed <数>   乱数の種（既定: 7）
+
+#include "Engine/Graphics/Common/Core/UploadRingAllocator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <random>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    constexpr uint64_t kCapacity = 1000;
+    constexpr uint32_t kMaxSize = 200;
+    constexpr uint32_t kMaxAlignmentBits = 6;   // 1〜32バイト
+
+    uint32_t failureCount = 0;
+
+    void Check(bool condition, const char* description, uint32_t step)
+    {
+        if (!condition) {
+            // 同じ失敗が続いても出力が埋まらないように最初の数件だけ出す
+            if (failureCount < 10) {
+                std::printf("FAILED at step %u: %s\n", step, description);
+            }
+            ++failureCount;
+        }
+    }
+
+    struct Range {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    /// @brief フェンス値に結び付けた割り当て
+    struct Batch {
+        uint64_t fenceValue;
+        std::vector<Range> ranges;
+    };
+
+    void TestBasic()
+    {
+        UploadRingAllocator ring;
+        ring.Initialize(kCapacity);
+        Check(ring.Allocate(600, 1) == 0, "first allocation starts at 0", 0);
+        ring.Submit(1);
+        Check(ring.Allocate(500, 1) == UploadRingAllocator::kInvalidOffset, "allocation fails while the ring is in use", 0);
+        Check(ring.Allocate(300, 256) == UploadRingAllocator::kInvalidOffset, "alignment padding counts against the space", 0);
+        Check(ring.Allocate(200, 256) == 768, "aligned allocation", 0);
+        ring.Submit(2);
+        Check(ring.GetOldestPendingFence() == 1, "oldest pending fence", 0);
+        ring.Release(1);
+        Check(ring.GetOldestPendingFence() == 2, "Release frees batches in order", 0);
+        Check(ring.Allocate(100, 1) == 0, "allocation wraps to the start", 0);
+        Check(ring.GetStatistics().wrapCount == 1, "wrap count", 0);
+        ring.Submit(3);
+        ring.Release(3);
+        Check(ring.GetStatistics().usedSize == 0 && ring.GetStatistics().pendingBatchCount == 0, "everything released", 0);
+        Check(ring.Allocate(kCapacity, 1) == 0, "empty ring restarts from the beginning", 0);
+    }
+
+    void RunRandomized(uint32_t steps, uint32_t seed)
+    {
+        UploadRingAllocator ring;
+        ring.Initialize(kCapacity);
+
+        std::vector<bool> used(kCapacity, false);
+        std::deque<Batch> pending;
+        std::vector<Range> unsubmitted;
+        uint64_t nextFence = 1;
+        uint64_t completedFence = 0;
+        uint32_t allocationCount = 0;
+        uint32_t failedCount = 0;
+
+        std::mt19937 random(seed);
+        for (uint32_t step = 0; step < steps; ++step) {
+            const uint32_t operation = random() % 10;
+            if (operation < 6) {
+                const uint64_t size = 1 + random() % kMaxSize;
+                const uint64_t alignment = 1ull << (random() % kMaxAlignmentBits);
+                const bool isEmpty = pending.empty() && unsubmitted.empty();
+                const uint64_t offset = ring.Allocate(size, alignment);
+                if (offset == UploadRingAllocator::kInvalidOffset) {
+                    ++failedCount;
+                    Check(!isEmpty, "allocation failed on an empty ring", step);
+                    continue;
+                }
+                const bool isInside = offset % alignment == 0 && offset + size <= kCapacity;
+                Check(isInside, "allocation is misaligned or outside the ring", step);
+                if (!isInside) {
+                    continue;
+                }
+                Check(std::none_of(used.begin() + offset, used.begin() + offset + size, [](bool b) { return b; }),
+                    "allocation overlaps an in-flight range", step);
+                std::fill(used.begin() + offset, used.begin() + offset + size, true);
+                unsubmitted.push_back({ offset, size });
+                ++allocationCount;
+            } else if (operation < 8) {
+                // 提出（割り当てが無ければ提出は作られない）
+                ring.Submit(nextFence);
+                if (!unsubmitted.empty()) {
+                    pending.push_back({ nextFence, std::move(unsubmitted) });
+                    unsubmitted.clear();
+                }
+                ++nextFence;
+            } else {
+                // GPUがいくつか先まで完了した
+                if (nextFence - 1 > completedFence) {
+                    completedFence += 1 + random() % (nextFence - 1 - completedFence);
+                }
+                ring.Release(completedFence);
+                while (!pending.empty() && pending.front().fenceValue <= completedFence) {
+                    for (const Range& range : pending.front().ranges) {
+                        std::fill(used.begin() + range.offset, used.begin() + range.offset + range.size, false);
+                    }
+                    pending.pop_front();
+                }
+
+                // 完了済みより前の値で呼んでも何も変わらない
+                const UploadRingAllocator::Statistics before = ring.GetStatistics();
+                ring.Release(completedFence / 2);
+                const UploadRingAllocator::Statistics after = ring.GetStatistics();
+                Check(after.usedSize == before.usedSize && after.pendingBatchCount == before.pendingBatchCount,
+                    "Release with an old fence changed the ring", step);
+            }
+
+            const UploadRingAllocator::Statistics statistics = ring.GetStatistics();
+            const uint64_t usedBytes = static_cast<uint64_t>(std::count(used.begin(), used.end(), true));
+            Check(statistics.usedSize >= usedBytes && statistics.usedSize <= kCapacity, "used size", step);
+            Check(statistics.pendingBatchCount == pending.size(), "pending batch count", step);
+            Check(ring.GetOldestPendingFence() == (pending.empty() ? 0 : pending.front().fenceValue), "oldest pending fence", step);
+            Check(ring.HasUnsubmitted() == !unsubmitted.empty(), "HasUnsubmitted", step);
+        }
+
+        // すべて完了させると空に戻り、容量いっぱいまで使える
+        ring.Submit(nextFence);
+        ring.Release(nextFence);
+        const UploadRingAllocator::Statistics statistics = ring.GetStatistics();
+        Check(statistics.usedSize == 0 && statistics.pendingBatchCount == 0, "ring is empty after everything completed", steps);
+        Check(statistics.allocationCount == allocationCount && statistics.failedCount == failedCount, "allocation statistics", steps);
+        Check(ring.Allocate(kCapacity, 1) == 0, "full-capacity allocation after everything completed", steps);
+
+        std::printf("randomized: %u steps, %u allocations, %u failed, %u wraps, peak %llu / %llu bytes\n",
+            steps, allocationCount, failedCount, statistics.wrapCount,
+            static_cast<unsigned long long>(statistics.peakUsedSize), static_cast<unsigned long long>(kCapacity));
+    }
+
+    void RunTiming()
+    {
+        // 64MB のリングに、1フレームあたり 256 個の 4KB〜64KB の割り当てを行い、2フレーム遅れで完了させる
+        constexpr uint32_t kFrames = 2000;
+        constexpr uint32_t kAllocationsPerFrame = 256;
+        UploadRingAllocator ring;
+        ring.Initialize(64ull << 20);
+        std::mt19937 random(1);
+
+        uint32_t failed = 0;
+        const Clock::time_point start = Clock::now();
+        for (uint32_t frame = 1; frame <= kFrames; ++frame) {
+            for (uint32_t i = 0; i < kAllocationsPerFrame; ++i) {
+                const uint64_t size = 4096ull << (random() % 5);
+                failed += ring.Allocate(size, 512) == UploadRingAllocator::kInvalidOffset ? 1 : 0;
+            }
+            ring.Submit(frame);
+            if (frame > 2) {
+                ring.Release(frame - 2);
+            }
+        }
+        const double milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        const uint32_t total = kFrames * kAllocationsPerFrame;
+        std::printf("timing: %u allocations over %u frames in %.2f ms (%.1f ns each), failed %u, wraps %u\n",
+            total, kFrames, milliseconds, milliseconds * 1.0e6 / total, failed, ring.GetStatistics().wrapCount);
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t steps = 200000;
+    uint32_t seed = 7;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--steps") == 0 && i + 1 < argc) {
+            steps = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::printf("usage: UploadRingAllocatorTest [--steps <n>] [--seed <n>]\n");
+            return 1;
+        }
+    }
+
+    TestBasic();
+    RunRandomized(steps, seed);
+    RunTiming();
+
+    std::printf("%s (%u failures)\n", failureCount == 0 ? "passed" : "FAILED", failureCount);
+    return failureCount == 0 ? 0 : 1;
+}